@@ -4,10 +4,147 @@
 // 목적: RecorderService에서 호출 가능한 Dart 인터페이스 제공
 // 작성일: 2025-10-22
 
+import 'dart:async';
 import 'dart:ffi' as ffi;
 import 'dart:io';
+import 'dart:isolate';
 import 'package:ffi/ffi.dart';
 
+/// 파이프라인 측정 단계 수 (NATIVE_RECORDER_PIPELINE_STAGE_COUNT와 동일)
+const int kPipelineStageCount = 8;
+
+/// 단계 이름 (C++ PipelineStage 순서와 동일)
+const List<String> kPipelineStageNames = [
+  'capture',
+  'video_queue',
+  'convert',
+  'video_encode',
+  'mux',
+  'video_total',
+  'audio_queue',
+  'audio_encode',
+];
+
+/// C 구조체: NativeRecorderStageLatency (마이크로초)
+final class NativeStageLatency extends ffi.Struct {
+  @ffi.Int64()
+  external int count;
+  @ffi.Int64()
+  external int minUs;
+  @ffi.Int64()
+  external int meanUs;
+  @ffi.Int64()
+  external int p50Us;
+  @ffi.Int64()
+  external int p90Us;
+  @ffi.Int64()
+  external int p99Us;
+  @ffi.Int64()
+  external int p999Us;
+  @ffi.Int64()
+  external int maxUs;
+}
+
+/// C 구조체: NativeRecorderPipelineStats
+final class NativePipelineStats extends ffi.Struct {
+  @ffi.Int32()
+  external int structSize;
+  @ffi.Int32()
+  external int stageCount;
+  @ffi.Int64()
+  external int recordCostNs;
+  @ffi.Array(kPipelineStageCount)
+  external ffi.Array<NativeStageLatency> stages;
+}
+
+/// C 구조체: NativeRecorderQueueStats
+final class NativeQueueStats extends ffi.Struct {
+  @ffi.Int32()
+  external int structSize;
+  @ffi.Int32()
+  external int videoQueueDepth;
+  @ffi.Int32()
+  external int videoQueueHighWater;
+  @ffi.Int32()
+  external int videoQueueCapacity;
+  @ffi.Int32()
+  external int audioQueueDepth;
+  @ffi.Int32()
+  external int audioQueueHighWater;
+  @ffi.Int32()
+  external int audioQueueCapacity;
+  @ffi.Int32()
+  external int reserved;
+  @ffi.Int64()
+  external int capturedVideoFrames;
+  @ffi.Int64()
+  external int repeatedVideoFrames;
+  @ffi.Int64()
+  external int droppedVideoFrames;
+  @ffi.Int64()
+  external int droppedAudioPackets;
+  @ffi.Int64()
+  external int droppedAudioSamples;
+  @ffi.Int64()
+  external int droppedAudioMs;
+}
+
+/// 실시간 통계 블록 레이아웃 버전 (native/core/live_stats.h의 kLiveStatsVersion과 동일)
+const int kLiveStatsVersion = 1;
+
+/// C 구조체: NativeRecorderLiveStats (네이티브가 seqlock으로 갱신, 읽기 전용)
+/// 뒤쪽 패딩(reserved)은 읽지 않으므로 생략
+final class NativeLiveStats extends ffi.Struct {
+  @ffi.Uint32()
+  external int version;
+  @ffi.Uint32()
+  external int structSize;
+  @ffi.Uint32()
+  external int sequence;
+  @ffi.Uint32()
+  external int recording;
+  @ffi.Int64()
+  external int elapsedMs;
+  @ffi.Int64()
+  external int videoFrames;
+  @ffi.Int64()
+  external int audioSamples;
+  @ffi.Int64()
+  external int capturedVideoFrames;
+  @ffi.Int64()
+  external int repeatedVideoFrames;
+  @ffi.Int64()
+  external int droppedVideoFrames;
+  @ffi.Int64()
+  external int droppedAudioPackets;
+  @ffi.Int64()
+  external int droppedAudioSamples;
+  @ffi.Int64()
+  external int droppedAudioMs;
+  @ffi.Int64()
+  external int encodedBytes;
+  @ffi.Int32()
+  external int videoQueueDepth;
+  @ffi.Int32()
+  external int videoQueueHighWater;
+  @ffi.Int32()
+  external int videoQueueCapacity;
+  @ffi.Int32()
+  external int audioQueueDepth;
+  @ffi.Int32()
+  external int audioQueueHighWater;
+  @ffi.Int32()
+  external int audioQueueCapacity;
+  @ffi.Float()
+  external double audioLevel;
+  @ffi.Float()
+  external double audioPeakLevel;
+  @ffi.Float()
+  external double videoFps;
+  @ffi.Float()
+  external double encoderBitrateKbps;
+}
+
 /// C++ 함수 시그니처 정의
 typedef NativeInitializeFunc = ffi.Int32 Function();
 typedef NativeStartRecordingFunc = ffi.Int32 Function(
@@ -30,6 +167,105 @@ typedef NativeGetElapsedTimeMsFunc = ffi.Int64 Function();
 typedef NativeGetAudioLevelFunc = ffi.Float Function();
 typedef NativeGetAudioPeakLevelFunc = ffi.Float Function();
 
+// 파이프라인 지연 시간 통계
+typedef NativeGetPipelineStatsFunc = ffi.Int32 Function(ffi.Pointer<NativePipelineStats> stats);
+typedef NativeGetQueueStatsFunc = ffi.Int32 Function(ffi.Pointer<NativeQueueStats> stats);
+typedef NativeGetLiveStatsFunc = ffi.Pointer<NativeLiveStats> Function();
+
+// 녹화 후처리 (faststart remux)
+typedef NativeIsFinalizingFunc = ffi.Int32 Function();
+typedef NativeGetSegmentPathsFunc = ffi.Pointer<Utf8> Function();
+typedef NativeSetFaststartEnabledFunc = ffi.Void Function(ffi.Int32 enabled);
+
+// 패킷 저널 (크래시 복구)
+typedef NativeSetPacketJournalEnabledFunc = ffi.Void Function(ffi.Int32 enabled);
+typedef NativeRecoverFromJournalFunc = ffi.Int32 Function(
+  ffi.Pointer<Utf8> journalPath,
+  ffi.Pointer<Utf8> outputPath,
+);
+
+// 비디오 큐 메모리 예산 / 저장 형식 (0: BGRA, 1: I420)
+typedef NativeSetFrameBufferingFunc = ffi.Int32 Function(ffi.Int64 budgetBytes, ffi.Int32 frameFormat);
+
+// pre-roll / post-roll (압축 패킷 메모리 링, 커밋 시점부터 파일 기록)
+typedef NativeSetPreRollFunc = ffi.Int32 Function(ffi.Int32 maxMs, ffi.Int64 maxBytes, ffi.Int32 postrollMs);
+typedef NativeCommitPreRollFunc = ffi.Int32 Function(ffi.Int32 lookbackMs);
+typedef NativeIsPreRollActiveFunc = ffi.Int32 Function();
+
+// 녹화 준비 / 트리거 (장치·인코더·출력 파일을 미리 열어 두고 시작만 빠르게)
+typedef NativeTriggerRecordingFunc = ffi.Int32 Function();
+typedef NativeIsArmedFunc = ffi.Int32 Function();
+
+// 비동기 중지 (중지 요청은 바로 반환, 종료 처리 기한 초과 시 남은 큐를 버림)
+typedef NativeIsStoppingFunc = ffi.Int32 Function();
+typedef NativeSetStopDeadlineFunc = ffi.Int32 Function(ffi.Int32 deadlineMs);
+
+// 인코더 자식 프로세스 (크래시 격리)
+typedef NativeSetEncoderIsolationFunc = ffi.Int32 Function(ffi.Int32 enabled);
+
+// 단계 감시 (정체/오류 단계만 재시작)
+typedef NativeSetWatchdogFunc = ffi.Int32 Function(ffi.Int32 deadlineMs, ffi.Int32 maxRestarts);
+
+// CPU 예산 조절
+typedef NativeSetCpuBudgetFunc = ffi.Int32 Function(ffi.Int32 budgetPercent);
+
+// 녹화 스레드 정책 (MMCSS/우선순위/affinity)
+typedef NativeSetThreadPolicyFunc = ffi.Int32 Function(
+  ffi.Int32 enabled,
+  ffi.Int32 affinityMode,
+  ffi.Uint64 captureCpus,
+  ffi.Uint64 audioCpus,
+  ffi.Uint64 encoderCpus,
+);
+
+// 녹화 세션 (핸들 기반, 여러 녹화를 동시에)
+typedef NativeCreateSessionFunc = ffi.Int32 Function();
+typedef NativeSessionFunc = ffi.Int32 Function(ffi.Int32 handle);
+typedef NativeSessionStartRecordingFunc = ffi.Int32 Function(
+  ffi.Int32 handle,
+  ffi.Pointer<Utf8> outputPath,
+  ffi.Int32 width,
+  ffi.Int32 height,
+  ffi.Int32 fps,
+  ffi.Int32 monitorIndex,
+);
+typedef NativeSessionGetInt64Func = ffi.Int64 Function(ffi.Int32 handle);
+typedef NativeSessionGetLiveStatsFunc = ffi.Pointer<NativeLiveStats> Function(ffi.Int32 handle);
+typedef NativeSessionGetSegmentPathsFunc = ffi.Pointer<Utf8> Function(ffi.Int32 handle);
+
+// 녹화 컨테이너 (Fragmented MP4 / Matroska / MPEG-TS)
+typedef NativeSetContainerFormatFunc = ffi.Int32 Function(ffi.Int32 container);
+typedef NativeRemuxToMp4Func = ffi.Int32 Function(
+  ffi.Pointer<Utf8> inputPath,
+  ffi.Pointer<Utf8> outputPath,
+);
+
+// 이중 출력 (primary + secondary)
+typedef NativeSetSecondaryOutputPathFunc = ffi.Void Function(ffi.Pointer<Utf8> outputPath);
+typedef NativeGetOutputStateFunc = ffi.Int32 Function(ffi.Int32 index);
+typedef NativeGetOutputBytesFunc = ffi.Int64 Function(ffi.Int32 index);
+
+// 네이티브 로그 파일
+typedef NativeSetLogFilePathFunc = ffi.Void Function(ffi.Pointer<Utf8> logPath);
+
+// 녹화 이벤트 (Dart_PostCObject → ReceivePort)
+typedef NativeInitializeDartApiFunc = ffi.Int32 Function(ffi.Pointer<ffi.Void> data);
+typedef NativeSetEventPortFunc = ffi.Void Function(ffi.Int64 port);
+
+// 파이프라인 trace (Chrome trace-event JSON)
+typedef NativeStartTraceFunc = ffi.Int32 Function(ffi.Pointer<Utf8> outputPath);
+typedef NativeStopTraceFunc = ffi.Int64 Function();
+
+// 캡처 trace (Linux 재생용 캡처 입력 기록)
+typedef NativeSetCaptureTracePathFunc = ffi.Int32 Function(ffi.Pointer<Utf8> outputPath);
+
+// 세그먼트 이어붙이기 (packet copy)
+typedef NativeConcatSegmentsFunc = ffi.Int32 Function(
+  ffi.Pointer<ffi.Pointer<Utf8>> inputPaths,
+  ffi.Int32 inputCount,
+  ffi.Pointer<Utf8> outputPath,
+);
+
 /// Dart 함수 시그니처 정의
 typedef DartInitializeFunc = int Function();
 typedef DartStartRecordingFunc = int Function(
@@ -52,6 +288,105 @@ typedef DartGetElapsedTimeMsFunc = int Function();
 typedef DartGetAudioLevelFunc = double Function();
 typedef DartGetAudioPeakLevelFunc = double Function();
 
+// 파이프라인 지연 시간 통계
+typedef DartGetPipelineStatsFunc = int Function(ffi.Pointer<NativePipelineStats> stats);
+typedef DartGetQueueStatsFunc = int Function(ffi.Pointer<NativeQueueStats> stats);
+typedef DartGetLiveStatsFunc = ffi.Pointer<NativeLiveStats> Function();
+
+// 녹화 후처리 (faststart remux)
+typedef DartIsFinalizingFunc = int Function();
+typedef DartGetSegmentPathsFunc = ffi.Pointer<Utf8> Function();
+typedef DartSetFaststartEnabledFunc = void Function(int enabled);
+
+// 패킷 저널 (크래시 복구)
+typedef DartSetPacketJournalEnabledFunc = void Function(int enabled);
+typedef DartRecoverFromJournalFunc = int Function(
+  ffi.Pointer<Utf8> journalPath,
+  ffi.Pointer<Utf8> outputPath,
+);
+
+// 녹화 컨테이너 (Fragmented MP4 / Matroska / MPEG-TS)
+typedef DartSetContainerFormatFunc = int Function(int container);
+
+// 비디오 큐 메모리 예산 / 저장 형식 (0: BGRA, 1: I420)
+typedef DartSetFrameBufferingFunc = int Function(int budgetBytes, int frameFormat);
+
+// pre-roll / post-roll (압축 패킷 메모리 링, 커밋 시점부터 파일 기록)
+typedef DartSetPreRollFunc = int Function(int maxMs, int maxBytes, int postrollMs);
+typedef DartCommitPreRollFunc = int Function(int lookbackMs);
+typedef DartIsPreRollActiveFunc = int Function();
+
+// 녹화 준비 / 트리거 (장치·인코더·출력 파일을 미리 열어 두고 시작만 빠르게)
+typedef DartTriggerRecordingFunc = int Function();
+typedef DartIsArmedFunc = int Function();
+
+// 비동기 중지 (중지 요청은 바로 반환, 종료 처리 기한 초과 시 남은 큐를 버림)
+typedef DartIsStoppingFunc = int Function();
+typedef DartSetStopDeadlineFunc = int Function(int deadlineMs);
+
+// 인코더 자식 프로세스 (크래시 격리)
+typedef DartSetEncoderIsolationFunc = int Function(int enabled);
+
+// 단계 감시 (정체/오류 단계만 재시작)
+typedef DartSetWatchdogFunc = int Function(int deadlineMs, int maxRestarts);
+
+// CPU 예산 조절
+typedef DartSetCpuBudgetFunc = int Function(int budgetPercent);
+
+// 녹화 스레드 정책 (MMCSS/우선순위/affinity)
+typedef DartSetThreadPolicyFunc = int Function(
+  int enabled,
+  int affinityMode,
+  int captureCpus,
+  int audioCpus,
+  int encoderCpus,
+);
+
+// 녹화 세션 (핸들 기반, 여러 녹화를 동시에)
+typedef DartCreateSessionFunc = int Function();
+typedef DartSessionFunc = int Function(int handle);
+typedef DartSessionStartRecordingFunc = int Function(
+  int handle,
+  ffi.Pointer<Utf8> outputPath,
+  int width,
+  int height,
+  int fps,
+  int monitorIndex,
+);
+typedef DartSessionGetInt64Func = int Function(int handle);
+typedef DartSessionGetLiveStatsFunc = ffi.Pointer<NativeLiveStats> Function(int handle);
+typedef DartSessionGetSegmentPathsFunc = ffi.Pointer<Utf8> Function(int handle);
+typedef DartRemuxToMp4Func = int Function(
+  ffi.Pointer<Utf8> inputPath,
+  ffi.Pointer<Utf8> outputPath,
+);
+
+// 이중 출력 (primary + secondary)
+typedef DartSetSecondaryOutputPathFunc = void Function(ffi.Pointer<Utf8> outputPath);
+typedef DartGetOutputStateFunc = int Function(int index);
+typedef DartGetOutputBytesFunc = int Function(int index);
+
+// 네이티브 로그 파일
+typedef DartSetLogFilePathFunc = void Function(ffi.Pointer<Utf8> logPath);
+
+// 녹화 이벤트 (Dart_PostCObject → ReceivePort)
+typedef DartInitializeDartApiFunc = int Function(ffi.Pointer<ffi.Void> data);
+typedef DartSetEventPortFunc = void Function(int port);
+
+// 파이프라인 trace (Chrome trace-event JSON)
+typedef DartStartTraceFunc = int Function(ffi.Pointer<Utf8> outputPath);
+typedef DartStopTraceFunc = int Function();
+
+// 캡처 trace (Linux 재생용 캡처 입력 기록)
+typedef DartSetCaptureTracePathFunc = int Function(ffi.Pointer<Utf8> outputPath);
+
+// 세그먼트 이어붙이기 (packet copy)
+typedef DartConcatSegmentsFunc = int Function(
+  ffi.Pointer<ffi.Pointer<Utf8>> inputPaths,
+  int inputCount,
+  ffi.Pointer<Utf8> outputPath,
+);
+
 /// 네이티브 라이브러리 로드
 ffi.DynamicLibrary _loadLibrary() {
   if (Platform.isWindows) {
@@ -112,6 +447,223 @@ class NativeRecorderBindings {
   static final DartGetAudioPeakLevelFunc getAudioPeakLevel = _lib
       .lookup<ffi.NativeFunction<NativeGetAudioPeakLevelFunc>>('NativeRecorder_GetAudioPeakLevel')
       .asFunction();
+
+  /// 파이프라인 지연 시간 통계 함수 바인딩
+  static final DartGetPipelineStatsFunc getPipelineStats = _lib
+      .lookup<ffi.NativeFunction<NativeGetPipelineStatsFunc>>('NativeRecorder_GetPipelineStats')
+      .asFunction();
+
+  static final DartGetQueueStatsFunc getQueueStats = _lib
+      .lookup<ffi.NativeFunction<NativeGetQueueStatsFunc>>('NativeRecorder_GetQueueStats')
+      .asFunction();
+
+  /// 실시간 통계 블록 주소 (한 번만 호출, NativeLiveStatsReader 사용 권장)
+  static final DartGetLiveStatsFunc getLiveStats = _lib
+      .lookup<ffi.NativeFunction<NativeGetLiveStatsFunc>>('NativeRecorder_GetLiveStats')
+      .asFunction();
+
+  /// 녹화 후처리 (faststart remux) 함수 바인딩
+  static final DartIsFinalizingFunc isFinalizing = _lib
+      .lookup<ffi.NativeFunction<NativeIsFinalizingFunc>>('NativeRecorder_IsFinalizing')
+      .asFunction();
+
+  /// 마지막 녹화의 세그먼트 경로 (인코더 재시작마다 하나씩, 줄바꿈 구분 UTF-8)
+  static final DartGetSegmentPathsFunc getSegmentPaths = _lib
+      .lookup<ffi.NativeFunction<NativeGetSegmentPathsFunc>>('NativeRecorder_GetSegmentPaths')
+      .asFunction();
+
+  static final DartSetFaststartEnabledFunc setFaststartEnabled = _lib
+      .lookup<ffi.NativeFunction<NativeSetFaststartEnabledFunc>>('NativeRecorder_SetFaststartEnabled')
+      .asFunction();
+
+  /// 패킷 저널 함수 바인딩
+  static final DartSetPacketJournalEnabledFunc setPacketJournalEnabled = _lib
+      .lookup<ffi.NativeFunction<NativeSetPacketJournalEnabledFunc>>('NativeRecorder_SetPacketJournalEnabled')
+      .asFunction();
+
+  static final DartRecoverFromJournalFunc recoverFromJournal = _lib
+      .lookup<ffi.NativeFunction<NativeRecoverFromJournalFunc>>('NativeRecorder_RecoverFromJournal')
+      .asFunction();
+
+  /// 녹화 컨테이너 함수 바인딩 (0: Fragmented MP4, 1: Matroska, 2: MPEG-TS)
+  static final DartSetContainerFormatFunc setContainerFormat = _lib
+      .lookup<ffi.NativeFunction<NativeSetContainerFormatFunc>>('NativeRecorder_SetContainerFormat')
+      .asFunction();
+
+  /// 비디오 큐 메모리 예산 / 저장 형식 (다음 녹화부터 적용)
+  static final DartSetFrameBufferingFunc setFrameBuffering = _lib
+      .lookup<ffi.NativeFunction<NativeSetFrameBufferingFunc>>('NativeRecorder_SetFrameBuffering')
+      .asFunction();
+
+  /// pre-roll 링 한도 / post-roll 길이 (다음 녹화부터 적용, maxMs 0이면 pre-roll 사용 안 함)
+  static final DartSetPreRollFunc setPreRoll = _lib
+      .lookup<ffi.NativeFunction<NativeSetPreRollFunc>>('NativeRecorder_SetPreRoll')
+      .asFunction();
+
+  /// pre-roll 커밋 (0: 성공, -2: pre-roll 중 아님, -3: 실패)
+  static final DartCommitPreRollFunc commitPreRoll = _lib
+      .lookup<ffi.NativeFunction<NativeCommitPreRollFunc>>('NativeRecorder_CommitPreRoll')
+      .asFunction();
+
+  static final DartIsPreRollActiveFunc isPreRollActive = _lib
+      .lookup<ffi.NativeFunction<NativeIsPreRollActiveFunc>>('NativeRecorder_IsPreRollActive')
+      .asFunction();
+
+  /// 녹화 준비 (startRecording과 같은 인자, 트리거 전에 중지하면 파일 없음)
+  static final DartStartRecordingFunc armRecording = _lib
+      .lookup<ffi.NativeFunction<NativeStartRecordingFunc>>('NativeRecorder_ArmRecording')
+      .asFunction();
+
+  /// 준비된 녹화 시작 (0: 성공, -2: 준비된 녹화 없음)
+  static final DartTriggerRecordingFunc triggerRecording = _lib
+      .lookup<ffi.NativeFunction<NativeTriggerRecordingFunc>>('NativeRecorder_TriggerRecording')
+      .asFunction();
+
+  static final DartIsArmedFunc isArmed = _lib
+      .lookup<ffi.NativeFunction<NativeIsArmedFunc>>('NativeRecorder_IsArmed')
+      .asFunction();
+
+  /// 중지 요청 후 종료 처리(큐 비우기, 파일 닫기) 중 여부, 끝나면 stopped/stoppedWithError 이벤트
+  static final DartIsStoppingFunc isStopping = _lib
+      .lookup<ffi.NativeFunction<NativeIsStoppingFunc>>('NativeRecorder_IsStopping')
+      .asFunction();
+
+  /// 종료 처리 기한 (다음 녹화부터 적용, 0이면 제한 없음, 기본 10000ms)
+  static final DartSetStopDeadlineFunc setStopDeadline = _lib
+      .lookup<ffi.NativeFunction<NativeSetStopDeadlineFunc>>('NativeRecorder_SetStopDeadline')
+      .asFunction();
+
+  /// 인코더 자식 프로세스 사용 (1: 사용, 0: 앱 안에서 인코딩, 다음 녹화부터 적용)
+  /// 인코더가 죽으면 새 세그먼트 파일로 이어서 기록하고 encoderRestarted 이벤트 전송
+  static final DartSetEncoderIsolationFunc setEncoderIsolation = _lib
+      .lookup<ffi.NativeFunction<NativeSetEncoderIsolationFunc>>('NativeRecorder_SetEncoderIsolation')
+      .asFunction();
+
+  /// 단계 감시 (기한 ms, 단계별 재시작 한도, 다음 녹화부터 적용, 기본 2000ms / 3회, 기한 0이면 감시 안 함)
+  /// 멈추거나 오류가 난 단계만 재시작하고 stageRestarted 이벤트 전송 (인코더는 새 세그먼트 + encoderRestarted)
+  static final DartSetWatchdogFunc setWatchdog = _lib
+      .lookup<ffi.NativeFunction<NativeSetWatchdogFunc>>('NativeRecorder_SetWatchdog')
+      .asFunction();
+
+  /// 녹화 스레드 정책 (다음 녹화부터 적용, 기본: 사용 / affinity 없음, 0: 성공, -1: 잘못된 affinityMode)
+  /// 오디오/캡처는 MMCSS 등록, 인코더는 우선순위를 낮춤 (affinityMode 0 없음, 1 선호 코어, 2 고정, 마스크 0이면 지정 안 함)
+  static final DartSetThreadPolicyFunc setThreadPolicy = _lib
+      .lookup<ffi.NativeFunction<NativeSetThreadPolicyFunc>>('NativeRecorder_SetThreadPolicy')
+      .asFunction();
+
+  /// CPU 예산 (전체 CPU 대비 %, 다음 녹화부터 적용, 기본 0 = 조절 안 함, 0: 성공, -1: 0~100 밖)
+  /// 넘으면 캡처 fps/preset/인코더 스레드를 단계적으로 낮추고 cpuGovernorChanged 이벤트 전송
+  static final DartSetCpuBudgetFunc setCpuBudget = _lib
+      .lookup<ffi.NativeFunction<NativeSetCpuBudgetFunc>>('NativeRecorder_SetCpuBudget')
+      .asFunction();
+
+  /// 세션 생성 (1 이상: 핸들, -1: D3D11 디바이스 생성 실패), 기본 세션(0)은 위 단일 녹화 함수가 사용
+  static final DartCreateSessionFunc createSession = _lib
+      .lookup<ffi.NativeFunction<NativeCreateSessionFunc>>('NativeRecorder_CreateSession')
+      .asFunction();
+
+  /// 세션 제거 (녹화 중이면 파일을 닫을 때까지 대기)
+  static final DartSessionFunc destroySession = _lib
+      .lookup<ffi.NativeFunction<NativeSessionFunc>>('NativeRecorder_DestroySession')
+      .asFunction();
+
+  /// 세션 녹화 시작 / 준비 (monitorIndex 음수면 기본 모니터)
+  static final DartSessionStartRecordingFunc sessionStartRecording = _lib
+      .lookup<ffi.NativeFunction<NativeSessionStartRecordingFunc>>('NativeRecorder_SessionStartRecording')
+      .asFunction();
+
+  static final DartSessionStartRecordingFunc sessionArmRecording = _lib
+      .lookup<ffi.NativeFunction<NativeSessionStartRecordingFunc>>('NativeRecorder_SessionArmRecording')
+      .asFunction();
+
+  static final DartSessionFunc sessionTriggerRecording = _lib
+      .lookup<ffi.NativeFunction<NativeSessionFunc>>('NativeRecorder_SessionTriggerRecording')
+      .asFunction();
+
+  static final DartSessionFunc sessionStopRecording = _lib
+      .lookup<ffi.NativeFunction<NativeSessionFunc>>('NativeRecorder_SessionStopRecording')
+      .asFunction();
+
+  static final DartSessionFunc sessionIsRecording = _lib
+      .lookup<ffi.NativeFunction<NativeSessionFunc>>('NativeRecorder_SessionIsRecording')
+      .asFunction();
+
+  static final DartSessionFunc sessionIsStopping = _lib
+      .lookup<ffi.NativeFunction<NativeSessionFunc>>('NativeRecorder_SessionIsStopping')
+      .asFunction();
+
+  static final DartSessionGetInt64Func sessionGetVideoFrameCount = _lib
+      .lookup<ffi.NativeFunction<NativeSessionGetInt64Func>>('NativeRecorder_SessionGetVideoFrameCount')
+      .asFunction();
+
+  static final DartSessionGetInt64Func sessionGetElapsedTimeMs = _lib
+      .lookup<ffi.NativeFunction<NativeSessionGetInt64Func>>('NativeRecorder_SessionGetElapsedTimeMs')
+      .asFunction();
+
+  /// 세션 실시간 통계 블록 (세션 제거 전까지 주소 고정, 알 수 없는 핸들이면 nullptr)
+  static final DartSessionGetLiveStatsFunc sessionGetLiveStats = _lib
+      .lookup<ffi.NativeFunction<NativeSessionGetLiveStatsFunc>>('NativeRecorder_SessionGetLiveStats')
+      .asFunction();
+
+  /// 세션의 마지막 녹화 세그먼트 경로 (알 수 없는 핸들이면 빈 문자열)
+  static final DartSessionGetSegmentPathsFunc sessionGetSegmentPaths = _lib
+      .lookup<ffi.NativeFunction<NativeSessionGetSegmentPathsFunc>>('NativeRecorder_SessionGetSegmentPaths')
+      .asFunction();
+
+  static final DartRemuxToMp4Func remuxToMp4 = _lib
+      .lookup<ffi.NativeFunction<NativeRemuxToMp4Func>>('NativeRecorder_RemuxToMp4')
+      .asFunction();
+
+  /// 이중 출력 함수 바인딩
+  /// 상태 값: 0 사용 안 함, 1 정상, 2 멈춤으로 분리, 3 쓰기 오류로 분리
+  static final DartSetSecondaryOutputPathFunc setSecondaryOutputPath = _lib
+      .lookup<ffi.NativeFunction<NativeSetSecondaryOutputPathFunc>>('NativeRecorder_SetSecondaryOutputPath')
+      .asFunction();
+
+  static final DartGetOutputStateFunc getOutputState = _lib
+      .lookup<ffi.NativeFunction<NativeGetOutputStateFunc>>('NativeRecorder_GetOutputState')
+      .asFunction();
+
+  static final DartGetOutputBytesFunc getOutputBytesWritten = _lib
+      .lookup<ffi.NativeFunction<NativeGetOutputBytesFunc>>('NativeRecorder_GetOutputBytesWritten')
+      .asFunction();
+
+  static final DartGetOutputBytesFunc getOutputQueuedBytes = _lib
+      .lookup<ffi.NativeFunction<NativeGetOutputBytesFunc>>('NativeRecorder_GetOutputQueuedBytes')
+      .asFunction();
+
+  /// 네이티브 로그 파일 함수 바인딩
+  static final DartSetLogFilePathFunc setLogFilePath = _lib
+      .lookup<ffi.NativeFunction<NativeSetLogFilePathFunc>>('NativeRecorder_SetLogFilePath')
+      .asFunction();
+
+  /// 녹화 이벤트 함수 바인딩 (NativeRecorderEvents에서 사용)
+  static final DartInitializeDartApiFunc initializeDartApi = _lib
+      .lookup<ffi.NativeFunction<NativeInitializeDartApiFunc>>('NativeRecorder_InitializeDartApi')
+      .asFunction();
+
+  static final DartSetEventPortFunc setEventPort = _lib
+      .lookup<ffi.NativeFunction<NativeSetEventPortFunc>>('NativeRecorder_SetEventPort')
+      .asFunction();
+
+  /// 파이프라인 trace 함수 바인딩 (chrome://tracing / Perfetto에서 열기)
+  static final DartStartTraceFunc startTrace = _lib
+      .lookup<ffi.NativeFunction<NativeStartTraceFunc>>('NativeRecorder_StartTrace')
+      .asFunction();
+
+  static final DartStopTraceFunc stopTrace = _lib
+      .lookup<ffi.NativeFunction<NativeStopTraceFunc>>('NativeRecorder_StopTrace')
+      .asFunction();
+
+  /// 캡처 trace 함수 바인딩 (satrec_replay로 재생)
+  static final DartSetCaptureTracePathFunc setCaptureTracePath = _lib
+      .lookup<ffi.NativeFunction<NativeSetCaptureTracePathFunc>>('NativeRecorder_SetCaptureTracePath')
+      .asFunction();
+
+  /// 세그먼트 이어붙이기 함수 바인딩
+  static final DartConcatSegmentsFunc concatSegments = _lib
+      .lookup<ffi.NativeFunction<NativeConcatSegmentsFunc>>('NativeRecorder_ConcatSegments')
+      .asFunction();
 }
 
 /// 편의 함수: 마지막 에러 메시지 가져오기 (Dart String 변환)
@@ -122,3 +674,404 @@ String getNativeLastError() {
   }
   return errorPtr.toDartString();
 }
+
+/// 편의 함수: 마지막 녹화의 세그먼트 경로 목록
+///
+/// 입력: 없음
+/// 출력: 녹화 순서대로 정렬된 세그먼트 경로 (재시작이 없었으면 출력 파일 하나)
+/// 세그먼트가 둘 이상이면 후처리가 하나의 출력 파일로 이어붙임 (실패하면 세그먼트별 파일로 남음)
+List<String> getNativeSegmentPaths() {
+  final pathsPtr = NativeRecorderBindings.getSegmentPaths();
+  if (pathsPtr.address == 0) {
+    return const [];
+  }
+  return pathsPtr.toDartString().split('\n').where((path) => path.isNotEmpty).toList();
+}
+
+/// 편의 함수: 세그먼트 목록을 하나의 MP4로 이어붙이기 (재인코딩 없음)
+///
+/// 입력: [inputPaths] 재생 순서대로 정렬된 세그먼트 경로, [outputPath] 출력 경로
+/// 출력: 네이티브 결과 코드 (0 성공, -1 인자 오류, -2 코덱 불일치, -3 입출력 오류)
+/// ⚠️ 파일 크기에 비례해 시간이 걸리므로 UI isolate가 아닌 곳에서 호출 권장
+int concatNativeSegments(List<String> inputPaths, String outputPath) {
+  final pathArray = calloc<ffi.Pointer<Utf8>>(inputPaths.length);
+  final outputPtr = outputPath.toNativeUtf8();
+  try {
+    for (var i = 0; i < inputPaths.length; i++) {
+      pathArray[i] = inputPaths[i].toNativeUtf8();
+    }
+    return NativeRecorderBindings.concatSegments(pathArray, inputPaths.length, outputPtr);
+  } finally {
+    for (var i = 0; i < inputPaths.length; i++) {
+      if (pathArray[i].address != 0) {
+        malloc.free(pathArray[i]);
+      }
+    }
+    calloc.free(pathArray);
+    malloc.free(outputPtr);
+  }
+}
+
+/// 파이프라인 단계 하나의 지연 시간 요약 (마이크로초)
+class PipelineStageLatency {
+  final String stage;
+  final int count;
+  final int meanUs;
+  final int p50Us;
+  final int p90Us;
+  final int p99Us;
+  final int p999Us;
+  final int maxUs;
+
+  const PipelineStageLatency({
+    required this.stage,
+    required this.count,
+    required this.meanUs,
+    required this.p50Us,
+    required this.p90Us,
+    required this.p99Us,
+    required this.p999Us,
+    required this.maxUs,
+  });
+
+  @override
+  String toString() =>
+      '$stage: n=$count mean=${meanUs}us p50=${p50Us}us p99=${p99Us}us max=${maxUs}us';
+}
+
+/// 편의 함수: 단계별 지연 시간 통계 조회
+///
+/// 출력: 측정값이 있는 단계 목록 (실패 시 빈 목록)
+List<PipelineStageLatency> getNativePipelineStats() {
+  final stats = calloc<NativePipelineStats>();
+  try {
+    stats.ref.structSize = ffi.sizeOf<NativePipelineStats>();
+    if (NativeRecorderBindings.getPipelineStats(stats) != 0) {
+      return const [];
+    }
+
+    final result = <PipelineStageLatency>[];
+    final count = stats.ref.stageCount < kPipelineStageCount
+        ? stats.ref.stageCount
+        : kPipelineStageCount;
+    for (var i = 0; i < count; i++) {
+      final stage = stats.ref.stages[i];
+      if (stage.count == 0) continue;
+      result.add(PipelineStageLatency(
+        stage: kPipelineStageNames[i],
+        count: stage.count,
+        meanUs: stage.meanUs,
+        p50Us: stage.p50Us,
+        p90Us: stage.p90Us,
+        p99Us: stage.p99Us,
+        p999Us: stage.p999Us,
+        maxUs: stage.maxUs,
+      ));
+    }
+    return result;
+  } finally {
+    calloc.free(stats);
+  }
+}
+
+/// 드롭/반복 프레임 및 큐 깊이 통계
+class RecorderQueueStats {
+  final int capturedVideoFrames;
+  final int repeatedVideoFrames;
+  final int droppedVideoFrames;
+  final int videoQueueDepth;
+  final int videoQueueHighWater;
+  final int videoQueueCapacity;
+  final int droppedAudioPackets;
+  final int droppedAudioSamples;
+  final int droppedAudioMs;
+  final int audioQueueDepth;
+  final int audioQueueHighWater;
+  final int audioQueueCapacity;
+
+  const RecorderQueueStats({
+    required this.capturedVideoFrames,
+    required this.repeatedVideoFrames,
+    required this.droppedVideoFrames,
+    required this.videoQueueDepth,
+    required this.videoQueueHighWater,
+    required this.videoQueueCapacity,
+    required this.droppedAudioPackets,
+    required this.droppedAudioSamples,
+    required this.droppedAudioMs,
+    required this.audioQueueDepth,
+    required this.audioQueueHighWater,
+    required this.audioQueueCapacity,
+  });
+
+  /// 버린 데이터가 있는지 여부 (설정한 fps를 유지하지 못하는 상태)
+  bool get hasDrops => droppedVideoFrames > 0 || droppedAudioPackets > 0;
+
+  @override
+  String toString() =>
+      'captured=$capturedVideoFrames repeated=$repeatedVideoFrames '
+      'droppedVideo=$droppedVideoFrames (queue max $videoQueueHighWater/$videoQueueCapacity) '
+      'droppedAudio=${droppedAudioMs}ms/$droppedAudioPackets packets '
+      '(queue max $audioQueueHighWater/$audioQueueCapacity)';
+}
+
+/// 편의 함수: 큐 압력 통계 조회 (실패 시 null)
+RecorderQueueStats? getNativeQueueStats() {
+  final stats = calloc<NativeQueueStats>();
+  try {
+    stats.ref.structSize = ffi.sizeOf<NativeQueueStats>();
+    if (NativeRecorderBindings.getQueueStats(stats) != 0) {
+      return null;
+    }
+    final s = stats.ref;
+    return RecorderQueueStats(
+      capturedVideoFrames: s.capturedVideoFrames,
+      repeatedVideoFrames: s.repeatedVideoFrames,
+      droppedVideoFrames: s.droppedVideoFrames,
+      videoQueueDepth: s.videoQueueDepth,
+      videoQueueHighWater: s.videoQueueHighWater,
+      videoQueueCapacity: s.videoQueueCapacity,
+      droppedAudioPackets: s.droppedAudioPackets,
+      droppedAudioSamples: s.droppedAudioSamples,
+      droppedAudioMs: s.droppedAudioMs,
+      audioQueueDepth: s.audioQueueDepth,
+      audioQueueHighWater: s.audioQueueHighWater,
+      audioQueueCapacity: s.audioQueueCapacity,
+    );
+  } finally {
+    calloc.free(stats);
+  }
+}
+
+/// 실시간 녹화 통계 (NativeLiveStats 한 시점의 일관된 복사본)
+class RecorderLiveStats {
+  final bool recording;
+  final int elapsedMs;
+  final int videoFrames;
+  final int audioSamples;
+  final double audioLevel;
+  final double audioPeakLevel;
+  final double videoFps;
+  final double encoderBitrateKbps;
+  final int encodedBytes;
+  final RecorderQueueStats queueStats;
+
+  const RecorderLiveStats({
+    required this.recording,
+    required this.elapsedMs,
+    required this.videoFrames,
+    required this.audioSamples,
+    required this.audioLevel,
+    required this.audioPeakLevel,
+    required this.videoFps,
+    required this.encoderBitrateKbps,
+    required this.encodedBytes,
+    required this.queueStats,
+  });
+}
+
+/// 네이티브 실시간 통계 블록 읽기 (FFI 호출은 생성 시 한 번뿐, 이후에는 메모리 직접 읽기)
+///
+/// 네이티브 인코더 스레드가 100ms마다 seqlock으로 갱신하므로
+/// sequence가 짝수이고 읽기 전후 값이 같을 때만 결과로 사용 (다르면 재시도)
+/// ⚠️ Windows x64(TSO) 기준: 일반 로드끼리 순서가 바뀌지 않는다는 전제
+class NativeLiveStatsReader {
+  NativeLiveStatsReader() : _block = NativeRecorderBindings.getLiveStats();
+
+  final ffi.Pointer<NativeLiveStats> _block;
+
+  /// 출력: 일관된 스냅샷 (블록 버전 불일치 또는 재시도 초과 시 null)
+  RecorderLiveStats? read({int maxAttempts = 16}) {
+    if (_block.address == 0) return null;
+    final b = _block.ref;
+    if (b.version != kLiveStatsVersion) return null;
+
+    for (var attempt = 0; attempt < maxAttempts; attempt++) {
+      final before = b.sequence;
+      if (before.isOdd) continue;
+
+      final stats = RecorderLiveStats(
+        recording: b.recording != 0,
+        elapsedMs: b.elapsedMs,
+        videoFrames: b.videoFrames,
+        audioSamples: b.audioSamples,
+        audioLevel: b.audioLevel,
+        audioPeakLevel: b.audioPeakLevel,
+        videoFps: b.videoFps,
+        encoderBitrateKbps: b.encoderBitrateKbps,
+        encodedBytes: b.encodedBytes,
+        queueStats: RecorderQueueStats(
+          capturedVideoFrames: b.capturedVideoFrames,
+          repeatedVideoFrames: b.repeatedVideoFrames,
+          droppedVideoFrames: b.droppedVideoFrames,
+          videoQueueDepth: b.videoQueueDepth,
+          videoQueueHighWater: b.videoQueueHighWater,
+          videoQueueCapacity: b.videoQueueCapacity,
+          droppedAudioPackets: b.droppedAudioPackets,
+          droppedAudioSamples: b.droppedAudioSamples,
+          droppedAudioMs: b.droppedAudioMs,
+          audioQueueDepth: b.audioQueueDepth,
+          audioQueueHighWater: b.audioQueueHighWater,
+          audioQueueCapacity: b.audioQueueCapacity,
+        ),
+      );
+      if (b.sequence == before) return stats;
+    }
+    return null;
+  }
+}
+
+/// 녹화 이벤트 종류 (NATIVE_RECORDER_EVENT_* 값과 동일)
+enum RecorderEventType {
+  recordingStarted(1),
+  firstFrameEncoded(2),
+  stageStalled(3),
+  deviceLost(4),
+  deviceRecovered(5),
+  segmentClosed(6),
+  stopped(7),
+  stoppedWithError(8),
+  finalizeCompleted(9),
+  preRollCommitted(10),
+  encoderRestarted(11),
+  stageRestarted(12),
+  cpuGovernorChanged(13),
+  secondaryOutputEnded(14);
+
+  const RecorderEventType(this.code);
+
+  final int code;
+
+  static RecorderEventType? fromCode(int code) {
+    for (final type in values) {
+      if (type.code == code) return type;
+    }
+    return null;
+  }
+}
+
+/// 네이티브 녹화 이벤트 한 건
+///
+/// [value]/[message] 의미는 종류별로 다름:
+/// - stageStalled: 정체 시간(ms) / 단계 이름
+/// - deviceLost, deviceRecovered: - / 소스 이름 (dxgi, wasapi)
+/// - segmentClosed: 기록한 바이트 / 파일 경로
+/// - stopped: 중지 요청 → 파일 닫힘 시간(ms) / -
+/// - stoppedWithError: 중지 요청 → 파일 닫힘 시간(ms) / 오류 원인
+/// - finalizeCompleted: 성공 1, 실패 0 / 결과 파일 경로
+/// - preRollCommitted: 커밋 시점 이전 길이(ms) / 녹화 중 파일 경로
+/// - encoderRestarted: 재시작 횟수 / 새 세그먼트 파일 경로
+/// - stageRestarted: 정체 감지 → 진행 재개 시간(ms) / 단계 이름 (capture, audio, encoder)
+/// - cpuGovernorChanged: 새 조절 단계 (0 = 원래 설정) / 판단 JSON (action, reason, recorder_cpu, system_cpu, fps, preset ...)
+/// - secondaryOutputEnded: 보조 출력이 담은 마지막 세그먼트 번호 (1 = 첫 파일) / 보조 출력 경로
+class RecorderEvent {
+  final RecorderEventType type;
+  final int elapsedMs;
+  final int value;
+  final String message;
+
+  /// 발생한 세션 핸들 (기본 세션과 세션 무관 이벤트는 0)
+  final int sessionId;
+
+  const RecorderEvent({
+    required this.type,
+    required this.elapsedMs,
+    required this.value,
+    required this.message,
+    this.sessionId = 0,
+  });
+
+  @override
+  String toString() =>
+      'RecorderEvent(${type.name}, session=$sessionId, ${elapsedMs}ms, value=$value, $message)';
+}
+
+/// 네이티브 녹화 이벤트 스트림 (폴링 없이 발생 즉시 수신)
+///
+/// 네이티브 스레드가 Dart_PostCObject로 [type, elapsed_ms, value, message, session]을 ReceivePort에 보냄
+/// 앱 전체에서 하나만 사용 (포트는 마지막으로 연결한 것만 유효)
+class NativeRecorderEvents {
+  NativeRecorderEvents._();
+
+  static ReceivePort? _port;
+  static final StreamController<RecorderEvent> _controller =
+      StreamController<RecorderEvent>.broadcast();
+
+  /// 이벤트 스트림 (첫 구독 전에 [connect] 필요)
+  static Stream<RecorderEvent> get stream => _controller.stream;
+
+  /// 네이티브 포트 연결 (여러 번 호출해도 한 번만 연결)
+  ///
+  /// 출력: 성공 시 true, Dart API 초기화 실패(SDK 버전 불일치) 시 false
+  static bool connect() {
+    if (_port != null) return true;
+    if (NativeRecorderBindings.initializeDartApi(ffi.NativeApi.initializeApiDLData) != 0) {
+      return false;
+    }
+
+    final port = ReceivePort('NativeRecorderEvents');
+    port.listen((message) {
+      if (message is! List || message.length < 4) return;
+      final type = RecorderEventType.fromCode(message[0] as int);
+      if (type == null) return;
+      _controller.add(RecorderEvent(
+        type: type,
+        elapsedMs: message[1] as int,
+        value: message[2] as int,
+        message: message[3] as String,
+        sessionId: message.length > 4 ? message[4] as int : 0,
+      ));
+    });
+    NativeRecorderBindings.setEventPort(port.sendPort.nativePort);
+    _port = port;
+    return true;
+  }
+
+  /// 네이티브 포트 해제 (앱 종료 시)
+  static void disconnect() {
+    final port = _port;
+    if (port == null) return;
+    NativeRecorderBindings.setEventPort(0);
+    port.close();
+    _port = null;
+  }
+}
+
+/// 편의 함수: 네이티브 로그를 Dart 로그 파일에 함께 기록
+///
+/// 입력: [logPath] LoggerService의 현재 로그 파일 경로
+/// 출력: 없음 (네이티브 로거가 100ms마다 파일 끝에 추가)
+void setNativeLogFilePath(String logPath) {
+  final pathPtr = logPath.toNativeUtf8();
+  try {
+    NativeRecorderBindings.setLogFilePath(pathPtr);
+  } finally {
+    malloc.free(pathPtr);
+  }
+}
+
+/// 편의 함수: 파이프라인 trace 기록 시작
+///
+/// 입력: [outputPath] trace JSON 경로
+/// 출력: 네이티브 결과 코드 (0 성공, -1 인자 오류, -2 이미 기록 중이거나 파일 열기 실패)
+int startNativeTrace(String outputPath) {
+  final pathPtr = outputPath.toNativeUtf8();
+  try {
+    return NativeRecorderBindings.startTrace(pathPtr);
+  } finally {
+    malloc.free(pathPtr);
+  }
+}
+
+/// 편의 함수: 캡처 trace 경로 설정 (다음 녹화부터 적용)
+///
+/// 입력: [outputPath] trace 파일 경로 (빈 문자열이면 기록 안 함)
+/// 출력: 네이티브 결과 코드 (항상 0)
+int setNativeCaptureTracePath(String outputPath) {
+  final pathPtr = outputPath.toNativeUtf8();
+  try {
+    return NativeRecorderBindings.setCaptureTracePath(pathPtr);
+  } finally {
+    malloc.free(pathPtr);
+  }
+}
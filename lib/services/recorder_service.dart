@@ -10,6 +10,7 @@ import 'package:path/path.dart' as path;
 import 'package:logger/logger.dart';
 import 'package:ffi/ffi.dart';
 import '../ffi/native_bindings.dart';
+import 'logger_service.dart';
 import 'tray_service.dart';  // Phase 3.2.3
 
 final _logger = Logger(
@@ -30,26 +31,134 @@ class RecorderService {
   DateTime? _sessionStartTime;
   String? _currentFilePath;
 
-  /// 녹화 중 여부
+  // 네이티브 이벤트로 갱신하는 녹화 상태 (화면마다 인스턴스가 있으므로 공유)
+  static StreamSubscription<RecorderEvent>? _eventSubscription;
+  static bool _isRecordingState = false;
+  static Completer<void>? _finalizeCompleter;
+  static final List<String> _finalizedPaths = [];
+  static Completer<void>? _stopCompleter;
+
+  /// 이 서비스가 쓰는 네이티브 세션 (기본 세션, NativeRecorder_StartRecording 등)
+  static const int _sessionHandle = 0;
+
+  /// 녹화 중 여부 (네이티브 이벤트로 갱신, 이벤트 연결 실패 시 FFI 조회)
   bool get isRecording {
     if (!_isInitialized) return false;
-    return NativeRecorderBindings.isRecording() == 1;
+    if (_eventSubscription == null) {
+      return NativeRecorderBindings.isRecording() == 1;
+    }
+    return _isRecordingState;
   }
 
+  /// 네이티브 녹화 이벤트 (시작, 첫 프레임, 정체, 장치 손실/복구, 파일 닫힘, 종료, 후처리 완료)
+  Stream<RecorderEvent> get events => NativeRecorderEvents.stream;
+
   /// 초기화
   Future<void> initialize() async {
     if (_isInitialized) return;
 
+    // 네이티브 로그도 LoggerService와 같은 파일에 기록 (초기화 로그 포함)
+    final logPath = LoggerService.instance.currentLogFilePath;
+    if (logPath != null) {
+      setNativeLogFilePath(logPath);
+    }
+
     final result = NativeRecorderBindings.initialize();
     if (result != 0) {
       final error = getNativeLastError();
       throw Exception('네이티브 녹화 초기화 실패: $error');
     }
 
+    // 상태 변화는 네이티브가 ReceivePort로 바로 보냄 (폴링 없음)
+    if (_eventSubscription == null) {
+      if (NativeRecorderEvents.connect()) {
+        _eventSubscription = NativeRecorderEvents.stream.listen(_onRecorderEvent);
+      } else {
+        _logger.w('⚠️ 네이티브 이벤트 연결 실패 (Dart SDK 버전 불일치), 녹화 상태는 FFI로 조회');
+      }
+    }
+
     _isInitialized = true;
     _logger.i('✅ 네이티브 녹화 초기화 완료');
   }
 
+  /// 네이티브 녹화 이벤트 처리
+  ///
+  /// 다른 세션(NativeRecorder_Session*으로 만든 동시 녹화)의 이벤트는 기록만 하고 상태를 바꾸지 않음
+  static void _onRecorderEvent(RecorderEvent event) {
+    if (event.sessionId != _sessionHandle) {
+      _logger.d('다른 세션 이벤트 무시: $event');
+      return;
+    }
+    switch (event.type) {
+      case RecorderEventType.recordingStarted:
+        _logger.i('🎬 네이티브 녹화 시작: ${event.message}');
+      case RecorderEventType.firstFrameEncoded:
+        _logger.i('🎞️ 첫 프레임 인코딩 완료 (${event.elapsedMs}ms)');
+      case RecorderEventType.stageStalled:
+        _logger.w('⚠️ ${event.message} 단계 정체 (${event.value}ms, 녹화 ${event.elapsedMs}ms 시점)');
+      case RecorderEventType.deviceLost:
+        _logger.w('⚠️ 캡처 장치 손실: ${event.message} (녹화 ${event.elapsedMs}ms 시점)');
+      case RecorderEventType.deviceRecovered:
+        _logger.i('✅ 캡처 장치 복구: ${event.message}');
+      case RecorderEventType.segmentClosed:
+        _logger.i('📁 녹화 파일 닫힘: ${event.message} '
+            '(${(event.value / (1024 * 1024)).toStringAsFixed(2)} MB)');
+      case RecorderEventType.stopped:
+        _isRecordingState = false;
+        _logger.i('⏹️ 녹화 종료 처리 완료 (${event.value}ms)');
+        _completeStop();
+      case RecorderEventType.stoppedWithError:
+        _isRecordingState = false;
+        _logger.e('❌ 녹화 오류 종료: ${event.message}');
+        _completeStop();
+        unawaited(_notifyRecordingError(event.message));
+      case RecorderEventType.finalizeCompleted:
+        if (event.value == 0) {
+          _logger.w('⚠️ faststart 후처리 실패, 원본 유지: ${event.message}');
+        } else {
+          _finalizedPaths.add(event.message);
+        }
+        // 여러 파일(이중 출력)을 처리 중이면 마지막 완료 이벤트까지 대기
+        final completer = _finalizeCompleter;
+        if (completer != null && NativeRecorderBindings.isFinalizing() == 0) {
+          _finalizeCompleter = null;
+          completer.complete();
+        }
+      case RecorderEventType.preRollCommitted:
+        _logger.i('⏺️ pre-roll 커밋: 커밋 시점 이전 ${event.value}ms 포함, 파일 기록 시작 (${event.message})');
+      case RecorderEventType.encoderRestarted:
+        _logger.w('⚠️ 인코더 재시작 #${event.value}, 새 세그먼트: ${event.message} '
+            '(녹화 ${event.elapsedMs}ms 시점)');
+      case RecorderEventType.stageRestarted:
+        _logger.i('✅ ${event.message} 단계 재시작 후 복구 (${event.value}ms)');
+      case RecorderEventType.cpuGovernorChanged:
+        _logger.i('⚖️ CPU 예산 조절 단계 ${event.value}: ${event.message}');
+      case RecorderEventType.secondaryOutputEnded:
+        _logger.w('⚠️ 인코더 재시작으로 보조 출력 종료 (세그먼트 ${event.value}까지만 기록): ${event.message}');
+    }
+  }
+
+  /// 중지 요청을 기다리는 stopRecording 깨우기
+  static void _completeStop() {
+    final completer = _stopCompleter;
+    if (completer != null) {
+      _stopCompleter = null;
+      completer.complete();
+    }
+  }
+
+  /// 녹화 오류 종료 알림 (트레이)
+  static Future<void> _notifyRecordingError(String message) async {
+    final trayService = TrayService();
+    if (!trayService.isInitialized) return;
+    await trayService.updateRecordingStatus(false);
+    await trayService.showNotification(
+      title: '녹화 오류',
+      message: '녹화가 중단되었습니다: $message',
+    );
+  }
+
   /// 녹화 시작
   ///
   /// @param durationSeconds 녹화 시간 (초 단위)
@@ -89,6 +198,7 @@ class RecorderService {
         malloc.free(pathPtr);
       }
 
+      _isRecordingState = true;
       _sessionStartTime = DateTime.now();
       _currentFilePath = outputPath;
       _logger.i('✅ 녹화 시작 완료');
@@ -127,12 +237,23 @@ class RecorderService {
     try {
       _logger.i('⏹️  녹화 중지 요청');
 
-      // 네이티브 녹화 중지
+      // 네이티브 녹화 중지 (캡처만 멈추고 바로 반환, 큐 비우기/파일 닫기는 백그라운드)
+      final completer = _stopCompleter ??= Completer<void>();
       final result = NativeRecorderBindings.stopRecording();
       if (result != 0) {
+        _stopCompleter = null;
         final error = getNativeLastError();
         throw Exception('네이티브 녹화 중지 실패: $error');
       }
+      _isRecordingState = false;
+      _finalizedPaths.clear();
+      await _waitForStopped(completer);
+
+      // 인코더 재시작으로 세그먼트가 나뉘었으면 후처리가 출력 파일 하나로 이어붙임
+      final segments = getNativeSegmentPaths();
+      if (segments.length > 1) {
+        _logger.i('🧩 인코더 재시작 세그먼트 ${segments.length}개 이어붙이기 예약');
+      }
 
       // 통계 출력
       if (_sessionStartTime != null) {
@@ -141,8 +262,22 @@ class RecorderService {
         _logger.i('  - 시작 시각: ${_sessionStartTime!.toIso8601String()}');
         _logger.i('  - 총 녹화 시간: ${duration.inSeconds}초');
       }
+      for (final stage in getNativePipelineStats()) {
+        _logger.i('  - 지연 $stage');
+      }
+      final queueStats = getNativeQueueStats();
+      if (queueStats != null) {
+        if (queueStats.hasDrops) {
+          _logger.w('  - ⚠️ 큐 $queueStats');
+        } else {
+          _logger.i('  - 큐 $queueStats');
+        }
+      }
       _sessionStartTime = null;
 
+      // faststart 후처리(백그라운드)가 끝나야 최종 파일이 완성됨
+      await _waitForFinalization();
+
       // 파일 정보
       final filePath = _currentFilePath;
       if (filePath != null) {
@@ -156,6 +291,13 @@ class RecorderService {
           _logger.w('⚠️  파일이 생성되지 않음: $filePath');
         }
       }
+      if (segments.length > 1 && _finalizedPaths.length > 1) {
+        // 이어붙이기 실패: 첫 세그먼트는 출력 경로, 이후는 <이름>_part<N>.mp4로 각각 남음
+        _logger.w('⚠️  세그먼트 이어붙이기 실패, 파일 ${_finalizedPaths.length}개로 저장됨');
+        for (final path in _finalizedPaths) {
+          _logger.w('  - $path');
+        }
+      }
 
       _logger.i('✅ 녹화 중지 완료');
 
@@ -183,6 +325,54 @@ class RecorderService {
     }
   }
 
+  /// 네이티브 종료 처리(파일 닫힘) 완료 대기
+  ///
+  /// 네이티브는 종료 처리 기한(기본 10초)을 넘기면 남은 큐를 버리므로 보통 그 안에 끝남.
+  /// 완료는 stopped/stoppedWithError 이벤트로 받고, 이벤트가 없으면 FFI로 조회
+  Future<void> _waitForStopped(
+    Completer<void> completer, {
+    Duration timeout = const Duration(seconds: 30),
+  }) async {
+    if (_eventSubscription == null) {
+      final deadline = DateTime.now().add(timeout);
+      while (NativeRecorderBindings.isStopping() == 1 && DateTime.now().isBefore(deadline)) {
+        await Future<void>.delayed(const Duration(milliseconds: 50));
+      }
+      return;
+    }
+    if (NativeRecorderBindings.isStopping() == 0) {
+      _completeStop();
+    }
+    try {
+      await completer.future.timeout(timeout);
+    } on TimeoutException {
+      _logger.w('⚠️  녹화 종료 처리 대기 시간 초과 (백그라운드에서 계속 진행)');
+    }
+  }
+
+  /// 네이티브 faststart 후처리 완료 대기
+  ///
+  /// 후처리는 네이티브 백그라운드 스레드에서 진행되므로 UI는 막히지 않음.
+  /// 완료는 finalizeCompleted 이벤트로 받고, 제한 시간을 넘기면 그대로 진행 (원본 fragmented MP4도 재생 가능)
+  Future<void> _waitForFinalization({
+    Duration timeout = const Duration(minutes: 5),
+  }) async {
+    if (NativeRecorderBindings.isFinalizing() == 0) return;
+    if (_eventSubscription == null) {
+      _logger.w('⚠️  이벤트 미연결, faststart 후처리는 백그라운드에서 계속 진행');
+      return;
+    }
+
+    _logger.i('🔧 faststart 후처리 대기 중...');
+    final completer = _finalizeCompleter ??= Completer<void>();
+    try {
+      await completer.future.timeout(timeout);
+      _logger.i('✅ faststart 후처리 완료');
+    } on TimeoutException {
+      _logger.w('⚠️  faststart 후처리 대기 시간 초과 (백그라운드에서 계속 진행)');
+    }
+  }
+
   /// 저장 파일 경로 생성
   ///
   /// @return 절대 경로 (예: C:\SatLecRec\recordings\20251022_0835_test.mp4)
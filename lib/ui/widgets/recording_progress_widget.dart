@@ -30,12 +30,16 @@ class RecordingProgress {
   /// 오디오 Peak 레벨 (0.0 ~ 1.0) - Phase 3.1.2
   final double audioPeakLevel;
 
+  /// 드롭/반복 프레임 및 큐 깊이 (조회 실패 시 null)
+  final RecorderQueueStats? queueStats;
+
   RecordingProgress({
     required this.elapsedMs,
     required this.videoFrameCount,
     required this.audioSampleCount,
     required this.audioLevel,
     required this.audioPeakLevel,
+    this.queueStats,
   });
 
   /// 경과 시간을 MM:SS 형식 문자열로 변환
@@ -56,8 +60,8 @@ class RecordingProgress {
 
 /// 녹화 진행률 표시 위젯
 ///
-/// 녹화 중일 때 1초마다 FFI를 통해 네이티브 레이어에서
-/// 진행 상황을 가져와 UI를 업데이트합니다.
+/// 녹화 중일 때 250ms마다 네이티브 실시간 통계 블록(공유 메모리)을 읽어
+/// UI를 업데이트합니다. (블록 주소를 받을 때 외에는 FFI 호출 없음)
 class RecordingProgressWidget extends StatefulWidget {
   const RecordingProgressWidget({super.key});
 
@@ -67,6 +71,7 @@ class RecordingProgressWidget extends StatefulWidget {
 
 class _RecordingProgressWidgetState extends State<RecordingProgressWidget> {
   Timer? _updateTimer;
+  NativeLiveStatsReader? _liveStats;
   RecordingProgress? _progress;
   bool _isRecording = false;
 
@@ -82,20 +87,25 @@ class _RecordingProgressWidgetState extends State<RecordingProgressWidget> {
     super.dispose();
   }
 
-  /// 1초마다 FFI를 통해 진행 상황 업데이트
+  /// 250ms마다 진행 상황 업데이트 (메모리 읽기만 하므로 레벨 미터가 부드럽게 움직임)
   void _startUpdateTimer() {
-    _updateTimer = Timer.periodic(const Duration(seconds: 1), (_) {
+    _updateTimer = Timer.periodic(const Duration(milliseconds: 250), (_) {
       _updateProgress();
     });
   }
 
-  /// 네이티브 레이어에서 진행 상황 가져오기
+  /// 네이티브 실시간 통계 블록에서 진행 상황 가져오기
   void _updateProgress() {
     try {
-      // FFI 호출
-      final isRecording = NativeRecorderBindings.isRecording() == 1;
+      // 블록 주소는 처음 한 번만 FFI로 받아 둠
+      _liveStats ??= NativeLiveStatsReader();
+      final stats = _liveStats!.read();
+      if (stats == null) {
+        // 갱신 중이라 일관된 값을 못 읽었거나 블록 버전이 다름 → 다음 주기에 다시 시도
+        return;
+      }
 
-      if (!isRecording) {
+      if (!stats.recording) {
         // 녹화 중이 아니면 상태 초기화
         if (_isRecording) {
           setState(() {
@@ -107,22 +117,16 @@ class _RecordingProgressWidgetState extends State<RecordingProgressWidget> {
       }
 
       // 녹화 중이면 진행 상황 업데이트
-      final elapsedMs = NativeRecorderBindings.getElapsedTimeMs();
-      final videoFrameCount = NativeRecorderBindings.getVideoFrameCount();
-      final audioSampleCount = NativeRecorderBindings.getAudioSampleCount();
-
-      // Phase 3.1.2: 오디오 레벨 조회
-      final audioLevel = NativeRecorderBindings.getAudioLevel();
-      final audioPeakLevel = NativeRecorderBindings.getAudioPeakLevel();
-
+      // 큐 압력: 드롭이 있으면 설정한 fps를 유지하지 못하는 상태
       setState(() {
         _isRecording = true;
         _progress = RecordingProgress(
-          elapsedMs: elapsedMs,
-          videoFrameCount: videoFrameCount,
-          audioSampleCount: audioSampleCount,
-          audioLevel: audioLevel,
-          audioPeakLevel: audioPeakLevel,
+          elapsedMs: stats.elapsedMs,
+          videoFrameCount: stats.videoFrames,
+          audioSampleCount: stats.audioSamples,
+          audioLevel: stats.audioLevel,
+          audioPeakLevel: stats.audioPeakLevel,
+          queueStats: stats.queueStats,
         );
       });
     } catch (e) {
@@ -196,10 +200,52 @@ class _RecordingProgressWidgetState extends State<RecordingProgressWidget> {
             ],
           ),
         ),
+        if (progress.queueStats != null) ...[
+          const SizedBox(height: 8),
+          _buildQueueStats(progress.queueStats!),
+        ],
       ],
     );
   }
 
+  /// 드롭/반복 프레임 및 큐 최대 깊이 표시
+  /// 드롭이 있으면 경고 색상으로 강조
+  Widget _buildQueueStats(RecorderQueueStats stats) {
+    final color = stats.hasDrops ? AppColors.recordingActive : AppColors.textSecondary;
+    final style = AppTypography.bodySmall.copyWith(
+      color: color,
+      fontWeight: FontWeight.w500,
+      fontFeatures: [const FontFeature.tabularFigures()],
+    );
+
+    return Container(
+      padding: const EdgeInsets.symmetric(vertical: 6, horizontal: 12),
+      decoration: BoxDecoration(
+        color: AppColors.neutral100,
+        borderRadius: BorderRadius.circular(8),
+      ),
+      child: Row(
+        mainAxisAlignment: MainAxisAlignment.spaceAround,
+        children: [
+          Icon(
+            stats.hasDrops ? Icons.warning_amber_rounded : Icons.speed_outlined,
+            size: 14,
+            color: color,
+          ),
+          Text('드롭 ${stats.droppedVideoFrames}f / ${stats.droppedAudioMs}ms', style: style),
+          _buildVerticalDivider(),
+          Text('반복 ${stats.repeatedVideoFrames}f', style: style),
+          _buildVerticalDivider(),
+          Text(
+            '큐 ${stats.videoQueueHighWater}/${stats.videoQueueCapacity} · '
+            '${stats.audioQueueHighWater}/${stats.audioQueueCapacity}',
+            style: style,
+          ),
+        ],
+      ),
+    );
+  }
+
   Widget _buildVerticalDivider() {
     return Container(
       width: 1,
@@ -0,0 +1,1506 @@
+// 녹화 코어 벤치마크 (Google Benchmark)
+// 합성 BGRA 프레임 / PCM 오디오로 인코더 단계별 처리량 측정
+//
+// 사용:
+//   cmake -S native -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build
+//   ./build/bench/satrec_core_bench --benchmark_filter=EncodeVideo
+//
+// 캡처 타임스탬프는 ManualMediaClock으로 생성하므로 실제 시간과 무관하게
+// 프레임 간격이 항상 1/fps (PTS 충돌/보정 없이 인코더 자체 비용만 측정)
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "capture_queue.h"
+#include "capture_source.h"
+#include "cpu_governor.h"
+#include "frame_converter.h"
+#include "generator_source.h"
+#include "libav_encoder.h"
+#include "live_stats.h"
+#include "media_clock.h"
+#include "mp4_finalizer.h"
+#include "native_logger.h"
+#include "packet_journal.h"
+#include "recorder_session.h"
+#include "recording_pipeline.h"
+#include "shared_frame_ring.h"
+#include "thread_policy.h"
+#include "trace_recorder.h"
+
+// LibavEncoder 내부 단계 접근 (libav_encoder.h의 friend 선언)
+class LibavEncoderBenchAccess {
+public:
+    static bool Convert(LibavEncoder& encoder, const uint8_t* bgra) {
+        return encoder.ConvertBGRAToYUV420(bgra, encoder.video_frame_);
+    }
+
+    // 변환된 프레임을 PTS와 함께 인코더에 넣기 (패킷 수신은 하지 않음)
+    static bool SendFrameOnly(LibavEncoder& encoder, int64_t pts) {
+        encoder.video_frame_->pts = pts;
+        return avcodec_send_frame(encoder.video_codec_ctx_, encoder.video_frame_) >= 0;
+    }
+
+    static bool ReceiveVideoPackets(LibavEncoder& encoder) {
+        return encoder.ReceiveAndWritePackets(encoder.video_codec_ctx_,
+                                              encoder.video_stream_->index);
+    }
+
+    // av_interleaved_write_frame 누적 시간/패킷 수 (컨테이너 비교)
+    static int64_t MuxWriteTimeNs(const LibavEncoder& encoder) { return encoder.mux_write_time_ns_; }
+    static int64_t MuxPacketCount(const LibavEncoder& encoder) { return encoder.mux_packet_count_; }
+};
+
+namespace {
+
+constexpr int kFps = 24;
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int kAudioChunkFrames = kSampleRate / 100;  // WASAPI 기본 주기 10ms
+constexpr int kSyntheticFrameCount = 8;               // 움직이는 화면 순환 프레임 수
+
+// 입력: 해상도, 프레임 번호
+// 출력: BGRA 프레임 (가로 그라데이션 배경 + 프레임마다 이동하는 사각형)
+// 정적 화면이면 x264가 거의 일을 하지 않으므로 프레임마다 내용을 바꿈
+std::vector<uint8_t> MakeSyntheticFrame(int width, int height, int index) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    const int box_size = height / 4;
+    const int box_x = (index * width / kSyntheticFrameCount) % (width - box_size);
+    const int box_y = height / 3;
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = pixels.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            const bool in_box = x >= box_x && x < box_x + box_size &&
+                                y >= box_y && y < box_y + box_size;
+            row[x * 4 + 0] = in_box ? 32 : static_cast<uint8_t>(x * 255 / width);
+            row[x * 4 + 1] = in_box ? 200 : static_cast<uint8_t>(y * 255 / height);
+            row[x * 4 + 2] = in_box ? 240 : 96;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return pixels;
+}
+
+std::vector<std::vector<uint8_t>> MakeSyntheticFrames(int width, int height) {
+    std::vector<std::vector<uint8_t>> frames;
+    frames.reserve(kSyntheticFrameCount);
+    for (int i = 0; i < kSyntheticFrameCount; ++i) {
+        frames.push_back(MakeSyntheticFrame(width, height, i));
+    }
+    return frames;
+}
+
+// 출력: 10ms 분량 Interleaved Float32 스테레오 (440Hz 사인파)
+std::vector<float> MakeSyntheticAudioChunk(int chunk_index) {
+    std::vector<float> samples(static_cast<size_t>(kAudioChunkFrames) * kChannels);
+    const double two_pi = 6.283185307179586;
+    for (int i = 0; i < kAudioChunkFrames; ++i) {
+        const double t = static_cast<double>(chunk_index * kAudioChunkFrames + i) / kSampleRate;
+        const float value = static_cast<float>(0.25 * std::sin(two_pi * 440.0 * t));
+        samples[static_cast<size_t>(i) * kChannels + 0] = value;
+        samples[static_cast<size_t>(i) * kChannels + 1] = value;
+    }
+    return samples;
+}
+
+std::filesystem::path BenchOutputPath(const char* name, int width, int height) {
+    return std::filesystem::temp_directory_path() /
+           (std::string("satrec_bench_") + name + "_" + std::to_string(width) + "x" +
+            std::to_string(height) + ".mp4");
+}
+
+// 입력: 벤치마크 상태, 출력 이름, 해상도, 시계
+// 출력: 실행 중인 인코더 (실패 시 state.SkipWithError 후 false)
+bool StartEncoder(benchmark::State& state, LibavEncoder& encoder, const std::filesystem::path& path,
+                  int width, int height, const MediaClock& clock, bool preroll = false) {
+    LibavEncoderConfig config;
+    config.start_in_preroll = preroll;
+    config.output_path = path.wstring();
+    config.video_width = width;
+    config.video_height = height;
+    config.video_fps = kFps;
+    config.audio_sample_rate = kSampleRate;
+    config.audio_channels = kChannels;
+    config.clock = &clock;
+    if (!encoder.Start(config)) {
+        state.SkipWithError(encoder.GetLastError().c_str());
+        return false;
+    }
+    return true;
+}
+
+void StopEncoder(LibavEncoder& encoder, const std::filesystem::path& path) {
+    encoder.Stop();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+uint64_t FrameTicks(const ManualMediaClock& clock, int64_t frame_index) {
+    return static_cast<uint64_t>(frame_index) * clock.Frequency() / kFps;
+}
+
+// 짧게 인코딩한 클립의 패킷 (수 GB 합성 파일/저널은 이 패킷을 타임스탬프만 밀어 반복해서 만듦)
+// 실제 녹화와 같은 LibavEncoder 출력이라 코덱 파라미터/패킷 크기 분포가 같음
+class EncodedClip {
+public:
+    EncodedClip() = default;
+    ~EncodedClip() { Reset(); }
+
+    EncodedClip(const EncodedClip&) = delete;
+    EncodedClip& operator=(const EncodedClip&) = delete;
+
+    // 입력: 해상도, 길이(초) / 출력: 비디오+오디오 패킷 (실패 시 false + error)
+    bool Create(int width, int height, int seconds, std::string* error) {
+        Reset();
+        const auto path = BenchOutputPath("clip", width, height);
+        {
+            ManualMediaClock clock;
+            LibavEncoder encoder;
+            LibavEncoderConfig config;
+            config.output_path = path.wstring();
+            config.video_width = width;
+            config.video_height = height;
+            config.video_fps = kFps;
+            config.audio_sample_rate = kSampleRate;
+            config.audio_channels = kChannels;
+            config.clock = &clock;
+            if (!encoder.Start(config)) {
+                *error = encoder.GetLastError();
+                return false;
+            }
+            const auto frames = MakeSyntheticFrames(width, height);
+            int64_t chunk = 0;
+            for (int64_t i = 0; i < static_cast<int64_t>(seconds) * kFps; i++) {
+                clock.Set(FrameTicks(clock, i));
+                const auto& frame = frames[static_cast<size_t>(i % kSyntheticFrameCount)];
+                bool ok = encoder.EncodeVideo(frame.data(), frame.size(), clock.Now());
+                // 다음 프레임 시각 전까지의 오디오 10ms 청크
+                for (; ok && chunk * kFps < (i + 1) * 100; chunk++) {
+                    const auto audio = MakeSyntheticAudioChunk(static_cast<int>(chunk));
+                    clock.Set(static_cast<uint64_t>(chunk) * clock.Frequency() / 100);
+                    ok = encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(audio.data()),
+                                             audio.size() * sizeof(float), clock.Now());
+                }
+                if (!ok) {
+                    *error = encoder.GetLastError();
+                    encoder.Stop();
+                    return false;
+                }
+            }
+            encoder.Stop();
+        }
+
+        const std::string utf8_path = path.u8string();
+        bool ok = avformat_open_input(&input_, utf8_path.c_str(), nullptr, nullptr) >= 0 &&
+                  avformat_find_stream_info(input_, nullptr) >= 0;
+        if (ok) {
+            first_dts_.assign(input_->nb_streams, AV_NOPTS_VALUE);
+            durations_.assign(input_->nb_streams, 0);
+            AVPacket* pkt = av_packet_alloc();
+            while (av_read_frame(input_, pkt) >= 0) {
+                const auto stream = static_cast<size_t>(pkt->stream_index);
+                if (first_dts_[stream] == AV_NOPTS_VALUE) first_dts_[stream] = pkt->dts;
+                durations_[stream] = pkt->dts + pkt->duration - first_dts_[stream];
+                bytes_ += pkt->size;
+                packets_.push_back(av_packet_clone(pkt));
+                av_packet_unref(pkt);
+            }
+            av_packet_free(&pkt);
+            ok = !packets_.empty();
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (!ok) *error = "클립 패킷 읽기 실패";
+        return ok;
+    }
+
+    // 스트림 정보 (PacketJournalWriter::Open, 출력 스트림 복사용)
+    const AVFormatContext* format() const { return input_; }
+    const std::vector<AVPacket*>& packets() const { return packets_; }
+    int64_t bytes() const { return bytes_; }
+
+    // 입력: 원본 패킷, 반복 번호 / 출력: 반복 번호만큼 스트림별 클립 길이를 더한 패킷 (out은 호출자가 unref)
+    void ShiftedCopy(const AVPacket* packet, int64_t repeat, AVPacket* out) const {
+        av_packet_ref(out, packet);
+        const int64_t offset = repeat * durations_[static_cast<size_t>(packet->stream_index)];
+        if (out->pts != AV_NOPTS_VALUE) out->pts += offset;
+        if (out->dts != AV_NOPTS_VALUE) out->dts += offset;
+    }
+
+private:
+    void Reset() {
+        for (AVPacket*& packet : packets_) av_packet_free(&packet);
+        packets_.clear();
+        if (input_) avformat_close_input(&input_);
+        bytes_ = 0;
+    }
+
+    AVFormatContext* input_ = nullptr;
+    std::vector<AVPacket*> packets_;
+    std::vector<int64_t> first_dts_;
+    std::vector<int64_t> durations_;  // 스트림별 클립 길이 (stream time_base)
+    int64_t bytes_ = 0;
+};
+
+// 입력: 클립, 출력 경로/muxer 이름/muxer 옵션, 목표 크기
+// 출력: 클립을 목표 크기까지 반복해 mux한 파일, packet_count에 쓴 패킷 수 (실패 시 false + error)
+bool WriteRepeatedClip(const EncodedClip& clip, const std::filesystem::path& path, const char* muxer,
+                       const char* movflags, int64_t target_bytes, int64_t* packet_count, std::string* error) {
+    const std::string utf8_path = path.u8string();
+    AVFormatContext* out = nullptr;
+    if (avformat_alloc_output_context2(&out, nullptr, muxer, utf8_path.c_str()) < 0) {
+        *error = "출력 컨텍스트 생성 실패";
+        return false;
+    }
+    const AVFormatContext* in = clip.format();
+    bool ok = true;
+    for (unsigned i = 0; ok && i < in->nb_streams; i++) {
+        AVStream* stream = avformat_new_stream(out, nullptr);
+        ok = stream && avcodec_parameters_copy(stream->codecpar, in->streams[i]->codecpar) >= 0;
+        if (ok) {
+            stream->codecpar->codec_tag = 0;
+            stream->time_base = in->streams[i]->time_base;
+        }
+    }
+    AVDictionary* options = nullptr;
+    if (movflags) av_dict_set(&options, "movflags", movflags, 0);
+    ok = ok && avio_open(&out->pb, utf8_path.c_str(), AVIO_FLAG_WRITE) >= 0 &&
+         avformat_write_header(out, &options) >= 0;
+    av_dict_free(&options);
+
+    int64_t written = 0;
+    AVPacket* packet = av_packet_alloc();
+    for (int64_t repeat = 0; ok && avio_tell(out->pb) < target_bytes; repeat++) {
+        for (const AVPacket* source : clip.packets()) {
+            clip.ShiftedCopy(source, repeat, packet);
+            const AVRational in_tb = in->streams[packet->stream_index]->time_base;
+            av_packet_rescale_ts(packet, in_tb, out->streams[packet->stream_index]->time_base);
+            if (av_interleaved_write_frame(out, packet) < 0) {
+                ok = false;
+                break;
+            }
+            written++;
+        }
+    }
+    av_packet_free(&packet);
+    if (ok) ok = av_write_trailer(out) >= 0;
+    if (out->pb) avio_closep(&out->pb);
+    avformat_free_context(out);
+    if (!ok) {
+        *error = "합성 파일 쓰기 실패";
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+    *packet_count = written;
+    return true;
+}
+
+// BGRA → YUV420P 변환 (sws_scale)
+void BM_ConvertBGRAToYUV420(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const auto frames = MakeSyntheticFrames(width, height);
+    const auto path = BenchOutputPath("convert", width, height);
+
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    if (!StartEncoder(state, encoder, path, width, height, clock)) return;
+
+    int64_t index = 0;
+    for (auto _ : state) {
+        const auto& frame = frames[static_cast<size_t>(index % kSyntheticFrameCount)];
+        if (!LibavEncoderBenchAccess::Convert(encoder, frame.data())) {
+            state.SkipWithError("ConvertBGRAToYUV420 실패");
+            break;
+        }
+        ++index;
+    }
+
+    state.SetItemsProcessed(index);
+    state.SetBytesProcessed(index * static_cast<int64_t>(width) * height * 4);
+    StopEncoder(encoder, path);
+}
+
+// 프레임 1장 전체 경로 (변환 + H.264 인코딩 + mux)
+void BM_EncodeVideo(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const auto frames = MakeSyntheticFrames(width, height);
+    const auto path = BenchOutputPath("video", width, height);
+
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    if (!StartEncoder(state, encoder, path, width, height, clock)) return;
+
+    int64_t index = 0;
+    for (auto _ : state) {
+        const auto& frame = frames[static_cast<size_t>(index % kSyntheticFrameCount)];
+        clock.Set(FrameTicks(clock, index));
+        if (!encoder.EncodeVideo(frame.data(), frame.size(), clock.Now())) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            break;
+        }
+        ++index;
+    }
+
+    state.SetItemsProcessed(index);
+    // 실시간 녹화 가능 여부: 1.0 이상이면 kFps를 따라감
+    state.counters["realtime_x"] = benchmark::Counter(
+        static_cast<double>(index) / kFps, benchmark::Counter::kIsRate);
+    StopEncoder(encoder, path);
+}
+
+// 캡처 쪽에서 I420으로 변환해 둔 프레임 1장 (평면 복사 + H.264 인코딩 + mux)
+// BM_EncodeVideo와의 차이가 인코더 스레드에서 빠지는 변환 비용
+void BM_EncodeVideoI420(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const auto path = BenchOutputPath("video_i420", width, height);
+
+    FrameConverter converter;
+    std::vector<FrameData> frames;
+    for (auto& pixels : MakeSyntheticFrames(width, height)) {
+        FrameData frame;
+        frame.pixels = std::move(pixels);
+        frame.width = width;
+        frame.height = height;
+        std::string error;
+        if (!converter.ConvertToI420(&frame, &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        frames.push_back(std::move(frame));
+    }
+
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    if (!StartEncoder(state, encoder, path, width, height, clock)) return;
+
+    int64_t index = 0;
+    for (auto _ : state) {
+        const auto& frame = frames[static_cast<size_t>(index % kSyntheticFrameCount)];
+        clock.Set(FrameTicks(clock, index));
+        if (!encoder.EncodeVideoI420(frame.pixels.data(), frame.pixels.size(), clock.Now())) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            break;
+        }
+        ++index;
+    }
+
+    state.SetItemsProcessed(index);
+    state.counters["realtime_x"] = benchmark::Counter(
+        static_cast<double>(index) / kFps, benchmark::Counter::kIsRate);
+    state.counters["frame_mb"] = static_cast<double>(frames[0].pixels.size()) / (1024.0 * 1024.0);
+    StopEncoder(encoder, path);
+}
+
+// 10ms 오디오 청크 (Interleaved → Planar 변환 + AAC 인코딩 + mux)
+void BM_EncodeAudio(benchmark::State& state) {
+    constexpr int kChunkCycle = 100;  // 1초 분량 순환
+    std::vector<std::vector<float>> chunks;
+    for (int i = 0; i < kChunkCycle; ++i) {
+        chunks.push_back(MakeSyntheticAudioChunk(i));
+    }
+    const auto path = BenchOutputPath("audio", 1280, 720);
+
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    if (!StartEncoder(state, encoder, path, 1280, 720, clock)) return;
+
+    int64_t index = 0;
+    for (auto _ : state) {
+        const auto& chunk = chunks[static_cast<size_t>(index % kChunkCycle)];
+        clock.Set(static_cast<uint64_t>(index) * clock.Frequency() / 100);
+        if (!encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(chunk.data()),
+                                 chunk.size() * sizeof(float), clock.Now())) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            break;
+        }
+        ++index;
+    }
+
+    state.SetItemsProcessed(index);
+    state.counters["realtime_x"] = benchmark::Counter(
+        static_cast<double>(index) / 100.0, benchmark::Counter::kIsRate);
+    StopEncoder(encoder, path);
+}
+
+// 패킷 수신 + muxing만 측정 (변환/전송은 타이머 정지 구간)
+void BM_ReceiveAndWritePackets(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const auto frames = MakeSyntheticFrames(width, height);
+    const auto path = BenchOutputPath("mux", width, height);
+
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    if (!StartEncoder(state, encoder, path, width, height, clock)) return;
+
+    int64_t index = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const auto& frame = frames[static_cast<size_t>(index % kSyntheticFrameCount)];
+        const bool sent = LibavEncoderBenchAccess::Convert(encoder, frame.data()) &&
+                          LibavEncoderBenchAccess::SendFrameOnly(encoder, index);
+        state.ResumeTiming();
+        if (!sent || !LibavEncoderBenchAccess::ReceiveVideoPackets(encoder)) {
+            state.SkipWithError("패킷 수신/쓰기 실패");
+            break;
+        }
+        ++index;
+    }
+
+    state.SetItemsProcessed(index);
+    StopEncoder(encoder, path);
+}
+
+// pre-roll 커밋 (링 → 파일 헤더 + 패킷 기록, 재인코딩 없음)
+// range(0)초 분량을 링에 인코딩해 둔 뒤 1.5초 시점을 커밋 시점으로 커밋 한 번만 측정
+// (늦게 호출된 커밋처럼 거의 링 전체를 기록, 인코딩은 타이머 정지 구간)
+void BM_CommitPreRoll(benchmark::State& state) {
+    constexpr int kWidth = 1280;
+    constexpr int kHeight = 720;
+    const int preroll_seconds = static_cast<int>(state.range(0));
+    const auto frames = MakeSyntheticFrames(kWidth, kHeight);
+    const auto chunk = MakeSyntheticAudioChunk(0);
+    const auto path = BenchOutputPath("preroll", kWidth, kHeight);
+
+    int64_t packets = 0;
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ManualMediaClock clock;
+        LibavEncoder encoder;
+        if (!StartEncoder(state, encoder, path, kWidth, kHeight, clock, true)) return;
+        // 비디오 1프레임 + 그 구간의 10ms 오디오 청크를 번갈아 인코딩
+        const int64_t total_frames = static_cast<int64_t>(preroll_seconds) * kFps;
+        int64_t audio_chunk = 0;
+        bool encoded = true;
+        for (int64_t i = 0; encoded && i < total_frames; ++i) {
+            const auto& frame = frames[static_cast<size_t>(i % kSyntheticFrameCount)];
+            clock.Set(FrameTicks(clock, i));
+            encoded = encoder.EncodeVideo(frame.data(), frame.size(), clock.Now());
+            while (encoded && audio_chunk * kFps < (i + 1) * 100) {
+                encoded = encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(chunk.data()),
+                                              chunk.size() * sizeof(float),
+                                              static_cast<uint64_t>(audio_chunk) * clock.Frequency() / 100);
+                ++audio_chunk;
+            }
+        }
+        if (!encoded) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            return;
+        }
+        state.ResumeTiming();
+
+        PreRollCommitInfo info;
+        const bool committed = encoder.CommitPreRoll(clock.Frequency() * 3 / 2, &info);
+
+        state.PauseTiming();
+        if (!committed) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            return;
+        }
+        // 커밋 시점 직전 키프레임부터 시작해야 함 (GOP = 1초)
+        if (info.packet_count == 0 || info.preroll_ms > 1000) {
+            state.SkipWithError("커밋 시작 키프레임이 GOP 범위를 벗어남");
+            return;
+        }
+        packets = info.packet_count;
+        bytes = info.bytes;
+        StopEncoder(encoder, path);
+        state.ResumeTiming();
+    }
+
+    state.counters["packets"] = static_cast<double>(packets);
+    state.counters["ring_mb"] = static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// 큰 녹화 파일의 faststart remux (RemuxToFaststartMp4, 종료 후 Mp4Finalizer가 도는 작업)
+// range(0) GB 분량의 fragmented MP4를 720p 클립 반복으로 만든 뒤 remux 한 번만 측정 (만드는 시간은 제외)
+// 입력 + 출력만큼 임시 폴더 여유 공간이 필요, 복사한 패킷 수가 입력과 다르면 실패
+void BM_RemuxLargeMp4(benchmark::State& state) {
+    const int64_t target_bytes = state.range(0) * 1024LL * 1024 * 1024;
+    const auto input_path = BenchOutputPath("remux_input", 1280, 720);
+    const auto output_path = BenchOutputPath("remux_output", 1280, 720);
+
+    EncodedClip clip;
+    std::string error;
+    int64_t input_packets = 0;
+    if (!clip.Create(1280, 720, 4, &error) ||
+        !WriteRepeatedClip(clip, input_path, "mp4", "frag_keyframe+empty_moov+default_base_moof", target_bytes,
+                           &input_packets, &error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    Mp4FinalizeStats stats;
+    for (auto _ : state) {
+        std::error_code ec;
+        std::filesystem::remove(output_path, ec);
+        const auto started_at = std::chrono::steady_clock::now();
+        const bool ok = RemuxToFaststartMp4(input_path.u8string(), output_path.u8string(), &stats, &error);
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count());
+        if (!ok) {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        if (stats.packet_count != input_packets) {
+            state.SkipWithError("remux한 패킷 수가 입력과 다름");
+            break;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * stats.input_bytes);
+    state.counters["input_gb"] = static_cast<double>(stats.input_bytes) / (1024.0 * 1024.0 * 1024.0);
+    state.counters["packets"] = static_cast<double>(stats.packet_count);
+    state.counters["mb_per_sec"] = stats.throughput_mb_per_sec;
+    std::error_code ec;
+    std::filesystem::remove(input_path, ec);
+    std::filesystem::remove(output_path, ec);
+}
+
+// 입력: 클립, 저널 경로, 목표 크기
+// 출력: 클립을 목표 크기까지 반복해 Append한 패킷 저널, stats에 기록 통계 (실패 시 false + error)
+bool WriteRepeatedJournal(const EncodedClip& clip, const std::filesystem::path& path, int64_t target_bytes,
+                          PacketJournalStats* stats, std::string* error) {
+    PacketJournalWriter journal;
+    if (!journal.Open(path.u8string(), clip.format())) {
+        *error = "저널 열기 실패";
+        return false;
+    }
+    bool ok = true;
+    AVPacket* packet = av_packet_alloc();
+    for (int64_t repeat = 0; ok && journal.GetStats().bytes_written < target_bytes; repeat++) {
+        for (const AVPacket* source : clip.packets()) {
+            clip.ShiftedCopy(source, repeat, packet);
+            ok = journal.Append(packet);
+            av_packet_unref(packet);
+            if (!ok) break;
+        }
+    }
+    av_packet_free(&packet);
+    journal.Close();
+    *stats = journal.GetStats();
+    if (!ok) {
+        *error = "저널 쓰기 실패";
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    return ok;
+}
+
+// 패킷 저널 Append 처리량 (인코더 스레드가 패킷마다 내는 비용, 기본 200ms fflush 주기)
+// range(0) GB 분량을 720p 클립 패킷 반복으로 기록, 측정 시간은 저널이 잰 Append/Flush 시간 합
+void BM_JournalAppend(benchmark::State& state) {
+    const int64_t target_bytes = state.range(0) * 1024LL * 1024 * 1024;
+    const auto path = BenchOutputPath("journal_append", 1280, 720);
+
+    EncodedClip clip;
+    std::string error;
+    if (!clip.Create(1280, 720, 4, &error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    PacketJournalStats stats;
+    for (auto _ : state) {
+        if (!WriteRepeatedJournal(clip, path, target_bytes, &stats, &error)) {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        state.SetIterationTime(static_cast<double>(stats.write_time_ns) / 1e9);
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * stats.bytes_written);
+    state.counters["journal_gb"] = static_cast<double>(stats.bytes_written) / (1024.0 * 1024.0 * 1024.0);
+    state.counters["packets"] = static_cast<double>(stats.packet_count);
+    state.counters["ns_per_packet"] =
+        stats.packet_count > 0 ? static_cast<double>(stats.write_time_ns) / static_cast<double>(stats.packet_count)
+                               : 0.0;
+    state.counters["flushes"] = static_cast<double>(stats.flush_count);
+}
+
+// 크래시 후 저널 → faststart MP4 복구 시간 (RecoverFromJournal)
+// range(0) GB 저널을 만든 뒤 복구 한 번만 측정 (만드는 시간은 제외), 복구한 패킷 수가 기록과 다르면 실패
+void BM_JournalRecover(benchmark::State& state) {
+    const int64_t target_bytes = state.range(0) * 1024LL * 1024 * 1024;
+    const auto journal_path = BenchOutputPath("journal_recover", 1280, 720);
+    const auto output_path = BenchOutputPath("journal_recovered", 1280, 720);
+
+    EncodedClip clip;
+    std::string error;
+    PacketJournalStats written;
+    if (!clip.Create(1280, 720, 4, &error) ||
+        !WriteRepeatedJournal(clip, journal_path, target_bytes, &written, &error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    JournalRecoveryStats stats;
+    for (auto _ : state) {
+        std::error_code ec;
+        std::filesystem::remove(output_path, ec);
+        const auto started_at = std::chrono::steady_clock::now();
+        const bool ok = RecoverFromJournal(journal_path.u8string(), output_path.u8string(), &stats, &error);
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count());
+        if (!ok) {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        if (stats.packet_count != written.packet_count) {
+            state.SkipWithError("복구한 패킷 수가 기록과 다름");
+            break;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * stats.journal_bytes);
+    state.counters["journal_gb"] = static_cast<double>(stats.journal_bytes) / (1024.0 * 1024.0 * 1024.0);
+    state.counters["packets"] = static_cast<double>(stats.packet_count);
+    state.counters["seconds_per_gb"] = stats.seconds_per_gb;
+    std::error_code ec;
+    std::filesystem::remove(journal_path, ec);
+    std::filesystem::remove(output_path, ec);
+}
+
+// 입력: 강제 종료 시점에 떠 둔 녹화 파일
+// 출력: 끝까지 읽어 낸 비디오 길이(초), 읽을 수 없으면 0
+double ReadableVideoSeconds(const std::filesystem::path& path) {
+    AVFormatContext* ctx = nullptr;
+    const std::string utf8_path = path.u8string();
+    if (avformat_open_input(&ctx, utf8_path.c_str(), nullptr, nullptr) < 0) return 0.0;
+    double end_seconds = 0.0;
+    const int video = avformat_find_stream_info(ctx, nullptr) >= 0
+                          ? av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0)
+                          : -1;
+    if (video >= 0) {
+        const AVRational tb = ctx->streams[video]->time_base;
+        const int64_t start = ctx->streams[video]->start_time != AV_NOPTS_VALUE ? ctx->streams[video]->start_time : 0;
+        AVPacket* pkt = av_packet_alloc();
+        while (av_read_frame(ctx, pkt) >= 0) {
+            if (pkt->stream_index == video && pkt->pts != AV_NOPTS_VALUE) {
+                end_seconds = std::max(end_seconds, static_cast<double>(pkt->pts - start + pkt->duration) * av_q2d(tb));
+            }
+            av_packet_unref(pkt);
+        }
+        av_packet_free(&pkt);
+    }
+    avformat_close_input(&ctx);
+    return end_seconds;
+}
+
+// 녹화 컨테이너 비교 (fragmented MP4 / Matroska / MPEG-TS, range(0) = RecordingContainer 값)
+// 720p24 합성 화면 + 오디오를 30초 인코딩하면서 20초 시점 파일을 디스크에 있는 그대로 복사 (강제 종료 시 남는 파일)
+// - 측정 시간: av_interleaved_write_frame 누적 시간 (muxer + 파일 I/O 쓰기 오버헤드)
+// - lost_seconds: 복사본에서 읽어 낸 비디오 길이와 20초의 차이, recover_ms: 복사본 → faststart MP4 remux 시간
+// - cpu_ms_per_media_s: 인코딩 전체의 프로세스 CPU 시간 (x264 스레드 포함)
+void BM_ContainerWriteAndKill(benchmark::State& state) {
+    constexpr int kWidth = 1280;
+    constexpr int kHeight = 720;
+    constexpr int64_t kSeconds = 30;
+    constexpr int64_t kKillAtSeconds = 20;
+    const auto container = static_cast<RecordingContainer>(state.range(0));
+    auto path = BenchOutputPath("container", kWidth, kHeight);
+    path.replace_extension(RecordingContainerExtension(container));
+    auto killed_path = BenchOutputPath("container_killed", kWidth, kHeight);
+    killed_path.replace_extension(RecordingContainerExtension(container));
+    const auto recovered_path = BenchOutputPath("container_recovered", kWidth, kHeight);
+    const auto frames = MakeSyntheticFrames(kWidth, kHeight);
+
+    double write_ms = 0.0;
+    double cpu_seconds = 0.0;
+    double lost_seconds = 0.0;
+    double recover_ms = 0.0;
+    double file_mb = 0.0;
+    int64_t packets = 0;
+    for (auto _ : state) {
+        ManualMediaClock clock;
+        LibavEncoder encoder;
+        LibavEncoderConfig config;
+        config.output_path = path.wstring();
+        config.container = container;
+        config.video_width = kWidth;
+        config.video_height = kHeight;
+        config.video_fps = kFps;
+        config.audio_sample_rate = kSampleRate;
+        config.audio_channels = kChannels;
+        config.h264_preset = "ultrafast";  // 인코딩 비용에 컨테이너 차이가 묻히지 않도록
+        config.clock = &clock;
+        if (!encoder.Start(config)) {
+            state.SkipWithError(encoder.GetLastError().c_str());
+            break;
+        }
+
+        const std::clock_t cpu_started_at = std::clock();
+        bool ok = true;
+        int64_t chunk = 0;
+        for (int64_t i = 0; ok && i < kSeconds * kFps; i++) {
+            if (i == kKillAtSeconds * kFps) {
+                std::error_code ec;
+                std::filesystem::copy_file(path, killed_path, std::filesystem::copy_options::overwrite_existing, ec);
+                ok = !ec;
+            }
+            clock.Set(FrameTicks(clock, i));
+            const auto& frame = frames[static_cast<size_t>(i % kSyntheticFrameCount)];
+            ok = ok && encoder.EncodeVideo(frame.data(), frame.size(), clock.Now());
+            for (; ok && chunk * kFps < (i + 1) * 100; chunk++) {
+                const auto audio = MakeSyntheticAudioChunk(static_cast<int>(chunk));
+                clock.Set(static_cast<uint64_t>(chunk) * clock.Frequency() / 100);
+                ok = encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(audio.data()),
+                                         audio.size() * sizeof(float), clock.Now());
+            }
+        }
+        cpu_seconds = static_cast<double>(std::clock() - cpu_started_at) / CLOCKS_PER_SEC;
+        write_ms = static_cast<double>(LibavEncoderBenchAccess::MuxWriteTimeNs(encoder)) / 1e6;
+        packets = LibavEncoderBenchAccess::MuxPacketCount(encoder);
+        const std::string error = encoder.GetLastError();
+        encoder.Stop();
+        if (!ok) {
+            state.SkipWithError(error.empty() ? "인코딩/복사 실패" : error.c_str());
+            break;
+        }
+        state.SetIterationTime(write_ms / 1000.0);
+
+        std::error_code ec;
+        file_mb = static_cast<double>(std::filesystem::file_size(path, ec)) / (1024.0 * 1024.0);
+        lost_seconds = static_cast<double>(kKillAtSeconds) - ReadableVideoSeconds(killed_path);
+        std::filesystem::remove(recovered_path, ec);
+        const auto started_at = std::chrono::steady_clock::now();
+        std::string remux_error;
+        Mp4FinalizeStats remux_stats;
+        if (!RemuxToFaststartMp4(killed_path.u8string(), recovered_path.u8string(), &remux_stats, &remux_error)) {
+            state.SkipWithError(("강제 종료 파일 복구 실패: " + remux_error).c_str());
+            break;
+        }
+        recover_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_at).count();
+    }
+
+    state.SetLabel(RecordingContainerExtension(container));
+    state.counters["write_us_per_packet"] = packets > 0 ? write_ms * 1000.0 / static_cast<double>(packets) : 0.0;
+    state.counters["cpu_ms_per_media_s"] = cpu_seconds * 1000.0 / static_cast<double>(kSeconds);
+    state.counters["lost_seconds"] = lost_seconds;
+    state.counters["recover_ms"] = recover_ms;
+    state.counters["file_mb"] = file_mb;
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(killed_path, ec);
+    std::filesystem::remove(recovered_path, ec);
+}
+
+// 시작 요청 → 첫 프레임 인코딩까지 지연 분포 (합성 소스 + 실제 시계, 720p24 I420 큐)
+// range(0) = 0: Start 한 번에 소스/인코더/출력 파일 초기화 (콜드 스타트)
+// range(0) = 1: Arm으로 미리 준비해 두고 Trigger부터 측정 (준비는 측정 구간 밖)
+// 반복마다 지연을 모아 p50/p90/p99/max 카운터로 보고, 5초 안에 첫 프레임이 없으면 실패
+void BM_StartToFirstFrame(benchmark::State& state) {
+    constexpr int kWidth = 1280;
+    constexpr int kHeight = 720;
+    constexpr auto kArmSettle = std::chrono::milliseconds(100);
+    constexpr auto kFirstFrameTimeout = std::chrono::seconds(5);
+    const bool armed = state.range(0) != 0;
+    const auto path = BenchOutputPath(armed ? "armed" : "cold", kWidth, kHeight);
+
+    SyntheticLectureConfig lecture;
+    lecture.width = kWidth;
+    lecture.height = kHeight;
+    lecture.fps = kFps;
+
+    RecordingPipeline pipeline;
+    std::vector<double> latencies_ms;
+    for (auto _ : state) {
+        GeneratorVideoSource video_source(lecture);
+        GeneratorAudioSource audio_source(lecture);
+        RecordingPipelineConfig config;
+        config.encoder.output_path = path.wstring();
+        config.encoder.video_width = kWidth;
+        config.encoder.video_height = kHeight;
+        config.encoder.video_fps = kFps;
+        config.video_source = &video_source;
+        config.audio_source = &audio_source;
+        config.video_frame_format = FramePixelFormat::kI420;
+
+        std::string error;
+        std::chrono::steady_clock::time_point requested_at;
+        bool started = false;
+        if (armed) {
+            // 준비 직후 스레드들이 자리 잡을 때까지 두고 트리거 (실제 사용처럼 준비와 시작 사이에 간격이 있음)
+            started = pipeline.Arm(config, &error);
+            if (started) {
+                std::this_thread::sleep_for(kArmSettle);
+                requested_at = std::chrono::steady_clock::now();
+                started = pipeline.Trigger();
+            }
+        } else {
+            requested_at = std::chrono::steady_clock::now();
+            started = pipeline.Start(config, &error);
+        }
+        if (!started) {
+            pipeline.Stop();
+            state.SkipWithError(error.empty() ? "트리거 실패" : error.c_str());
+            return;
+        }
+
+        while (pipeline.GetVideoFrameCount() < 1 && pipeline.IsCapturing() &&
+               std::chrono::steady_clock::now() - requested_at < kFirstFrameTimeout) {
+            std::this_thread::yield();
+        }
+        const auto first_frame_at = std::chrono::steady_clock::now();
+        const bool got_frame = pipeline.GetVideoFrameCount() >= 1;
+        pipeline.Stop();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (!got_frame) {
+            state.SkipWithError("첫 프레임이 인코딩되지 않음");
+            return;
+        }
+
+        const double seconds = std::chrono::duration<double>(first_frame_at - requested_at).count();
+        state.SetIterationTime(seconds);
+        latencies_ms.push_back(seconds * 1000.0);
+    }
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    auto percentile = [&latencies_ms](double p) {
+        if (latencies_ms.empty()) return 0.0;
+        const size_t index = std::min(latencies_ms.size() - 1,
+                                      static_cast<size_t>(p * static_cast<double>(latencies_ms.size())));
+        return latencies_ms[index];
+    };
+    state.counters["p50_ms"] = percentile(0.50);
+    state.counters["p90_ms"] = percentile(0.90);
+    state.counters["p99_ms"] = percentile(0.99);
+    state.counters["max_ms"] = latencies_ms.empty() ? 0.0 : latencies_ms.back();
+}
+
+// 중지 요청 → 반환 / 파일 닫힘 지연 (합성 소스 + 실제 시계, 1080p BGRA 큐 512MB로 인코더 밀림을 유도)
+// range(0) = 종료 처리 기한(ms, 0이면 남은 큐를 모두 인코딩)
+// 반복 시간은 파일 닫힘까지, 중지 요청이 10ms 안에 반환되지 않으면 실패
+void BM_StopLatency(benchmark::State& state) {
+    constexpr int kWidth = 1920;
+    constexpr int kHeight = 1080;
+    constexpr auto kRecordTime = std::chrono::milliseconds(1500);
+    constexpr double kMaxStopReturnMs = 10.0;
+    const int deadline_ms = static_cast<int>(state.range(0));
+    const auto path = BenchOutputPath("stop", kWidth, kHeight);
+
+    SyntheticLectureConfig lecture;
+    lecture.width = kWidth;
+    lecture.height = kHeight;
+    lecture.fps = kFps;
+
+    RecorderSession session(0);
+    std::vector<double> finalize_ms;
+    double max_return_ms = 0.0;
+    int64_t discarded = 0;
+    for (auto _ : state) {
+        RecorderSessionConfig config;
+        config.video_source = std::make_unique<GeneratorVideoSource>(lecture);
+        config.audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+        config.pipeline.encoder.output_path = path.wstring();
+        config.pipeline.encoder.video_width = kWidth;
+        config.pipeline.encoder.video_height = kHeight;
+        config.pipeline.encoder.video_fps = kFps;
+        config.pipeline.video_frame_format = FramePixelFormat::kBgra;
+        config.pipeline.video_queue_budget_bytes = 512u * 1024u * 1024u;
+        config.pipeline.finalize_deadline_ms = deadline_ms;
+
+        std::string error;
+        if (!session.Launch(std::move(config), &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        std::this_thread::sleep_for(kRecordTime);
+        if (!session.pipeline().IsTriggered()) {
+            session.Stop();
+            state.SkipWithError(session.GetLastError().c_str());
+            return;
+        }
+
+        const auto requested_at = std::chrono::steady_clock::now();
+        session.RequestStop();
+        const auto returned_at = std::chrono::steady_clock::now();
+        session.Stop();
+        const auto finalized_at = std::chrono::steady_clock::now();
+        discarded += session.pipeline().GetQueueStats().discarded_on_stop;
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+
+        const double return_ms = std::chrono::duration<double, std::milli>(returned_at - requested_at).count();
+        max_return_ms = std::max(max_return_ms, return_ms);
+        if (return_ms > kMaxStopReturnMs) {
+            state.SkipWithError("중지 요청이 바로 반환되지 않음");
+            return;
+        }
+        const double seconds = std::chrono::duration<double>(finalized_at - requested_at).count();
+        state.SetIterationTime(seconds);
+        finalize_ms.push_back(seconds * 1000.0);
+    }
+
+    std::sort(finalize_ms.begin(), finalize_ms.end());
+    state.counters["stop_return_max_ms"] = max_return_ms;
+    state.counters["finalize_p50_ms"] = finalize_ms.empty() ? 0.0 : finalize_ms[finalize_ms.size() / 2];
+    state.counters["finalize_max_ms"] = finalize_ms.empty() ? 0.0 : finalize_ms.back();
+    state.counters["discarded"] = static_cast<double>(discarded);
+}
+
+// 단계별 지연 히스토그램 기록 비용 (Clock::now + Record, 녹화 스레드가 프레임마다 내는 계측 비용)
+// 캡처/오디오/인코더 스레드가 같은 PipelineStats에 동시에 기록하는 경우까지 스레드 수로 비교
+void BM_PipelineStatsRecord(benchmark::State& state) {
+    static PipelineStats stats;
+    const auto stage = static_cast<PipelineStage>(state.thread_index() % static_cast<int>(PipelineStage::kCount));
+    for (auto _ : state) {
+        stats.RecordSince(stage, PipelineStats::Clock::now());
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        state.counters["samples"] = static_cast<double>(stats.GetSampleCount());
+    }
+}
+
+// SATREC_TRACE_SCOPE 1회 비용 (range(0) = 0: trace 꺼짐 → atomic load만, 1: 켜짐 → ring에 이벤트 기록)
+// 켜진 경우 writer 스레드가 비우는 속도보다 빨리 기록하므로 ring이 차서 버린 이벤트도 함께 보고
+void BM_TraceScope(benchmark::State& state) {
+    const bool enabled = state.range(0) != 0;
+    const auto path = std::filesystem::temp_directory_path() / "satrec_bench_trace_scope.json";
+    std::string error;
+    if (enabled && !TraceRecorder::Instance().Start(path.u8string(), &error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+    for (auto _ : state) {
+        SATREC_TRACE_SCOPE("bench_scope");
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (enabled) {
+        TraceRecorder::Instance().Stop();
+        state.counters["written"] = static_cast<double>(TraceRecorder::Instance().GetWrittenEventCount());
+        state.counters["dropped"] = static_cast<double>(TraceRecorder::Instance().GetDroppedEventCount());
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+}
+
+// 합성 소스로 실제 파이프라인을 돌렸을 때의 단계별 지연 (Linux에서 캡처 장치 없이 재현)
+// 720p24 합성 강의 화면 + 오디오를 실제 시계로 3초 녹화한 뒤 세션의 PipelineStats 요약을 카운터로 보고
+// range(0) = 1이면 trace를 켜고 녹화 (꺼진 경우와 단계별 p99를 비교해 trace 오버헤드 확인)
+void BM_SyntheticPipelineLatency(benchmark::State& state) {
+    constexpr int kWidth = 1280;
+    constexpr int kHeight = 720;
+    constexpr auto kRecordTime = std::chrono::seconds(3);
+    const bool trace = state.range(0) != 0;
+    const auto path = BenchOutputPath("synthetic_pipeline", kWidth, kHeight);
+    const auto trace_path = std::filesystem::temp_directory_path() / "satrec_bench_synthetic_trace.json";
+
+    SyntheticLectureConfig lecture;
+    lecture.width = kWidth;
+    lecture.height = kHeight;
+    lecture.fps = kFps;
+
+    RecorderSession session(0);
+    for (auto _ : state) {
+        RecorderSessionConfig config;
+        config.video_source = std::make_unique<GeneratorVideoSource>(lecture);
+        config.audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+        config.pipeline.encoder.output_path = path.wstring();
+        config.pipeline.encoder.video_width = kWidth;
+        config.pipeline.encoder.video_height = kHeight;
+        config.pipeline.encoder.video_fps = kFps;
+        config.pipeline.video_frame_format = FramePixelFormat::kBgra;
+
+        std::string error;
+        if (trace && !TraceRecorder::Instance().Start(trace_path.u8string(), &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        if (!session.Launch(std::move(config), &error)) {
+            TraceRecorder::Instance().Stop();
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        std::this_thread::sleep_for(kRecordTime);
+        session.Stop();
+        TraceRecorder::Instance().Stop();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        std::filesystem::remove(trace_path, ec);
+        if (!session.GetLastError().empty()) {
+            state.SkipWithError(session.GetLastError().c_str());
+            return;
+        }
+    }
+
+    const PipelineStats& stats = session.pipeline().pipeline_stats();
+    const LatencySummary total = stats.Summarize(PipelineStage::kVideoTotal);
+    state.counters["frames"] = static_cast<double>(total.count);
+    state.counters["total_p50_us"] = static_cast<double>(total.p50_us);
+    state.counters["total_p99_us"] = static_cast<double>(total.p99_us);
+    state.counters["queue_p99_us"] = static_cast<double>(stats.Summarize(PipelineStage::kVideoQueue).p99_us);
+    state.counters["convert_p99_us"] = static_cast<double>(stats.Summarize(PipelineStage::kConvert).p99_us);
+    state.counters["encode_p99_us"] = static_cast<double>(stats.Summarize(PipelineStage::kVideoEncode).p99_us);
+    state.counters["mux_p99_us"] = static_cast<double>(stats.Summarize(PipelineStage::kMux).p99_us);
+    state.counters["record_cost_ns"] = static_cast<double>(stats.GetRecordCostNs());
+    if (trace) {
+        state.counters["trace_events"] = static_cast<double>(TraceRecorder::Instance().GetWrittenEventCount());
+        state.counters["trace_dropped"] = static_cast<double>(TraceRecorder::Instance().GetDroppedEventCount());
+    }
+}
+
+// 단계 감시 복구 시간: 녹화 중 한 단계에 오류를 주입하고 재시작 후 진행이 재개될 때까지 (감지 → 재개)
+// 복구하지 못하거나 녹화가 오류로 끝나면 실패
+void BM_StageRecovery(benchmark::State& state) {
+    constexpr int kWidth = 1280;
+    constexpr int kHeight = 720;
+    constexpr auto kWarmUp = std::chrono::milliseconds(800);
+    constexpr auto kRecoveryTimeout = std::chrono::milliseconds(3000);
+    const auto stage = static_cast<WatchedStage>(state.range(0));
+    const auto path = BenchOutputPath("recovery", kWidth, kHeight);
+
+    SyntheticLectureConfig lecture;
+    lecture.width = kWidth;
+    lecture.height = kHeight;
+    lecture.fps = kFps;
+
+    RecorderSession session(0);
+    std::vector<double> recovery_ms;
+    for (auto _ : state) {
+        RecorderSessionConfig config;
+        config.video_source = std::make_unique<GeneratorVideoSource>(lecture);
+        config.audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+        config.pipeline.encoder.output_path = path.wstring();
+        config.pipeline.encoder.video_width = kWidth;
+        config.pipeline.encoder.video_height = kHeight;
+        config.pipeline.encoder.video_fps = kFps;
+        config.pipeline.watchdog_deadline_ms = 500;
+
+        std::string error;
+        if (!session.Launch(std::move(config), &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        std::this_thread::sleep_for(kWarmUp);
+        if (!session.pipeline().InjectStageFault(stage, StageFault::kError)) {
+            session.Stop();
+            state.SkipWithError("오류 주입 실패");
+            return;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + kRecoveryTimeout;
+        WatchdogStageStats stats;
+        while (std::chrono::steady_clock::now() < deadline) {
+            stats = session.pipeline().GetWatchdogStats(stage);
+            if (stats.recoveries > 0 || stats.failed) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        session.Stop();
+        const std::string last_error = session.GetLastError();
+        const std::vector<std::wstring> segments = session.pipeline().GetSegmentPaths();
+        for (const auto& segment : segments) {
+            std::error_code ec;
+            std::filesystem::remove(segment, ec);
+        }
+        if (stats.recoveries < 1) {
+            state.SkipWithError("단계가 재시작 후 복구되지 않음");
+            return;
+        }
+        if (!last_error.empty()) {
+            state.SkipWithError(last_error.c_str());
+            return;
+        }
+        state.SetIterationTime(static_cast<double>(stats.last_recovery_ms) / 1000.0);
+        recovery_ms.push_back(static_cast<double>(stats.last_recovery_ms));
+    }
+
+    std::sort(recovery_ms.begin(), recovery_ms.end());
+    state.counters["recovery_p50_ms"] = recovery_ms.empty() ? 0.0 : recovery_ms[recovery_ms.size() / 2];
+    state.counters["recovery_max_ms"] = recovery_ms.empty() ? 0.0 : recovery_ms.back();
+}
+
+// CPU hog 아래 캡처/오디오 스레드 깨어남 지연: 논리 CPU 수의 두 배만큼 쉬지 않고 도는 스레드를 띄운 채
+// 캡처(1/fps 간격)와 오디오(10ms 폴링) 스레드가 목표 시각보다 얼마나 늦게 깨어나는지 측정 (policy:0 기본, 1 스레드 정책)
+// 오디오 글리치 = 폴링 간격이 kAudioGlitchGap을 넘은 횟수 (그동안 장치 버퍼가 넘쳐 소리가 끊겼을 구간)
+// 권한이 없어 우선순위를 못 바꾸면 priority_applied 0 (Linux SCHED_RR/nice 감소는 CAP_SYS_NICE 필요)
+void BM_ThreadJitterUnderCpuHog(benchmark::State& state) {
+    constexpr auto kMeasureTime = std::chrono::seconds(3);
+    constexpr auto kCaptureInterval = std::chrono::nanoseconds(1000000000LL / kFps);
+    constexpr auto kAudioInterval = std::chrono::milliseconds(10);
+    constexpr auto kAudioGlitchGap = std::chrono::milliseconds(20);
+    ThreadPolicyConfig policy;
+    policy.enabled = state.range(0) != 0;
+    const unsigned hog_threads = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<int64_t> capture_late_us;
+    std::vector<int64_t> audio_late_us;
+    int64_t audio_glitches = 0;
+    bool priority_applied = false;
+    for (auto _ : state) {
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> hogs;
+        for (unsigned i = 0; i < hog_threads; i++) {
+            hogs.emplace_back([&stop] {
+                volatile uint64_t sink = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int n = 0; n < 10000; n++) sink = sink * 6364136223846793005ULL + 1;
+                }
+            });
+        }
+
+        // 목표 시각을 절대값으로 진행 (한 번 늦어도 다음 목표는 밀리지 않음, 파이프라인 캡처 루프와 같은 방식)
+        const auto until = std::chrono::steady_clock::now() + kMeasureTime;
+        auto periodic = [until](ThreadRole role, const ThreadPolicyConfig& config,
+                                std::chrono::nanoseconds interval, std::vector<int64_t>* late_us,
+                                int64_t* gaps_over, std::chrono::nanoseconds gap_limit, bool* applied) {
+            ScopedThreadPolicy thread_policy(role, config);
+            *applied = thread_policy.result().priority;
+            auto next = std::chrono::steady_clock::now() + interval;
+            auto last_wake = std::chrono::steady_clock::now();
+            while (next < until) {
+                std::this_thread::sleep_until(next);
+                const auto woke = std::chrono::steady_clock::now();
+                late_us->push_back(std::chrono::duration_cast<std::chrono::microseconds>(woke - next).count());
+                if (gaps_over && woke - last_wake > gap_limit) (*gaps_over)++;
+                last_wake = woke;
+                next += interval;
+            }
+        };
+        std::vector<int64_t> capture_iteration;
+        std::vector<int64_t> audio_iteration;
+        int64_t glitches = 0;
+        bool capture_applied = false;
+        bool audio_applied = false;
+        const auto measure_started_at = std::chrono::steady_clock::now();
+        std::thread capture(periodic, ThreadRole::kCapture, policy, kCaptureInterval, &capture_iteration,
+                            nullptr, std::chrono::nanoseconds(0), &capture_applied);
+        std::thread audio(periodic, ThreadRole::kAudio, policy, kAudioInterval, &audio_iteration, &glitches,
+                          kAudioGlitchGap, &audio_applied);
+        capture.join();
+        audio.join();
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                             measure_started_at).count());
+        stop = true;
+        for (auto& hog : hogs) hog.join();
+
+        capture_late_us.insert(capture_late_us.end(), capture_iteration.begin(), capture_iteration.end());
+        audio_late_us.insert(audio_late_us.end(), audio_iteration.begin(), audio_iteration.end());
+        audio_glitches += glitches;
+        priority_applied = capture_applied && audio_applied;
+    }
+    if (capture_late_us.empty() || audio_late_us.empty()) {
+        state.SkipWithError("측정된 주기가 없음");
+        return;
+    }
+
+    std::sort(capture_late_us.begin(), capture_late_us.end());
+    std::sort(audio_late_us.begin(), audio_late_us.end());
+    auto percentile = [](const std::vector<int64_t>& sorted, double p) {
+        return static_cast<double>(sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))]);
+    };
+    state.counters["capture_late_p50_us"] = percentile(capture_late_us, 0.50);
+    state.counters["capture_late_p99_us"] = percentile(capture_late_us, 0.99);
+    state.counters["capture_late_max_us"] = static_cast<double>(capture_late_us.back());
+    state.counters["audio_late_p99_us"] = percentile(audio_late_us, 0.99);
+    state.counters["audio_late_max_us"] = static_cast<double>(audio_late_us.back());
+    state.counters["audio_glitches"] = static_cast<double>(audio_glitches);
+    state.counters["hog_threads"] = static_cast<double>(hog_threads);
+    state.counters["priority_applied"] = priority_applied ? 1.0 : 0.0;
+}
+
+// CPU 예산 조절 시뮬레이션: 가상 시계 1초 간격으로 12분, 녹화 사용률은 단계의 fps 비율로 모델링
+// 120~420초 Zoom 부하(시스템 +55%), 500~600초 움직임 많은 화면(녹화 비용 ×1.5), 측정 잡음 ±2%
+// 검사: 압박 시작 후 제한 시간 안에 예산/시스템 기준 아래로 돌아옴, 단계 변경 횟수 제한(진동 없음), 끝나면 단계 0
+// 실제 프로세스/부하 측정은 loadtest --cpu-budget --load-threads
+void BM_CpuGovernorSimulation(benchmark::State& state) {
+    constexpr int kDurationSeconds = 720;
+    constexpr double kBaseRecorderPercent = 28.0;  // 단계 0 (24fps veryfast) 녹화 사용률
+    constexpr double kBackgroundPercent = 10.0;    // 다른 상주 프로그램
+    constexpr double kZoomPercent = 55.0;
+    constexpr int kZoomStart = 120;
+    constexpr int kZoomEnd = 420;
+    constexpr int kMotionStart = 500;
+    constexpr int kMotionEnd = 600;
+    constexpr int kMaxChanges = 6;  // 압박 구간 두 번 × (낮춤 + 복원) + 여유
+    CpuGovernorConfig config;
+    config.budget_percent = 35.0;
+
+    int changes = 0;
+    int max_level = 0;
+    int final_level = 0;
+    int64_t seconds_out_of_bounds = 0;
+    int64_t time_to_comply_s = -1;
+    for (auto _ : state) {
+        CpuGovernor governor;
+        governor.Reset(config, BuildCpuGovernorLadder(kFps, config.min_capture_fps), 0);
+        uint64_t noise_state = 12345;
+        // 결정적 잡음 (-2 ~ +2%)
+        auto noise = [&noise_state] {
+            noise_state = noise_state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<double>(noise_state >> 40) / static_cast<double>(1ULL << 24) * 4.0 - 2.0;
+        };
+        // 압박 구간 시작 후 판단 3초 + 보류, 단계마다 (degrade_after + hold) 안에 한 단계씩 내려감
+        const int64_t comply_limit_s = static_cast<int64_t>(governor.level_count()) *
+                                       (config.degrade_after_ms + config.hold_ms) / 1000 + 1;
+        changes = 0;
+        max_level = 0;
+        seconds_out_of_bounds = 0;
+        time_to_comply_s = -1;
+        for (int t = 0; t < kDurationSeconds; t++) {
+            const bool zoom = t >= kZoomStart && t < kZoomEnd;
+            const bool motion = t >= kMotionStart && t < kMotionEnd;
+            const CpuGovernorLevel& level = governor.current();
+            CpuUsageSample sample;
+            sample.recorder_percent = kBaseRecorderPercent * static_cast<double>(level.capture_fps) / kFps *
+                                      (motion ? 1.5 : 1.0) + noise();
+            sample.system_percent = std::min(100.0, sample.recorder_percent + kBackgroundPercent +
+                                                        (zoom ? kZoomPercent : 0.0) + noise());
+
+            const bool in_bounds = sample.recorder_percent <= config.budget_percent &&
+                                   sample.system_percent < config.system_high_percent;
+            if (zoom && time_to_comply_s < 0 && in_bounds) time_to_comply_s = t - kZoomStart;
+            const bool settled = (zoom && t - kZoomStart > comply_limit_s) ||
+                                 (motion && t - kMotionStart > comply_limit_s);
+            if (settled && !in_bounds) seconds_out_of_bounds++;
+
+            const CpuGovernorDecision decision = governor.Update(sample, static_cast<int64_t>(t) * 1000);
+            if (decision.action != CpuGovernorAction::kNone) changes++;
+            max_level = std::max(max_level, governor.level());
+        }
+        final_level = governor.level();
+        benchmark::DoNotOptimize(final_level);
+    }
+
+    state.counters["changes"] = static_cast<double>(changes);
+    state.counters["max_level"] = static_cast<double>(max_level);
+    state.counters["final_level"] = static_cast<double>(final_level);
+    state.counters["time_to_comply_s"] = static_cast<double>(time_to_comply_s);
+    state.counters["seconds_out_of_bounds"] = static_cast<double>(seconds_out_of_bounds);
+    if (time_to_comply_s < 0 || seconds_out_of_bounds > 0) {
+        state.SkipWithError("압박 구간에서 예산/시스템 기준 아래로 돌아오지 않음");
+    } else if (changes > kMaxChanges) {
+        state.SkipWithError("단계 변경이 너무 잦음 (진동)");
+    } else if (final_level != 0) {
+        state.SkipWithError("부하가 끝난 뒤 원래 단계로 복원되지 않음");
+    }
+}
+
+// 입력: 기록 번호
+// 출력: 모든 필드가 같은 번호에서 파생된 스냅샷 (읽은 값이 섞였는지 검사용)
+LiveStatsSnapshot MakeLiveStatsSnapshot(int64_t n) {
+    LiveStatsSnapshot snapshot;
+    snapshot.recording = true;
+    snapshot.elapsed_ms = n;
+    snapshot.video_frames = n * 2;
+    snapshot.audio_samples = n * 480;
+    snapshot.captured_video_frames = n + 1;
+    snapshot.repeated_video_frames = n + 2;
+    snapshot.dropped_video_frames = n + 3;
+    snapshot.dropped_audio_packets = n + 4;
+    snapshot.dropped_audio_samples = n + 5;
+    snapshot.dropped_audio_ms = n + 6;
+    snapshot.encoded_bytes = n * 1000;
+    snapshot.video_queue_depth = static_cast<int32_t>(n % 60);
+    snapshot.video_queue_high_water = static_cast<int32_t>(n % 61);
+    snapshot.audio_queue_depth = static_cast<int32_t>(n % 100);
+    snapshot.audio_level = static_cast<float>(n % 1000);
+    snapshot.video_fps = static_cast<float>(n % 997);
+    return snapshot;
+}
+
+bool IsConsistentLiveStats(const LiveStatsSnapshot& s) {
+    const int64_t n = s.elapsed_ms;
+    return s.video_frames == n * 2 && s.audio_samples == n * 480 &&
+           s.captured_video_frames == n + 1 && s.repeated_video_frames == n + 2 &&
+           s.dropped_video_frames == n + 3 && s.dropped_audio_packets == n + 4 &&
+           s.dropped_audio_samples == n + 5 && s.dropped_audio_ms == n + 6 &&
+           s.encoded_bytes == n * 1000 && s.video_queue_depth == n % 60 &&
+           s.video_queue_high_water == n % 61 && s.audio_queue_depth == n % 100 &&
+           s.audio_level == static_cast<float>(n % 1000) && s.video_fps == static_cast<float>(n % 997);
+}
+
+// 공유 통계 블록 읽기 비용 + 일관성 검사
+// 기록 스레드가 쉬지 않고 Publish하는 최악 조건에서 읽은 스냅샷이 한 번이라도 섞이면 실패
+void BM_LiveStatsReadUnderContention(benchmark::State& state) {
+    LiveStats stats;
+    stats.Publish(MakeLiveStatsSnapshot(0));  // 초기값(모두 0)은 검사 규칙에 맞지 않으므로 먼저 한 번 기록
+    std::atomic<bool> running(true);
+    std::atomic<int64_t> published(0);
+    std::thread writer([&] {
+        int64_t n = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            stats.Publish(MakeLiveStatsSnapshot(++n));
+        }
+        published = n;
+    });
+
+    int64_t torn = 0;
+    int64_t retried_out = 0;
+    int64_t last_n = 0;
+    for (auto _ : state) {
+        LiveStatsSnapshot snapshot;
+        if (!stats.Read(&snapshot)) {
+            retried_out++;
+            continue;
+        }
+        // 값이 섞이지 않았고 기록 순서가 거꾸로 보이지 않아야 함
+        if (!IsConsistentLiveStats(snapshot) || snapshot.elapsed_ms < last_n) torn++;
+        last_n = snapshot.elapsed_ms;
+        benchmark::DoNotOptimize(snapshot);
+    }
+    running = false;
+    writer.join();
+
+    state.counters["torn"] = static_cast<double>(torn);
+    state.counters["retried_out"] = static_cast<double>(retried_out);
+    state.counters["published"] = static_cast<double>(published.load());
+    if (torn > 0) {
+        state.SkipWithError("공유 통계 블록에서 섞인 스냅샷을 읽음");
+    }
+}
+
+// 캡처 스레드 → 인코더 쪽으로 1080p I420 프레임 넘기기 (mode 0: 프로세스 내 큐, 1: 공유 메모리 링)
+// 큐는 캡처가 만든 프레임 버퍼를 그대로 넘기고, 링은 슬롯에 한 번 복사 (인코더 자식 프로세스 모드)
+// 소비자 스레드가 순서대로 받았는지 프레임 번호로 확인, 하나라도 어긋나면 실패
+void BM_FrameHandoff(benchmark::State& state) {
+    const bool shared = state.range(0) != 0;
+    constexpr int kWidth = 1920;
+    constexpr int kHeight = 1080;
+    constexpr size_t kSlots = 8;
+    const size_t frame_bytes = FramePixelBytes(FramePixelFormat::kI420, kWidth, kHeight);
+    std::vector<uint8_t> source(frame_bytes, 0x80);
+
+    CaptureQueue<FrameData> queue(kSlots);
+    SharedMemoryRegion region;
+    SharedFrameRing ring;
+    if (shared) {
+        std::string error;
+        const size_t ring_bytes = SharedFrameRing::RequiredBytes(kSlots, frame_bytes);
+        if (!region.Create("satrec_bench_ring", ring_bytes, &error) ||
+            !ring.Attach(region.data(), region.size(), kSlots, frame_bytes, true)) {
+            state.SkipWithError(("공유 메모리 링 생성 실패: " + error).c_str());
+            return;
+        }
+    }
+
+    std::atomic<bool> running(true);
+    std::atomic<int64_t> received(0);
+    std::atomic<int64_t> out_of_order(0);
+    std::thread consumer([&] {
+        uint64_t expected = 0;
+        FrameData frame;
+        while (running.load(std::memory_order_acquire) || (shared ? ring.Size() > 0 : !queue.Empty())) {
+            uint64_t sequence = 0;
+            if (shared) {
+                const SharedRingItem* item = ring.Peek();
+                if (!item) continue;
+                memcpy(&sequence, SharedFrameRing::Payload(item), sizeof(sequence));
+                benchmark::DoNotOptimize(SharedFrameRing::Payload(item)[frame_bytes - 1]);
+                ring.Release();
+            } else {
+                if (!queue.TryPop(&frame)) continue;
+                memcpy(&sequence, frame.pixels.data(), sizeof(sequence));
+                benchmark::DoNotOptimize(frame.pixels[frame_bytes - 1]);
+            }
+            if (sequence != expected) out_of_order.fetch_add(1, std::memory_order_relaxed);
+            expected = sequence + 1;
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    uint64_t sequence = 0;
+    for (auto _ : state) {
+        memcpy(source.data(), &sequence, sizeof(sequence));
+        if (shared) {
+            SharedRingItem* item = nullptr;
+            while (!(item = ring.TryAcquire())) std::this_thread::yield();
+            item->kind = SharedRingItemKind::kVideo;
+            item->bytes = static_cast<uint32_t>(frame_bytes);
+            item->timestamp = sequence;
+            memcpy(SharedFrameRing::Payload(item), source.data(), frame_bytes);
+            ring.Publish();
+        } else {
+            // 캡처 소스가 프레임마다 새 버퍼를 채우는 것과 같은 비용 (할당 + 복사)
+            FrameData frame;
+            frame.width = kWidth;
+            frame.height = kHeight;
+            frame.format = FramePixelFormat::kI420;
+            frame.timestamp = sequence;
+            frame.pixels.assign(source.begin(), source.end());
+            while (queue.Size() >= kSlots) std::this_thread::yield();
+            queue.Push(std::move(frame));
+        }
+        sequence++;
+    }
+    running.store(false, std::memory_order_release);
+    consumer.join();
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(frame_bytes));
+    state.counters["received"] = static_cast<double>(received.load());
+    if (out_of_order.load() > 0 || received.load() != static_cast<int64_t>(sequence)) {
+        state.SkipWithError("넘긴 프레임 순서/개수가 맞지 않음");
+    }
+}
+
+void Resolutions(benchmark::internal::Benchmark* bench) {
+    bench->Args({1280, 720});
+    bench->Args({1920, 1080});
+    bench->Args({2560, 1440});
+    bench->Args({3840, 2160});
+    bench->ArgNames({"w", "h"});
+}
+
+}  // namespace
+
+// x264는 내부 스레드를 사용하므로 CPU 시간이 아닌 실제 경과 시간 기준
+BENCHMARK(BM_ConvertBGRAToYUV420)->Apply(Resolutions)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncodeVideo)->Apply(Resolutions)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncodeVideoI420)->Apply(Resolutions)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncodeAudio)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ReceiveAndWritePackets)->Apply(Resolutions)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CommitPreRoll)->Arg(2)->Arg(10)->Arg(30)->ArgName("seconds")->Iterations(5)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RemuxLargeMp4)->Arg(2)->ArgName("gb")->Iterations(1)
+    ->UseManualTime()->Unit(benchmark::kSecond);
+BENCHMARK(BM_JournalAppend)->Arg(2)->ArgName("gb")->Iterations(1)
+    ->UseManualTime()->Unit(benchmark::kSecond);
+BENCHMARK(BM_JournalRecover)->Arg(2)->ArgName("gb")->Iterations(1)
+    ->UseManualTime()->Unit(benchmark::kSecond);
+BENCHMARK(BM_ContainerWriteAndKill)->Arg(0)->Arg(1)->Arg(2)->ArgName("container")->Iterations(1)
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartToFirstFrame)->Arg(0)->Arg(1)->ArgName("armed")->Iterations(30)
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StopLatency)->Arg(0)->Arg(100)->ArgName("deadline_ms")->Iterations(5)
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PipelineStatsRecord)->Threads(1)->Threads(4)->UseRealTime()->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TraceScope)->Arg(0)->Arg(1)->ArgName("enabled")->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_SyntheticPipelineLatency)->Arg(0)->Arg(1)->ArgName("trace")->Iterations(1)
+    ->UseRealTime()->Unit(benchmark::kSecond);
+BENCHMARK(BM_StageRecovery)->Arg(0)->Arg(1)->Arg(2)->ArgName("stage")->Iterations(3)
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ThreadJitterUnderCpuHog)->Arg(0)->Arg(1)->ArgName("policy")->Iterations(1)
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CpuGovernorSimulation)->Iterations(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameHandoff)->Arg(0)->Arg(1)->ArgName("shared")->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LiveStatsReadUnderContention)->UseRealTime()->Unit(benchmark::kNanosecond);
+
+int main(int argc, char** argv) {
+    // 인코더 진행 로그가 벤치마크 표를 가리지 않도록 경고 이상만 출력
+    NativeLogger::Instance().SetMinLevel(LogLevel::kWarning);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    NativeLogger::Instance().Flush();
+    return 0;
+}
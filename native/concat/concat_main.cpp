@@ -0,0 +1,72 @@
+// satrec_concat: 녹화 세그먼트를 재인코딩 없이 하나의 MP4로 합치는 명령줄 도구
+//
+// 사용법: satrec_concat -o <출력.mp4> <세그먼트1.mp4> <세그먼트2.mp4> ...
+// 종료 코드: 0 성공, 1 인자 오류, 2 호환되지 않는 세그먼트, 3 입출력 오류
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mp4_concat.h"
+
+namespace {
+
+void PrintUsage() {
+    fprintf(stderr, "사용법: satrec_concat -o <출력.mp4> <세그먼트1.mp4> [세그먼트2.mp4 ...]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string output_path;
+    std::vector<std::string> input_paths;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+
+    if (output_path.empty() || input_paths.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    ConcatStats stats;
+    std::string error;
+    const ConcatResult result = ConcatSegments(input_paths, output_path, &stats, &error);
+
+    switch (result) {
+        case ConcatResult::kOk:
+            // 기계 판독용 결과 (한 줄 JSON)
+            printf("{\"segments\":%d,\"packets\":%lld,\"input_bytes\":%lld,\"output_bytes\":%lld,"
+                   "\"gaps_closed\":%lld,\"closed_gap_seconds\":%.3f,\"duration_seconds\":%.3f,"
+                   "\"elapsed_seconds\":%.3f,\"throughput_mb_per_sec\":%.1f}\n",
+                   stats.segment_count,
+                   static_cast<long long>(stats.packet_count),
+                   static_cast<long long>(stats.input_bytes),
+                   static_cast<long long>(stats.output_bytes),
+                   static_cast<long long>(stats.gaps_closed),
+                   stats.closed_gap_seconds,
+                   stats.output_duration_seconds,
+                   stats.elapsed_seconds,
+                   stats.throughput_mb_per_sec);
+            return 0;
+        case ConcatResult::kInvalidArgument:
+            fprintf(stderr, "❌ %s\n", error.c_str());
+            return 1;
+        case ConcatResult::kIncompatible:
+            fprintf(stderr, "❌ %s\n", error.c_str());
+            return 2;
+        case ConcatResult::kIoError:
+        default:
+            fprintf(stderr, "❌ %s\n", error.c_str());
+            return 3;
+    }
+}
@@ -0,0 +1,66 @@
+// 캡처 스레드 → 인코더 스레드 전달 큐
+// 가득 차면 가장 오래된 항목을 버림 (캡처 스레드는 인코더 속도와 무관하게 진행)
+
+#ifndef SAT_LEC_REC_CAPTURE_QUEUE_H_
+#define SAT_LEC_REC_CAPTURE_QUEUE_H_
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/// 입력: 캡처된 항목 (비디오 프레임, 오디오 패킷 등)
+/// 출력: 추가 순서대로 꺼낸 항목, 버린 항목
+/// 예외: 없음
+template <typename T>
+class CaptureQueue {
+public:
+    explicit CaptureQueue(size_t capacity) : capacity_(capacity) {}
+
+    CaptureQueue(const CaptureQueue&) = delete;
+    CaptureQueue& operator=(const CaptureQueue&) = delete;
+
+    // 항목 추가, 반환값은 추가 후 깊이
+    // 가득 차 있으면 가장 오래된 항목을 꺼내 dropped에 담음 (통계용, nullptr이면 그냥 버림)
+    size_t Push(T item, std::optional<T>* dropped = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.size() >= capacity_ && !items_.empty()) {
+            if (dropped) {
+                dropped->emplace(std::move(items_.front()));
+            }
+            items_.pop_front();
+        }
+        items_.push_back(std::move(item));
+        return items_.size();
+    }
+
+    // 가장 오래된 항목 꺼내기 (비어 있으면 false), remaining: 꺼낸 뒤 깊이
+    bool TryPop(T* out, size_t* remaining = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty()) return false;
+        *out = std::move(items_.front());
+        items_.pop_front();
+        if (remaining) *remaining = items_.size();
+        return true;
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    bool Empty() const { return Size() == 0; }
+    size_t Capacity() const { return capacity_; }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.clear();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<T> items_;
+    const size_t capacity_;
+};
+
+#endif  // SAT_LEC_REC_CAPTURE_QUEUE_H_
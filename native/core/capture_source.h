@@ -0,0 +1,108 @@
+// 캡처 소스 인터페이스 (화면/오디오 입력을 파이프라인과 분리)
+// Windows: DXGI Desktop Duplication / WASAPI loopback (windows/runner)
+// 공통: 합성 강의 생성기, 기존 영상 파일 디코딩 (Linux 부하 테스트, 프로파일링)
+
+#ifndef SAT_LEC_REC_CAPTURE_SOURCE_H_
+#define SAT_LEC_REC_CAPTURE_SOURCE_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "recorder_events.h"
+
+/// 큐에 담긴 프레임 픽셀 형식
+/// - kBgra: 소스 출력 그대로 (4바이트/픽셀)
+/// - kI420: 캡처 스레드에서 변환한 YUV420P (Y → U → V 평면을 빈틈없이 연속 배치, 1.5바이트/픽셀)
+///          인코더 입력 형식과 같아 인코더 스레드는 평면 복사만 함
+enum class FramePixelFormat {
+    kBgra = 0,
+    kI420 = 1,
+};
+
+/// 입력: 픽셀 형식, 해상도 (I420은 짝수 크기)
+/// 출력: 프레임 하나의 픽셀 바이트 수
+inline size_t FramePixelBytes(FramePixelFormat format, int width, int height) {
+    const size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    return format == FramePixelFormat::kI420 ? pixels + pixels / 2 : pixels * 4;
+}
+
+// 프레임 데이터 구조
+struct FrameData {
+    std::vector<uint8_t> pixels;  // format에 따른 픽셀 데이터 (소스는 항상 BGRA로 채움)
+    FramePixelFormat format = FramePixelFormat::kBgra;
+    int width = 0;
+    int height = 0;
+    uint64_t timestamp = 0;  // 캡처 시점 tick (파이프라인 MediaClock 기준, Windows는 QPC)
+    // 캡처 단계 시작 시점 (프레임을 얻은 직후, 대기 시간 제외, kCapture 통계용)
+    std::chrono::steady_clock::time_point acquired_at{};
+};
+
+// 오디오 샘플 데이터 구조
+struct AudioSample {
+    std::vector<uint8_t> data;      // PCM 오디오 데이터 (Interleaved Float32)
+    uint32_t frame_count = 0;       // 오디오 프레임 수
+    uint32_t sample_rate = 0;       // 샘플레이트 (Hz)
+    uint16_t channels = 0;          // 채널 수 (2 = 스테레오)
+    uint16_t bits_per_sample = 0;   // 비트 깊이
+    uint64_t timestamp = 0;         // 캡처 시점 tick (파이프라인 MediaClock 기준)
+};
+
+/// 읽기 결과
+enum class CaptureReadResult {
+    kData = 0,     // 새 프레임/패킷을 채움
+    kNoData = 1,   // 아직 없음 (비디오: 화면 변화 없음 → 파이프라인이 직전 프레임 반복)
+    kError = 2,    // 복구할 수 없는 오류 (녹화 종료)
+};
+
+/// 오디오 소스 형식 (Start 성공 후 유효)
+struct AudioSourceFormat {
+    int sample_rate = 48000;
+    int channels = 2;
+    int bits_per_sample = 32;  // Float32 (LibavEncoder 입력 형식)
+};
+
+/// 입력: 캡처 스레드의 주기적 CaptureFrame 호출 (FPS 간격은 파이프라인이 맞춤)
+/// 출력: BGRA 프레임 (타임스탬프 포함)
+/// 예외: 초기화 실패 시 Start가 false, 복구할 수 없는 캡처 오류 시 kError
+///
+/// 모든 함수는 파이프라인의 캡처 스레드 한 곳에서만 호출 (SetEventSink는 Start 전/Stop 후 파이프라인이 호출)
+/// 단계 감시 재시작 시 캡처 스레드가 Stop → Start를 다시 호출하므로 Start는 Stop 후 반복 호출 가능해야 함
+class IVideoSource {
+public:
+    virtual ~IVideoSource() = default;
+
+    virtual const char* Name() const = 0;
+    // 장치 손실/복구 알림 대상 (nullptr이면 해제, 알릴 것이 없는 소스는 무시)
+    virtual void SetEventSink(RecorderEventSink* /*sink*/) {}
+    virtual bool Start(std::string* error) = 0;
+    virtual void Stop() = 0;
+
+    // 새 프레임이 있으면 frame을 채우고 kData (크기는 호출할 때마다 다시 설정)
+    // 화면이 그대로면 kNoData (잠깐 대기할 수 있음, 최대 100ms 정도)
+    virtual CaptureReadResult CaptureFrame(FrameData* frame, std::string* error) = 0;
+};
+
+/// 입력: 오디오 스레드의 주기적 ReadPacket 호출 (약 10ms 간격)
+/// 출력: Interleaved Float32 PCM 패킷 (타임스탬프 포함)
+/// 예외: 초기화 실패 시 Start가 false, 복구할 수 없는 오류 시 kError
+///
+/// kNoData가 나올 때까지 반복 호출해서 쌓인 패킷을 모두 꺼냄 (무음 구간도 패킷 전달)
+/// 단계 감시 재시작 시 오디오 스레드가 Stop → Start를 다시 호출 (재시작 후 Format은 같아야 함)
+class IAudioSource {
+public:
+    virtual ~IAudioSource() = default;
+
+    virtual const char* Name() const = 0;
+    // 장치 손실 알림 대상 (nullptr이면 해제, 알릴 것이 없는 소스는 무시)
+    virtual void SetEventSink(RecorderEventSink* /*sink*/) {}
+    virtual bool Start(std::string* error) = 0;
+    virtual void Stop() = 0;
+    virtual AudioSourceFormat Format() const = 0;
+
+    virtual CaptureReadResult ReadPacket(AudioSample* sample, std::string* error) = 0;
+};
+
+#endif  // SAT_LEC_REC_CAPTURE_SOURCE_H_
@@ -0,0 +1,586 @@
+// 캡처 trace 기록/재생 구현
+
+#include "capture_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#include "native_logger.h"
+
+extern "C" {
+#include <libavutil/crc.h>
+}
+
+namespace {
+
+constexpr char kTraceMagic[4] = {'S', 'L', 'R', 'C'};
+constexpr uint32_t kRecordSync = 0x43524C53;  // "SLRC"
+constexpr size_t kHeaderSize = 4 + 4 * 8 + 8 * 2;
+constexpr size_t kRecordHeaderSize = 4 + 4 + 8 + 4 + 4;
+constexpr uint32_t kMaxPayloadSize = 256 * 1024 * 1024;  // 손상된 길이 필드 방어용
+constexpr size_t kMaxLiteralRun = 128;
+constexpr size_t kMaxRepeatRun = 129;
+
+// UTF-8 경로로 파일 열기 (Windows는 wide 경로 필요)
+FILE* OpenFileUtf8(const std::string& path, const char* mode) {
+#if defined(_WIN32)
+    std::wstring wide_mode(mode, mode + strlen(mode));
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, std::filesystem::u8path(path).wstring().c_str(), wide_mode.c_str()) != 0) {
+        return nullptr;
+    }
+    return file;
+#else
+    return fopen(path.c_str(), mode);
+#endif
+}
+
+uint32_t Crc32(const uint8_t* data, size_t size) {
+    return av_crc(av_crc_get_table(AV_CRC_32_IEEE_LE), UINT32_MAX, data, size) ^ UINT32_MAX;
+}
+
+void PutU32(std::vector<uint8_t>& buf, uint32_t value) {
+    uint8_t bytes[4];
+    memcpy(bytes, &value, sizeof(bytes));
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+void PutU64(std::vector<uint8_t>& buf, uint64_t value) {
+    uint8_t bytes[8];
+    memcpy(bytes, &value, sizeof(bytes));
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+void PatchU32(std::vector<uint8_t>& buf, size_t offset, uint32_t value) {
+    memcpy(buf.data() + offset, &value, sizeof(value));
+}
+
+uint32_t GetU32(const uint8_t* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t GetU64(const uint8_t* data) {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// 입력: 타일 픽셀 (행 우선)
+// 출력: out 뒤에 RLE 데이터 추가
+void EncodeRle(const uint32_t* pixels, size_t count, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < count) {
+        size_t run = 1;
+        while (i + run < count && run < kMaxRepeatRun && pixels[i + run] == pixels[i]) run++;
+        if (run >= 2) {
+            out.push_back(static_cast<uint8_t>(126 + run));
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&pixels[i]);
+            out.insert(out.end(), bytes, bytes + 4);
+            i += run;
+            continue;
+        }
+
+        // 반복이 시작되기 전까지 그대로 복사
+        const size_t start = i;
+        while (i < count && i - start < kMaxLiteralRun &&
+               !(i + 1 < count && pixels[i + 1] == pixels[i])) {
+            i++;
+        }
+        if (i == start) i++;  // 마지막 픽셀 하나
+        out.push_back(static_cast<uint8_t>(i - start - 1));
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&pixels[start]);
+        out.insert(out.end(), bytes, bytes + (i - start) * 4);
+    }
+}
+
+// 입력: RLE 데이터, 복원할 픽셀 수
+// 출력: pixels (count개), 데이터가 정확히 count개로 풀리지 않으면 false
+bool DecodeRle(const uint8_t* data, size_t size, uint32_t* pixels, size_t count) {
+    size_t pos = 0;
+    size_t written = 0;
+    while (pos < size && written < count) {
+        const uint8_t control = data[pos++];
+        if (control < 128) {
+            const size_t literal = static_cast<size_t>(control) + 1;
+            if (pos + literal * 4 > size || written + literal > count) return false;
+            memcpy(pixels + written, data + pos, literal * 4);
+            pos += literal * 4;
+            written += literal;
+        } else {
+            const size_t run = static_cast<size_t>(control) - 126;
+            if (pos + 4 > size || written + run > count) return false;
+            uint32_t pixel;
+            memcpy(&pixel, data + pos, 4);
+            pos += 4;
+            std::fill(pixels + written, pixels + written + run, pixel);
+            written += run;
+        }
+    }
+    return pos == size && written == count;
+}
+
+}  // namespace
+
+// ==============================================================================
+// trace 기록
+// ==============================================================================
+
+CaptureTraceWriter::~CaptureTraceWriter() {
+    Close();
+}
+
+bool CaptureTraceWriter::Open(const std::string& path, const CaptureTraceInfo& info, std::string* error) {
+    Close();
+
+    file_ = OpenFileUtf8(path, "wb");
+    if (!file_) {
+        *error = "캡처 trace 파일 열기 실패: " + path;
+        return false;
+    }
+
+    std::vector<uint8_t> header;
+    header.insert(header.end(), kTraceMagic, kTraceMagic + sizeof(kTraceMagic));
+    PutU32(header, kCaptureTraceVersion);
+    PutU32(header, static_cast<uint32_t>(info.width));
+    PutU32(header, static_cast<uint32_t>(info.height));
+    PutU32(header, static_cast<uint32_t>(info.fps));
+    PutU32(header, static_cast<uint32_t>(info.sample_rate));
+    PutU32(header, static_cast<uint32_t>(info.channels));
+    PutU32(header, static_cast<uint32_t>(info.bits_per_sample));
+    PutU32(header, static_cast<uint32_t>(kTileSize));
+    PutU64(header, info.qpc_frequency);
+    PutU64(header, info.start_qpc);
+    if (fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        fclose(file_);
+        file_ = nullptr;
+        *error = "캡처 trace 헤더 쓰기 실패";
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+        pending_frames_ = 0;
+        stop_requested_ = false;
+        stats_ = CaptureTraceStats{};
+        stats_.bytes_written = static_cast<int64_t>(header.size());
+    }
+    previous_frame_.clear();
+    previous_width_ = 0;
+    previous_height_ = 0;
+
+    writer_thread_ = std::thread(&CaptureTraceWriter::WriterLoop, this);
+    is_open_.store(true, std::memory_order_release);
+    SATREC_LOG_INFO("[CaptureTrace] 기록 시작: %s (%dx%d@%d, %dHz %dch %dbit)", path.c_str(),
+                    info.width, info.height, info.fps, info.sample_rate, info.channels,
+                    info.bits_per_sample);
+    return true;
+}
+
+void CaptureTraceWriter::Close() {
+    if (!writer_thread_.joinable()) return;
+
+    is_open_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    writer_thread_.join();
+
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+    free_buffers_.clear();
+    previous_frame_.clear();
+    previous_frame_.shrink_to_fit();
+
+    const CaptureTraceStats stats = GetStats();
+    const double ratio = stats.bytes_written > 0
+        ? static_cast<double>(stats.raw_bytes) / static_cast<double>(stats.bytes_written) : 0.0;
+    SATREC_LOG_INFO("[CaptureTrace] 기록 종료: 프레임 %lld (반복 %lld, 버림 %lld), 오디오 %lld, "
+                    "%.1fMB (압축률 %.1fx, 변경 타일 %.1f%%)",
+                    static_cast<long long>(stats.video_frames),
+                    static_cast<long long>(stats.repeated_frames),
+                    static_cast<long long>(stats.dropped_frames),
+                    static_cast<long long>(stats.audio_packets),
+                    static_cast<double>(stats.bytes_written) / (1024.0 * 1024.0), ratio,
+                    stats.total_tiles > 0
+                        ? 100.0 * static_cast<double>(stats.dirty_tiles) / static_cast<double>(stats.total_tiles)
+                        : 0.0);
+}
+
+void CaptureTraceWriter::AddVideoFrame(const uint8_t* bgra, int width, int height, uint64_t qpc) {
+    if (!IsOpen() || !bgra || width <= 0 || height <= 0) return;
+
+    PendingRecord record;
+    record.type = CaptureTraceRecordType::kVideoFrame;
+    record.qpc = qpc;
+    record.width = width;
+    record.height = height;
+    {
+        // 기록 스레드가 밀려 있으면 복사 전에 버림 (캡처 스레드 지연 방지)
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_frames_ >= kMaxPendingFrames) {
+            stats_.dropped_frames++;
+            return;
+        }
+        if (!free_buffers_.empty()) {
+            record.data = std::move(free_buffers_.back());
+            free_buffers_.pop_back();
+        }
+    }
+    const size_t size = static_cast<size_t>(width) * height * 4;
+    record.data.resize(size);
+    memcpy(record.data.data(), bgra, size);
+    Enqueue(std::move(record));
+}
+
+void CaptureTraceWriter::AddRepeatedFrame(uint64_t qpc) {
+    if (!IsOpen()) return;
+    PendingRecord record;
+    record.type = CaptureTraceRecordType::kRepeatedFrame;
+    record.qpc = qpc;
+    Enqueue(std::move(record));
+}
+
+void CaptureTraceWriter::AddAudio(const uint8_t* pcm, size_t size, uint32_t frame_count, uint64_t qpc) {
+    if (!IsOpen() || !pcm) return;
+    PendingRecord record;
+    record.type = CaptureTraceRecordType::kAudio;
+    record.qpc = qpc;
+    record.frame_count = frame_count;
+    record.data.assign(pcm, pcm + size);
+    Enqueue(std::move(record));
+}
+
+void CaptureTraceWriter::Enqueue(PendingRecord record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_requested_) return;
+        if (record.type == CaptureTraceRecordType::kVideoFrame) pending_frames_++;
+        pending_.push_back(std::move(record));
+    }
+    cv_.notify_one();
+}
+
+CaptureTraceStats CaptureTraceWriter::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void CaptureTraceWriter::WriterLoop() {
+    bool write_failed = false;
+    std::vector<uint8_t> payload;
+
+    while (true) {
+        PendingRecord record;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_requested_ || !pending_.empty(); });
+            if (pending_.empty()) break;  // stop_requested_ && 남은 레코드 없음
+            record = std::move(pending_.front());
+            pending_.pop_front();
+        }
+
+        payload.clear();
+        int64_t raw_bytes = 0;
+        int64_t compress_ns = 0;
+        switch (record.type) {
+            case CaptureTraceRecordType::kVideoFrame: {
+                const auto started_at = std::chrono::steady_clock::now();
+                raw_bytes = static_cast<int64_t>(record.data.size());
+                EncodeVideoPayload(record, &payload);
+                compress_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - started_at).count();
+                break;
+            }
+            case CaptureTraceRecordType::kRepeatedFrame:
+                break;
+            case CaptureTraceRecordType::kAudio:
+                raw_bytes = static_cast<int64_t>(record.data.size());
+                PutU32(payload, record.frame_count);
+                payload.insert(payload.end(), record.data.begin(), record.data.end());
+                break;
+        }
+
+        if (!write_failed && !WriteRecord(record.type, record.qpc, payload)) {
+            write_failed = true;
+            is_open_.store(false, std::memory_order_release);
+            SATREC_LOG_ERROR("[CaptureTrace] ❌ 레코드 쓰기 실패, 이후 기록 중단 (녹화는 계속)");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        switch (record.type) {
+            case CaptureTraceRecordType::kVideoFrame:
+                pending_frames_--;
+                stats_.video_frames++;
+                // EncodeVideoPayload가 직전 프레임 버퍼와 교환해 둔 버퍼를 재사용
+                if (free_buffers_.size() < kMaxPendingFrames && !record.data.empty()) {
+                    free_buffers_.push_back(std::move(record.data));
+                }
+                break;
+            case CaptureTraceRecordType::kRepeatedFrame:
+                stats_.repeated_frames++;
+                break;
+            case CaptureTraceRecordType::kAudio:
+                stats_.audio_packets++;
+                break;
+        }
+        stats_.raw_bytes += raw_bytes;
+        stats_.compress_time_ns += compress_ns;
+        if (!write_failed) {
+            stats_.bytes_written += static_cast<int64_t>(kRecordHeaderSize + payload.size());
+        }
+    }
+}
+
+void CaptureTraceWriter::EncodeVideoPayload(PendingRecord& record, std::vector<uint8_t>* payload) {
+    const int width = record.width;
+    const int height = record.height;
+    const bool keyframe = previous_frame_.size() != record.data.size() ||
+                          previous_width_ != width || previous_height_ != height;
+    const int tiles_x = (width + kTileSize - 1) / kTileSize;
+    const int tiles_y = (height + kTileSize - 1) / kTileSize;
+    const size_t stride = static_cast<size_t>(width) * 4;
+
+    PutU32(*payload, static_cast<uint32_t>(width));
+    PutU32(*payload, static_cast<uint32_t>(height));
+    const size_t tile_count_offset = payload->size();
+    PutU32(*payload, 0);
+
+    uint32_t dirty_tiles = 0;
+    std::vector<uint32_t> tile_pixels(static_cast<size_t>(kTileSize) * kTileSize);
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        const int y0 = ty * kTileSize;
+        const int tile_height = std::min(kTileSize, height - y0);
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const int x0 = tx * kTileSize;
+            const int tile_width = std::min(kTileSize, width - x0);
+            const size_t row_bytes = static_cast<size_t>(tile_width) * 4;
+            const size_t first = static_cast<size_t>(y0) * stride + static_cast<size_t>(x0) * 4;
+
+            bool dirty = keyframe;
+            for (int y = 0; !dirty && y < tile_height; ++y) {
+                const size_t offset = first + static_cast<size_t>(y) * stride;
+                dirty = memcmp(record.data.data() + offset, previous_frame_.data() + offset, row_bytes) != 0;
+            }
+            if (!dirty) continue;
+
+            for (int y = 0; y < tile_height; ++y) {
+                memcpy(tile_pixels.data() + static_cast<size_t>(y) * tile_width,
+                       record.data.data() + first + static_cast<size_t>(y) * stride, row_bytes);
+            }
+            PutU32(*payload, static_cast<uint32_t>(ty * tiles_x + tx));
+            const size_t size_offset = payload->size();
+            PutU32(*payload, 0);
+            EncodeRle(tile_pixels.data(), static_cast<size_t>(tile_width) * tile_height, *payload);
+            PatchU32(*payload, size_offset, static_cast<uint32_t>(payload->size() - size_offset - 4));
+            dirty_tiles++;
+        }
+    }
+    PatchU32(*payload, tile_count_offset, dirty_tiles);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.dirty_tiles += dirty_tiles;
+        stats_.total_tiles += static_cast<int64_t>(tiles_x) * tiles_y;
+    }
+
+    // 현재 프레임을 다음 비교 기준으로 (복사 없이 교환, 이전 버퍼는 재사용 목록으로)
+    previous_frame_.swap(record.data);
+    previous_width_ = width;
+    previous_height_ = height;
+}
+
+bool CaptureTraceWriter::WriteRecord(CaptureTraceRecordType type, uint64_t qpc,
+                                     const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> header;
+    header.reserve(kRecordHeaderSize);
+    PutU32(header, kRecordSync);
+    PutU32(header, static_cast<uint32_t>(type));
+    PutU64(header, qpc);
+    PutU32(header, static_cast<uint32_t>(payload.size()));
+    PutU32(header, Crc32(payload.data(), payload.size()));
+    if (fwrite(header.data(), 1, header.size(), file_) != header.size()) return false;
+    if (!payload.empty() && fwrite(payload.data(), 1, payload.size(), file_) != payload.size()) return false;
+    return true;
+}
+
+// ==============================================================================
+// trace 재생
+// ==============================================================================
+
+CaptureTraceReader::~CaptureTraceReader() {
+    Close();
+}
+
+bool CaptureTraceReader::Open(const std::string& path, std::string* error) {
+    Close();
+
+    file_ = OpenFileUtf8(path, "rb");
+    if (!file_) {
+        *error = "캡처 trace 파일 열기 실패: " + path;
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        memcmp(header, kTraceMagic, sizeof(kTraceMagic)) != 0) {
+        Close();
+        *error = "캡처 trace 파일이 아님: " + path;
+        return false;
+    }
+    const uint32_t version = GetU32(header + 4);
+    if (version != kCaptureTraceVersion) {
+        Close();
+        *error = "지원하지 않는 캡처 trace 버전: " + std::to_string(version);
+        return false;
+    }
+
+    info_.width = static_cast<int>(GetU32(header + 8));
+    info_.height = static_cast<int>(GetU32(header + 12));
+    info_.fps = static_cast<int>(GetU32(header + 16));
+    info_.sample_rate = static_cast<int>(GetU32(header + 20));
+    info_.channels = static_cast<int>(GetU32(header + 24));
+    info_.bits_per_sample = static_cast<int>(GetU32(header + 28));
+    tile_size_ = static_cast<int>(GetU32(header + 32));
+    info_.qpc_frequency = GetU64(header + 36);
+    info_.start_qpc = GetU64(header + 44);
+    if (tile_size_ <= 0 || tile_size_ > 1024) {
+        Close();
+        *error = "캡처 trace 헤더 손상 (tile_size)";
+        return false;
+    }
+
+    truncated_ = false;
+    frame_.clear();
+    frame_width_ = 0;
+    frame_height_ = 0;
+    return true;
+}
+
+void CaptureTraceReader::Close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool CaptureTraceReader::Next(CaptureTraceRecord* record) {
+    if (!file_) return false;
+
+    uint8_t header[kRecordHeaderSize];
+    const size_t header_read = fread(header, 1, sizeof(header), file_);
+    if (header_read != sizeof(header)) {
+        truncated_ = header_read != 0;  // 레코드 경계에서 끝났으면 정상 종료
+        return false;
+    }
+    const uint32_t sync = GetU32(header);
+    const uint32_t type = GetU32(header + 4);
+    const uint64_t qpc = GetU64(header + 8);
+    const uint32_t payload_size = GetU32(header + 16);
+    const uint32_t crc = GetU32(header + 20);
+    if (sync != kRecordSync || payload_size > kMaxPayloadSize) {
+        truncated_ = true;
+        return false;
+    }
+
+    payload_.resize(payload_size);
+    if (payload_size > 0 && fread(payload_.data(), 1, payload_size, file_) != payload_size) {
+        truncated_ = true;
+        return false;
+    }
+    if (Crc32(payload_.data(), payload_.size()) != crc) {
+        truncated_ = true;
+        return false;
+    }
+
+    record->type = static_cast<CaptureTraceRecordType>(type);
+    record->qpc = qpc;
+    record->pcm.clear();
+    record->frame_count = 0;
+    switch (record->type) {
+        case CaptureTraceRecordType::kVideoFrame:
+            if (!DecodeVideoPayload(payload_, record)) {
+                truncated_ = true;
+                return false;
+            }
+            return true;
+        case CaptureTraceRecordType::kRepeatedFrame:
+            // 첫 프레임 이전의 반복 프레임은 bgra == nullptr
+            record->bgra = frame_.empty() ? nullptr : frame_.data();
+            record->bgra_size = frame_.size();
+            record->width = frame_width_;
+            record->height = frame_height_;
+            return true;
+        case CaptureTraceRecordType::kAudio:
+            if (payload_.size() < 4) {
+                truncated_ = true;
+                return false;
+            }
+            record->frame_count = GetU32(payload_.data());
+            record->pcm.assign(payload_.begin() + 4, payload_.end());
+            return true;
+    }
+    truncated_ = true;  // 알 수 없는 레코드 종류
+    return false;
+}
+
+bool CaptureTraceReader::DecodeVideoPayload(const std::vector<uint8_t>& payload, CaptureTraceRecord* record) {
+    if (payload.size() < 12) return false;
+    const int width = static_cast<int>(GetU32(payload.data()));
+    const int height = static_cast<int>(GetU32(payload.data() + 4));
+    const uint32_t tile_count = GetU32(payload.data() + 8);
+    if (width <= 0 || height <= 0 || width > 16384 || height > 16384) return false;
+
+    // 해상도가 바뀌면 새 프레임 (이 레코드는 키프레임이어야 함)
+    const size_t frame_size = static_cast<size_t>(width) * height * 4;
+    if (width != frame_width_ || height != frame_height_ || frame_.size() != frame_size) {
+        frame_.assign(frame_size, 0);
+        frame_width_ = width;
+        frame_height_ = height;
+    }
+
+    const int tiles_x = (width + tile_size_ - 1) / tile_size_;
+    const int tiles_y = (height + tile_size_ - 1) / tile_size_;
+    const size_t stride = static_cast<size_t>(width) * 4;
+    std::vector<uint32_t> tile_pixels(static_cast<size_t>(tile_size_) * tile_size_);
+    size_t pos = 12;
+    for (uint32_t i = 0; i < tile_count; ++i) {
+        if (pos + 8 > payload.size()) return false;
+        const uint32_t tile_index = GetU32(payload.data() + pos);
+        const uint32_t encoded_size = GetU32(payload.data() + pos + 4);
+        pos += 8;
+        if (tile_index >= static_cast<uint32_t>(tiles_x * tiles_y) || pos + encoded_size > payload.size()) {
+            return false;
+        }
+
+        const int x0 = static_cast<int>(tile_index % static_cast<uint32_t>(tiles_x)) * tile_size_;
+        const int y0 = static_cast<int>(tile_index / static_cast<uint32_t>(tiles_x)) * tile_size_;
+        const int tile_width = std::min(tile_size_, width - x0);
+        const int tile_height = std::min(tile_size_, height - y0);
+        if (!DecodeRle(payload.data() + pos, encoded_size, tile_pixels.data(),
+                       static_cast<size_t>(tile_width) * tile_height)) {
+            return false;
+        }
+        pos += encoded_size;
+
+        const size_t row_bytes = static_cast<size_t>(tile_width) * 4;
+        for (int y = 0; y < tile_height; ++y) {
+            memcpy(frame_.data() + static_cast<size_t>(y0 + y) * stride + static_cast<size_t>(x0) * 4,
+                   tile_pixels.data() + static_cast<size_t>(y) * tile_width, row_bytes);
+        }
+    }
+
+    record->bgra = frame_.data();
+    record->bgra_size = frame_.size();
+    record->width = width;
+    record->height = height;
+    return true;
+}
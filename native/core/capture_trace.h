@@ -0,0 +1,175 @@
+// 캡처 trace 기록/재생 (사용자 PC의 캡처 입력을 그대로 저장해서 Linux에서 재현)
+// 비디오는 이전 프레임과 달라진 타일만 RLE 압축, 오디오는 캡처한 PCM 그대로 저장
+
+#ifndef SAT_LEC_REC_CAPTURE_TRACE_H_
+#define SAT_LEC_REC_CAPTURE_TRACE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// trace 파일 구조 (모든 정수는 little-endian)
+//
+//   [파일 헤더] magic "SLRC" | version u32 | width u32 | height u32 | fps u32 |
+//               sample_rate u32 | channels u32 | bits_per_sample u32 | tile_size u32 |
+//               qpc_frequency u64 | start_qpc u64
+//   [레코드]    sync u32 | type u32 | qpc u64 | payload_size u32 | crc32 u32 | payload
+//
+//   비디오 프레임 payload: width u32 | height u32 | tile_count u32 |
+//                          tile_count × (tile_index u32 | encoded_size u32 | RLE 데이터)
+//     - 첫 프레임과 해상도가 바뀐 프레임은 모든 타일 포함 (키프레임)
+//     - RLE: 제어 바이트 c < 128 → c+1개 픽셀 그대로, c >= 128 → 다음 픽셀 c-126번 반복
+//   반복 프레임 payload: 없음 (화면 변화 없음 → 직전 프레임 재사용)
+//   오디오 payload: frame_count u32 | PCM (헤더의 채널/비트 깊이, interleaved)
+//
+// 레코드는 append-only이므로 잘린 파일도 마지막 완전한 레코드까지 재생 가능
+constexpr uint32_t kCaptureTraceVersion = 1;
+
+enum class CaptureTraceRecordType : uint32_t {
+    kVideoFrame = 1,
+    kRepeatedFrame = 2,
+    kAudio = 3,
+};
+
+/// 입력: 없음
+/// 출력: trace 헤더 정보 (캡처 형식 + QPC 기준)
+/// 예외: 없음
+struct CaptureTraceInfo {
+    int width = 0;
+    int height = 0;
+    int fps = 0;
+    int sample_rate = 0;
+    int channels = 0;
+    int bits_per_sample = 0;
+    uint64_t qpc_frequency = 0;
+    uint64_t start_qpc = 0;  // 기록 시작 시점 (재생 시 인코더 시작 시각으로 사용)
+};
+
+/// 입력: 없음
+/// 출력: trace 기록 통계 (Close 이후 최종값)
+/// 예외: 없음
+struct CaptureTraceStats {
+    int64_t video_frames = 0;
+    int64_t repeated_frames = 0;
+    int64_t dirty_tiles = 0;
+    int64_t total_tiles = 0;
+    int64_t audio_packets = 0;
+    int64_t dropped_frames = 0;    // 기록 스레드가 밀려서 버린 프레임
+    int64_t raw_bytes = 0;         // 압축 전 캡처 데이터 크기
+    int64_t bytes_written = 0;
+    int64_t compress_time_ns = 0;  // 타일 비교 + RLE (기록 스레드)
+};
+
+/// 입력: 캡처 스레드의 BGRA 프레임 / PCM 패킷 (캡처 시점 QPC 포함)
+/// 출력: append-only trace 파일
+/// 예외: 쓰기 실패 시 기록만 중단 (녹화는 계속 진행)
+///
+/// Add* 함수는 데이터를 복사해서 기록 스레드에 넘기고 바로 반환
+/// (타일 비교, 압축, 파일 쓰기는 캡처 스레드 밖에서 처리)
+class CaptureTraceWriter {
+public:
+    static constexpr int kTileSize = 32;
+    static constexpr size_t kMaxPendingFrames = 8;  // 초과 시 새 프레임을 버림
+
+    CaptureTraceWriter() = default;
+    ~CaptureTraceWriter();
+
+    CaptureTraceWriter(const CaptureTraceWriter&) = delete;
+    CaptureTraceWriter& operator=(const CaptureTraceWriter&) = delete;
+
+    bool Open(const std::string& path, const CaptureTraceInfo& info, std::string* error);
+    void Close();
+    bool IsOpen() const { return is_open_.load(std::memory_order_acquire); }
+
+    void AddVideoFrame(const uint8_t* bgra, int width, int height, uint64_t qpc);
+    void AddRepeatedFrame(uint64_t qpc);
+    void AddAudio(const uint8_t* pcm, size_t size, uint32_t frame_count, uint64_t qpc);
+
+    CaptureTraceStats GetStats() const;
+
+private:
+    struct PendingRecord {
+        CaptureTraceRecordType type = CaptureTraceRecordType::kVideoFrame;
+        uint64_t qpc = 0;
+        int width = 0;
+        int height = 0;
+        uint32_t frame_count = 0;
+        std::vector<uint8_t> data;
+    };
+
+    void Enqueue(PendingRecord record);
+    void WriterLoop();
+    void EncodeVideoPayload(PendingRecord& record, std::vector<uint8_t>* payload);
+    bool WriteRecord(CaptureTraceRecordType type, uint64_t qpc, const std::vector<uint8_t>& payload);
+
+    std::atomic<bool> is_open_{false};
+    FILE* file_ = nullptr;
+    std::thread writer_thread_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<PendingRecord> pending_;
+    size_t pending_frames_ = 0;
+    bool stop_requested_ = false;
+    std::vector<std::vector<uint8_t>> free_buffers_;  // 프레임 버퍼 재사용 (8MB 할당 반복 방지)
+    CaptureTraceStats stats_{};
+
+    // 기록 스레드 전용: 직전 프레임 (타일 비교 기준)
+    std::vector<uint8_t> previous_frame_;
+    int previous_width_ = 0;
+    int previous_height_ = 0;
+};
+
+/// 재생용 레코드 (비디오는 누적 복원한 전체 BGRA 프레임)
+struct CaptureTraceRecord {
+    CaptureTraceRecordType type = CaptureTraceRecordType::kVideoFrame;
+    uint64_t qpc = 0;
+    // 비디오/반복 프레임: Reader 내부 버퍼 (다음 Next 호출 전까지 유효)
+    const uint8_t* bgra = nullptr;
+    size_t bgra_size = 0;
+    int width = 0;
+    int height = 0;
+    // 오디오
+    std::vector<uint8_t> pcm;
+    uint32_t frame_count = 0;
+};
+
+/// 입력: trace 파일 경로 (UTF-8)
+/// 출력: 기록 순서대로 복원한 캡처 레코드
+/// 예외: 헤더 손상 시 Open이 false, 잘리거나 손상된 레코드에서 Next가 false (truncated() 확인)
+class CaptureTraceReader {
+public:
+    CaptureTraceReader() = default;
+    ~CaptureTraceReader();
+
+    CaptureTraceReader(const CaptureTraceReader&) = delete;
+    CaptureTraceReader& operator=(const CaptureTraceReader&) = delete;
+
+    bool Open(const std::string& path, std::string* error);
+    bool Next(CaptureTraceRecord* record);
+    void Close();
+
+    const CaptureTraceInfo& info() const { return info_; }
+    // 파일 끝이 아닌 곳에서 읽기를 멈췄는지 (잘린 레코드/CRC 불일치)
+    bool truncated() const { return truncated_; }
+
+private:
+    bool DecodeVideoPayload(const std::vector<uint8_t>& payload, CaptureTraceRecord* record);
+
+    FILE* file_ = nullptr;
+    CaptureTraceInfo info_{};
+    int tile_size_ = CaptureTraceWriter::kTileSize;
+    bool truncated_ = false;
+    std::vector<uint8_t> frame_;
+    int frame_width_ = 0;
+    int frame_height_ = 0;
+    std::vector<uint8_t> payload_;
+};
+
+#endif  // SAT_LEC_REC_CAPTURE_TRACE_H_
@@ -0,0 +1,286 @@
+// CPU 예산 조절기 구현
+
+#include "cpu_governor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// x264 preset (빠른 것부터)
+constexpr const char* kPresets[] = {"ultrafast", "superfast", "veryfast", "faster", "fast",
+                                    "medium",    "slow",      "slower",   "veryslow"};
+constexpr int kPresetCount = static_cast<int>(sizeof(kPresets) / sizeof(kPresets[0]));
+constexpr int kDefaultPresetIndex = 2;  // veryfast (LibavEncoderConfig 기본값)
+
+int PresetIndex(const char* preset) {
+    if (!preset) return kDefaultPresetIndex;
+    for (int i = 0; i < kPresetCount; i++) {
+        if (strcmp(kPresets[i], preset) == 0) return i;
+    }
+    return kDefaultPresetIndex;
+}
+
+const char* ActionName(CpuGovernorAction action) {
+    switch (action) {
+        case CpuGovernorAction::kNone: return "none";
+        case CpuGovernorAction::kDegrade: return "degrade";
+        case CpuGovernorAction::kRestore: return "restore";
+    }
+    return "unknown";
+}
+
+uint64_t WallNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef _WIN32
+uint64_t FileTimeTo100Ns(const FILETIME& time) {
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+#endif
+
+}  // namespace
+
+std::vector<CpuGovernorLevel> BuildCpuGovernorLadder(int capture_fps, int min_capture_fps) {
+    const int fps_floor = std::max(1, std::min(min_capture_fps, capture_fps));
+    const int candidates[] = {capture_fps, capture_fps * 3 / 4, capture_fps / 2, capture_fps / 3};
+    std::vector<CpuGovernorLevel> ladder;
+    for (int fps : candidates) {
+        fps = std::max(fps_floor, fps);
+        if (!ladder.empty() && ladder.back().capture_fps == fps) continue;
+        ladder.push_back(CpuGovernorLevel{fps});
+    }
+    return ladder;
+}
+
+std::vector<CpuEncoderStep> BuildCpuEncoderSteps(const char* preset, int logical_cpus) {
+    const int cpus = std::max(1, logical_cpus);
+    const int preset_index = PresetIndex(preset);
+    const CpuEncoderStep candidates[] = {
+        {kPresets[preset_index], 0},
+        {kPresets[std::max(0, preset_index - 1)], std::max(2, cpus / 2)},
+        {kPresets[0], std::max(1, cpus / 4)},
+    };
+    std::vector<CpuEncoderStep> steps;
+    for (const CpuEncoderStep& step : candidates) {
+        if (!steps.empty() && strcmp(steps.back().preset, step.preset) == 0 &&
+            steps.back().encoder_threads == step.encoder_threads) {
+            continue;
+        }
+        steps.push_back(step);
+    }
+    return steps;
+}
+
+void CpuGovernor::Reset(const CpuGovernorConfig& config, std::vector<CpuGovernorLevel> ladder, int64_t now_ms) {
+    config_ = config;
+    ladder_ = ladder.empty() ? std::vector<CpuGovernorLevel>{CpuGovernorLevel()} : std::move(ladder);
+    level_ = 0;
+    max_level_ = 0;
+    hold_until_ms_ = now_ms;
+    pressure_since_ms_ = -1;
+    headroom_since_ms_ = -1;
+    exhausted_ = false;
+    idle_at_top_ = false;
+}
+
+int CpuGovernor::EncoderStepDelta() const {
+    if (exhausted_) return 1;
+    if (idle_at_top_ && max_level_ == 0) return -1;
+    return 0;
+}
+
+CpuGovernorDecision CpuGovernor::Update(const CpuUsageSample& sample, int64_t now_ms) {
+    CpuGovernorDecision decision;
+    decision.from_level = level_;
+    decision.to_level = level_;
+    if (config_.budget_percent <= 0.0 || ladder_.size() < 2) return decision;
+
+    // 변경 직후 구간은 이전 단계의 사용률이 섞여 있으므로 판단하지 않음
+    if (now_ms < hold_until_ms_) {
+        pressure_since_ms_ = -1;
+        headroom_since_ms_ = -1;
+        return decision;
+    }
+
+    const bool over_budget = sample.recorder_percent > config_.budget_percent;
+    const bool system_saturated = sample.system_percent >= config_.system_high_percent;
+    const bool headroom = sample.recorder_percent < config_.budget_percent * config_.restore_ratio &&
+                          sample.system_percent < config_.system_restore_percent;
+
+    if (over_budget || system_saturated) {
+        headroom_since_ms_ = -1;
+        if (pressure_since_ms_ < 0) pressure_since_ms_ = now_ms;
+        if (now_ms - pressure_since_ms_ >= config_.degrade_after_ms) {
+            if (level_ + 1 < level_count()) {
+                decision.action = CpuGovernorAction::kDegrade;
+                decision.reason = over_budget ? "recorder_over_budget" : "system_saturated";
+                level_++;
+                max_level_ = std::max(max_level_, level_);
+            } else if (over_budget) {
+                // 가장 낮은 fps에서도 녹화가 예산을 넘음 → 다음 녹화에서 인코더 단계를 낮춤
+                exhausted_ = true;
+            }
+        }
+    } else if (headroom) {
+        pressure_since_ms_ = -1;
+        if (headroom_since_ms_ < 0) headroom_since_ms_ = now_ms;
+        if (now_ms - headroom_since_ms_ >= config_.restore_after_ms) {
+            if (level_ > 0) {
+                decision.action = CpuGovernorAction::kRestore;
+                decision.reason = "headroom";
+                level_--;
+            } else {
+                idle_at_top_ = true;
+            }
+        }
+    } else {
+        // 예산의 restore_ratio ~ 100% 사이: 현재 단계 유지
+        pressure_since_ms_ = -1;
+        headroom_since_ms_ = -1;
+    }
+
+    if (decision.action != CpuGovernorAction::kNone) {
+        decision.to_level = level_;
+        hold_until_ms_ = now_ms + config_.hold_ms;
+        pressure_since_ms_ = -1;
+        headroom_since_ms_ = -1;
+    }
+    return decision;
+}
+
+std::string CpuGovernorDecisionJson(const CpuGovernorDecision& decision, const CpuGovernorLevel& level,
+                                    const CpuUsageSample& sample, double budget_percent) {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer),
+             "{\"action\":\"%s\",\"reason\":\"%s\",\"from\":%d,\"to\":%d,\"recorder_cpu\":%.1f,"
+             "\"system_cpu\":%.1f,\"budget\":%.1f,\"fps\":%d}",
+             ActionName(decision.action), decision.reason, decision.from_level, decision.to_level,
+             sample.recorder_percent, sample.system_percent, budget_percent, level.capture_fps);
+    return buffer;
+}
+
+CpuUsageSampler::CpuUsageSampler()
+    : logical_cpus_(std::max(1, static_cast<int>(std::thread::hardware_concurrency()))) {}
+
+void CpuUsageSampler::SetChildProcess(int64_t pid) {
+    if (pid == child_pid_) return;
+    child_pid_ = pid;
+    // 새 자식은 지금부터의 사용량만 (읽지 못하면 다음 Sample에서 0부터)
+    last_child_ns_ = 0;
+    if (pid > 0) ReadProcessCpuNs(pid, &last_child_ns_);
+}
+
+bool CpuUsageSampler::Sample(CpuUsageSample* sample) {
+    const uint64_t wall_ns = WallNs();
+    uint64_t process_ns = 0;
+    uint64_t system_busy = 0;
+    uint64_t system_total = 0;
+    if (!ReadProcessCpuNs(0, &process_ns) || !ReadSystemTimes(&system_busy, &system_total)) return false;
+    uint64_t child_ns = last_child_ns_;
+    if (child_pid_ > 0 && !ReadProcessCpuNs(child_pid_, &child_ns)) child_ns = last_child_ns_;
+
+    const bool had_baseline = has_baseline_;
+    const uint64_t wall_delta = wall_ns - last_wall_ns_;
+    const uint64_t process_delta = process_ns - last_process_ns_;
+    const uint64_t child_delta = child_ns >= last_child_ns_ ? child_ns - last_child_ns_ : 0;
+    const uint64_t busy_delta = system_busy - last_system_busy_;
+    const uint64_t total_delta = system_total - last_system_total_;
+    has_baseline_ = true;
+    last_wall_ns_ = wall_ns;
+    last_process_ns_ = process_ns;
+    last_child_ns_ = child_ns;
+    last_system_busy_ = system_busy;
+    last_system_total_ = system_total;
+    if (!had_baseline || wall_delta == 0 || total_delta == 0) return false;
+
+    const double capacity_ns = static_cast<double>(wall_delta) * logical_cpus_;
+    sample->recorder_percent =
+        std::min(100.0, 100.0 * static_cast<double>(process_delta + child_delta) / capacity_ns);
+    sample->system_percent = std::min(100.0, 100.0 * static_cast<double>(busy_delta) / static_cast<double>(total_delta));
+    return true;
+}
+
+#ifdef _WIN32
+
+bool CpuUsageSampler::ReadProcessCpuNs(int64_t pid, uint64_t* cpu_ns) {
+    HANDLE process = pid == 0 ? GetCurrentProcess()
+                              : OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (!process) return false;
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    const bool ok = GetProcessTimes(process, &creation_time, &exit_time, &kernel_time, &user_time) != 0;
+    if (pid != 0) CloseHandle(process);
+    if (!ok) return false;
+    *cpu_ns = (FileTimeTo100Ns(kernel_time) + FileTimeTo100Ns(user_time)) * 100;
+    return true;
+}
+
+bool CpuUsageSampler::ReadSystemTimes(uint64_t* busy, uint64_t* total) {
+    FILETIME idle_time, kernel_time, user_time;
+    if (!GetSystemTimes(&idle_time, &kernel_time, &user_time)) return false;
+    // 커널 시간에 유휴 시간이 포함됨
+    *total = FileTimeTo100Ns(kernel_time) + FileTimeTo100Ns(user_time);
+    *busy = *total - FileTimeTo100Ns(idle_time);
+    return true;
+}
+
+#else
+
+bool CpuUsageSampler::ReadProcessCpuNs(int64_t pid, uint64_t* cpu_ns) {
+    if (pid == 0) {
+        timespec now{};
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0) return false;
+        *cpu_ns = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+        return true;
+    }
+    // /proc/<pid>/stat: "pid (comm) state ..." 의 14, 15번째 필드 (utime, stime, clock tick)
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%lld/stat", static_cast<long long>(pid));
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+    char line[1024];
+    const bool read = fgets(line, sizeof(line), file) != nullptr;
+    fclose(file);
+    if (!read) return false;
+    const char* fields = strrchr(line, ')');
+    unsigned long long utime = 0;
+    unsigned long long stime = 0;
+    if (!fields || sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2) {
+        return false;
+    }
+    const long ticks_per_second = sysconf(_SC_CLK_TCK);
+    if (ticks_per_second <= 0) return false;
+    *cpu_ns = (utime + stime) * 1000000000ULL / static_cast<unsigned long long>(ticks_per_second);
+    return true;
+}
+
+bool CpuUsageSampler::ReadSystemTimes(uint64_t* busy, uint64_t* total) {
+    // /proc/stat 첫 줄: cpu user nice system idle iowait irq softirq steal
+    FILE* file = fopen("/proc/stat", "r");
+    if (!file) return false;
+    unsigned long long values[8] = {};
+    const int count = fscanf(file, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &values[0], &values[1], &values[2],
+                             &values[3], &values[4], &values[5], &values[6], &values[7]);
+    fclose(file);
+    if (count < 4) return false;
+    uint64_t sum = 0;
+    for (int i = 0; i < count; i++) sum += values[i];
+    const uint64_t idle = values[3] + (count > 4 ? values[4] : 0);  // idle + iowait
+    *total = sum;
+    *busy = sum - idle;
+    return true;
+}
+
+#endif
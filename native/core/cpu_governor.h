@@ -0,0 +1,155 @@
+// CPU 예산 조절기 (녹화 프로세스 CPU 사용률 + 시스템 전체 사용률 → 캡처 fps 단계 조정)
+// 강의실 PC에서 녹화가 CPU를 다 써 Zoom 영상이 끊기지 않도록, 설정한 예산(전체 CPU 대비 %) 아래로 유지
+// 녹화 중에는 fps만 바꿈 (파일 하나 유지), x264 preset/인코더 스레드는 다음 녹화 시작 때 적용할 단계로만 권함
+// 측정(CpuUsageSampler)과 판단(CpuGovernor)은 스레드/시계와 무관, 주기 호출과 적용은 파이프라인이 담당
+
+#ifndef SAT_LEC_REC_CPU_GOVERNOR_H_
+#define SAT_LEC_REC_CPU_GOVERNOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// 입력: 없음
+/// 출력: 조절기 설정
+/// 예외: 없음
+struct CpuGovernorConfig {
+    // 녹화 프로세스(인코더 자식 프로세스 포함)가 쓸 수 있는 전체 CPU 대비 사용률 (%, 0이면 조절 안 함)
+    double budget_percent = 0.0;
+    // 시스템 전체 사용률이 이 이상이면 예산 안이어도 압박으로 봄 (다른 프로그램이 CPU를 못 받는 상태)
+    double system_high_percent = 90.0;
+    // 복원 조건: 녹화 사용률 < 예산 × restore_ratio 이고 시스템 사용률 < system_restore_percent
+    double restore_ratio = 0.7;
+    double system_restore_percent = 75.0;
+    // 압박이 이 시간 동안 이어지면 한 단계 낮춤, 여유가 restore_after_ms 동안 이어지면 한 단계 복원
+    int64_t degrade_after_ms = 3000;
+    int64_t restore_after_ms = 15000;
+    // 단계를 바꾼 직후 판단 보류 (바뀐 설정이 측정에 반영될 때까지, 진동 방지)
+    int64_t hold_ms = 5000;
+    // 캡처 fps 하한
+    int min_capture_fps = 8;
+};
+
+/// 입력: 없음
+/// 출력: 녹화 중 조절 단계 하나 (0 = 원래 설정, 클수록 CPU를 덜 씀)
+/// 예외: 없음
+struct CpuGovernorLevel {
+    int capture_fps = 24;
+};
+
+/// 입력: 원래 fps, fps 하한
+/// 출력: 단계 목록 (원래 fps → 3/4 → 1/2 → 1/3, 하한으로 자르고 같은 단계는 합침)
+/// 예외: 없음
+///
+/// 캡처 간격만 바뀌므로 인코더를 다시 열지 않음 (세그먼트가 나뉘지 않음)
+std::vector<CpuGovernorLevel> BuildCpuGovernorLadder(int capture_fps, int min_capture_fps);
+
+/// 입력: 없음
+/// 출력: 다음 녹화에 적용할 인코더 단계 하나 (0 = 원래 설정)
+/// 예외: 없음
+struct CpuEncoderStep {
+    const char* preset = "veryfast";  // 정적 문자열 (LibavEncoderConfig::h264_preset에 그대로 넘김)
+    int encoder_threads = 0;          // 0이면 코덱 기본값 (자동)
+};
+
+/// 입력: 원래 preset, 논리 CPU 수
+/// 출력: 인코더 단계 목록 (원래 → 한 단계 빠른 preset + 절반 스레드 → ultrafast + 1/4 스레드, 같은 단계는 합침)
+/// 예외: 없음
+std::vector<CpuEncoderStep> BuildCpuEncoderSteps(const char* preset, int logical_cpus);
+
+/// 입력: 없음
+/// 출력: 측정 한 구간의 CPU 사용률
+/// 예외: 없음
+struct CpuUsageSample {
+    double recorder_percent = 0.0;  // 녹화 프로세스 (+ 인코더 자식), 전체 CPU 대비 %
+    double system_percent = 0.0;    // 시스템 전체 (모든 프로세스), %
+};
+
+/// 조절 판단 방향
+enum class CpuGovernorAction {
+    kNone = 0,
+    kDegrade = 1,  // 한 단계 낮춤
+    kRestore = 2,  // 한 단계 복원
+};
+
+/// 입력: 없음
+/// 출력: Update 한 번의 판단 결과
+/// 예외: 없음
+struct CpuGovernorDecision {
+    CpuGovernorAction action = CpuGovernorAction::kNone;
+    int from_level = 0;
+    int to_level = 0;
+    const char* reason = "";  // recorder_over_budget, system_saturated, headroom
+};
+
+/// 입력: 주기적인 CpuUsageSample과 현재 시각(ms, 단조 증가)
+/// 출력: 단계 변경 판단 (한 번에 한 단계)
+/// 예외: 없음
+///
+/// 히스테리시스: 낮추기는 압박이 degrade_after_ms, 복원은 여유가 restore_after_ms 이어져야 하고
+/// 압박/여유 기준 사이(예산의 70~100%)에서는 현재 단계 유지, 변경 후 hold_ms 동안은 판단하지 않음
+/// 다음 녹화의 인코더 단계 권고(EncoderStepDelta)도 같은 기준: 마지막 단계에서도 예산 초과가 degrade_after_ms 이어지면 +1,
+/// 한 번도 낮추지 않고 원래 단계에서 여유가 restore_after_ms 이어졌으면 -1
+/// 한 스레드에서만 호출
+class CpuGovernor {
+public:
+    void Reset(const CpuGovernorConfig& config, std::vector<CpuGovernorLevel> ladder, int64_t now_ms);
+    CpuGovernorDecision Update(const CpuUsageSample& sample, int64_t now_ms);
+
+    int level() const { return level_; }
+    int level_count() const { return static_cast<int>(ladder_.size()); }
+    const CpuGovernorLevel& current() const { return ladder_[static_cast<size_t>(level_)]; }
+    const CpuGovernorLevel& at(int level) const { return ladder_[static_cast<size_t>(level)]; }
+    // 다음 녹화의 인코더 단계 변화 권고 (+1 낮춤, -1 복원, 0 유지)
+    int EncoderStepDelta() const;
+
+private:
+    CpuGovernorConfig config_;
+    std::vector<CpuGovernorLevel> ladder_{CpuGovernorLevel()};
+    int level_ = 0;
+    int max_level_ = 0;
+    int64_t hold_until_ms_ = 0;
+    int64_t pressure_since_ms_ = -1;  // 압박 시작 (-1이면 압박 아님)
+    int64_t headroom_since_ms_ = -1;  // 여유 시작
+    bool exhausted_ = false;          // 마지막 단계에서도 압박이 이어짐 (fps로는 부족)
+    bool idle_at_top_ = false;        // 원래 단계에서 여유가 이어짐
+};
+
+/// 입력: 판단 결과, 바뀐 단계, 측정값, 예산
+/// 출력: 로그/이벤트용 한 줄 JSON
+///       {"action":"degrade","reason":...,"from":0,"to":1,"recorder_cpu":41.2,"system_cpu":93.0,
+///        "budget":35.0,"fps":18}
+/// 예외: 없음
+std::string CpuGovernorDecisionJson(const CpuGovernorDecision& decision, const CpuGovernorLevel& level,
+                                    const CpuUsageSample& sample, double budget_percent);
+
+/// 입력: 주기적인 Sample 호출 (첫 호출은 기준점만 잡고 false)
+/// 출력: 직전 호출 이후 구간의 녹화 프로세스/시스템 CPU 사용률
+/// 예외: 없음 - 측정 실패 시 false
+///
+/// Windows: GetProcessTimes/GetSystemTimes, Linux: CLOCK_PROCESS_CPUTIME_ID, /proc/<pid>/stat, /proc/stat
+/// 한 스레드에서만 호출
+class CpuUsageSampler {
+public:
+    CpuUsageSampler();
+
+    // 인코더 자식 프로세스도 녹화 사용률에 합침 (0이면 없음, 재시작으로 pid가 바뀌면 다시 설정)
+    void SetChildProcess(int64_t pid);
+    bool Sample(CpuUsageSample* sample);
+
+private:
+    // 누적 CPU 시간 (ns)
+    static bool ReadProcessCpuNs(int64_t pid, uint64_t* cpu_ns);  // pid 0 = 이 프로세스
+    static bool ReadSystemTimes(uint64_t* busy, uint64_t* total);
+
+    int logical_cpus_ = 1;
+    int64_t child_pid_ = 0;
+    bool has_baseline_ = false;
+    uint64_t last_wall_ns_ = 0;
+    uint64_t last_process_ns_ = 0;
+    uint64_t last_child_ns_ = 0;
+    uint64_t last_system_busy_ = 0;
+    uint64_t last_system_total_ = 0;
+};
+
+#endif  // SAT_LEC_REC_CPU_GOVERNOR_H_
@@ -0,0 +1,730 @@
+// 인코더 자식 프로세스 구현 (부모 감독 + 자식 본체)
+
+#include "encoder_process.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <thread>
+
+#include "media_clock.h"
+#include "native_logger.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace {
+
+constexpr uint32_t kChannelMagic = 0x53524543;  // "SREC"
+constexpr uint32_t kChannelVersion = 1;
+constexpr size_t kChannelAlignment = 64;
+// 자식이 처리할 항목이 없을 때 알림 대기 (heartbeat도 이 주기로 올라감)
+constexpr int kHostIdleWaitMs = 50;
+// 자식이 부모 프로세스 생존을 확인하는 주기
+constexpr auto kParentCheckInterval = std::chrono::milliseconds(500);
+// 부모가 자식 상태를 확인하는 주기 (Start 준비 대기, Finish)
+constexpr auto kSupervisePollInterval = std::chrono::milliseconds(5);
+// 오디오 슬롯 하나에 담을 최대 길이 (WASAPI 패킷은 보통 10ms)
+constexpr int kAudioSlotMs = 200;
+
+enum class EncoderHostState : uint32_t {
+    kStarting = 0,
+    kReady = 1,    // 인코더 시작, 출력 파일 열림
+    kFailed = 2,   // 인코더 시작 실패 (error에 원인)
+    kFinished = 3, // closing 후 남은 항목까지 인코딩하고 파일을 닫음
+};
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void CopyText(char* dest, size_t capacity, const std::string& text) {
+    const size_t length = std::min(text.size(), capacity - 1);
+    memcpy(dest, text.data(), length);
+    dest[length] = '\0';
+}
+
+// ============================================================================
+// 프로세스 유틸리티
+// ============================================================================
+
+int64_t CurrentProcessId() {
+#ifdef _WIN32
+    return static_cast<int64_t>(GetCurrentProcessId());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+bool IsProcessAlive(int64_t pid) {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!process) return false;
+    const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+bool SpawnChild(const std::string& path, const std::vector<std::string>& args, int64_t* pid, void** handle,
+                std::string* error) {
+#ifdef _WIN32
+    // 명령줄: "경로" "인자"... (인자는 채널 이름과 로그 경로뿐이라 따옴표가 들어가지 않음)
+    std::wstring command_line = L"\"" + std::filesystem::u8path(path).wstring() + L"\"";
+    for (const std::string& arg : args) {
+        command_line += L" \"" + std::filesystem::u8path(arg).wstring() + L"\"";
+    }
+    STARTUPINFOW startup_info{};
+    startup_info.cb = sizeof(startup_info);
+    PROCESS_INFORMATION process_info{};
+    if (!CreateProcessW(nullptr, command_line.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr,
+                        &startup_info, &process_info)) {
+        *error = "인코더 프로세스 실행 실패 (" + std::to_string(::GetLastError()) + "): " + path;
+        return false;
+    }
+    CloseHandle(process_info.hThread);
+    *pid = static_cast<int64_t>(process_info.dwProcessId);
+    *handle = process_info.hProcess;
+    return true;
+#else
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(path.c_str()));
+    for (const std::string& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    pid_t child = 0;
+    const int result = posix_spawn(&child, path.c_str(), nullptr, nullptr, argv.data(), environ);
+    if (result != 0) {
+        *error = "인코더 프로세스 실행 실패 (" + std::string(strerror(result)) + "): " + path;
+        return false;
+    }
+    *pid = static_cast<int64_t>(child);
+    *handle = nullptr;
+    return true;
+#endif
+}
+
+// 종료했으면 true + 종료 코드 (신호로 죽었으면 128 + 신호 번호), block이면 끝날 때까지 대기
+bool WaitChild(int64_t pid, void* handle, bool block, int* exit_code) {
+#ifdef _WIN32
+    (void)pid;
+    if (WaitForSingleObject(static_cast<HANDLE>(handle), block ? INFINITE : 0) != WAIT_OBJECT_0) {
+        return false;
+    }
+    DWORD code = 0;
+    GetExitCodeProcess(static_cast<HANDLE>(handle), &code);
+    CloseHandle(static_cast<HANDLE>(handle));
+    *exit_code = static_cast<int>(code);
+    return true;
+#else
+    (void)handle;
+    int status = 0;
+    const pid_t result = waitpid(static_cast<pid_t>(pid), &status, block ? 0 : WNOHANG);
+    if (result == 0) return false;
+    if (result < 0) {
+        *exit_code = -1;  // 이미 회수됨
+        return true;
+    }
+    *exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return true;
+#endif
+}
+
+void KillChild(int64_t pid, void* handle) {
+#ifdef _WIN32
+    (void)pid;
+    TerminateProcess(static_cast<HANDLE>(handle), 1);
+#else
+    (void)handle;
+    kill(static_cast<pid_t>(pid), SIGKILL);
+#endif
+}
+
+}  // namespace
+
+/// 입력: 없음
+/// 출력: 자식에게 넘기는 인코더 설정 (공유 메모리에 그대로 놓이는 POD)
+/// 예외: 없음
+struct EncoderHostSettings {
+    char output_path[1024];  // UTF-8, 재시작마다 다음 세그먼트 경로
+    int32_t width;
+    int32_t height;
+    int32_t fps;
+    int32_t audio_sample_rate;
+    int32_t audio_channels;
+    int32_t container;
+    int32_t enable_fragmented_mp4;
+    int32_t matroska_cluster_time_ms;
+    int32_t h264_crf;
+    char h264_preset[16];
+    int32_t aac_bitrate;
+    int32_t enable_packet_journal;
+    int32_t journal_flush_interval_ms;
+};
+
+/// 입력: 없음
+/// 출력: 공유 메모리 맨 앞의 채널 헤더 (뒤에 비디오 링, 오디오 링)
+/// 예외: 없음
+struct EncoderChannelHeader {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t video_ring_offset = 0;
+    uint64_t video_ring_bytes = 0;
+    uint64_t audio_ring_offset = 0;
+    uint64_t audio_ring_bytes = 0;
+    uint64_t video_slots = 0;
+    uint64_t video_slot_bytes = 0;
+    uint64_t audio_slots = 0;
+    uint64_t audio_slot_bytes = 0;
+    int64_t parent_pid = 0;
+    EncoderHostSettings settings{};
+
+    std::atomic<uint64_t> start_tick{0};     // PTS 기준 (0이면 자식이 처음 꺼낸 항목 시각)
+    std::atomic<uint32_t> host_state{0};     // EncoderHostState
+    std::atomic<uint32_t> closing{0};        // 1: 더 넣을 항목 없음 (남은 항목까지 인코딩 후 종료)
+    std::atomic<uint32_t> discard{0};        // 1: 남은 항목을 버리고 바로 파일을 닫음
+    std::atomic<uint32_t> in_flight{0};      // 자식이 인코딩 중인 항목 종류 (0: 없음, 죽으면 부모가 버림)
+    std::atomic<uint32_t> data_word{0};      // 생산자 → 자식 알림 (SharedSignal)
+    std::atomic<uint64_t> heartbeat{0};      // 자식 루프가 돌 때마다 증가
+    std::atomic<int64_t> video_frames{0};    // 현재 세그먼트
+    std::atomic<int64_t> audio_samples{0};
+    std::atomic<int64_t> muxed_bytes{0};
+    std::atomic<int64_t> discarded_items{0};  // discard로 버린 항목 (세그먼트 무관 누적)
+    char error[256] = {};
+};
+
+// ============================================================================
+// EncoderProcess (부모)
+// ============================================================================
+
+EncoderProcess::EncoderProcess() = default;
+
+EncoderProcess::~EncoderProcess() {
+    if (child_running_) {
+        // 정상 경로는 Finish, 여기서는 남은 항목을 버리고 짧게 기다린 뒤 강제 종료
+        header_->closing.store(1, std::memory_order_release);
+        header_->discard.store(1, std::memory_order_release);
+        data_signal_.Notify();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        int exit_code = 0;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (WaitChild(child_pid_.load(), child_handle_, false, &exit_code)) {
+                child_running_ = false;
+                break;
+            }
+            std::this_thread::sleep_for(kSupervisePollInterval);
+        }
+        ReapChild(true);
+    }
+    data_signal_.Detach();
+}
+
+bool EncoderProcess::Start(const EncoderProcessConfig& config, std::string* error) {
+    if (child_running_) {
+        *error = "인코더 프로세스가 이미 실행 중입니다";
+        return false;
+    }
+    if (config.host_path.empty()) {
+        *error = "인코더 프로세스 경로 없음";
+        return false;
+    }
+    if (!config.encoder.secondary_output_path.empty() || config.encoder.start_in_preroll) {
+        *error = "인코더 프로세스 모드는 보조 출력/pre-roll을 지원하지 않음";
+        return false;
+    }
+    const std::string output_utf8 = std::filesystem::path(config.encoder.output_path).u8string();
+    if (output_utf8.size() >= sizeof(EncoderHostSettings::output_path)) {
+        *error = "출력 경로가 너무 김";
+        return false;
+    }
+
+    config_ = config;
+    restart_count_ = 0;
+    base_video_frames_ = 0;
+    base_audio_samples_ = 0;
+    base_muxed_bytes_ = 0;
+    lost_items_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        last_error_.clear();
+        segment_paths_.assign(1, config.encoder.output_path);
+    }
+
+    // 채널 배치: 헤더 | 비디오 링 (슬롯 = 프레임 하나) | 오디오 링 (슬롯 = 200ms)
+    const size_t video_slot_bytes = FramePixelBytes(config.frame_format, config.encoder.video_width,
+                                                    config.encoder.video_height);
+    const size_t audio_slot_bytes = std::max<size_t>(
+        4096, static_cast<size_t>(config.encoder.audio_sample_rate) * static_cast<size_t>(config.encoder.audio_channels) *
+                  sizeof(float) * kAudioSlotMs / 1000);
+    const size_t video_slots = std::max<size_t>(2, config.video_slots);
+    const size_t audio_slots = std::max<size_t>(2, config.audio_slots);
+    const size_t video_offset = AlignUp(sizeof(EncoderChannelHeader), kChannelAlignment);
+    const size_t video_bytes = SharedFrameRing::RequiredBytes(video_slots, video_slot_bytes);
+    const size_t audio_offset = AlignUp(video_offset + video_bytes, kChannelAlignment);
+    const size_t audio_bytes = SharedFrameRing::RequiredBytes(audio_slots, audio_slot_bytes);
+
+    static std::atomic<uint32_t> channel_counter{0};
+    channel_name_ = "satrec_enc_" + std::to_string(CurrentProcessId()) + "_" +
+                    std::to_string(channel_counter.fetch_add(1) + 1);
+    data_signal_.Detach();
+    header_ = nullptr;
+    if (!region_.Create(channel_name_, audio_offset + audio_bytes, error)) {
+        return false;
+    }
+
+    header_ = new (region_.data()) EncoderChannelHeader();
+    header_->magic = kChannelMagic;
+    header_->version = kChannelVersion;
+    header_->video_ring_offset = video_offset;
+    header_->video_ring_bytes = video_bytes;
+    header_->audio_ring_offset = audio_offset;
+    header_->audio_ring_bytes = audio_bytes;
+    header_->video_slots = video_slots;
+    header_->video_slot_bytes = video_slot_bytes;
+    header_->audio_slots = audio_slots;
+    header_->audio_slot_bytes = audio_slot_bytes;
+    header_->parent_pid = CurrentProcessId();
+
+    EncoderHostSettings& settings = header_->settings;
+    CopyText(settings.output_path, sizeof(settings.output_path), output_utf8);
+    settings.width = config.encoder.video_width;
+    settings.height = config.encoder.video_height;
+    settings.fps = config.encoder.video_fps;
+    settings.audio_sample_rate = config.encoder.audio_sample_rate;
+    settings.audio_channels = config.encoder.audio_channels;
+    settings.container = static_cast<int32_t>(config.encoder.container);
+    settings.enable_fragmented_mp4 = config.encoder.enable_fragmented_mp4 ? 1 : 0;
+    settings.matroska_cluster_time_ms = config.encoder.matroska_cluster_time_ms;
+    settings.h264_crf = config.encoder.h264_crf;
+    CopyText(settings.h264_preset, sizeof(settings.h264_preset),
+             config.encoder.h264_preset ? config.encoder.h264_preset : "veryfast");
+    settings.aac_bitrate = config.encoder.aac_bitrate;
+    settings.enable_packet_journal = config.encoder.enable_packet_journal ? 1 : 0;
+    settings.journal_flush_interval_ms = config.encoder.journal_flush_interval_ms;
+
+    if (!video_ring_.Attach(region_.data() + video_offset, video_bytes, video_slots, video_slot_bytes, true) ||
+        !audio_ring_.Attach(region_.data() + audio_offset, audio_bytes, audio_slots, audio_slot_bytes, true)) {
+        *error = "공유 링 초기화 실패";
+        region_.Close();
+        header_ = nullptr;
+        return false;
+    }
+    data_signal_.Attach(&header_->data_word, channel_name_ + "_data");
+
+    if (!Spawn(error)) {
+        region_.Close();
+        header_ = nullptr;
+        return false;
+    }
+
+    // 자식이 인코더를 시작하고 출력 파일을 열 때까지 대기
+    const auto started_at = std::chrono::steady_clock::now();
+    const auto deadline = started_at + std::chrono::milliseconds(config_.ready_timeout_ms);
+    int exit_code = 0;
+    while (header_->host_state.load(std::memory_order_acquire) == static_cast<uint32_t>(EncoderHostState::kStarting)) {
+        if (WaitChild(child_pid_.load(), child_handle_, false, &exit_code)) {
+            child_running_ = false;
+            break;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) break;
+        std::this_thread::sleep_for(kSupervisePollInterval);
+    }
+    if (header_->host_state.load(std::memory_order_acquire) != static_cast<uint32_t>(EncoderHostState::kReady)) {
+        if (header_->error[0] != '\0') {
+            *error = header_->error;
+        } else if (!child_running_) {
+            *error = "인코더 프로세스가 시작 중 종료됨 (종료 코드 " + std::to_string(exit_code) + ")";
+        } else {
+            *error = "인코더 프로세스 준비 시간 초과";
+        }
+        ReapChild(true);
+        data_signal_.Detach();
+        region_.Close();
+        header_ = nullptr;
+        return false;
+    }
+
+    last_heartbeat_ = header_->heartbeat.load(std::memory_order_relaxed);
+    heartbeat_at_ = std::chrono::steady_clock::now();
+    SATREC_LOG_INFO("[EncoderProcess] ✅ 인코더 프로세스 준비 (pid %lld, 채널 %s, 비디오 슬롯 %zu × %.1fMB, %.1fms)",
+                    static_cast<long long>(child_pid_.load()), channel_name_.c_str(), video_slots,
+                    static_cast<double>(video_slot_bytes) / (1024.0 * 1024.0),
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_at).count());
+    return true;
+}
+
+void EncoderProcess::SetStartTick(uint64_t tick) {
+    if (header_) header_->start_tick.store(tick, std::memory_order_release);
+}
+
+bool EncoderProcess::Spawn(std::string* error) {
+    int64_t pid = 0;
+    void* handle = nullptr;
+    // 자식 로그도 앱과 같은 파일에 (NativeLogger가 매번 열고 닫으므로 두 프로세스가 번갈아 추가)
+    std::vector<std::string> args = {"--channel", channel_name_};
+    const std::string log_path = NativeLogger::Instance().GetFilePath();
+    if (!log_path.empty()) {
+        args.push_back("--log");
+        args.push_back(log_path);
+    }
+    if (config_.lower_priority) args.push_back("--lower-priority");
+    if (!SpawnChild(config_.host_path, args, &pid, &handle, error)) {
+        return false;
+    }
+    child_pid_ = pid;
+    child_handle_ = handle;
+    child_running_ = true;
+    return true;
+}
+
+void EncoderProcess::ReapChild(bool kill) {
+    if (!child_running_) return;
+    if (kill) KillChild(child_pid_.load(), child_handle_);
+    int exit_code = 0;
+    WaitChild(child_pid_.load(), child_handle_, true, &exit_code);
+    child_handle_ = nullptr;
+    child_running_ = false;
+}
+
+bool EncoderProcess::PushVideo(const FrameData& frame) {
+    if (!header_) return false;
+    SharedRingItem* item = video_ring_.TryAcquire();
+    if (!item || frame.pixels.size() > video_ring_.MaxItemBytes()) return false;
+    item->kind = SharedRingItemKind::kVideo;
+    item->bytes = static_cast<uint32_t>(frame.pixels.size());
+    item->timestamp = frame.timestamp;
+    item->width = frame.width;
+    item->height = frame.height;
+    item->format = static_cast<int32_t>(frame.format);
+    memcpy(SharedFrameRing::Payload(item), frame.pixels.data(), frame.pixels.size());
+    video_ring_.Publish();
+    data_signal_.Notify();
+    return true;
+}
+
+bool EncoderProcess::PushAudio(const AudioSample& sample) {
+    if (!header_) return false;
+    SharedRingItem* item = audio_ring_.TryAcquire();
+    if (!item || sample.data.size() > audio_ring_.MaxItemBytes()) return false;
+    item->kind = SharedRingItemKind::kAudio;
+    item->bytes = static_cast<uint32_t>(sample.data.size());
+    item->timestamp = sample.timestamp;
+    item->frame_count = sample.frame_count;
+    item->sample_rate = sample.sample_rate;
+    item->channels = sample.channels;
+    item->bits_per_sample = sample.bits_per_sample;
+    memcpy(SharedFrameRing::Payload(item), sample.data.data(), sample.data.size());
+    audio_ring_.Publish();
+    data_signal_.Notify();
+    return true;
+}
+
+bool EncoderProcess::Restart(const char* reason) {
+    ReapChild(true);
+
+    // 죽은 자식이 인코딩하던 항목은 다시 넣으면 같은 이유로 죽을 수 있으므로 버림 (자식 대신 소비)
+    const uint32_t in_flight = header_->in_flight.exchange(0, std::memory_order_acq_rel);
+    if (in_flight == static_cast<uint32_t>(SharedRingItemKind::kVideo) && video_ring_.Peek()) {
+        video_ring_.Release();
+        lost_items_.fetch_add(1, std::memory_order_relaxed);
+    } else if (in_flight == static_cast<uint32_t>(SharedRingItemKind::kAudio) && audio_ring_.Peek()) {
+        audio_ring_.Release();
+        lost_items_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 현재 세그먼트 값을 합계로 옮기고 새 세그먼트는 0부터
+    base_video_frames_.fetch_add(header_->video_frames.exchange(0), std::memory_order_relaxed);
+    base_audio_samples_.fetch_add(header_->audio_samples.exchange(0), std::memory_order_relaxed);
+    base_muxed_bytes_.fetch_add(header_->muxed_bytes.exchange(0), std::memory_order_relaxed);
+
+    const int restart = restart_count_.fetch_add(1) + 1;
+    if (restart > config_.max_restarts) {
+        SetLastError(std::string("인코더 프로세스 재시작 한도 초과 (") + reason + ")");
+        SATREC_LOG_ERROR("[EncoderProcess] ❌ 재시작 한도 %d회 초과: %s", config_.max_restarts, reason);
+        return false;
+    }
+
+    const std::wstring segment_path = RecordingSegmentPath(config_.encoder.output_path, restart);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        segment_paths_.push_back(segment_path);
+    }
+    CopyText(header_->settings.output_path, sizeof(header_->settings.output_path),
+             std::filesystem::path(segment_path).u8string());
+    header_->start_tick.store(0, std::memory_order_relaxed);
+    header_->error[0] = '\0';
+    header_->host_state.store(static_cast<uint32_t>(EncoderHostState::kStarting), std::memory_order_release);
+
+    SATREC_LOG_WARN("[EncoderProcess] ⚠️ 인코더 프로세스 재시작 %d/%d (%s), 새 세그먼트: %s", restart,
+                    config_.max_restarts, reason, std::filesystem::path(segment_path).u8string().c_str());
+    std::string error;
+    if (!Spawn(&error)) {
+        SetLastError(error);
+        return false;
+    }
+    last_heartbeat_ = header_->heartbeat.load(std::memory_order_relaxed);
+    heartbeat_at_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+EncoderProcessStatus EncoderProcess::Poll() {
+    if (!header_) return EncoderProcessStatus::kRunning;
+    if (!child_running_) return EncoderProcessStatus::kFailed;
+
+    int exit_code = 0;
+    if (WaitChild(child_pid_.load(), child_handle_, false, &exit_code)) {
+        child_running_ = false;
+        const std::string reason = "종료 코드 " + std::to_string(exit_code);
+        return Restart(reason.c_str()) ? EncoderProcessStatus::kRestarted : EncoderProcessStatus::kFailed;
+    }
+    const auto state = static_cast<EncoderHostState>(header_->host_state.load(std::memory_order_acquire));
+    if (state == EncoderHostState::kFailed) {
+        const std::string reason = std::string("인코더 시작 실패: ") + header_->error;
+        return Restart(reason.c_str()) ? EncoderProcessStatus::kRestarted : EncoderProcessStatus::kFailed;
+    }
+
+    // 루프가 멈춤 (드라이버/코덱 교착): 준비 중에는 준비 한도, 이후에는 hang 한도
+    const uint64_t heartbeat = header_->heartbeat.load(std::memory_order_relaxed);
+    const auto now = std::chrono::steady_clock::now();
+    if (heartbeat != last_heartbeat_) {
+        last_heartbeat_ = heartbeat;
+        heartbeat_at_ = now;
+        return EncoderProcessStatus::kRunning;
+    }
+    const int timeout_ms = state == EncoderHostState::kStarting ? config_.ready_timeout_ms : config_.hang_timeout_ms;
+    if (now - heartbeat_at_ >= std::chrono::milliseconds(timeout_ms)) {
+        return Restart("응답 없음") ? EncoderProcessStatus::kRestarted : EncoderProcessStatus::kFailed;
+    }
+    return EncoderProcessStatus::kRunning;
+}
+
+bool EncoderProcess::Finish(int deadline_ms) {
+    if (!header_ || !child_running_) return false;
+    header_->closing.store(1, std::memory_order_release);
+    data_signal_.Notify();
+
+    const auto started_at = std::chrono::steady_clock::now();
+    auto discard_at = started_at;
+    bool discard_sent = false;
+    bool finished = false;
+    while (child_running_) {
+        int exit_code = 0;
+        if (WaitChild(child_pid_.load(), child_handle_, false, &exit_code)) {
+            child_running_ = false;
+            finished = exit_code == 0 && header_->host_state.load(std::memory_order_acquire) ==
+                                             static_cast<uint32_t>(EncoderHostState::kFinished);
+            // 남은 항목이 있는데 죽었으면 새 세그먼트로 마저 인코딩 (closing은 그대로라 다 비우면 종료)
+            if (!finished && !discard_sent && (VideoDepth() > 0 || AudioDepth() > 0)) {
+                const std::string reason = "종료 처리 중 종료 코드 " + std::to_string(exit_code);
+                if (Restart(reason.c_str())) continue;
+            }
+            break;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const uint64_t heartbeat = header_->heartbeat.load(std::memory_order_relaxed);
+        if (heartbeat != last_heartbeat_) {
+            last_heartbeat_ = heartbeat;
+            heartbeat_at_ = now;
+        }
+        if (deadline_ms > 0 && !discard_sent && now - started_at >= std::chrono::milliseconds(deadline_ms)) {
+            SATREC_LOG_WARN("[EncoderProcess] ⚠️ 종료 처리 기한 %dms 초과, 남은 항목을 버리고 파일을 닫음 (비디오 %zu, 오디오 %zu)",
+                            deadline_ms, VideoDepth(), AudioDepth());
+            header_->discard.store(1, std::memory_order_release);
+            data_signal_.Notify();
+            discard_sent = true;
+            discard_at = now;
+        }
+        const bool discard_expired = discard_sent && now - discard_at >= std::chrono::milliseconds(config_.hang_timeout_ms);
+        const bool hung = now - heartbeat_at_ >= std::chrono::milliseconds(config_.hang_timeout_ms);
+        if (discard_expired || hung) {
+            SATREC_LOG_ERROR("[EncoderProcess] ❌ 인코더 프로세스가 종료되지 않아 강제 종료 (마지막 세그먼트는 trailer 없음)");
+            ReapChild(true);
+            break;
+        }
+        std::this_thread::sleep_for(kSupervisePollInterval);
+    }
+    if (!finished && GetLastError().empty()) {
+        SetLastError("인코더 프로세스가 마지막 세그먼트를 정상적으로 닫지 못함");
+    }
+    return finished;
+}
+
+std::string EncoderProcess::GetLastError() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return last_error_;
+}
+
+void EncoderProcess::SetLastError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    last_error_ = error;
+}
+
+std::vector<std::wstring> EncoderProcess::GetSegmentPaths() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return segment_paths_;
+}
+
+std::wstring EncoderProcess::CurrentSegmentPath() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return segment_paths_.empty() ? std::wstring() : segment_paths_.back();
+}
+
+int64_t EncoderProcess::GetVideoFrameCount() const {
+    return base_video_frames_.load(std::memory_order_relaxed) +
+           (header_ ? header_->video_frames.load(std::memory_order_relaxed) : 0);
+}
+
+int64_t EncoderProcess::GetAudioSampleCount() const {
+    return base_audio_samples_.load(std::memory_order_relaxed) +
+           (header_ ? header_->audio_samples.load(std::memory_order_relaxed) : 0);
+}
+
+int64_t EncoderProcess::GetMuxedBytes() const {
+    return base_muxed_bytes_.load(std::memory_order_relaxed) +
+           (header_ ? header_->muxed_bytes.load(std::memory_order_relaxed) : 0);
+}
+
+int64_t EncoderProcess::GetDiscardedItems() const {
+    return lost_items_.load(std::memory_order_relaxed) +
+           (header_ ? header_->discarded_items.load(std::memory_order_relaxed) : 0);
+}
+
+// ============================================================================
+// 자식 프로세스 본체
+// ============================================================================
+
+int RunEncoderHost(const std::string& channel_name) {
+    TraceRecorder::Instance().SetThreadName("encoder_host");
+    SharedMemoryRegion region;
+    std::string error;
+    if (!region.Open(channel_name, &error)) {
+        SATREC_LOG_ERROR("[EncoderHost] ❌ %s", error.c_str());
+        return 1;
+    }
+    auto* header = reinterpret_cast<EncoderChannelHeader*>(region.data());
+    if (region.size() < sizeof(EncoderChannelHeader) || header->magic != kChannelMagic ||
+        header->version != kChannelVersion) {
+        SATREC_LOG_ERROR("[EncoderHost] ❌ 채널 형식 불일치: %s", channel_name.c_str());
+        return 1;
+    }
+    SharedFrameRing video_ring;
+    SharedFrameRing audio_ring;
+    if (!video_ring.Attach(region.data() + header->video_ring_offset, header->video_ring_bytes,
+                           header->video_slots, header->video_slot_bytes, false) ||
+        !audio_ring.Attach(region.data() + header->audio_ring_offset, header->audio_ring_bytes,
+                           header->audio_slots, header->audio_slot_bytes, false)) {
+        SATREC_LOG_ERROR("[EncoderHost] ❌ 공유 링 연결 실패");
+        return 1;
+    }
+    SharedSignal data_signal;
+    data_signal.Attach(&header->data_word, channel_name + "_data");
+
+    const EncoderHostSettings& settings = header->settings;
+    const std::string preset(settings.h264_preset);
+    LibavEncoderConfig config;
+    config.output_path = std::filesystem::u8path(settings.output_path).wstring();
+    config.video_width = settings.width;
+    config.video_height = settings.height;
+    config.video_fps = settings.fps;
+    config.audio_sample_rate = settings.audio_sample_rate;
+    config.audio_channels = settings.audio_channels;
+    config.container = static_cast<RecordingContainer>(settings.container);
+    config.enable_fragmented_mp4 = settings.enable_fragmented_mp4 != 0;
+    config.matroska_cluster_time_ms = settings.matroska_cluster_time_ms;
+    config.h264_crf = settings.h264_crf;
+    config.h264_preset = preset.c_str();
+    config.aac_bitrate = settings.aac_bitrate;
+    config.enable_packet_journal = settings.enable_packet_journal != 0;
+    config.journal_flush_interval_ms = settings.journal_flush_interval_ms;
+    config.clock = &SystemMediaClock::Instance();
+
+    LibavEncoder encoder;
+    if (!encoder.Start(config)) {
+        CopyText(header->error, sizeof(header->error), encoder.GetLastError());
+        header->host_state.store(static_cast<uint32_t>(EncoderHostState::kFailed), std::memory_order_release);
+        return 2;
+    }
+    header->host_state.store(static_cast<uint32_t>(EncoderHostState::kReady), std::memory_order_release);
+    SATREC_LOG_INFO("[EncoderHost] ✅ 인코더 시작: %s", settings.output_path);
+
+    bool rebased = false;
+    auto parent_checked_at = std::chrono::steady_clock::now();
+    while (true) {
+        header->heartbeat.fetch_add(1, std::memory_order_relaxed);
+        if (header->discard.load(std::memory_order_acquire)) {
+            int64_t discarded = 0;
+            for (; video_ring.Peek(); discarded++) video_ring.Release();
+            for (; audio_ring.Peek(); discarded++) audio_ring.Release();
+            header->discarded_items.fetch_add(discarded, std::memory_order_relaxed);
+            break;
+        }
+
+        const uint32_t signal_value = data_signal.Load();
+        const SharedRingItem* video = video_ring.Peek();
+        const SharedRingItem* audio = audio_ring.Peek();
+        if (!video && !audio) {
+            // 부모는 생산을 끝낸 뒤 closing을 세우므로, closing을 본 뒤 다시 비어 있으면 끝
+            if (header->closing.load(std::memory_order_acquire)) {
+                if (!video_ring.Peek() && !audio_ring.Peek()) break;
+                continue;
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (now - parent_checked_at >= kParentCheckInterval) {
+                parent_checked_at = now;
+                if (!IsProcessAlive(header->parent_pid)) {
+                    SATREC_LOG_WARN("[EncoderHost] ⚠️ 부모 프로세스 종료, 지금까지의 파일을 닫고 종료");
+                    break;
+                }
+            }
+            data_signal.Wait(signal_value, kHostIdleWaitMs);
+            continue;
+        }
+
+        // 캡처 시각이 이른 쪽부터 (A/V 인터리브 순서 유지)
+        const bool take_video = video && (!audio || video->timestamp <= audio->timestamp);
+        const SharedRingItem* item = take_video ? video : audio;
+        if (!rebased) {
+            rebased = true;
+            const uint64_t start_tick = header->start_tick.load(std::memory_order_acquire);
+            encoder.ResetStartTime(start_tick != 0 ? start_tick : item->timestamp);
+        }
+
+        // 인코딩 중 표시는 Release 전에 지움 (그 사이에 죽으면 같은 항목을 한 번 더 인코딩할 뿐 잃지 않음)
+        header->in_flight.store(static_cast<uint32_t>(item->kind), std::memory_order_release);
+        bool ok = false;
+        if (take_video) {
+            ok = item->format == static_cast<int32_t>(FramePixelFormat::kI420)
+                ? encoder.EncodeVideoI420(SharedFrameRing::Payload(item), item->bytes, item->timestamp)
+                : encoder.EncodeVideo(SharedFrameRing::Payload(item), item->bytes, item->timestamp);
+            if (ok) header->video_frames.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ok = encoder.EncodeAudio(SharedFrameRing::Payload(item), item->bytes, item->timestamp);
+            if (ok) header->audio_samples.fetch_add(item->frame_count, std::memory_order_relaxed);
+        }
+        if (!ok) {
+            CopyText(header->error, sizeof(header->error), encoder.GetLastError());
+        }
+        header->in_flight.store(0, std::memory_order_release);
+        (take_video ? video_ring : audio_ring).Release();
+        header->muxed_bytes.store(encoder.GetMuxedBytes(), std::memory_order_relaxed);
+    }
+
+    encoder.Stop();
+    header->host_state.store(static_cast<uint32_t>(EncoderHostState::kFinished), std::memory_order_release);
+    SATREC_LOG_INFO("[EncoderHost] 인코더 종료 (비디오 %lld프레임)",
+                    static_cast<long long>(header->video_frames.load(std::memory_order_relaxed)));
+    return 0;
+}
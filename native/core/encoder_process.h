@@ -0,0 +1,145 @@
+// 인코더 자식 프로세스 (앱에서는 캡처만, 인코딩은 satrec_encoder_host 프로세스에서)
+// FFmpeg/드라이버 크래시가 앱 전체(Flutter, 스케줄러)를 끌고 내려가지 않도록 격리
+// 프레임/오디오는 공유 메모리 링(shared_frame_ring.h)으로 넘기고, 자식이 죽으면 새 세그먼트로 다시 띄움
+
+#ifndef SAT_LEC_REC_ENCODER_PROCESS_H_
+#define SAT_LEC_REC_ENCODER_PROCESS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "capture_source.h"
+#include "libav_encoder.h"
+#include "shared_frame_ring.h"
+
+struct EncoderChannelHeader;
+
+/// 입력: 없음
+/// 출력: 인코더 프로세스 설정
+/// 예외: 없음
+struct EncoderProcessConfig {
+    // satrec_encoder_host 실행 파일 경로 (UTF-8)
+    std::string host_path;
+
+    // 출력 경로/해상도/FPS/오디오 형식/컨테이너/품질 (보조 출력, pre-roll은 지원하지 않음)
+    // clock은 무시하고 항상 SystemMediaClock (두 프로세스가 같은 시계를 봐야 함)
+    LibavEncoderConfig encoder;
+
+    // 링에 넣을 프레임 형식과 슬롯 수 (비디오 슬롯 크기 = 프레임 크기, 오디오 슬롯 = 200ms)
+    FramePixelFormat frame_format = FramePixelFormat::kBgra;
+    size_t video_slots = 16;
+    size_t audio_slots = 100;
+
+    // 자식 프로세스 전체를 인코더 우선순위로 낮춤 (캡처/오디오가 먼저, thread_policy.h)
+    bool lower_priority = true;
+    // 자식이 죽거나 멈췄을 때 새 세그먼트로 다시 띄우는 최대 횟수 (넘으면 Poll이 kFailed)
+    int max_restarts = 3;
+    // 자식 준비(인코더 시작, 파일 열기) 대기 한도
+    int ready_timeout_ms = 10000;
+    // 처리할 항목이 있는데 자식 루프가 이 시간 동안 멈추면 강제 종료 후 재시작
+    int hang_timeout_ms = 5000;
+};
+
+/// 감독 결과
+enum class EncoderProcessStatus {
+    kRunning = 0,
+    kRestarted = 1,  // 자식이 죽어서 새 세그먼트로 다시 띄움 (CurrentSegmentPath)
+    kFailed = 2,     // 재시작 한도 초과 또는 재시작 실패 (GetLastError)
+};
+
+/// 입력: EncoderProcessConfig, 캡처 프레임/오디오
+/// 출력: 자식 프로세스가 인코딩한 세그먼트 파일들 (재시작마다 <이름>_part<N>.<확장자>)
+/// 예외: 시작 실패 시 Start가 false + error, 이후 실패는 Poll 결과와 GetLastError
+///
+/// 스레드: PushVideo는 캡처 스레드, PushAudio는 오디오 스레드 (링마다 생산자 하나),
+/// Poll/Finish는 감독 스레드 한 곳에서만 호출, 통계 조회는 아무 스레드에서나
+class EncoderProcess {
+public:
+    EncoderProcess();
+    ~EncoderProcess();
+
+    EncoderProcess(const EncoderProcess&) = delete;
+    EncoderProcess& operator=(const EncoderProcess&) = delete;
+
+    // 공유 메모리 생성 → 자식 실행 → 인코더 준비(출력 파일 열기)까지 대기
+    bool Start(const EncoderProcessConfig& config, std::string* error);
+    // PTS 기준 시점 (첫 항목을 넣기 전에 호출, 재시작한 세그먼트는 자기 첫 항목이 기준)
+    void SetStartTick(uint64_t tick);
+
+    // 링 슬롯에 바로 기록 (가득 찼거나 슬롯보다 크면 false → 호출자가 드롭으로 셈)
+    bool PushVideo(const FrameData& frame);
+    bool PushAudio(const AudioSample& sample);
+
+    // 자식 상태 확인 (종료/실패/멈춤이면 새 세그먼트로 재시작)
+    EncoderProcessStatus Poll();
+    // 더 넣을 항목 없음 → 자식이 남은 항목을 인코딩하고 파일을 닫을 때까지 대기
+    // deadline_ms > 0이면 그 뒤 남은 항목을 버리게 하고, 그래도 끝나지 않으면 강제 종료
+    // 반환: 마지막 세그먼트를 정상적으로 닫았는지
+    bool Finish(int deadline_ms);
+
+    std::string GetLastError() const;
+    std::vector<std::wstring> GetSegmentPaths() const;
+    std::wstring CurrentSegmentPath() const;
+    int GetRestartCount() const { return restart_count_.load(std::memory_order_relaxed); }
+    int64_t GetProcessId() const { return child_pid_.load(std::memory_order_relaxed); }
+
+    // 모든 세그먼트 합계
+    int64_t GetVideoFrameCount() const;
+    int64_t GetAudioSampleCount() const;
+    int64_t GetMuxedBytes() const;
+    // 자식 크래시로 잃은 항목 + 종료 기한 초과로 버린 항목
+    int64_t GetDiscardedItems() const;
+
+    size_t VideoDepth() const { return video_ring_.Size(); }
+    size_t AudioDepth() const { return audio_ring_.Size(); }
+    size_t VideoCapacity() const { return video_ring_.Capacity(); }
+    size_t AudioCapacity() const { return audio_ring_.Capacity(); }
+
+private:
+    bool Spawn(std::string* error);
+    // 자식 종료/강제 종료 후 상태 정리 (처리 중이던 항목은 버림), 다음 세그먼트로 다시 실행
+    bool Restart(const char* reason);
+    void ReapChild(bool kill);
+    void SetLastError(const std::string& error);
+
+    EncoderProcessConfig config_;
+    std::string channel_name_;
+    SharedMemoryRegion region_;
+    EncoderChannelHeader* header_ = nullptr;
+    SharedFrameRing video_ring_;
+    SharedFrameRing audio_ring_;
+    SharedSignal data_signal_;
+
+    // 자식 프로세스 (감독 스레드 전용, pid만 통계용으로 공개)
+    std::atomic<int64_t> child_pid_{0};
+    void* child_handle_ = nullptr;  // Windows HANDLE
+    bool child_running_ = false;
+    uint64_t last_heartbeat_ = 0;
+    std::chrono::steady_clock::time_point heartbeat_at_{};
+
+    std::atomic<int> restart_count_{0};
+    // 이전 세그먼트까지의 합계 (현재 세그먼트 값은 공유 헤더)
+    std::atomic<int64_t> base_video_frames_{0};
+    std::atomic<int64_t> base_audio_samples_{0};
+    std::atomic<int64_t> base_muxed_bytes_{0};
+    std::atomic<int64_t> lost_items_{0};
+
+    mutable std::mutex state_mutex_;
+    std::string last_error_;
+    std::vector<std::wstring> segment_paths_;
+};
+
+/// 입력: 공유 메모리 채널 이름 (satrec_encoder_host --channel 인자)
+/// 출력: 자식 프로세스 본체, 종료 코드 (0: 정상 종료, 1: 채널 오류, 2: 인코더 시작 실패)
+/// 예외: 없음
+///
+/// 링에서 캡처 시각이 이른 항목부터 슬롯 메모리에서 바로 인코딩, 부모가 closing을 세우면 남은 항목까지 처리 후 종료
+/// 부모 프로세스가 사라져도 지금까지의 파일은 닫고 종료
+int RunEncoderHost(const std::string& channel_name);
+
+#endif  // SAT_LEC_REC_ENCODER_PROCESS_H_
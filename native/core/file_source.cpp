@@ -0,0 +1,436 @@
+// 영상 파일 캡처 소스 구현
+
+#include "file_source.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libswresample/swresample.h>
+#include <libswscale/swscale.h>
+}
+
+#include "native_logger.h"
+
+namespace {
+
+std::string AvErrorToString(int errnum) {
+    char err_buf[128];
+    av_strerror(errnum, err_buf, sizeof(err_buf));
+    return std::string(err_buf);
+}
+
+constexpr double kDefaultFrameDuration = 1.0 / 30.0;
+
+}  // namespace
+
+/// 입력: 파일 경로, 스트림 종류 (비디오/오디오)
+/// 출력: 해당 스트림의 디코딩 프레임 (파일 순서대로)
+/// 예외: 열기/디코딩 실패 시 false + error
+class MediaFileDecoder {
+public:
+    ~MediaFileDecoder() {
+        av_packet_free(&packet_);
+        avcodec_free_context(&codec_ctx_);
+        avformat_close_input(&format_ctx_);
+    }
+
+    bool Open(const std::string& path, AVMediaType type, std::string* error) {
+        int ret = avformat_open_input(&format_ctx_, path.c_str(), nullptr, nullptr);
+        if (ret < 0) {
+            *error = "파일 열기 실패: " + AvErrorToString(ret);
+            return false;
+        }
+        ret = avformat_find_stream_info(format_ctx_, nullptr);
+        if (ret < 0) {
+            *error = "스트림 정보 읽기 실패: " + AvErrorToString(ret);
+            return false;
+        }
+
+        const AVCodec* codec = nullptr;
+        stream_index_ = av_find_best_stream(format_ctx_, type, -1, -1, &codec, 0);
+        if (stream_index_ < 0 || !codec) {
+            *error = std::string(type == AVMEDIA_TYPE_VIDEO ? "비디오" : "오디오") + " 스트림 없음";
+            return false;
+        }
+        AVStream* stream = format_ctx_->streams[stream_index_];
+        codec_ctx_ = avcodec_alloc_context3(codec);
+        packet_ = av_packet_alloc();
+        if (!codec_ctx_ || !packet_) {
+            *error = "디코더 할당 실패";
+            return false;
+        }
+        ret = avcodec_parameters_to_context(codec_ctx_, stream->codecpar);
+        if (ret >= 0) {
+            ret = avcodec_open2(codec_ctx_, codec, nullptr);
+        }
+        if (ret < 0) {
+            *error = "디코더 열기 실패: " + AvErrorToString(ret);
+            return false;
+        }
+
+        time_base_ = av_q2d(stream->time_base);
+        start_pts_ = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        const AVRational rate = stream->avg_frame_rate.num > 0 ? stream->avg_frame_rate : stream->r_frame_rate;
+        frame_duration_ = rate.num > 0 && rate.den > 0 ? av_q2d(av_inv_q(rate)) : kDefaultFrameDuration;
+        return true;
+    }
+
+    // 다음 프레임 디코딩 (파일 끝이면 false + end_of_file = true)
+    bool ReadFrame(AVFrame* frame, bool* end_of_file, std::string* error) {
+        *end_of_file = false;
+        while (true) {
+            int ret = avcodec_receive_frame(codec_ctx_, frame);
+            if (ret == 0) return true;
+            if (ret == AVERROR_EOF) {
+                *end_of_file = true;
+                return false;
+            }
+            if (ret != AVERROR(EAGAIN)) {
+                *error = "avcodec_receive_frame 실패: " + AvErrorToString(ret);
+                return false;
+            }
+
+            // 디코더에 패킷 더 넣기 (파일 끝이면 남은 프레임 flush)
+            if (draining_) continue;
+            ret = av_read_frame(format_ctx_, packet_);
+            if (ret < 0) {
+                if (ret != AVERROR_EOF) {
+                    *error = "av_read_frame 실패: " + AvErrorToString(ret);
+                    return false;
+                }
+                draining_ = true;
+                avcodec_send_packet(codec_ctx_, nullptr);
+                continue;
+            }
+            if (packet_->stream_index == stream_index_) {
+                ret = avcodec_send_packet(codec_ctx_, packet_);
+                if (ret < 0 && ret != AVERROR(EAGAIN)) {
+                    av_packet_unref(packet_);
+                    *error = "avcodec_send_packet 실패: " + AvErrorToString(ret);
+                    return false;
+                }
+            }
+            av_packet_unref(packet_);
+        }
+    }
+
+    // 처음으로 되감기 (반복 재생)
+    bool Rewind(std::string* error) {
+        const int ret = av_seek_frame(format_ctx_, stream_index_, start_pts_, AVSEEK_FLAG_BACKWARD);
+        if (ret < 0) {
+            *error = "처음으로 되감기 실패: " + AvErrorToString(ret);
+            return false;
+        }
+        avcodec_flush_buffers(codec_ctx_);
+        draining_ = false;
+        return true;
+    }
+
+    // 파일 시작 기준 프레임 표시 시각 (초)
+    double FrameSeconds(const AVFrame* frame) const {
+        const int64_t pts = frame->best_effort_timestamp != AV_NOPTS_VALUE ? frame->best_effort_timestamp
+                                                                           : frame->pts;
+        if (pts == AV_NOPTS_VALUE) return 0.0;
+        return static_cast<double>(pts - start_pts_) * time_base_;
+    }
+
+    AVCodecContext* codec_context() const { return codec_ctx_; }
+    double frame_duration() const { return frame_duration_; }
+
+private:
+    AVFormatContext* format_ctx_ = nullptr;
+    AVCodecContext* codec_ctx_ = nullptr;
+    AVPacket* packet_ = nullptr;
+    int stream_index_ = -1;
+    bool draining_ = false;
+    double time_base_ = 0.0;
+    int64_t start_pts_ = 0;
+    double frame_duration_ = kDefaultFrameDuration;
+};
+
+// ============================================================================
+// FileVideoSource
+// ============================================================================
+
+FileVideoSource::FileVideoSource(const std::string& path, int width, int height, bool loop,
+                                 const MediaClock* clock)
+    : path_(path), width_(width), height_(height), loop_(loop),
+      clock_(clock ? clock : &SystemMediaClock::Instance()) {}
+
+FileVideoSource::~FileVideoSource() {
+    Stop();
+}
+
+bool FileVideoSource::Start(std::string* error) {
+    Stop();
+    if (width_ <= 0 || height_ <= 0) {
+        *error = "잘못된 출력 해상도";
+        return false;
+    }
+    decoder_ = std::make_unique<MediaFileDecoder>();
+    if (!decoder_->Open(path_, AVMEDIA_TYPE_VIDEO, error)) {
+        decoder_.reset();
+        return false;
+    }
+    current_ = av_frame_alloc();
+    pending_ = av_frame_alloc();
+    if (!current_ || !pending_) {
+        *error = "프레임 할당 실패";
+        Stop();
+        return false;
+    }
+    frame_duration_seconds_ = decoder_->frame_duration();
+    start_tick_ = clock_->Now();
+    SATREC_LOG_INFO("[FileSource] 비디오 파일 재생 시작: %s (출력 %dx%d, 반복 %s)",
+                    path_.c_str(), width_, height_, loop_ ? "예" : "아니오");
+    return true;
+}
+
+void FileVideoSource::Stop() {
+    sws_freeContext(sws_ctx_);
+    sws_ctx_ = nullptr;
+    av_frame_free(&current_);
+    av_frame_free(&pending_);
+    decoder_.reset();
+    has_current_ = false;
+    has_pending_ = false;
+    end_of_file_ = false;
+    loop_offset_seconds_ = 0.0;
+    last_frame_seconds_ = 0.0;
+}
+
+CaptureReadResult FileVideoSource::CaptureFrame(FrameData* frame, std::string* error) {
+    if (!decoder_) {
+        *error = "FileVideoSource가 시작되지 않음";
+        return CaptureReadResult::kError;
+    }
+
+    const uint64_t now = clock_->Now();
+    const double elapsed_seconds = static_cast<double>(clock_->ElapsedNs(start_tick_, now)) / 1e9;
+
+    // 표시 시각이 지난 프레임까지 디코딩 (마지막 것만 표시)
+    bool advanced = false;
+    bool decoded_since_rewind = true;
+    while (true) {
+        if (!has_pending_) {
+            if (end_of_file_) break;
+            bool eof = false;
+            if (!decoder_->ReadFrame(pending_, &eof, error)) {
+                if (!eof) return CaptureReadResult::kError;
+                if (!loop_ || !decoded_since_rewind) {
+                    end_of_file_ = true;
+                    break;
+                }
+                loop_offset_seconds_ += last_frame_seconds_ + frame_duration_seconds_;
+                if (!decoder_->Rewind(error)) return CaptureReadResult::kError;
+                decoded_since_rewind = false;
+                continue;
+            }
+            has_pending_ = true;
+            decoded_since_rewind = true;
+            pending_seconds_ = loop_offset_seconds_ + decoder_->FrameSeconds(pending_);
+        }
+        // 첫 프레임은 시각과 무관하게 바로 표시
+        if (has_current_ && pending_seconds_ > elapsed_seconds) break;
+
+        last_frame_seconds_ = pending_seconds_ - loop_offset_seconds_;
+        av_frame_unref(current_);
+        av_frame_move_ref(current_, pending_);
+        has_current_ = true;
+        has_pending_ = false;
+        advanced = true;
+    }
+
+    if (!advanced) {
+        return CaptureReadResult::kNoData;
+    }
+    if (!ConvertCurrent(frame, error)) {
+        return CaptureReadResult::kError;
+    }
+    frame->timestamp = now;
+    return CaptureReadResult::kData;
+}
+
+bool FileVideoSource::ConvertCurrent(FrameData* frame, std::string* error) {
+    frame->acquired_at = std::chrono::steady_clock::now();
+    sws_ctx_ = sws_getCachedContext(sws_ctx_, current_->width, current_->height,
+                                    static_cast<AVPixelFormat>(current_->format),
+                                    width_, height_, AV_PIX_FMT_BGRA, SWS_BILINEAR,
+                                    nullptr, nullptr, nullptr);
+    if (!sws_ctx_) {
+        *error = "sws_getCachedContext 실패";
+        return false;
+    }
+
+    frame->width = width_;
+    frame->height = height_;
+    frame->pixels.resize(static_cast<size_t>(width_) * height_ * 4);
+    uint8_t* dst_data[4] = {frame->pixels.data(), nullptr, nullptr, nullptr};
+    int dst_linesize[4] = {width_ * 4, 0, 0, 0};
+    sws_scale(sws_ctx_, current_->data, current_->linesize, 0, current_->height, dst_data, dst_linesize);
+    return true;
+}
+
+// ============================================================================
+// FileAudioSource
+// ============================================================================
+
+FileAudioSource::FileAudioSource(const std::string& path, int sample_rate, int channels, bool loop,
+                                 const MediaClock* clock)
+    : path_(path), sample_rate_(sample_rate), channels_(channels), loop_(loop),
+      clock_(clock ? clock : &SystemMediaClock::Instance()) {
+    packet_frames_ = std::max(sample_rate_ / 100, 1);
+}
+
+FileAudioSource::~FileAudioSource() {
+    Stop();
+}
+
+bool FileAudioSource::Start(std::string* error) {
+    Stop();
+    if (sample_rate_ <= 0 || channels_ <= 0) {
+        *error = "잘못된 오디오 형식";
+        return false;
+    }
+    decoder_ = std::make_unique<MediaFileDecoder>();
+    if (!decoder_->Open(path_, AVMEDIA_TYPE_AUDIO, error)) {
+        decoder_.reset();
+        return false;
+    }
+
+    const AVCodecContext* codec_ctx = decoder_->codec_context();
+    AVChannelLayout in_layout;
+    if (codec_ctx->ch_layout.order == AV_CHANNEL_ORDER_UNSPEC) {
+        av_channel_layout_default(&in_layout, codec_ctx->ch_layout.nb_channels);
+    } else {
+        av_channel_layout_copy(&in_layout, &codec_ctx->ch_layout);
+    }
+    AVChannelLayout out_layout;
+    av_channel_layout_default(&out_layout, channels_);
+
+    int ret = swr_alloc_set_opts2(&swr_ctx_, &out_layout, AV_SAMPLE_FMT_FLT, sample_rate_,
+                                  &in_layout, codec_ctx->sample_fmt, codec_ctx->sample_rate, 0, nullptr);
+    av_channel_layout_uninit(&in_layout);
+    av_channel_layout_uninit(&out_layout);
+    if (ret >= 0) {
+        ret = swr_init(swr_ctx_);
+    }
+    if (ret < 0) {
+        *error = "오디오 변환기 초기화 실패: " + AvErrorToString(ret);
+        Stop();
+        return false;
+    }
+
+    decoded_ = av_frame_alloc();
+    if (!decoded_) {
+        *error = "프레임 할당 실패";
+        Stop();
+        return false;
+    }
+    start_tick_ = clock_->Now();
+    SATREC_LOG_INFO("[FileSource] 오디오 파일 재생 시작: %s (%d Hz → %d Hz, %d채널)",
+                    path_.c_str(), codec_ctx->sample_rate, sample_rate_, channels_);
+    return true;
+}
+
+void FileAudioSource::Stop() {
+    swr_free(&swr_ctx_);
+    av_frame_free(&decoded_);
+    decoder_.reset();
+    buffer_.clear();
+    buffer_offset_ = 0;
+    end_of_file_ = false;
+    emitted_samples_ = 0;
+}
+
+AudioSourceFormat FileAudioSource::Format() const {
+    AudioSourceFormat format;
+    format.sample_rate = sample_rate_;
+    format.channels = channels_;
+    format.bits_per_sample = 32;
+    return format;
+}
+
+bool FileAudioSource::FillBuffer(size_t needed_floats, std::string* error) {
+    bool decoded_since_rewind = true;
+    while (buffer_.size() - buffer_offset_ < needed_floats) {
+        if (end_of_file_) {
+            // 반복 재생하지 않으면 무음으로 채움
+            buffer_.resize(buffer_offset_ + needed_floats, 0.0f);
+            return true;
+        }
+
+        bool eof = false;
+        if (!decoder_->ReadFrame(decoded_, &eof, error)) {
+            if (!eof) return false;
+            if (!loop_ || !decoded_since_rewind) {
+                end_of_file_ = true;
+                continue;
+            }
+            if (!decoder_->Rewind(error)) return false;
+            decoded_since_rewind = false;
+            continue;
+        }
+        decoded_since_rewind = true;
+
+        // 변환 결과를 버퍼 끝에 추가
+        const int out_capacity = swr_get_out_samples(swr_ctx_, decoded_->nb_samples);
+        if (out_capacity < 0) {
+            av_frame_unref(decoded_);
+            *error = "swr_get_out_samples 실패";
+            return false;
+        }
+        const size_t old_size = buffer_.size();
+        buffer_.resize(old_size + static_cast<size_t>(out_capacity) * channels_);
+        uint8_t* out_data[1] = {reinterpret_cast<uint8_t*>(buffer_.data() + old_size)};
+        const int converted = swr_convert(swr_ctx_, out_data, out_capacity,
+                                          const_cast<const uint8_t**>(decoded_->extended_data),
+                                          decoded_->nb_samples);
+        av_frame_unref(decoded_);
+        if (converted < 0) {
+            buffer_.resize(old_size);
+            *error = "swr_convert 실패: " + AvErrorToString(converted);
+            return false;
+        }
+        buffer_.resize(old_size + static_cast<size_t>(converted) * channels_);
+    }
+    return true;
+}
+
+CaptureReadResult FileAudioSource::ReadPacket(AudioSample* sample, std::string* error) {
+    if (!decoder_) {
+        *error = "FileAudioSource가 시작되지 않음";
+        return CaptureReadResult::kError;
+    }
+
+    const int64_t available = clock_->PositionAt(start_tick_, clock_->Now(), sample_rate_) - emitted_samples_;
+    if (available < packet_frames_) {
+        return CaptureReadResult::kNoData;
+    }
+
+    const size_t packet_floats = static_cast<size_t>(packet_frames_) * channels_;
+    if (!FillBuffer(packet_floats, error)) {
+        return CaptureReadResult::kError;
+    }
+
+    sample->frame_count = static_cast<uint32_t>(packet_frames_);
+    sample->sample_rate = static_cast<uint32_t>(sample_rate_);
+    sample->channels = static_cast<uint16_t>(channels_);
+    sample->bits_per_sample = 32;
+    sample->data.resize(packet_floats * sizeof(float));
+    memcpy(sample->data.data(), buffer_.data() + buffer_offset_, packet_floats * sizeof(float));
+    sample->timestamp = clock_->TickAt(start_tick_, emitted_samples_, sample_rate_);
+    emitted_samples_ += packet_frames_;
+
+    // 내보낸 앞부분 정리 (버퍼가 계속 커지지 않도록)
+    buffer_offset_ += packet_floats;
+    if (buffer_offset_ >= buffer_.size() / 2) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(buffer_offset_));
+        buffer_offset_ = 0;
+    }
+    return CaptureReadResult::kData;
+}
@@ -0,0 +1,97 @@
+// 영상 파일 캡처 소스 (기존 녹화/강의 영상을 디코딩해서 실제 시간에 맞춰 내보냄)
+// 실제 강의 콘텐츠로 파이프라인 부하를 재현할 때 사용 (Linux 프로파일링)
+
+#ifndef SAT_LEC_REC_FILE_SOURCE_H_
+#define SAT_LEC_REC_FILE_SOURCE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "capture_source.h"
+#include "media_clock.h"
+
+struct AVFrame;
+struct SwsContext;
+struct SwrContext;
+class MediaFileDecoder;
+
+/// 입력: 영상 파일 경로 (UTF-8), 출력 해상도, 시계 (nullptr이면 SystemMediaClock)
+/// 출력: 경과 시간에 해당하는 디코딩 프레임 (출력 해상도 BGRA로 변환)
+/// 예외: 파일/디코더 열기 실패 시 Start가 false
+///
+/// - 새로 표시할 프레임이 없으면 kNoData (파이프라인이 직전 프레임 반복)
+/// - loop가 true면 파일 끝에서 처음으로 돌아가 계속 재생, false면 마지막 프레임 유지
+class FileVideoSource : public IVideoSource {
+public:
+    FileVideoSource(const std::string& path, int width, int height, bool loop = true,
+                    const MediaClock* clock = nullptr);
+    ~FileVideoSource() override;
+
+    const char* Name() const override { return "file"; }
+    bool Start(std::string* error) override;
+    void Stop() override;
+    CaptureReadResult CaptureFrame(FrameData* frame, std::string* error) override;
+
+private:
+    bool ConvertCurrent(FrameData* frame, std::string* error);
+
+    std::string path_;
+    int width_;
+    int height_;
+    bool loop_;
+    const MediaClock* clock_;
+
+    std::unique_ptr<MediaFileDecoder> decoder_;
+    SwsContext* sws_ctx_ = nullptr;
+    AVFrame* current_ = nullptr;   // 지금 표시 중인 프레임
+    AVFrame* pending_ = nullptr;   // 디코딩했지만 아직 표시 시각이 안 된 프레임
+    bool has_current_ = false;
+    bool has_pending_ = false;
+    bool end_of_file_ = false;
+    double pending_seconds_ = 0.0;
+    double loop_offset_seconds_ = 0.0;  // 반복 재생 누적 길이
+    double last_frame_seconds_ = 0.0;
+    double frame_duration_seconds_ = 0.0;
+    uint64_t start_tick_ = 0;
+};
+
+/// 입력: 영상 파일 경로 (UTF-8), 출력 샘플레이트/채널, 시계 (nullptr이면 SystemMediaClock)
+/// 출력: 경과 시간만큼 Float32 Interleaved로 변환한 10ms 패킷
+/// 예외: 파일/디코더 열기 실패 시 Start가 false
+///
+/// 오디오 스트림이 끝나면 loop가 true면 처음부터, false면 무음 패킷을 계속 전달
+class FileAudioSource : public IAudioSource {
+public:
+    FileAudioSource(const std::string& path, int sample_rate = 48000, int channels = 2, bool loop = true,
+                    const MediaClock* clock = nullptr);
+    ~FileAudioSource() override;
+
+    const char* Name() const override { return "file"; }
+    bool Start(std::string* error) override;
+    void Stop() override;
+    AudioSourceFormat Format() const override;
+    CaptureReadResult ReadPacket(AudioSample* sample, std::string* error) override;
+
+private:
+    bool FillBuffer(size_t needed_floats, std::string* error);
+
+    std::string path_;
+    int sample_rate_;
+    int channels_;
+    bool loop_;
+    const MediaClock* clock_;
+
+    std::unique_ptr<MediaFileDecoder> decoder_;
+    SwrContext* swr_ctx_ = nullptr;
+    AVFrame* decoded_ = nullptr;
+    std::vector<float> buffer_;   // 변환했지만 아직 내보내지 않은 샘플
+    size_t buffer_offset_ = 0;
+    bool end_of_file_ = false;
+    int packet_frames_ = 480;
+    uint64_t start_tick_ = 0;
+    int64_t emitted_samples_ = 0;
+};
+
+#endif  // SAT_LEC_REC_FILE_SOURCE_H_
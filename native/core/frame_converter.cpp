@@ -0,0 +1,58 @@
+// 캡처 스레드 프레임 변환 구현
+
+#include "frame_converter.h"
+
+#include <utility>
+
+extern "C" {
+#include <libswscale/swscale.h>
+}
+
+FrameConverter::~FrameConverter() {
+    if (sws_ctx_) {
+        sws_freeContext(sws_ctx_);
+        sws_ctx_ = nullptr;
+    }
+}
+
+bool FrameConverter::ConvertToI420(FrameData* frame, std::string* error) {
+    if (frame->format == FramePixelFormat::kI420) {
+        return true;
+    }
+    const int width = frame->width;
+    const int height = frame->height;
+    if (width <= 0 || height <= 0 || (width % 2) != 0 || (height % 2) != 0) {
+        *error = "I420 변환은 짝수 해상도만 지원";
+        return false;
+    }
+    if (frame->pixels.size() != FramePixelBytes(FramePixelFormat::kBgra, width, height)) {
+        *error = "BGRA 프레임 크기 불일치";
+        return false;
+    }
+
+    // 같은 해상도면 기존 컨텍스트 재사용
+    sws_ctx_ = sws_getCachedContext(sws_ctx_, width, height, AV_PIX_FMT_BGRA,
+                                    width, height, AV_PIX_FMT_YUV420P,
+                                    SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!sws_ctx_) {
+        *error = "SwsContext 생성 실패";
+        return false;
+    }
+
+    // Y(w×h) → U(w/2×h/2) → V(w/2×h/2) 연속 배치
+    std::vector<uint8_t> i420(FramePixelBytes(FramePixelFormat::kI420, width, height));
+    const size_t luma_bytes = static_cast<size_t>(width) * static_cast<size_t>(height);
+    uint8_t* dst_data[3] = {i420.data(), i420.data() + luma_bytes, i420.data() + luma_bytes + luma_bytes / 4};
+    int dst_linesize[3] = {width, width / 2, width / 2};
+    const uint8_t* src_data[1] = {frame->pixels.data()};
+    int src_linesize[1] = {width * 4};
+
+    if (sws_scale(sws_ctx_, src_data, src_linesize, 0, height, dst_data, dst_linesize) != height) {
+        *error = "sws_scale 실패";
+        return false;
+    }
+
+    frame->pixels = std::move(i420);
+    frame->format = FramePixelFormat::kI420;
+    return true;
+}
@@ -0,0 +1,34 @@
+// 캡처 스레드 프레임 변환 (BGRA → I420)
+// 큐에 쌓이는 프레임 메모리를 4 → 1.5바이트/픽셀로 줄임
+
+#ifndef SAT_LEC_REC_FRAME_CONVERTER_H_
+#define SAT_LEC_REC_FRAME_CONVERTER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "capture_source.h"
+
+struct SwsContext;
+
+/// 입력: BGRA FrameData (캡처 소스 출력)
+/// 출력: 같은 FrameData를 I420 (FramePixelFormat::kI420)으로 교체
+/// 예외: 홀수 크기 또는 sws_scale 실패 시 false + error (frame은 BGRA 그대로)
+///
+/// 한 스레드(캡처 스레드)에서만 사용, 해상도가 바뀌면 변환 컨텍스트를 다시 만듦
+class FrameConverter {
+public:
+    FrameConverter() = default;
+    ~FrameConverter();
+
+    FrameConverter(const FrameConverter&) = delete;
+    FrameConverter& operator=(const FrameConverter&) = delete;
+
+    bool ConvertToI420(FrameData* frame, std::string* error);
+
+private:
+    SwsContext* sws_ctx_ = nullptr;
+};
+
+#endif  // SAT_LEC_REC_FRAME_CONVERTER_H_
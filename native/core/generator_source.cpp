@@ -0,0 +1,70 @@
+// 합성 강의 캡처 소스 구현
+
+#include "generator_source.h"
+
+#include <algorithm>
+
+GeneratorVideoSource::GeneratorVideoSource(const SyntheticLectureConfig& config, const MediaClock* clock)
+    : lecture_(config), clock_(clock ? clock : &SystemMediaClock::Instance()) {}
+
+bool GeneratorVideoSource::Start(std::string* /*error*/) {
+    start_tick_ = clock_->Now();
+    last_frame_index_ = -1;
+    return true;
+}
+
+CaptureReadResult GeneratorVideoSource::CaptureFrame(FrameData* frame, std::string* /*error*/) {
+    const uint64_t now = clock_->Now();
+    const int64_t frame_index = clock_->PositionAt(start_tick_, now, lecture_.config().fps);
+    if (frame_index == last_frame_index_) {
+        return CaptureReadResult::kNoData;
+    }
+    last_frame_index_ = frame_index;
+
+    frame->acquired_at = std::chrono::steady_clock::now();
+    frame->width = lecture_.config().width;
+    frame->height = lecture_.config().height;
+    frame->pixels.resize(lecture_.FrameBytes());
+    lecture_.RenderVideoFrame(frame_index, frame->pixels.data());
+    frame->timestamp = now;
+    return CaptureReadResult::kData;
+}
+
+GeneratorAudioSource::GeneratorAudioSource(const SyntheticLectureConfig& config, const MediaClock* clock)
+    : lecture_(config), clock_(clock ? clock : &SystemMediaClock::Instance()) {
+    // 10ms 패킷 (WASAPI 공유 모드 기본 주기)
+    packet_frames_ = std::max(lecture_.config().sample_rate / 100, 1);
+}
+
+bool GeneratorAudioSource::Start(std::string* /*error*/) {
+    start_tick_ = clock_->Now();
+    emitted_samples_ = 0;
+    return true;
+}
+
+AudioSourceFormat GeneratorAudioSource::Format() const {
+    AudioSourceFormat format;
+    format.sample_rate = lecture_.config().sample_rate;
+    format.channels = lecture_.config().channels;
+    format.bits_per_sample = 32;
+    return format;
+}
+
+CaptureReadResult GeneratorAudioSource::ReadPacket(AudioSample* sample, std::string* /*error*/) {
+    const int sample_rate = lecture_.config().sample_rate;
+    const int64_t available = clock_->PositionAt(start_tick_, clock_->Now(), sample_rate) - emitted_samples_;
+    if (available < packet_frames_) {
+        return CaptureReadResult::kNoData;
+    }
+
+    const int channels = lecture_.config().channels;
+    sample->frame_count = static_cast<uint32_t>(packet_frames_);
+    sample->sample_rate = static_cast<uint32_t>(sample_rate);
+    sample->channels = static_cast<uint16_t>(channels);
+    sample->bits_per_sample = 32;
+    sample->data.resize(static_cast<size_t>(packet_frames_) * channels * sizeof(float));
+    lecture_.RenderAudio(emitted_samples_, packet_frames_, reinterpret_cast<float*>(sample->data.data()));
+    sample->timestamp = clock_->TickAt(start_tick_, emitted_samples_, sample_rate);
+    emitted_samples_ += packet_frames_;
+    return CaptureReadResult::kData;
+}
@@ -0,0 +1,60 @@
+// 합성 강의 캡처 소스 (SyntheticLecture를 실제 시간에 맞춰 내보냄)
+// 슬라이드 패턴 + 움직이는 영역 + 톤/비프음 → DXGI/WASAPI 없이 파이프라인 부하 테스트
+
+#ifndef SAT_LEC_REC_GENERATOR_SOURCE_H_
+#define SAT_LEC_REC_GENERATOR_SOURCE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "capture_source.h"
+#include "media_clock.h"
+#include "synthetic_lecture.h"
+
+/// 입력: 합성 강의 설정, 시계 (nullptr이면 SystemMediaClock)
+/// 출력: CaptureFrame 시점의 경과 시간에 해당하는 합성 프레임
+/// 예외: 없음
+///
+/// 화면처럼 동작: 호출 간격과 무관하게 "지금" 보이는 프레임을 반환,
+/// 직전 호출과 같은 프레임 번호면 kNoData (화면 변화 없음)
+class GeneratorVideoSource : public IVideoSource {
+public:
+    explicit GeneratorVideoSource(const SyntheticLectureConfig& config, const MediaClock* clock = nullptr);
+
+    const char* Name() const override { return "generator"; }
+    bool Start(std::string* error) override;
+    void Stop() override {}
+    CaptureReadResult CaptureFrame(FrameData* frame, std::string* error) override;
+
+private:
+    SyntheticLecture lecture_;
+    const MediaClock* clock_;
+    uint64_t start_tick_ = 0;
+    int64_t last_frame_index_ = -1;
+};
+
+/// 입력: 합성 강의 설정, 시계 (nullptr이면 SystemMediaClock)
+/// 출력: 경과 시간만큼 쌓인 오디오를 10ms 패킷으로 (WASAPI loopback 주기와 같게)
+/// 예외: 없음
+///
+/// 패킷 타임스탬프는 패킷 첫 샘플의 시각 (시작 tick + 샘플 위치)
+class GeneratorAudioSource : public IAudioSource {
+public:
+    explicit GeneratorAudioSource(const SyntheticLectureConfig& config, const MediaClock* clock = nullptr);
+
+    const char* Name() const override { return "generator"; }
+    bool Start(std::string* error) override;
+    void Stop() override {}
+    AudioSourceFormat Format() const override;
+    CaptureReadResult ReadPacket(AudioSample* sample, std::string* error) override;
+
+private:
+    SyntheticLecture lecture_;
+    const MediaClock* clock_;
+    int packet_frames_ = 480;
+    uint64_t start_tick_ = 0;
+    int64_t emitted_samples_ = 0;
+};
+
+#endif  // SAT_LEC_REC_GENERATOR_SOURCE_H_
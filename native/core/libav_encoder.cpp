@@ -2,9 +2,34 @@
 
 #include "libav_encoder.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <filesystem>
+#include <system_error>
 #include <vector>
 
+#include "native_logger.h"
+
+const char* RecordingContainerExtension(RecordingContainer container) {
+    switch (container) {
+        case RecordingContainer::kMatroska:
+            return ".mkv";
+        case RecordingContainer::kMpegTs:
+            return ".ts";
+        case RecordingContainer::kFragmentedMp4:
+        default:
+            return ".mp4";
+    }
+}
+
+std::wstring RecordingSegmentPath(const std::wstring& base, int index) {
+    if (index == 0) return base;
+    const std::filesystem::path path(base);
+    return (path.parent_path() /
+            (path.stem().wstring() + L"_part" + std::to_wstring(index + 1) + path.extension().wstring()))
+        .wstring();
+}
+
 // ==============================================================================
 // 생성자 / 소멸자
 // ==============================================================================
@@ -25,19 +50,29 @@ LibavEncoder::~LibavEncoder() {
 
 void LibavEncoder::SetLastError(const std::string& message) {
     last_error_ = message;
-    printf("[LibavEncoder] ERROR: %s\n", message.c_str());
-    fflush(stdout);
+    SATREC_LOG_ERROR("[LibavEncoder] ERROR: %s", message.c_str());
+}
+
+void LibavEncoder::RecordStage(PipelineStage stage,
+                              std::chrono::steady_clock::time_point started_at) {
+    const auto elapsed = std::chrono::steady_clock::now() - started_at;
+    if (config_.pipeline_stats) {
+        config_.pipeline_stats->Record(
+            stage, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    // 같은 구간을 trace 타임라인에도 기록 (TraceRecorder와 같은 steady_clock 기준)
+    TraceRecorder& trace = TraceRecorder::Instance();
+    if (trace.IsEnabled()) {
+        trace.Complete(PipelineStats::StageName(stage),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           started_at.time_since_epoch()).count(),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
 }
 
 std::string LibavEncoder::WideToUTF8(const std::wstring& wide_str) {
     if (wide_str.empty()) return std::string();
-
-    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wide_str.c_str(),
-                                          (int)wide_str.size(), NULL, 0, NULL, NULL);
-    std::string utf8_str(size_needed, 0);
-    WideCharToMultiByte(CP_UTF8, 0, wide_str.c_str(), (int)wide_str.size(),
-                       &utf8_str[0], size_needed, NULL, NULL);
-    return utf8_str;
+    return std::filesystem::path(wide_str).u8string();
 }
 
 // ==============================================================================
@@ -52,20 +87,16 @@ bool LibavEncoder::Start(const LibavEncoderConfig& config) {
 
     config_ = config;
 
-    printf("[LibavEncoder] 초기화 시작...\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] 초기화 시작...");
 
     // QPC 주파수 및 시작 시점 초기화 (A/V 동기화의 핵심)
     // ⚠️ 중요: 오디오/비디오 모두 이 시점을 기준으로 PTS를 계산함
-    LARGE_INTEGER freq, start;
-    QueryPerformanceFrequency(&freq);
-    QueryPerformanceCounter(&start);
-    qpc_frequency_ = freq.QuadPart;
-    recording_start_qpc_ = start.QuadPart;
+    const MediaClock& clock = config_.clock ? *config_.clock : SystemMediaClock::Instance();
+    qpc_frequency_ = clock.Frequency();
+    recording_start_qpc_ = clock.Now();
 
-    printf("[LibavEncoder] QPC 초기화: freq=%llu, start=%llu\n",
-           qpc_frequency_, recording_start_qpc_);
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] 시계 초기화: freq=%llu, start=%llu",
+                    qpc_frequency_, recording_start_qpc_);
 
     // 1. AVFormatContext 생성
     if (!InitializeFormat()) {
@@ -85,23 +116,34 @@ bool LibavEncoder::Start(const LibavEncoderConfig& config) {
         return false;
     }
 
-    // 4. MP4 파일 열기 및 헤더 작성
-    if (!WriteHeader()) {
+    // 4. MP4 파일 열기 및 헤더 작성 (pre-roll이면 커밋할 때까지 미룸)
+    if (config_.start_in_preroll) {
+        preroll_ = std::make_unique<PreRollRing>(config_.preroll_limits);
+        SATREC_LOG_INFO("[LibavEncoder] pre-roll 대기 (최대 %lldms / %.0fMB, 커밋 전까지 파일 없음)",
+                        static_cast<long long>(config_.preroll_limits.max_duration_ms),
+                        static_cast<double>(config_.preroll_limits.max_bytes) / (1024.0 * 1024.0));
+    } else if (!WriteHeader()) {
         Cleanup();
         return false;
     }
 
     is_running_ = true;
-    printf("[LibavEncoder] ✅ 초기화 완료\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ 초기화 완료");
     return true;
 }
 
 bool LibavEncoder::InitializeFormat() {
     std::string utf8_path = WideToUTF8(config_.output_path);
 
-    // MP4 muxer용 AVFormatContext 할당
-    int ret = avformat_alloc_output_context2(&format_ctx_, nullptr, "mp4", utf8_path.c_str());
+    const char* muxer_name = "mp4";
+    if (config_.container == RecordingContainer::kMatroska) {
+        muxer_name = "matroska";
+    } else if (config_.container == RecordingContainer::kMpegTs) {
+        muxer_name = "mpegts";
+    }
+
+    // 컨테이너별 AVFormatContext 할당
+    int ret = avformat_alloc_output_context2(&format_ctx_, nullptr, muxer_name, utf8_path.c_str());
     if (ret < 0) {
         char err_buf[128];
         av_strerror(ret, err_buf, sizeof(err_buf));
@@ -109,14 +151,31 @@ bool LibavEncoder::InitializeFormat() {
         return false;
     }
 
-    // Fragmented MP4 옵션 설정 (크래시 복구용)
-    if (config_.enable_fragmented_mp4) {
-        av_dict_set(&format_ctx_->metadata, "movflags",
-                   "frag_keyframe+empty_moov+default_base_moof", 0);
+    // muxer 옵션은 avformat_write_header()에 전달해야 적용됨
+    // (metadata에 넣으면 파일 태그로만 기록되고 muxer는 무시함)
+    switch (config_.container) {
+        case RecordingContainer::kFragmentedMp4:
+            // Fragmented MP4 옵션 설정 (크래시 복구용)
+            if (config_.enable_fragmented_mp4) {
+                av_dict_set(&mux_options_, "movflags",
+                           "frag_keyframe+empty_moov+default_base_moof", 0);
+            }
+            break;
+        case RecordingContainer::kMatroska: {
+            // cluster를 짧게 끊고 매 패킷 flush → 끊긴 지점 직전 cluster까지 재생 가능
+            char cluster_ms[16];
+            snprintf(cluster_ms, sizeof(cluster_ms), "%d", config_.matroska_cluster_time_ms);
+            av_dict_set(&mux_options_, "cluster_time_limit", cluster_ms, 0);
+            av_dict_set(&mux_options_, "cluster_size_limit", "2097152", 0);  // 2MB
+            format_ctx_->flush_packets = 1;
+            break;
+        }
+        case RecordingContainer::kMpegTs:
+            format_ctx_->flush_packets = 1;
+            break;
     }
 
-    printf("[LibavEncoder] ✅ AVFormatContext 생성 완료\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ AVFormatContext 생성 완료 (%s)", muxer_name);
     return true;
 }
 
@@ -152,6 +211,7 @@ bool LibavEncoder::InitializeVideoCodec() {
     video_codec_ctx_->time_base = AVRational{1, config_.video_fps};
     video_codec_ctx_->framerate = AVRational{config_.video_fps, 1};
     video_codec_ctx_->gop_size = config_.video_fps;  // 1초마다 키프레임
+    if (config_.video_threads > 0) video_codec_ctx_->thread_count = config_.video_threads;
 
     // CRF 품질 설정
     char crf_str[8];
@@ -160,6 +220,11 @@ bool LibavEncoder::InitializeVideoCodec() {
     av_opt_set(video_codec_ctx_->priv_data, "preset", config_.h264_preset, 0);
     av_opt_set(video_codec_ctx_->priv_data, "tune", "zerolatency", 0);
 
+    // MP4/MKV는 SPS/PPS를 extradata로 받아야 함 (MPEG-TS는 in-band 유지)
+    if (format_ctx_->oformat->flags & AVFMT_GLOBALHEADER) {
+        video_codec_ctx_->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    }
+
     // 5. 인코더 열기
     int ret = avcodec_open2(video_codec_ctx_, codec, nullptr);
     if (ret < 0) {
@@ -201,9 +266,8 @@ bool LibavEncoder::InitializeVideoCodec() {
         return false;
     }
 
-    printf("[LibavEncoder] ✅ Video 인코더 초기화 완료 (%dx%d@%dfps, CRF=%d)\n",
-           config_.video_width, config_.video_height, config_.video_fps, config_.h264_crf);
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ Video 인코더 초기화 완료 (%dx%d@%dfps, CRF=%d)",
+                    config_.video_width, config_.video_height, config_.video_fps, config_.h264_crf);
     return true;
 }
 
@@ -241,6 +305,9 @@ bool LibavEncoder::InitializeAudioCodec() {
     audio_codec_ctx_->sample_fmt = AV_SAMPLE_FMT_FLTP;  // Planar float
     audio_codec_ctx_->bit_rate = config_.aac_bitrate;
     audio_codec_ctx_->time_base = AVRational{1, config_.audio_sample_rate};
+    if (format_ctx_->oformat->flags & AVFMT_GLOBALHEADER) {
+        audio_codec_ctx_->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    }
 
     // 5. 인코더 열기
     int ret = avcodec_open2(audio_codec_ctx_, codec, nullptr);
@@ -300,9 +367,8 @@ bool LibavEncoder::InitializeAudioCodec() {
         return false;
     }
 
-    printf("[LibavEncoder] ✅ Audio 인코더 초기화 완료 (%dHz, %dkbps, frame_size=%d)\n",
-           config_.audio_sample_rate, config_.aac_bitrate / 1000, audio_codec_ctx_->frame_size);
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ Audio 인코더 초기화 완료 (%dHz, %dkbps, frame_size=%d)",
+                    config_.audio_sample_rate, config_.aac_bitrate / 1000, audio_codec_ctx_->frame_size);
     return true;
 }
 
@@ -310,16 +376,29 @@ bool LibavEncoder::WriteHeader() {
     std::string utf8_path = WideToUTF8(config_.output_path);
 
     // 1. 파일 열기
-    int ret = avio_open(&format_ctx_->pb, utf8_path.c_str(), AVIO_FLAG_WRITE);
-    if (ret < 0) {
-        char err_buf[128];
-        av_strerror(ret, err_buf, sizeof(err_buf));
-        SetLastError(std::string("출력 파일 열기 실패: ") + err_buf);
+    int ret = 0;
+    if (config_.secondary_output_path.empty()) {
+        ret = avio_open(&format_ctx_->pb, utf8_path.c_str(), AVIO_FLAG_WRITE);
+        if (ret < 0) {
+            char err_buf[128];
+            av_strerror(ret, err_buf, sizeof(err_buf));
+            SetLastError(std::string("출력 파일 열기 실패: ") + err_buf);
+            return false;
+        }
+    } else if (!OpenOutputTee(utf8_path)) {
         return false;
     }
 
-    // 2. MP4 헤더 작성
-    ret = avformat_write_header(format_ctx_, nullptr);
+    // 2. 컨테이너 헤더 작성 (muxer 옵션 적용)
+    ret = avformat_write_header(format_ctx_, &mux_options_);
+    if (mux_options_) {
+        // 남은 항목 = muxer가 인식하지 못한 옵션
+        const AVDictionaryEntry* unused = nullptr;
+        while ((unused = av_dict_iterate(mux_options_, unused))) {
+            SATREC_LOG_WARN("[LibavEncoder] ⚠️ 적용되지 않은 muxer 옵션: %s=%s", unused->key, unused->value);
+        }
+        av_dict_free(&mux_options_);
+    }
     if (ret < 0) {
         char err_buf[128];
         av_strerror(ret, err_buf, sizeof(err_buf));
@@ -327,8 +406,54 @@ bool LibavEncoder::WriteHeader() {
         return false;
     }
 
-    printf("[LibavEncoder] ✅ MP4 헤더 작성 완료\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ MP4 헤더 작성 완료");
+
+    // 3. 패킷 저널 열기 (헤더 작성 후 확정된 stream time_base 사용)
+    encode_started_at_ = std::chrono::steady_clock::now();
+    if (config_.enable_packet_journal) {
+        journal_ = std::make_unique<PacketJournalWriter>();
+        const std::string journal_path = utf8_path + ".journal";
+        if (journal_->Open(journal_path, format_ctx_, config_.journal_flush_interval_ms)) {
+            SATREC_LOG_INFO("[LibavEncoder] ✅ 패킷 저널 기록 시작: %s", journal_path.c_str());
+        } else {
+            // 저널은 보조 수단이므로 실패해도 녹화는 계속
+            SATREC_LOG_WARN("[LibavEncoder] ⚠️ 패킷 저널 열기 실패, 저널 없이 계속: %s", journal_path.c_str());
+            journal_.reset();
+        }
+    }
+    return true;
+}
+
+bool LibavEncoder::OpenOutputTee(const std::string& primary_path) {
+    std::string error;
+    auto primary_sink = FileOutputSink::Open(primary_path, &error);
+    if (!primary_sink) {
+        SetLastError(error);
+        return false;
+    }
+
+    output_tee_ = std::make_shared<OutputTee>();
+    output_tee_->AddDestination("primary", std::move(primary_sink), config_.output_writer_options);
+
+    // 보조 경로는 열기 실패해도 primary만으로 녹화 계속
+    const std::string secondary_path = WideToUTF8(config_.secondary_output_path);
+    auto secondary_sink = FileOutputSink::Open(secondary_path, &error);
+    if (secondary_sink) {
+        output_tee_->AddDestination("secondary", std::move(secondary_sink),
+                                    config_.output_writer_options);
+    } else {
+        SATREC_LOG_WARN("[LibavEncoder] ⚠️ 보조 출력 열기 실패, primary만 기록: %s", error.c_str());
+    }
+
+    if (!output_tee_->Open(&error)) {
+        SetLastError(error);
+        output_tee_.reset();
+        return false;
+    }
+    format_ctx_->pb = output_tee_->GetAvioContext();
+    format_ctx_->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+    SATREC_LOG_INFO("[LibavEncoder] ✅ 이중 출력 사용 (대상 %zu개)", output_tee_->GetDestinationCount());
     return true;
 }
 
@@ -337,23 +462,10 @@ bool LibavEncoder::WriteHeader() {
 // ==============================================================================
 
 bool LibavEncoder::EncodeVideo(const uint8_t* bgra_data, size_t length, uint64_t capture_qpc) {
-    if (!is_running_) {
-        SetLastError("인코더가 실행 중이 아닙니다");
+    if (!BeginVideoFrame(capture_qpc)) {
         return false;
     }
 
-    // 첫 비디오 프레임 시점 로그 (디버그 및 동기화 검증용)
-    if (!first_video_logged_ && capture_qpc > 0) {
-        first_video_logged_ = true;
-        double offset_from_start = 0.0;
-        if (qpc_frequency_ > 0 && capture_qpc >= recording_start_qpc_) {
-            offset_from_start = static_cast<double>(capture_qpc - recording_start_qpc_)
-                               / static_cast<double>(qpc_frequency_) * 1000.0;  // ms
-        }
-        printf("[LibavEncoder] 🎬 첫 비디오 프레임: 녹화 시작 후 %.2fms\n", offset_from_start);
-        fflush(stdout);
-    }
-
     // 예상 크기 검증
     size_t expected_size = config_.video_width * config_.video_height * 4;
     if (length != expected_size) {
@@ -362,11 +474,61 @@ bool LibavEncoder::EncodeVideo(const uint8_t* bgra_data, size_t length, uint64_t
     }
 
     // 1. BGRA → YUV420P 변환
+    const auto convert_started_at = std::chrono::steady_clock::now();
     if (!ConvertBGRAToYUV420(bgra_data, video_frame_)) {
         return false;
     }
+    RecordStage(PipelineStage::kConvert, convert_started_at);
+
+    // 2. PTS 계산 + 인코더에 전송
+    return SubmitVideoFrame(capture_qpc);
+}
+
+bool LibavEncoder::EncodeVideoI420(const uint8_t* i420_data, size_t length, uint64_t capture_qpc) {
+    if (!BeginVideoFrame(capture_qpc)) {
+        return false;
+    }
+
+    const int width = config_.video_width;
+    const int height = config_.video_height;
+    const size_t luma_bytes = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (length != luma_bytes + luma_bytes / 2) {
+        SetLastError("Video 프레임 크기 불일치 (I420)");
+        return false;
+    }
+
+    // 1. 연속 배치된 Y/U/V 평면을 AVFrame 평면(linesize 정렬)으로 복사 (색 변환은 캡처 스레드에서 완료)
+    const uint8_t* u_plane = i420_data + luma_bytes;
+    const uint8_t* v_plane = u_plane + luma_bytes / 4;
+    av_image_copy_plane(video_frame_->data[0], video_frame_->linesize[0], i420_data, width, width, height);
+    av_image_copy_plane(video_frame_->data[1], video_frame_->linesize[1], u_plane, width / 2, width / 2, height / 2);
+    av_image_copy_plane(video_frame_->data[2], video_frame_->linesize[2], v_plane, width / 2, width / 2, height / 2);
+
+    // 2. PTS 계산 + 인코더에 전송
+    return SubmitVideoFrame(capture_qpc);
+}
+
+bool LibavEncoder::BeginVideoFrame(uint64_t capture_qpc) {
+    if (!is_running_) {
+        SetLastError("인코더가 실행 중이 아닙니다");
+        return false;
+    }
+
+    // 첫 비디오 프레임 시점 로그 (디버그 및 동기화 검증용)
+    if (!first_video_logged_ && capture_qpc > 0) {
+        first_video_logged_ = true;
+        double offset_from_start = 0.0;
+        if (qpc_frequency_ > 0 && capture_qpc >= recording_start_qpc_) {
+            offset_from_start = static_cast<double>(capture_qpc - recording_start_qpc_)
+                               / static_cast<double>(qpc_frequency_) * 1000.0;  // ms
+        }
+        SATREC_LOG_INFO("[LibavEncoder] 🎬 첫 비디오 프레임: 녹화 시작 후 %.2fms", offset_from_start);
+    }
+    return true;
+}
 
-    // 2. QPC 기반 PTS 계산 (A/V 동기화 핵심)
+bool LibavEncoder::SubmitVideoFrame(uint64_t capture_qpc) {
+    // 1. QPC 기반 PTS 계산 (A/V 동기화 핵심)
     // ⚠️ 중요: 카운터 기반(next_video_pts_++)이 아닌 실제 경과 시간 사용
     // 이렇게 해야 정적 화면에서도 오디오와 동기화됨
     int64_t pts = 0;
@@ -392,7 +554,7 @@ bool LibavEncoder::EncodeVideo(const uint8_t* bgra_data, size_t length, uint64_t
 
     video_frame_->pts = pts;
 
-    // 3. 인코더에 전송
+    // 2. 인코더에 전송
     return SendVideoFrame(video_frame_);
 }
 
@@ -416,7 +578,9 @@ bool LibavEncoder::ConvertBGRAToYUV420(const uint8_t* bgra, AVFrame* yuv_frame)
 
 bool LibavEncoder::SendVideoFrame(AVFrame* frame) {
     // 1. 프레임을 인코더에 전송
+    const auto send_started_at = std::chrono::steady_clock::now();
     int ret = avcodec_send_frame(video_codec_ctx_, frame);
+    RecordStage(PipelineStage::kVideoEncode, send_started_at);
     if (ret < 0) {
         char err_buf[128];
         av_strerror(ret, err_buf, sizeof(err_buf));
@@ -442,8 +606,7 @@ bool LibavEncoder::EncodeAudio(const uint8_t* float32_data, size_t length, uint6
             offset_from_start = static_cast<double>(capture_qpc - recording_start_qpc_)
                                / static_cast<double>(qpc_frequency_) * 1000.0;  // ms
         }
-        printf("[LibavEncoder] 🎵 첫 오디오 패킷: 녹화 시작 후 %.2fms\n", offset_from_start);
-        fflush(stdout);
+        SATREC_LOG_INFO("[LibavEncoder] 🎵 첫 오디오 패킷: 녹화 시작 후 %.2fms", offset_from_start);
     }
 
     // 1. 입력 데이터를 버퍼에 추가
@@ -531,7 +694,9 @@ bool LibavEncoder::EncodeAudio(const uint8_t* float32_data, size_t length, uint6
 
 bool LibavEncoder::SendAudioFrame(AVFrame* frame) {
     // 1. 프레임을 인코더에 전송
+    const auto send_started_at = std::chrono::steady_clock::now();
     int ret = avcodec_send_frame(audio_codec_ctx_, frame);
+    RecordStage(PipelineStage::kAudioEncode, send_started_at);
     if (ret < 0) {
         char err_buf[128];
         av_strerror(ret, err_buf, sizeof(err_buf));
@@ -567,28 +732,155 @@ bool LibavEncoder::ReceiveAndWritePackets(AVCodecContext* codec_ctx, int stream_
             break;
         }
 
-        // 2. 타임스탬프 변환 (codec time_base → stream time_base)
-        AVStream* stream = format_ctx_->streams[stream_index];
-        av_packet_rescale_ts(pkt, codec_ctx->time_base, stream->time_base);
-        pkt->stream_index = stream_index;
+        // 2. pre-roll 중이면 메모리 링에 보관 (codec time_base 그대로, 커밋 시 변환)
+        if (preroll_) {
+            pkt->stream_index = stream_index;
+            if (!preroll_->Push(pkt, codec_ctx->time_base, codec_ctx == video_codec_ctx_)) {
+                SetLastError("pre-roll 패킷 보관 실패");
+                success = false;
+                break;
+            }
+            continue;
+        }
 
-        // 3. Interleaved write (자동으로 DTS 순서 정렬)
-        ret = av_interleaved_write_frame(format_ctx_, pkt);
-        if (ret < 0) {
-            char err_buf[128];
-            av_strerror(ret, err_buf, sizeof(err_buf));
-            SetLastError(std::string("av_interleaved_write_frame 실패: ") + err_buf);
+        // 3. 파일에 기록
+        if (!WritePacket(pkt, codec_ctx->time_base, stream_index)) {
             success = false;
             break;
         }
-
-        av_packet_unref(pkt);
     }
 
     av_packet_free(&pkt);
     return success;
 }
 
+bool LibavEncoder::WritePacket(AVPacket* pkt, AVRational codec_time_base, int stream_index) {
+    // 1. pre-roll 커밋 후: 시작 키프레임이 0이 되도록 이동
+    if (mux_offset_us_ != 0) {
+        const int64_t offset = av_rescale_q(mux_offset_us_, AV_TIME_BASE_Q, codec_time_base);
+        if (pkt->pts != AV_NOPTS_VALUE) pkt->pts -= offset;
+        if (pkt->dts != AV_NOPTS_VALUE) pkt->dts -= offset;
+        if (pkt->pts != AV_NOPTS_VALUE && pkt->pts < 0) {
+            // 인코더 지연으로 커밋 후에 나온, 시작 키프레임보다 이른 오디오 패킷
+            av_packet_unref(pkt);
+            return true;
+        }
+    }
+
+    // 2. 타임스탬프 변환 (codec time_base → stream time_base)
+    AVStream* stream = format_ctx_->streams[stream_index];
+    av_packet_rescale_ts(pkt, codec_time_base, stream->time_base);
+    pkt->stream_index = stream_index;
+
+    // 2.5. 패킷 저널 기록 (muxer가 패킷을 가져가기 전에 기록)
+    if (journal_ && !journal_->Append(pkt)) {
+        SATREC_LOG_WARN("[LibavEncoder] ⚠️ 패킷 저널 쓰기 실패, 저널 기록 중단");
+        CloseJournal(true);  // 불완전한 저널은 남기지 않음 (MP4 fragment로 복구)
+    }
+
+    // 3. Interleaved write (자동으로 DTS 순서 정렬)
+    const int packet_size = pkt->size;  // write 후에는 muxer가 패킷을 가져감
+    const auto write_started_at = std::chrono::steady_clock::now();
+    const int ret = av_interleaved_write_frame(format_ctx_, pkt);
+    mux_write_time_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - write_started_at).count();
+    RecordStage(PipelineStage::kMux, write_started_at);
+    mux_packet_count_++;
+    muxed_bytes_ += packet_size;
+    av_packet_unref(pkt);
+    if (ret < 0) {
+        char err_buf[128];
+        av_strerror(ret, err_buf, sizeof(err_buf));
+        SetLastError(std::string("av_interleaved_write_frame 실패: ") + err_buf);
+        return false;
+    }
+    return true;
+}
+
+// ==============================================================================
+// pre-roll 커밋
+// ==============================================================================
+
+bool LibavEncoder::ResetStartTime(uint64_t start_qpc) {
+    if (!is_running_ || last_video_pts_ >= 0 || last_audio_pts_ >= 0) {
+        return false;
+    }
+    recording_start_qpc_ = start_qpc;
+    encode_started_at_ = std::chrono::steady_clock::now();
+    SATREC_LOG_INFO("[LibavEncoder] PTS 기준 시점 이동: start=%llu", recording_start_qpc_);
+    return true;
+}
+
+bool LibavEncoder::CommitPreRoll(uint64_t commit_qpc, PreRollCommitInfo* info) {
+    if (!is_running_ || !preroll_) {
+        SetLastError("pre-roll 상태가 아닙니다");
+        return false;
+    }
+    if (format_ctx_->pb) {
+        // 이전 커밋에서 헤더 작성이 실패한 상태 (같은 컨텍스트로 다시 열지 않음)
+        SetLastError("이전 pre-roll 커밋이 실패했습니다");
+        return false;
+    }
+    const auto commit_started_at = std::chrono::steady_clock::now();
+
+    // 1. 커밋 시점 (Start 기준 경과 us, 패킷 pts와 같은 기준)
+    int64_t commit_us = 0;
+    if (qpc_frequency_ > 0 && commit_qpc >= recording_start_qpc_) {
+        commit_us = av_rescale(static_cast<int64_t>(commit_qpc - recording_start_qpc_), 1000000,
+                               static_cast<int64_t>(qpc_frequency_));
+    }
+
+    // 2. 직전 키프레임부터 꺼내기 (아직 인코딩된 비디오가 없으면 링을 버리고 다음 패킷부터 기록)
+    std::vector<AVPacket*> packets;
+    int64_t start_us = 0;
+    const PreRollRingStats ring_stats = preroll_->GetStats();
+    if (!preroll_->TakeFrom(commit_us, &packets, &start_us)) {
+        start_us = 0;
+    }
+    preroll_.reset();
+    auto free_packets = [&packets](size_t from) {
+        for (size_t i = from; i < packets.size(); i++) av_packet_free(&packets[i]);
+    };
+
+    // 3. 파일 열기 + 헤더 (실패하면 빈 링으로 돌아가 이후 패킷은 버림)
+    if (!WriteHeader()) {
+        free_packets(0);
+        preroll_ = std::make_unique<PreRollRing>(config_.preroll_limits);
+        return false;
+    }
+    mux_offset_us_ = start_us;
+
+    // 4. 링의 패킷을 그대로 기록 (재인코딩 없음)
+    int64_t bytes = 0;
+    for (size_t i = 0; i < packets.size(); i++) {
+        AVPacket* packet = packets[i];
+        const bool is_video = packet->stream_index == video_stream_->index;
+        const AVRational time_base = is_video ? video_codec_ctx_->time_base : audio_codec_ctx_->time_base;
+        bytes += packet->size;
+        if (!WritePacket(packet, time_base, packet->stream_index)) {
+            free_packets(i);
+            return false;
+        }
+        av_packet_free(&packets[i]);
+    }
+
+    PreRollCommitInfo result;
+    result.packet_count = static_cast<int64_t>(packets.size());
+    result.bytes = bytes;
+    result.preroll_ms = std::max<int64_t>(0, commit_us - start_us) / 1000;
+    result.commit_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - commit_started_at).count();
+    SATREC_LOG_INFO("[LibavEncoder] ✅ pre-roll 커밋: 키프레임 %.2f초 시점부터 %lldms, 패킷 %lld개 / %.1fMB "
+                    "(링 최대 %lldms, GOP %lld패킷 버림), %.2fms 소요",
+                    static_cast<double>(start_us) / 1e6, static_cast<long long>(result.preroll_ms),
+                    static_cast<long long>(result.packet_count), static_cast<double>(bytes) / (1024.0 * 1024.0),
+                    static_cast<long long>(ring_stats.duration_ms),
+                    static_cast<long long>(ring_stats.evicted_packets),
+                    static_cast<double>(result.commit_us) / 1000.0);
+    if (info) *info = result;
+    return true;
+}
+
 // ==============================================================================
 // 종료
 // ==============================================================================
@@ -596,8 +888,7 @@ bool LibavEncoder::ReceiveAndWritePackets(AVCodecContext* codec_ctx, int stream_
 void LibavEncoder::Stop() {
     if (!is_running_) return;
 
-    printf("[LibavEncoder] 인코더 종료 중...\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] 인코더 종료 중...");
 
     // 1. 남은 프레임 플러시
     if (video_codec_ctx_) {
@@ -608,15 +899,38 @@ void LibavEncoder::Stop() {
         FlushEncoder(audio_codec_ctx_, audio_stream_->index);
     }
 
-    // 2. MP4 트레일러 작성
-    WriteTrailer();
+    // 2. 컨테이너 트레일러 작성 (커밋 전 pre-roll이면 파일이 없으므로 링만 버림)
+    bool trailer_ok = false;
+    if (preroll_) {
+        const PreRollRingStats ring_stats = preroll_->GetStats();
+        SATREC_LOG_INFO("[LibavEncoder] pre-roll 커밋 없이 종료, 버린 패킷 %zu개 (%.1fMB)",
+                        ring_stats.packet_count, static_cast<double>(ring_stats.bytes) / (1024.0 * 1024.0));
+        preroll_.reset();
+    } else {
+        trailer_ok = WriteTrailer();
+    }
+
+    // 컨테이너별 쓰기 오버헤드 (muxer + 파일 I/O, 인코더 스레드 기준)
+    if (format_ctx_ && format_ctx_->pb) {
+        const double session_seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - encode_started_at_).count();
+        const double write_ms = static_cast<double>(mux_write_time_ns_) / 1e6;
+        SATREC_LOG_INFO("[LibavEncoder] mux 통계 (%s): 패킷 %lld개, %.1fMB, 쓰기 %.1fms (세션의 %.3f%%)",
+                        format_ctx_->oformat->name,
+                        static_cast<long long>(mux_packet_count_),
+                        static_cast<double>(avio_tell(format_ctx_->pb)) / (1024.0 * 1024.0),
+                        write_ms,
+                        session_seconds > 0.0 ? write_ms / (session_seconds * 1000.0) * 100.0 : 0.0);
+    }
+
+    // 2.5. MP4가 정상 완료되었으면 저널은 더 이상 필요 없음
+    CloseJournal(trailer_ok);
 
     // 3. 리소스 정리
     Cleanup();
 
     is_running_ = false;
-    printf("[LibavEncoder] ✅ 인코더 종료 완료\n");
-    fflush(stdout);
+    SATREC_LOG_INFO("[LibavEncoder] ✅ 인코더 종료 완료");
 }
 
 void LibavEncoder::FlushEncoder(AVCodecContext* codec_ctx, int stream_index) {
@@ -627,13 +941,51 @@ void LibavEncoder::FlushEncoder(AVCodecContext* codec_ctx, int stream_index) {
     ReceiveAndWritePackets(codec_ctx, stream_index);
 }
 
-void LibavEncoder::WriteTrailer() {
-    if (format_ctx_) {
-        av_write_trailer(format_ctx_);
+bool LibavEncoder::WriteTrailer() {
+    if (!format_ctx_) {
+        return false;
     }
+
+    int ret = av_write_trailer(format_ctx_);
+    if (ret < 0) {
+        char err_buf[128];
+        av_strerror(ret, err_buf, sizeof(err_buf));
+        SetLastError(std::string("av_write_trailer 실패: ") + err_buf);
+        return false;
+    }
+    return true;
+}
+
+void LibavEncoder::CloseJournal(bool remove_file) {
+    if (!journal_) return;
+
+    journal_->Close();
+    const PacketJournalStats stats = journal_->GetStats();
+
+    // 저널 기록 오버헤드 (인코더 스레드 기준)
+    const double session_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - encode_started_at_).count();
+    const double write_ms = static_cast<double>(stats.write_time_ns) / 1e6;
+    SATREC_LOG_INFO("[LibavEncoder] 패킷 저널: 패킷 %lld개, %.1fMB (%.1fKB/s), flush %lld회, "
+                    "쓰기 %.1fms (세션의 %.3f%%)",
+                    static_cast<long long>(stats.packet_count),
+                    static_cast<double>(stats.bytes_written) / (1024.0 * 1024.0),
+                    session_seconds > 0.0 ? static_cast<double>(stats.bytes_written) / 1024.0 / session_seconds : 0.0,
+                    static_cast<long long>(stats.flush_count),
+                    write_ms,
+                    session_seconds > 0.0 ? write_ms / (session_seconds * 1000.0) * 100.0 : 0.0);
+
+    if (remove_file || stats.packet_count == 0) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(journal_->GetPath()), ec);
+    }
+    journal_.reset();
 }
 
 void LibavEncoder::Cleanup() {
+    // 저널 (Stop에서 처리되지 않은 경우: 초기화 실패 등)
+    CloseJournal(false);
+
     // Video
     if (sws_ctx_) {
         sws_freeContext(sws_ctx_);
@@ -659,8 +1011,16 @@ void LibavEncoder::Cleanup() {
     audio_buffer_.clear();  // 오디오 샘플 버퍼 정리
 
     // Format
+    av_dict_free(&mux_options_);
+    mux_write_time_ns_ = 0;
+    mux_packet_count_ = 0;
+    muxed_bytes_ = 0;
     if (format_ctx_) {
-        if (format_ctx_->pb) {
+        if (output_tee_) {
+            // 대상별 큐를 모두 기록한 뒤 닫음 (멈춘 대상은 기다리지 않음)
+            output_tee_->Close();
+            format_ctx_->pb = nullptr;
+        } else if (format_ctx_->pb) {
             avio_closep(&format_ctx_->pb);
         }
         avformat_free_context(format_ctx_);
@@ -671,6 +1031,10 @@ void LibavEncoder::Cleanup() {
     video_stream_ = nullptr;
     audio_stream_ = nullptr;
 
+    // pre-roll (초기화 실패, 헤더 작성 실패 후 종료 등)
+    preroll_.reset();
+    mux_offset_us_ = 0;
+
     // PTS 및 QPC 상태 초기화
     last_video_pts_ = -1;
     last_audio_pts_ = -1;
@@ -0,0 +1,231 @@
+// libavcodec 기반 Video+Audio 인코더
+// FFmpeg 프로세스 + Named Pipe 방식을 대체
+
+#ifndef SAT_LEC_REC_LIBAV_ENCODER_H_
+#define SAT_LEC_REC_LIBAV_ENCODER_H_
+
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// FFmpeg 헤더 (C 라이브러리이므로 extern "C" 필요)
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/opt.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+#include <libswresample/swresample.h>
+}
+
+#include "media_clock.h"
+#include "output_tee.h"
+#include "packet_journal.h"
+#include "pipeline_stats.h"
+#include "preroll_ring.h"
+#include "trace_recorder.h"
+
+/// 녹화 중 사용할 컨테이너
+/// - kFragmentedMp4: fragment 단위로 복구 가능 (기본값)
+/// - kMatroska: cluster 단위로 flush, 어느 시점에 끊겨도 재생 가능
+/// - kMpegTs: 188바이트 패킷 단위 스트림, 어느 시점에 끊겨도 재생 가능
+/// MKV/TS는 녹화 종료 후 stream copy로 MP4 변환 (Mp4Finalizer)
+enum class RecordingContainer {
+    kFragmentedMp4 = 0,
+    kMatroska = 1,
+    kMpegTs = 2,
+};
+
+/// 입력: 컨테이너 종류
+/// 출력: 녹화 중 파일 확장자 (".mp4", ".mkv", ".ts")
+const char* RecordingContainerExtension(RecordingContainer container);
+
+/// 입력: 첫 세그먼트 경로, 세그먼트 번호 (0부터)
+/// 출력: 0번은 원래 경로, 이후는 <이름>_part<N+1>.<확장자> (인코더 재시작으로 이어 쓴 파일, satrec_concat으로 합침)
+std::wstring RecordingSegmentPath(const std::wstring& base, int index);
+
+/// 입력: libavcodec 인코더 설정 (출력 경로, 해상도, FPS 등)
+/// 출력: 인코더 초기화 및 실행 제어 함수 제공
+/// 예외: 초기화 실패 시 Start()가 false 반환, GetLastError()로 원인 확인
+struct LibavEncoderConfig {
+    std::wstring output_path;  // MP4 출력 파일 경로
+    // 보조 출력 경로 (비어 있으면 사용 안 함)
+    // 지정 시 muxer 출력을 두 대상에 비동기로 복제하고, 멈추거나 실패한 대상만 분리
+    std::wstring secondary_output_path;
+    OutputWriterOptions output_writer_options{};
+
+    // Video 설정
+    int video_width = 1920;
+    int video_height = 1080;
+    int video_fps = 24;
+
+    // Audio 설정
+    int audio_sample_rate = 48000;
+    int audio_channels = 2;
+
+    // 인코딩 옵션
+    RecordingContainer container = RecordingContainer::kFragmentedMp4;
+    bool enable_fragmented_mp4 = true;  // 크래시 복구용 (container가 MP4일 때만 사용)
+    int matroska_cluster_time_ms = 1000;  // MKV cluster 최대 길이 (flush 주기)
+    int h264_crf = 23;                  // 품질 (18=최고, 28=낮음)
+    const char* h264_preset = "veryfast";  // ultrafast, superfast, veryfast, faster, fast, medium, slow, slower, veryslow
+    int video_threads = 0;              // H.264 인코더 스레드 수 (0이면 코덱 기본값 = 자동)
+    int aac_bitrate = 192000;           // 192kbps
+
+    // 타임스탬프 시계 (nullptr이면 SystemMediaClock = Windows QPC)
+    // EncodeVideo/EncodeAudio의 capture_qpc는 이 시계의 tick이어야 함, 인코더보다 오래 살아 있어야 함
+    const MediaClock* clock = nullptr;
+
+    // 단계별 지연 시간 기록 대상 (nullptr이면 측정 안 함, 인코더보다 오래 살아 있어야 함)
+    PipelineStats* pipeline_stats = nullptr;
+
+    // 패킷 저널 (MP4 옆에 <출력 경로>.journal 기록, 정상 종료 시 삭제)
+    bool enable_packet_journal = false;
+    int journal_flush_interval_ms = 200;
+
+    // pre-roll: true면 Start에서 파일을 열지 않고 인코딩된 패킷을 메모리 링에만 보관
+    // CommitPreRoll 전까지 디스크를 쓰지 않으며, 커밋 없이 Stop하면 파일도 만들지 않음
+    bool start_in_preroll = false;
+    PreRollLimits preroll_limits{};
+};
+
+/// 입력: 없음
+/// 출력: pre-roll 커밋 결과 (CommitPreRoll)
+/// 예외: 없음
+struct PreRollCommitInfo {
+    int64_t packet_count = 0;    // 링에서 파일로 넘긴 패킷
+    int64_t bytes = 0;
+    int64_t preroll_ms = 0;      // 시작 키프레임 ~ 커밋 시점 (커밋 전에 미리 담긴 길이)
+    int64_t commit_us = 0;       // 링을 파일로 넘기는 데 걸린 시간 (헤더 작성 포함)
+};
+
+/// 입력: LibavEncoderConfig, BGRA 비디오 프레임, Float32 오디오 샘플
+/// 출력: H.264+AAC로 인코딩된 MP4 파일
+/// 예외: 인코딩 실패 시 EncodeVideo/EncodeAudio가 false 반환
+class LibavEncoder {
+public:
+    LibavEncoder();
+    ~LibavEncoder();
+
+    // 초기화 및 종료
+    bool Start(const LibavEncoderConfig& config);
+    void Stop();
+    bool IsRunning() const { return is_running_; }
+
+    // 프레임/오디오 인코딩
+    // bgra_data: 1920x1080x4 바이트 (BGRA 포맷)
+    // float32_data: 오디오 샘플 (Interleaved Float32, L/R/L/R...)
+    // capture_qpc: 캡처 시점 tick (config.clock 기준, 기본값은 QueryPerformanceCounter, A/V 동기화용)
+    bool EncodeVideo(const uint8_t* bgra_data, size_t length, uint64_t capture_qpc);
+    // i420_data: Y(w×h) → U → V(w/2×h/2) 연속 배치 (캡처 스레드에서 이미 변환한 프레임, 평면 복사만 함)
+    bool EncodeVideoI420(const uint8_t* i420_data, size_t length, uint64_t capture_qpc);
+    bool EncodeAudio(const uint8_t* float32_data, size_t length, uint64_t capture_qpc);
+
+    // pre-roll 커밋: 파일을 열고 commit_qpc 직전 비디오 키프레임부터 링의 패킷을 재인코딩 없이 기록
+    // 이후 패킷은 바로 파일로 감, 파일 타임스탬프는 그 키프레임이 0이 되도록 이동
+    // 실패 시 false (pre-roll 상태가 아니거나 파일 열기/쓰기 실패, 이후 패킷은 버려짐)
+    bool CommitPreRoll(uint64_t commit_qpc, PreRollCommitInfo* info);
+    bool IsPreRollActive() const { return preroll_ != nullptr; }
+
+    // PTS 기준 시점을 start_qpc로 옮김 (미리 시작해 둔 인코더를 트리거 시점부터 쓰는 경우)
+    // 첫 프레임/오디오를 인코딩하기 전에만 유효 (이미 인코딩했으면 false, 기준 유지)
+    bool ResetStartTime(uint64_t start_qpc);
+
+    // 에러 처리
+    std::string GetLastError() const { return last_error_; }
+
+    // 이중 출력 상태 (secondary_output_path 미사용 시 nullptr)
+    // 인코더 종료 후에도 마지막 상태를 조회할 수 있도록 shared_ptr로 공유
+    std::shared_ptr<const OutputTee> GetOutputTee() const { return output_tee_; }
+
+    // muxer에 넘긴 누적 패킷 바이트 (비트레이트 계산용, 인코딩 스레드에서 조회)
+    int64_t GetMuxedBytes() const { return muxed_bytes_; }
+
+private:
+    // === 초기화 헬퍼 ===
+    bool InitializeFormat();
+    bool InitializeVideoCodec();
+    bool InitializeAudioCodec();
+    bool WriteHeader();
+    bool OpenOutputTee(const std::string& primary_path);
+
+    // === 인코딩 헬퍼 ===
+    bool BeginVideoFrame(uint64_t capture_qpc);   // 실행 상태 확인 + 첫 프레임 로그
+    bool SubmitVideoFrame(uint64_t capture_qpc);  // video_frame_에 PTS 설정 후 전송
+    bool SendVideoFrame(AVFrame* frame);
+    bool SendAudioFrame(AVFrame* frame);
+    bool ReceiveAndWritePackets(AVCodecContext* codec_ctx, int stream_index);
+    // pre-roll 이동 적용 → stream time_base 변환 → 저널 → muxer (pkt는 비워짐)
+    bool WritePacket(AVPacket* pkt, AVRational codec_time_base, int stream_index);
+
+    // === 변환 헬퍼 ===
+    bool ConvertBGRAToYUV420(const uint8_t* bgra, AVFrame* yuv_frame);
+
+    // === 종료 헬퍼 ===
+    void FlushEncoder(AVCodecContext* codec_ctx, int stream_index);
+    bool WriteTrailer();
+    void CloseJournal(bool remove_file);
+    void Cleanup();
+
+    // 벤치마크에서 변환/패킷 수신 단계를 개별 측정 (native/bench)
+    friend class LibavEncoderBenchAccess;
+
+    // === 유틸리티 ===
+    void SetLastError(const std::string& message);
+    // 단계 통계 + trace 구간 기록
+    void RecordStage(PipelineStage stage, std::chrono::steady_clock::time_point started_at);
+    std::string WideToUTF8(const std::wstring& wide_str);
+
+    // === 설정 ===
+    LibavEncoderConfig config_{};
+
+    // === AVFormat ===
+    AVFormatContext* format_ctx_ = nullptr;
+    AVDictionary* mux_options_ = nullptr;  // avformat_write_header에 전달할 muxer 옵션
+    int64_t mux_write_time_ns_ = 0;        // av_interleaved_write_frame 누적 시간 (컨테이너 비교용)
+    int64_t mux_packet_count_ = 0;
+    int64_t muxed_bytes_ = 0;
+    std::shared_ptr<OutputTee> output_tee_;  // 이중 출력 시 format_ctx_->pb 제공
+
+    // === Video ===
+    AVCodecContext* video_codec_ctx_ = nullptr;
+    AVStream* video_stream_ = nullptr;
+    AVFrame* video_frame_ = nullptr;
+    SwsContext* sws_ctx_ = nullptr;
+    int64_t last_video_pts_ = -1;  // 단조 증가 보장용 (이전 PTS)
+
+    // === Audio ===
+    AVCodecContext* audio_codec_ctx_ = nullptr;
+    AVStream* audio_stream_ = nullptr;
+    AVFrame* audio_frame_ = nullptr;
+    SwrContext* swr_ctx_ = nullptr;
+    int64_t last_audio_pts_ = -1;  // 단조 증가 보장용 (이전 PTS)
+    std::vector<float> audio_buffer_;  // 오디오 샘플 버퍼 (Interleaved Float32)
+    uint64_t first_audio_qpc_ = 0;     // 첫 오디오 샘플의 QPC (디버그용)
+    int64_t audio_samples_written_ = 0; // 누적 작성 샘플 수 (통계용)
+
+    // === pre-roll ===
+    std::unique_ptr<PreRollRing> preroll_;  // 커밋 전까지만 존재 (nullptr이면 바로 기록)
+    int64_t mux_offset_us_ = 0;             // 커밋 시작 키프레임 시각 (파일 타임스탬프에서 뺌)
+
+    // === 패킷 저널 ===
+    std::unique_ptr<PacketJournalWriter> journal_;
+    std::chrono::steady_clock::time_point encode_started_at_{};  // 저널 오버헤드 비율 계산용
+
+    // === 디버그용 플래그 ===
+    bool first_video_logged_ = false;  // 첫 비디오 프레임 로그 출력 여부
+
+    // === QPC 타임스탬프 (A/V 동기화, config_.clock 기준) ===
+    uint64_t recording_start_qpc_ = 0;  // 녹화 시작 시점의 QPC
+    uint64_t qpc_frequency_ = 0;        // QPC 주파수 (초당 틱 수)
+
+    // === 상태 ===
+    bool is_running_ = false;
+    std::string last_error_;
+};
+
+#endif  // SAT_LEC_REC_LIBAV_ENCODER_H_
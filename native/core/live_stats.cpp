@@ -0,0 +1,80 @@
+// 녹화 실시간 통계 블록 구현
+
+#include "live_stats.h"
+
+#include <thread>
+
+void LiveStats::Publish(const LiveStatsSnapshot& snapshot) {
+    // 1. sequence를 홀수로 (기록 시작), 이후 필드 쓰기가 sequence보다 먼저 보이지 않도록 release fence
+    const uint32_t sequence = block_.sequence.load(std::memory_order_relaxed);
+    block_.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // 2. 필드 기록
+    block_.recording.store(snapshot.recording ? 1u : 0u, std::memory_order_relaxed);
+    block_.elapsed_ms.store(snapshot.elapsed_ms, std::memory_order_relaxed);
+    block_.video_frames.store(snapshot.video_frames, std::memory_order_relaxed);
+    block_.audio_samples.store(snapshot.audio_samples, std::memory_order_relaxed);
+    block_.captured_video_frames.store(snapshot.captured_video_frames, std::memory_order_relaxed);
+    block_.repeated_video_frames.store(snapshot.repeated_video_frames, std::memory_order_relaxed);
+    block_.dropped_video_frames.store(snapshot.dropped_video_frames, std::memory_order_relaxed);
+    block_.dropped_audio_packets.store(snapshot.dropped_audio_packets, std::memory_order_relaxed);
+    block_.dropped_audio_samples.store(snapshot.dropped_audio_samples, std::memory_order_relaxed);
+    block_.dropped_audio_ms.store(snapshot.dropped_audio_ms, std::memory_order_relaxed);
+    block_.encoded_bytes.store(snapshot.encoded_bytes, std::memory_order_relaxed);
+    block_.video_queue_depth.store(snapshot.video_queue_depth, std::memory_order_relaxed);
+    block_.video_queue_high_water.store(snapshot.video_queue_high_water, std::memory_order_relaxed);
+    block_.video_queue_capacity.store(snapshot.video_queue_capacity, std::memory_order_relaxed);
+    block_.audio_queue_depth.store(snapshot.audio_queue_depth, std::memory_order_relaxed);
+    block_.audio_queue_high_water.store(snapshot.audio_queue_high_water, std::memory_order_relaxed);
+    block_.audio_queue_capacity.store(snapshot.audio_queue_capacity, std::memory_order_relaxed);
+    block_.audio_level.store(snapshot.audio_level, std::memory_order_relaxed);
+    block_.audio_peak_level.store(snapshot.audio_peak_level, std::memory_order_relaxed);
+    block_.video_fps.store(snapshot.video_fps, std::memory_order_relaxed);
+    block_.encoder_bitrate_kbps.store(snapshot.encoder_bitrate_kbps, std::memory_order_relaxed);
+
+    // 3. sequence를 짝수로 (기록 완료, 필드 쓰기가 모두 보인 뒤)
+    block_.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool LiveStats::Read(LiveStatsSnapshot* out, int max_attempts) const {
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        const uint32_t before = block_.sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            // 기록 중: 기록자는 수백 ns 안에 끝나므로 양보 후 재시도
+            std::this_thread::yield();
+            continue;
+        }
+
+        LiveStatsSnapshot snapshot;
+        snapshot.recording = block_.recording.load(std::memory_order_relaxed) != 0;
+        snapshot.elapsed_ms = block_.elapsed_ms.load(std::memory_order_relaxed);
+        snapshot.video_frames = block_.video_frames.load(std::memory_order_relaxed);
+        snapshot.audio_samples = block_.audio_samples.load(std::memory_order_relaxed);
+        snapshot.captured_video_frames = block_.captured_video_frames.load(std::memory_order_relaxed);
+        snapshot.repeated_video_frames = block_.repeated_video_frames.load(std::memory_order_relaxed);
+        snapshot.dropped_video_frames = block_.dropped_video_frames.load(std::memory_order_relaxed);
+        snapshot.dropped_audio_packets = block_.dropped_audio_packets.load(std::memory_order_relaxed);
+        snapshot.dropped_audio_samples = block_.dropped_audio_samples.load(std::memory_order_relaxed);
+        snapshot.dropped_audio_ms = block_.dropped_audio_ms.load(std::memory_order_relaxed);
+        snapshot.encoded_bytes = block_.encoded_bytes.load(std::memory_order_relaxed);
+        snapshot.video_queue_depth = block_.video_queue_depth.load(std::memory_order_relaxed);
+        snapshot.video_queue_high_water = block_.video_queue_high_water.load(std::memory_order_relaxed);
+        snapshot.video_queue_capacity = block_.video_queue_capacity.load(std::memory_order_relaxed);
+        snapshot.audio_queue_depth = block_.audio_queue_depth.load(std::memory_order_relaxed);
+        snapshot.audio_queue_high_water = block_.audio_queue_high_water.load(std::memory_order_relaxed);
+        snapshot.audio_queue_capacity = block_.audio_queue_capacity.load(std::memory_order_relaxed);
+        snapshot.audio_level = block_.audio_level.load(std::memory_order_relaxed);
+        snapshot.audio_peak_level = block_.audio_peak_level.load(std::memory_order_relaxed);
+        snapshot.video_fps = block_.video_fps.load(std::memory_order_relaxed);
+        snapshot.encoder_bitrate_kbps = block_.encoder_bitrate_kbps.load(std::memory_order_relaxed);
+
+        // 필드 읽기가 두 번째 sequence 읽기 뒤로 밀리지 않도록 acquire fence
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block_.sequence.load(std::memory_order_relaxed) == before) {
+            *out = snapshot;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,108 @@
+// 녹화 실시간 통계 블록 (seqlock)
+// UI가 블록 주소를 한 번만 받아 두고 FFI 호출 없이 메모리에서 직접 읽음
+
+#ifndef SAT_LEC_REC_LIVE_STATS_H_
+#define SAT_LEC_REC_LIVE_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+
+// 블록 레이아웃 버전 (필드 추가/변경 시 증가, Dart는 다르면 읽지 않음)
+constexpr uint32_t kLiveStatsVersion = 1;
+
+/// 입력: 없음
+/// 출력: 한 시점의 녹화 통계 값
+/// 예외: 없음
+struct LiveStatsSnapshot {
+    bool recording = false;
+    int64_t elapsed_ms = 0;
+    int64_t video_frames = 0;            // 인코딩 완료 프레임
+    int64_t audio_samples = 0;           // 인코딩 완료 오디오 프레임 (채널당)
+    int64_t captured_video_frames = 0;
+    int64_t repeated_video_frames = 0;
+    int64_t dropped_video_frames = 0;
+    int64_t dropped_audio_packets = 0;
+    int64_t dropped_audio_samples = 0;
+    int64_t dropped_audio_ms = 0;
+    int64_t encoded_bytes = 0;           // muxer에 넘긴 누적 바이트
+    int32_t video_queue_depth = 0;
+    int32_t video_queue_high_water = 0;
+    int32_t video_queue_capacity = 0;
+    int32_t audio_queue_depth = 0;
+    int32_t audio_queue_high_water = 0;
+    int32_t audio_queue_capacity = 0;
+    float audio_level = 0.0f;            // RMS (0.0 ~ 1.0)
+    float audio_peak_level = 0.0f;       // Peak (0.0 ~ 1.0)
+    float video_fps = 0.0f;              // 직전 갱신 구간의 인코딩 fps
+    float encoder_bitrate_kbps = 0.0f;   // 직전 갱신 구간의 출력 비트레이트
+};
+
+/// 입력: 없음
+/// 출력: 공유 메모리 통계 블록 (64바이트 정렬, 3 캐시 라인)
+/// 예외: 없음
+///
+/// 레이아웃은 native_screen_recorder.h의 NativeRecorderLiveStats,
+/// lib/ffi/native_bindings.dart의 NativeLiveStats와 같아야 함 (모든 필드가 lock-free atomic = 일반 정수/실수 크기)
+///
+/// 읽기 규칙 (seqlock): sequence가 홀수면 기록 중, 필드를 읽기 전후 sequence가 같아야 일관된 값
+struct alignas(64) LiveStatsBlock {
+    uint32_t version = kLiveStatsVersion;
+    uint32_t struct_size = sizeof(LiveStatsBlock);
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint32_t> recording{0};
+
+    std::atomic<int64_t> elapsed_ms{0};
+    std::atomic<int64_t> video_frames{0};
+    std::atomic<int64_t> audio_samples{0};
+    std::atomic<int64_t> captured_video_frames{0};
+    std::atomic<int64_t> repeated_video_frames{0};
+    std::atomic<int64_t> dropped_video_frames{0};
+    std::atomic<int64_t> dropped_audio_packets{0};
+    std::atomic<int64_t> dropped_audio_samples{0};
+    std::atomic<int64_t> dropped_audio_ms{0};
+    std::atomic<int64_t> encoded_bytes{0};
+
+    std::atomic<int32_t> video_queue_depth{0};
+    std::atomic<int32_t> video_queue_high_water{0};
+    std::atomic<int32_t> video_queue_capacity{0};
+    std::atomic<int32_t> audio_queue_depth{0};
+    std::atomic<int32_t> audio_queue_high_water{0};
+    std::atomic<int32_t> audio_queue_capacity{0};
+
+    std::atomic<float> audio_level{0.0f};
+    std::atomic<float> audio_peak_level{0.0f};
+    std::atomic<float> video_fps{0.0f};
+    std::atomic<float> encoder_bitrate_kbps{0.0f};
+};
+
+static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t) && std::atomic<int64_t>::is_always_lock_free,
+              "FFI에서 일반 Int64로 읽으려면 lock-free atomic이어야 함");
+static_assert(sizeof(std::atomic<float>) == sizeof(float) && std::atomic<float>::is_always_lock_free,
+              "FFI에서 일반 Float로 읽으려면 lock-free atomic이어야 함");
+static_assert(sizeof(LiveStatsBlock) == 192, "NativeRecorderLiveStats / NativeLiveStats 레이아웃과 맞춰야 함");
+
+/// 입력: 통계 스냅샷 (기록 스레드 하나에서만 Publish)
+/// 출력: 다른 스레드/프로세스(Dart)가 읽는 LiveStatsBlock
+/// 예외: 없음
+///
+/// 블록 주소는 객체 수명 동안 바뀌지 않음 (UI는 한 번만 매핑)
+class LiveStats {
+public:
+    LiveStats() = default;
+
+    LiveStats(const LiveStats&) = delete;
+    LiveStats& operator=(const LiveStats&) = delete;
+
+    // 단일 기록자 전용 (동시에 두 스레드가 호출하면 안 됨)
+    void Publish(const LiveStatsSnapshot& snapshot);
+
+    // 아무 스레드에서나 호출 가능, 일관된 값을 못 읽으면 max_attempts번 재시도 후 false
+    bool Read(LiveStatsSnapshot* out, int max_attempts = 64) const;
+
+    const LiveStatsBlock& block() const { return block_; }
+
+private:
+    LiveStatsBlock block_;
+};
+
+#endif  // SAT_LEC_REC_LIVE_STATS_H_
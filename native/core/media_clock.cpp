@@ -0,0 +1,62 @@
+// 캡처/인코딩 타임스탬프 시계 구현
+
+#include "media_clock.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+int64_t MediaClock::ElapsedNs(uint64_t from, uint64_t to) const {
+    const uint64_t frequency = Frequency();
+    if (frequency == 0 || to <= from) return 0;
+    const uint64_t delta = to - from;
+    // 초 단위와 나머지로 나눠 곱셈 overflow 방지
+    return static_cast<int64_t>((delta / frequency) * 1000000000ULL +
+                                (delta % frequency) * 1000000000ULL / frequency);
+}
+
+int64_t MediaClock::PositionAt(uint64_t start, uint64_t now, int64_t rate) const {
+    const int64_t elapsed_ns = ElapsedNs(start, now);
+    if (rate <= 0) return 0;
+    return (elapsed_ns / 1000000000LL) * rate + (elapsed_ns % 1000000000LL) * rate / 1000000000LL;
+}
+
+uint64_t MediaClock::TickAt(uint64_t start, int64_t position, int64_t rate) const {
+    if (rate <= 0 || position <= 0) return start;
+    const uint64_t pos = static_cast<uint64_t>(position);
+    const uint64_t r = static_cast<uint64_t>(rate);
+    const uint64_t frequency = Frequency();
+    return start + (pos / r) * frequency + (pos % r) * frequency / r;
+}
+
+const SystemMediaClock& SystemMediaClock::Instance() {
+    static const SystemMediaClock instance;
+    return instance;
+}
+
+SystemMediaClock::SystemMediaClock() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    frequency_ = static_cast<uint64_t>(frequency.QuadPart);
+#else
+    frequency_ = 1000000000ULL;
+#endif
+}
+
+uint64_t SystemMediaClock::Now() const {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+uint64_t SystemMediaClock::Frequency() const {
+    return frequency_;
+}
@@ -0,0 +1,69 @@
+// 캡처/인코딩 타임스탬프 시계
+// Windows 캡처 코드의 QueryPerformanceCounter 값과 같은 단위(tick + 초당 tick 수)를 사용
+
+#ifndef SAT_LEC_REC_MEDIA_CLOCK_H_
+#define SAT_LEC_REC_MEDIA_CLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+
+/// 입력: 없음
+/// 출력: 현재 tick과 초당 tick 수
+/// 예외: 없음
+///
+/// 캡처 타임스탬프와 LibavEncoder의 녹화 시작 시점은 같은 시계를 사용해야 함
+/// (PTS = (캡처 tick - 시작 tick) / 초당 tick 수)
+class MediaClock {
+public:
+    virtual ~MediaClock() = default;
+
+    virtual uint64_t Now() const = 0;
+    virtual uint64_t Frequency() const = 0;
+
+    // 두 tick 사이 경과 시간 (나노초, overflow 없이 계산)
+    int64_t ElapsedNs(uint64_t from, uint64_t to) const;
+
+    // 샘플/프레임 번호 ↔ tick 변환 (rate: 초당 샘플/프레임 수)
+    // PositionAt: start부터 now까지 지난 위치 (내림), TickAt: start에서 position만큼 지난 tick
+    int64_t PositionAt(uint64_t start, uint64_t now, int64_t rate) const;
+    uint64_t TickAt(uint64_t start, int64_t position, int64_t rate) const;
+};
+
+/// 시스템 시계
+/// - Windows: QueryPerformanceCounter (DXGI/WASAPI 캡처 타임스탬프와 동일)
+/// - 그 외: steady_clock 나노초
+class SystemMediaClock : public MediaClock {
+public:
+    static const SystemMediaClock& Instance();
+
+    uint64_t Now() const override;
+    uint64_t Frequency() const override;
+
+private:
+    SystemMediaClock();
+
+    uint64_t frequency_ = 0;
+};
+
+/// 수동으로 진행하는 시계 (벤치마크, 실제 시간보다 빠른 장시간 테스트용)
+/// 초당 tick 수는 생성 시 지정 (기본 1GHz = 나노초)
+class ManualMediaClock : public MediaClock {
+public:
+    explicit ManualMediaClock(uint64_t frequency = 1000000000ULL) : frequency_(frequency) {}
+
+    uint64_t Now() const override { return ticks_.load(std::memory_order_acquire); }
+    uint64_t Frequency() const override { return frequency_; }
+
+    void Set(uint64_t ticks) { ticks_.store(ticks, std::memory_order_release); }
+    void Advance(uint64_t ticks) { ticks_.fetch_add(ticks, std::memory_order_acq_rel); }
+    // 초 단위 진행 (tick으로 반올림)
+    void AdvanceSeconds(double seconds) {
+        Advance(static_cast<uint64_t>(seconds * static_cast<double>(frequency_) + 0.5));
+    }
+
+private:
+    uint64_t frequency_;
+    std::atomic<uint64_t> ticks_{0};
+};
+
+#endif  // SAT_LEC_REC_MEDIA_CLOCK_H_
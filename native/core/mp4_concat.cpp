@@ -0,0 +1,389 @@
+// 재인코딩 없는 MP4 세그먼트 이어붙이기 구현
+
+#include "mp4_concat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "native_logger.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace {
+
+std::string AvErrorToString(int errnum) {
+    char err_buf[128];
+    av_strerror(errnum, err_buf, sizeof(err_buf));
+    return std::string(err_buf);
+}
+
+int64_t FileSizeOrZero(const std::string& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(std::filesystem::u8path(path), ec);
+    return ec ? 0 : static_cast<int64_t>(size);
+}
+
+bool IsCopiedStream(const AVStream* stream) {
+    const AVMediaType type = stream->codecpar->codec_type;
+    return type == AVMEDIA_TYPE_VIDEO || type == AVMEDIA_TYPE_AUDIO;
+}
+
+// 입력: 세그먼트 경로
+// 출력: 스트림 정보까지 읽은 AVFormatContext (실패 시 nullptr)
+// 예외: 실패 시 error에 원인 기록
+AVFormatContext* OpenSegment(const std::string& path, std::string* error) {
+    AVFormatContext* ctx = nullptr;
+    int ret = avformat_open_input(&ctx, path.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        if (error) *error = "세그먼트 열기 실패 (" + path + "): " + AvErrorToString(ret);
+        return nullptr;
+    }
+    ret = avformat_find_stream_info(ctx, nullptr);
+    if (ret < 0) {
+        if (error) *error = "스트림 정보 읽기 실패 (" + path + "): " + AvErrorToString(ret);
+        avformat_close_input(&ctx);
+        return nullptr;
+    }
+    return ctx;
+}
+
+// 입력: 기준 코덱 파라미터, 비교 대상 코덱 파라미터
+// 출력: 하나의 MP4 트랙(stsd 1개)에 담을 수 있으면 true
+// 예외: 다르면 reason에 차이점 기록
+bool SameCodecParameters(const AVCodecParameters* a,
+                         const AVCodecParameters* b,
+                         std::string* reason) {
+    if (a->codec_type != b->codec_type || a->codec_id != b->codec_id) {
+        *reason = std::string("코덱 불일치: ") + avcodec_get_name(a->codec_id) +
+                  " vs " + avcodec_get_name(b->codec_id);
+        return false;
+    }
+
+    if (a->codec_type == AVMEDIA_TYPE_VIDEO) {
+        if (a->width != b->width || a->height != b->height) {
+            *reason = "해상도 불일치: " + std::to_string(a->width) + "x" +
+                      std::to_string(a->height) + " vs " + std::to_string(b->width) +
+                      "x" + std::to_string(b->height);
+            return false;
+        }
+        if (a->format != b->format) {
+            *reason = "픽셀 포맷 불일치";
+            return false;
+        }
+    } else if (a->codec_type == AVMEDIA_TYPE_AUDIO) {
+        if (a->sample_rate != b->sample_rate) {
+            *reason = "샘플레이트 불일치: " + std::to_string(a->sample_rate) + " vs " +
+                      std::to_string(b->sample_rate);
+            return false;
+        }
+        if (a->ch_layout.nb_channels != b->ch_layout.nb_channels) {
+            *reason = "채널 수 불일치";
+            return false;
+        }
+    }
+
+    // extradata (H.264 SPS/PPS, AAC AudioSpecificConfig)가 다르면 packet copy 불가
+    if (a->extradata_size != b->extradata_size ||
+        (a->extradata_size > 0 &&
+         memcmp(a->extradata, b->extradata, a->extradata_size) != 0)) {
+        *reason = std::string(av_get_media_type_string(a->codec_type)) +
+                  " extradata 불일치 (인코더 설정이 다름)";
+        return false;
+    }
+
+    return true;
+}
+
+// 입력: 세그먼트 경로 목록
+// 출력: 모든 세그먼트의 A/V 스트림 구성이 첫 세그먼트와 같으면 kOk
+// 예외: 호환되지 않으면 kIncompatible, 열기 실패 시 kIoError
+ConcatResult VerifyCompatibility(const std::vector<std::string>& input_paths,
+                                 std::string* error) {
+    AVFormatContext* reference = OpenSegment(input_paths[0], error);
+    if (!reference) {
+        return ConcatResult::kIoError;
+    }
+
+    std::vector<const AVCodecParameters*> reference_params;
+    for (unsigned int i = 0; i < reference->nb_streams; i++) {
+        if (IsCopiedStream(reference->streams[i])) {
+            reference_params.push_back(reference->streams[i]->codecpar);
+        }
+    }
+
+    ConcatResult result = ConcatResult::kOk;
+    if (reference_params.empty()) {
+        if (error) *error = "Video/Audio 스트림이 없습니다: " + input_paths[0];
+        result = ConcatResult::kIncompatible;
+    }
+
+    for (size_t seg = 1; seg < input_paths.size() && result == ConcatResult::kOk; seg++) {
+        AVFormatContext* ctx = OpenSegment(input_paths[seg], error);
+        if (!ctx) {
+            result = ConcatResult::kIoError;
+            break;
+        }
+
+        size_t index = 0;
+        std::string reason;
+        for (unsigned int i = 0; i < ctx->nb_streams; i++) {
+            if (!IsCopiedStream(ctx->streams[i])) continue;
+            if (index >= reference_params.size()) {
+                reason = "스트림 수 불일치";
+                break;
+            }
+            if (!SameCodecParameters(reference_params[index], ctx->streams[i]->codecpar, &reason)) {
+                break;
+            }
+            index++;
+        }
+        if (reason.empty() && index != reference_params.size()) {
+            reason = "스트림 수 불일치";
+        }
+        if (!reason.empty()) {
+            if (error) *error = "호환되지 않는 세그먼트 (" + input_paths[seg] + "): " + reason;
+            result = ConcatResult::kIncompatible;
+        }
+
+        avformat_close_input(&ctx);
+    }
+
+    avformat_close_input(&reference);
+    return result;
+}
+
+}  // namespace
+
+// ==============================================================================
+// 세그먼트 이어붙이기
+// ==============================================================================
+
+ConcatResult ConcatSegments(const std::vector<std::string>& input_paths,
+                            const std::string& output_path,
+                            ConcatStats* stats,
+                            std::string* error) {
+    if (input_paths.empty() || output_path.empty()) {
+        if (error) *error = "입력 세그먼트 또는 출력 경로가 비어 있습니다";
+        return ConcatResult::kInvalidArgument;
+    }
+
+    const auto started_at = std::chrono::steady_clock::now();
+    ConcatStats local_stats;
+    local_stats.segment_count = static_cast<int>(input_paths.size());
+
+    // 1. 코덱 파라미터 호환성 검사 (복사 시작 전에 전부 확인)
+    ConcatResult result = VerifyCompatibility(input_paths, error);
+    if (result != ConcatResult::kOk) {
+        SATREC_LOG_ERROR("[Mp4Concat] ❌ 세그먼트 검사 실패: %s", error ? error->c_str() : "");
+        return result;
+    }
+
+    AVFormatContext* out_ctx = nullptr;
+    bool output_created = false;  // 실패하면 이 함수가 만든 출력 파일을 지움
+    AVPacket* pkt = av_packet_alloc();
+    if (!pkt) {
+        if (error) *error = "AVPacket 할당 실패";
+        return ConcatResult::kIoError;
+    }
+
+    // 출력 스트림별 타임스탬프 상태 (출력 time_base 기준)
+    std::vector<int64_t> last_dts;
+    int64_t timeline_end_us = 0;  // 지금까지 이어붙인 구간의 끝 (AV_TIME_BASE)
+    int64_t max_end_us = 0;       // 지금까지 쓴 패킷 중 가장 늦게 끝나는 시각 (AV_TIME_BASE)
+
+    for (size_t seg = 0; seg < input_paths.size() && result == ConcatResult::kOk; seg++) {
+        AVFormatContext* in_ctx = OpenSegment(input_paths[seg], error);
+        if (!in_ctx) {
+            result = ConcatResult::kIoError;
+            break;
+        }
+
+        // 2. 첫 세그먼트 기준으로 출력 생성
+        if (!out_ctx) {
+            int ret = avformat_alloc_output_context2(&out_ctx, nullptr, "mp4", output_path.c_str());
+            if (ret < 0 || !out_ctx) {
+                if (error) *error = "출력 컨텍스트 생성 실패: " + AvErrorToString(ret);
+                avformat_close_input(&in_ctx);
+                result = ConcatResult::kIoError;
+                break;
+            }
+
+            for (unsigned int i = 0; i < in_ctx->nb_streams; i++) {
+                AVStream* in_stream = in_ctx->streams[i];
+                if (!IsCopiedStream(in_stream)) continue;
+
+                AVStream* out_stream = avformat_new_stream(out_ctx, nullptr);
+                if (!out_stream ||
+                    avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar) < 0) {
+                    if (error) *error = "출력 스트림 생성 실패";
+                    result = ConcatResult::kIoError;
+                    break;
+                }
+                out_stream->codecpar->codec_tag = 0;
+                out_stream->time_base = in_stream->time_base;
+            }
+
+            if (result == ConcatResult::kOk) {
+                int ret = avio_open(&out_ctx->pb, output_path.c_str(), AVIO_FLAG_WRITE);
+                if (ret < 0) {
+                    if (error) *error = "출력 파일 열기 실패: " + AvErrorToString(ret);
+                    result = ConcatResult::kIoError;
+                } else {
+                    output_created = true;
+                }
+            }
+
+            if (result == ConcatResult::kOk) {
+                AVDictionary* mux_options = nullptr;
+                av_dict_set(&mux_options, "movflags", "+faststart", 0);
+                int ret = avformat_write_header(out_ctx, &mux_options);
+                av_dict_free(&mux_options);
+                if (ret < 0) {
+                    if (error) *error = "avformat_write_header 실패: " + AvErrorToString(ret);
+                    result = ConcatResult::kIoError;
+                }
+            }
+
+            if (result != ConcatResult::kOk) {
+                avformat_close_input(&in_ctx);
+                break;
+            }
+            last_dts.assign(out_ctx->nb_streams, AV_NOPTS_VALUE);
+        }
+
+        // 3. 입력 스트림 → 출력 스트림 매핑 (호환성 검사로 순서/개수 일치 보장)
+        std::vector<int> stream_map(in_ctx->nb_streams, -1);
+        int next_out = 0;
+        for (unsigned int i = 0; i < in_ctx->nb_streams; i++) {
+            if (IsCopiedStream(in_ctx->streams[i])) {
+                stream_map[i] = next_out++;
+            }
+        }
+
+        // 4. 경계 보정: 세그먼트 시작 시각을 지금까지의 타임라인 끝에 맞춤
+        //    (세그먼트 내부의 A/V 상대 위치는 그대로 유지)
+        //    공백 = 직전 세그먼트 끝보다 늦게 시작한 만큼 (앞으로 당김), 일찍 시작하면 뒤로 밀 뿐 공백이 아님
+        const int64_t segment_start_us =
+            (in_ctx->start_time != AV_NOPTS_VALUE) ? in_ctx->start_time : 0;
+        const int64_t shift_us = timeline_end_us - segment_start_us;
+        if (shift_us < 0) {
+            local_stats.gaps_closed++;
+            local_stats.closed_gap_seconds += static_cast<double>(-shift_us) / AV_TIME_BASE;
+        }
+
+        SATREC_LOG_INFO("[Mp4Concat] 세그먼트 %zu/%zu: %s (시작 %.3fs → %.3fs)",
+                        seg + 1, input_paths.size(), input_paths[seg].c_str(),
+                        static_cast<double>(segment_start_us) / AV_TIME_BASE,
+                        static_cast<double>(timeline_end_us) / AV_TIME_BASE);
+
+        int ret = 0;
+        while ((ret = av_read_frame(in_ctx, pkt)) >= 0) {
+            const int in_index = pkt->stream_index;
+            if (in_index < 0 || in_index >= static_cast<int>(stream_map.size()) ||
+                stream_map[in_index] < 0) {
+                av_packet_unref(pkt);
+                continue;
+            }
+
+            const int out_index = stream_map[in_index];
+            AVStream* in_stream = in_ctx->streams[in_index];
+            AVStream* out_stream = out_ctx->streams[out_index];
+
+            if (pkt->dts == AV_NOPTS_VALUE) {
+                pkt->dts = pkt->pts;
+            }
+            av_packet_rescale_ts(pkt, in_stream->time_base, out_stream->time_base);
+
+            const int64_t shift = av_rescale_q(shift_us, AV_TIME_BASE_Q, out_stream->time_base);
+            if (pkt->pts != AV_NOPTS_VALUE) pkt->pts += shift;
+            if (pkt->dts != AV_NOPTS_VALUE) pkt->dts += shift;
+
+            // 단조 증가 보장: 경계에서 겹치면 직전 DTS 다음으로 밀어냄
+            int64_t& prev_dts = last_dts[out_index];
+            if (pkt->dts != AV_NOPTS_VALUE && prev_dts != AV_NOPTS_VALUE && pkt->dts <= prev_dts) {
+                const int64_t bump = prev_dts + 1 - pkt->dts;
+                pkt->dts += bump;
+                if (pkt->pts != AV_NOPTS_VALUE) pkt->pts += bump;
+            }
+            if (pkt->dts != AV_NOPTS_VALUE) {
+                prev_dts = pkt->dts;
+                const int64_t end_us = av_rescale_q(pkt->dts + std::max<int64_t>(pkt->duration, 0),
+                                                    out_stream->time_base, AV_TIME_BASE_Q);
+                max_end_us = std::max(max_end_us, end_us);
+            }
+
+            pkt->stream_index = out_index;
+            pkt->pos = -1;
+
+            ret = av_interleaved_write_frame(out_ctx, pkt);
+            if (ret < 0) {
+                if (error) *error = "av_interleaved_write_frame 실패: " + AvErrorToString(ret);
+                result = ConcatResult::kIoError;
+                break;
+            }
+            local_stats.packet_count++;
+        }
+
+        if (result == ConcatResult::kOk && ret != AVERROR_EOF) {
+            if (error) *error = "av_read_frame 실패 (" + input_paths[seg] + "): " + AvErrorToString(ret);
+            result = ConcatResult::kIoError;
+        }
+
+        timeline_end_us = max_end_us;
+        local_stats.input_bytes += FileSizeOrZero(input_paths[seg]);
+        avformat_close_input(&in_ctx);
+    }
+
+    // 5. trailer 작성 (faststart로 moov를 앞쪽으로 이동)
+    if (result == ConcatResult::kOk && out_ctx) {
+        int ret = av_write_trailer(out_ctx);
+        if (ret < 0) {
+            if (error) *error = "av_write_trailer 실패: " + AvErrorToString(ret);
+            result = ConcatResult::kIoError;
+        }
+    }
+
+    av_packet_free(&pkt);
+    if (out_ctx) {
+        if (out_ctx->pb) {
+            avio_closep(&out_ctx->pb);
+        }
+        avformat_free_context(out_ctx);
+    }
+    // 중간에 실패한 출력은 재생할 수 없는 조각이므로 남기지 않음 (닫은 뒤에 지워야 Windows에서도 삭제됨)
+    if (result != ConcatResult::kOk && output_created) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(output_path), ec);
+    }
+
+    local_stats.output_duration_seconds = static_cast<double>(max_end_us) / AV_TIME_BASE;
+    local_stats.elapsed_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started_at).count();
+    if (result == ConcatResult::kOk) {
+        local_stats.output_bytes = FileSizeOrZero(output_path);
+        if (local_stats.elapsed_seconds > 0.0) {
+            local_stats.throughput_mb_per_sec =
+                static_cast<double>(local_stats.input_bytes) / (1024.0 * 1024.0) /
+                local_stats.elapsed_seconds;
+        }
+        SATREC_LOG_INFO("[Mp4Concat] ✅ 이어붙이기 완료: 세그먼트 %d개, 패킷 %lld개, %.1fs 분량, %.2fs (%.1fMB/s)",
+                        local_stats.segment_count,
+                        static_cast<long long>(local_stats.packet_count),
+                        local_stats.output_duration_seconds,
+                        local_stats.elapsed_seconds,
+                        local_stats.throughput_mb_per_sec);
+    } else {
+        SATREC_LOG_ERROR("[Mp4Concat] ❌ 이어붙이기 실패: %s", error ? error->c_str() : "");
+    }
+
+    if (stats) {
+        *stats = local_stats;
+    }
+    return result;
+}
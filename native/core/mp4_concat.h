@@ -0,0 +1,47 @@
+// 재인코딩 없는 MP4 세그먼트 이어붙이기 (packet copy)
+// 세그먼트로 나뉘었거나 크래시 후 재시작된 강의를 하나의 파일로 합침
+
+#ifndef SAT_LEC_REC_MP4_CONCAT_H_
+#define SAT_LEC_REC_MP4_CONCAT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// ConcatSegments 결과 코드
+enum class ConcatResult {
+    kOk = 0,
+    kInvalidArgument = -1,   // 입력 목록이 비었거나 경로가 잘못됨
+    kIncompatible = -2,      // 코덱 파라미터가 서로 다름 (재인코딩 필요)
+    kIoError = -3,           // 파일 읽기/쓰기 실패
+};
+
+/// 입력: 없음
+/// 출력: 이어붙이기 작업 통계
+/// 예외: 없음
+struct ConcatStats {
+    int segment_count = 0;
+    int64_t packet_count = 0;
+    int64_t input_bytes = 0;
+    int64_t output_bytes = 0;
+    int64_t gaps_closed = 0;          // 직전 세그먼트 끝보다 늦게 시작해 당긴 경계 수 (겹친 경계는 세지 않음)
+    double closed_gap_seconds = 0.0;  // 당긴 길이의 합 (초)
+    double output_duration_seconds = 0.0;
+    double elapsed_seconds = 0.0;
+    double throughput_mb_per_sec = 0.0;
+};
+
+/// 입력: 세그먼트 경로 목록 (UTF-8, 재생 순서), 출력 경로 (UTF-8)
+/// 출력: 모든 세그먼트를 packet copy로 이어붙인 faststart MP4
+/// 예외: 실패 시 ConcatResult 오류 코드 반환, error에 원인 기록 (쓰다 만 출력 파일은 지움)
+///
+/// 처리 방식:
+/// 1. 모든 세그먼트의 코덱 파라미터(코덱, 해상도, 샘플레이트, extradata)를 먼저 비교
+/// 2. 세그먼트를 하나씩 열어 패킷을 순서대로 복사 (동시에 열리는 입력은 항상 1개)
+/// 3. 세그먼트 경계에서 타임스탬프를 이전 세그먼트 끝에 이어지도록 보정
+ConcatResult ConcatSegments(const std::vector<std::string>& input_paths,
+                            const std::string& output_path,
+                            ConcatStats* stats,
+                            std::string* error);
+
+#endif  // SAT_LEC_REC_MP4_CONCAT_H_
@@ -0,0 +1,385 @@
+// 녹화 종료 후 MP4 후처리 (faststart remux) 구현
+
+#include "mp4_finalizer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "libav_encoder.h"
+#include "mp4_concat.h"
+#include "native_logger.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace {
+
+std::string AvErrorToString(int errnum) {
+    char err_buf[128];
+    av_strerror(errnum, err_buf, sizeof(err_buf));
+    return std::string(err_buf);
+}
+
+int64_t FileSizeOrZero(const std::string& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(std::filesystem::u8path(path), ec);
+    return ec ? 0 : static_cast<int64_t>(size);
+}
+
+}  // namespace
+
+// ==============================================================================
+// Stream copy remux
+// ==============================================================================
+
+bool RemuxToFaststartMp4(const std::string& input_path,
+                         const std::string& output_path,
+                         Mp4FinalizeStats* stats,
+                         std::string* error) {
+    const auto started_at = std::chrono::steady_clock::now();
+
+    AVFormatContext* in_ctx = nullptr;
+    AVFormatContext* out_ctx = nullptr;
+    AVPacket* pkt = nullptr;
+    std::vector<int> stream_map;
+    int64_t packet_count = 0;
+    bool success = false;
+
+    auto fail = [&](const std::string& message) {
+        if (error) *error = message;
+    };
+
+    do {
+        // 1. 입력 열기 (moov + 첫 fragment만 읽음, 나머지는 패킷 단위로 스트리밍)
+        int ret = avformat_open_input(&in_ctx, input_path.c_str(), nullptr, nullptr);
+        if (ret < 0) {
+            fail("입력 파일 열기 실패: " + AvErrorToString(ret));
+            break;
+        }
+        ret = avformat_find_stream_info(in_ctx, nullptr);
+        if (ret < 0) {
+            fail("스트림 정보 읽기 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 2. 출력 컨텍스트 (progressive MP4)
+        ret = avformat_alloc_output_context2(&out_ctx, nullptr, "mp4", output_path.c_str());
+        if (ret < 0 || !out_ctx) {
+            fail("출력 컨텍스트 생성 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 3. Video/Audio 스트림만 그대로 복사 (codec_tag는 muxer가 다시 결정)
+        stream_map.assign(in_ctx->nb_streams, -1);
+        int out_index = 0;
+        bool stream_error = false;
+        for (unsigned int i = 0; i < in_ctx->nb_streams; i++) {
+            AVStream* in_stream = in_ctx->streams[i];
+            const AVMediaType type = in_stream->codecpar->codec_type;
+            if (type != AVMEDIA_TYPE_VIDEO && type != AVMEDIA_TYPE_AUDIO) {
+                continue;
+            }
+
+            AVStream* out_stream = avformat_new_stream(out_ctx, nullptr);
+            if (!out_stream) {
+                fail("출력 스트림 생성 실패");
+                stream_error = true;
+                break;
+            }
+            ret = avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar);
+            if (ret < 0) {
+                fail("코덱 파라미터 복사 실패: " + AvErrorToString(ret));
+                stream_error = true;
+                break;
+            }
+            out_stream->codecpar->codec_tag = 0;
+            out_stream->time_base = in_stream->time_base;
+            stream_map[i] = out_index++;
+        }
+        if (stream_error) break;
+        if (out_index == 0) {
+            fail("복사할 Video/Audio 스트림이 없습니다");
+            break;
+        }
+
+        ret = avio_open(&out_ctx->pb, output_path.c_str(), AVIO_FLAG_WRITE);
+        if (ret < 0) {
+            fail("출력 파일 열기 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 4. faststart: trailer 작성 시 moov를 파일 앞쪽으로 이동
+        //    (libavformat이 고정 크기 버퍼로 mdat을 뒤로 밀어내므로 메모리 사용량 일정)
+        AVDictionary* mux_options = nullptr;
+        av_dict_set(&mux_options, "movflags", "+faststart", 0);
+        ret = avformat_write_header(out_ctx, &mux_options);
+        av_dict_free(&mux_options);
+        if (ret < 0) {
+            fail("avformat_write_header 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 5. 패킷 단위 복사
+        pkt = av_packet_alloc();
+        if (!pkt) {
+            fail("AVPacket 할당 실패");
+            break;
+        }
+
+        bool copy_error = false;
+        while ((ret = av_read_frame(in_ctx, pkt)) >= 0) {
+            const int in_index = pkt->stream_index;
+            if (in_index < 0 || in_index >= static_cast<int>(stream_map.size()) ||
+                stream_map[in_index] < 0) {
+                av_packet_unref(pkt);
+                continue;
+            }
+
+            AVStream* in_stream = in_ctx->streams[in_index];
+            AVStream* out_stream = out_ctx->streams[stream_map[in_index]];
+            av_packet_rescale_ts(pkt, in_stream->time_base, out_stream->time_base);
+            pkt->stream_index = stream_map[in_index];
+            pkt->pos = -1;
+
+            ret = av_interleaved_write_frame(out_ctx, pkt);
+            if (ret < 0) {
+                fail("av_interleaved_write_frame 실패: " + AvErrorToString(ret));
+                copy_error = true;
+                break;
+            }
+            packet_count++;
+        }
+        if (copy_error) break;
+        if (ret != AVERROR_EOF) {
+            fail("av_read_frame 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 6. trailer 작성 (moov 이동 포함)
+        ret = av_write_trailer(out_ctx);
+        if (ret < 0) {
+            fail("av_write_trailer 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        success = true;
+    } while (false);
+
+    av_packet_free(&pkt);
+    if (out_ctx) {
+        if (out_ctx->pb) {
+            avio_closep(&out_ctx->pb);
+        }
+        avformat_free_context(out_ctx);
+    }
+    avformat_close_input(&in_ctx);
+
+    if (stats) {
+        const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - started_at).count();
+        stats->success = success;
+        stats->input_bytes = FileSizeOrZero(input_path);
+        stats->output_bytes = success ? FileSizeOrZero(output_path) : 0;
+        stats->packet_count = packet_count;
+        stats->elapsed_seconds = elapsed;
+        stats->throughput_mb_per_sec = elapsed > 0.0
+            ? static_cast<double>(stats->input_bytes) / (1024.0 * 1024.0) / elapsed
+            : 0.0;
+    }
+
+    return success;
+}
+
+// ==============================================================================
+// 백그라운드 후처리 스레드
+// ==============================================================================
+
+Mp4Finalizer::Mp4Finalizer(CompletionCallback on_complete) : on_complete_(std::move(on_complete)) {
+    worker_ = std::thread(&Mp4Finalizer::WorkerLoop, this);
+}
+
+Mp4Finalizer::~Mp4Finalizer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void Mp4Finalizer::Enqueue(const std::string& path) {
+    Enqueue(path, path);
+}
+
+void Mp4Finalizer::Enqueue(const std::string& input_path, const std::string& output_path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(Job{input_path, output_path, {}});
+    }
+    cv_.notify_one();
+}
+
+void Mp4Finalizer::EnqueueConcat(std::vector<std::string> segment_paths, const std::string& output_path) {
+    if (segment_paths.size() == 1) {
+        Enqueue(segment_paths.front(), output_path);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(Job{std::string(), output_path, std::move(segment_paths)});
+    }
+    cv_.notify_one();
+}
+
+bool Mp4Finalizer::IsBusy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_ || !jobs_.empty();
+}
+
+void Mp4Finalizer::WaitUntilIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return !busy_ && jobs_.empty(); });
+}
+
+Mp4FinalizeStats Mp4Finalizer::GetLastStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_stats_;
+}
+
+void Mp4Finalizer::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_requested_ || !jobs_.empty(); });
+            // 종료 요청이 와도 남은 작업은 모두 처리 (앱 종료 시 파일 상태 보장)
+            if (jobs_.empty()) {
+                break;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            busy_ = true;
+        }
+
+        std::vector<Completion> completions;
+        if (job.segment_paths.empty()) {
+            completions.emplace_back(job.output_path, FinalizeFile(job));
+        } else {
+            ConcatFiles(job, &completions);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_ = false;
+        }
+        idle_cv_.notify_all();
+        // IsBusy가 이미 갱신된 뒤 알림 (수신자가 바로 IsBusy로 남은 작업 확인 가능)
+        if (on_complete_) {
+            for (const Completion& completion : completions) {
+                on_complete_(completion.first, completion.second);
+            }
+        }
+    }
+}
+
+bool Mp4Finalizer::FinalizeFile(const Job& job) {
+    const std::string temp_path = job.output_path + ".faststart.tmp";
+
+    SATREC_LOG_INFO("[Mp4Finalizer] faststart 변환 시작: %s", job.input_path.c_str());
+
+    Mp4FinalizeStats stats;
+    std::string error;
+    bool ok = RemuxToFaststartMp4(job.input_path, temp_path, &stats, &error);
+
+    std::error_code ec;
+    if (ok) {
+        // 결과 파일 확정 (같은 디렉터리 내 rename이므로 추가 복사 없음)
+        std::filesystem::rename(std::filesystem::u8path(temp_path),
+                                std::filesystem::u8path(job.output_path), ec);
+        if (ec) {
+            ok = false;
+            stats.success = false;
+            error = "결과 파일 교체 실패: " + ec.message();
+        } else if (job.input_path != job.output_path) {
+            // 다른 컨테이너(MKV/TS)에서 변환한 경우 원본 삭제
+            std::filesystem::remove(std::filesystem::u8path(job.input_path), ec);
+        }
+    }
+
+    if (ok) {
+        SATREC_LOG_INFO("[Mp4Finalizer] ✅ faststart 완료: %.1fMB, 패킷 %lld개, %.2fs (%.1fMB/s)",
+                        static_cast<double>(stats.input_bytes) / (1024.0 * 1024.0),
+                        static_cast<long long>(stats.packet_count),
+                        stats.elapsed_seconds,
+                        stats.throughput_mb_per_sec);
+    } else {
+        // 실패 시 원본(fragmented MP4)은 그대로 두고 임시 파일만 제거
+        std::filesystem::remove(std::filesystem::u8path(temp_path), ec);
+        SATREC_LOG_WARN("[Mp4Finalizer] ⚠️ faststart 실패, 원본 유지: %s", error.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_stats_ = stats;
+    return ok;
+}
+
+void Mp4Finalizer::ConcatFiles(const Job& job, std::vector<Completion>* completions) {
+    const std::string temp_path = job.output_path + ".concat.tmp";
+
+    SATREC_LOG_INFO("[Mp4Finalizer] 세그먼트 %zu개 이어붙이기 시작: %s",
+                    job.segment_paths.size(), job.output_path.c_str());
+
+    ConcatStats concat_stats;
+    std::string error;
+    bool ok = ConcatSegments(job.segment_paths, temp_path, &concat_stats, &error) == ConcatResult::kOk;
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(std::filesystem::u8path(temp_path),
+                                std::filesystem::u8path(job.output_path), ec);
+        if (ec) {
+            ok = false;
+            error = "결과 파일 교체 실패: " + ec.message();
+            std::filesystem::remove(std::filesystem::u8path(temp_path), ec);
+        }
+    }
+
+    if (ok) {
+        // 결과 파일이 세그먼트 중 하나를 덮어썼을 수 있으므로 그 경로는 지우지 않음
+        for (const std::string& segment : job.segment_paths) {
+            if (segment != job.output_path) {
+                std::filesystem::remove(std::filesystem::u8path(segment), ec);
+            }
+        }
+        Mp4FinalizeStats stats;
+        stats.success = true;
+        stats.input_bytes = concat_stats.input_bytes;
+        stats.output_bytes = concat_stats.output_bytes;
+        stats.packet_count = concat_stats.packet_count;
+        stats.elapsed_seconds = concat_stats.elapsed_seconds;
+        stats.throughput_mb_per_sec = concat_stats.throughput_mb_per_sec;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_stats_ = stats;
+        }
+        completions->emplace_back(job.output_path, true);
+        return;
+    }
+
+    // 이어붙일 수 없으면 세그먼트를 각각 MP4로 남김 (첫 세그먼트는 출력 경로, 이후는 _part<N>)
+    SATREC_LOG_WARN("[Mp4Finalizer] ⚠️ 세그먼트 이어붙이기 실패, 세그먼트별로 변환: %s", error.c_str());
+    const std::wstring base = std::filesystem::u8path(job.output_path).wstring();
+    for (size_t i = 0; i < job.segment_paths.size(); i++) {
+        Job part;
+        part.input_path = job.segment_paths[i];
+        part.output_path = std::filesystem::path(RecordingSegmentPath(base, static_cast<int>(i))).u8string();
+        completions->emplace_back(part.output_path, FinalizeFile(part));
+    }
+}
@@ -0,0 +1,94 @@
+// 녹화 종료 후 MP4 후처리 (faststart remux)
+// Fragmented MP4(empty_moov) / Matroska / MPEG-TS → moov가 앞에 있는 progressive MP4로 변환
+
+#ifndef SAT_LEC_REC_MP4_FINALIZER_H_
+#define SAT_LEC_REC_MP4_FINALIZER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// 입력: 없음
+/// 출력: 마지막 후처리 작업의 크기/시간/처리량 통계
+/// 예외: 없음 (실패 시 success=false)
+struct Mp4FinalizeStats {
+    bool success = false;
+    int64_t input_bytes = 0;       // 원본 파일 크기
+    int64_t output_bytes = 0;      // 결과 파일 크기
+    int64_t packet_count = 0;      // 복사한 패킷 수
+    double elapsed_seconds = 0.0;  // remux + moov 이동까지 걸린 시간
+    double throughput_mb_per_sec = 0.0;  // input_bytes 기준 처리량
+};
+
+/// 입력: 입력/출력 파일 경로 (UTF-8)
+/// 출력: stream copy로 재다중화한 faststart MP4 파일
+/// 예외: 실패 시 false 반환, error에 원인 기록 (출력 파일은 남아 있을 수 있음)
+///
+/// ⚠️ 파일 전체를 메모리에 올리지 않음
+/// - 패킷 단위로 읽고 쓰며, moov 이동은 libavformat이 고정 크기 버퍼로 수행
+bool RemuxToFaststartMp4(const std::string& input_path,
+                         const std::string& output_path,
+                         Mp4FinalizeStats* stats,
+                         std::string* error);
+
+/// 입력: 완료된 녹화 파일 경로 (Enqueue), 인코더 재시작으로 나뉜 세그먼트 목록 (EnqueueConcat)
+/// 출력: 백그라운드 스레드에서 원본을 faststart MP4로 교체 (또는 다른 컨테이너 → MP4 변환, 세그먼트 이어붙이기)
+/// 예외: 변환 실패 시 원본을 그대로 유지 (fragmented MP4/MKV/TS 모두 재생 가능)
+class Mp4Finalizer {
+public:
+    // 작업 1건 완료 알림 (결과 경로 UTF-8, 성공 여부), 후처리 스레드에서 호출
+    using CompletionCallback = std::function<void(const std::string& output_path, bool success)>;
+
+    explicit Mp4Finalizer(CompletionCallback on_complete = nullptr);
+    ~Mp4Finalizer();
+
+    Mp4Finalizer(const Mp4Finalizer&) = delete;
+    Mp4Finalizer& operator=(const Mp4Finalizer&) = delete;
+
+    // 후처리 작업 추가 (즉시 반환)
+    // path를 제자리에서 faststart MP4로 교체
+    void Enqueue(const std::string& path);
+    // input_path를 output_path(MP4)로 변환한 뒤 성공하면 input_path 삭제
+    void Enqueue(const std::string& input_path, const std::string& output_path);
+    // 세그먼트들(재생 순서)을 output_path 하나로 이어붙인 뒤 성공하면 세그먼트 삭제
+    // 이어붙일 수 없으면(코덱 파라미터 불일치 등) 세그먼트마다 <이름>_part<N>.mp4로 변환해 각각 완료 알림
+    void EnqueueConcat(std::vector<std::string> segment_paths, const std::string& output_path);
+
+    // 대기 중이거나 진행 중인 작업이 있는지 여부
+    bool IsBusy() const;
+
+    // 모든 작업이 끝날 때까지 대기
+    void WaitUntilIdle();
+
+    Mp4FinalizeStats GetLastStats() const;
+
+private:
+    struct Job {
+        std::string input_path;
+        std::string output_path;
+        std::vector<std::string> segment_paths;  // 비어 있지 않으면 이어붙이기 작업 (input_path 무시)
+    };
+    using Completion = std::pair<std::string, bool>;  // 결과 경로, 성공 여부
+
+    void WorkerLoop();
+    bool FinalizeFile(const Job& job);
+    void ConcatFiles(const Job& job, std::vector<Completion>* completions);
+
+    CompletionCallback on_complete_;
+    std::thread worker_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::deque<Job> jobs_;
+    bool busy_ = false;
+    bool stop_requested_ = false;
+    Mp4FinalizeStats last_stats_{};
+};
+
+#endif  // SAT_LEC_REC_MP4_FINALIZER_H_
@@ -0,0 +1,431 @@
+// 네이티브 비동기 로거 구현
+
+#include "native_logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+constexpr auto kDrainInterval = std::chrono::milliseconds(100);
+constexpr auto kFlushTimeout = std::chrono::seconds(2);
+
+FILE* OpenFileForAppend(const std::string& path) {
+    FILE* file = nullptr;
+#ifdef _WIN32
+    std::wstring wide_path = std::filesystem::u8path(path).wstring();
+    if (_wfopen_s(&file, wide_path.c_str(), L"ab") != 0) {
+        return nullptr;
+    }
+#else
+    file = fopen(path.c_str(), "ab");
+#endif
+    return file;
+}
+
+void AppendFormatted(std::string* out, const char* format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+    const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) {
+        va_end(retry);
+        return;
+    }
+    if (static_cast<size_t>(length) < sizeof(buffer)) {
+        out->append(buffer, static_cast<size_t>(length));
+    } else {
+        const size_t offset = out->size();
+        out->resize(offset + static_cast<size_t>(length) + 1);
+        vsnprintf(&(*out)[offset], static_cast<size_t>(length) + 1, format, retry);
+        out->resize(offset + static_cast<size_t>(length));
+    }
+    va_end(retry);
+}
+
+bool IsFloatConversion(char conversion) {
+    return strchr("fFeEgGaA", conversion) != nullptr;
+}
+
+// 인자 하나 출력: 저장된 형식에 맞게 length modifier를 다시 붙여 snprintf 호출
+// (printf와 달리 서식/인자 형식이 어긋나도 잘못된 메모리를 읽지 않음)
+void AppendArg(std::string* out, const std::string& spec, char conversion,
+               const LogRecord& record, int index) {
+    const LogRecord::ArgValue& value = record.values[index];
+    switch (record.types[index]) {
+        case LogRecord::ArgType::kString:
+            AppendFormatted(out, (spec + "s").c_str(), record.text + value.text.offset);
+            return;
+        case LogRecord::ArgType::kPointer:
+            AppendFormatted(out, (spec + "p").c_str(), value.p);
+            return;
+        case LogRecord::ArgType::kDouble:
+            if (IsFloatConversion(conversion)) {
+                AppendFormatted(out, (spec + conversion).c_str(), value.d);
+            } else {
+                AppendFormatted(out, (spec + "g").c_str(), value.d);
+            }
+            return;
+        case LogRecord::ArgType::kSigned:
+        case LogRecord::ArgType::kUnsigned:
+            break;
+    }
+
+    // 정수
+    if (IsFloatConversion(conversion)) {
+        AppendFormatted(out, (spec + conversion).c_str(), static_cast<double>(value.i));
+    } else if (conversion == 'c') {
+        AppendFormatted(out, (spec + "c").c_str(), static_cast<int>(value.i));
+    } else if (strchr("uxXo", conversion) != nullptr ||
+               record.types[index] == LogRecord::ArgType::kUnsigned) {
+        // 원래 크기로 잘라 부호 확장 제거 (HRESULT를 %08X로 출력하는 경우 등)
+        uint64_t unsigned_value = value.u;
+        const uint8_t size = record.sizes[index];
+        if (size < 8) {
+            unsigned_value &= (uint64_t{1} << (size * 8)) - 1;
+        }
+        const char unsigned_conversion = strchr("uxXo", conversion) ? conversion : 'u';
+        AppendFormatted(out, (spec + "ll" + unsigned_conversion).c_str(),
+                        static_cast<unsigned long long>(unsigned_value));
+    } else {
+        AppendFormatted(out, (spec + "lld").c_str(), static_cast<long long>(value.i));
+    }
+}
+
+void FormatLogMessage(const LogRecord& record, std::string* out) {
+    int next_arg = 0;
+    const char* p = record.format ? record.format : "";
+    while (*p) {
+        if (*p != '%') {
+            out->push_back(*p++);
+            continue;
+        }
+        if (p[1] == '%') {
+            out->push_back('%');
+            p += 2;
+            continue;
+        }
+
+        // flags / width / precision 유지, length modifier는 저장된 형식 기준으로 다시 붙임
+        std::string spec = "%";
+        p++;
+        while (*p && strchr("-+ #0", *p)) spec.push_back(*p++);
+        while (*p && (isdigit(static_cast<unsigned char>(*p)) || *p == '.')) spec.push_back(*p++);
+        while (*p && strchr("hljztLqI", *p)) {
+            if (p[0] == 'I' && p[1] == '6' && p[2] == '4') {
+                p += 3;
+            } else {
+                p++;
+            }
+        }
+        const char conversion = *p;
+        if (!conversion) break;
+        p++;
+
+        if (next_arg >= record.arg_count) {
+            out->append("<?>");
+            continue;
+        }
+        AppendArg(out, spec, conversion, record, next_arg++);
+    }
+    if (record.truncated) {
+        out->append(" …(생략)");
+    }
+    // 기존 printf 메시지의 줄바꿈은 제거 (한 레코드 = 한 줄)
+    while (!out->empty() && (out->back() == '\n' || out->back() == '\r')) {
+        out->pop_back();
+    }
+}
+
+char LevelLetter(LogLevel level) {
+    switch (level) {
+        case LogLevel::kDebug:   return 'D';
+        case LogLevel::kInfo:    return 'I';
+        case LogLevel::kWarning: return 'W';
+        case LogLevel::kError:   return 'E';
+        default:                 return '?';
+    }
+}
+
+// 한 줄: "HH:MM:SS.mmm I t2 [C++] 메시지"
+void FormatLine(const LogRecord& record, std::string* out) {
+    const time_t seconds = static_cast<time_t>(record.wall_time_us / 1000000);
+    const int millis = static_cast<int>((record.wall_time_us / 1000) % 1000);
+    struct tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    AppendFormatted(out, "%02d:%02d:%02d.%03d %c t%u [native] ",
+                    local.tm_hour, local.tm_min, local.tm_sec, millis,
+                    LevelLetter(record.level), record.thread_id);
+    FormatLogMessage(record, out);
+    out->push_back('\n');
+}
+
+struct PendingLine {
+    int64_t wall_time_us;
+    std::string text;
+};
+
+// 스레드 종료 시 ring buffer를 반환 (다음 스레드가 재사용)
+struct ThreadBufferLease {
+    std::atomic<bool>* in_use = nullptr;
+    void* buffer = nullptr;
+    ~ThreadBufferLease() {
+        if (in_use) in_use->store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadBufferLease t_lease;
+
+}  // namespace
+
+// ==============================================================================
+// 생성 / 설정
+// ==============================================================================
+
+NativeLogger& NativeLogger::Instance() {
+    // 종료 순서 문제를 피하기 위해 해제하지 않음 (detach된 스레드가 종료 중에 로그를 남길 수 있음)
+    static NativeLogger* instance = new NativeLogger();
+    return *instance;
+}
+
+NativeLogger::NativeLogger() {
+    std::thread(&NativeLogger::DrainLoop, this).detach();
+}
+
+void NativeLogger::SetFilePath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    file_path_ = path;
+}
+
+std::string NativeLogger::GetFilePath() const {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    return file_path_;
+}
+
+int64_t NativeLogger::GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    int64_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void NativeLogger::LogStats() {
+    const LatencySummary latency = GetEnqueueLatency();
+    SATREC_LOG_INFO("[NativeLogger] 기록 비용: %lld회, 평균 %lldns, p50 %lldns, p99 %lldns, "
+                    "최대 %lldns, 버림 %lld개",
+                    latency.count, latency.mean_us, latency.p50_us, latency.p99_us,
+                    latency.max_us, GetDroppedCount());
+}
+
+// ==============================================================================
+// 기록 (호출 스레드)
+// ==============================================================================
+
+NativeLogger::ThreadBuffer* NativeLogger::GetThreadBuffer() {
+    if (t_lease.buffer) {
+        return static_cast<ThreadBuffer*>(t_lease.buffer);
+    }
+
+    // 스레드당 1회만 lock (종료된 스레드의 buffer 중 모두 출력된 것이 있으면 재사용)
+    ThreadBuffer* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (auto& candidate : buffers_) {
+            if (candidate->head.load(std::memory_order_relaxed) !=
+                candidate->tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            bool expected = false;
+            if (candidate->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                buffer = candidate.get();
+                break;
+            }
+        }
+        if (!buffer) {
+            buffers_.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers_.back().get();
+            buffer->thread_id = static_cast<uint32_t>(buffers_.size());
+        }
+    }
+    t_lease.buffer = buffer;
+    t_lease.in_use = &buffer->in_use;
+    return buffer;
+}
+
+LogRecord* NativeLogger::BeginRecord(LogLevel level, const char* format) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    const uint32_t head = buffer->head.load(std::memory_order_relaxed);
+    const uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= ThreadBuffer::kCapacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    LogRecord& record = buffer->records[head & (ThreadBuffer::kCapacity - 1)];
+    record.format = format;
+    record.wall_time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.arg_count = 0;
+    record.level = level;
+    record.truncated = false;
+    record.text_used = 0;
+    record.thread_id = buffer->thread_id;
+    return &record;
+}
+
+void NativeLogger::CommitRecord() {
+    ThreadBuffer* buffer = static_cast<ThreadBuffer*>(t_lease.buffer);
+    buffer->head.store(buffer->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void NativeLogger::AddInteger(LogRecord& record, LogRecord::ArgType type, int64_t value, uint8_t size) {
+    if (record.arg_count >= LogRecord::kMaxArgs) {
+        record.truncated = true;
+        return;
+    }
+    const int index = record.arg_count++;
+    record.types[index] = type;
+    record.sizes[index] = size;
+    record.values[index].i = value;
+}
+
+void NativeLogger::AddDouble(LogRecord& record, double value) {
+    if (record.arg_count >= LogRecord::kMaxArgs) {
+        record.truncated = true;
+        return;
+    }
+    const int index = record.arg_count++;
+    record.types[index] = LogRecord::ArgType::kDouble;
+    record.sizes[index] = sizeof(double);
+    record.values[index].d = value;
+}
+
+void NativeLogger::AddPointer(LogRecord& record, const void* value) {
+    if (record.arg_count >= LogRecord::kMaxArgs) {
+        record.truncated = true;
+        return;
+    }
+    const int index = record.arg_count++;
+    record.types[index] = LogRecord::ArgType::kPointer;
+    record.sizes[index] = sizeof(void*);
+    record.values[index].p = value;
+}
+
+void NativeLogger::AddText(LogRecord& record, const char* text) {
+    if (record.arg_count >= LogRecord::kMaxArgs) {
+        record.truncated = true;
+        return;
+    }
+    if (!text) text = "(null)";
+
+    // 남은 공간에 복사 (끝의 '\0' 포함), 넘치면 잘라냄
+    size_t length = strlen(text);
+    const size_t available = LogRecord::kTextCapacity - record.text_used - 1;
+    if (length > available) {
+        length = available;
+        record.truncated = true;
+    }
+    memcpy(record.text + record.text_used, text, length);
+    record.text[record.text_used + length] = '\0';
+
+    const int index = record.arg_count++;
+    record.types[index] = LogRecord::ArgType::kString;
+    record.sizes[index] = 0;
+    record.values[index].text.offset = record.text_used;
+    record.values[index].text.length = static_cast<uint16_t>(length);
+    record.text_used = static_cast<uint16_t>(record.text_used + length + 1);
+}
+
+// ==============================================================================
+// 출력 (drain 스레드)
+// ==============================================================================
+
+void NativeLogger::Flush() {
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    const uint64_t target = ++flush_requested_;
+    wake_requested_ = true;
+    drain_cv_.notify_all();
+    flushed_cv_.wait_for(lock, kFlushTimeout, [this, target] { return flush_completed_ >= target; });
+}
+
+void NativeLogger::DrainLoop() {
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    while (true) {
+        drain_cv_.wait_for(lock, kDrainInterval, [this] { return wake_requested_; });
+        wake_requested_ = false;
+        const uint64_t flush_target = flush_requested_;
+        const std::string path = file_path_;
+        lock.unlock();
+
+        DrainAll(path);
+
+        lock.lock();
+        flush_completed_ = flush_target;
+        flushed_cv_.notify_all();
+    }
+}
+
+void NativeLogger::DrainAll(const std::string& path) {
+    // 등록된 buffer 목록 복사 (buffer 자체는 해제되지 않으므로 포인터 사용 안전)
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers.reserve(buffers_.size());
+        for (auto& buffer : buffers_) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    std::vector<PendingLine> lines;
+    for (ThreadBuffer* buffer : buffers) {
+        const uint32_t head = buffer->head.load(std::memory_order_acquire);
+        uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+        for (; tail != head; tail++) {
+            const LogRecord& record = buffer->records[tail & (ThreadBuffer::kCapacity - 1)];
+            PendingLine line;
+            line.wall_time_us = record.wall_time_us;
+            FormatLine(record, &line.text);
+            lines.push_back(std::move(line));
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+    if (lines.empty()) return;
+
+    // 스레드 간 순서를 시각 기준으로 정렬 (같은 스레드 안의 순서는 유지)
+    std::stable_sort(lines.begin(), lines.end(), [](const PendingLine& a, const PendingLine& b) {
+        return a.wall_time_us < b.wall_time_us;
+    });
+
+    if (console_enabled_.load(std::memory_order_relaxed)) {
+        for (const auto& line : lines) {
+            fwrite(line.text.data(), 1, line.text.size(), stdout);
+        }
+        fflush(stdout);
+    }
+
+    if (!path.empty()) {
+        FILE* file = OpenFileForAppend(path);
+        if (file) {
+            for (const auto& line : lines) {
+                fwrite(line.text.data(), 1, line.text.size(), file);
+            }
+            fclose(file);
+        }
+    }
+    written_records_.fetch_add(static_cast<int64_t>(lines.size()), std::memory_order_relaxed);
+}
@@ -0,0 +1,182 @@
+// 네이티브 비동기 로거
+// 녹화 스레드는 서식 문자열 포인터와 인자 값만 기록하고, 문자열 조립과 출력은 drain 스레드에서 수행
+
+#ifndef SAT_LEC_REC_NATIVE_LOGGER_H_
+#define SAT_LEC_REC_NATIVE_LOGGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "pipeline_stats.h"
+
+enum class LogLevel : uint8_t {
+    kDebug = 0,
+    kInfo = 1,
+    kWarning = 2,
+    kError = 3,
+};
+
+/// 스레드 ring buffer에 저장되는 고정 크기 로그 레코드
+/// - 숫자 인자는 값 그대로, 문자열 인자는 text 영역에 복사 (원본 수명과 무관)
+/// - 서식 문자열은 포인터만 저장하므로 문자열 리터럴이어야 함
+struct LogRecord {
+    static constexpr int kMaxArgs = 12;
+    static constexpr size_t kTextCapacity = 256;
+
+    enum class ArgType : uint8_t { kSigned, kUnsigned, kDouble, kString, kPointer };
+
+    struct TextRange {
+        uint16_t offset;
+        uint16_t length;
+    };
+    union ArgValue {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+        TextRange text;
+    };
+
+    const char* format;
+    int64_t wall_time_us;          // system_clock (로그 파일 시각 표시용)
+    ArgValue values[kMaxArgs];
+    ArgType types[kMaxArgs];
+    uint8_t sizes[kMaxArgs];       // 정수 인자의 원래 크기 (%X 등 부호 없는 출력 시 사용)
+    uint8_t arg_count;
+    LogLevel level;
+    bool truncated;                // 인자 수 또는 문자열 길이 초과로 일부 생략됨
+    uint16_t text_used;
+    uint32_t thread_id;
+    char text[kTextCapacity];
+};
+
+/// 입력: 녹화 스레드를 포함한 모든 네이티브 스레드의 로그 호출
+/// 출력: 콘솔(stdout) + Dart LoggerService와 같은 로그 파일에 한 줄씩 추가
+/// 예외: 파일 쓰기 실패 시 콘솔만 사용 (로그 호출은 실패하지 않음)
+///
+/// ⚠️ 비용 구조
+/// - 호출 스레드: 스레드 전용 ring(SPSC)에 레코드 1개 기록 (lock/할당/파일 I/O 없음)
+/// - ring이 가득 차면 레코드를 버리고 개수만 기록 (녹화 스레드를 막지 않음)
+/// - printf 서식 해석, 시각 변환, 파일 열기/쓰기는 drain 스레드에서 100ms마다 일괄 처리
+/// - 로그 파일은 매 일괄 처리마다 열고 닫음 (Dart 쪽 로테이션(rename)과 충돌하지 않도록)
+class NativeLogger {
+public:
+    static NativeLogger& Instance();
+
+    NativeLogger(const NativeLogger&) = delete;
+    NativeLogger& operator=(const NativeLogger&) = delete;
+
+    // 로그 파일 경로 (UTF-8, 빈 문자열이면 콘솔만)
+    void SetFilePath(const std::string& path);
+    // 인코더 자식 프로세스가 같은 파일에 기록하도록 넘겨줄 때 사용
+    std::string GetFilePath() const;
+    void SetMinLevel(LogLevel level) { min_level_.store(level, std::memory_order_relaxed); }
+    void SetConsoleEnabled(bool enabled) { console_enabled_.store(enabled, std::memory_order_relaxed); }
+
+    // 지금까지 기록된 레코드를 모두 출력할 때까지 대기 (녹화 종료, 앱 종료 시)
+    void Flush();
+
+    template <typename... Args>
+    void Log(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "로그 인자가 너무 많습니다");
+        if (level < min_level_.load(std::memory_order_relaxed)) return;
+
+        const auto started_at = std::chrono::steady_clock::now();
+        LogRecord* record = BeginRecord(level, format);
+        if (record) {
+            (AddArg(*record, args), ...);
+            CommitRecord();
+        }
+        enqueue_latency_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started_at).count());
+    }
+
+    // 호출 스레드 기준 기록 비용 (요약 필드 값 단위: ns)
+    LatencySummary GetEnqueueLatency() const { return enqueue_latency_.Summarize(); }
+    int64_t GetDroppedCount() const;
+    int64_t GetWrittenCount() const { return written_records_.load(std::memory_order_relaxed); }
+
+    // 기록 비용/버림 통계를 로그로 남김 (녹화 세션 종료 시)
+    void LogStats();
+
+private:
+    struct ThreadBuffer {
+        static constexpr uint32_t kCapacity = 512;  // 2의 거듭제곱
+
+        LogRecord records[kCapacity];
+        std::atomic<uint32_t> head{0};   // 다음 쓰기 위치 (생산자)
+        std::atomic<uint32_t> tail{0};   // 다음 읽기 위치 (drain 스레드)
+        std::atomic<int64_t> dropped{0};
+        std::atomic<bool> in_use{true};  // 스레드 종료 시 false → 새 스레드가 재사용
+        uint32_t thread_id = 0;
+    };
+
+    NativeLogger();
+    ~NativeLogger() = default;
+
+    ThreadBuffer* GetThreadBuffer();
+    LogRecord* BeginRecord(LogLevel level, const char* format);
+    void CommitRecord();
+
+    template <typename T>
+    static void AddArg(LogRecord& record, const T& value) {
+        if constexpr (std::is_convertible_v<const T&, const char*>) {
+            AddText(record, value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            AddInteger(record, LogRecord::ArgType::kSigned, value ? 1 : 0, 1);
+        } else if constexpr (std::is_enum_v<T>) {
+            AddInteger(record, LogRecord::ArgType::kSigned,
+                       static_cast<int64_t>(value), static_cast<uint8_t>(sizeof(T)));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            AddInteger(record, LogRecord::ArgType::kSigned,
+                       static_cast<int64_t>(value), static_cast<uint8_t>(sizeof(T)));
+        } else if constexpr (std::is_integral_v<T>) {
+            AddInteger(record, LogRecord::ArgType::kUnsigned,
+                       static_cast<int64_t>(static_cast<uint64_t>(value)), static_cast<uint8_t>(sizeof(T)));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            AddDouble(record, static_cast<double>(value));
+        } else if constexpr (std::is_pointer_v<T>) {
+            AddPointer(record, value);
+        } else {
+            static_assert(std::is_same_v<T, std::string>, "지원하지 않는 로그 인자 형식");
+            AddText(record, value.c_str());
+        }
+    }
+    static void AddInteger(LogRecord& record, LogRecord::ArgType type, int64_t value, uint8_t size);
+    static void AddDouble(LogRecord& record, double value);
+    static void AddPointer(LogRecord& record, const void* value);
+    static void AddText(LogRecord& record, const char* text);
+
+    void DrainLoop();
+    void DrainAll(const std::string& path);
+
+    std::atomic<LogLevel> min_level_{LogLevel::kInfo};
+    std::atomic<bool> console_enabled_{true};
+    LatencyHistogram enqueue_latency_{1};  // ns 단위
+    std::atomic<int64_t> written_records_{0};
+
+    mutable std::mutex registry_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    mutable std::mutex drain_mutex_;
+    std::condition_variable drain_cv_;
+    std::condition_variable flushed_cv_;
+    bool wake_requested_ = false;
+    uint64_t flush_requested_ = 0;
+    uint64_t flush_completed_ = 0;
+    std::string file_path_;              // drain_mutex_로 보호
+};
+
+#define SATREC_LOG_DEBUG(...) NativeLogger::Instance().Log(LogLevel::kDebug, __VA_ARGS__)
+#define SATREC_LOG_INFO(...) NativeLogger::Instance().Log(LogLevel::kInfo, __VA_ARGS__)
+#define SATREC_LOG_WARN(...) NativeLogger::Instance().Log(LogLevel::kWarning, __VA_ARGS__)
+#define SATREC_LOG_ERROR(...) NativeLogger::Instance().Log(LogLevel::kError, __VA_ARGS__)
+
+#endif  // SAT_LEC_REC_NATIVE_LOGGER_H_
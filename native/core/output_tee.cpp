@@ -0,0 +1,370 @@
+// 이중 출력 (primary + secondary) 비동기 파일 기록 구현
+
+#include "output_tee.h"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <utility>
+
+#include "native_logger.h"
+
+namespace {
+
+int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FILE* OpenFileUtf8(const std::string& path) {
+    FILE* file = nullptr;
+#ifdef _WIN32
+    std::wstring wide_path = std::filesystem::u8path(path).wstring();
+    if (_wfopen_s(&file, wide_path.c_str(), L"wb") != 0) {
+        return nullptr;
+    }
+#else
+    file = fopen(path.c_str(), "wb");
+#endif
+    return file;
+}
+
+int SeekFile(FILE* file, int64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, SEEK_SET);
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+}  // namespace
+
+// ==============================================================================
+// FileOutputSink
+// ==============================================================================
+
+std::unique_ptr<FileOutputSink> FileOutputSink::Open(const std::string& path, std::string* error) {
+    FILE* file = OpenFileUtf8(path);
+    if (!file) {
+        if (error) *error = "출력 파일 열기 실패: " + path;
+        return nullptr;
+    }
+    return std::unique_ptr<FileOutputSink>(new FileOutputSink(file));
+}
+
+FileOutputSink::~FileOutputSink() {
+    Close();
+}
+
+bool FileOutputSink::WriteAt(int64_t offset, const uint8_t* data, size_t size, std::string* error) {
+    if (!file_) {
+        if (error) *error = "파일이 닫혀 있음";
+        return false;
+    }
+    // muxer가 헤더를 다시 쓰는 경우(moov/cue 위치 갱신 등)에만 seek 발생
+    if (offset != position_) {
+        if (SeekFile(file_, offset) != 0) {
+            if (error) *error = std::string("seek 실패: ") + strerror(errno);
+            return false;
+        }
+        position_ = offset;
+    }
+    if (fwrite(data, 1, size, file_) != size) {
+        if (error) *error = std::string("쓰기 실패: ") + strerror(errno);
+        return false;
+    }
+    position_ += static_cast<int64_t>(size);
+    return true;
+}
+
+bool FileOutputSink::Flush(std::string* error) {
+    if (file_ && fflush(file_) != 0) {
+        if (error) *error = std::string("flush 실패: ") + strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+void FileOutputSink::Close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+// ==============================================================================
+// AsyncOutputWriter
+// ==============================================================================
+
+// 스레드와 공유하는 상태 (detach된 스레드가 참조할 수 있으므로 shared_ptr로 관리)
+struct AsyncOutputWriter::State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable drained_cv;
+    std::deque<Block> queue;
+    std::unique_ptr<OutputSink> sink;
+    bool close_requested = false;
+    bool writing = false;
+    bool finished = false;  // 스레드가 sink를 닫고 종료함
+    int64_t write_started_ms = 0;
+    OutputDestinationHealth health;
+};
+
+AsyncOutputWriter::AsyncOutputWriter(std::string name, std::unique_ptr<OutputSink> sink,
+                                     const OutputWriterOptions& options)
+    : name_(std::move(name)), options_(options), state_(std::make_shared<State>()) {
+    state_->sink = std::move(sink);
+    state_->health.state = OutputDestinationState::kHealthy;
+    std::thread(&AsyncOutputWriter::WorkerLoop, state_).detach();
+}
+
+AsyncOutputWriter::~AsyncOutputWriter() {
+    Close();
+}
+
+void AsyncOutputWriter::Drop(State& state, OutputDestinationState reason, const std::string& error) {
+    // mutex를 잡은 상태에서 호출
+    if (state.health.state != OutputDestinationState::kHealthy) return;
+    state.health.state = reason;
+    state.health.error = error;
+    state.health.queued_bytes = 0;
+    state.queue.clear();
+    state.cv.notify_all();
+    state.drained_cv.notify_all();
+}
+
+bool AsyncOutputWriter::Submit(int64_t offset, const uint8_t* data, size_t size) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    State& state = *state_;
+    if (state.health.state != OutputDestinationState::kHealthy || state.close_requested) {
+        return false;
+    }
+
+    // 멈춤 판단: 진행 중인 쓰기가 너무 오래 걸리거나 큐가 한도를 넘음
+    if (state.writing && NowMs() - state.write_started_ms > options_.stall_timeout_ms) {
+        Drop(state, OutputDestinationState::kStalled,
+             "쓰기 지연 " + std::to_string(NowMs() - state.write_started_ms) + "ms");
+        return false;
+    }
+    if (state.health.queued_bytes + static_cast<int64_t>(size) > options_.max_queued_bytes) {
+        Drop(state, OutputDestinationState::kStalled,
+             "큐 한도 초과 (" + std::to_string(state.health.queued_bytes) + " bytes)");
+        return false;
+    }
+
+    Block block;
+    block.offset = offset;
+    block.data.assign(data, data + size);
+    state.queue.push_back(std::move(block));
+    state.health.queued_bytes += static_cast<int64_t>(size);
+    state.cv.notify_one();
+    return true;
+}
+
+void AsyncOutputWriter::WorkerLoop(std::shared_ptr<State> state_ptr) {
+    State& state = *state_ptr;
+    std::unique_lock<std::mutex> lock(state.mutex);
+
+    while (true) {
+        state.cv.wait(lock, [&state] {
+            return !state.queue.empty() || state.close_requested ||
+                   state.health.state != OutputDestinationState::kHealthy;
+        });
+        if (state.health.state != OutputDestinationState::kHealthy) break;
+        if (state.queue.empty()) {
+            // close_requested && 큐 비어 있음 → 마지막 flush
+            std::string error;
+            state.writing = true;
+            state.write_started_ms = NowMs();
+            lock.unlock();
+            bool ok = state.sink->Flush(&error);
+            lock.lock();
+            state.writing = false;
+            if (!ok) {
+                Drop(state, OutputDestinationState::kFailed, error);
+            }
+            break;
+        }
+
+        Block block = std::move(state.queue.front());
+        state.queue.pop_front();
+        state.writing = true;
+        state.write_started_ms = NowMs();
+        lock.unlock();
+
+        // sink 호출은 잠금 없이 수행 (멈춘 디스크가 Submit을 막지 않도록)
+        std::string error;
+        bool ok = state.sink->WriteAt(block.offset, block.data.data(), block.data.size(), &error);
+        const int64_t elapsed_ms = NowMs() - state.write_started_ms;
+
+        lock.lock();
+        state.writing = false;
+        if (state.health.state != OutputDestinationState::kHealthy) break;  // 쓰는 동안 분리됨
+        if (!ok) {
+            Drop(state, OutputDestinationState::kFailed, error);
+            break;
+        }
+        const int64_t size = static_cast<int64_t>(block.data.size());
+        state.health.bytes_written += size;
+        state.health.queued_bytes -= size;
+        if (elapsed_ms > state.health.max_write_ms) {
+            state.health.max_write_ms = elapsed_ms;
+        }
+        if (state.queue.empty()) {
+            state.drained_cv.notify_all();
+        }
+    }
+
+    // 파일 핸들까지 닫은 뒤 종료 알림 (Close 직후 후처리가 파일을 열 수 있도록)
+    std::unique_ptr<OutputSink> sink = std::move(state.sink);
+    lock.unlock();
+    if (sink) {
+        sink->Close();
+    }
+    lock.lock();
+    state.finished = true;
+    state.drained_cv.notify_all();
+}
+
+void AsyncOutputWriter::Close() {
+    if (closed_) return;
+    closed_ = true;
+
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    State& state = *state_;
+    state.close_requested = true;
+    state.cv.notify_all();
+
+    // 스레드가 sink를 닫을 때까지 대기 (멈춘 경우 분리하고 스레드는 남겨둠)
+    // 이미 분리된 대상은 기다리지 않음
+    const bool finished = state.drained_cv.wait_for(
+        lock, std::chrono::milliseconds(options_.close_timeout_ms),
+        [&state] {
+            return state.finished || state.health.state != OutputDestinationState::kHealthy;
+        });
+    if (!finished) {
+        Drop(state, OutputDestinationState::kStalled, "종료 시 남은 큐 기록 시간 초과");
+    }
+}
+
+bool AsyncOutputWriter::IsHealthy() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->health.state == OutputDestinationState::kHealthy;
+}
+
+OutputDestinationHealth AsyncOutputWriter::GetHealth() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->health;
+}
+
+// ==============================================================================
+// OutputTee
+// ==============================================================================
+
+OutputTee::~OutputTee() {
+    Close();
+}
+
+void OutputTee::AddDestination(std::string name, std::unique_ptr<OutputSink> sink,
+                               const OutputWriterOptions& options) {
+    writers_.push_back(std::make_unique<AsyncOutputWriter>(std::move(name), std::move(sink), options));
+    last_states_.push_back(OutputDestinationState::kHealthy);
+}
+
+bool OutputTee::Open(std::string* error) {
+    if (writers_.empty()) {
+        if (error) *error = "출력 대상이 없습니다";
+        return false;
+    }
+
+    constexpr int kBufferSize = 256 * 1024;
+    auto* buffer = static_cast<unsigned char*>(av_malloc(kBufferSize));
+    if (!buffer) {
+        if (error) *error = "AVIO 버퍼 할당 실패";
+        return false;
+    }
+    avio_ctx_ = avio_alloc_context(buffer, kBufferSize, 1, this, nullptr,
+                                   &OutputTee::WritePacket, &OutputTee::Seek);
+    if (!avio_ctx_) {
+        av_free(buffer);
+        if (error) *error = "AVIOContext 생성 실패";
+        return false;
+    }
+    // 대상별로 offset을 따라가므로 muxer의 seek(헤더 재작성)도 그대로 지원
+    avio_ctx_->seekable = AVIO_SEEKABLE_NORMAL;
+    return true;
+}
+
+void OutputTee::Close() {
+    if (avio_ctx_) {
+        avio_flush(avio_ctx_);
+        av_freep(&avio_ctx_->buffer);
+        avio_context_free(&avio_ctx_);
+    }
+    for (auto& writer : writers_) {
+        writer->Close();
+    }
+}
+
+OutputDestinationHealth OutputTee::GetHealth(size_t index) const {
+    if (index >= writers_.size()) {
+        return OutputDestinationHealth();
+    }
+    return writers_[index]->GetHealth();
+}
+
+int OutputTee::WritePacket(void* opaque, const uint8_t* buf, int buf_size) {
+    auto* self = static_cast<OutputTee*>(opaque);
+
+    bool any_healthy = false;
+    for (size_t i = 0; i < self->writers_.size(); i++) {
+        AsyncOutputWriter& writer = *self->writers_[i];
+        if (writer.Submit(self->position_, buf, static_cast<size_t>(buf_size))) {
+            any_healthy = true;
+            continue;
+        }
+        // 분리된 대상은 한 번만 로그 (나머지 대상은 계속 기록)
+        if (self->last_states_[i] == OutputDestinationState::kHealthy) {
+            const OutputDestinationHealth health = writer.GetHealth();
+            self->last_states_[i] = health.state;
+            SATREC_LOG_WARN("[OutputTee] ⚠️ 출력 대상 분리: %s (%s)",
+                            writer.GetName().c_str(), health.error.c_str());
+        }
+    }
+
+    if (!any_healthy) {
+        return AVERROR(EIO);
+    }
+    self->position_ += buf_size;
+    if (self->position_ > self->size_) {
+        self->size_ = self->position_;
+    }
+    return buf_size;
+}
+
+int64_t OutputTee::Seek(void* opaque, int64_t offset, int whence) {
+    auto* self = static_cast<OutputTee*>(opaque);
+
+    int64_t target = 0;
+    switch (whence & ~AVSEEK_FORCE) {
+        case AVSEEK_SIZE:
+            return self->size_;
+        case SEEK_SET:
+            target = offset;
+            break;
+        case SEEK_CUR:
+            target = self->position_ + offset;
+            break;
+        case SEEK_END:
+            target = self->size_ + offset;
+            break;
+        default:
+            return AVERROR(EINVAL);
+    }
+    if (target < 0) {
+        return AVERROR(EINVAL);
+    }
+    self->position_ = target;
+    return target;
+}
@@ -0,0 +1,155 @@
+// 이중 출력 (primary + secondary) 비동기 파일 기록
+// muxer 출력 바이트를 대상별 큐/스레드로 복제하고, 멈추거나 실패한 대상만 분리
+
+#ifndef SAT_LEC_REC_OUTPUT_TEE_H_
+#define SAT_LEC_REC_OUTPUT_TEE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+/// 입력: 파일 오프셋과 바이트 블록
+/// 출력: 실제 저장소에 기록 (파일, 또는 장애 주입용 구현)
+/// 예외: 실패 시 false 반환, error에 원인 기록 (이후 호출되지 않음)
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    virtual bool WriteAt(int64_t offset, const uint8_t* data, size_t size, std::string* error) = 0;
+    virtual bool Flush(std::string* error) = 0;
+    virtual void Close() = 0;
+};
+
+/// 입력: 출력 파일 경로 (UTF-8)
+/// 출력: 일반 파일에 기록하는 OutputSink
+/// 예외: 파일 열기 실패 시 Open()이 nullptr 반환
+class FileOutputSink : public OutputSink {
+public:
+    static std::unique_ptr<FileOutputSink> Open(const std::string& path, std::string* error);
+    ~FileOutputSink() override;
+
+    bool WriteAt(int64_t offset, const uint8_t* data, size_t size, std::string* error) override;
+    bool Flush(std::string* error) override;
+    void Close() override;
+
+private:
+    explicit FileOutputSink(FILE* file) : file_(file) {}
+
+    FILE* file_ = nullptr;
+    int64_t position_ = 0;
+};
+
+/// 출력 대상 상태 (FFI 값과 동일)
+enum class OutputDestinationState {
+    kInactive = 0,  // 사용하지 않음
+    kHealthy = 1,
+    kStalled = 2,   // 큐 초과 또는 쓰기 지연으로 분리됨
+    kFailed = 3,    // 쓰기 오류(디스크 부족 등)로 분리됨
+};
+
+/// 입력: 없음
+/// 출력: 출력 대상 하나의 상태/통계 스냅샷
+/// 예외: 없음
+struct OutputDestinationHealth {
+    OutputDestinationState state = OutputDestinationState::kInactive;
+    int64_t bytes_written = 0;   // sink까지 기록 완료된 바이트
+    int64_t queued_bytes = 0;    // 큐에서 대기 중인 바이트
+    int64_t max_write_ms = 0;    // 가장 오래 걸린 단일 쓰기
+    std::string error;           // 분리 원인
+};
+
+/// 대상별 큐 한도 (어느 하나라도 넘으면 해당 대상을 분리)
+struct OutputWriterOptions {
+    int64_t max_queued_bytes = 64LL * 1024 * 1024;  // 64MB (1080p 기준 약 1분 분량)
+    int stall_timeout_ms = 3000;                     // 단일 쓰기가 이보다 오래 걸리면 멈춤으로 판단
+    int close_timeout_ms = 10000;                    // Close 시 남은 큐 기록 대기 한도
+};
+
+/// 입력: OutputSink, 대상 이름 (로그용)
+/// 출력: 전용 스레드에서 큐에 쌓인 블록을 순서대로 기록
+/// 예외: 없음 (상태는 GetHealth()로 확인)
+///
+/// ⚠️ 분리된 대상의 스레드가 쓰기 호출에 묶여 있으면 Close()에서 detach
+/// - 스레드는 공유 상태만 참조하므로 AsyncOutputWriter가 먼저 파괴되어도 안전
+class AsyncOutputWriter {
+public:
+    AsyncOutputWriter(std::string name, std::unique_ptr<OutputSink> sink,
+                      const OutputWriterOptions& options);
+    ~AsyncOutputWriter();
+
+    AsyncOutputWriter(const AsyncOutputWriter&) = delete;
+    AsyncOutputWriter& operator=(const AsyncOutputWriter&) = delete;
+
+    // 블록 추가 (복사 후 즉시 반환). 대상이 분리되었으면 false
+    bool Submit(int64_t offset, const uint8_t* data, size_t size);
+
+    // 남은 큐를 기록하고 sink 닫기 (close_timeout_ms 초과 시 멈춤으로 분리)
+    void Close();
+
+    bool IsHealthy() const;
+    OutputDestinationHealth GetHealth() const;
+    const std::string& GetName() const { return name_; }
+
+private:
+    struct Block {
+        int64_t offset = 0;
+        std::vector<uint8_t> data;
+    };
+    struct State;
+
+    static void WorkerLoop(std::shared_ptr<State> state);
+    static void Drop(State& state, OutputDestinationState reason, const std::string& error);
+
+    std::string name_;
+    OutputWriterOptions options_;
+    std::shared_ptr<State> state_;
+    bool closed_ = false;
+};
+
+/// 입력: 출력 대상 목록 (첫 번째가 primary)
+/// 출력: muxer용 AVIOContext (쓰기/seek를 모든 정상 대상에 복제)
+/// 예외: 모든 대상이 분리되면 쓰기가 AVERROR(EIO) 반환 → 인코더가 실패 처리
+class OutputTee {
+public:
+    OutputTee() = default;
+    ~OutputTee();
+
+    OutputTee(const OutputTee&) = delete;
+    OutputTee& operator=(const OutputTee&) = delete;
+
+    // 대상 추가 (Open 전에 호출)
+    void AddDestination(std::string name, std::unique_ptr<OutputSink> sink,
+                        const OutputWriterOptions& options = OutputWriterOptions());
+
+    // AVIOContext 생성 (format_ctx->pb에 연결, AVFMT_FLAG_CUSTOM_IO 필요)
+    bool Open(std::string* error);
+    AVIOContext* GetAvioContext() const { return avio_ctx_; }
+
+    // avio 버퍼 flush 후 모든 대상 Close, AVIOContext 해제
+    void Close();
+
+    size_t GetDestinationCount() const { return writers_.size(); }
+    OutputDestinationHealth GetHealth(size_t index) const;
+
+private:
+    static int WritePacket(void* opaque, const uint8_t* buf, int buf_size);
+    static int64_t Seek(void* opaque, int64_t offset, int whence);
+
+    std::vector<std::unique_ptr<AsyncOutputWriter>> writers_;
+    std::vector<OutputDestinationState> last_states_;  // 분리 로그 중복 방지
+    AVIOContext* avio_ctx_ = nullptr;
+    int64_t position_ = 0;  // muxer 기준 현재 위치
+    int64_t size_ = 0;      // 지금까지 쓴 가장 먼 위치 (AVSEEK_SIZE 응답)
+};
+
+#endif  // SAT_LEC_REC_OUTPUT_TEE_H_
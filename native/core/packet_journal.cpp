@@ -0,0 +1,462 @@
+// 인코딩된 패킷 저널 구현
+
+#include "packet_journal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#include "native_logger.h"
+
+extern "C" {
+#include <libavutil/crc.h>
+#include <libavutil/intreadwrite.h>
+}
+
+namespace {
+
+constexpr char kJournalMagic[4] = {'S', 'L', 'R', 'J'};
+constexpr uint32_t kRecordSync = 0x50524C53;  // "SLRP"
+constexpr size_t kRecordHeaderSize = 44;
+constexpr uint32_t kMaxPayloadSize = 64 * 1024 * 1024;  // 손상된 길이 필드 방어용
+
+std::string AvErrorToString(int errnum) {
+    char err_buf[128];
+    av_strerror(errnum, err_buf, sizeof(err_buf));
+    return std::string(err_buf);
+}
+
+// UTF-8 경로로 파일 열기 (Windows는 wide 경로 필요)
+FILE* OpenFileUtf8(const std::string& path, const char* mode) {
+#if defined(_WIN32)
+    std::wstring wide_mode(mode, mode + strlen(mode));
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, std::filesystem::u8path(path).wstring().c_str(), wide_mode.c_str()) != 0) {
+        return nullptr;
+    }
+    return file;
+#else
+    return fopen(path.c_str(), mode);
+#endif
+}
+
+// 2GB 이상 파일에서도 동작하는 현재 위치 조회
+int64_t TellPosition(FILE* file) {
+#if defined(_WIN32)
+    return _ftelli64(file);
+#else
+    return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+uint32_t Crc32(const uint8_t* data, size_t size) {
+    return av_crc(av_crc_get_table(AV_CRC_32_IEEE_LE), UINT32_MAX, data, size) ^ UINT32_MAX;
+}
+
+// 정수는 호스트 바이트 순서와 관계없이 little-endian으로 기록/해석 (다른 PC에서 복구 가능)
+void PutU32(std::vector<uint8_t>& buf, uint32_t value) {
+    uint8_t bytes[4];
+    AV_WL32(bytes, value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+void PutI32(std::vector<uint8_t>& buf, int32_t value) {
+    PutU32(buf, static_cast<uint32_t>(value));
+}
+
+void PutI64(std::vector<uint8_t>& buf, int64_t value) {
+    uint8_t bytes[8];
+    AV_WL64(bytes, static_cast<uint64_t>(value));
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+bool ReadExact(FILE* file, void* data, size_t size) {
+    return fread(data, 1, size, file) == size;
+}
+
+bool ReadU32(FILE* file, uint32_t* value) {
+    uint8_t bytes[4];
+    if (!ReadExact(file, bytes, sizeof(bytes))) return false;
+    *value = AV_RL32(bytes);
+    return true;
+}
+
+bool ReadI32(FILE* file, int32_t* value) {
+    uint32_t raw = 0;
+    if (!ReadU32(file, &raw)) return false;
+    *value = static_cast<int32_t>(raw);
+    return true;
+}
+
+bool ReadI64(FILE* file, int64_t* value) {
+    uint8_t bytes[8];
+    if (!ReadExact(file, bytes, sizeof(bytes))) return false;
+    *value = static_cast<int64_t>(AV_RL64(bytes));
+    return true;
+}
+
+}  // namespace
+
+// ==============================================================================
+// 저널 기록
+// ==============================================================================
+
+PacketJournalWriter::~PacketJournalWriter() {
+    Close();
+}
+
+bool PacketJournalWriter::Open(const std::string& path,
+                               const AVFormatContext* format_ctx,
+                               int flush_interval_ms) {
+    Close();
+
+    file_ = OpenFileUtf8(path, "wb");
+    if (!file_) {
+        return false;
+    }
+
+    path_ = path;
+    flush_interval_ = std::chrono::milliseconds(flush_interval_ms);
+    last_flush_ = std::chrono::steady_clock::now();
+    stats_ = PacketJournalStats{};
+
+    // 파일 헤더 + 스트림 정보 (avformat_write_header 이후의 stream time_base 기준)
+    std::vector<uint8_t> header;
+    header.insert(header.end(), kJournalMagic, kJournalMagic + sizeof(kJournalMagic));
+    PutU32(header, kPacketJournalVersion);
+    PutU32(header, format_ctx->nb_streams);
+
+    for (unsigned int i = 0; i < format_ctx->nb_streams; i++) {
+        const AVStream* stream = format_ctx->streams[i];
+        const AVCodecParameters* par = stream->codecpar;
+        PutI32(header, par->codec_type);
+        PutI32(header, par->codec_id);
+        PutI32(header, stream->time_base.num);
+        PutI32(header, stream->time_base.den);
+        PutI32(header, par->width);
+        PutI32(header, par->height);
+        PutI32(header, par->format);
+        PutI32(header, par->sample_rate);
+        PutI32(header, par->ch_layout.nb_channels);
+        PutI32(header, par->frame_size);
+        PutI64(header, par->bit_rate);
+        PutU32(header, static_cast<uint32_t>(par->extradata_size));
+        if (par->extradata_size > 0) {
+            header.insert(header.end(), par->extradata, par->extradata + par->extradata_size);
+        }
+    }
+
+    if (!WriteBytes(header.data(), header.size())) {
+        Close();
+        return false;
+    }
+    Flush();
+    return true;
+}
+
+bool PacketJournalWriter::Append(const AVPacket* pkt) {
+    if (!file_ || !pkt) {
+        return false;
+    }
+
+    const auto started_at = std::chrono::steady_clock::now();
+
+    uint8_t record[kRecordHeaderSize];
+    const uint32_t payload_size = static_cast<uint32_t>(pkt->size);
+    const uint32_t stream_index = static_cast<uint32_t>(pkt->stream_index);
+    const uint32_t flags = static_cast<uint32_t>(pkt->flags);
+    const uint32_t crc = Crc32(pkt->data, pkt->size);
+    AV_WL32(record + 0, kRecordSync);
+    AV_WL32(record + 4, payload_size);
+    AV_WL32(record + 8, stream_index);
+    AV_WL32(record + 12, flags);
+    AV_WL64(record + 16, static_cast<uint64_t>(pkt->pts));
+    AV_WL64(record + 24, static_cast<uint64_t>(pkt->dts));
+    AV_WL64(record + 32, static_cast<uint64_t>(pkt->duration));
+    AV_WL32(record + 40, crc);
+
+    bool ok = WriteBytes(record, sizeof(record)) &&
+              (payload_size == 0 || WriteBytes(pkt->data, payload_size));
+    if (ok) {
+        stats_.packet_count++;
+    }
+
+    // 주기적으로 OS 캐시까지 flush (앱 크래시 시에도 남도록)
+    if (started_at - last_flush_ >= flush_interval_) {
+        Flush();
+    }
+
+    stats_.write_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started_at).count();
+    return ok;
+}
+
+void PacketJournalWriter::Flush() {
+    if (!file_) return;
+    fflush(file_);
+    stats_.flush_count++;
+    last_flush_ = std::chrono::steady_clock::now();
+}
+
+void PacketJournalWriter::Close() {
+    if (!file_) return;
+    fflush(file_);
+    fclose(file_);
+    file_ = nullptr;
+}
+
+bool PacketJournalWriter::WriteBytes(const void* data, size_t size) {
+    if (fwrite(data, 1, size, file_) != size) {
+        return false;
+    }
+    stats_.bytes_written += static_cast<int64_t>(size);
+    return true;
+}
+
+// ==============================================================================
+// 저널 복구
+// ==============================================================================
+
+bool RecoverFromJournal(const std::string& journal_path,
+                        const std::string& output_path,
+                        JournalRecoveryStats* stats,
+                        std::string* error) {
+    const auto started_at = std::chrono::steady_clock::now();
+    JournalRecoveryStats local_stats;
+
+    auto fail = [&](const std::string& message) {
+        if (error) *error = message;
+    };
+
+    FILE* file = OpenFileUtf8(journal_path, "rb");
+    if (!file) {
+        fail("저널 파일 열기 실패: " + journal_path);
+        return false;
+    }
+
+    {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(std::filesystem::u8path(journal_path), ec);
+        local_stats.journal_bytes = ec ? 0 : static_cast<int64_t>(size);
+    }
+
+    AVFormatContext* out_ctx = nullptr;
+    AVPacket* pkt = nullptr;
+    bool success = false;
+    std::vector<int64_t> stream_end;
+
+    do {
+        // 1. 파일 헤더 검증
+        char magic[4];
+        uint32_t version = 0;
+        uint32_t stream_count = 0;
+        if (!ReadExact(file, magic, sizeof(magic)) ||
+            memcmp(magic, kJournalMagic, sizeof(magic)) != 0 ||
+            !ReadU32(file, &version) || !ReadU32(file, &stream_count)) {
+            fail("저널 헤더가 손상되었습니다");
+            break;
+        }
+        if (version != kPacketJournalVersion || stream_count == 0 || stream_count > 16) {
+            fail("지원하지 않는 저널 버전/스트림 수");
+            break;
+        }
+
+        int ret = avformat_alloc_output_context2(&out_ctx, nullptr, "mp4", output_path.c_str());
+        if (ret < 0 || !out_ctx) {
+            fail("출력 컨텍스트 생성 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        // 2. 스트림 정보 복원
+        bool header_ok = true;
+        for (uint32_t i = 0; i < stream_count && header_ok; i++) {
+            int32_t codec_type = 0, codec_id = 0, tb_num = 0, tb_den = 0;
+            int32_t width = 0, height = 0, format = 0, sample_rate = 0;
+            int32_t channels = 0, frame_size = 0;
+            int64_t bit_rate = 0;
+            uint32_t extradata_size = 0;
+            header_ok = ReadI32(file, &codec_type) && ReadI32(file, &codec_id) &&
+                        ReadI32(file, &tb_num) && ReadI32(file, &tb_den) &&
+                        ReadI32(file, &width) && ReadI32(file, &height) &&
+                        ReadI32(file, &format) && ReadI32(file, &sample_rate) &&
+                        ReadI32(file, &channels) && ReadI32(file, &frame_size) &&
+                        ReadI64(file, &bit_rate) && ReadU32(file, &extradata_size) &&
+                        extradata_size <= kMaxPayloadSize && tb_num > 0 && tb_den > 0;
+            if (!header_ok) break;
+
+            AVStream* stream = avformat_new_stream(out_ctx, nullptr);
+            if (!stream) {
+                header_ok = false;
+                break;
+            }
+            AVCodecParameters* par = stream->codecpar;
+            par->codec_type = static_cast<AVMediaType>(codec_type);
+            par->codec_id = static_cast<AVCodecID>(codec_id);
+            par->width = width;
+            par->height = height;
+            par->format = format;
+            par->sample_rate = sample_rate;
+            par->frame_size = frame_size;
+            par->bit_rate = bit_rate;
+            if (channels > 0) {
+                av_channel_layout_default(&par->ch_layout, channels);
+            }
+            if (extradata_size > 0) {
+                par->extradata = static_cast<uint8_t*>(
+                    av_mallocz(extradata_size + AV_INPUT_BUFFER_PADDING_SIZE));
+                if (!par->extradata || !ReadExact(file, par->extradata, extradata_size)) {
+                    header_ok = false;
+                    break;
+                }
+                par->extradata_size = static_cast<int>(extradata_size);
+            }
+            stream->time_base = AVRational{tb_num, tb_den};
+        }
+        if (!header_ok) {
+            fail("저널 스트림 정보가 손상되었습니다");
+            break;
+        }
+
+        // avformat_write_header가 time_base를 바꿀 수 있으므로 원래 값을 보관
+        std::vector<AVRational> journal_time_base(out_ctx->nb_streams);
+        for (unsigned int i = 0; i < out_ctx->nb_streams; i++) {
+            journal_time_base[i] = out_ctx->streams[i]->time_base;
+        }
+        stream_end.assign(out_ctx->nb_streams, 0);
+
+        ret = avio_open(&out_ctx->pb, output_path.c_str(), AVIO_FLAG_WRITE);
+        if (ret < 0) {
+            fail("출력 파일 열기 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        AVDictionary* mux_options = nullptr;
+        av_dict_set(&mux_options, "movflags", "+faststart", 0);
+        ret = avformat_write_header(out_ctx, &mux_options);
+        av_dict_free(&mux_options);
+        if (ret < 0) {
+            fail("avformat_write_header 실패: " + AvErrorToString(ret));
+            break;
+        }
+
+        pkt = av_packet_alloc();
+        if (!pkt) {
+            fail("AVPacket 할당 실패");
+            break;
+        }
+
+        // 3. 레코드 복사 (잘리거나 CRC가 맞지 않는 레코드에서 중단)
+        local_stats.recovered_bytes = TellPosition(file);
+        bool write_error = false;
+        while (true) {
+            uint8_t record[kRecordHeaderSize];
+            size_t got = fread(record, 1, sizeof(record), file);
+            if (got == 0) {
+                break;  // 정상적인 파일 끝
+            }
+            if (got != sizeof(record)) {
+                local_stats.truncated_tail = true;
+                break;
+            }
+
+            const uint32_t sync = AV_RL32(record + 0);
+            const uint32_t payload_size = AV_RL32(record + 4);
+            const uint32_t stream_index = AV_RL32(record + 8);
+            const uint32_t flags = AV_RL32(record + 12);
+            const int64_t pts = static_cast<int64_t>(AV_RL64(record + 16));
+            const int64_t dts = static_cast<int64_t>(AV_RL64(record + 24));
+            const int64_t duration = static_cast<int64_t>(AV_RL64(record + 32));
+            const uint32_t crc = AV_RL32(record + 40);
+
+            if (sync != kRecordSync || payload_size > kMaxPayloadSize ||
+                stream_index >= out_ctx->nb_streams) {
+                local_stats.truncated_tail = true;
+                break;
+            }
+
+            if (av_new_packet(pkt, static_cast<int>(payload_size)) < 0) {
+                fail("패킷 버퍼 할당 실패");
+                write_error = true;
+                break;
+            }
+            if (!ReadExact(file, pkt->data, payload_size) ||
+                Crc32(pkt->data, payload_size) != crc) {
+                av_packet_unref(pkt);
+                local_stats.truncated_tail = true;
+                break;
+            }
+
+            pkt->stream_index = static_cast<int>(stream_index);
+            pkt->flags = static_cast<int>(flags);
+            pkt->pts = pts;
+            pkt->dts = dts;
+            pkt->duration = duration;
+
+            AVStream* out_stream = out_ctx->streams[stream_index];
+            if (dts != AV_NOPTS_VALUE) {
+                stream_end[stream_index] = av_rescale_q(dts + duration,
+                                                        journal_time_base[stream_index],
+                                                        AV_TIME_BASE_Q);
+            }
+            av_packet_rescale_ts(pkt, journal_time_base[stream_index], out_stream->time_base);
+
+            ret = av_interleaved_write_frame(out_ctx, pkt);
+            if (ret < 0) {
+                fail("av_interleaved_write_frame 실패: " + AvErrorToString(ret));
+                write_error = true;
+                break;
+            }
+            local_stats.packet_count++;
+            local_stats.recovered_bytes = TellPosition(file);
+        }
+        if (write_error) break;
+
+        if (local_stats.packet_count == 0) {
+            fail("복구할 패킷이 없습니다");
+            break;
+        }
+
+        ret = av_write_trailer(out_ctx);
+        if (ret < 0) {
+            fail("av_write_trailer 실패: " + AvErrorToString(ret));
+            break;
+        }
+        success = true;
+    } while (false);
+
+    av_packet_free(&pkt);
+    if (out_ctx) {
+        if (out_ctx->pb) {
+            avio_closep(&out_ctx->pb);
+        }
+        avformat_free_context(out_ctx);
+    }
+    fclose(file);
+
+    for (int64_t end_us : stream_end) {
+        local_stats.recovered_duration_seconds =
+            std::max(local_stats.recovered_duration_seconds,
+                     static_cast<double>(end_us) / AV_TIME_BASE);
+    }
+    local_stats.elapsed_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started_at).count();
+    if (local_stats.journal_bytes > 0) {
+        local_stats.seconds_per_gb = local_stats.elapsed_seconds /
+            (static_cast<double>(local_stats.journal_bytes) / (1024.0 * 1024.0 * 1024.0));
+    }
+
+    SATREC_LOG_INFO("[PacketJournal] %s 저널 복구: 패킷 %lld개, %.1fs 분량, %.2fs (%.1fs/GB)%s",
+                    success ? "✅" : "❌",
+                    static_cast<long long>(local_stats.packet_count),
+                    local_stats.recovered_duration_seconds,
+                    local_stats.elapsed_seconds,
+                    local_stats.seconds_per_gb,
+                    local_stats.truncated_tail ? ", 잘린 마지막 레코드 제외" : "");
+
+    if (stats) {
+        *stats = local_stats;
+    }
+    return success;
+}
@@ -0,0 +1,90 @@
+// 인코딩된 패킷 저널 (append-only, 크래시 복구용)
+// MP4와 나란히 기록하여 비정상 종료 시 마지막 완전한 패킷까지 복구
+
+#ifndef SAT_LEC_REC_PACKET_JOURNAL_H_
+#define SAT_LEC_REC_PACKET_JOURNAL_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+// 저널 파일 구조 (모든 정수는 호스트 바이트 순서와 관계없이 little-endian)
+//
+//   [파일 헤더]  magic "SLRJ" | version u32 | stream_count u32
+//   [스트림 정보] stream_count × (codec 파라미터 + time_base + extradata)
+//   [레코드]     sync u32 | payload_size u32 | stream_index u32 | flags u32 |
+//                pts i64 | dts i64 | duration i64 | crc32 u32 | payload
+//
+// 레코드는 append-only로만 추가되므로, 잘린 파일도 마지막 완전한 레코드까지는 유효함
+constexpr uint32_t kPacketJournalVersion = 1;
+
+/// 입력: 없음
+/// 출력: 저널 기록 오버헤드 통계 (Close 시점 기준)
+/// 예외: 없음
+struct PacketJournalStats {
+    int64_t packet_count = 0;
+    int64_t bytes_written = 0;     // 헤더 + 레코드 전체
+    int64_t flush_count = 0;
+    int64_t write_time_ns = 0;     // Append/Flush에 소비한 시간 (인코더 스레드 기준)
+};
+
+/// 입력: 헤더까지 작성된 AVFormatContext, 인코딩된 AVPacket (stream time_base 기준)
+/// 출력: append-only 저널 파일
+/// 예외: 쓰기 실패 시 false 반환 (녹화 자체는 계속 진행 가능)
+class PacketJournalWriter {
+public:
+    PacketJournalWriter() = default;
+    ~PacketJournalWriter();
+
+    PacketJournalWriter(const PacketJournalWriter&) = delete;
+    PacketJournalWriter& operator=(const PacketJournalWriter&) = delete;
+
+    // flush_interval_ms: fflush 주기 (OS 캐시까지만 내려보내므로 저렴함)
+    bool Open(const std::string& path, const AVFormatContext* format_ctx,
+              int flush_interval_ms = 200);
+    bool Append(const AVPacket* pkt);
+    void Flush();
+    void Close();
+
+    bool IsOpen() const { return file_ != nullptr; }
+    const std::string& GetPath() const { return path_; }
+    PacketJournalStats GetStats() const { return stats_; }
+
+private:
+    bool WriteBytes(const void* data, size_t size);
+
+    FILE* file_ = nullptr;
+    std::string path_;
+    std::chrono::milliseconds flush_interval_{200};
+    std::chrono::steady_clock::time_point last_flush_{};
+    PacketJournalStats stats_{};
+};
+
+/// 입력: 없음
+/// 출력: 저널 복구 결과 통계
+/// 예외: 없음
+struct JournalRecoveryStats {
+    int64_t packet_count = 0;
+    int64_t journal_bytes = 0;
+    int64_t recovered_bytes = 0;       // 유효한 레코드가 끝나는 위치
+    bool truncated_tail = false;       // 마지막 레코드가 잘려 있었는지 여부
+    double recovered_duration_seconds = 0.0;
+    double elapsed_seconds = 0.0;
+    double seconds_per_gb = 0.0;       // 저널 1GB당 복구 시간
+};
+
+/// 입력: 저널 경로, 출력 MP4 경로 (UTF-8)
+/// 출력: 마지막 완전한 패킷까지 담은 faststart MP4
+/// 예외: 헤더 손상/입출력 실패 시 false 반환, error에 원인 기록
+bool RecoverFromJournal(const std::string& journal_path,
+                        const std::string& output_path,
+                        JournalRecoveryStats* stats,
+                        std::string* error);
+
+#endif  // SAT_LEC_REC_PACKET_JOURNAL_H_
@@ -0,0 +1,211 @@
+// 녹화 파이프라인 단계별 지연 시간 통계 구현
+
+#include "pipeline_stats.h"
+
+#include <cstdio>
+#include <iterator>
+#include <limits>
+
+#include "native_logger.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+int HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+}  // namespace
+
+// ==============================================================================
+// LatencyHistogram
+// ==============================================================================
+
+int LatencyHistogram::BucketIndex(uint64_t units) {
+    if (units < static_cast<uint64_t>(kSubBucketCount)) {
+        return static_cast<int>(units);
+    }
+    int exponent = HighestBit(units);
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    const int shift = exponent - kSubBucketBits;
+    const int sub_bucket = static_cast<int>(units >> shift) - kSubBucketCount;
+    return (shift + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+    if (index < kSubBucketCount) {
+        return static_cast<uint64_t>(index);
+    }
+    const int shift = index / kSubBucketCount - 1;
+    const uint64_t sub_bucket = static_cast<uint64_t>(index % kSubBucketCount);
+    return ((static_cast<uint64_t>(kSubBucketCount) + sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t nanoseconds) {
+    if (nanoseconds < 0) nanoseconds = 0;
+
+    const uint64_t units = static_cast<uint64_t>(nanoseconds / unit_ns_);
+    buckets_[BucketIndex(units)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    int64_t current = min_ns_.load(std::memory_order_relaxed);
+    while (nanoseconds < current &&
+           !min_ns_.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+    current = max_ns_.load(std::memory_order_relaxed);
+    while (nanoseconds > current &&
+           !max_ns_.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_ns_.store(0, std::memory_order_relaxed);
+    min_ns_.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+LatencySummary LatencyHistogram::Summarize() const {
+    LatencySummary summary;
+    const int64_t count = count_.load(std::memory_order_relaxed);
+    if (count <= 0) {
+        return summary;
+    }
+
+    summary.count = count;
+    summary.min_us = min_ns_.load(std::memory_order_relaxed) / unit_ns_;
+    summary.max_us = max_ns_.load(std::memory_order_relaxed) / unit_ns_;
+    summary.mean_us = sum_ns_.load(std::memory_order_relaxed) / count / unit_ns_;
+
+    // 퍼센타일: 누적 카운트가 목표를 넘는 버킷의 상한값 (max로 제한)
+    struct Target {
+        double quantile;
+        int64_t* out;
+    };
+    Target targets[] = {
+        {0.50, &summary.p50_us},
+        {0.90, &summary.p90_us},
+        {0.99, &summary.p99_us},
+        {0.999, &summary.p999_us},
+    };
+
+    int64_t cumulative = 0;
+    size_t next = 0;
+    for (int i = 0; i < kBucketCount && next < std::size(targets); i++) {
+        cumulative += static_cast<int64_t>(buckets_[i].load(std::memory_order_relaxed));
+        while (next < std::size(targets) &&
+               static_cast<double>(cumulative) >= targets[next].quantile * static_cast<double>(count)) {
+            const int64_t bound = static_cast<int64_t>(BucketUpperBound(i));
+            *targets[next].out = bound < summary.max_us ? bound : summary.max_us;
+            next++;
+        }
+    }
+    // 동시 기록으로 합계가 어긋난 경우
+    for (; next < std::size(targets); next++) {
+        *targets[next].out = summary.max_us;
+    }
+    return summary;
+}
+
+// ==============================================================================
+// PipelineStats
+// ==============================================================================
+
+void PipelineStats::Reset() {
+    for (auto& histogram : histograms_) {
+        histogram.Reset();
+    }
+
+    // 계측 비용 보정: 실제 호출 경로(now + Record)를 임시 히스토그램에 반복 기록
+    constexpr int kCalibrationRounds = 4096;
+    LatencyHistogram scratch;
+    const auto started_at = Clock::now();
+    for (int i = 0; i < kCalibrationRounds; i++) {
+        const auto t = Clock::now();
+        scratch.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t).count());
+    }
+    const int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - started_at).count();
+    record_cost_ns_.store(elapsed_ns / kCalibrationRounds, std::memory_order_relaxed);
+
+    session_started_at_ = Clock::now();
+}
+
+void PipelineStats::Record(PipelineStage stage, int64_t nanoseconds) {
+    const size_t index = static_cast<size_t>(stage);
+    if (index >= histograms_.size()) return;
+    histograms_[index].Record(nanoseconds);
+}
+
+LatencySummary PipelineStats::Summarize(PipelineStage stage) const {
+    const size_t index = static_cast<size_t>(stage);
+    if (index >= histograms_.size()) return LatencySummary();
+    return histograms_[index].Summarize();
+}
+
+int64_t PipelineStats::GetSampleCount() const {
+    int64_t total = 0;
+    for (const auto& histogram : histograms_) {
+        total += histogram.Summarize().count;
+    }
+    return total;
+}
+
+const char* PipelineStats::StageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::kCapture:     return "capture";
+        case PipelineStage::kVideoQueue:  return "video_queue";
+        case PipelineStage::kConvert:     return "convert";
+        case PipelineStage::kVideoEncode: return "video_encode";
+        case PipelineStage::kMux:         return "mux";
+        case PipelineStage::kVideoTotal:  return "video_total";
+        case PipelineStage::kAudioQueue:  return "audio_queue";
+        case PipelineStage::kAudioEncode: return "audio_encode";
+        default:                          return "unknown";
+    }
+}
+
+void PipelineStats::LogSummary() const {
+    SATREC_LOG_INFO("[PipelineStats] 단계별 지연 시간 (µs)");
+    SATREC_LOG_INFO("[PipelineStats] %-13s %9s %8s %8s %8s %8s %8s %8s",
+                    "stage", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (size_t i = 0; i < histograms_.size(); i++) {
+        const auto stage = static_cast<PipelineStage>(i);
+        const LatencySummary s = histograms_[i].Summarize();
+        if (s.count == 0) continue;
+        SATREC_LOG_INFO("[PipelineStats] %-13s %9lld %8lld %8lld %8lld %8lld %8lld %8lld",
+                        StageName(stage),
+                        static_cast<long long>(s.count),
+                        static_cast<long long>(s.mean_us),
+                        static_cast<long long>(s.p50_us),
+                        static_cast<long long>(s.p90_us),
+                        static_cast<long long>(s.p99_us),
+                        static_cast<long long>(s.p999_us),
+                        static_cast<long long>(s.max_us));
+    }
+
+    // 계측 오버헤드 추정 (측정 1회당 now() 2회 + Record 1회 기준)
+    const double session_seconds = std::chrono::duration<double>(
+        Clock::now() - session_started_at_).count();
+    const double overhead_ms = static_cast<double>(GetSampleCount()) *
+                               static_cast<double>(GetRecordCostNs()) / 1e6;
+    SATREC_LOG_INFO("[PipelineStats] 계측 비용: 측정당 %lldns, 합계 %.1fms (세션의 %.4f%%)",
+                    static_cast<long long>(GetRecordCostNs()),
+                    overhead_ms,
+                    session_seconds > 0.0 ? overhead_ms / (session_seconds * 1000.0) * 100.0 : 0.0);
+}
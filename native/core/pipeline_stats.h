@@ -0,0 +1,113 @@
+// 녹화 파이프라인 단계별 지연 시간 통계
+// 캡처 → 큐 → 변환 → 인코딩 → mux 각 단계를 lock-free 히스토그램으로 집계
+
+#ifndef SAT_LEC_REC_PIPELINE_STATS_H_
+#define SAT_LEC_REC_PIPELINE_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// 측정 단계 (FFI 구조체 배열 순서와 동일, 끝에만 추가할 것)
+enum class PipelineStage {
+    kCapture = 0,       // 캡처된 텍스처 복사 + CPU 메모리 읽기 (Map/memcpy)
+    kVideoQueue = 1,    // 비디오 큐 대기 (Enqueue → Dequeue)
+    kConvert = 2,       // BGRA → YUV420P 변환 (sws_scale)
+    kVideoEncode = 3,   // avcodec_send_frame (비디오)
+    kMux = 4,           // av_interleaved_write_frame (비디오 + 오디오 패킷)
+    kVideoTotal = 5,    // 캡처 시점 → 인코딩/mux 완료
+    kAudioQueue = 6,    // 오디오 큐 대기
+    kAudioEncode = 7,   // avcodec_send_frame (오디오)
+    kCount = 8,
+};
+
+/// 입력: 없음
+/// 출력: 히스토그램 요약 (마이크로초 단위, 단위를 지정한 히스토그램은 그 단위)
+/// 예외: 없음
+struct LatencySummary {
+    int64_t count = 0;
+    int64_t min_us = 0;
+    int64_t mean_us = 0;
+    int64_t p50_us = 0;
+    int64_t p90_us = 0;
+    int64_t p99_us = 0;
+    int64_t p999_us = 0;
+    int64_t max_us = 0;
+};
+
+/// 입력: 지연 시간 (나노초)
+/// 출력: HDR 방식(log-linear) 버킷 카운트, 퍼센타일 요약
+/// 예외: 없음
+///
+/// - 2의 거듭제곱 구간마다 16개의 선형 하위 버킷 → 상대 오차 약 6%
+/// - 1µs ~ 2^37µs(약 38시간) 범위, 넘는 값은 마지막 버킷에 기록
+/// - Record는 relaxed atomic 연산만 사용 (여러 스레드에서 동시 호출 가능)
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxExponent = 36;  // 최상위 비트 위치 한도 (µs 기준)
+    static constexpr int kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+    LatencyHistogram() : LatencyHistogram(1000) {}
+    // unit_ns: 버킷/요약 값의 단위 (기본 µs, 1이면 ns 단위로 집계)
+    explicit LatencyHistogram(int64_t unit_ns) : unit_ns_(unit_ns > 0 ? unit_ns : 1) { Reset(); }
+
+    void Record(int64_t nanoseconds);
+    void Reset();
+
+    // 기록 중에도 호출 가능 (약간의 불일치는 허용)
+    LatencySummary Summarize() const;
+
+private:
+    static int BucketIndex(uint64_t units);
+    static uint64_t BucketUpperBound(int index);
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<int64_t> count_{0};
+    std::atomic<int64_t> sum_ns_{0};
+    std::atomic<int64_t> min_ns_{0};
+    std::atomic<int64_t> max_ns_{0};
+    int64_t unit_ns_;
+};
+
+/// 입력: 단계별 지연 시간 기록 (캡처/오디오/인코더 스레드)
+/// 출력: 단계별 요약, 세션 종료 시 로그
+/// 예외: 없음
+class PipelineStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PipelineStats() = default;
+
+    PipelineStats(const PipelineStats&) = delete;
+    PipelineStats& operator=(const PipelineStats&) = delete;
+
+    // 새 녹화 세션 시작 시 호출 (측정 오버헤드 보정 포함)
+    void Reset();
+
+    void Record(PipelineStage stage, int64_t nanoseconds);
+    void RecordSince(PipelineStage stage, Clock::time_point started_at) {
+        Record(stage, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - started_at).count());
+    }
+
+    LatencySummary Summarize(PipelineStage stage) const;
+
+    // 측정 1회당 비용 (Clock::now + Record, Reset 시점에 측정)
+    int64_t GetRecordCostNs() const { return record_cost_ns_.load(std::memory_order_relaxed); }
+    int64_t GetSampleCount() const;
+
+    // 세션 요약 로그 (단계별 퍼센타일 + 계측 오버헤드 추정치)
+    void LogSummary() const;
+
+    static const char* StageName(PipelineStage stage);
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(PipelineStage::kCount)> histograms_;
+    std::atomic<int64_t> record_cost_ns_{0};
+    Clock::time_point session_started_at_{};
+};
+
+#endif  // SAT_LEC_REC_PIPELINE_STATS_H_
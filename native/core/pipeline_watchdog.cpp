@@ -0,0 +1,109 @@
+// 녹화 파이프라인 감시 구현
+
+#include "pipeline_watchdog.h"
+
+const char* WatchedStageName(WatchedStage stage) {
+    switch (stage) {
+        case WatchedStage::kCapture: return "capture";
+        case WatchedStage::kAudio: return "audio";
+        case WatchedStage::kEncoder: return "encoder";
+        case WatchedStage::kCount: break;
+    }
+    return "unknown";
+}
+
+void PipelineWatchdog::Reset(const PipelineWatchdogConfig& config, const MediaClock* clock, uint64_t now) {
+    config_ = config;
+    clock_ = clock ? clock : &SystemMediaClock::Instance();
+    for (size_t i = 0; i < stages_.size(); i++) {
+        stages_[i] = StageState();
+        heartbeats_[i].beat_tick_.store(now, std::memory_order_relaxed);
+        heartbeats_[i].restarted_tick_.store(0, std::memory_order_relaxed);
+        heartbeats_[i].fault_.store(false, std::memory_order_relaxed);
+        heartbeats_[i].restart_requested_.store(false, std::memory_order_release);
+    }
+}
+
+void PipelineWatchdog::Enable(WatchedStage stage) {
+    stages_[Index(stage)].enabled = true;
+}
+
+WatchdogAction PipelineWatchdog::OnStalled(size_t index, uint64_t now, int64_t* value) {
+    StageState& state = stages_[index];
+    StageHeartbeat& heartbeat = heartbeats_[index];
+    state.stats.stalls++;
+    if (state.stats.restarts >= config_.max_restarts) {
+        state.mode = Mode::kFailed;
+        state.stats.failed = true;
+        heartbeat.restart_requested_.store(false, std::memory_order_release);
+        *value = state.stats.restarts;
+        return WatchdogAction::kGaveUp;
+    }
+    state.stats.restarts++;
+    state.mode = Mode::kRestarting;
+    state.detect_tick = now;
+    state.pending_tick = now;
+    // 요청 전에 쌓인 오류 표시는 이번 재시작으로 처리됨
+    heartbeat.fault_.store(false, std::memory_order_relaxed);
+    heartbeat.restart_requested_.store(true, std::memory_order_release);
+    *value = clock_->ElapsedNs(heartbeat.beat_tick_.load(std::memory_order_acquire), now) / 1000000;
+    return WatchdogAction::kRestartRequested;
+}
+
+int PipelineWatchdog::Check(uint64_t now, WatchdogAction* actions, int64_t* values) {
+    const int64_t deadline_ns = config_.stall_deadline_ms * 1000000LL;
+    const int64_t unresponsive_ns = (config_.unresponsive_deadline_ms > 0 ? config_.unresponsive_deadline_ms
+                                                                          : config_.stall_deadline_ms * 5) *
+                                    1000000LL;
+    int count = 0;
+    for (size_t i = 0; i < stages_.size(); i++) {
+        actions[i] = WatchdogAction::kNone;
+        values[i] = 0;
+        StageState& state = stages_[i];
+        if (!state.enabled || state.mode == Mode::kFailed) continue;
+        StageHeartbeat& heartbeat = heartbeats_[i];
+        const uint64_t beat = heartbeat.beat_tick_.load(std::memory_order_acquire);
+
+        if (state.mode == Mode::kHealthy) {
+            const bool fault = heartbeat.fault_.exchange(false, std::memory_order_acq_rel);
+            if (fault || clock_->ElapsedNs(beat, now) >= deadline_ns) {
+                actions[i] = OnStalled(i, now, &values[i]);
+            }
+        } else if (heartbeat.restart_requested_.load(std::memory_order_acquire)) {
+            // 요청을 아직 가져가지 않음: 스레드가 호출 안에서 멈춰 있으므로 재시작 횟수를 늘리지 않고 기다림
+            state.pending_tick = now;
+            const int64_t waited_ns = clock_->ElapsedNs(state.detect_tick, now);
+            if (waited_ns >= unresponsive_ns) {
+                state.mode = Mode::kFailed;
+                state.stats.failed = true;
+                state.stats.unresponsive = true;
+                heartbeat.restart_requested_.store(false, std::memory_order_release);
+                actions[i] = WatchdogAction::kUnresponsive;
+                values[i] = waited_ns / 1000000;
+            }
+        } else {
+            // 재시작 대기: 재시작을 마친 뒤의 Beat면 복구, 재시작 후 오류나 기한 초과면 다시 정체
+            const uint64_t restarted = heartbeat.restarted_tick_.load(std::memory_order_acquire);
+            const bool restarted_since = restarted > state.detect_tick;
+            const bool fault = restarted_since && heartbeat.fault_.exchange(false, std::memory_order_acq_rel);
+            if (!fault && restarted_since && beat > restarted) {
+                const int64_t recovery_ms = clock_->ElapsedNs(state.detect_tick, beat) / 1000000;
+                state.mode = Mode::kHealthy;
+                state.stats.recoveries++;
+                state.stats.last_recovery_ms = recovery_ms;
+                state.stats.total_recovery_ms += recovery_ms;
+                if (recovery_ms > state.stats.max_recovery_ms) state.stats.max_recovery_ms = recovery_ms;
+                actions[i] = WatchdogAction::kRecovered;
+                values[i] = recovery_ms;
+            } else if (fault || clock_->ElapsedNs(state.pending_tick, now) >= deadline_ns) {
+                actions[i] = OnStalled(i, now, &values[i]);
+            }
+        }
+        if (actions[i] != WatchdogAction::kNone) count++;
+    }
+    return count;
+}
+
+WatchdogStageStats PipelineWatchdog::GetStats(WatchedStage stage) const {
+    return stages_[Index(stage)].stats;
+}
@@ -0,0 +1,141 @@
+// 녹화 파이프라인 감시 (단계별 heartbeat → 정체 감지 → 그 단계만 재시작 요청)
+// 캡처/오디오/인코더 스레드가 heartbeat를 남기고, 감시 스레드가 기한 안에 갱신되지 않은 단계를 찾음
+// 재시작은 요청만 하고 실제 작업(소스 재시작, 인코더 새 세그먼트)은 각 단계 스레드가 다음 반복에서 수행
+// 호출 안에서 돌아오지 않는 스레드는 요청을 가져가지 못하므로 제자리에서 살릴 수 없음 → 응답 없음으로 포기
+
+#ifndef SAT_LEC_REC_PIPELINE_WATCHDOG_H_
+#define SAT_LEC_REC_PIPELINE_WATCHDOG_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "media_clock.h"
+
+/// 감시 대상 단계 (pipeline_stats.h의 PipelineStage와 달리 스레드 단위)
+enum class WatchedStage {
+    kCapture = 0,  // 캡처 스레드 (비디오 소스)
+    kAudio = 1,    // 오디오 스레드 (오디오 소스)
+    kEncoder = 2,  // 인코더 스레드 (in-process 인코딩만, 자식 프로세스는 EncoderProcess가 감시)
+    kCount = 3,
+};
+
+// 로그/이벤트용 단계 이름 (capture, audio, encoder)
+const char* WatchedStageName(WatchedStage stage);
+
+/// 입력: 단계 스레드의 Beat/ReportFault/RestartDone, 감시 스레드의 재시작 요청
+/// 출력: 마지막 정상 진행 시각, 재시작 요청 플래그
+/// 예외: 없음
+///
+/// 모든 함수는 relaxed/acquire-release atomic 연산만 사용 (단계 스레드의 반복마다 호출해도 부담 없음)
+class StageHeartbeat {
+public:
+    // 정상 진행 (처리 1건 완료, 또는 처리할 것이 없어 대기 중) - tick은 파이프라인 MediaClock 기준
+    void Beat(uint64_t tick) { beat_tick_.store(tick, std::memory_order_release); }
+    // 복구가 필요한 오류 (장치 무효화, 인코딩 실패, 재시작 실패) → 기한을 기다리지 않고 다음 확인에서 정체 처리
+    void ReportFault() { fault_.store(true, std::memory_order_release); }
+    // 감시 스레드의 재시작 요청을 가져감 (단계 스레드, 요청이 있으면 true 후 재시작 수행)
+    bool TakeRestartRequest() {
+        return restart_requested_.load(std::memory_order_relaxed) &&
+               restart_requested_.exchange(false, std::memory_order_acq_rel);
+    }
+    // 재시작 성공 (이후 Beat가 오면 복구 완료로 봄), 실패하면 ReportFault
+    void RestartDone(uint64_t tick) { restarted_tick_.store(tick, std::memory_order_release); }
+
+private:
+    friend class PipelineWatchdog;
+
+    std::atomic<uint64_t> beat_tick_{0};
+    std::atomic<uint64_t> restarted_tick_{0};
+    std::atomic<bool> fault_{false};
+    std::atomic<bool> restart_requested_{false};
+};
+
+/// 입력: 없음
+/// 출력: 감시 설정
+/// 예외: 없음
+struct PipelineWatchdogConfig {
+    // heartbeat가 이 시간 동안 갱신되지 않으면 정체 (재시작 후 같은 시간 안에 회복하지 않아도 다시 정체)
+    int64_t stall_deadline_ms = 2000;
+    // 단계별 재시작 한도 (넘으면 복구 실패 → 파이프라인이 오류로 녹화 종료)
+    int max_restarts = 3;
+    // 재시작 요청을 이 시간 동안 가져가지 않으면 응답 없음 (0이면 stall_deadline_ms × 5)
+    // 가져가지 않은 요청은 재시작 횟수에 세지 않음 (잠깐 멈췄다 돌아오는 스레드는 한 번만 재시작)
+    int64_t unresponsive_deadline_ms = 0;
+};
+
+/// 입력: 없음
+/// 출력: 단계 하나의 감시 통계 (Reset 전까지 누적)
+/// 예외: 없음
+struct WatchdogStageStats {
+    int64_t stalls = 0;             // 정체/오류 감지 횟수
+    int64_t restarts = 0;           // 재시작 요청 횟수
+    int64_t recoveries = 0;         // 재시작 후 정상 진행 재개
+    int64_t last_recovery_ms = 0;   // 감지 → 재개 (마지막)
+    int64_t max_recovery_ms = 0;
+    int64_t total_recovery_ms = 0;
+    bool failed = false;            // 재시작 한도 초과 또는 응답 없음
+    bool unresponsive = false;      // 재시작 요청을 기한 안에 가져가지 않음 (스레드가 호출 안에서 멈춤)
+};
+
+/// Check 결과 (단계별)
+enum class WatchdogAction {
+    kNone = 0,
+    kRestartRequested = 1,  // 정체/오류 감지 → 재시작 요청 (value: 마지막 heartbeat 이후 ms)
+    kRecovered = 2,         // 재시작 후 진행 재개 (value: 감지 → 재개 ms)
+    kGaveUp = 3,            // 재시작 한도 초과 (value: 재시작 횟수)
+    kUnresponsive = 4,      // 재시작 요청을 가져가지 않음, 제자리 재시작 불가 (value: 요청 후 ms)
+};
+
+/// 입력: 단계별 StageHeartbeat (단계 스레드가 갱신), 감시 스레드의 주기적 Check
+/// 출력: 단계별 조치 (재시작 요청/복구/포기/응답 없음), 감시 통계
+/// 예외: 없음
+///
+/// Reset/Enable/Check는 한 스레드(감시 스레드, 또는 그 스레드 시작 전/종료 후의 파이프라인)에서만 호출
+/// 단계 상태: 정상 → (정체) → 재시작 대기 → (재시작 후 Beat) → 정상
+/// 재시작 후 다시 기한을 넘기면 재시작 횟수 추가, 요청을 가져가지 않은 채 unresponsive_deadline_ms가 지나면 응답 없음
+/// 재시작은 단계 스레드가 스스로 하므로 감시는 멈춘 스레드를 대신 교체하지 못함 (인코더는 프로세스 격리 모드로 대비)
+class PipelineWatchdog {
+public:
+    PipelineWatchdog() = default;
+
+    PipelineWatchdog(const PipelineWatchdog&) = delete;
+    PipelineWatchdog& operator=(const PipelineWatchdog&) = delete;
+
+    // 모든 단계를 감시 해제 + 통계 초기화 (now: 단계별 heartbeat 초기값)
+    void Reset(const PipelineWatchdogConfig& config, const MediaClock* clock, uint64_t now);
+    // 단계 감시 시작 (해당 스레드를 띄우기 직전에 호출)
+    void Enable(WatchedStage stage);
+    bool IsEnabled(WatchedStage stage) const { return stages_[Index(stage)].enabled; }
+
+    StageHeartbeat& heartbeat(WatchedStage stage) { return heartbeats_[Index(stage)]; }
+
+    // 모든 단계 확인, actions/values에 단계별 결과 (배열 크기 WatchedStage::kCount)
+    // 반환: kNone이 아닌 결과 수
+    int Check(uint64_t now, WatchdogAction* actions, int64_t* values);
+
+    WatchdogStageStats GetStats(WatchedStage stage) const;
+
+private:
+    enum class Mode { kHealthy, kRestarting, kFailed };
+
+    struct StageState {
+        bool enabled = false;
+        Mode mode = Mode::kHealthy;
+        uint64_t detect_tick = 0;   // 마지막 정체 감지 (재시작 요청) 시각
+        uint64_t pending_tick = 0;  // 요청이 마지막으로 대기 중이던 확인 시각 (재시작 기한은 가져간 뒤부터)
+        WatchdogStageStats stats;
+    };
+
+    static size_t Index(WatchedStage stage) { return static_cast<size_t>(stage); }
+    // 정체 처리: 한도 안이면 재시작 요청, 넘으면 포기
+    WatchdogAction OnStalled(size_t index, uint64_t now, int64_t* value);
+
+    PipelineWatchdogConfig config_;
+    const MediaClock* clock_ = &SystemMediaClock::Instance();
+    std::array<StageHeartbeat, static_cast<size_t>(WatchedStage::kCount)> heartbeats_;
+    std::array<StageState, static_cast<size_t>(WatchedStage::kCount)> stages_;
+};
+
+#endif  // SAT_LEC_REC_PIPELINE_WATCHDOG_H_
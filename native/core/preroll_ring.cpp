@@ -0,0 +1,115 @@
+// 인코딩된 패킷 pre-roll 링 구현
+
+#include "preroll_ring.h"
+
+#include <algorithm>
+
+extern "C" {
+#include <libavutil/avutil.h>
+#include <libavutil/mathematics.h>
+}
+
+PreRollRing::PreRollRing(PreRollLimits limits) : limits_(limits) {}
+
+PreRollRing::~PreRollRing() {
+    Clear();
+}
+
+bool PreRollRing::Push(AVPacket* pkt, AVRational time_base, bool is_video) {
+    AVPacket* copy = av_packet_alloc();
+    if (!copy) return false;
+    av_packet_move_ref(copy, pkt);
+
+    Entry entry;
+    entry.packet = copy;
+    entry.time_us = copy->pts == AV_NOPTS_VALUE
+        ? (entries_.empty() ? 0 : entries_.back().time_us)
+        : av_rescale_q(copy->pts, time_base, AV_TIME_BASE_Q);
+    entry.is_video = is_video;
+    entry.keyframe = is_video && (copy->flags & AV_PKT_FLAG_KEY) != 0;
+    bytes_ += static_cast<size_t>(copy->size);
+    entries_.push_back(entry);
+
+    Evict();
+    return true;
+}
+
+void PreRollRing::Evict() {
+    const int64_t max_duration_us = limits_.max_duration_ms * 1000;
+    while (!entries_.empty()) {
+        const int64_t newest_us = entries_.back().time_us;
+        const bool over_duration = newest_us - entries_.front().time_us > max_duration_us;
+        const bool over_bytes = bytes_ > limits_.max_bytes;
+        if (!over_duration && !over_bytes) return;
+
+        // 맨 앞 이후의 첫 비디오 키프레임까지 버려야 남은 패킷이 키프레임으로 시작함
+        // (다음 키프레임이 아직 없으면 현재 GOP가 끝날 때까지 한도를 넘긴 채로 유지)
+        size_t next_key = 1;
+        while (next_key < entries_.size() && !entries_[next_key].keyframe) {
+            next_key++;
+        }
+        if (next_key >= entries_.size()) return;
+        DropFront(next_key);
+    }
+}
+
+void PreRollRing::DropFront(size_t count) {
+    for (size_t i = 0; i < count && !entries_.empty(); i++) {
+        Entry& entry = entries_.front();
+        bytes_ -= static_cast<size_t>(entry.packet->size);
+        evicted_bytes_ += entry.packet->size;
+        evicted_packets_++;
+        av_packet_free(&entry.packet);
+        entries_.pop_front();
+    }
+}
+
+bool PreRollRing::TakeFrom(int64_t commit_us, std::vector<AVPacket*>* out, int64_t* start_us) {
+    // commit_us 이하인 마지막 키프레임 (없으면 첫 키프레임)
+    size_t start = entries_.size();
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (!entries_[i].keyframe) continue;
+        if (start == entries_.size() || entries_[i].time_us <= commit_us) {
+            start = i;
+        }
+        if (entries_[i].time_us > commit_us) break;
+    }
+    if (start == entries_.size()) return false;
+
+    const int64_t key_us = entries_[start].time_us;
+    out->reserve(out->size() + entries_.size() - start);
+    for (size_t i = 0; i < entries_.size(); i++) {
+        Entry& entry = entries_[i];
+        // 키프레임 이전 패킷, 키프레임보다 이른 오디오는 파일 시작 전이므로 버림
+        if (i < start || (!entry.is_video && entry.time_us < key_us)) {
+            av_packet_free(&entry.packet);
+            continue;
+        }
+        out->push_back(entry.packet);
+        entry.packet = nullptr;
+    }
+    entries_.clear();
+    bytes_ = 0;
+    *start_us = key_us;
+    return true;
+}
+
+void PreRollRing::Clear() {
+    for (Entry& entry : entries_) {
+        av_packet_free(&entry.packet);
+    }
+    entries_.clear();
+    bytes_ = 0;
+}
+
+PreRollRingStats PreRollRing::GetStats() const {
+    PreRollRingStats stats;
+    stats.packet_count = entries_.size();
+    stats.bytes = bytes_;
+    if (!entries_.empty()) {
+        stats.duration_ms = std::max<int64_t>(0, entries_.back().time_us - entries_.front().time_us) / 1000;
+    }
+    stats.evicted_packets = evicted_packets_;
+    stats.evicted_bytes = evicted_bytes_;
+    return stats;
+}
@@ -0,0 +1,83 @@
+// 인코딩된 패킷 pre-roll 링 (메모리 전용)
+// 녹화를 미리 켜 둔 동안 압축 패킷만 길이/바이트 한도 안에서 보관하고,
+// 커밋 시점 직전 키프레임부터 재인코딩 없이 파일로 넘김
+
+#ifndef SAT_LEC_REC_PREROLL_RING_H_
+#define SAT_LEC_REC_PREROLL_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+/// 입력: 없음
+/// 출력: pre-roll 링 한도 (둘 중 먼저 넘는 쪽 기준으로 오래된 GOP부터 버림)
+/// 예외: 없음
+struct PreRollLimits {
+    int64_t max_duration_ms = 30000;
+    size_t max_bytes = 64 * 1024 * 1024;
+};
+
+/// 입력: 없음
+/// 출력: 링 상태 / 누적 통계
+/// 예외: 없음
+struct PreRollRingStats {
+    size_t packet_count = 0;
+    size_t bytes = 0;
+    int64_t duration_ms = 0;       // 가장 오래된 패킷 ~ 가장 최근 패킷
+    int64_t evicted_packets = 0;   // 한도 초과로 버린 패킷 (누적)
+    int64_t evicted_bytes = 0;
+};
+
+/// 입력: 인코더에서 받은 AVPacket (codec time_base 기준, stream_index 설정됨)
+/// 출력: 비디오 키프레임으로 시작하는 패킷 목록 (TakeFrom)
+/// 예외: 없음 (패킷 복사 실패 시 Push가 false)
+///
+/// 항상 비디오 키프레임 경계(GOP 단위)로만 버리므로 남은 패킷은 언제나 디코딩 가능한 상태
+/// 인코더 스레드 전용 (스레드 안전하지 않음)
+class PreRollRing {
+public:
+    explicit PreRollRing(PreRollLimits limits = PreRollLimits());
+    ~PreRollRing();
+
+    PreRollRing(const PreRollRing&) = delete;
+    PreRollRing& operator=(const PreRollRing&) = delete;
+
+    // pkt의 참조를 링으로 옮김 (호출 후 pkt는 비어 있음)
+    // time_base: pkt의 pts 기준 (codec time_base), is_video: 키프레임 경계 판단용
+    bool Push(AVPacket* pkt, AVRational time_base, bool is_video);
+
+    // commit_us 이하인 마지막 비디오 키프레임부터 모든 패킷을 out으로 넘기고 링을 비움
+    // (commit_us보다 이른 키프레임이 없으면 가장 오래된 키프레임부터)
+    // 키프레임보다 앞선 오디오 패킷은 버림, 호출자가 out의 패킷을 av_packet_free로 해제
+    // 출력: 시작 키프레임 시각(us, pts 기준), 비디오 키프레임이 없으면 false (링은 그대로)
+    bool TakeFrom(int64_t commit_us, std::vector<AVPacket*>* out, int64_t* start_us);
+
+    void Clear();
+    bool Empty() const { return entries_.empty(); }
+    PreRollRingStats GetStats() const;
+
+private:
+    struct Entry {
+        AVPacket* packet = nullptr;
+        int64_t time_us = 0;  // pts를 마이크로초로 변환한 값
+        bool is_video = false;
+        bool keyframe = false;
+    };
+
+    // 한도를 넘으면 다음 비디오 키프레임 직전까지 (GOP 하나) 버림
+    void Evict();
+    void DropFront(size_t count);
+
+    PreRollLimits limits_;
+    std::deque<Entry> entries_;
+    size_t bytes_ = 0;
+    int64_t evicted_packets_ = 0;
+    int64_t evicted_bytes_ = 0;
+};
+
+#endif  // SAT_LEC_REC_PREROLL_RING_H_
@@ -0,0 +1,23 @@
+// 녹화 상태 이벤트 구현
+
+#include "recorder_events.h"
+
+const char* RecorderEventTypeName(RecorderEventType type) {
+    switch (type) {
+        case RecorderEventType::kRecordingStarted: return "recording_started";
+        case RecorderEventType::kFirstFrameEncoded: return "first_frame_encoded";
+        case RecorderEventType::kStageStalled: return "stage_stalled";
+        case RecorderEventType::kDeviceLost: return "device_lost";
+        case RecorderEventType::kDeviceRecovered: return "device_recovered";
+        case RecorderEventType::kSegmentClosed: return "segment_closed";
+        case RecorderEventType::kStopped: return "stopped";
+        case RecorderEventType::kStoppedWithError: return "stopped_with_error";
+        case RecorderEventType::kFinalizeCompleted: return "finalize_completed";
+        case RecorderEventType::kPreRollCommitted: return "preroll_committed";
+        case RecorderEventType::kEncoderRestarted: return "encoder_restarted";
+        case RecorderEventType::kStageRestarted: return "stage_restarted";
+        case RecorderEventType::kCpuGovernorChanged: return "cpu_governor_changed";
+        case RecorderEventType::kSecondaryOutputEnded: return "secondary_output_ended";
+    }
+    return "unknown";
+}
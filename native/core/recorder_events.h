@@ -0,0 +1,57 @@
+// 녹화 상태 이벤트 (시작, 첫 프레임, 정체/단계 복구, 장치 손실/복구, 파일 닫힘, CPU 예산 조절, 종료)
+// UI가 폴링하지 않고 바로 알 수 있도록 파이프라인/소스/러너가 발생시킴
+
+#ifndef SAT_LEC_REC_RECORDER_EVENTS_H_
+#define SAT_LEC_REC_RECORDER_EVENTS_H_
+
+#include <cstdint>
+#include <string>
+
+/// 이벤트 종류 (값은 FFI로 그대로 전달되므로 변경 금지, 추가만 가능)
+/// native_screen_recorder.h의 NATIVE_RECORDER_EVENT_*, lib/ffi/native_bindings.dart의 RecorderEventType과 동일
+enum class RecorderEventType : int32_t {
+    kRecordingStarted = 1,   // 인코더/캡처 스레드 시작 완료
+    kFirstFrameEncoded = 2,  // 첫 비디오 프레임 인코딩 완료
+    kStageStalled = 3,       // value: 정체 시간(ms), message: 단계 이름
+    kDeviceLost = 4,         // message: 소스 이름 (dxgi, wasapi)
+    kDeviceRecovered = 5,    // message: 소스 이름
+    kSegmentClosed = 6,      // 녹화 파일 닫힘, value: 기록한 바이트, message: 파일 경로
+    kStopped = 7,            // 정상 종료 (파일 닫힘), value: 중지 → 파일 닫힘 시간(ms)
+    kStoppedWithError = 8,   // 오류로 종료, value: 중지 → 파일 닫힘 시간(ms, 준비 실패면 0), message: 원인
+    kFinalizeCompleted = 9,  // faststart 후처리 1건 완료, value: 성공 1 / 실패 0, message: 결과 경로
+    kPreRollCommitted = 10,  // pre-roll을 파일로 넘김, value: 커밋 시점 이전 길이(ms), message: 파일 경로
+    kEncoderRestarted = 11,  // 인코더를 새 세그먼트로 다시 염 (자식 프로세스 종료/멈춤, 단계 감시 재시작)
+                             // value: 재시작 횟수, message: 새 세그먼트 경로
+    kStageRestarted = 12,    // 단계 감시 재시작 후 진행 재개, value: 감지 → 재개 시간(ms), message: 단계 이름
+    kCpuGovernorChanged = 13,  // CPU 예산 조절 단계 변경, value: 새 단계 (0 = 원래 설정)
+                               // message: 판단 JSON (action, reason, from, to, recorder_cpu, system_cpu, budget, fps, preset, threads)
+    kSecondaryOutputEnded = 14,  // 인코더 재시작으로 보조 출력 종료 (이후 세그먼트는 주 출력에만)
+                                 // value: 보조 출력이 담은 마지막 세그먼트 번호 (1 = 첫 파일), message: 보조 출력 경로
+};
+
+/// 입력: 없음
+/// 출력: 이벤트 한 건
+/// 예외: 없음
+struct RecorderEvent {
+    RecorderEventType type = RecorderEventType::kRecordingStarted;
+    int64_t elapsed_ms = 0;  // 녹화 시작 기준 (시작 전/무관한 이벤트는 0)
+    int64_t value = 0;
+    std::string message;
+    int32_t session_id = 0;  // 발생한 녹화 세션 (RecorderSession이 붙임, 기본 세션은 0)
+};
+
+/// 입력: 이벤트
+/// 출력: 구현체가 전달 (Dart 포트, 로그 등)
+/// 예외: 없음
+///
+/// 캡처/오디오/인코더/감시/러너 스레드에서 동시에 호출되므로 스레드 안전해야 하고, 오래 막히면 안 됨
+class RecorderEventSink {
+public:
+    virtual ~RecorderEventSink() = default;
+    virtual void OnRecorderEvent(const RecorderEvent& event) = 0;
+};
+
+// 로그용 이벤트 이름
+const char* RecorderEventTypeName(RecorderEventType type);
+
+#endif  // SAT_LEC_REC_RECORDER_EVENTS_H_
@@ -0,0 +1,166 @@
+// 녹화 세션 구현
+
+#include "recorder_session.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+#include "native_logger.h"
+#include "trace_recorder.h"
+
+namespace {
+
+// 세션 스레드가 캡처 실패를 확인하는 주기 (중지 요청은 바로 깨움)
+constexpr auto kSessionPollInterval = std::chrono::milliseconds(10);
+
+}  // namespace
+
+RecorderSession::RecorderSession(int32_t id) : id_(id) {}
+
+RecorderSession::~RecorderSession() {
+    Stop();
+}
+
+bool RecorderSession::Launch(RecorderSessionConfig config, std::string* error) {
+    if (!finished_.load(std::memory_order_acquire)) {
+        *error = IsRecording() ? "이미 녹화 중입니다" : "이전 녹화 종료 처리 중입니다";
+        return false;
+    }
+    if (!config.video_source) {
+        *error = "비디오 소스 없음";
+        return false;
+    }
+    // 끝난 이전 세션 스레드 정리 (소스는 config_를 바꾸면서 해제)
+    if (thread_.joinable()) thread_.join();
+
+    config_ = std::move(config);
+    config_.pipeline.video_source = config_.video_source.get();
+    config_.pipeline.audio_source = config_.audio_source.get();
+    config_.pipeline.event_sink = this;
+    // 종료 이벤트는 on_finished(후처리 예약)까지 끝난 뒤 세션 스레드가 보냄
+    config_.pipeline.defer_stop_event = true;
+    SetLastError("");
+    {
+        std::lock_guard<std::mutex> lock(trigger_mutex_);
+        trigger_requested_ = false;
+    }
+
+    recording_ = true;
+    finished_ = false;
+    try {
+        thread_ = std::thread(&RecorderSession::Run, this);
+    } catch (const std::exception& e) {
+        recording_ = false;
+        finished_ = true;
+        *error = std::string("세션 스레드 시작 실패: ") + e.what();
+        return false;
+    }
+    return true;
+}
+
+bool RecorderSession::Trigger() {
+    std::lock_guard<std::mutex> lock(trigger_mutex_);
+    if (pipeline_.Trigger()) {
+        return true;
+    }
+    // 준비가 끝나기 전이면 세션 스레드가 준비 직후 트리거
+    if (IsRecording() && !pipeline_.IsTriggered()) {
+        trigger_requested_ = true;
+        return true;
+    }
+    return false;
+}
+
+void RecorderSession::RequestStop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        recording_ = false;
+    }
+    stop_cv_.notify_all();
+}
+
+void RecorderSession::Stop() {
+    RequestStop();
+    if (thread_.joinable()) thread_.join();
+}
+
+std::string RecorderSession::GetLastError() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return last_error_;
+}
+
+void RecorderSession::SetLastError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    last_error_ = error;
+}
+
+void RecorderSession::OnRecorderEvent(const RecorderEvent& event) {
+    if (!config_.event_sink) return;
+    RecorderEvent stamped = event;
+    stamped.session_id = id_;
+    config_.event_sink->OnRecorderEvent(stamped);
+}
+
+void RecorderSession::Run() {
+    TraceRecorder::Instance().SetThreadName("session");
+    try {
+        std::string error;
+        if (!pipeline_.Arm(config_.pipeline, &error)) {
+            SATREC_LOG_ERROR("[Session %d] ❌ 녹화 파이프라인 시작 실패: %s", id_, error.c_str());
+            SetLastError(error);
+            recording_ = false;
+            // 이벤트를 받은 쪽이 바로 다시 Launch할 수 있도록 먼저 끝남으로 표시
+            finished_ = true;
+            RecorderEvent event;
+            event.type = RecorderEventType::kStoppedWithError;
+            event.message = error;
+            OnRecorderEvent(event);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(trigger_mutex_);
+            if (!config_.arm_only || trigger_requested_) {
+                pipeline_.Trigger();
+            }
+            trigger_requested_ = false;
+        }
+        SATREC_LOG_INFO("[Session %d] ✅ 모든 초기화 완료, %s", id_,
+                        pipeline_.IsTriggered() ? "녹화 시작" : "트리거 대기");
+
+        // 중지 요청 또는 복구할 수 없는 캡처 실패까지 대기
+        {
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            while (recording_.load(std::memory_order_acquire) && pipeline_.IsCapturing()) {
+                stop_cv_.wait_for(lock, kSessionPollInterval);
+            }
+        }
+        if (recording_.exchange(false)) {
+            SetLastError(pipeline_.GetLastError());
+        }
+
+        // 큐에 남은 항목 인코딩 후 인코더/소스 종료 (파일 닫힘)
+        pipeline_.Stop();
+        pipeline_.LogSummary();
+        if (config_.on_finished) {
+            config_.on_finished(*this);
+        }
+    } catch (const std::exception& e) {
+        SATREC_LOG_ERROR("[Session %d] ❌ 세션 스레드 예외 발생: %s", id_, e.what());
+        recording_ = false;
+        SetLastError(std::string("세션 스레드 예외: ") + e.what());
+        pipeline_.Stop();
+        finished_ = true;
+        RecorderEvent event;
+        event.type = RecorderEventType::kStoppedWithError;
+        event.message = GetLastError();
+        OnRecorderEvent(event);
+        return;
+    }
+
+    // 종료/오류 종료 이벤트는 후처리 예약(on_finished)과 끝남 표시 뒤에 보냄
+    // → 이벤트를 받은 쪽에서 후처리 진행 여부(IsFinalizing)가 정확하고 바로 다시 Launch 가능
+    finished_ = true;
+    pipeline_.EmitStopEvent();
+}
@@ -0,0 +1,105 @@
+// 녹화 세션 (소스 + 파이프라인 + 세션 스레드를 한 객체가 소유)
+// 러너는 세션 핸들로 여러 녹화를 동시에 관리 (다음 강의 시작과 이전 강의 종료 처리를 겹치거나 모니터별 동시 녹화)
+
+#ifndef SAT_LEC_REC_RECORDER_SESSION_H_
+#define SAT_LEC_REC_RECORDER_SESSION_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "capture_source.h"
+#include "recorder_events.h"
+#include "recording_pipeline.h"
+
+class RecorderSession;
+
+/// 입력: 파이프라인 설정, 세션이 소유할 캡처 소스
+/// 출력: RecorderSession::Launch 설정
+/// 예외: 없음
+struct RecorderSessionConfig {
+    // video_source/audio_source/event_sink는 세션이 아래 값으로 채움
+    RecordingPipelineConfig pipeline;
+
+    // 세션이 소유 (다음 Launch 또는 세션 소멸 시 해제), Start/Stop은 세션 스레드에서 호출
+    std::unique_ptr<IVideoSource> video_source;
+    std::unique_ptr<IAudioSource> audio_source;  // nullptr이면 비디오만
+
+    // 상태 이벤트 수신자 (세션 id를 붙여 전달, 세션보다 오래 살아 있어야 함)
+    RecorderEventSink* event_sink = nullptr;
+
+    // true면 준비(Arm)만 하고 Trigger를 기다림 (트리거 없이 중지하면 파일 없음)
+    bool arm_only = false;
+
+    // 파이프라인 Stop 직후, 종료 이벤트 전에 세션 스레드에서 호출 (후처리 예약 등, 비어 있으면 없음)
+    std::function<void(RecorderSession&)> on_finished;
+};
+
+/// 입력: RecorderSessionConfig
+/// 출력: 세션 스레드가 돌리는 녹화 한 건 (통계는 pipeline()으로 조회)
+/// 예외: 준비 실패는 Launch가 아니라 세션 스레드에서 kStoppedWithError 이벤트 + GetLastError로 알림
+///
+/// 세션 스레드: 파이프라인 준비 → (트리거) → 중지 요청 또는 캡처 실패까지 대기 → 파이프라인 Stop → on_finished
+///             → 끝남 표시 → kStopped/kStoppedWithError (이벤트를 받으면 IsFinished가 true, 후처리는 이미 예약됨)
+/// 끝난 세션은 다시 Launch할 수 있고, 파이프라인(공유 통계 블록 포함)은 세션 수명 동안 같은 객체
+class RecorderSession : private RecorderEventSink {
+public:
+    explicit RecorderSession(int32_t id);
+    ~RecorderSession();
+
+    RecorderSession(const RecorderSession&) = delete;
+    RecorderSession& operator=(const RecorderSession&) = delete;
+
+    int32_t id() const { return id_; }
+
+    // 세션 스레드 시작 (이전 녹화가 아직 진행/종료 처리 중이면 false + error)
+    bool Launch(RecorderSessionConfig config, std::string* error);
+    // 준비된 녹화 시작 (준비가 끝나기 전이면 끝나는 즉시 시작), 트리거할 녹화가 없으면 false
+    bool Trigger();
+    // 중지 요청만 하고 바로 반환 (세션 스레드가 캡처 중지 → 큐 비우기 → 파일 닫기를 백그라운드로 진행)
+    // 완료는 kStopped/kStoppedWithError 이벤트, 오래 걸리는 정도는 pipeline.finalize_deadline_ms로 제한
+    void RequestStop();
+    // 중지 요청 후 세션 스레드 종료(파일 닫힘, on_finished)까지 대기
+    void Stop();
+
+    // Launch 이후 중지 요청/캡처 실패 전까지 true (준비 중, 트리거 대기 중 포함)
+    bool IsRecording() const { return recording_.load(std::memory_order_acquire); }
+    // 세션 스레드가 끝났는지 (Launch 전에도 true)
+    bool IsFinished() const { return finished_.load(std::memory_order_acquire); }
+    // 중지 요청 후 종료 처리 중 (이 동안 다시 Launch할 수 없음)
+    bool IsStopping() const { return !IsRecording() && !IsFinished(); }
+    std::string GetLastError() const;
+
+    RecordingPipeline& pipeline() { return pipeline_; }
+    const RecordingPipeline& pipeline() const { return pipeline_; }
+
+private:
+    void Run();
+    void SetLastError(const std::string& error);
+    // 파이프라인/소스 이벤트에 세션 id를 붙여 전달
+    void OnRecorderEvent(const RecorderEvent& event) override;
+
+    const int32_t id_;
+    RecordingPipeline pipeline_;
+    RecorderSessionConfig config_;
+
+    std::thread thread_;
+    std::atomic<bool> recording_{false};
+    std::atomic<bool> finished_{true};
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+
+    // 준비 중에 들어온 트리거 (준비가 끝나면 세션 스레드가 바로 트리거)
+    std::mutex trigger_mutex_;
+    bool trigger_requested_ = false;
+
+    mutable std::mutex error_mutex_;
+    std::string last_error_;
+};
+
+#endif  // SAT_LEC_REC_RECORDER_SESSION_H_
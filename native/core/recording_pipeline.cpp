@@ -0,0 +1,1508 @@
+// 녹화 파이프라인 구현
+
+#include "recording_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <optional>
+
+#include "native_logger.h"
+#include "trace_recorder.h"
+
+namespace {
+
+// 인코더 스레드가 처리할 항목이 없을 때 대기 시간
+constexpr auto kEncoderIdleSleep = std::chrono::milliseconds(2);
+// 오디오 소스 확인 주기 (WASAPI 공유 모드 패킷 주기)
+constexpr auto kAudioPollInterval = std::chrono::milliseconds(10);
+// 공유 통계 블록 갱신 주기 / fps·비트레이트 계산 구간 (24fps에서 100ms는 2~3프레임이라 흔들림)
+constexpr int64_t kLiveStatsIntervalNs = 100 * 1000000LL;
+constexpr int64_t kRateWindowNs = 1000 * 1000000LL;
+// 단계 감시 주기 (정체 감지/복구 시각의 오차, 재시작 요청 → 단계 스레드가 가져가는 지연과 별개)
+constexpr auto kWatchdogPollInterval = std::chrono::milliseconds(20);
+// CPU 예산 조절: 사용률 측정 구간 / 종료 확인 주기 (Stop이 측정 구간만큼 기다리지 않도록)
+constexpr int64_t kGovernorSampleIntervalMs = 1000;
+constexpr auto kGovernorStopPollInterval = std::chrono::milliseconds(50);
+// pre-roll 커밋 응답 대기 한도 (인코더 스레드가 큐 처리 사이에 바로 처리하므로 보통 수 ms)
+constexpr auto kCommitTimeout = std::chrono::seconds(5);
+// post-roll 중 종료 시점 확인 주기
+constexpr auto kPostRollPollInterval = std::chrono::milliseconds(10);
+// 종료 처리 중 인코더 스레드 종료 확인 주기 (기한 초과 판단 오차)
+constexpr auto kFinalizePollInterval = std::chrono::milliseconds(5);
+// 인코더 자식 프로세스 상태 확인 주기 (종료/멈춤 감지 → 재시작 지연)
+constexpr auto kEncoderProcessPollInterval = std::chrono::milliseconds(10);
+// 준비(Arm) 상태에서 트리거 확인 주기 (트리거 → 첫 캡처 지연의 상한)
+constexpr int64_t kArmedPollIntervalNs = 1000000LL;
+
+// 큐 최대 깊이 갱신
+void UpdateHighWater(std::atomic<int64_t>& high_water, size_t depth) {
+    const int64_t value = static_cast<int64_t>(depth);
+    int64_t current = high_water.load(std::memory_order_relaxed);
+    while (value > current &&
+           !high_water.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// 오디오 레벨 계산 (Float32 PCM, -1.0 ~ +1.0)
+// RMS: 소리의 "에너지", Peak: 최대 진폭 (둘 다 0.0 ~ 1.0)
+void CalculateAudioLevel(const AudioSample& sample, float* rms, float* peak) {
+    const size_t total_samples = sample.data.size() / sizeof(float);
+    *rms = 0.0f;
+    *peak = 0.0f;
+    if (total_samples == 0) return;
+
+    const float* samples = reinterpret_cast<const float*>(sample.data.data());
+    double sum_squares = 0.0;
+    for (size_t i = 0; i < total_samples; i++) {
+        const float value = samples[i];
+        sum_squares += static_cast<double>(value) * value;
+        *peak = std::max(*peak, std::fabs(value));
+    }
+    *rms = static_cast<float>(std::sqrt(sum_squares / static_cast<double>(total_samples)));
+}
+
+}  // namespace
+
+RecordingPipeline::RecordingPipeline() {
+    frame_queue_ = std::make_unique<CaptureQueue<FrameData>>(config_.video_queue_capacity);
+    audio_queue_ = std::make_unique<CaptureQueue<AudioSample>>(config_.audio_queue_capacity);
+}
+
+RecordingPipeline::~RecordingPipeline() {
+    Stop();
+}
+
+void RecordingPipeline::ResetStats() {
+    pipeline_stats_.Reset();
+    start_tick_ = 0;
+    video_frame_count_ = 0;
+    audio_sample_count_ = 0;
+    audio_level_ = 0.0f;
+    audio_peak_level_ = 0.0f;
+    captured_video_frames_ = 0;
+    repeated_video_frames_ = 0;
+    dropped_video_frames_ = 0;
+    video_queue_high_water_ = 0;
+    dropped_audio_packets_ = 0;
+    dropped_audio_samples_ = 0;
+    dropped_audio_us_ = 0;
+    audio_queue_high_water_ = 0;
+    discarded_on_stop_ = 0;
+    last_stop_ms_ = 0;
+    encoder_restart_count_ = 0;
+    closed_segment_bytes_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        watchdog_stats_.fill(WatchdogStageStats());
+        governor_stats_ = CpuGovernorStats();
+    }
+    for (size_t i = 0; i < injected_hang_ms_.size(); i++) {
+        injected_hang_ms_[i] = 0;
+        injected_error_[i] = false;
+    }
+}
+
+bool RecordingPipeline::Start(const RecordingPipelineConfig& config, std::string* error) {
+    if (!Arm(config, error)) {
+        return false;
+    }
+    Trigger();
+    return true;
+}
+
+bool RecordingPipeline::Arm(const RecordingPipelineConfig& config, std::string* error) {
+    if (started_) {
+        *error = "이미 녹화 중입니다";
+        return false;
+    }
+    if (!config.video_source) {
+        *error = "비디오 소스 없음";
+        return false;
+    }
+    if (config.encoder.video_fps <= 0) {
+        *error = "잘못된 FPS";
+        return false;
+    }
+
+    if (config.video_frame_format == FramePixelFormat::kI420 &&
+        (config.encoder.video_width % 2 != 0 || config.encoder.video_height % 2 != 0)) {
+        *error = "I420 큐 저장은 짝수 해상도만 지원";
+        return false;
+    }
+    if (!config.encoder_host_path.empty()) {
+        // 자식 프로세스는 자기 SystemMediaClock으로 PTS를 계산하므로 소스도 같은 시계여야 함
+        if (config.clock && config.clock != &SystemMediaClock::Instance()) {
+            *error = "인코더 프로세스 모드는 시스템 시계만 지원";
+            return false;
+        }
+        if (config.encoder.start_in_preroll || !config.encoder.secondary_output_path.empty()) {
+            *error = "인코더 프로세스 모드는 pre-roll/보조 출력을 지원하지 않음";
+            return false;
+        }
+    }
+
+    // 비디오 큐 깊이: 메모리 예산이 있으면 프레임 크기(해상도 × 저장 형식)로 나눠서 결정
+    const size_t frame_bytes = FramePixelBytes(config.video_frame_format, config.encoder.video_width,
+                                               config.encoder.video_height);
+    size_t video_capacity = config.video_queue_capacity;
+    if (config.video_queue_budget_bytes > 0 && frame_bytes > 0) {
+        video_capacity = std::max(kMinVideoQueueFrames, config.video_queue_budget_bytes / frame_bytes);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        config_ = config;
+        clock_ = config.clock ? config.clock : &SystemMediaClock::Instance();
+        last_error_.clear();
+        output_tee_.reset();
+        frame_queue_ = std::make_unique<CaptureQueue<FrameData>>(video_capacity);
+        audio_queue_ = std::make_unique<CaptureQueue<AudioSample>>(config.audio_queue_capacity);
+        video_frame_bytes_ = frame_bytes;
+        segment_paths_.assign(1, config.encoder.output_path);
+    }
+    SATREC_LOG_INFO("[Pipeline] 비디오 큐: %zu프레임 × %.1fMB (%s, 최대 %.0fMB)", video_capacity,
+                    static_cast<double>(frame_bytes) / (1024.0 * 1024.0),
+                    config.video_frame_format == FramePixelFormat::kI420 ? "I420" : "BGRA",
+                    static_cast<double>(video_capacity * frame_bytes) / (1024.0 * 1024.0));
+    ResetStats();
+    stop_requested_ = false;
+    producers_done_ = false;
+    encoder_done_ = false;
+    discard_backlog_ = false;
+    triggered_ = false;
+    trigger_tick_ = 0;
+    encoder_rebased_ = false;
+    postroll_end_tick_ = 0;
+    wrote_output_ = false;
+    commit_pending_ = false;
+    has_last_frame_ = false;
+    last_frame_ = FrameData();
+    const auto arm_started_at = std::chrono::steady_clock::now();
+
+    // 1. 비디오 소스 시작 + 프레임 버퍼/변환 준비는 별도 스레드, 오디오 소스 → 인코더(출력 파일 열기)는
+    //    이 스레드에서 동시에 진행 (장치 손실/복구 이벤트는 파이프라인을 거쳐 전달)
+    SATREC_LOG_INFO("[Pipeline] 소스 시작: 비디오=%s, 오디오=%s", config_.video_source->Name(),
+                    config_.audio_source ? config_.audio_source->Name() : "없음");
+    config_.video_source->SetEventSink(this);
+    if (config_.audio_source) config_.audio_source->SetEventSink(this);
+    bool video_started = false;
+    std::string video_error;
+    std::thread video_init([this, frame_bytes, &video_started, &video_error] {
+        video_started = config_.video_source->Start(&video_error);
+        if (video_started) {
+            PrepareFrameBuffers(frame_bytes);
+        }
+    });
+
+    AudioSourceFormat audio_format;
+    bool audio_started = false;
+    encoder_segment_index_ = 0;
+    segment_rebase_pending_ = false;
+    bool init_ok = true;
+    if (config_.audio_source) {
+        audio_started = config_.audio_source->Start(error);
+        init_ok = audio_started;
+        if (init_ok) {
+            audio_format = config_.audio_source->Format();
+            if (audio_format.bits_per_sample != 32) {
+                *error = "지원하지 않는 오디오 형식 (Float32만 지원)";
+                init_ok = false;
+            }
+        }
+    }
+
+    // 2. 인코더 시작 (코덱/변환 컨텍스트 생성, 출력 파일 열기 + 헤더)
+    if (init_ok) {
+        LibavEncoderConfig encoder_config = config_.encoder;
+        encoder_config.audio_sample_rate = audio_format.sample_rate;
+        encoder_config.audio_channels = audio_format.channels;
+        encoder_config.clock = clock_;
+        encoder_config.pipeline_stats = &pipeline_stats_;
+        encoder_config_ = encoder_config;
+        audio_format_ = audio_format;
+
+        if (!config_.encoder_host_path.empty()) {
+            // 자식 프로세스 모드: 링 슬롯 수 = 큐 깊이 (같은 메모리 예산)
+            EncoderProcessConfig process_config;
+            process_config.host_path = config_.encoder_host_path;
+            process_config.encoder = encoder_config;
+            process_config.frame_format = config_.video_frame_format;
+            process_config.video_slots = video_capacity;
+            process_config.audio_slots = config_.audio_queue_capacity;
+            process_config.max_restarts = config_.encoder_max_restarts;
+            process_config.lower_priority = config_.thread_policy.enabled;
+            auto process = std::make_unique<EncoderProcess>();
+            if (process->Start(process_config, error)) {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                encoder_process_ = std::move(process);
+            } else {
+                SATREC_LOG_ERROR("[Pipeline] ❌ 인코더 프로세스 시작 실패: %s", error->c_str());
+                init_ok = false;
+            }
+        } else {
+            encoder_ = std::make_unique<LibavEncoder>();
+            if (!encoder_->Start(encoder_config)) {
+                *error = encoder_->GetLastError();
+                SATREC_LOG_ERROR("[Pipeline] ❌ LibavEncoder 시작 실패: %s", error->c_str());
+                encoder_.reset();
+                init_ok = false;
+            }
+        }
+    }
+
+    video_init.join();
+    if (init_ok && !video_started) {
+        *error = video_error;
+        init_ok = false;
+    }
+    if (!init_ok) {
+        SetLastError(*error);
+        if (encoder_) {
+            // 헤더만 있는 빈 파일은 남기지 않음
+            encoder_->Stop();
+            encoder_.reset();
+            RemoveOutputFiles();
+        }
+        if (encoder_process_) {
+            encoder_process_->Finish(0);
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                encoder_process_.reset();
+            }
+            RemoveOutputFiles();
+        }
+        if (audio_started) config_.audio_source->Stop();
+        if (video_started) config_.video_source->Stop();
+        config_.video_source->SetEventSink(nullptr);
+        if (config_.audio_source) config_.audio_source->SetEventSink(nullptr);
+        return false;
+    }
+    if (encoder_) {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            output_tee_ = encoder_->GetOutputTee();
+        }
+        preroll_active_ = encoder_->IsPreRollActive();
+    }
+
+    // 3. 캡처 trace (오디오 스레드보다 먼저 열어야 첫 패킷부터 기록됨)
+    if (!config_.capture_trace_path.empty()) {
+        CaptureTraceInfo info;
+        info.width = config_.encoder.video_width;
+        info.height = config_.encoder.video_height;
+        info.fps = config_.encoder.video_fps;
+        info.sample_rate = audio_format.sample_rate;
+        info.channels = audio_format.channels;
+        info.bits_per_sample = audio_format.bits_per_sample;
+        info.qpc_frequency = clock_->Frequency();
+        info.start_qpc = clock_->Now();
+        std::string trace_error;
+        if (!capture_trace_.Open(config_.capture_trace_path, info, &trace_error)) {
+            SATREC_LOG_WARN("[Pipeline] ⚠️ 캡처 trace 시작 실패 (녹화는 계속): %s", trace_error.c_str());
+        }
+    }
+
+    // 4. 오디오 / 인코더 / 캡처 스레드 (트리거 전에는 캡처만 하고 큐에 넣지 않음)
+    started_ = true;
+    capturing_ = true;
+    const uint64_t armed_tick = clock_->Now();
+    live_stats_tick_ = 0;
+    rate_window_tick_ = armed_tick;
+    rate_window_frames_ = 0;
+    rate_window_bytes_ = 0;
+    last_encoded_bytes_ = 0;
+    video_fps_ = 0.0f;
+    encoder_bitrate_kbps_ = 0.0f;
+    PublishLiveStats(false);
+
+    // 단계 감시 (자식 프로세스 인코더는 EncoderProcess가 자체 heartbeat로 감시)
+    PipelineWatchdogConfig watchdog_config;
+    watchdog_config.stall_deadline_ms = config_.watchdog_deadline_ms;
+    watchdog_config.max_restarts = config_.stage_max_restarts;
+    watchdog_.Reset(watchdog_config, clock_, armed_tick);
+    if (config_.watchdog_deadline_ms > 0) {
+        watchdog_.Enable(WatchedStage::kCapture);
+        if (config_.audio_source) watchdog_.Enable(WatchedStage::kAudio);
+        if (encoder_) watchdog_.Enable(WatchedStage::kEncoder);
+    }
+
+    // CPU 예산 조절: 녹화 중에는 캡처 fps만 (인코더를 다시 열면 세그먼트가 나뉨)
+    const bool governor_enabled = config_.cpu_governor.budget_percent > 0.0;
+    capture_interval_ns_ = 1000000000LL / config_.encoder.video_fps;
+    governor_.Reset(config_.cpu_governor,
+                    BuildCpuGovernorLadder(config_.encoder.video_fps, config_.cpu_governor.min_capture_fps), 0);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        governor_stats_.enabled = governor_enabled;
+        governor_stats_.level_count = governor_.level_count();
+        governor_stats_.capture_fps = governor_.current().capture_fps;
+    }
+
+    if (config_.audio_source) {
+        audio_thread_ = std::thread(&RecordingPipeline::AudioLoop, this);
+    }
+    encoder_thread_ = encoder_process_ ? std::thread(&RecordingPipeline::EncoderProcessLoop, this)
+                                       : std::thread(&RecordingPipeline::EncoderLoop, this);
+    capture_thread_ = std::thread(&RecordingPipeline::CaptureLoop, this, config_.encoder.video_fps);
+    if (config_.watchdog_deadline_ms > 0) {
+        watchdog_stop_ = false;
+        watchdog_thread_ = std::thread(&RecordingPipeline::WatchdogLoop, this);
+    }
+    if (governor_enabled) {
+        governor_stop_ = false;
+        governor_thread_ = std::thread(&RecordingPipeline::GovernorLoop, this);
+    }
+    armed_.store(true, std::memory_order_release);
+
+    SATREC_LOG_INFO("[Pipeline] ✅ 녹화 준비 완료 (%dx%d @ %dfps, %.1fms)", config_.encoder.video_width,
+                    config_.encoder.video_height, config_.encoder.video_fps,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - arm_started_at).count());
+    return true;
+}
+
+bool RecordingPipeline::Trigger() {
+    if (!armed_.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+    // 캡처/오디오 스레드가 이 플래그를 보고 바로 큐에 넣기 시작 (인코더 PTS 기준도 이 시점)
+    const uint64_t now = clock_->Now();
+    trigger_tick_.store(now, std::memory_order_relaxed);
+    start_tick_.store(now, std::memory_order_relaxed);
+    if (encoder_process_) encoder_process_->SetStartTick(now);
+    triggered_.store(true, std::memory_order_release);
+
+    SATREC_LOG_INFO("[Pipeline] ✅ 녹화 시작 (트리거)");
+    EmitEvent(RecorderEventType::kRecordingStarted, 0,
+              std::filesystem::path(config_.encoder.output_path).u8string());
+    return true;
+}
+
+void RecordingPipeline::PrepareFrameBuffers(size_t frame_bytes) {
+    // 첫 프레임에서 할당/컨텍스트 생성이 일어나지 않도록 미리 준비 (캡처 스레드 시작 전에만 호출)
+    last_frame_.pixels.reserve(std::max(frame_bytes, FramePixelBytes(FramePixelFormat::kBgra,
+                                                                      config_.encoder.video_width,
+                                                                      config_.encoder.video_height)));
+    if (config_.video_frame_format == FramePixelFormat::kI420) {
+        FrameData blank;
+        blank.width = config_.encoder.video_width;
+        blank.height = config_.encoder.video_height;
+        blank.pixels.assign(FramePixelBytes(FramePixelFormat::kBgra, blank.width, blank.height), 0);
+        std::string warm_error;
+        if (!frame_converter_.ConvertToI420(&blank, &warm_error)) {
+            SATREC_LOG_WARN("[Pipeline] ⚠️ I420 변환 준비 실패 (첫 프레임에서 다시 시도): %s", warm_error.c_str());
+        }
+    }
+}
+
+void RecordingPipeline::RemoveOutputFiles() const {
+    std::error_code ec;
+    std::filesystem::remove(std::filesystem::path(config_.encoder.output_path), ec);
+    if (!config_.encoder.secondary_output_path.empty()) {
+        std::filesystem::remove(std::filesystem::path(config_.encoder.secondary_output_path), ec);
+    }
+}
+
+void RecordingPipeline::StopProducers() {
+    // 종료 중에는 heartbeat가 끊기므로 감시부터 멈춤
+    StopWatchdog();
+    StopGovernor();
+    stop_requested_ = true;
+    if (capture_thread_.joinable()) capture_thread_.join();
+    if (audio_thread_.joinable()) audio_thread_.join();
+    capturing_ = false;
+
+    if (config_.audio_source) {
+        config_.audio_source->Stop();
+        config_.audio_source->SetEventSink(nullptr);
+    }
+    if (config_.video_source) {
+        config_.video_source->Stop();
+        config_.video_source->SetEventSink(nullptr);
+    }
+    capture_trace_.Close();
+    producers_done_ = true;
+}
+
+void RecordingPipeline::JoinEncoderWithDeadline() {
+    if (!encoder_thread_.joinable()) return;
+    SATREC_LOG_INFO("[Pipeline] 인코더 스레드 종료 대기...");
+    // 자식 프로세스 모드의 기한은 FinishEncoderProcess가 적용 (감독 스레드는 바로 끝남)
+    if (config_.finalize_deadline_ms > 0 && !encoder_process_) {
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(config_.finalize_deadline_ms);
+        while (!encoder_done_.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(kFinalizePollInterval);
+        }
+        if (!encoder_done_.load(std::memory_order_acquire)) {
+            SATREC_LOG_WARN("[Pipeline] ⚠️ 종료 처리 기한 %dms 초과, 남은 큐 항목을 버리고 파일을 닫음 (비디오 %zu, 오디오 %zu)",
+                            config_.finalize_deadline_ms, frame_queue_->Size(), audio_queue_->Size());
+            discard_backlog_.store(true, std::memory_order_release);
+        }
+    }
+    encoder_thread_.join();
+}
+
+void RecordingPipeline::Stop() {
+    if (!started_) return;
+    const auto stop_started_at = std::chrono::steady_clock::now();
+    // 이후 Trigger는 무시 (트리거 없이 끝나면 post-roll도 없음)
+    armed_ = false;
+
+    // post-roll: 지금부터 postroll_ms까지 캡처한 항목만 더 기록 (캡처가 먼저 끝나면 바로 종료)
+    if (config_.postroll_ms > 0 && IsCapturing() && IsTriggered() && !IsPreRollActive()) {
+        const uint64_t end_tick = clock_->Now() + static_cast<uint64_t>(
+            static_cast<double>(config_.postroll_ms) * static_cast<double>(clock_->Frequency()) / 1000.0);
+        postroll_end_tick_.store(end_tick, std::memory_order_relaxed);
+        SATREC_LOG_INFO("[Pipeline] post-roll %dms 기록 후 종료", config_.postroll_ms);
+        while (IsCapturing() && clock_->Now() < end_tick) {
+            std::this_thread::sleep_for(kPostRollPollInterval);
+        }
+    }
+
+    // 캡처/오디오 스레드 종료 → 인코더 스레드가 남은 큐를 비우고 종료
+    StopProducers();
+    JoinEncoderWithDeadline();
+    const bool process_closed = encoder_process_ ? FinishEncoderProcess() : false;
+
+    // 마지막 값 유지 + 녹화 종료 표시 (인코더 스레드 종료 후라 기록자는 이 스레드뿐)
+    PublishLiveStats(false);
+
+    if (encoder_) {
+        // 커밋 없이 끝난 pre-roll은 파일을 만들지 않고, 트리거 없이 끝난 준비 상태는 미리 연 파일을 지움
+        const bool triggered = IsTriggered();
+        wrote_output_ = triggered && !encoder_->IsPreRollActive();
+        encoder_->Stop();
+        encoder_.reset();
+        if (!triggered) {
+            RemoveOutputFiles();
+            SATREC_LOG_INFO("[Pipeline] 트리거 없이 준비 해제, 미리 연 출력 파일 삭제");
+        }
+        if (wrote_output_) {
+            // 감시 재시작으로 세그먼트가 나뉘었으면 마지막 세그먼트 (앞 세그먼트는 재시작할 때 알림)
+            EmitEvent(RecorderEventType::kSegmentClosed, last_encoded_bytes_ - closed_segment_bytes_,
+                      std::filesystem::path(GetSegmentPaths().back()).u8string());
+        }
+    } else if (!encoder_process_ && encoder_segment_index_ > 0) {
+        // 인코더 재시작이 실패한 채 종료 (앞 세그먼트는 재시작할 때 이미 닫고 알림)
+        wrote_output_ = IsTriggered();
+    }
+    if (encoder_process_) {
+        const bool triggered = IsTriggered();
+        wrote_output_ = triggered;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            segment_paths_ = encoder_process_->GetSegmentPaths();
+            encoder_process_.reset();
+        }
+        if (!triggered) {
+            RemoveOutputFiles();
+            SATREC_LOG_INFO("[Pipeline] 트리거 없이 준비 해제, 미리 연 출력 파일 삭제");
+        } else {
+            // 세그먼트마다 알림 (재시작이 없으면 출력 파일 하나, 마지막 세그먼트가 비정상 종료면 trailer 없음)
+            for (const std::wstring& path : GetSegmentPaths()) {
+                std::error_code ec;
+                const auto bytes = std::filesystem::file_size(std::filesystem::path(path), ec);
+                EmitEvent(RecorderEventType::kSegmentClosed, ec ? 0 : static_cast<int64_t>(bytes),
+                          std::filesystem::path(path).u8string());
+            }
+            if (!process_closed) {
+                SATREC_LOG_WARN("[Pipeline] ⚠️ 인코더 프로세스가 마지막 세그먼트를 정상적으로 닫지 못함");
+            }
+        }
+    }
+    preroll_active_ = false;
+    postroll_end_tick_ = 0;
+    has_last_frame_ = false;
+    last_frame_ = FrameData();
+    start_tick_ = 0;
+    started_ = false;
+    const auto stop_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - stop_started_at).count();
+    last_stop_ms_.store(static_cast<int64_t>(stop_ms), std::memory_order_relaxed);
+    SATREC_LOG_INFO("[Pipeline] 녹화 종료 (비디오 %lld프레임, 오디오 %lld샘플, 종료 처리 %lldms, 버린 항목 %lld)",
+                    static_cast<long long>(GetVideoFrameCount()),
+                    static_cast<long long>(GetAudioSampleCount()), static_cast<long long>(stop_ms),
+                    static_cast<long long>(discarded_on_stop_.load(std::memory_order_relaxed)));
+
+    if (!config_.defer_stop_event) {
+        EmitStopEvent();
+    }
+}
+
+void RecordingPipeline::EmitStopEvent() {
+    // 캡처/인코딩 중 오류가 있었으면 오류 종료로 알림 (파일은 Stop에서 정상적으로 닫힘)
+    const int64_t stop_ms = GetLastStopMs();
+    const std::string last_error = GetLastError();
+    if (last_error.empty()) {
+        EmitEvent(RecorderEventType::kStopped, stop_ms);
+    } else {
+        EmitEvent(RecorderEventType::kStoppedWithError, stop_ms, last_error);
+    }
+}
+
+bool RecordingPipeline::CommitPreRoll(int64_t lookback_ms, std::string* error, PreRollCommitInfo* info) {
+    if (!started_ || !IsPreRollActive()) {
+        *error = "pre-roll 중이 아닙니다";
+        return false;
+    }
+    if (!IsCapturing()) {
+        *error = "캡처가 중단되어 커밋할 수 없습니다";
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(commit_mutex_);
+    if (commit_pending_.load(std::memory_order_relaxed)) {
+        *error = "이미 커밋 요청이 처리 중입니다";
+        return false;
+    }
+    const uint64_t now = clock_->Now();
+    const auto lookback_ticks = static_cast<uint64_t>(
+        static_cast<double>(std::max<int64_t>(0, lookback_ms)) * static_cast<double>(clock_->Frequency()) / 1000.0);
+    commit_tick_ = now > lookback_ticks ? now - lookback_ticks : 0;
+    commit_done_ = false;
+    commit_pending_.store(true, std::memory_order_release);
+
+    // 인코더 스레드가 큐 처리 사이에 커밋 (파일 쓰기는 인코더 스레드만 함)
+    if (!commit_cv_.wait_for(lock, kCommitTimeout, [this] { return commit_done_; })) {
+        *error = "pre-roll 커밋 응답 시간 초과";
+        return false;
+    }
+    if (!commit_ok_) {
+        *error = commit_error_;
+        return false;
+    }
+    if (info) *info = commit_info_;
+    return true;
+}
+
+void RecordingPipeline::ServiceCommitRequest(bool finished) {
+    if (!commit_pending_.load(std::memory_order_acquire)) return;
+
+    PreRollCommitInfo info;
+    bool committed = false;
+    {
+        std::lock_guard<std::mutex> lock(commit_mutex_);
+        if (finished || !encoder_) {
+            commit_ok_ = false;
+            commit_error_ = finished ? "녹화가 종료되어 커밋하지 않았습니다" : "인코더 재시작 중이라 커밋하지 않았습니다";
+        } else {
+            SATREC_TRACE_SCOPE("commit_preroll");
+            commit_ok_ = encoder_->CommitPreRoll(commit_tick_, &info);
+            commit_error_ = commit_ok_ ? std::string() : encoder_->GetLastError();
+            commit_info_ = info;
+        }
+        committed = commit_ok_;
+        if (committed) {
+            preroll_active_ = false;
+            start_tick_ = commit_tick_;  // 경과 시간은 커밋 시점부터
+        } else if (!finished) {
+            SetLastError(commit_error_);
+        }
+        commit_done_ = true;
+        commit_pending_.store(false, std::memory_order_release);
+    }
+    commit_cv_.notify_all();
+
+    if (committed) {
+        EmitEvent(RecorderEventType::kPreRollCommitted, info.preroll_ms,
+                  std::filesystem::path(config_.encoder.output_path).u8string());
+    }
+}
+
+void RecordingPipeline::RebaseEncoderOnce(uint64_t item_timestamp) {
+    if (segment_rebase_pending_) {
+        // 재시작한 인코더: 새 세그먼트는 처음 꺼낸 항목부터 0 (자식 프로세스 재시작과 같은 방식)
+        segment_rebase_pending_ = false;
+        encoder_->ResetStartTime(item_timestamp);
+        return;
+    }
+    if (encoder_rebased_) return;
+    encoder_rebased_ = true;
+    // 큐 항목은 트리거 후에만 들어오므로 첫 항목을 꺼낸 시점에는 trigger_tick_이 확정됨
+    const uint64_t trigger_tick = trigger_tick_.load(std::memory_order_relaxed);
+    encoder_->ResetStartTime(trigger_tick);
+    rate_window_tick_ = trigger_tick;
+}
+
+bool RecordingPipeline::IsPastPostRoll(uint64_t timestamp) const {
+    const uint64_t end_tick = postroll_end_tick_.load(std::memory_order_relaxed);
+    return end_tick != 0 && timestamp > end_tick;
+}
+
+std::string RecordingPipeline::GetLastError() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return last_error_;
+}
+
+void RecordingPipeline::SetLastError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    last_error_ = error;
+}
+
+int64_t RecordingPipeline::GetElapsedMs() const {
+    const uint64_t start = start_tick_.load(std::memory_order_relaxed);
+    if (start == 0 || !IsCapturing()) return 0;
+    return clock_->ElapsedNs(start, clock_->Now()) / 1000000;
+}
+
+void RecordingPipeline::PublishLiveStats(bool recording) {
+    const uint64_t now = clock_->Now();
+    const RecordingQueueStats queue = GetQueueStats();
+
+    LiveStatsSnapshot snapshot;
+    snapshot.recording = recording;
+    const uint64_t start = start_tick_.load(std::memory_order_relaxed);
+    snapshot.elapsed_ms = start != 0 ? clock_->ElapsedNs(start, now) / 1000000 : 0;
+    snapshot.video_frames = GetVideoFrameCount();
+    snapshot.audio_samples = GetAudioSampleCount();
+    snapshot.captured_video_frames = queue.captured_video_frames;
+    snapshot.repeated_video_frames = queue.repeated_video_frames;
+    snapshot.dropped_video_frames = queue.dropped_video_frames;
+    snapshot.dropped_audio_packets = queue.dropped_audio_packets;
+    snapshot.dropped_audio_samples = queue.dropped_audio_samples;
+    snapshot.dropped_audio_ms = queue.dropped_audio_us / 1000;
+    snapshot.video_queue_depth = static_cast<int32_t>(queue.video_queue_depth);
+    snapshot.video_queue_high_water = static_cast<int32_t>(queue.video_queue_high_water);
+    snapshot.video_queue_capacity = static_cast<int32_t>(queue.video_queue_capacity);
+    snapshot.audio_queue_depth = static_cast<int32_t>(queue.audio_queue_depth);
+    snapshot.audio_queue_high_water = static_cast<int32_t>(queue.audio_queue_high_water);
+    snapshot.audio_queue_capacity = static_cast<int32_t>(queue.audio_queue_capacity);
+    snapshot.audio_level = GetAudioLevel();
+    snapshot.audio_peak_level = GetAudioPeakLevel();
+
+    if (encoder_) {
+        last_encoded_bytes_ = closed_segment_bytes_ + encoder_->GetMuxedBytes();
+    } else if (encoder_process_) {
+        last_encoded_bytes_ = encoder_process_->GetMuxedBytes();
+    }
+    snapshot.encoded_bytes = last_encoded_bytes_;
+
+    // fps / 비트레이트는 1초 구간마다 갱신 (그 사이에는 직전 구간 값 유지)
+    const int64_t window_ns = clock_->ElapsedNs(rate_window_tick_, now);
+    if (window_ns >= kRateWindowNs) {
+        const double window_seconds = static_cast<double>(window_ns) / 1e9;
+        video_fps_ = static_cast<float>(
+            static_cast<double>(snapshot.video_frames - rate_window_frames_) / window_seconds);
+        encoder_bitrate_kbps_ = static_cast<float>(
+            static_cast<double>(snapshot.encoded_bytes - rate_window_bytes_) * 8.0 / 1000.0 / window_seconds);
+        rate_window_tick_ = now;
+        rate_window_frames_ = snapshot.video_frames;
+        rate_window_bytes_ = snapshot.encoded_bytes;
+    }
+    snapshot.video_fps = recording ? video_fps_ : 0.0f;
+    snapshot.encoder_bitrate_kbps = recording ? encoder_bitrate_kbps_ : 0.0f;
+
+    live_stats_.Publish(snapshot);
+    live_stats_tick_ = now;
+}
+
+void RecordingPipeline::EmitEvent(RecorderEventType type, int64_t value, const std::string& message) {
+    if (!config_.event_sink) return;
+    RecorderEvent event;
+    event.type = type;
+    event.value = value;
+    event.message = message;
+    OnRecorderEvent(event);
+}
+
+void RecordingPipeline::OnRecorderEvent(const RecorderEvent& event) {
+    if (!config_.event_sink) return;
+    RecorderEvent stamped = event;
+    const uint64_t start = start_tick_.load(std::memory_order_relaxed);
+    if (stamped.elapsed_ms == 0 && start != 0) {
+        stamped.elapsed_ms = clock_->ElapsedNs(start, clock_->Now()) / 1000000;
+    }
+    config_.event_sink->OnRecorderEvent(stamped);
+}
+
+int64_t RecordingPipeline::GetEncoderProcessId() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return encoder_process_ ? encoder_process_->GetProcessId() : 0;
+}
+
+std::vector<std::wstring> RecordingPipeline::GetSegmentPaths() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return segment_paths_;
+}
+
+std::shared_ptr<const OutputTee> RecordingPipeline::GetOutputTee() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return output_tee_;
+}
+
+RecordingQueueStats RecordingPipeline::GetQueueStats() const {
+    RecordingQueueStats stats;
+    stats.captured_video_frames = captured_video_frames_.load(std::memory_order_relaxed);
+    stats.repeated_video_frames = repeated_video_frames_.load(std::memory_order_relaxed);
+    stats.dropped_video_frames = dropped_video_frames_.load(std::memory_order_relaxed);
+    stats.dropped_audio_packets = dropped_audio_packets_.load(std::memory_order_relaxed);
+    stats.dropped_audio_samples = dropped_audio_samples_.load(std::memory_order_relaxed);
+    stats.dropped_audio_us = dropped_audio_us_.load(std::memory_order_relaxed);
+    stats.video_queue_high_water = static_cast<size_t>(video_queue_high_water_.load(std::memory_order_relaxed));
+    stats.audio_queue_high_water = static_cast<size_t>(audio_queue_high_water_.load(std::memory_order_relaxed));
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (encoder_process_) {
+        // 자식 프로세스 모드: 큐 대신 공유 메모리 링
+        stats.video_queue_depth = encoder_process_->VideoDepth();
+        stats.audio_queue_depth = encoder_process_->AudioDepth();
+        stats.video_queue_capacity = encoder_process_->VideoCapacity();
+        stats.audio_queue_capacity = encoder_process_->AudioCapacity();
+    } else {
+        stats.video_queue_depth = frame_queue_->Size();
+        stats.audio_queue_depth = audio_queue_->Size();
+        stats.video_queue_capacity = frame_queue_->Capacity();
+        stats.audio_queue_capacity = audio_queue_->Capacity();
+    }
+    stats.video_frame_bytes = video_frame_bytes_;
+    stats.discarded_on_stop = discarded_on_stop_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void RecordingPipeline::LogSummary() const {
+    pipeline_stats_.LogSummary();
+    const RecordingQueueStats stats = GetQueueStats();
+    SATREC_LOG_INFO("[Pipeline] 📊 큐 통계: 캡처 %lld, 반복 %lld, 비디오 드롭 %lld (큐 최대 %zu/%zu, %.0fMB), "
+                    "오디오 드롭 %lld패킷/%lld샘플/%.1fms (큐 최대 %zu/%zu)",
+                    static_cast<long long>(stats.captured_video_frames),
+                    static_cast<long long>(stats.repeated_video_frames),
+                    static_cast<long long>(stats.dropped_video_frames),
+                    stats.video_queue_high_water, stats.video_queue_capacity,
+                    static_cast<double>(stats.video_queue_high_water * stats.video_frame_bytes) / (1024.0 * 1024.0),
+                    static_cast<long long>(stats.dropped_audio_packets),
+                    static_cast<long long>(stats.dropped_audio_samples),
+                    static_cast<double>(stats.dropped_audio_us) / 1000.0,
+                    stats.audio_queue_high_water, stats.audio_queue_capacity);
+}
+
+// ============================================================================
+// 캡처 / 오디오 스레드
+// ============================================================================
+
+void RecordingPipeline::EnqueueFrame(FrameData frame) {
+    if (encoder_process_) {
+        // 공유 메모리 슬롯에 바로 복사 (가득 차면 새 프레임을 버림, 자식이 읽는 슬롯은 덮어쓸 수 없음)
+        if (IsPastPostRoll(frame.timestamp)) return;
+        if (!encoder_process_->PushVideo(frame)) {
+            dropped_video_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+        const size_t depth = encoder_process_->VideoDepth();
+        UpdateHighWater(video_queue_high_water_, depth);
+        SATREC_TRACE_COUNTER("video_queue", depth);
+        return;
+    }
+    std::optional<FrameData> dropped;
+    const size_t depth = frame_queue_->Push(std::move(frame), &dropped);
+    if (dropped) {
+        // 큐가 가득 찬 경우: 가장 오래된 프레임 버림
+        dropped_video_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+    UpdateHighWater(video_queue_high_water_, depth);
+    SATREC_TRACE_COUNTER("video_queue", depth);
+}
+
+void RecordingPipeline::EnqueueAudioSample(AudioSample sample) {
+    std::optional<AudioSample> dropped;
+    size_t depth = 0;
+    if (encoder_process_) {
+        if (IsPastPostRoll(sample.timestamp)) return;
+        depth = encoder_process_->AudioDepth();
+        if (!encoder_process_->PushAudio(sample)) {
+            dropped = std::move(sample);
+        } else {
+            depth++;
+        }
+    } else {
+        depth = audio_queue_->Push(std::move(sample), &dropped);
+    }
+    if (dropped) {
+        // 큐가 가득 찬 경우: 가장 오래된 샘플 버림
+        dropped_audio_packets_.fetch_add(1, std::memory_order_relaxed);
+        dropped_audio_samples_.fetch_add(dropped->frame_count, std::memory_order_relaxed);
+        if (dropped->sample_rate > 0) {
+            dropped_audio_us_.fetch_add(
+                static_cast<int64_t>(dropped->frame_count) * 1000000LL / dropped->sample_rate,
+                std::memory_order_relaxed);
+        }
+    }
+    UpdateHighWater(audio_queue_high_water_, depth);
+    SATREC_TRACE_COUNTER("audio_queue", depth);
+}
+
+void RecordingPipeline::CaptureLoop(int fps) {
+    TraceRecorder::Instance().SetThreadName("capture");
+    ScopedThreadPolicy thread_policy(ThreadRole::kCapture, config_.thread_policy);
+    IVideoSource* source = config_.video_source;
+
+    // FPS 제한을 위한 타이밍 계산 (예: 24fps → 프레임 간격 약 41.67ms)
+    // CPU 예산 조절이 간격을 늘릴 수 있어 매 반복 다시 읽음 (PTS는 캡처 시각 기준이라 파일은 그대로 이어짐)
+    int64_t frame_interval_ns = capture_interval_ns_.load(std::memory_order_relaxed);
+    uint64_t last_frame_tick = clock_->Now();
+    int64_t frame_count = 0;
+    // 트리거 전(준비 상태)에는 캡처/변환만 해서 마지막 프레임을 최신으로 유지하고 큐에는 넣지 않음
+    bool triggered = IsTriggered();
+    // 감시 중 소스 오류 → 재시작 요청을 처리할 때까지 마지막 프레임 반복 (비디오 스트림 유지)
+    const bool watched = IsWatched(WatchedStage::kCapture);
+    bool source_faulted = false;
+    SATREC_LOG_INFO("[Pipeline] 프레임 캡처 루프 시작 (목표: %dfps, 간격: %.2fms)",
+                    fps, static_cast<double>(frame_interval_ns) / 1e6);
+
+    try {
+        while (!stop_requested_.load(std::memory_order_acquire)) {
+            if (watched && watchdog_.heartbeat(WatchedStage::kCapture).TakeRestartRequest()) {
+                source_faulted = !RestartVideoSource();
+            }
+            frame_interval_ns = capture_interval_ns_.load(std::memory_order_relaxed);
+            if (!triggered && IsTriggered()) {
+                // 트리거 직후: 간격을 기다리지 않고 바로 첫 프레임 캡처
+                triggered = true;
+            } else {
+                // 목표 프레임 간격이 지날 때까지 대기 (남은 시간만큼 sleep, 준비 상태에서는 트리거도 확인)
+                const int64_t elapsed_ns = clock_->ElapsedNs(last_frame_tick, clock_->Now());
+                if (elapsed_ns < frame_interval_ns) {
+                    int64_t wait_ns = frame_interval_ns - elapsed_ns;
+                    if (!triggered) wait_ns = std::min(wait_ns, kArmedPollIntervalNs);
+                    if (watched && !source_faulted) Beat(WatchedStage::kCapture);
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+                    continue;
+                }
+            }
+            last_frame_tick = clock_->Now();
+
+            FrameData frame;
+            std::string error;
+            CaptureReadResult result = CaptureReadResult::kNoData;
+            if (!source_faulted) {
+                SATREC_TRACE_SCOPE("capture_frame");
+                if (ConsumeInjectedFault(WatchedStage::kCapture)) {
+                    error = "주입된 캡처 오류";
+                    result = CaptureReadResult::kError;
+                } else {
+                    result = source->CaptureFrame(&frame, &error);
+                }
+            }
+
+            if (result == CaptureReadResult::kError) {
+                if (!watched) {
+                    SATREC_LOG_ERROR("[Pipeline] ❌ 프레임 캡처 실패, 루프 종료 (총 %lld 프레임): %s",
+                                     static_cast<long long>(frame_count), error.c_str());
+                    SetLastError(error.empty() ? "프레임 캡처 실패" : error);
+                    break;
+                }
+                SATREC_LOG_ERROR("[Pipeline] ❌ 프레임 캡처 실패, 소스 재시작 대기: %s", error.c_str());
+                watchdog_.heartbeat(WatchedStage::kCapture).ReportFault();
+                source_faulted = true;
+                result = CaptureReadResult::kNoData;
+            } else if (watched && !source_faulted) {
+                Beat(WatchedStage::kCapture);
+            }
+
+            if (result == CaptureReadResult::kNoData) {
+                // 화면 변화 없음 → 마지막 프레임을 새 타임스탬프로 반복
+                // ⚠️ 중요: 정적 화면(PPT, 문서 등)에서도 비디오 스트림 유지 필요
+                if (!has_last_frame_ || !triggered) continue;
+                FrameData repeat_frame = last_frame_;
+                repeat_frame.timestamp = clock_->Now();
+                repeated_video_frames_.fetch_add(1, std::memory_order_relaxed);
+                capture_trace_.AddRepeatedFrame(repeat_frame.timestamp);
+                EnqueueFrame(std::move(repeat_frame));
+            } else {
+                if (triggered) {
+                    capture_trace_.AddVideoFrame(frame.pixels.data(), frame.width, frame.height, frame.timestamp);
+                    if (frame.acquired_at != std::chrono::steady_clock::time_point{}) {
+                        pipeline_stats_.RecordSince(PipelineStage::kCapture, frame.acquired_at);
+                    }
+                }
+                if (config_.video_frame_format == FramePixelFormat::kI420) {
+                    // 큐에 쌓이기 전에 변환 (인코더 스레드는 평면 복사만 함)
+                    SATREC_TRACE_SCOPE("convert_i420");
+                    const auto convert_started_at = std::chrono::steady_clock::now();
+                    if (!frame_converter_.ConvertToI420(&frame, &error)) {
+                        SATREC_LOG_ERROR("[Pipeline] ❌ I420 변환 실패, 루프 종료: %s", error.c_str());
+                        SetLastError(error);
+                        break;
+                    }
+                    if (triggered) pipeline_stats_.RecordSince(PipelineStage::kConvert, convert_started_at);
+                }
+                last_frame_ = frame;
+                has_last_frame_ = true;
+                if (!triggered) continue;
+                captured_video_frames_.fetch_add(1, std::memory_order_relaxed);
+                EnqueueFrame(std::move(frame));
+            }
+
+            frame_count++;
+            if (frame_count == 1) {
+                SATREC_LOG_INFO("[Pipeline] 🎬 첫 번째 프레임 캡처 성공!");
+            }
+            if (frame_count % (static_cast<int64_t>(fps) * 10) == 0) {  // 10초마다 로그
+                const double seconds = static_cast<double>(
+                    clock_->ElapsedNs(start_tick_.load(std::memory_order_relaxed), last_frame_tick)) / 1e9;
+                SATREC_LOG_INFO("[Pipeline] 📊 캡처된 프레임: %lld (실제 FPS: %.1f)",
+                                static_cast<long long>(frame_count),
+                                seconds > 0.0 ? static_cast<double>(frame_count) / seconds : 0.0);
+            }
+        }
+    } catch (const std::exception& e) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 캡처 스레드 예외 발생: %s", e.what());
+        SetLastError(std::string("캡처 스레드 예외: ") + e.what());
+    }
+
+    capturing_.store(false, std::memory_order_release);
+    SATREC_LOG_INFO("[Pipeline] 캡처 루프 종료, 총 %lld 프레임 캡처됨", static_cast<long long>(frame_count));
+}
+
+void RecordingPipeline::AudioLoop() {
+    TraceRecorder::Instance().SetThreadName("audio");
+    ScopedThreadPolicy thread_policy(ThreadRole::kAudio, config_.thread_policy);
+    IAudioSource* source = config_.audio_source;
+    int64_t packet_count = 0;
+    // 감시 중이면 소스 오류(장치 무효화 등)에서 스레드를 끝내지 않고 재시작 요청을 기다림
+    const bool watched = IsWatched(WatchedStage::kAudio);
+    bool source_faulted = false;
+
+    try {
+        bool failed = false;
+        while (!failed && !stop_requested_.load(std::memory_order_acquire)) {
+            if (watched && watchdog_.heartbeat(WatchedStage::kAudio).TakeRestartRequest()) {
+                source_faulted = !RestartAudioSource();
+            }
+            // 쌓인 패킷 모두 꺼내기 (무음 구간도 패킷 전달, A/V 동기화 유지)
+            const bool inject_error = !source_faulted && ConsumeInjectedFault(WatchedStage::kAudio);
+            while (!source_faulted) {
+                SATREC_TRACE_SCOPE("audio_packet");
+                AudioSample sample;
+                std::string error;
+                CaptureReadResult result;
+                if (inject_error) {
+                    error = "주입된 오디오 오류";
+                    result = CaptureReadResult::kError;
+                } else {
+                    result = source->ReadPacket(&sample, &error);
+                }
+                if (result == CaptureReadResult::kNoData) break;
+                if (result == CaptureReadResult::kError) {
+                    if (watched) {
+                        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 캡처 실패, 소스 재시작 대기: %s", error.c_str());
+                        watchdog_.heartbeat(WatchedStage::kAudio).ReportFault();
+                        source_faulted = true;
+                    } else {
+                        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 캡처 실패, 오디오 스레드 종료: %s", error.c_str());
+                        failed = true;
+                    }
+                    break;
+                }
+
+                float rms = 0.0f;
+                float peak = 0.0f;
+                CalculateAudioLevel(sample, &rms, &peak);
+                audio_level_.store(rms, std::memory_order_relaxed);
+                audio_peak_level_.store(peak, std::memory_order_relaxed);
+
+                // 준비 상태에서는 레벨만 갱신하고 버림 (트리거 이전에 캡처된 패킷도 버림)
+                if (!IsTriggered() || sample.timestamp < trigger_tick_.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                capture_trace_.AddAudio(sample.data.data(), sample.data.size(), sample.frame_count,
+                                        sample.timestamp);
+                EnqueueAudioSample(std::move(sample));
+
+                packet_count++;
+                if (packet_count == 1) {
+                    SATREC_LOG_INFO("[Pipeline] 🎤 첫 번째 오디오 샘플 캡처 성공!");
+                }
+                if (packet_count % 500 == 0) {
+                    SATREC_LOG_INFO("[Pipeline] 📊 오디오 샘플: %lld개 캡처됨", static_cast<long long>(packet_count));
+                }
+            }
+            // WASAPI loopback은 재생 중인 소리가 없으면 패킷이 없으므로 패킷 수가 아니라 읽기 반복을 진행으로 봄
+            if (watched && !source_faulted) Beat(WatchedStage::kAudio);
+            std::this_thread::sleep_for(kAudioPollInterval);
+        }
+    } catch (const std::exception& e) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 스레드 예외 발생: %s", e.what());
+    }
+
+    SATREC_LOG_INFO("[Pipeline] 오디오 캡처 스레드 종료, 총 %lld개 샘플 캡처됨", static_cast<long long>(packet_count));
+}
+
+// ============================================================================
+// 인코더 스레드
+// ============================================================================
+
+bool RecordingPipeline::ProcessNextVideoFrame() {
+    FrameData frame;
+    if (!frame_queue_->TryPop(&frame)) {
+        return false;
+    }
+
+    if (IsPastPostRoll(frame.timestamp)) {
+        return true;
+    }
+    if (!encoder_) {
+        // 인코더 재시작 실패 → 다음 재시작까지 버림
+        dropped_video_frames_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    RebaseEncoderOnce(frame.timestamp);
+
+    pipeline_stats_.Record(PipelineStage::kVideoQueue, clock_->ElapsedNs(frame.timestamp, clock_->Now()));
+    SATREC_TRACE_SCOPE("encode_video");
+
+    // ⚠️ 중요: 캡처 시점 타임스탬프를 인코더에 전달 (A/V 동기화 핵심)
+    const bool encoded = frame.format == FramePixelFormat::kI420
+        ? encoder_->EncodeVideoI420(frame.pixels.data(), frame.pixels.size(), frame.timestamp)
+        : encoder_->EncodeVideo(frame.pixels.data(), frame.pixels.size(), frame.timestamp);
+    if (!encoded) {
+        OnEncodeFailure(encoder_->GetLastError());
+        return true;
+    }
+    if (IsWatched(WatchedStage::kEncoder)) Beat(WatchedStage::kEncoder);
+    pipeline_stats_.Record(PipelineStage::kVideoTotal, clock_->ElapsedNs(frame.timestamp, clock_->Now()));
+
+    const int64_t count = video_frame_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count == 1 || count % 300 == 0) {
+        SATREC_LOG_INFO("[Pipeline] 비디오 프레임 #%lld 인코딩 완료", static_cast<long long>(count));
+    }
+    if (count == 1) {
+        EmitEvent(RecorderEventType::kFirstFrameEncoded);
+    }
+    return true;
+}
+
+bool RecordingPipeline::ProcessNextAudioSample() {
+    AudioSample audio;
+    if (!audio_queue_->TryPop(&audio)) {
+        return false;
+    }
+
+    if (IsPastPostRoll(audio.timestamp)) {
+        return true;
+    }
+    if (!encoder_) {
+        dropped_audio_packets_.fetch_add(1, std::memory_order_relaxed);
+        dropped_audio_samples_.fetch_add(audio.frame_count, std::memory_order_relaxed);
+        if (audio.sample_rate > 0) {
+            dropped_audio_us_.fetch_add(static_cast<int64_t>(audio.frame_count) * 1000000LL / audio.sample_rate,
+                                        std::memory_order_relaxed);
+        }
+        return true;
+    }
+    RebaseEncoderOnce(audio.timestamp);
+
+    pipeline_stats_.Record(PipelineStage::kAudioQueue, clock_->ElapsedNs(audio.timestamp, clock_->Now()));
+    SATREC_TRACE_SCOPE("encode_audio");
+
+    // 비디오와 동일한 시계 기준으로 PTS 계산됨
+    if (!encoder_->EncodeAudio(audio.data.data(), audio.data.size(), audio.timestamp)) {
+        const std::string encoder_error = encoder_->GetLastError();
+        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 패킷 인코딩 실패 (%zu bytes, %u frames): %s",
+                         audio.data.size(), audio.frame_count, encoder_error.c_str());
+        OnEncodeFailure(encoder_error.empty() ? "오디오 인코딩 실패" : encoder_error);
+        return true;
+    }
+    audio_sample_count_.fetch_add(audio.frame_count, std::memory_order_relaxed);
+    if (IsWatched(WatchedStage::kEncoder)) Beat(WatchedStage::kEncoder);
+    return true;
+}
+
+void RecordingPipeline::EncoderLoop() {
+    TraceRecorder::Instance().SetThreadName("encoder");
+    ScopedThreadPolicy thread_policy(ThreadRole::kEncoder, config_.thread_policy);
+    SATREC_LOG_INFO("[Pipeline] 인코더 스레드 시작");
+    const bool watched = IsWatched(WatchedStage::kEncoder);
+
+    try {
+        // 캡처 중지 후에도 큐에 남은 항목은 모두 인코딩
+        while (!producers_done_.load(std::memory_order_acquire) ||
+               !frame_queue_->Empty() || !audio_queue_->Empty()) {
+            if (discard_backlog_.load(std::memory_order_acquire)) {
+                DiscardBacklog();
+                break;
+            }
+            if (watched && watchdog_.heartbeat(WatchedStage::kEncoder).TakeRestartRequest()) {
+                RestartEncoder();
+            }
+            ServiceCommitRequest(false);
+            if (ConsumeInjectedFault(WatchedStage::kEncoder) && encoder_) {
+                OnEncodeFailure("주입된 인코딩 오류");
+            }
+            bool processed = false;
+            processed |= ProcessNextVideoFrame();
+            processed |= ProcessNextAudioSample();
+            if (!processed) {
+                // 처리할 항목이 없는 대기도 정상 진행 (큐가 찼는데 인코딩이 안 되는 경우만 정체)
+                if (watched) Beat(WatchedStage::kEncoder);
+                std::this_thread::sleep_for(kEncoderIdleSleep);
+            }
+            if (clock_->ElapsedNs(live_stats_tick_, clock_->Now()) >= kLiveStatsIntervalNs) {
+                PublishLiveStats(IsCapturing() && IsTriggered());
+            }
+        }
+    } catch (const std::exception& e) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 인코더 스레드 예외 발생: %s", e.what());
+        SetLastError(std::string("인코더 스레드 예외: ") + e.what());
+    }
+
+    // 종료 직전에 들어온 커밋 요청이 대기하지 않도록 응답
+    ServiceCommitRequest(true);
+    encoder_done_.store(true, std::memory_order_release);
+    SATREC_LOG_INFO("[Pipeline] 인코더 스레드 종료");
+}
+
+void RecordingPipeline::OnEncodeFailure(const std::string& error) {
+    if (!IsWatched(WatchedStage::kEncoder)) {
+        SetLastError(error);
+        return;
+    }
+    // 감시 스레드가 다음 확인에서 재시작 요청 → 이 스레드가 새 세그먼트로 다시 염
+    SATREC_LOG_ERROR("[Pipeline] ❌ 인코딩 실패, 인코더 재시작 대기: %s", error.c_str());
+    watchdog_.heartbeat(WatchedStage::kEncoder).ReportFault();
+}
+
+void RecordingPipeline::RestartEncoder() {
+    const auto restart_started_at = std::chrono::steady_clock::now();
+    // 1. 현재 세그먼트 닫기 (trailer까지), pre-roll/트리거 전이면 아직 남길 것이 없으므로 같은 경로를 다시 씀
+    const bool keep_path = IsPreRollActive() || !IsTriggered();
+    if (encoder_) {
+        const int64_t segment_bytes = encoder_->GetMuxedBytes();
+        encoder_->Stop();
+        encoder_.reset();
+        if (!keep_path) {
+            closed_segment_bytes_ += segment_bytes;
+            const std::wstring closed_path = RecordingSegmentPath(config_.encoder.output_path, encoder_segment_index_);
+            std::error_code ec;
+            const auto bytes = std::filesystem::file_size(std::filesystem::path(closed_path), ec);
+            EmitEvent(RecorderEventType::kSegmentClosed, ec ? segment_bytes : static_cast<int64_t>(bytes),
+                      std::filesystem::path(closed_path).u8string());
+        }
+    }
+
+    // 2. 보조 출력은 방금 닫은 세그먼트에서 끝냄 (Stop이 trailer까지 닫은 파일을 소유자가 그대로 후처리)
+    //    트리거 전이면 아직 기록한 것이 없으므로 같은 경로로 다시 엶
+    if (!keep_path && !encoder_config_.secondary_output_path.empty()) {
+        const std::string secondary_path = std::filesystem::path(encoder_config_.secondary_output_path).u8string();
+        SATREC_LOG_WARN("[Pipeline] ⚠️ 인코더 재시작으로 보조 출력 종료 (세그먼트 %d까지): %s",
+                        encoder_segment_index_ + 1, secondary_path.c_str());
+        EmitEvent(RecorderEventType::kSecondaryOutputEnded, encoder_segment_index_ + 1, secondary_path);
+        encoder_config_.secondary_output_path.clear();
+    }
+
+    // 3. 새 세그먼트
+    const int segment_index = keep_path ? encoder_segment_index_ : encoder_segment_index_ + 1;
+    LibavEncoderConfig encoder_config = encoder_config_;
+    encoder_config.output_path = RecordingSegmentPath(config_.encoder.output_path, segment_index);
+    encoder_config.start_in_preroll = IsPreRollActive();
+    auto encoder = std::make_unique<LibavEncoder>();
+    if (!encoder->Start(encoder_config)) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 인코더 재시작 실패: %s", encoder->GetLastError().c_str());
+        encoder_segment_index_ = segment_index;
+        watchdog_.heartbeat(WatchedStage::kEncoder).ReportFault();
+        return;
+    }
+    encoder_ = std::move(encoder);
+    encoder_segment_index_ = segment_index;
+    // 트리거 후면 처음 꺼낸 항목부터 새 PTS (트리거 전이면 원래대로 트리거 시점 기준)
+    segment_rebase_pending_ = encoder_rebased_;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        output_tee_ = encoder_->GetOutputTee();
+        if (!keep_path) segment_paths_.push_back(encoder_config.output_path);
+    }
+    const int restarts = encoder_restart_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    watchdog_.heartbeat(WatchedStage::kEncoder).RestartDone(clock_->Now());
+    SATREC_LOG_WARN("[Pipeline] ⚠️ 인코더 재시작 %d (%.1fms), 세그먼트: %s", restarts,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restart_started_at).count(),
+                    std::filesystem::path(encoder_config.output_path).u8string().c_str());
+    EmitEvent(RecorderEventType::kEncoderRestarted, restarts,
+              std::filesystem::path(encoder_config.output_path).u8string());
+}
+
+void RecordingPipeline::DiscardBacklog() {
+    // 생산자는 이미 끝났으므로 큐는 더 늘지 않음
+    int64_t video = 0;
+    int64_t audio = 0;
+    FrameData frame;
+    while (frame_queue_->TryPop(&frame)) video++;
+    AudioSample sample;
+    while (audio_queue_->TryPop(&sample)) {
+        audio++;
+        dropped_audio_samples_.fetch_add(sample.frame_count, std::memory_order_relaxed);
+        if (sample.sample_rate > 0) {
+            dropped_audio_us_.fetch_add(
+                static_cast<int64_t>(sample.frame_count) * 1000000LL / sample.sample_rate,
+                std::memory_order_relaxed);
+        }
+    }
+    dropped_video_frames_.fetch_add(video, std::memory_order_relaxed);
+    dropped_audio_packets_.fetch_add(audio, std::memory_order_relaxed);
+    discarded_on_stop_.fetch_add(video + audio, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// 인코더 자식 프로세스 감독
+// ============================================================================
+
+void RecordingPipeline::SyncEncoderProcessCounters() {
+    const int64_t before = video_frame_count_.load(std::memory_order_relaxed);
+    const int64_t frames = encoder_process_->GetVideoFrameCount();
+    video_frame_count_.store(frames, std::memory_order_relaxed);
+    audio_sample_count_.store(encoder_process_->GetAudioSampleCount(), std::memory_order_relaxed);
+    if (before == 0 && frames > 0) {
+        SATREC_LOG_INFO("[Pipeline] 비디오 프레임 #1 인코딩 완료 (인코더 프로세스)");
+        EmitEvent(RecorderEventType::kFirstFrameEncoded);
+    }
+}
+
+void RecordingPipeline::EncoderProcessLoop() {
+    TraceRecorder::Instance().SetThreadName("encoder_supervisor");
+    SATREC_LOG_INFO("[Pipeline] 인코더 프로세스 감독 스레드 시작 (pid %lld)",
+                    static_cast<long long>(encoder_process_->GetProcessId()));
+
+    // 캡처가 끝나면 남은 링 항목은 Stop 호출 스레드가 FinishEncoderProcess로 처리
+    while (!producers_done_.load(std::memory_order_acquire)) {
+        const EncoderProcessStatus status = encoder_process_->Poll();
+        if (status == EncoderProcessStatus::kRestarted) {
+            const int restarts = encoder_process_->GetRestartCount();
+            encoder_restart_count_.store(restarts, std::memory_order_relaxed);
+            EmitEvent(RecorderEventType::kEncoderRestarted, restarts,
+                      std::filesystem::path(encoder_process_->CurrentSegmentPath()).u8string());
+        } else if (status == EncoderProcessStatus::kFailed) {
+            // 더 인코딩할 수 없음 → 캡처 중단 (IsCapturing false, 파일은 지금까지의 세그먼트)
+            encoder_restart_count_.store(encoder_process_->GetRestartCount(), std::memory_order_relaxed);
+            SetLastError(encoder_process_->GetLastError());
+            stop_requested_.store(true, std::memory_order_release);
+            break;
+        }
+
+        if (!encoder_rebased_ && IsTriggered()) {
+            encoder_rebased_ = true;
+            rate_window_tick_ = trigger_tick_.load(std::memory_order_relaxed);
+        }
+        SyncEncoderProcessCounters();
+        if (clock_->ElapsedNs(live_stats_tick_, clock_->Now()) >= kLiveStatsIntervalNs) {
+            PublishLiveStats(IsCapturing() && IsTriggered());
+        }
+        std::this_thread::sleep_for(kEncoderProcessPollInterval);
+    }
+
+    encoder_done_.store(true, std::memory_order_release);
+    SATREC_LOG_INFO("[Pipeline] 인코더 프로세스 감독 스레드 종료");
+}
+
+bool RecordingPipeline::FinishEncoderProcess() {
+    const int64_t discarded_before = encoder_process_->GetDiscardedItems();
+    const bool closed = encoder_process_->Finish(config_.finalize_deadline_ms);
+    SyncEncoderProcessCounters();
+    encoder_restart_count_.store(encoder_process_->GetRestartCount(), std::memory_order_relaxed);
+    last_encoded_bytes_ = encoder_process_->GetMuxedBytes();
+    discarded_on_stop_.fetch_add(encoder_process_->GetDiscardedItems() - discarded_before,
+                                 std::memory_order_relaxed);
+    if (!closed && GetLastError().empty()) {
+        SetLastError(encoder_process_->GetLastError());
+    }
+    return closed;
+}
+
+// ============================================================================
+// 단계 감시
+// ============================================================================
+
+void RecordingPipeline::WatchdogLoop() {
+    TraceRecorder::Instance().SetThreadName("watchdog");
+    SATREC_LOG_INFO("[Pipeline] 단계 감시 시작 (기한 %dms, 단계별 재시작 최대 %d회)", config_.watchdog_deadline_ms,
+                    config_.stage_max_restarts);
+
+    constexpr size_t kStages = static_cast<size_t>(WatchedStage::kCount);
+    WatchdogAction actions[kStages];
+    int64_t values[kStages];
+    while (!watchdog_stop_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(kWatchdogPollInterval);
+        if (watchdog_.Check(clock_->Now(), actions, values) == 0) continue;
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            for (size_t i = 0; i < kStages; i++) {
+                watchdog_stats_[i] = watchdog_.GetStats(static_cast<WatchedStage>(i));
+            }
+        }
+        for (size_t i = 0; i < kStages; i++) {
+            const char* name = WatchedStageName(static_cast<WatchedStage>(i));
+            switch (actions[i]) {
+                case WatchdogAction::kNone:
+                    break;
+                case WatchdogAction::kRestartRequested:
+                    SATREC_LOG_WARN("[Pipeline] ⚠️ %s 단계 정체/오류 (마지막 진행 %lldms 전), 재시작 요청", name,
+                                    static_cast<long long>(values[i]));
+                    EmitEvent(RecorderEventType::kStageStalled, values[i], name);
+                    break;
+                case WatchdogAction::kRecovered:
+                    SATREC_LOG_INFO("[Pipeline] ✅ %s 단계 복구 (감지 → 재개 %lldms)", name,
+                                    static_cast<long long>(values[i]));
+                    EmitEvent(RecorderEventType::kStageRestarted, values[i], name);
+                    break;
+                case WatchdogAction::kGaveUp: {
+                    // 더 복구할 수 없음 → 캡처 중단 (IsCapturing false, 파일은 지금까지 기록한 내용으로 닫힘)
+                    const std::string error = std::string(name) + " 단계 복구 실패 (재시작 " +
+                                              std::to_string(values[i]) + "회)";
+                    SATREC_LOG_ERROR("[Pipeline] ❌ %s", error.c_str());
+                    SetLastError(error);
+                    stop_requested_.store(true, std::memory_order_release);
+                    break;
+                }
+                case WatchdogAction::kUnresponsive: {
+                    // 스레드가 호출 안에서 멈춰 재시작 요청을 가져가지 못함 → 제자리 재시작 불가, 녹화 종료
+                    const std::string error = std::string(name) + " 단계 응답 없음 (재시작 요청 후 " +
+                                              std::to_string(values[i]) + "ms)";
+                    SATREC_LOG_ERROR("[Pipeline] ❌ %s", error.c_str());
+                    SetLastError(error);
+                    stop_requested_.store(true, std::memory_order_release);
+                    break;
+                }
+            }
+        }
+    }
+    SATREC_LOG_INFO("[Pipeline] 단계 감시 종료");
+}
+
+void RecordingPipeline::StopWatchdog() {
+    watchdog_stop_.store(true, std::memory_order_release);
+    if (watchdog_thread_.joinable()) watchdog_thread_.join();
+}
+
+// ===== CPU 예산 조절 =====
+
+void RecordingPipeline::GovernorLoop() {
+    TraceRecorder::Instance().SetThreadName("cpu_governor");
+    const CpuGovernorConfig& config = config_.cpu_governor;
+    SATREC_LOG_INFO("[Pipeline] CPU 예산 조절 시작 (예산 %.0f%%, 단계 %d개)", config.budget_percent,
+                    governor_.level_count());
+
+    CpuUsageSampler sampler;
+    const auto started_at = std::chrono::steady_clock::now();
+    auto elapsed_ms = [started_at] {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_at)
+            .count();
+    };
+    int64_t next_sample_ms = 0;
+    while (!governor_stop_.load(std::memory_order_acquire)) {
+        const int64_t now_ms = elapsed_ms();
+        if (now_ms < next_sample_ms) {
+            std::this_thread::sleep_for(kGovernorStopPollInterval);
+            continue;
+        }
+        next_sample_ms = now_ms + kGovernorSampleIntervalMs;
+
+        // 인코더 자식 프로세스도 녹화 사용률에 포함 (재시작하면 pid가 바뀜)
+        sampler.SetChildProcess(GetEncoderProcessId());
+        CpuUsageSample sample;
+        if (!sampler.Sample(&sample)) continue;
+        const CpuGovernorDecision decision = governor_.Update(sample, now_ms);
+        const CpuGovernorLevel& level = governor_.current();
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            governor_stats_.last_sample = sample;
+            governor_stats_.encoder_step_delta = governor_.EncoderStepDelta();
+            if (decision.action != CpuGovernorAction::kNone) {
+                governor_stats_.level = decision.to_level;
+                governor_stats_.changes++;
+                governor_stats_.capture_fps = level.capture_fps;
+            }
+        }
+        if (decision.action == CpuGovernorAction::kNone) continue;
+
+        // 캡처 간격만 바로 바꿈 (인코더는 그대로, 파일 하나 유지)
+        capture_interval_ns_.store(1000000000LL / level.capture_fps, std::memory_order_relaxed);
+        const std::string json = CpuGovernorDecisionJson(decision, level, sample, config.budget_percent);
+        SATREC_LOG_INFO("[Pipeline] CPU 예산 조절 %s", json.c_str());
+        EmitEvent(RecorderEventType::kCpuGovernorChanged, decision.to_level, json);
+    }
+}
+
+void RecordingPipeline::StopGovernor() {
+    governor_stop_.store(true, std::memory_order_release);
+    if (governor_thread_.joinable()) governor_thread_.join();
+}
+
+CpuGovernorStats RecordingPipeline::GetCpuGovernorStats() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return governor_stats_;
+}
+
+bool RecordingPipeline::ConsumeInjectedFault(WatchedStage stage) {
+    const size_t index = static_cast<size_t>(stage);
+    if (injected_hang_ms_[index].load(std::memory_order_relaxed) > 0) {
+        const int64_t hang_ms = injected_hang_ms_[index].exchange(0, std::memory_order_acq_rel);
+        if (hang_ms > 0) {
+            SATREC_LOG_WARN("[Pipeline] ⚠️ 오류 주입: %s 단계 %lldms 멈춤", WatchedStageName(stage),
+                            static_cast<long long>(hang_ms));
+            std::this_thread::sleep_for(std::chrono::milliseconds(hang_ms));
+        }
+    }
+    return injected_error_[index].load(std::memory_order_relaxed) &&
+           injected_error_[index].exchange(false, std::memory_order_acq_rel);
+}
+
+bool RecordingPipeline::InjectStageFault(WatchedStage stage, StageFault fault, int64_t hang_ms) {
+    if (stage == WatchedStage::kCount || !IsCapturing() || !IsWatched(stage)) return false;
+    const size_t index = static_cast<size_t>(stage);
+    if (fault == StageFault::kHang) {
+        if (hang_ms <= 0) return false;
+        injected_hang_ms_[index].store(hang_ms, std::memory_order_release);
+    } else {
+        injected_error_[index].store(true, std::memory_order_release);
+    }
+    return true;
+}
+
+WatchdogStageStats RecordingPipeline::GetWatchdogStats(WatchedStage stage) const {
+    if (stage == WatchedStage::kCount) return WatchdogStageStats();
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return watchdog_stats_[static_cast<size_t>(stage)];
+}
+
+bool RecordingPipeline::RestartVideoSource() {
+    const auto restart_started_at = std::chrono::steady_clock::now();
+    IVideoSource* source = config_.video_source;
+    source->Stop();
+    std::string error;
+    if (!source->Start(&error)) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 비디오 소스(%s) 재시작 실패: %s", source->Name(), error.c_str());
+        watchdog_.heartbeat(WatchedStage::kCapture).ReportFault();
+        return false;
+    }
+    watchdog_.heartbeat(WatchedStage::kCapture).RestartDone(clock_->Now());
+    SATREC_LOG_WARN("[Pipeline] ⚠️ 비디오 소스(%s) 재시작 (%.1fms)", source->Name(),
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restart_started_at).count());
+    return true;
+}
+
+bool RecordingPipeline::RestartAudioSource() {
+    const auto restart_started_at = std::chrono::steady_clock::now();
+    IAudioSource* source = config_.audio_source;
+    // WASAPI: 오디오 클라이언트를 놓고 기본 장치로 다시 초기화 (장치가 바뀌었으면 새 장치)
+    source->Stop();
+    std::string error;
+    if (!source->Start(&error)) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 소스(%s) 재시작 실패: %s", source->Name(), error.c_str());
+        watchdog_.heartbeat(WatchedStage::kAudio).ReportFault();
+        return false;
+    }
+    // 인코더는 처음 형식으로 열려 있으므로 형식이 바뀐 장치는 받을 수 없음 (다음 재시작에서 다시 확인)
+    const AudioSourceFormat format = source->Format();
+    if (format.sample_rate != audio_format_.sample_rate || format.channels != audio_format_.channels ||
+        format.bits_per_sample != audio_format_.bits_per_sample) {
+        SATREC_LOG_ERROR("[Pipeline] ❌ 오디오 소스(%s) 재시작 후 형식 변경 (%dHz %dch → %dHz %dch)", source->Name(),
+                         audio_format_.sample_rate, audio_format_.channels, format.sample_rate, format.channels);
+        source->Stop();
+        watchdog_.heartbeat(WatchedStage::kAudio).ReportFault();
+        return false;
+    }
+    watchdog_.heartbeat(WatchedStage::kAudio).RestartDone(clock_->Now());
+    SATREC_LOG_WARN("[Pipeline] ⚠️ 오디오 소스(%s) 재시작 (%.1fms)", source->Name(),
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restart_started_at).count());
+    return true;
+}
@@ -0,0 +1,377 @@
+// 녹화 파이프라인 (캡처 소스 → FPS 간격 캡처 → 큐 → 인코더 스레드)
+// 소스만 바꾸면 Windows 러너와 Linux 부하 테스트가 같은 코드 경로를 사용
+
+#ifndef SAT_LEC_REC_RECORDING_PIPELINE_H_
+#define SAT_LEC_REC_RECORDING_PIPELINE_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "capture_queue.h"
+#include "capture_source.h"
+#include "capture_trace.h"
+#include "cpu_governor.h"
+#include "encoder_process.h"
+#include "frame_converter.h"
+#include "libav_encoder.h"
+#include "live_stats.h"
+#include "media_clock.h"
+#include "pipeline_stats.h"
+#include "pipeline_watchdog.h"
+#include "recorder_events.h"
+#include "thread_policy.h"
+
+/// 입력: 캡처 소스, 인코더 설정
+/// 출력: RecordingPipeline 시작 설정
+/// 예외: 없음
+struct RecordingPipelineConfig {
+    // 출력 경로, 해상도, FPS, 컨테이너, pre-roll 등
+    // 오디오 형식, clock, pipeline_stats는 파이프라인이 소스/자신의 값으로 채움
+    LibavEncoderConfig encoder;
+
+    // 파이프라인보다 오래 살아 있어야 함 (Start/Stop은 파이프라인이 호출)
+    IVideoSource* video_source = nullptr;
+    IAudioSource* audio_source = nullptr;  // nullptr이면 비디오만
+
+    // 소스 타임스탬프와 같은 시계 (nullptr이면 SystemMediaClock), 실제 시간으로 흘러야 함 (FPS 간격 대기)
+    const MediaClock* clock = nullptr;
+
+    size_t video_queue_capacity = 60;   // 약 2.5초 @ 24fps
+    size_t audio_queue_capacity = 100;  // 약 1초 (10ms 패킷)
+
+    // 비디오 큐 메모리 예산 (0이면 video_queue_capacity 프레임)
+    // 지정하면 큐 깊이 = 예산 / 프레임 크기 (해상도·저장 형식에 따라 달라짐, 최소 kMinVideoQueueFrames)
+    size_t video_queue_budget_bytes = 0;
+    // 큐에 넣을 프레임 형식 (kI420이면 캡처 스레드에서 변환, 1080p 기준 프레임당 8.3MB → 3.1MB)
+    FramePixelFormat video_frame_format = FramePixelFormat::kBgra;
+
+    // post-roll: Stop 호출 후 이 시간만큼 더 기록하고 종료 (0이면 바로 종료, 커밋 전 pre-roll이면 무시)
+    // 종료 시점 이후에 캡처된 프레임/오디오는 큐에 남아 있어도 인코딩하지 않음
+    int postroll_ms = 0;
+
+    // 종료 처리 기한: 캡처 중지 후 큐를 비우는 데 이 시간을 넘기면 남은 항목을 버리고 바로 파일을 닫음 (0이면 제한 없음)
+    // 버린 항목은 비디오/오디오 드롭과 discarded_on_stop에 더함, 인코딩 중인 한 항목과 인코더 flush/trailer는 기한 밖
+    int finalize_deadline_ms = 0;
+
+    // 인코더 자식 프로세스 (satrec_encoder_host 경로, 비어 있으면 이 프로세스의 인코더 스레드에서 인코딩)
+    // 지정하면 큐 대신 공유 메모리 링(슬롯 수 = 큐 깊이)으로 넘기고, 자식이 죽으면 새 세그먼트 파일로 이어서 기록
+    // pre-roll, 보조 출력, SystemMediaClock이 아닌 clock은 지원하지 않음 (Arm 실패)
+    std::string encoder_host_path;
+    // 자식이 죽거나 멈췄을 때 다시 띄우는 최대 횟수 (넘으면 캡처 중단 + 오류)
+    int encoder_max_restarts = 3;
+
+    // 단계 감시: 캡처/오디오/인코더 스레드의 heartbeat가 이 시간 동안 멈추거나 복구가 필요한 오류가 나면
+    // 그 단계만 재시작 (소스 Stop → Start, 인코더는 <이름>_part<N> 새 세그먼트), 0이면 감시 안 함 (오류 시 그 단계 종료)
+    // 재시작 후에도 같은 시간 안에 회복하지 않으면 다시 재시작, stage_max_restarts를 넘으면 오류로 녹화 종료
+    // 재시작은 단계 스레드가 요청을 가져가 스스로 수행 → 호출 안에서 돌아오지 않으면 기한 × 5 뒤 응답 없음 오류로 종료
+    int watchdog_deadline_ms = 2000;
+    int stage_max_restarts = 3;
+
+    // 캡처/오디오/인코더 스레드 우선순위·MMCSS·affinity (thread_policy.h, 인코더 자식 프로세스는 우선순위만)
+    ThreadPolicyConfig thread_policy;
+
+    // CPU 예산 조절 (cpu_governor.h, budget_percent 0이면 끔): 1초마다 녹화/시스템 CPU 사용률을 재서
+    // 캡처 fps만 낮추거나 복원 (kCpuGovernorChanged 이벤트, 인코더는 다시 열지 않으므로 파일 하나 유지)
+    // preset/인코더 스레드는 GetCpuGovernorStats().encoder_step_delta를 보고 호출자가 다음 녹화에 적용
+    CpuGovernorConfig cpu_governor;
+
+    // 캡처 trace 경로 (비어 있으면 기록 안 함, satrec_replay로 재생)
+    std::string capture_trace_path;
+
+    // 상태 이벤트 수신자 (nullptr이면 알리지 않음, 파이프라인보다 오래 살아 있어야 함)
+    // 시작/첫 프레임/정체·재시작/장치 손실·복구/파일 닫힘을 캡처·오디오·인코더·감시·Start/Stop 호출 스레드에서 전달
+    RecorderEventSink* event_sink = nullptr;
+    // true면 Stop이 종료 이벤트를 보내지 않음 (소유자가 후처리까지 마친 뒤 EmitStopEvent로 보냄, RecorderSession)
+    bool defer_stop_event = false;
+};
+
+/// 입력: 없음
+/// 출력: 드롭/반복 프레임 및 큐 깊이 통계
+/// 예외: 없음
+struct RecordingQueueStats {
+    int64_t captured_video_frames = 0;   // 새로 캡처한 프레임 (반복 제외)
+    int64_t repeated_video_frames = 0;   // 화면 변화 없음 → 마지막 프레임 재사용
+    int64_t dropped_video_frames = 0;
+    int64_t dropped_audio_packets = 0;
+    int64_t dropped_audio_samples = 0;   // 채널당 프레임 수 기준
+    int64_t dropped_audio_us = 0;
+    size_t video_queue_depth = 0;
+    size_t audio_queue_depth = 0;
+    size_t video_queue_high_water = 0;
+    size_t audio_queue_high_water = 0;
+    size_t video_queue_capacity = 0;
+    size_t audio_queue_capacity = 0;
+    size_t video_frame_bytes = 0;        // 큐에 담긴 프레임 하나의 픽셀 바이트 (저장 형식 기준)
+    int64_t discarded_on_stop = 0;       // 종료 처리 기한을 넘겨 인코딩하지 않고 버린 큐 항목 (비디오 + 오디오)
+};
+
+/// 입력: 없음
+/// 출력: CPU 예산 조절 상태 (GetCpuGovernorStats)
+/// 예외: 없음
+struct CpuGovernorStats {
+    bool enabled = false;
+    int level = 0;                // 0 = 원래 설정
+    int level_count = 1;
+    int64_t changes = 0;          // 단계 변경 횟수 (낮춤 + 복원)
+    int capture_fps = 0;          // 현재 단계의 캡처 fps
+    int encoder_step_delta = 0;   // 다음 녹화의 인코더 단계 권고 (+1 낮춤, -1 복원, BuildCpuEncoderSteps 기준)
+    CpuUsageSample last_sample;   // 마지막 측정값
+};
+
+/// 부하 테스트/벤치마크용 단계 오류 주입 (RecordingPipeline::InjectStageFault)
+enum class StageFault {
+    kHang = 0,   // 단계 스레드가 다음 반복에서 지정 시간 동안 멈춤 (WASAPI/드라이버 호출 안에서 막힌 상황)
+    kError = 1,  // 다음 소스 읽기/인코딩이 실패 (장치 무효화, 인코더 오류)
+};
+
+/// 입력: RecordingPipelineConfig
+/// 출력: 캡처/오디오/인코더 스레드로 녹화한 파일, 진행률/레벨/큐 통계
+/// 예외: 초기화 실패 시 Start가 false + error, 캡처 실패 시 IsCapturing이 false (GetLastError로 원인 확인)
+///
+/// 통계 조회 함수는 아무 스레드에서나 호출 가능하며, Stop 이후에도 다음 Start 전까지 마지막 값 유지
+/// 소스 이벤트는 파이프라인이 경과 시간을 붙여 config.event_sink로 전달
+class RecordingPipeline : private RecorderEventSink {
+public:
+    // 메모리 예산으로 큐 깊이를 정할 때 최소 프레임 수 (인코더 순간 지연 흡수)
+    static constexpr size_t kMinVideoQueueFrames = 8;
+
+    RecordingPipeline();
+    ~RecordingPipeline();
+
+    RecordingPipeline(const RecordingPipeline&) = delete;
+    RecordingPipeline& operator=(const RecordingPipeline&) = delete;
+
+    // Arm + Trigger (바로 녹화 시작)
+    bool Start(const RecordingPipelineConfig& config, std::string* error);
+    // 준비: 비디오 소스 시작(+ 프레임 버퍼 준비)은 잠깐 띄운 별도 스레드에서, 오디오 소스 시작 → 인코더 시작(출력 파일 열기)은
+    // 호출 스레드에서 동시에 진행하고 둘 다 끝나면 캡처/오디오/인코더 스레드까지 띄움
+    // 비디오 소스의 Start는 호출 스레드가 아닌 스레드에서 불리므로 COM 등 스레드별 초기화는 소스가 스스로 해야 함
+    // 트리거 전에는 캡처 프레임을 마지막 프레임으로만 보관하고 오디오는 레벨만 갱신 (큐/파일에 쓰지 않음)
+    bool Arm(const RecordingPipelineConfig& config, std::string* error);
+    // 녹화 시작: 플래그만 바꾸고 kRecordingStarted를 보냄 (준비 상태가 아니면 false)
+    // 캡처 스레드가 다음 트리거 확인(최대 1ms) 때 바로 첫 프레임을 캡처, PTS/경과 시간은 이 시점 기준
+    bool Trigger();
+    // 준비 완료 후 아직 트리거하지 않은 상태 (트리거 없이 Stop하면 미리 연 파일을 지움)
+    bool IsArmed() const { return armed_.load(std::memory_order_acquire); }
+    bool IsTriggered() const { return triggered_.load(std::memory_order_acquire); }
+    // (post-roll 대기 →) 캡처 중지 → 큐에 남은 항목 인코딩(종료 처리 기한까지) → 인코더/소스 종료
+    // 호출 스레드에서 완료까지 대기, 끝나면 kStopped/kStoppedWithError (value: Stop 호출 → 파일 닫힘 ms)
+    void Stop();
+    // 마지막 Stop 결과로 kStopped/kStoppedWithError 전송 (config.defer_stop_event일 때 소유자가 호출)
+    void EmitStopEvent();
+    // 마지막 Stop의 호출 → 파일 닫힘 시간 (post-roll 포함, 다음 Start 전까지 유지)
+    int64_t GetLastStopMs() const { return last_stop_ms_.load(std::memory_order_relaxed); }
+
+    // pre-roll 커밋 (config.encoder.start_in_preroll로 시작한 경우)
+    // 커밋 시점 = 지금 - lookback_ms, 인코더 스레드가 그 직전 키프레임부터 링을 파일로 넘길 때까지 대기
+    // 성공하면 경과 시간/이벤트 시각은 커밋 시점 기준으로 다시 셈
+    bool CommitPreRoll(int64_t lookback_ms, std::string* error, PreRollCommitInfo* info = nullptr);
+    // 커밋 전 pre-roll 중 여부 (디스크에 아직 아무것도 쓰지 않음)
+    bool IsPreRollActive() const { return preroll_active_.load(std::memory_order_acquire); }
+    // 마지막 Stop이 파일을 남겼는지 (커밋 없이 끝난 pre-roll, 트리거 없이 끝난 준비 상태면 false, 다음 Start 전까지 유지)
+    bool WroteOutput() const { return wrote_output_; }
+
+    bool IsStarted() const { return started_; }
+    // 캡처 루프 동작 중 여부 (Stop 또는 복구할 수 없는 캡처 오류 시 false)
+    bool IsCapturing() const { return capturing_.load(std::memory_order_acquire); }
+    std::string GetLastError() const;
+
+    int64_t GetVideoFrameCount() const { return video_frame_count_.load(std::memory_order_relaxed); }
+    int64_t GetAudioSampleCount() const { return audio_sample_count_.load(std::memory_order_relaxed); }
+    // 트리거 이후 경과 시간 (캡처 중이 아니거나 트리거 전이면 0)
+    int64_t GetElapsedMs() const;
+    float GetAudioLevel() const { return audio_level_.load(std::memory_order_relaxed); }
+    float GetAudioPeakLevel() const { return audio_peak_level_.load(std::memory_order_relaxed); }
+
+    RecordingQueueStats GetQueueStats() const;
+    const PipelineStats& pipeline_stats() const { return pipeline_stats_; }
+    // 공유 통계 블록 (인코더 스레드가 100ms마다 갱신, 주소는 파이프라인 수명 동안 고정)
+    const LiveStatsBlock& live_stats() const { return live_stats_.block(); }
+    bool ReadLiveStats(LiveStatsSnapshot* out) const { return live_stats_.Read(out); }
+    // 이중 출력 상태 (보조 출력 미사용 시 nullptr)
+    std::shared_ptr<const OutputTee> GetOutputTee() const;
+
+    // 인코더 자식 프로세스 상태 (in-process 인코딩이면 0 / 빈 목록, 다음 Start 전까지 유지)
+    int64_t GetEncoderProcessId() const;
+    int GetEncoderRestartCount() const { return encoder_restart_count_.load(std::memory_order_relaxed); }
+    // 이번 녹화가 남긴 파일 (인코더 재시작이 없으면 출력 경로 하나)
+    std::vector<std::wstring> GetSegmentPaths() const;
+
+    // 단계 감시 통계 (감시하지 않는 단계는 0, 다음 Start 전까지 유지)
+    WatchdogStageStats GetWatchdogStats(WatchedStage stage) const;
+    // 오류 주입 (부하 테스트/벤치마크 전용): 해당 단계 스레드가 다음 반복에서 한 번 적용
+    // kHang은 hang_ms 동안 멈춤, 녹화 중이 아니거나 감시하지 않는 단계면 false
+    bool InjectStageFault(WatchedStage stage, StageFault fault, int64_t hang_ms = 0);
+
+    // CPU 예산 조절 상태 (다음 Start 전까지 유지)
+    CpuGovernorStats GetCpuGovernorStats() const;
+
+    // 세션 요약 로그 (단계별 지연 시간 + 큐 압력)
+    void LogSummary() const;
+
+private:
+    void ResetStats();
+    void StopProducers();
+    // 인코더 스레드가 큐를 다 비울 때까지 대기, 종료 처리 기한을 넘기면 남은 항목을 버리게 함
+    void JoinEncoderWithDeadline();
+    // 큐에 남은 항목 버림 (종료 처리 기한 초과, 인코더 스레드)
+    void DiscardBacklog();
+    void CaptureLoop(int fps);
+    void AudioLoop();
+    void EncoderLoop();
+    // 인코더 자식 프로세스 감독 (자식 모드에서 인코더 스레드 대신 실행, 재시작 알림 + 통계 반영)
+    void EncoderProcessLoop();
+    // 자식이 남은 링 항목을 인코딩하고 파일을 닫을 때까지 대기 (Stop 호출 스레드, 종료 처리 기한 적용)
+    bool FinishEncoderProcess();
+    // 자식 프로세스의 인코딩 수를 파이프라인 통계로 옮김
+    void SyncEncoderProcessCounters();
+    bool ProcessNextVideoFrame();
+    bool ProcessNextAudioSample();
+    void EnqueueFrame(FrameData frame);
+    void EnqueueAudioSample(AudioSample sample);
+    // 비디오 소스 시작 직후 프레임 버퍼/변환 컨텍스트 미리 준비 (Arm의 비디오 초기화 스레드)
+    void PrepareFrameBuffers(size_t frame_bytes);
+    // 출력 파일 삭제 (트리거 없이 끝났거나 준비 중 실패)
+    void RemoveOutputFiles() const;
+    // 첫 큐 항목을 인코딩하기 전에 인코더 PTS 기준을 트리거 시점으로 옮김 (인코더 스레드)
+    // 재시작한 인코더(새 세그먼트)는 처음 꺼낸 항목의 시각을 기준으로 함
+    void RebaseEncoderOnce(uint64_t item_timestamp);
+    // post-roll 종료 시점 이후에 캡처된 항목 여부 (인코딩하지 않고 버림)
+    bool IsPastPostRoll(uint64_t timestamp) const;
+    // CommitPreRoll 요청 처리 (인코더 스레드), finished면 처리하지 않고 실패로 응답
+    void ServiceCommitRequest(bool finished);
+    // 인코더 입력 실패 처리: 감시 중이면 복구 요청 (녹화 계속), 아니면 녹화 오류로 기록
+    void OnEncodeFailure(const std::string& error);
+    // 단계 감시 스레드 (heartbeat 확인 → 정체 알림/재시작 요청/복구 알림, 한도 초과 시 오류로 종료)
+    void WatchdogLoop();
+    void StopWatchdog();
+    bool IsWatched(WatchedStage stage) const { return watchdog_.IsEnabled(stage); }
+    void Beat(WatchedStage stage) { watchdog_.heartbeat(stage).Beat(clock_->Now()); }
+    // 주입된 오류 적용 (단계 스레드): kHang이면 그 시간만큼 멈추고 false, kError면 true
+    bool ConsumeInjectedFault(WatchedStage stage);
+    // 단계 재시작 (각 단계 스레드에서 재시작 요청을 가져간 뒤 호출, 성공 시 RestartDone, 실패 시 ReportFault)
+    bool RestartVideoSource();
+    bool RestartAudioSource();
+    void RestartEncoder();
+    // CPU 예산 조절 스레드 (측정 → 단계 판단 → 캡처 간격 변경 → 이벤트)
+    void GovernorLoop();
+    void StopGovernor();
+    void SetLastError(const std::string& error);
+    // 공유 통계 블록 갱신 (Start → 인코더 스레드 → Stop 순으로 한 번에 한 스레드만 호출)
+    void PublishLiveStats(bool recording);
+    // 상태 이벤트 전달 (event_sink 미설정 시 무시)
+    void EmitEvent(RecorderEventType type, int64_t value = 0, const std::string& message = std::string());
+    // 소스 이벤트 (경과 시간을 붙여 event_sink로 전달)
+    void OnRecorderEvent(const RecorderEvent& event) override;
+
+    RecordingPipelineConfig config_;
+    const MediaClock* clock_ = &SystemMediaClock::Instance();
+    bool started_ = false;
+
+    std::unique_ptr<LibavEncoder> encoder_;
+    // 인코더 재시작용 (Arm에서 채운 오디오 형식/시계 포함 설정, 인코더 스레드 전용)
+    LibavEncoderConfig encoder_config_;
+    int encoder_segment_index_ = 0;       // in-process 인코더 세그먼트 번호 (인코더 스레드 전용)
+    bool segment_rebase_pending_ = false; // 새 세그먼트의 PTS 기준 미정 (인코더 스레드 전용)
+    int64_t closed_segment_bytes_ = 0;    // 재시작으로 닫은 세그먼트의 바이트 합 (통계 누적용)
+    AudioSourceFormat audio_format_;      // Arm에서 확인한 오디오 형식 (오디오 소스 재시작 후 비교)
+    // 자식 프로세스 모드 (encoder_ 대신, 큐 대신 공유 메모리 링)
+    std::unique_ptr<EncoderProcess> encoder_process_;
+    std::atomic<int> encoder_restart_count_{0};
+    std::vector<std::wstring> segment_paths_;
+    CaptureTraceWriter capture_trace_;
+    std::unique_ptr<CaptureQueue<FrameData>> frame_queue_;
+    std::unique_ptr<CaptureQueue<AudioSample>> audio_queue_;
+
+    std::thread capture_thread_;
+    std::thread audio_thread_;
+    std::thread encoder_thread_;
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<bool> producers_done_{false};  // 캡처/오디오 스레드 종료 후 true (인코더가 큐를 비우고 종료)
+    std::atomic<bool> encoder_done_{false};    // 인코더 스레드가 루프를 끝냄 (Stop의 기한 대기용)
+    std::atomic<bool> discard_backlog_{false};  // 종료 처리 기한 초과 → 인코더 스레드가 남은 큐를 버림
+    std::atomic<bool> capturing_{false};
+
+    // 준비/트리거 (Trigger 호출 스레드 → 캡처/오디오 스레드, trigger_tick_은 triggered_보다 먼저 기록)
+    std::atomic<bool> armed_{false};
+    std::atomic<bool> triggered_{false};
+    std::atomic<uint64_t> trigger_tick_{0};
+    bool encoder_rebased_ = false;  // 인코더 스레드 전용
+
+    // 마지막 캡처 프레임 (화면 변화 없을 때 재사용, 캡처 스레드 전용, 큐 저장 형식으로 보관)
+    FrameData last_frame_;
+    bool has_last_frame_ = false;
+    FrameConverter frame_converter_;  // 캡처 스레드 전용
+
+    mutable std::mutex state_mutex_;
+    std::string last_error_;
+    std::shared_ptr<const OutputTee> output_tee_;
+    size_t video_frame_bytes_ = 0;
+
+    PipelineStats pipeline_stats_;
+    std::atomic<uint64_t> start_tick_{0};
+    std::atomic<int64_t> video_frame_count_{0};
+    std::atomic<int64_t> audio_sample_count_{0};
+    std::atomic<float> audio_level_{0.0f};       // RMS
+    std::atomic<float> audio_peak_level_{0.0f};  // Peak
+
+    std::atomic<int64_t> captured_video_frames_{0};
+    std::atomic<int64_t> repeated_video_frames_{0};
+    std::atomic<int64_t> dropped_video_frames_{0};
+    std::atomic<int64_t> video_queue_high_water_{0};
+    std::atomic<int64_t> dropped_audio_packets_{0};
+    std::atomic<int64_t> dropped_audio_samples_{0};
+    std::atomic<int64_t> dropped_audio_us_{0};
+    std::atomic<int64_t> audio_queue_high_water_{0};
+    std::atomic<int64_t> discarded_on_stop_{0};
+    std::atomic<int64_t> last_stop_ms_{0};
+
+    // pre-roll 커밋 요청 (CommitPreRoll 호출 스레드 → 인코더 스레드)
+    std::atomic<bool> preroll_active_{false};
+    std::atomic<bool> commit_pending_{false};
+    std::mutex commit_mutex_;
+    std::condition_variable commit_cv_;
+    uint64_t commit_tick_ = 0;
+    bool commit_done_ = false;
+    bool commit_ok_ = false;
+    PreRollCommitInfo commit_info_;
+    std::string commit_error_;
+    bool wrote_output_ = false;
+    std::atomic<uint64_t> postroll_end_tick_{0};  // 0이면 제한 없음
+
+    // 단계 감시 (감시 스레드가 Check, 통계 복사본은 state_mutex_)
+    PipelineWatchdog watchdog_;
+    std::thread watchdog_thread_;
+    std::atomic<bool> watchdog_stop_{false};
+    std::array<WatchdogStageStats, static_cast<size_t>(WatchedStage::kCount)> watchdog_stats_{};
+    // 주입된 오류 (InjectStageFault → 단계 스레드)
+    std::array<std::atomic<int64_t>, static_cast<size_t>(WatchedStage::kCount)> injected_hang_ms_{};
+    std::array<std::atomic<bool>, static_cast<size_t>(WatchedStage::kCount)> injected_error_{};
+
+    // CPU 예산 조절 (조절 스레드 전용, 단계 목록은 Arm 이후 불변, 통계 복사본은 state_mutex_)
+    CpuGovernor governor_;
+    std::thread governor_thread_;
+    std::atomic<bool> governor_stop_{false};
+    CpuGovernorStats governor_stats_;
+    std::atomic<int64_t> capture_interval_ns_{0};   // 캡처 스레드가 매 반복 읽음
+
+    // 공유 통계 블록 + 구간 fps/비트레이트 계산 상태 (PublishLiveStats 전용)
+    LiveStats live_stats_;
+    uint64_t live_stats_tick_ = 0;
+    uint64_t rate_window_tick_ = 0;
+    int64_t rate_window_frames_ = 0;
+    int64_t rate_window_bytes_ = 0;
+    int64_t last_encoded_bytes_ = 0;
+    float video_fps_ = 0.0f;
+    float encoder_bitrate_kbps_ = 0.0f;
+};
+
+#endif  // SAT_LEC_REC_RECORDING_PIPELINE_H_
@@ -0,0 +1,288 @@
+// 프로세스 간 공유 메모리 링 구현
+
+#include "shared_frame_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+constexpr size_t kSlotAlignment = 64;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#ifdef _WIN32
+std::wstring PlatformName(const std::string& name) {
+    const std::string full = "Local\\" + name;
+    return std::wstring(full.begin(), full.end());
+}
+#else
+std::string PlatformName(const std::string& name) {
+    return "/" + name;
+}
+#endif
+
+}  // namespace
+
+// ============================================================================
+// SharedMemoryRegion
+// ============================================================================
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    Close();
+}
+
+bool SharedMemoryRegion::Create(const std::string& name, size_t size, std::string* error) {
+    Close();
+#ifdef _WIN32
+    const uint64_t size64 = size;
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu),
+                                        PlatformName(name).c_str());
+    if (!mapping || ::GetLastError() == ERROR_ALREADY_EXISTS) {
+        if (mapping) CloseHandle(mapping);
+        *error = "공유 메모리 생성 실패: " + name;
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        *error = "공유 메모리 매핑 실패: " + name;
+        return false;
+    }
+    mapping_ = mapping;
+    data_ = static_cast<uint8_t*>(view);
+#else
+    const std::string path = PlatformName(name);
+    const int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        *error = "공유 메모리 생성 실패: " + name + " (" + strerror(errno) + ")";
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        *error = "공유 메모리 크기 설정 실패: " + std::string(strerror(errno));
+        close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        *error = "공유 메모리 매핑 실패: " + std::string(strerror(errno));
+        shm_unlink(path.c_str());
+        return false;
+    }
+    data_ = static_cast<uint8_t*>(view);
+#endif
+    name_ = name;
+    size_ = size;
+    owner_ = true;
+    return true;
+}
+
+bool SharedMemoryRegion::Open(const std::string& name, std::string* error) {
+    Close();
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, PlatformName(name).c_str());
+    if (!mapping) {
+        *error = "공유 메모리 열기 실패: " + name;
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info{};
+    if (!view || VirtualQuery(view, &info, sizeof(info)) == 0) {
+        if (view) UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        *error = "공유 메모리 매핑 실패: " + name;
+        return false;
+    }
+    mapping_ = mapping;
+    data_ = static_cast<uint8_t*>(view);
+    size_ = info.RegionSize;
+#else
+    const int fd = shm_open(PlatformName(name).c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        *error = "공유 메모리 열기 실패: " + name + " (" + strerror(errno) + ")";
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        *error = "공유 메모리 크기 확인 실패: " + name;
+        return false;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        *error = "공유 메모리 매핑 실패: " + std::string(strerror(errno));
+        return false;
+    }
+    data_ = static_cast<uint8_t*>(view);
+    size_ = size;
+#endif
+    name_ = name;
+    owner_ = false;
+    return true;
+}
+
+void SharedMemoryRegion::Close() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    mapping_ = nullptr;
+#else
+    munmap(data_, size_);
+    if (owner_) {
+        shm_unlink(PlatformName(name_).c_str());
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+    name_.clear();
+}
+
+// ============================================================================
+// SharedSignal
+// ============================================================================
+
+SharedSignal::~SharedSignal() {
+    Detach();
+}
+
+void SharedSignal::Attach(std::atomic<uint32_t>* word, const std::string& name) {
+    Detach();
+    word_ = word;
+#ifdef _WIN32
+    // 양쪽 모두 CreateEvent (이미 있으면 같은 이벤트를 엶)
+    event_ = CreateEventW(nullptr, FALSE, FALSE, PlatformName(name).c_str());
+#else
+    (void)name;
+#endif
+}
+
+void SharedSignal::Detach() {
+#ifdef _WIN32
+    if (event_) {
+        CloseHandle(static_cast<HANDLE>(event_));
+        event_ = nullptr;
+    }
+#endif
+    word_ = nullptr;
+}
+
+void SharedSignal::Notify() {
+    if (!word_) return;
+    word_->fetch_add(1, std::memory_order_acq_rel);
+#if defined(_WIN32)
+    if (event_) SetEvent(static_cast<HANDLE>(event_));
+#elif defined(__linux__)
+    // 프로세스 간 공유 futex이므로 FUTEX_PRIVATE_FLAG 없이 호출
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word_), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void SharedSignal::Wait(uint32_t expected, int timeout_ms) {
+    if (!word_ || word_->load(std::memory_order_acquire) != expected) return;
+#if defined(_WIN32)
+    if (event_) {
+        WaitForSingleObject(static_cast<HANDLE>(event_), static_cast<DWORD>(timeout_ms));
+        return;
+    }
+#elif defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word_), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+    return;
+#endif
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::min(timeout_ms, 1)));
+}
+
+// ============================================================================
+// SharedFrameRing
+// ============================================================================
+
+size_t SharedFrameRing::RequiredBytes(size_t slot_count, size_t slot_bytes) {
+    return AlignUp(sizeof(SharedRingHeader), kSlotAlignment) +
+           slot_count * AlignUp(sizeof(SharedRingItem) + slot_bytes, kSlotAlignment);
+}
+
+bool SharedFrameRing::Attach(uint8_t* base, size_t available_bytes, size_t slot_count, size_t slot_bytes,
+                             bool init) {
+    header_ = nullptr;
+    slots_ = nullptr;
+    if (!base || slot_count == 0 || RequiredBytes(slot_count, slot_bytes) > available_bytes) {
+        return false;
+    }
+    const size_t stride = AlignUp(sizeof(SharedRingItem) + slot_bytes, kSlotAlignment);
+    auto* header = reinterpret_cast<SharedRingHeader*>(base);
+    if (init) {
+        header = new (base) SharedRingHeader();
+        header->slot_count = static_cast<uint32_t>(slot_count);
+        header->slot_bytes = static_cast<uint32_t>(stride);
+    } else if (header->slot_count != slot_count || header->slot_bytes != stride) {
+        return false;
+    }
+    header_ = header;
+    slots_ = base + AlignUp(sizeof(SharedRingHeader), kSlotAlignment);
+    return true;
+}
+
+SharedRingItem* SharedFrameRing::Slot(uint64_t index) const {
+    return reinterpret_cast<SharedRingItem*>(
+        slots_ + static_cast<size_t>(index % header_->slot_count) * header_->slot_bytes);
+}
+
+SharedRingItem* SharedFrameRing::TryAcquire() {
+    const uint64_t write = header_->write_index.load(std::memory_order_relaxed);
+    const uint64_t read = header_->read_index.load(std::memory_order_acquire);
+    if (write - read >= header_->slot_count) return nullptr;
+    return Slot(write);
+}
+
+void SharedFrameRing::Publish() {
+    header_->write_index.fetch_add(1, std::memory_order_release);
+}
+
+const SharedRingItem* SharedFrameRing::Peek() const {
+    const uint64_t read = header_->read_index.load(std::memory_order_relaxed);
+    const uint64_t write = header_->write_index.load(std::memory_order_acquire);
+    if (read == write) return nullptr;
+    return Slot(read);
+}
+
+void SharedFrameRing::Release() {
+    header_->read_index.fetch_add(1, std::memory_order_release);
+}
+
+size_t SharedFrameRing::Size() const {
+    if (!header_) return 0;
+    const uint64_t write = header_->write_index.load(std::memory_order_acquire);
+    const uint64_t read = header_->read_index.load(std::memory_order_acquire);
+    return static_cast<size_t>(write - read);
+}
@@ -0,0 +1,146 @@
+// 프로세스 간 프레임/오디오 전달용 공유 메모리 링 (인코더 자식 프로세스 모드)
+// 생산자(앱의 캡처/오디오 스레드)가 슬롯에 바로 쓰고, 소비자(인코더 프로세스)는 슬롯 메모리에서 바로 인코딩
+// 알림은 Linux futex (공유 메모리의 정수 하나), Windows는 이름 있는 이벤트
+
+#ifndef SAT_LEC_REC_SHARED_FRAME_RING_H_
+#define SAT_LEC_REC_SHARED_FRAME_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "공유 메모리 atomic은 lock-free여야 프로세스 간에 동작함");
+
+/// 입력: 영역 이름 (플랫폼 접두어 없이, 예: "satrec_enc_1234_1"), 크기
+/// 출력: 두 프로세스가 같은 물리 메모리를 보는 매핑
+/// 예외: 실패 시 Create/Open이 false + error
+///
+/// 만든 쪽(Create)이 소멸 시 이름도 지움 (Linux shm_unlink, Windows는 마지막 핸들이 닫힐 때 사라짐)
+class SharedMemoryRegion {
+public:
+    SharedMemoryRegion() = default;
+    ~SharedMemoryRegion();
+
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    bool Create(const std::string& name, size_t size, std::string* error);
+    bool Open(const std::string& name, std::string* error);
+    void Close();
+
+    uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool IsOpen() const { return data_ != nullptr; }
+
+private:
+    std::string name_;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+#ifdef _WIN32
+    void* mapping_ = nullptr;  // HANDLE
+#endif
+};
+
+/// 입력: 공유 메모리 안의 대기용 정수, 이름 (Windows 이벤트 이름에 사용)
+/// 출력: 프로세스 간 알림 (Notify → Wait 깨움)
+/// 예외: 없음 (Windows 이벤트 생성 실패 시 Wait이 timeout만큼 잠자는 폴링으로 동작)
+///
+/// 대기하는 쪽은 word 값을 먼저 읽고 조건을 확인한 뒤 그 값으로 Wait (그 사이 Notify는 값이 바뀌어 놓치지 않음)
+class SharedSignal {
+public:
+    SharedSignal() = default;
+    ~SharedSignal();
+
+    SharedSignal(const SharedSignal&) = delete;
+    SharedSignal& operator=(const SharedSignal&) = delete;
+
+    void Attach(std::atomic<uint32_t>* word, const std::string& name);
+    void Detach();
+
+    // word를 올리고 대기 중인 쪽을 깨움
+    void Notify();
+    // word가 expected인 동안 최대 timeout_ms 대기 (값이 이미 다르면 바로 반환)
+    void Wait(uint32_t expected, int timeout_ms);
+    uint32_t Load() const { return word_->load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t>* word_ = nullptr;
+#ifdef _WIN32
+    void* event_ = nullptr;  // HANDLE (자동 리셋)
+#endif
+};
+
+/// 공유 링 항목 종류
+enum class SharedRingItemKind : uint32_t {
+    kVideo = 1,
+    kAudio = 2,
+};
+
+/// 입력: 없음
+/// 출력: 슬롯 앞부분의 항목 헤더 (뒤에 bytes만큼 데이터)
+/// 예외: 없음
+struct SharedRingItem {
+    SharedRingItemKind kind = SharedRingItemKind::kVideo;
+    uint32_t bytes = 0;
+    uint64_t timestamp = 0;  // 캡처 시점 tick (SystemMediaClock, 두 프로세스가 같은 시계)
+    int32_t width = 0;       // 비디오
+    int32_t height = 0;
+    int32_t format = 0;      // FramePixelFormat
+    uint32_t frame_count = 0;  // 오디오
+    uint32_t sample_rate = 0;
+    uint16_t channels = 0;
+    uint16_t bits_per_sample = 0;
+    uint8_t reserved[20] = {};
+};
+static_assert(sizeof(SharedRingItem) == 64, "슬롯 데이터가 64바이트 정렬되도록 헤더 크기 고정");
+
+/// 입력: 없음
+/// 출력: 링 상태 (공유 메모리에 그대로 놓임)
+/// 예외: 없음
+struct SharedRingHeader {
+    alignas(64) std::atomic<uint64_t> write_index{0};  // 생산자만 씀
+    alignas(64) std::atomic<uint64_t> read_index{0};   // 소비자만 씀 (소비자가 죽었으면 감독자가 대신)
+    alignas(64) uint32_t slot_count = 0;
+    uint32_t slot_bytes = 0;  // 항목 헤더 포함
+};
+
+/// 입력: 공유 메모리 안의 링 영역
+/// 출력: 단일 생산자/단일 소비자 고정 슬롯 링
+/// 예외: 없음
+///
+/// 가득 차면 새 항목을 넣지 않음 (생산자가 드롭으로 셈, 소비자가 쓰는 슬롯은 덮어쓸 수 없음)
+/// 생산자: TryAcquire → 데이터 쓰기 → Publish, 소비자: Peek → 슬롯에서 바로 처리 → Release
+class SharedFrameRing {
+public:
+    // slot_bytes: 항목 하나의 최대 데이터 크기 (헤더 제외)
+    static size_t RequiredBytes(size_t slot_count, size_t slot_bytes);
+
+    // init이면 헤더를 초기화 (만드는 쪽), 아니면 기존 헤더를 검사
+    bool Attach(uint8_t* base, size_t available_bytes, size_t slot_count, size_t slot_bytes, bool init);
+
+    // 생산자: 빈 슬롯 (가득 찼으면 nullptr), 데이터는 Payload(item)에 최대 MaxItemBytes()까지
+    SharedRingItem* TryAcquire();
+    void Publish();
+
+    // 소비자: 가장 오래된 항목 (비었으면 nullptr), 처리 후 Release
+    const SharedRingItem* Peek() const;
+    void Release();
+
+    static uint8_t* Payload(SharedRingItem* item) { return reinterpret_cast<uint8_t*>(item + 1); }
+    static const uint8_t* Payload(const SharedRingItem* item) { return reinterpret_cast<const uint8_t*>(item + 1); }
+
+    size_t Size() const;
+    size_t Capacity() const { return header_ ? header_->slot_count : 0; }
+    size_t MaxItemBytes() const { return header_ ? header_->slot_bytes - sizeof(SharedRingItem) : 0; }
+
+private:
+    SharedRingItem* Slot(uint64_t index) const;
+
+    SharedRingHeader* header_ = nullptr;
+    uint8_t* slots_ = nullptr;
+};
+
+#endif  // SAT_LEC_REC_SHARED_FRAME_RING_H_
@@ -0,0 +1,157 @@
+// 합성 강의 콘텐츠 생성기 구현
+
+#include "synthetic_lecture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// 슬라이드 배경색 (B, G, R)
+constexpr uint8_t kSlidePalette[][3] = {
+    {245, 245, 245}, {235, 225, 210}, {210, 235, 225}, {225, 215, 240}, {200, 220, 245},
+};
+
+// 슬라이드/줄 번호로 결정되는 의사 난수 (텍스트 줄 길이용)
+uint32_t Hash(uint32_t a, uint32_t b) {
+    uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+void FillRect(uint8_t* bgra, int stride_pixels, const SyntheticRect& rect,
+              uint8_t b, uint8_t g, uint8_t r) {
+    for (int y = rect.y; y < rect.y + rect.height; ++y) {
+        uint8_t* pixel = bgra + (static_cast<size_t>(y) * stride_pixels + rect.x) * 4;
+        for (int x = 0; x < rect.width; ++x, pixel += 4) {
+            pixel[0] = b;
+            pixel[1] = g;
+            pixel[2] = r;
+            pixel[3] = 255;
+        }
+    }
+}
+
+}  // namespace
+
+SyntheticLecture::SyntheticLecture(const SyntheticLectureConfig& config) : config_(config) {
+    // 최소값 보정 (마커/움직이는 영역이 화면 안에 들어가야 함)
+    config_.width = std::max(config_.width, 64);
+    config_.height = std::max(config_.height, 64);
+    config_.fps = std::max(config_.fps, 1);
+    config_.sample_rate = std::max(config_.sample_rate, 8000);
+    config_.channels = std::max(config_.channels, 1);
+
+    marker_frame_interval_ = std::max<int64_t>(
+        1, std::llround(config_.marker_interval_seconds * config_.fps));
+    marker_frame_length_ = std::clamp<int64_t>(
+        std::llround(config_.marker_duration_seconds * config_.fps), 1, marker_frame_interval_);
+    slide_frame_interval_ = std::max<int64_t>(
+        1, std::llround(config_.slide_interval_seconds * config_.fps));
+
+    // 마커: 오른쪽 위 모서리 (움직이는 영역은 화면 위 1/5 아래로만 이동)
+    const int marker_size = std::max(config_.height / 10, 8);
+    const int margin = config_.height / 40;
+    marker_rect_ = {config_.width - marker_size - margin, margin, marker_size, marker_size};
+}
+
+bool SyntheticLecture::IsMarkerFrame(int64_t frame_index) const {
+    return frame_index >= marker_frame_interval_ &&
+           frame_index % marker_frame_interval_ < marker_frame_length_;
+}
+
+void SyntheticLecture::RenderSlide(int64_t slide_index) {
+    const int width = config_.width;
+    const int height = config_.height;
+    slide_pixels_.resize(FrameBytes());
+
+    const auto& color = kSlidePalette[slide_index % (sizeof(kSlidePalette) / sizeof(kSlidePalette[0]))];
+    FillRect(slide_pixels_.data(), width, {0, 0, width, height}, color[0], color[1], color[2]);
+
+    // 제목 띠
+    FillRect(slide_pixels_.data(), width, {0, 0, width, height / 8}, 90, 60, 30);
+
+    // 본문 텍스트 줄 (길이가 다른 짙은 막대)
+    const int line_height = std::max(height / 30, 2);
+    const int left = width / 16;
+    const int max_length = width * 3 / 5;
+    const uint32_t slide_key = static_cast<uint32_t>(slide_index);
+    for (int line = 0, y = height / 5; y + line_height < height - height / 10;
+         ++line, y += line_height * 2) {
+        const int length = max_length / 3 +
+                           static_cast<int>(Hash(slide_key, static_cast<uint32_t>(line)) %
+                                            static_cast<uint32_t>(max_length * 2 / 3));
+        FillRect(slide_pixels_.data(), width, {left, y, length, line_height}, 40, 40, 40);
+    }
+    cached_slide_index_ = slide_index;
+}
+
+void SyntheticLecture::RenderVideoFrame(int64_t frame_index, uint8_t* bgra) {
+    const int64_t slide_index = frame_index / slide_frame_interval_;
+    if (slide_index != cached_slide_index_) {
+        RenderSlide(slide_index);
+    }
+    std::memcpy(bgra, slide_pixels_.data(), FrameBytes());
+
+    const int width = config_.width;
+    const int height = config_.height;
+
+    // 움직이는 영역: 리사주 궤적을 따라 이동하는 스크롤 체커 패턴
+    const int box_width = width / 5;
+    const int box_height = height / 5;
+    const double t = static_cast<double>(frame_index) / config_.fps;
+    const int min_y = height / 5;
+    const int range_x = width - box_width;
+    const int range_y = height - box_height - min_y;
+    const int box_x = static_cast<int>((0.5 + 0.5 * std::sin(t * 0.37)) * range_x);
+    const int box_y = min_y + static_cast<int>((0.5 + 0.5 * std::sin(t * 0.23 + 1.0)) * range_y);
+    const int scroll = static_cast<int>(frame_index * 4);
+    for (int y = 0; y < box_height; ++y) {
+        uint8_t* pixel = bgra + (static_cast<size_t>(box_y + y) * width + box_x) * 4;
+        for (int x = 0; x < box_width; ++x, pixel += 4) {
+            const bool dark = (((x + scroll) / 16) + (y / 16)) & 1;
+            pixel[0] = dark ? 60 : 200;
+            pixel[1] = dark ? 30 : static_cast<uint8_t>(x * 255 / box_width);
+            pixel[2] = dark ? 20 : static_cast<uint8_t>(y * 255 / box_height);
+            pixel[3] = 255;
+        }
+    }
+
+    // 마커: 비프음 구간에만 흰색, 나머지는 검은색
+    const uint8_t level = IsMarkerFrame(frame_index) ? 255 : 0;
+    FillRect(bgra, width, marker_rect_, level, level, level);
+}
+
+void SyntheticLecture::RenderAudio(int64_t first_sample, int frame_count, float* interleaved) const {
+    const int64_t sample_rate = config_.sample_rate;
+    const int64_t fps = config_.fps;
+    // 마커 k의 시작 샘플 = (k × marker_frame_interval 프레임의 시작 시각) × sample_rate
+    const int64_t marker_samples_den = marker_frame_interval_ * sample_rate;
+    const int64_t beep_length = std::max<int64_t>(
+        1, std::llround(config_.marker_duration_seconds * config_.sample_rate));
+
+    for (int i = 0; i < frame_count; ++i) {
+        const int64_t sample = first_sample + i;
+        const int64_t marker = sample * fps / marker_samples_den;
+        const int64_t beep_start = marker * marker_samples_den / fps;
+        float value;
+        if (marker >= 1 && sample - beep_start < beep_length) {
+            const double phase = std::fmod(static_cast<double>(sample - beep_start) * config_.beep_hz /
+                                           static_cast<double>(sample_rate), 1.0);
+            value = config_.beep_amplitude * static_cast<float>(std::sin(kTwoPi * phase));
+        } else {
+            // 긴 녹화에서도 정밀도 유지를 위해 위상을 [0, 1)로 접음
+            const double phase = std::fmod(static_cast<double>(sample) * config_.tone_hz /
+                                           static_cast<double>(sample_rate), 1.0);
+            value = config_.tone_amplitude * static_cast<float>(std::sin(kTwoPi * phase));
+        }
+        for (int channel = 0; channel < config_.channels; ++channel) {
+            interleaved[static_cast<size_t>(i) * config_.channels + channel] = value;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// 합성 강의 콘텐츠 생성기 (장시간 soak 테스트, 벤치마크용)
+// 실제 강의 화면/소리와 비슷한 부하를 결정적으로 재현:
+// - 몇 분마다 바뀌는 슬라이드 (배경 + 텍스트 줄 모양 막대)
+// - 화면 안을 계속 움직이는 영역 (발표자 영상/포인터 역할)
+// - 낮은 음량의 연속 톤 + 일정 간격의 비프음
+// - 비프음 시작 샘플과 정확히 같은 프레임에 켜지는 마커 사각형 (A/V 오프셋 측정용)
+
+#ifndef SAT_LEC_REC_SYNTHETIC_LECTURE_H_
+#define SAT_LEC_REC_SYNTHETIC_LECTURE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// 입력: 해상도, FPS, 오디오 형식, 슬라이드/마커 간격
+/// 출력: SyntheticLecture 생성 설정
+/// 예외: 없음 (잘못된 값은 SyntheticLecture가 최소값으로 보정)
+struct SyntheticLectureConfig {
+    int width = 1920;
+    int height = 1080;
+    int fps = 24;
+    int sample_rate = 48000;
+    int channels = 2;
+
+    double slide_interval_seconds = 180.0;  // 슬라이드 전환 간격
+    double marker_interval_seconds = 10.0;  // 비프음 + 플래시 간격
+    double marker_duration_seconds = 0.1;   // 비프음/플래시 길이
+
+    double tone_hz = 440.0;
+    float tone_amplitude = 0.05f;   // 배경 톤 (마커 검출 임계값보다 충분히 작게)
+    double beep_hz = 1000.0;
+    float beep_amplitude = 0.5f;
+};
+
+/// 화면 위 사각형 (픽셀 단위)
+struct SyntheticRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+/// 입력: SyntheticLectureConfig
+/// 출력: 프레임 번호별 BGRA 프레임, 샘플 위치별 Interleaved Float32 오디오
+/// 예외: 없음
+///
+/// 프레임/샘플 번호만으로 결과가 정해지므로 같은 설정이면 항상 같은 콘텐츠
+/// (N번째 마커: 프레임 N × marker_frame_interval, 샘플 = 그 프레임 시작 시각)
+class SyntheticLecture {
+public:
+    explicit SyntheticLecture(const SyntheticLectureConfig& config);
+
+    const SyntheticLectureConfig& config() const { return config_; }
+    size_t FrameBytes() const { return static_cast<size_t>(config_.width) * config_.height * 4; }
+
+    // 입력: 프레임 번호, 출력 버퍼 (FrameBytes() 바이트)
+    void RenderVideoFrame(int64_t frame_index, uint8_t* bgra);
+
+    // 입력: 시작 샘플 위치 (채널당), 프레임 수, 출력 버퍼 (frame_count × channels 개 float)
+    void RenderAudio(int64_t first_sample, int frame_count, float* interleaved) const;
+
+    // 마커 정보 (A/V 오프셋 분석용)
+    SyntheticRect MarkerRegion() const { return marker_rect_; }
+    int64_t MarkerFrameInterval() const { return marker_frame_interval_; }
+    bool IsMarkerFrame(int64_t frame_index) const;
+    // 마커 검출 임계값 (배경 톤 최대값과 비프음 최대값의 중간)
+    float BeepThreshold() const { return (config_.tone_amplitude + config_.beep_amplitude) / 2.0f; }
+
+private:
+    void RenderSlide(int64_t slide_index);
+
+    SyntheticLectureConfig config_;
+    SyntheticRect marker_rect_;
+    int64_t marker_frame_interval_ = 0;  // 마커 사이 프레임 수
+    int64_t marker_frame_length_ = 1;    // 플래시가 켜져 있는 프레임 수
+    int64_t slide_frame_interval_ = 0;
+
+    // 현재 슬라이드 배경 캐시 (슬라이드가 바뀔 때만 다시 그림)
+    std::vector<uint8_t> slide_pixels_;
+    int64_t cached_slide_index_ = -1;
+};
+
+#endif  // SAT_LEC_REC_SYNTHETIC_LECTURE_H_
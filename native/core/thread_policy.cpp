@@ -0,0 +1,282 @@
+// 녹화 스레드 우선순위/MMCSS/CPU affinity 정책 구현
+
+#include "thread_policy.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "native_logger.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <avrt.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifndef _WIN32
+// SCHED_RR 우선순위 (1~99 중 낮은 값, 커널 스레드/IRQ 스레드보다 아래)
+constexpr int kCaptureRealtimePriority = 10;
+constexpr int kAudioRealtimePriority = 20;
+// SCHED_RR 권한이 없을 때 nice 조정 (음수는 RLIMIT_NICE/CAP_SYS_NICE 필요)
+constexpr int kCaptureNiceDelta = -5;
+constexpr int kAudioNiceDelta = -10;
+// 인코더는 권한 없이도 항상 가능한 방향 (nice 증가)
+constexpr int kEncoderNiceDelta = 5;
+
+// 현재 스레드 id (setpriority는 Linux에서 스레드 단위)
+id_t CurrentThreadId() {
+    return static_cast<id_t>(syscall(SYS_gettid));
+}
+#endif
+
+uint64_t RoleCpus(ThreadRole role, const ThreadPolicyConfig& config) {
+    switch (role) {
+        case ThreadRole::kCapture: return config.capture_cpus;
+        case ThreadRole::kAudio: return config.audio_cpus;
+        case ThreadRole::kEncoder: return config.encoder_cpus;
+    }
+    return 0;
+}
+
+#ifdef _WIN32
+// 선호 코어 (마스크의 가장 낮은 비트)
+int LowestCpu(uint64_t mask) {
+    for (int cpu = 0; cpu < 64; cpu++) {
+        if (mask & (1ULL << cpu)) return cpu;
+    }
+    return -1;
+}
+#endif
+
+void AppendDetail(std::string* detail, const std::string& part) {
+    if (!detail->empty()) *detail += ", ";
+    *detail += part;
+}
+
+}  // namespace
+
+const char* ThreadRoleName(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::kCapture: return "capture";
+        case ThreadRole::kAudio: return "audio";
+        case ThreadRole::kEncoder: return "encoder";
+    }
+    return "unknown";
+}
+
+#ifdef _WIN32
+
+struct ScopedThreadPolicy::SavedState {
+    HANDLE mmcss = nullptr;
+    int old_priority = THREAD_PRIORITY_ERROR_RETURN;
+    DWORD_PTR old_affinity = 0;
+    DWORD old_ideal = static_cast<DWORD>(-1);
+};
+
+ScopedThreadPolicy::ScopedThreadPolicy(ThreadRole role, const ThreadPolicyConfig& config)
+    : saved_(std::make_unique<SavedState>()) {
+    if (!config.enabled) return;
+    HANDLE thread = GetCurrentThread();
+    bool requested_failed = false;
+
+    // 1. 우선순위: 오디오/캡처는 MMCSS (실패 시 스레드 우선순위), 인코더는 한 단계 낮춤
+    //    THREAD_MODE_BACKGROUND_BEGIN은 I/O·메모리 우선순위까지 낮춰 파일 기록이 밀리므로 쓰지 않음
+    if (role != ThreadRole::kEncoder && config.use_mmcss) {
+        DWORD task_index = 0;
+        const wchar_t* task = role == ThreadRole::kAudio ? L"Pro Audio" : L"Capture";
+        saved_->mmcss = AvSetMmThreadCharacteristicsW(task, &task_index);
+        if (saved_->mmcss) {
+            result_.mmcss = true;
+            result_.priority = true;
+            AppendDetail(&result_.detail, role == ThreadRole::kAudio ? "MMCSS Pro Audio" : "MMCSS Capture");
+        } else {
+            AppendDetail(&result_.detail, "MMCSS 등록 실패 (오류 " + std::to_string(GetLastError()) + ")");
+        }
+    }
+    if (!result_.mmcss) {
+        const int priority = role == ThreadRole::kAudio     ? THREAD_PRIORITY_HIGHEST
+                             : role == ThreadRole::kCapture ? THREAD_PRIORITY_ABOVE_NORMAL
+                                                            : THREAD_PRIORITY_BELOW_NORMAL;
+        saved_->old_priority = GetThreadPriority(thread);
+        if (SetThreadPriority(thread, priority)) {
+            result_.priority = true;
+            AppendDetail(&result_.detail, "우선순위 " + std::to_string(priority));
+        } else {
+            saved_->old_priority = THREAD_PRIORITY_ERROR_RETURN;
+            requested_failed = true;
+            AppendDetail(&result_.detail, "우선순위 변경 실패 (오류 " + std::to_string(GetLastError()) + ")");
+        }
+    }
+
+    // 2. affinity
+    const uint64_t cpus = RoleCpus(role, config);
+    if (config.affinity_mode == ThreadAffinityMode::kHard && cpus != 0) {
+        saved_->old_affinity = SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(cpus));
+        if (saved_->old_affinity != 0) {
+            result_.affinity = true;
+            char mask[32];
+            snprintf(mask, sizeof(mask), "0x%llx", static_cast<unsigned long long>(cpus));
+            AppendDetail(&result_.detail, std::string("affinity ") + mask);
+        } else {
+            requested_failed = true;
+            AppendDetail(&result_.detail, "affinity 실패 (프로세스 affinity 밖의 CPU)");
+        }
+    } else if (config.affinity_mode == ThreadAffinityMode::kSoft && cpus != 0) {
+        const int cpu = LowestCpu(cpus);
+        saved_->old_ideal = SetThreadIdealProcessor(thread, static_cast<DWORD>(cpu));
+        if (saved_->old_ideal != static_cast<DWORD>(-1)) {
+            result_.affinity = true;
+            AppendDetail(&result_.detail, "선호 코어 " + std::to_string(cpu));
+        } else {
+            requested_failed = true;
+            AppendDetail(&result_.detail, "선호 코어 지정 실패");
+        }
+    }
+
+    if (requested_failed) {
+        SATREC_LOG_WARN("[ThreadPolicy] ⚠️ %s 스레드 정책 일부 실패: %s", ThreadRoleName(role), result_.detail.c_str());
+    } else {
+        SATREC_LOG_INFO("[ThreadPolicy] %s 스레드: %s", ThreadRoleName(role), result_.detail.c_str());
+    }
+}
+
+ScopedThreadPolicy::~ScopedThreadPolicy() {
+    HANDLE thread = GetCurrentThread();
+    if (saved_->old_ideal != static_cast<DWORD>(-1)) SetThreadIdealProcessor(thread, saved_->old_ideal);
+    if (saved_->old_affinity != 0) SetThreadAffinityMask(thread, saved_->old_affinity);
+    if (saved_->old_priority != THREAD_PRIORITY_ERROR_RETURN) SetThreadPriority(thread, saved_->old_priority);
+    if (saved_->mmcss) AvRevertMmThreadCharacteristics(saved_->mmcss);
+}
+
+bool ApplyEncoderProcessPriority(std::string* detail) {
+    // 코덱 작업 스레드는 우선순위를 물려받지 않으므로 프로세스 우선순위 클래스로 낮춤
+    if (!SetPriorityClass(GetCurrentProcess(), BELOW_NORMAL_PRIORITY_CLASS)) {
+        *detail = "우선순위 클래스 변경 실패 (오류 " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    *detail = "BELOW_NORMAL_PRIORITY_CLASS";
+    return true;
+}
+
+#else
+
+struct ScopedThreadPolicy::SavedState {
+    bool sched_changed = false;
+    int old_policy = SCHED_OTHER;
+    sched_param old_param{};
+    bool nice_changed = false;
+    int old_nice = 0;
+    bool affinity_changed = false;
+    cpu_set_t old_affinity;
+};
+
+ScopedThreadPolicy::ScopedThreadPolicy(ThreadRole role, const ThreadPolicyConfig& config)
+    : saved_(std::make_unique<SavedState>()) {
+    if (!config.enabled) return;
+    const pthread_t thread = pthread_self();
+    bool requested_failed = false;
+
+    // 1. 우선순위: 오디오/캡처는 SCHED_RR (권한이 없으면 nice 낮춤), 인코더는 nice 높임
+    if (role != ThreadRole::kEncoder && config.use_mmcss &&
+        pthread_getschedparam(thread, &saved_->old_policy, &saved_->old_param) == 0) {
+        sched_param param{};
+        param.sched_priority = role == ThreadRole::kAudio ? kAudioRealtimePriority : kCaptureRealtimePriority;
+        const int rc = pthread_setschedparam(thread, SCHED_RR, &param);
+        if (rc == 0) {
+            saved_->sched_changed = true;
+            result_.mmcss = true;
+            result_.priority = true;
+            AppendDetail(&result_.detail, "SCHED_RR " + std::to_string(param.sched_priority));
+        } else {
+            AppendDetail(&result_.detail, std::string("SCHED_RR 실패 (") + strerror(rc) + ")");
+        }
+    }
+    if (!result_.mmcss) {
+        const int delta = role == ThreadRole::kAudio     ? kAudioNiceDelta
+                          : role == ThreadRole::kCapture ? kCaptureNiceDelta
+                                                         : kEncoderNiceDelta;
+        const id_t tid = CurrentThreadId();
+        errno = 0;
+        const int old_nice = getpriority(PRIO_PROCESS, tid);
+        const int target = std::clamp(old_nice + delta, -20, 19);
+        if (errno == 0 && setpriority(PRIO_PROCESS, tid, target) == 0) {
+            saved_->nice_changed = true;
+            saved_->old_nice = old_nice;
+            result_.priority = true;
+            AppendDetail(&result_.detail, "nice " + std::to_string(target));
+        } else {
+            // 권한 없는 nice 낮춤 실패는 흔함 (기본 우선순위로 계속)
+            requested_failed = true;
+            AppendDetail(&result_.detail, std::string("nice 변경 실패 (") + strerror(errno) + ")");
+        }
+    }
+
+    // 2. affinity (Linux에는 선호 코어 개념이 없어 kSoft는 적용하지 않음)
+    const uint64_t cpus = RoleCpus(role, config);
+    if (config.affinity_mode == ThreadAffinityMode::kHard && cpus != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+            if (cpus & (1ULL << cpu)) CPU_SET(cpu, &set);
+        }
+        const bool saved = pthread_getaffinity_np(thread, sizeof(cpu_set_t), &saved_->old_affinity) == 0;
+        const int rc = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &set);
+        if (rc == 0) {
+            saved_->affinity_changed = saved;
+            result_.affinity = true;
+            char mask[32];
+            snprintf(mask, sizeof(mask), "0x%llx", static_cast<unsigned long long>(cpus));
+            AppendDetail(&result_.detail, std::string("affinity ") + mask);
+        } else {
+            requested_failed = true;
+            AppendDetail(&result_.detail, std::string("affinity 실패 (") + strerror(rc) + ")");
+        }
+    } else if (config.affinity_mode == ThreadAffinityMode::kSoft && cpus != 0) {
+        AppendDetail(&result_.detail, "선호 코어 미지원 (Linux)");
+    }
+
+    if (requested_failed) {
+        SATREC_LOG_WARN("[ThreadPolicy] ⚠️ %s 스레드 정책 일부 실패: %s", ThreadRoleName(role), result_.detail.c_str());
+    } else {
+        SATREC_LOG_INFO("[ThreadPolicy] %s 스레드: %s", ThreadRoleName(role), result_.detail.c_str());
+    }
+}
+
+ScopedThreadPolicy::~ScopedThreadPolicy() {
+    const pthread_t thread = pthread_self();
+    if (saved_->affinity_changed) {
+        pthread_setaffinity_np(thread, sizeof(cpu_set_t), &saved_->old_affinity);
+    }
+    if (saved_->nice_changed) {
+        // nice를 다시 낮추는 방향이면 권한이 없어 실패할 수 있음 (스레드가 곧 끝나므로 무시)
+        setpriority(PRIO_PROCESS, CurrentThreadId(), saved_->old_nice);
+    }
+    if (saved_->sched_changed) {
+        pthread_setschedparam(thread, saved_->old_policy, &saved_->old_param);
+    }
+}
+
+bool ApplyEncoderProcessPriority(std::string* detail) {
+    // 이후 만드는 코덱 작업 스레드가 이 스레드의 nice를 물려받음
+    const id_t tid = CurrentThreadId();
+    errno = 0;
+    const int old_nice = getpriority(PRIO_PROCESS, tid);
+    const int target = std::clamp(old_nice + kEncoderNiceDelta, -20, 19);
+    if (errno != 0 || setpriority(PRIO_PROCESS, tid, target) != 0) {
+        *detail = std::string("nice 변경 실패 (") + strerror(errno) + ")";
+        return false;
+    }
+    *detail = "nice " + std::to_string(target);
+    return true;
+}
+
+#endif
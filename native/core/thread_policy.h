@@ -0,0 +1,84 @@
+// 녹화 스레드 우선순위/MMCSS/CPU affinity 정책
+// Zoom 등 CPU를 많이 쓰는 프로그램과 같이 돌 때 오디오/캡처가 밀리지 않도록 단계 스레드마다 적용
+// Windows: 오디오/캡처는 MMCSS("Pro Audio"/"Capture") 등록, 인코더는 우선순위 낮춤
+// Linux: 오디오/캡처는 SCHED_RR (권한이 없으면 nice 낮춤), 인코더는 nice 높임
+
+#ifndef SAT_LEC_REC_THREAD_POLICY_H_
+#define SAT_LEC_REC_THREAD_POLICY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// 정책을 적용할 스레드 역할
+enum class ThreadRole {
+    kCapture = 0,  // 캡처 스레드 (FPS 간격 캡처 + 변환)
+    kAudio = 1,    // 오디오 스레드 (10ms 간격 폴링, 밀리면 바로 끊김)
+    kEncoder = 2,  // 인코더 스레드 / 인코더 자식 프로세스
+};
+
+// 로그용 역할 이름 (capture, audio, encoder)
+const char* ThreadRoleName(ThreadRole role);
+
+/// CPU affinity 적용 방식
+enum class ThreadAffinityMode {
+    kNone = 0,  // 지정 안 함 (OS 스케줄러에 맡김)
+    kSoft = 1,  // 선호 코어만 지정 (Windows ideal processor, 다른 코어로 옮길 수 있음, Linux는 미지원)
+    kHard = 2,  // 지정한 코어에서만 실행 (SetThreadAffinityMask / pthread_setaffinity_np)
+};
+
+/// 입력: 없음
+/// 출력: 스레드 정책 설정
+/// 예외: 없음
+struct ThreadPolicyConfig {
+    // false면 OS 기본 우선순위 그대로 (정책 비교 측정용)
+    bool enabled = true;
+    // 오디오/캡처를 MMCSS(Linux: SCHED_RR)에 등록, 실패하거나 false면 스레드 우선순위만 올림
+    bool use_mmcss = true;
+    ThreadAffinityMode affinity_mode = ThreadAffinityMode::kNone;
+    // 역할별 CPU 비트마스크 (bit n = 논리 CPU n, 0이면 그 역할은 지정 안 함)
+    // kSoft는 가장 낮은 비트 하나만 선호 코어로 씀
+    uint64_t capture_cpus = 0;
+    uint64_t audio_cpus = 0;
+    uint64_t encoder_cpus = 0;
+};
+
+/// 입력: 없음
+/// 출력: 스레드 하나에 실제 적용된 정책 (권한/OS 지원에 따라 일부만 적용될 수 있음)
+/// 예외: 없음
+struct ThreadPolicyResult {
+    bool mmcss = false;     // MMCSS(Linux: SCHED_RR) 등록
+    bool priority = false;  // 우선순위 변경 (MMCSS 등록 포함)
+    bool affinity = false;  // affinity/선호 코어 지정
+    std::string detail;     // 적용 내용 또는 실패 원인 (로그용)
+};
+
+/// 입력: 역할, 정책 설정 (생성한 스레드에 바로 적용)
+/// 출력: 적용 결과 (result)
+/// 예외: 없음 - 적용 실패는 경고 로그만 남기고 녹화는 계속
+///
+/// 스레드 함수 맨 앞에서 지역 변수로 만들고, 소멸 시 MMCSS 해제 + 이전 우선순위/affinity 복구
+/// (Linux에서 nice를 다시 낮추는 것은 권한이 필요해 복구되지 않을 수 있음)
+/// 생성/소멸은 같은 스레드에서 해야 함
+class ScopedThreadPolicy {
+public:
+    ScopedThreadPolicy(ThreadRole role, const ThreadPolicyConfig& config);
+    ~ScopedThreadPolicy();
+
+    ScopedThreadPolicy(const ScopedThreadPolicy&) = delete;
+    ScopedThreadPolicy& operator=(const ScopedThreadPolicy&) = delete;
+
+    const ThreadPolicyResult& result() const { return result_; }
+
+private:
+    struct SavedState;  // 복구할 이전 상태 (플랫폼별)
+
+    ThreadPolicyResult result_;
+    std::unique_ptr<SavedState> saved_;
+};
+
+// 인코더 자식 프로세스 전체를 인코더 역할 우선순위로 (코덱 내부 작업 스레드 포함)
+// 인코더를 열기 전에 호출 (Linux는 이후 만든 스레드가 nice를 물려받음), 실패하면 false
+bool ApplyEncoderProcessPriority(std::string* detail);
+
+#endif  // SAT_LEC_REC_THREAD_POLICY_H_
@@ -0,0 +1,293 @@
+// 네이티브 파이프라인 trace 기록 구현
+
+#include "trace_recorder.h"
+
+#include <filesystem>
+
+#include "native_logger.h"
+
+namespace {
+
+// 현재 스레드의 ring buffer (최초 이벤트 기록 시 등록, 스레드 종료 시 반환)
+struct ThreadBufferLease {
+    std::atomic<bool>* in_use = nullptr;
+    void* buffer = nullptr;
+    ~ThreadBufferLease() {
+        if (in_use) in_use->store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadBufferLease t_lease;
+
+FILE* OpenFileUtf8(const std::string& path) {
+    FILE* file = nullptr;
+#ifdef _WIN32
+    std::wstring wide_path = std::filesystem::u8path(path).wstring();
+    if (_wfopen_s(&file, wide_path.c_str(), L"wb") != 0) {
+        return nullptr;
+    }
+#else
+    file = fopen(path.c_str(), "wb");
+#endif
+    return file;
+}
+
+// JSON 문자열 출력 (이벤트/스레드 이름은 코드에서 정한 값이므로 최소한의 escape만 수행)
+void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p; p++) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+constexpr auto kWriterInterval = std::chrono::milliseconds(50);
+
+}  // namespace
+
+// ==============================================================================
+// 시작 / 종료
+// ==============================================================================
+
+TraceRecorder& TraceRecorder::Instance() {
+    // 종료 순서 문제를 피하기 위해 해제하지 않음 (detach된 스레드가 종료 중에 기록할 수 있음)
+    static TraceRecorder* instance = new TraceRecorder();
+    return *instance;
+}
+
+TraceRecorder::~TraceRecorder() {
+    Stop();
+}
+
+int64_t TraceRecorder::NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool TraceRecorder::Start(const std::string& path, std::string* error) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (file_ || writer_.joinable()) {
+        if (error) *error = "이미 trace 기록 중입니다";
+        return false;
+    }
+
+    file_ = OpenFileUtf8(path);
+    if (!file_) {
+        if (error) *error = "trace 파일 열기 실패: " + path;
+        return false;
+    }
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file_);
+    first_event_ = true;
+    written_events_.store(0, std::memory_order_relaxed);
+
+    // 이전 세션에서 남은 이벤트 폐기 (writer 스레드가 없으므로 tail 변경 안전)
+    {
+        std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+        for (auto& buffer : buffers_) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+            buffer->name_written = false;
+        }
+    }
+
+    stop_requested_ = false;
+    writer_ = std::thread(&TraceRecorder::WriterLoop, this);
+    enabled_.store(true, std::memory_order_release);
+
+    SATREC_LOG_INFO("[TraceRecorder] ✅ trace 기록 시작: %s", path.c_str());
+    return true;
+}
+
+void TraceRecorder::Stop() {
+    enabled_.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        if (!writer_.joinable()) return;
+        stop_requested_ = true;
+    }
+    writer_cv_.notify_all();
+    writer_.join();
+
+    // writer 스레드가 마지막 drain까지 마친 상태
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (file_) {
+        fputs("\n]}\n", file_);
+        fclose(file_);
+        file_ = nullptr;
+    }
+
+    SATREC_LOG_INFO("[TraceRecorder] ✅ trace 기록 종료: 이벤트 %lld개 (버림 %lld개)",
+                    static_cast<long long>(GetWrittenEventCount()),
+                    static_cast<long long>(GetDroppedEventCount()));
+}
+
+int64_t TraceRecorder::GetDroppedEventCount() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    int64_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ==============================================================================
+// 이벤트 기록 (녹화 스레드)
+// ==============================================================================
+
+TraceRecorder::ThreadBuffer* TraceRecorder::GetThreadBuffer() {
+    if (t_lease.buffer) {
+        return static_cast<ThreadBuffer*>(t_lease.buffer);
+    }
+    // 스레드당 1회만 lock (녹화마다 스레드가 새로 생기므로 종료된 스레드의 buffer 재사용)
+    ThreadBuffer* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (auto& candidate : buffers_) {
+            if (candidate->head.load(std::memory_order_relaxed) !=
+                candidate->tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            bool expected = false;
+            if (candidate->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                buffer = candidate.get();
+                buffer->thread_name.clear();
+                buffer->name_written = false;
+                break;
+            }
+        }
+        if (!buffer) {
+            buffers_.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers_.back().get();
+            buffer->thread_id = static_cast<uint32_t>(buffers_.size());
+        }
+    }
+    t_lease.buffer = buffer;
+    t_lease.in_use = &buffer->in_use;
+    return buffer;
+}
+
+void TraceRecorder::SetThreadName(const char* name) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    buffer->thread_name = name ? name : "";
+}
+
+void TraceRecorder::Push(EventType type, const char* name, int64_t timestamp_ns, int64_t value) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    const uint32_t head = buffer->head.load(std::memory_order_relaxed);
+    const uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= ThreadBuffer::kCapacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = buffer->events[head & (ThreadBuffer::kCapacity - 1)];
+    event.name = name;
+    event.timestamp_ns = timestamp_ns;
+    event.value = value;
+    event.type = type;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Complete(const char* name, int64_t start_ns, int64_t duration_ns) {
+    if (!IsEnabled()) return;
+    Push(EventType::kComplete, name, start_ns, duration_ns);
+}
+
+void TraceRecorder::Counter(const char* name, int64_t value) {
+    if (!IsEnabled()) return;
+    Push(EventType::kCounter, name, NowNs(), value);
+}
+
+void TraceRecorder::Instant(const char* name) {
+    if (!IsEnabled()) return;
+    Push(EventType::kInstant, name, NowNs(), 0);
+}
+
+// ==============================================================================
+// 직렬화 (writer 스레드)
+// ==============================================================================
+
+void TraceRecorder::WriterLoop() {
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    while (!stop_requested_) {
+        writer_cv_.wait_for(lock, kWriterInterval, [this] { return stop_requested_; });
+        lock.unlock();
+        DrainAll();
+        lock.lock();
+    }
+    lock.unlock();
+    // 종료 직전 기록된 이벤트까지 모두 기록
+    DrainAll();
+}
+
+void TraceRecorder::DrainAll() {
+    // 등록된 buffer 목록 복사 (buffer 자체는 해제되지 않으므로 포인터 사용 안전)
+    std::vector<ThreadBuffer*> buffers;
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers.reserve(buffers_.size());
+        for (auto& buffer : buffers_) {
+            buffers.push_back(buffer.get());
+            names.push_back(buffer->thread_name);
+        }
+    }
+
+    for (size_t i = 0; i < buffers.size(); i++) {
+        ThreadBuffer& buffer = *buffers[i];
+        const uint32_t head = buffer.head.load(std::memory_order_acquire);
+        uint32_t tail = buffer.tail.load(std::memory_order_relaxed);
+        if (head == tail) continue;
+
+        // 스레드 이름 메타데이터 (이벤트가 있는 스레드만)
+        if (!buffer.name_written && !names[i].empty()) {
+            fprintf(file_, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                    first_event_ ? "" : ",\n", buffer.thread_id);
+            WriteJsonString(file_, names[i].c_str());
+            fputs("}}", file_);
+            first_event_ = false;
+            buffer.name_written = true;
+        }
+
+        for (; tail != head; tail++) {
+            WriteEvent(buffer, buffer.events[tail & (ThreadBuffer::kCapacity - 1)]);
+        }
+        buffer.tail.store(tail, std::memory_order_release);
+    }
+    fflush(file_);
+}
+
+void TraceRecorder::WriteEvent(const ThreadBuffer& buffer, const Event& event) {
+    // ts/dur 단위: µs (소수점 이하 ns 유지)
+    const double ts_us = static_cast<double>(event.timestamp_ns) / 1000.0;
+
+    fputs(first_event_ ? "{\"name\":" : ",\n{\"name\":", file_);
+    first_event_ = false;
+    WriteJsonString(file_, event.name ? event.name : "?");
+
+    switch (event.type) {
+        case EventType::kComplete:
+            fprintf(file_, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer.thread_id, ts_us, static_cast<double>(event.value) / 1000.0);
+            break;
+        case EventType::kCounter:
+            fprintf(file_, ",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                    buffer.thread_id, ts_us, static_cast<long long>(event.value));
+            break;
+        case EventType::kInstant:
+            fprintf(file_, ",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                    buffer.thread_id, ts_us);
+            break;
+    }
+    written_events_.fetch_add(1, std::memory_order_relaxed);
+}
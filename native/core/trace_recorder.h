@@ -0,0 +1,142 @@
+// 네이티브 파이프라인 trace 기록 (Chrome trace-event JSON)
+// chrome://tracing 또는 Perfetto UI(ui.perfetto.dev)에서 열어 스레드별 타임라인 확인
+
+#ifndef SAT_LEC_REC_TRACE_RECORDER_H_
+#define SAT_LEC_REC_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// 입력: Start(경로) 이후 각 스레드에서 기록한 이벤트
+/// 출력: Chrome trace-event 형식 JSON 파일
+/// 예외: 파일 열기 실패 시 Start()가 false 반환
+///
+/// ⚠️ 비용 구조
+/// - 비활성 상태: atomic load 1회 후 반환
+/// - 활성 상태: 스레드 전용 ring buffer(SPSC)에 고정 크기 이벤트 1개 기록 (lock/할당 없음)
+/// - JSON 직렬화와 파일 쓰기는 전용 writer 스레드에서 주기적으로 수행
+/// - ring이 가득 차면 이벤트를 버리고 개수만 기록 (녹화 스레드를 막지 않음)
+///
+/// ⚠️ 이벤트 이름은 문자열 리터럴처럼 프로그램 종료까지 유효한 포인터여야 함
+class TraceRecorder {
+public:
+    static TraceRecorder& Instance();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // trace 시작 (이미 기록 중이면 false)
+    bool Start(const std::string& path, std::string* error);
+    // 남은 이벤트를 모두 기록하고 JSON 닫기
+    void Stop();
+
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // 현재 스레드 이름 (trace 뷰어의 행 이름, 활성 여부와 관계없이 호출 가능)
+    void SetThreadName(const char* name);
+
+    // 이벤트 기록 (비활성 상태면 무시)
+    void Complete(const char* name, int64_t start_ns, int64_t duration_ns);
+    void Counter(const char* name, int64_t value);
+    void Instant(const char* name);
+
+    // trace 기준 시각 (steady_clock, 나노초)
+    static int64_t NowNs();
+
+    int64_t GetWrittenEventCount() const { return written_events_.load(std::memory_order_relaxed); }
+    int64_t GetDroppedEventCount() const;
+
+private:
+    enum class EventType : uint8_t { kComplete, kCounter, kInstant };
+
+    struct Event {
+        const char* name;
+        int64_t timestamp_ns;
+        int64_t value;  // kComplete: duration_ns, kCounter: 값
+        EventType type;
+    };
+
+    // 스레드 하나가 쓰고 writer 스레드가 읽는 ring buffer
+    struct ThreadBuffer {
+        static constexpr uint32_t kCapacity = 8192;  // 2의 거듭제곱
+
+        Event events[kCapacity];
+        std::atomic<uint32_t> head{0};     // 다음 쓰기 위치 (생산자)
+        std::atomic<uint32_t> tail{0};     // 다음 읽기 위치 (writer 스레드)
+        std::atomic<int64_t> dropped{0};
+        std::atomic<bool> in_use{true};    // 스레드 종료 시 false → 새 스레드가 재사용
+        uint32_t thread_id = 0;
+        std::string thread_name;           // registry_mutex_로 보호
+        bool name_written = false;         // writer 스레드 전용
+    };
+
+    TraceRecorder() = default;
+    ~TraceRecorder();
+
+    ThreadBuffer* GetThreadBuffer();
+    void Push(EventType type, const char* name, int64_t timestamp_ns, int64_t value);
+
+    void WriterLoop();
+    void DrainAll();
+    void WriteEvent(const ThreadBuffer& buffer, const Event& event);
+
+    std::atomic<bool> enabled_{false};
+
+    mutable std::mutex registry_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;  // 스레드가 종료되어도 유지
+
+    std::mutex writer_mutex_;
+    std::condition_variable writer_cv_;
+    std::thread writer_;
+    bool stop_requested_ = false;
+    FILE* file_ = nullptr;            // writer 스레드 / Stop에서만 사용
+    bool first_event_ = true;
+    std::atomic<int64_t> written_events_{0};
+};
+
+/// 입력: 이벤트 이름 (문자열 리터럴)
+/// 출력: 스코프 종료 시 duration 이벤트 1개 기록
+/// 예외: 없음
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(TraceRecorder::Instance().IsEnabled() ? name : nullptr),
+          start_ns_(name_ ? TraceRecorder::NowNs() : 0) {}
+    ~TraceScope() {
+        if (name_) {
+            TraceRecorder::Instance().Complete(name_, start_ns_, TraceRecorder::NowNs() - start_ns_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    int64_t start_ns_;
+};
+
+#define SATREC_TRACE_CONCAT_INNER(a, b) a##b
+#define SATREC_TRACE_CONCAT(a, b) SATREC_TRACE_CONCAT_INNER(a, b)
+
+// 현재 스코프 구간 기록
+#define SATREC_TRACE_SCOPE(name) \
+    TraceScope SATREC_TRACE_CONCAT(satrec_trace_scope_, __LINE__)(name)
+
+// 카운터 값 기록 (큐 깊이 등)
+#define SATREC_TRACE_COUNTER(name, value)                                          \
+    do {                                                                           \
+        if (TraceRecorder::Instance().IsEnabled()) {                               \
+            TraceRecorder::Instance().Counter(name, static_cast<int64_t>(value));  \
+        }                                                                          \
+    } while (0)
+
+#endif  // SAT_LEC_REC_TRACE_RECORDER_H_
@@ -0,0 +1,58 @@
+// satrec_encoder_host: 녹화 앱이 띄우는 인코더 자식 프로세스
+// 공유 메모리 링의 프레임/오디오를 인코딩해 파일로 기록 (FFmpeg/드라이버 크래시를 앱과 분리)
+//
+// 사용법: satrec_encoder_host --channel <채널 이름> [--log <로그 파일>] [--lower-priority]
+// 직접 실행하지 않음 (EncoderProcess가 채널을 만들고 실행)
+// 종료 코드: 0 정상 종료, 1 인자/채널 오류, 2 인코더 시작 실패
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "encoder_process.h"
+#include "native_logger.h"
+#include "thread_policy.h"
+
+static void PrintUsage() {
+    fprintf(stderr, "사용법: satrec_encoder_host --channel <채널 이름> [--log <로그 파일>] [--lower-priority]\n");
+}
+
+int main(int argc, char** argv) {
+    std::string channel_name;
+    std::string log_path;
+    bool lower_priority = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--channel") == 0 && i + 1 < argc) {
+            channel_name = argv[++i];
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (strcmp(argv[i], "--lower-priority") == 0) {
+            lower_priority = true;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (channel_name.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    // 앱과 같은 로그 파일에 기록 (콘솔은 없음)
+    NativeLogger::Instance().SetFilePath(log_path);
+    NativeLogger::Instance().SetConsoleEnabled(log_path.empty());
+
+    // 인코더를 열기 전에 낮춰야 코덱 작업 스레드까지 적용 (캡처/오디오가 있는 앱 프로세스가 먼저)
+    if (lower_priority) {
+        std::string detail;
+        if (ApplyEncoderProcessPriority(&detail)) {
+            SATREC_LOG_INFO("[EncoderHost] 프로세스 우선순위: %s", detail.c_str());
+        } else {
+            SATREC_LOG_WARN("[EncoderHost] ⚠️ 프로세스 우선순위 변경 실패: %s", detail.c_str());
+        }
+    }
+
+    const int exit_code = RunEncoderHost(channel_name);
+    NativeLogger::Instance().Flush();
+    return exit_code;
+}
@@ -0,0 +1,565 @@
+// satrec_loadtest: 합성/파일 캡처 소스로 런너와 같은 녹화 파이프라인(FPS 간격 캡처 → 큐 → 인코더)을
+// 실제 시간으로 돌려 부하를 측정하는 명령줄 도구 (Linux 프로파일링용, perf/VTune으로 감싸서 사용)
+//
+// 사용법: satrec_loadtest [--source synthetic|file:<경로>] [--seconds <초>] [--fps <n>] [--size <W>x<H>]
+//                         [--video-only] [--output <경로>] [--container mp4|mkv|ts] [--keep]
+//                         [--frame-format bgra|i420] [--queue-budget-mb <MB>]
+//                         [--preroll-seconds <초>] [--postroll-ms <ms>] [--sessions <n>]
+//                         [--stop-deadline-ms <ms>] [--encoder-host <경로>] [--kill-encoder-after <초>]
+//                         [--watchdog-deadline-ms <ms>] [--inject-fault <단계>:error|hang:<ms>@<초>]
+//                         [--no-thread-policy] [--cpu-budget <%>] [--load-threads <n>] [--load-window <초>:<초>]
+// --preroll-seconds: 메모리 링에만 인코딩하다가 그 시점에 커밋 (커밋 호출 지연을 commit_ms로 출력)
+// --sessions: 녹화 세션 n개를 동시에 (세션마다 소스/큐/인코더/출력 파일, 결과 JSON도 세션마다 한 줄)
+// --stop-deadline-ms: 종료 처리 기한 (중지 요청 반환 stop_return_ms, 파일 닫힘까지 finalize_ms를 출력)
+// --encoder-host: satrec_encoder_host 자식 프로세스로 인코딩 (공유 메모리 링)
+// --kill-encoder-after: 그 시점에 인코더 프로세스를 강제 종료해 재시작/새 세그먼트를 확인 (재시작이 없으면 실패)
+// --inject-fault: 그 시점에 단계(capture|audio|encoder)에 오류/멈춤을 주입해 단계 감시 재시작을 확인
+//                 (복구하지 못하면 실패, 감지 → 재개 시간을 max_recovery_ms로 출력, 요청을 못 받으면 stage_unresponsive)
+// --no-thread-policy: 캡처/오디오/인코더 스레드를 OS 기본 우선순위로 (스레드 정책 비교용)
+// --cpu-budget: 녹화 CPU 예산 (전체 CPU 대비 %), 단계 변경은 stderr와 governor_* 필드로 출력
+// --load-threads/--load-window: 그 구간(기본 전체)에 쉬지 않고 도는 스레드 n개로 다른 프로그램(Zoom) 부하를 흉내
+// 종료 코드: 0 성공, 1 인자 오류, 2 파이프라인 시작 실패, 3 녹화 중 캡처/인코딩 오류
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/types.h>
+#endif
+
+#include "file_source.h"
+#include "generator_source.h"
+#include "native_logger.h"
+#include "pipeline_stats.h"
+#include "pipeline_watchdog.h"
+#include "recorder_events.h"
+#include "recorder_session.h"
+#include "recording_pipeline.h"
+
+namespace {
+
+// 이벤트 경로 확인용: 첫 프레임 인코딩 시점과 정체 횟수를 결과 JSON에 포함
+class LoadTestEventSink : public RecorderEventSink {
+public:
+    void OnRecorderEvent(const RecorderEvent& event) override {
+        if (event.type == RecorderEventType::kFirstFrameEncoded) {
+            first_frame_ms.store(event.elapsed_ms, std::memory_order_relaxed);
+        } else if (event.type == RecorderEventType::kEncoderRestarted) {
+            encoder_restarts.fetch_add(1, std::memory_order_relaxed);
+            fprintf(stderr, "⚠️ 인코더 프로세스 재시작 #%lld (녹화 %lldms 시점): %s\n",
+                    static_cast<long long>(event.value), static_cast<long long>(event.elapsed_ms),
+                    event.message.c_str());
+        } else if (event.type == RecorderEventType::kStageRestarted) {
+            fprintf(stderr, "✅ %s 재시작 후 복구 %lldms (녹화 %lldms 시점)\n", event.message.c_str(),
+                    static_cast<long long>(event.value), static_cast<long long>(event.elapsed_ms));
+        } else if (event.type == RecorderEventType::kCpuGovernorChanged) {
+            fprintf(stderr, "⚖️ CPU 예산 조절 단계 %lld (녹화 %lldms 시점): %s\n", static_cast<long long>(event.value),
+                    static_cast<long long>(event.elapsed_ms), event.message.c_str());
+        } else if (event.type == RecorderEventType::kStageStalled) {
+            stall_events.fetch_add(1, std::memory_order_relaxed);
+            fprintf(stderr, "⚠️ %s 정체 %lldms (녹화 %lldms 시점)\n", event.message.c_str(),
+                    static_cast<long long>(event.value), static_cast<long long>(event.elapsed_ms));
+        }
+    }
+
+    std::atomic<int64_t> first_frame_ms{-1};
+    std::atomic<int64_t> stall_events{0};
+    std::atomic<int64_t> encoder_restarts{0};
+};
+
+struct LoadTestOptions {
+    std::string file_path;  // 비어 있으면 합성 소스
+    double seconds = 30.0;
+    int fps = 24;
+    int width = 1920;
+    int height = 1080;
+    bool video_only = false;
+    bool keep_output = false;
+    std::string output_path;
+    RecordingContainer container = RecordingContainer::kFragmentedMp4;
+    FramePixelFormat frame_format = FramePixelFormat::kBgra;
+    double queue_budget_mb = 0.0;  // 0이면 기본 프레임 수 큐
+    double preroll_seconds = 0.0;  // 0이면 처음부터 파일 기록
+    int postroll_ms = 0;
+    int sessions = 1;
+    int stop_deadline_ms = 0;  // 0이면 남은 큐를 모두 인코딩
+    std::string encoder_host_path;  // 비어 있으면 이 프로세스에서 인코딩
+    double kill_encoder_after = 0.0;  // 0이면 강제 종료하지 않음
+    int watchdog_deadline_ms = 2000;
+    bool thread_policy = true;
+    bool inject_fault = false;
+    WatchedStage fault_stage = WatchedStage::kCapture;
+    StageFault fault = StageFault::kError;
+    int64_t fault_hang_ms = 0;
+    double fault_at = 0.0;
+    double cpu_budget_percent = 0.0;  // 0이면 CPU 예산 조절 안 함
+    int load_threads = 0;
+    double load_start = 0.0;
+    double load_end = -1.0;  // 음수면 끝까지
+};
+
+void PrintUsage() {
+    fprintf(stderr, "사용법: satrec_loadtest [--source synthetic|file:<경로>] [--seconds <초>] [--fps <n>] "
+                    "[--size <W>x<H>] [--video-only] [--output <경로>] [--container mp4|mkv|ts] [--keep] "
+                    "[--frame-format bgra|i420] [--queue-budget-mb <MB>] "
+                    "[--preroll-seconds <초>] [--postroll-ms <ms>] [--sessions <n>] [--stop-deadline-ms <ms>] "
+                    "[--encoder-host <경로>] [--kill-encoder-after <초>] "
+                    "[--watchdog-deadline-ms <ms>] [--inject-fault <단계>:error|hang:<ms>@<초>] "
+                    "[--no-thread-policy] [--cpu-budget <%%>] [--load-threads <n>] [--load-window <초>:<초>]\n");
+}
+
+// 입력: "<단계>:error@<초>" 또는 "<단계>:hang:<ms>@<초>" (단계: capture, audio, encoder)
+// 출력: options의 주입 설정, 형식이 틀리면 false
+bool ParseFaultSpec(const char* value, LoadTestOptions* options) {
+    char stage[16] = {};
+    char kind[16] = {};
+    long long hang_ms = 0;
+    double at = 0.0;
+    if (sscanf(value, "%15[a-z]:hang:%lld@%lf", stage, &hang_ms, &at) == 3) {
+        if (hang_ms <= 0) return false;
+        options->fault = StageFault::kHang;
+        options->fault_hang_ms = hang_ms;
+    } else if (sscanf(value, "%15[a-z]:%15[a-z]@%lf", stage, kind, &at) == 3 && strcmp(kind, "error") == 0) {
+        options->fault = StageFault::kError;
+    } else {
+        return false;
+    }
+    if (strcmp(stage, "capture") == 0) {
+        options->fault_stage = WatchedStage::kCapture;
+    } else if (strcmp(stage, "audio") == 0) {
+        options->fault_stage = WatchedStage::kAudio;
+    } else if (strcmp(stage, "encoder") == 0) {
+        options->fault_stage = WatchedStage::kEncoder;
+    } else {
+        return false;
+    }
+    options->inject_fault = true;
+    options->fault_at = at;
+    return at > 0.0;
+}
+
+bool ParseOptions(int argc, char** argv, LoadTestOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strncmp(value, "file:", 5) == 0 && value[5] != '\0') {
+                options->file_path = value + 5;
+            } else if (strcmp(value, "synthetic") != 0) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            options->seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            options->fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &options->width, &options->height) != 2) return false;
+        } else if (strcmp(argv[i], "--video-only") == 0) {
+            options->video_only = true;
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            options->keep_output = true;
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options->output_path = argv[++i];
+        } else if (strcmp(argv[i], "--container") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "mp4") == 0) {
+                options->container = RecordingContainer::kFragmentedMp4;
+            } else if (strcmp(value, "mkv") == 0) {
+                options->container = RecordingContainer::kMatroska;
+            } else if (strcmp(value, "ts") == 0) {
+                options->container = RecordingContainer::kMpegTs;
+            } else {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--frame-format") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "bgra") == 0) {
+                options->frame_format = FramePixelFormat::kBgra;
+            } else if (strcmp(value, "i420") == 0) {
+                options->frame_format = FramePixelFormat::kI420;
+            } else {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--queue-budget-mb") == 0 && i + 1 < argc) {
+            options->queue_budget_mb = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--preroll-seconds") == 0 && i + 1 < argc) {
+            options->preroll_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--postroll-ms") == 0 && i + 1 < argc) {
+            options->postroll_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sessions") == 0 && i + 1 < argc) {
+            options->sessions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--stop-deadline-ms") == 0 && i + 1 < argc) {
+            options->stop_deadline_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--encoder-host") == 0 && i + 1 < argc) {
+            options->encoder_host_path = argv[++i];
+        } else if (strcmp(argv[i], "--kill-encoder-after") == 0 && i + 1 < argc) {
+            options->kill_encoder_after = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--watchdog-deadline-ms") == 0 && i + 1 < argc) {
+            options->watchdog_deadline_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--inject-fault") == 0 && i + 1 < argc) {
+            if (!ParseFaultSpec(argv[++i], options)) return false;
+        } else if (strcmp(argv[i], "--no-thread-policy") == 0) {
+            options->thread_policy = false;
+        } else if (strcmp(argv[i], "--cpu-budget") == 0 && i + 1 < argc) {
+            options->cpu_budget_percent = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--load-threads") == 0 && i + 1 < argc) {
+            options->load_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--load-window") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lf:%lf", &options->load_start, &options->load_end) != 2) return false;
+        } else {
+            return false;
+        }
+    }
+    // H.264 yuv420p는 짝수 해상도만 허용
+    return options->seconds > 0.0 && options->fps > 0 &&
+           options->width > 0 && options->height > 0 &&
+           options->width % 2 == 0 && options->height % 2 == 0 && options->queue_budget_mb >= 0.0 &&
+           options->preroll_seconds >= 0.0 && options->preroll_seconds < options->seconds &&
+           options->postroll_ms >= 0 && options->sessions > 0 &&
+           options->stop_deadline_ms >= 0 && options->kill_encoder_after >= 0.0 &&
+           (options->kill_encoder_after == 0.0 ||
+            (!options->encoder_host_path.empty() && options->kill_encoder_after < options->seconds)) &&
+           options->watchdog_deadline_ms >= 0 &&
+           options->cpu_budget_percent >= 0.0 && options->cpu_budget_percent <= 100.0 &&
+           options->load_threads >= 0 && options->load_start >= 0.0 &&
+           (options->load_end < 0.0 || options->load_end > options->load_start) &&
+           // 주입은 감시 중인 단계만 (인코더 프로세스 모드의 인코더는 EncoderProcess가 감시)
+           (!options->inject_fault ||
+            (options->watchdog_deadline_ms > 0 && options->fault_at < options->seconds &&
+             !(options->fault_stage == WatchedStage::kAudio && options->video_only) &&
+             !(options->fault_stage == WatchedStage::kEncoder && !options->encoder_host_path.empty())));
+}
+
+// 인코더 자식 프로세스 강제 종료 (크래시 흉내)
+void KillProcess(int64_t pid) {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+    if (process) {
+        TerminateProcess(process, 1);
+        CloseHandle(process);
+    }
+#else
+    kill(static_cast<pid_t>(pid), SIGKILL);
+#endif
+}
+
+// 다른 프로그램 부하 흉내: Start부터 Stop까지 쉬지 않고 도는 스레드들
+class CpuLoadGenerator {
+public:
+    ~CpuLoadGenerator() { Stop(); }
+
+    void Start(int threads) {
+        stop_ = false;
+        for (int i = 0; i < threads; i++) {
+            threads_.emplace_back([this] {
+                volatile uint64_t sink = 0;
+                while (!stop_.load(std::memory_order_relaxed)) {
+                    for (int n = 0; n < 10000; n++) sink = sink * 6364136223846793005ULL + 1;
+                }
+            });
+        }
+    }
+
+    void Stop() {
+        stop_ = true;
+        for (auto& thread : threads_) thread.join();
+        threads_.clear();
+    }
+
+    bool running() const { return !threads_.empty(); }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+// 세션 하나의 출력 경로 (세션이 여럿이면 확장자 앞에 _<번호>)
+std::string SessionOutputPath(const std::string& output_path, int index, int count) {
+    if (count == 1) return output_path;
+    std::filesystem::path path = std::filesystem::u8path(output_path);
+    const std::string stem = path.stem().u8string() + "_" + std::to_string(index);
+    return (path.parent_path() / std::filesystem::u8path(stem + path.extension().u8string())).u8string();
+}
+
+// 세션 하나의 상태 (이벤트 수신자는 세션보다 오래 살아 있어야 하므로 함께 보관)
+struct LoadTestSession {
+    std::string output_path;
+    std::string source_name;
+    LoadTestEventSink events;
+    std::unique_ptr<RecorderSession> session;
+    double commit_ms = 0.0;
+    PreRollCommitInfo commit_info;
+    double finalize_ms = 0.0;  // 중지 요청 → 세션 종료 (파일 닫힘)
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    LoadTestOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.output_path.empty()) {
+        options.output_path = (std::filesystem::temp_directory_path() /
+                               (std::string("satrec_loadtest") +
+                                RecordingContainerExtension(options.container))).u8string();
+    }
+
+    // 인코더 진행 로그는 경고 이상만
+    NativeLogger::Instance().SetMinLevel(LogLevel::kWarning);
+
+    // 세션마다 소스/큐/인코더를 따로 만들어 동시에 시작 (준비는 세션 스레드에서 병렬로 진행)
+    std::vector<std::unique_ptr<LoadTestSession>> sessions;
+    for (int i = 0; i < options.sessions; i++) {
+        auto entry = std::make_unique<LoadTestSession>();
+        entry->output_path = SessionOutputPath(options.output_path, i, options.sessions);
+
+        RecorderSessionConfig config;
+        if (options.file_path.empty()) {
+            SyntheticLectureConfig lecture;
+            lecture.width = options.width;
+            lecture.height = options.height;
+            lecture.fps = options.fps;
+            config.video_source = std::make_unique<GeneratorVideoSource>(lecture);
+            if (!options.video_only) config.audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+        } else {
+            config.video_source = std::make_unique<FileVideoSource>(options.file_path, options.width,
+                                                                    options.height);
+            if (!options.video_only) config.audio_source = std::make_unique<FileAudioSource>(options.file_path);
+        }
+        entry->source_name = config.video_source->Name();
+        config.pipeline.encoder.output_path = std::filesystem::u8path(entry->output_path).wstring();
+        config.pipeline.encoder.video_width = options.width;
+        config.pipeline.encoder.video_height = options.height;
+        config.pipeline.encoder.video_fps = options.fps;
+        config.pipeline.encoder.container = options.container;
+        config.pipeline.video_frame_format = options.frame_format;
+        config.pipeline.video_queue_budget_bytes =
+            static_cast<size_t>(options.queue_budget_mb * 1024.0 * 1024.0);
+        config.pipeline.encoder.start_in_preroll = options.preroll_seconds > 0.0;
+        config.pipeline.postroll_ms = options.postroll_ms;
+        config.pipeline.finalize_deadline_ms = options.stop_deadline_ms;
+        config.pipeline.encoder_host_path = options.encoder_host_path;
+        config.pipeline.watchdog_deadline_ms = options.watchdog_deadline_ms;
+        config.pipeline.thread_policy.enabled = options.thread_policy;
+        config.pipeline.cpu_governor.budget_percent = options.cpu_budget_percent;
+        config.event_sink = &entry->events;
+
+        entry->session = std::make_unique<RecorderSession>(i);
+        std::string error;
+        if (!entry->session->Launch(std::move(config), &error)) {
+            fprintf(stderr, "❌ 세션 %d 시작 실패: %s\n", i, error.c_str());
+            return 2;
+        }
+        sessions.push_back(std::move(entry));
+    }
+
+    // 모든 세션의 녹화 시작(트리거)까지 대기, 준비 실패는 세션이 바로 끝남
+    for (const auto& entry : sessions) {
+        RecorderSession& session = *entry->session;
+        while (session.IsRecording() && !session.pipeline().IsTriggered()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!session.pipeline().IsTriggered()) {
+            fprintf(stderr, "❌ 세션 %d 파이프라인 시작 실패: %s\n", session.id(), session.GetLastError().c_str());
+            for (const auto& other : sessions) other->session->Stop();
+            return 2;
+        }
+    }
+
+    auto all_recording = [&sessions] {
+        for (const auto& entry : sessions) {
+            if (!entry->session->IsRecording()) return false;
+        }
+        return true;
+    };
+
+    const std::clock_t cpu_started_at = std::clock();
+    const auto wall_started_at = std::chrono::steady_clock::now();
+    const auto deadline = wall_started_at + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                std::chrono::duration<double>(options.seconds));
+    // pre-roll: 지정 시점까지 메모리 링에만 인코딩한 뒤 커밋
+    if (options.preroll_seconds > 0.0) {
+        const auto commit_at = wall_started_at + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                     std::chrono::duration<double>(options.preroll_seconds));
+        while (all_recording() && std::chrono::steady_clock::now() < commit_at) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        for (const auto& entry : sessions) {
+            std::string error;
+            const auto commit_started_at = std::chrono::steady_clock::now();
+            if (!entry->session->pipeline().CommitPreRoll(0, &error, &entry->commit_info)) {
+                fprintf(stderr, "❌ 세션 %d pre-roll 커밋 실패: %s\n", entry->session->id(), error.c_str());
+                for (const auto& other : sessions) other->session->Stop();
+                return 3;
+            }
+            entry->commit_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - commit_started_at).count();
+        }
+    }
+    const auto kill_at = wall_started_at + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                               std::chrono::duration<double>(options.kill_encoder_after));
+    bool encoder_killed = options.kill_encoder_after == 0.0;
+    const auto fault_at = wall_started_at + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                std::chrono::duration<double>(options.fault_at));
+    bool fault_injected = !options.inject_fault;
+    CpuLoadGenerator load;
+    bool load_done = options.load_threads == 0;
+    auto at_seconds = [wall_started_at](double seconds) {
+        return wall_started_at + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                     std::chrono::duration<double>(seconds));
+    };
+    while (all_recording() && std::chrono::steady_clock::now() < deadline) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!load_done && !load.running() && now >= at_seconds(options.load_start)) {
+            fprintf(stderr, "🔥 부하 스레드 %d개 시작\n", options.load_threads);
+            load.Start(options.load_threads);
+        } else if (load.running() && options.load_end >= 0.0 && now >= at_seconds(options.load_end)) {
+            fprintf(stderr, "🔥 부하 스레드 종료\n");
+            load.Stop();
+            load_done = true;
+        }
+        if (!fault_injected && std::chrono::steady_clock::now() >= fault_at) {
+            fault_injected = true;
+            for (const auto& entry : sessions) {
+                fprintf(stderr, "💥 세션 %d %s 단계에 %s 주입\n", entry->session->id(),
+                        WatchedStageName(options.fault_stage),
+                        options.fault == StageFault::kHang ? "멈춤" : "오류");
+                entry->session->pipeline().InjectStageFault(options.fault_stage, options.fault,
+                                                            options.fault_hang_ms);
+            }
+        }
+        if (!encoder_killed && std::chrono::steady_clock::now() >= kill_at) {
+            encoder_killed = true;
+            for (const auto& entry : sessions) {
+                const int64_t pid = entry->session->pipeline().GetEncoderProcessId();
+                fprintf(stderr, "💥 세션 %d 인코더 프로세스 강제 종료 (pid %lld)\n", entry->session->id(),
+                        static_cast<long long>(pid));
+                if (pid > 0) KillProcess(pid);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    load.Stop();
+    bool capture_failed = !all_recording();
+    // 중지 요청을 먼저 모두 보내 세션들이 남은 큐를 동시에 비우게 함 (러너의 StopRecording과 같은 경로)
+    const auto stop_requested_at = std::chrono::steady_clock::now();
+    for (const auto& entry : sessions) entry->session->RequestStop();
+    const double stop_return_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - stop_requested_at).count();
+    for (const auto& entry : sessions) {
+        entry->session->Stop();
+        entry->finalize_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - stop_requested_at).count();
+    }
+    const double wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_started_at).count();
+    const double cpu_seconds = static_cast<double>(std::clock() - cpu_started_at) / CLOCKS_PER_SEC;
+    NativeLogger::Instance().Flush();
+
+    for (const auto& entry : sessions) {
+        if (!options.keep_output) {
+            // 인코더가 재시작했으면 세그먼트 파일이 여럿
+            std::error_code ec;
+            std::filesystem::remove(std::filesystem::u8path(entry->output_path), ec);
+            for (const std::wstring& segment : entry->session->pipeline().GetSegmentPaths()) {
+                std::filesystem::remove(std::filesystem::path(segment), ec);
+            }
+        }
+        const std::string error = entry->session->GetLastError();
+        if (!error.empty()) {
+            fprintf(stderr, "❌ 세션 %d 녹화 중 오류: %s\n", entry->session->id(), error.c_str());
+            capture_failed = true;
+        }
+        if (options.kill_encoder_after > 0.0 && entry->events.encoder_restarts.load() == 0) {
+            fprintf(stderr, "❌ 세션 %d 인코더 프로세스를 종료했지만 재시작하지 않음\n", entry->session->id());
+            capture_failed = true;
+        }
+        if (options.inject_fault &&
+            entry->session->pipeline().GetWatchdogStats(options.fault_stage).recoveries == 0) {
+            fprintf(stderr, "❌ 세션 %d %s 단계가 재시작 후 복구되지 않음\n", entry->session->id(),
+                    WatchedStageName(options.fault_stage));
+            capture_failed = true;
+        }
+    }
+    if (capture_failed) {
+        return 3;
+    }
+
+    // 기계 판독용 결과 (세션마다 한 줄 JSON, cpu_seconds/cpu_cores는 모든 세션을 합친 프로세스 값)
+    for (const auto& entry : sessions) {
+        const RecordingPipeline& pipeline = entry->session->pipeline();
+        const RecordingQueueStats queue = pipeline.GetQueueStats();
+        const PipelineStats& stats = pipeline.pipeline_stats();
+        const LatencySummary capture = stats.Summarize(PipelineStage::kCapture);
+        const LatencySummary convert = stats.Summarize(PipelineStage::kConvert);
+        const LatencySummary encode = stats.Summarize(PipelineStage::kVideoEncode);
+        const LatencySummary video_total = stats.Summarize(PipelineStage::kVideoTotal);
+        const int64_t encoded_frames = pipeline.GetVideoFrameCount();
+        WatchdogStageStats watchdog;  // 모든 단계 합계 (max_recovery_ms는 최댓값)
+        for (size_t i = 0; i < static_cast<size_t>(WatchedStage::kCount); i++) {
+            const WatchdogStageStats stage = pipeline.GetWatchdogStats(static_cast<WatchedStage>(i));
+            watchdog.restarts += stage.restarts;
+            watchdog.recoveries += stage.recoveries;
+            if (stage.max_recovery_ms > watchdog.max_recovery_ms) watchdog.max_recovery_ms = stage.max_recovery_ms;
+            watchdog.unresponsive = watchdog.unresponsive || stage.unresponsive;
+        }
+        const CpuGovernorStats governor = pipeline.GetCpuGovernorStats();
+
+        printf("{\"source\":\"%s\",\"session\":%d,\"sessions\":%d,\"width\":%d,\"height\":%d,\"fps\":%d,"
+               "\"wall_seconds\":%.3f,\"cpu_seconds\":%.3f,\"cpu_cores\":%.2f,\"encoded_frames\":%lld,"
+               "\"encoded_fps\":%.2f,\"captured_frames\":%lld,"
+               "\"repeated_frames\":%lld,\"dropped_video_frames\":%lld,\"dropped_audio_packets\":%lld,"
+               "\"frame_format\":\"%s\",\"video_frame_bytes\":%zu,"
+               "\"video_queue_high_water\":%zu,\"audio_queue_high_water\":%zu,"
+               "\"capture_p99_us\":%lld,\"convert_p50_us\":%lld,\"convert_p99_us\":%lld,"
+               "\"encode_p50_us\":%lld,\"encode_p99_us\":%lld,\"video_total_p99_us\":%lld,"
+               "\"first_frame_ms\":%lld,\"stall_events\":%lld,"
+               "\"commit_ms\":%.3f,\"preroll_ms\":%lld,\"preroll_packets\":%lld,"
+               "\"stop_return_ms\":%.3f,\"finalize_ms\":%.1f,\"discarded_on_stop\":%lld,"
+               "\"encoder_restarts\":%d,\"segments\":%zu,"
+               "\"stage_restarts\":%lld,\"stage_recoveries\":%lld,\"max_recovery_ms\":%lld,\"stage_unresponsive\":%s,"
+               "\"cpu_budget\":%.1f,\"governor_level\":%d,\"governor_changes\":%lld,\"governor_fps\":%d,\"governor_encoder_step_delta\":%d,"
+               "\"recorder_cpu_percent\":%.1f,\"system_cpu_percent\":%.1f}\n",
+               entry->source_name.c_str(), entry->session->id(), options.sessions,
+               options.width, options.height, options.fps, wall_seconds,
+               cpu_seconds, wall_seconds > 0.0 ? cpu_seconds / wall_seconds : 0.0,
+               static_cast<long long>(encoded_frames),
+               wall_seconds > 0.0 ? static_cast<double>(encoded_frames) / wall_seconds : 0.0,
+               static_cast<long long>(queue.captured_video_frames),
+               static_cast<long long>(queue.repeated_video_frames),
+               static_cast<long long>(queue.dropped_video_frames),
+               static_cast<long long>(queue.dropped_audio_packets),
+               options.frame_format == FramePixelFormat::kI420 ? "i420" : "bgra", queue.video_frame_bytes,
+               queue.video_queue_high_water, queue.audio_queue_high_water,
+               static_cast<long long>(capture.p99_us),
+               static_cast<long long>(convert.p50_us), static_cast<long long>(convert.p99_us),
+               static_cast<long long>(encode.p50_us), static_cast<long long>(encode.p99_us),
+               static_cast<long long>(video_total.p99_us),
+               static_cast<long long>(entry->events.first_frame_ms.load()),
+               static_cast<long long>(entry->events.stall_events.load()),
+               entry->commit_ms, static_cast<long long>(entry->commit_info.preroll_ms),
+               static_cast<long long>(entry->commit_info.packet_count),
+               stop_return_ms, entry->finalize_ms, static_cast<long long>(queue.discarded_on_stop),
+               pipeline.GetEncoderRestartCount(), pipeline.GetSegmentPaths().size(),
+               static_cast<long long>(watchdog.restarts), static_cast<long long>(watchdog.recoveries),
+               static_cast<long long>(watchdog.max_recovery_ms), watchdog.unresponsive ? "true" : "false",
+               options.cpu_budget_percent, governor.level, static_cast<long long>(governor.changes),
+               governor.capture_fps, governor.encoder_step_delta, governor.last_sample.recorder_percent, governor.last_sample.system_percent);
+    }
+    return 0;
+}
@@ -0,0 +1,482 @@
+// satrec_record: Flutter 엔진 없이 녹화 파이프라인만 돌리는 헤드리스 녹화 명령줄 도구
+// 예약 녹화 스크립트, 무인 PC, 인코더 단독 측정용 (러너와 같은 RecordingPipeline 경로)
+//
+// 사용법: satrec_record [--source synthetic|file:<경로>|screen[:<모니터>]] [--duration <초>] [--fps <n>]
+//                       [--size <W>x<H>] [--profile realtime|balanced|quality] [--preset <x264 preset>]
+//                       [--crf <n>] [--audio-bitrate <bps>] [--container mp4|mkv|ts] [--output <경로>]
+//                       [--video-only] [--frame-format bgra|i420] [--queue-budget-mb <MB>]
+//                       [--stats-interval <초>] [--encoder-host <경로>] [--cpu-budget <%>]
+// --source screen: Windows 빌드(러너 옆 satrec_record.exe)에서만, DXGI 화면 + WASAPI 루프백
+// --duration 0: Ctrl+C(SIGINT/SIGTERM)까지 녹화
+// 출력: stdout에 한 줄 JSON (started, 이벤트, stats, summary), 사람이 읽는 메시지는 stderr
+// 종료 코드: 0 성공, 1 인자 오류, 2 시작 실패, 3 녹화 중 캡처/인코딩 오류
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "file_source.h"
+#include "generator_source.h"
+#include "live_stats.h"
+#include "native_logger.h"
+#include "pipeline_stats.h"
+#include "recorder_events.h"
+#include "recording_pipeline.h"
+
+#ifdef SATREC_RECORD_SCREEN_CAPTURE
+#include <d3d11.h>
+
+#include "dxgi_video_source.h"
+#include "wasapi_audio_source.h"
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "ole32.lib")
+#endif
+
+namespace {
+
+std::atomic<bool> g_interrupted(false);
+
+void OnSignal(int) {
+    g_interrupted.store(true, std::memory_order_relaxed);
+}
+
+// 인코딩 품질 묶음 (x264 preset + CRF), --preset/--crf로 개별 값을 덮어씀
+struct EncodeProfile {
+    const char* name;
+    const char* preset;
+    int crf;
+};
+
+constexpr EncodeProfile kProfiles[] = {
+    {"realtime", "ultrafast", 26},  // CPU 최소 (Zoom과 같은 PC에서 여유가 없을 때)
+    {"balanced", "veryfast", 23},   // 러너 기본값
+    {"quality", "medium", 20},      // 녹화 전용 PC
+};
+
+struct RecordOptions {
+    enum class Source { kSynthetic, kFile, kScreen };
+    Source source = Source::kSynthetic;
+    std::string file_path;
+    int monitor_index = -1;  // 화면 캡처 모니터 (-1이면 DxgiVideoSource 기본값)
+    double duration_seconds = 10.0;  // 0이면 신호까지
+    int fps = 24;
+    int width = 1920;
+    int height = 1080;
+    const EncodeProfile* profile = &kProfiles[1];
+    std::string preset;  // 비어 있으면 프로필 값
+    int crf = -1;        // 음수면 프로필 값
+    int audio_bitrate = 192000;
+    RecordingContainer container = RecordingContainer::kFragmentedMp4;
+    std::string output_path;
+    bool video_only = false;
+    // 가벼운 기본값: I420 큐 64MB (1080p 약 21프레임 ≈ 0.9초 @ 24fps)
+    FramePixelFormat frame_format = FramePixelFormat::kI420;
+    double queue_budget_mb = 64.0;
+    double stats_interval_seconds = 1.0;  // 0이면 주기 통계 출력 안 함
+    std::string encoder_host_path;
+    double cpu_budget_percent = 0.0;  // 0이면 CPU 예산 조절 안 함
+};
+
+void PrintUsage() {
+    fprintf(stderr, "사용법: satrec_record [--source synthetic|file:<경로>|screen[:<모니터>]] [--duration <초>] "
+                    "[--fps <n>] [--size <W>x<H>] [--profile realtime|balanced|quality] [--preset <preset>] "
+                    "[--crf <n>] [--audio-bitrate <bps>] [--container mp4|mkv|ts] [--output <경로>] [--video-only] "
+                    "[--frame-format bgra|i420] [--queue-budget-mb <MB>] [--stats-interval <초>] "
+                    "[--encoder-host <경로>] [--cpu-budget <%%>]\n");
+}
+
+bool ParseOptions(int argc, char** argv, RecordOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "synthetic") == 0) {
+                options->source = RecordOptions::Source::kSynthetic;
+            } else if (strncmp(value, "file:", 5) == 0 && value[5] != '\0') {
+                options->source = RecordOptions::Source::kFile;
+                options->file_path = value + 5;
+            } else if (strcmp(value, "screen") == 0) {
+                options->source = RecordOptions::Source::kScreen;
+            } else if (strncmp(value, "screen:", 7) == 0) {
+                options->source = RecordOptions::Source::kScreen;
+                options->monitor_index = atoi(value + 7);
+            } else {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            options->duration_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            options->fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &options->width, &options->height) != 2) return false;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            options->profile = nullptr;
+            for (const EncodeProfile& profile : kProfiles) {
+                if (strcmp(value, profile.name) == 0) options->profile = &profile;
+            }
+            if (!options->profile) return false;
+        } else if (strcmp(argv[i], "--preset") == 0 && i + 1 < argc) {
+            options->preset = argv[++i];
+        } else if (strcmp(argv[i], "--crf") == 0 && i + 1 < argc) {
+            options->crf = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--audio-bitrate") == 0 && i + 1 < argc) {
+            options->audio_bitrate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--container") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "mp4") == 0) {
+                options->container = RecordingContainer::kFragmentedMp4;
+            } else if (strcmp(value, "mkv") == 0) {
+                options->container = RecordingContainer::kMatroska;
+            } else if (strcmp(value, "ts") == 0) {
+                options->container = RecordingContainer::kMpegTs;
+            } else {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options->output_path = argv[++i];
+        } else if (strcmp(argv[i], "--video-only") == 0) {
+            options->video_only = true;
+        } else if (strcmp(argv[i], "--frame-format") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "bgra") == 0) {
+                options->frame_format = FramePixelFormat::kBgra;
+            } else if (strcmp(value, "i420") == 0) {
+                options->frame_format = FramePixelFormat::kI420;
+            } else {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--queue-budget-mb") == 0 && i + 1 < argc) {
+            options->queue_budget_mb = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--stats-interval") == 0 && i + 1 < argc) {
+            options->stats_interval_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--encoder-host") == 0 && i + 1 < argc) {
+            options->encoder_host_path = argv[++i];
+        } else if (strcmp(argv[i], "--cpu-budget") == 0 && i + 1 < argc) {
+            options->cpu_budget_percent = atof(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    // H.264 yuv420p는 짝수 해상도만 허용, CRF는 x264 범위 (0~51)
+    return options->duration_seconds >= 0.0 && options->fps > 0 && options->width > 0 && options->height > 0 &&
+           options->width % 2 == 0 && options->height % 2 == 0 && options->crf <= 51 &&
+           options->audio_bitrate > 0 && options->queue_budget_mb >= 0.0 && options->stats_interval_seconds >= 0.0 &&
+           options->cpu_budget_percent >= 0.0 && options->cpu_budget_percent <= 100.0;
+}
+
+// 출력 경로 기본값: 현재 폴더의 satrec_<날짜_시각>.<확장자>
+std::string DefaultOutputPath(RecordingContainer container) {
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char name[64];
+    std::strftime(name, sizeof(name), "satrec_%Y%m%d_%H%M%S", &local);
+    return std::string(name) + RecordingContainerExtension(container);
+}
+
+std::string JsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+double PeakResidentMb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0.0;
+    return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;  // Linux: KB
+#endif
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+// stdout JSON 한 줄씩 (이벤트는 캡처/오디오/인코더 스레드에서 오므로 줄이 섞이지 않게 잠금)
+std::mutex g_output_mutex;
+
+void PrintJsonLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(g_output_mutex);
+    fputs(line.c_str(), stdout);
+    fputc('\n', stdout);
+    fflush(stdout);
+}
+
+// 파이프라인 상태 이벤트 → {"event":"<이름>",...}
+class JsonEventSink : public RecorderEventSink {
+public:
+    void OnRecorderEvent(const RecorderEvent& event) override {
+        if (event.type == RecorderEventType::kFirstFrameEncoded) {
+            first_frame_ms.store(event.elapsed_ms, std::memory_order_relaxed);
+        }
+        char head[160];
+        snprintf(head, sizeof(head), "{\"event\":\"%s\",\"elapsed_ms\":%lld,\"value\":%lld,\"message\":\"",
+                 RecorderEventTypeName(event.type), static_cast<long long>(event.elapsed_ms),
+                 static_cast<long long>(event.value));
+        PrintJsonLine(head + JsonEscape(event.message) + "\"}");
+    }
+
+    std::atomic<int64_t> first_frame_ms{-1};
+};
+
+void PrintStatsLine(const LiveStatsSnapshot& stats) {
+    char line[512];
+    snprintf(line, sizeof(line),
+             "{\"event\":\"stats\",\"elapsed_ms\":%lld,\"video_frames\":%lld,\"video_fps\":%.2f,"
+             "\"bitrate_kbps\":%.1f,\"encoded_bytes\":%lld,\"dropped_video_frames\":%lld,"
+             "\"dropped_audio_packets\":%lld,\"video_queue_depth\":%d,\"video_queue_capacity\":%d,"
+             "\"audio_level\":%.3f,\"rss_peak_mb\":%.1f}",
+             static_cast<long long>(stats.elapsed_ms), static_cast<long long>(stats.video_frames),
+             static_cast<double>(stats.video_fps), static_cast<double>(stats.encoder_bitrate_kbps),
+             static_cast<long long>(stats.encoded_bytes), static_cast<long long>(stats.dropped_video_frames),
+             static_cast<long long>(stats.dropped_audio_packets), stats.video_queue_depth,
+             stats.video_queue_capacity, static_cast<double>(stats.audio_level), PeakResidentMb());
+    PrintJsonLine(line);
+}
+
+#ifdef SATREC_RECORD_SCREEN_CAPTURE
+// 화면 캡처용 COM + D3D11 디바이스 (프로세스 수명 동안 유지)
+struct ScreenCaptureDevice {
+    ID3D11Device* device = nullptr;
+    ID3D11DeviceContext* context = nullptr;
+
+    ~ScreenCaptureDevice() {
+        if (context) context->Release();
+        if (device) device->Release();
+    }
+
+    bool Create(std::string* error) {
+        const HRESULT com = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        if (FAILED(com) && com != RPC_E_CHANGED_MODE) {
+            *error = "COM 초기화 실패";
+            return false;
+        }
+        const D3D_FEATURE_LEVEL feature_levels[] = {
+            D3D_FEATURE_LEVEL_11_1, D3D_FEATURE_LEVEL_11_0, D3D_FEATURE_LEVEL_10_1, D3D_FEATURE_LEVEL_10_0};
+        D3D_FEATURE_LEVEL feature_level;
+        const HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr,
+                                             D3D11_CREATE_DEVICE_BGRA_SUPPORT, feature_levels,
+                                             ARRAYSIZE(feature_levels), D3D11_SDK_VERSION, &device,
+                                             &feature_level, &context);
+        if (FAILED(hr)) {
+            *error = "D3D11 디바이스 생성 실패";
+            return false;
+        }
+        return true;
+    }
+};
+#endif
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto process_started_at = std::chrono::steady_clock::now();
+    RecordOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.output_path.empty()) {
+        options.output_path = DefaultOutputPath(options.container);
+    }
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    // 진행 로그는 경고 이상만 stderr로 (stdout은 JSON 전용)
+    NativeLogger::Instance().SetMinLevel(LogLevel::kWarning);
+
+    // 1. 소스
+    RecordingPipelineConfig config;
+    std::unique_ptr<IVideoSource> video_source;
+    std::unique_ptr<IAudioSource> audio_source;
+#ifdef SATREC_RECORD_SCREEN_CAPTURE
+    ScreenCaptureDevice screen_device;
+#endif
+    switch (options.source) {
+        case RecordOptions::Source::kSynthetic: {
+            SyntheticLectureConfig lecture;
+            lecture.width = options.width;
+            lecture.height = options.height;
+            lecture.fps = options.fps;
+            video_source = std::make_unique<GeneratorVideoSource>(lecture);
+            if (!options.video_only) audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+            break;
+        }
+        case RecordOptions::Source::kFile:
+            video_source = std::make_unique<FileVideoSource>(options.file_path, options.width, options.height);
+            if (!options.video_only) audio_source = std::make_unique<FileAudioSource>(options.file_path);
+            break;
+        case RecordOptions::Source::kScreen: {
+#ifdef SATREC_RECORD_SCREEN_CAPTURE
+            std::string error;
+            if (!screen_device.Create(&error)) {
+                fprintf(stderr, "❌ %s\n", error.c_str());
+                return 2;
+            }
+            video_source = options.monitor_index < 0
+                ? std::make_unique<DxgiVideoSource>(screen_device.device, screen_device.context)
+                : std::make_unique<DxgiVideoSource>(screen_device.device, screen_device.context,
+                                                    static_cast<UINT>(options.monitor_index));
+            if (!options.video_only) audio_source = std::make_unique<WasapiAudioSource>();
+            break;
+#else
+            fprintf(stderr, "❌ 이 빌드는 화면 캡처를 지원하지 않음 (Windows 앱 빌드의 satrec_record.exe 사용)\n");
+            return 1;
+#endif
+        }
+    }
+
+    // 2. 파이프라인 설정 (러너와 같은 인코더 기본값 + 프로필)
+    JsonEventSink events;
+    const std::string preset = options.preset.empty() ? options.profile->preset : options.preset;
+    const int crf = options.crf >= 0 ? options.crf : options.profile->crf;
+    config.video_source = video_source.get();
+    config.audio_source = audio_source.get();
+    config.encoder.output_path = std::filesystem::u8path(options.output_path).wstring();
+    config.encoder.video_width = options.width;
+    config.encoder.video_height = options.height;
+    config.encoder.video_fps = options.fps;
+    config.encoder.container = options.container;
+    config.encoder.enable_fragmented_mp4 = true;
+    config.encoder.h264_crf = crf;
+    config.encoder.h264_preset = preset.c_str();
+    config.encoder.aac_bitrate = options.audio_bitrate;
+    config.video_frame_format = options.frame_format;
+    config.video_queue_budget_bytes = static_cast<size_t>(options.queue_budget_mb * 1024.0 * 1024.0);
+    config.cpu_governor.budget_percent = options.cpu_budget_percent;
+    config.encoder_host_path = options.encoder_host_path;
+    config.event_sink = &events;
+
+    // 3. 시작 (준비 + 트리거, 호출 스레드에서 완료까지)
+    RecordingPipeline pipeline;
+    std::string error;
+    const auto arm_started_at = std::chrono::steady_clock::now();
+    if (!pipeline.Start(config, &error)) {
+        fprintf(stderr, "❌ 녹화 시작 실패: %s\n", error.c_str());
+        PrintJsonLine("{\"event\":\"start_failed\",\"message\":\"" + JsonEscape(error) + "\"}");
+        return 2;
+    }
+    const double arm_ms = ElapsedMs(arm_started_at);
+    const double startup_ms = ElapsedMs(process_started_at);
+    {
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "{\"event\":\"started\",\"startup_ms\":%.1f,\"arm_ms\":%.1f,\"source\":\"%s\","
+                 "\"profile\":\"%s\",\"rss_peak_mb\":%.1f,\"output\":\"",
+                 startup_ms, arm_ms, video_source->Name(), options.profile->name, PeakResidentMb());
+        PrintJsonLine(line + JsonEscape(options.output_path) + "\"}");
+    }
+    fprintf(stderr, "⏺️ 녹화 중: %s (%s)\n", options.output_path.c_str(),
+            options.duration_seconds > 0.0 ? "지정 시간까지" : "Ctrl+C로 종료");
+
+    // 4. 종료 조건까지 주기 통계 출력
+    const std::clock_t cpu_started_at = std::clock();
+    const auto recording_started_at = std::chrono::steady_clock::now();
+    const auto stats_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.stats_interval_seconds));
+    auto next_stats_at = recording_started_at + stats_interval;
+    while (pipeline.IsCapturing() && !g_interrupted.load(std::memory_order_relaxed)) {
+        const auto now = std::chrono::steady_clock::now();
+        if (options.duration_seconds > 0.0 &&
+            std::chrono::duration<double>(now - recording_started_at).count() >= options.duration_seconds) {
+            break;
+        }
+        if (options.stats_interval_seconds > 0.0 && now >= next_stats_at) {
+            next_stats_at += stats_interval;
+            LiveStatsSnapshot stats;
+            if (pipeline.ReadLiveStats(&stats)) PrintStatsLine(stats);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    const bool capture_failed = !pipeline.IsCapturing();
+
+    // 5. 종료 (남은 큐 인코딩 + 파일 닫기) 후 요약
+    pipeline.Stop();
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                              recording_started_at).count();
+    const double cpu_seconds = static_cast<double>(std::clock() - cpu_started_at) / CLOCKS_PER_SEC;
+    NativeLogger::Instance().Flush();
+
+    const RecordingQueueStats queue = pipeline.GetQueueStats();
+    LiveStatsSnapshot stats;
+    pipeline.ReadLiveStats(&stats);
+    const PipelineStats& stage_stats = pipeline.pipeline_stats();
+    const LatencySummary encode = stage_stats.Summarize(PipelineStage::kVideoEncode);
+    const LatencySummary video_total = stage_stats.Summarize(PipelineStage::kVideoTotal);
+    const int64_t encoded_frames = pipeline.GetVideoFrameCount();
+    const std::string last_error = pipeline.GetLastError();
+
+    char summary[1024];
+    snprintf(summary, sizeof(summary),
+             "{\"event\":\"summary\",\"source\":\"%s\",\"width\":%d,\"height\":%d,\"fps\":%d,"
+             "\"profile\":\"%s\",\"preset\":\"%s\",\"crf\":%d,\"startup_ms\":%.1f,\"arm_ms\":%.1f,"
+             "\"first_frame_ms\":%lld,\"wall_seconds\":%.3f,\"cpu_seconds\":%.3f,\"cpu_cores\":%.2f,"
+             "\"encoded_frames\":%lld,\"encoded_fps\":%.2f,\"encoded_bytes\":%lld,\"bitrate_kbps\":%.1f,"
+             "\"captured_frames\":%lld,\"repeated_frames\":%lld,\"dropped_video_frames\":%lld,"
+             "\"dropped_audio_packets\":%lld,\"video_queue_high_water\":%zu,\"video_queue_capacity\":%zu,"
+             "\"encode_p50_us\":%lld,\"encode_p99_us\":%lld,\"video_total_p99_us\":%lld,"
+             "\"stop_ms\":%lld,\"rss_peak_mb\":%.1f,\"interrupted\":%s,\"ok\":%s,\"output\":\"",
+             video_source->Name(), options.width, options.height, options.fps, options.profile->name,
+             preset.c_str(), crf, startup_ms, arm_ms, static_cast<long long>(events.first_frame_ms.load()),
+             wall_seconds, cpu_seconds, wall_seconds > 0.0 ? cpu_seconds / wall_seconds : 0.0,
+             static_cast<long long>(encoded_frames),
+             wall_seconds > 0.0 ? static_cast<double>(encoded_frames) / wall_seconds : 0.0,
+             static_cast<long long>(stats.encoded_bytes),
+             wall_seconds > 0.0 ? static_cast<double>(stats.encoded_bytes) * 8.0 / 1000.0 / wall_seconds : 0.0,
+             static_cast<long long>(queue.captured_video_frames),
+             static_cast<long long>(queue.repeated_video_frames),
+             static_cast<long long>(queue.dropped_video_frames),
+             static_cast<long long>(queue.dropped_audio_packets), queue.video_queue_high_water,
+             queue.video_queue_capacity, static_cast<long long>(encode.p50_us),
+             static_cast<long long>(encode.p99_us), static_cast<long long>(video_total.p99_us),
+             static_cast<long long>(pipeline.GetLastStopMs()), PeakResidentMb(),
+             g_interrupted.load() ? "true" : "false", last_error.empty() ? "true" : "false");
+    PrintJsonLine(summary + JsonEscape(options.output_path) + "\"}");
+
+    if (capture_failed || !last_error.empty()) {
+        fprintf(stderr, "❌ 녹화 중 오류: %s\n", last_error.empty() ? "캡처 중단" : last_error.c_str());
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,320 @@
+// satrec_replay: 캡처 trace(.slrc)를 인코더 파이프라인에 다시 넣어 성능 문제를 재현하는 명령줄 도구
+//
+// 사용법: satrec_replay [--realtime] [--output <경로>] [--container mp4|mkv|ts] [--keep] <trace.slrc>
+//   기본      : 가능한 한 빠르게, 호출 스레드에서 기록 순서대로 인코딩 (실행마다 결과 동일)
+//   --realtime: 원래 캡처 간격대로 캡처 큐 → 인코더 스레드 (런너와 같은 큐 크기/드롭 정책)
+// 종료 코드: 0 성공, 1 인자 오류, 2 trace 읽기 오류, 3 인코딩 오류
+//
+// 타임스탬프는 trace에 기록된 QPC 값을 그대로 사용하므로 PTS가 원래 녹화와 같음
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "capture_queue.h"
+#include "capture_trace.h"
+#include "libav_encoder.h"
+#include "media_clock.h"
+#include "native_logger.h"
+#include "pipeline_stats.h"
+
+namespace {
+
+// 런너(native_screen_recorder.cpp)의 캡처 큐 크기와 동일
+constexpr size_t kVideoQueueSize = 60;
+constexpr size_t kAudioQueueSize = 100;
+
+struct ReplayOptions {
+    std::string trace_path;
+    std::string output_path;
+    bool realtime = false;
+    bool keep_output = false;
+    RecordingContainer container = RecordingContainer::kFragmentedMp4;
+};
+
+/// 재생 결과 통계
+struct ReplayStats {
+    int64_t video_frames = 0;
+    int64_t repeated_frames = 0;
+    int64_t audio_packets = 0;
+    int64_t skipped_frames = 0;         // 해상도가 인코더 설정과 다른 프레임
+    int64_t dropped_video_frames = 0;   // --realtime: 큐가 가득 차서 버린 프레임
+    int64_t dropped_audio_packets = 0;
+    uint64_t last_qpc = 0;
+};
+
+struct QueuedFrame {
+    std::vector<uint8_t> pixels;
+    uint64_t qpc = 0;
+    PipelineStats::Clock::time_point enqueued_at{};
+};
+
+struct QueuedAudio {
+    std::vector<uint8_t> pcm;
+    uint64_t qpc = 0;
+    PipelineStats::Clock::time_point enqueued_at{};
+};
+
+void PrintUsage() {
+    fprintf(stderr, "사용법: satrec_replay [--realtime] [--output <경로>] [--container mp4|mkv|ts] "
+                    "[--keep] <trace.slrc>\n");
+}
+
+bool ParseOptions(int argc, char** argv, ReplayOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--realtime") == 0) {
+            options->realtime = true;
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            options->keep_output = true;
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options->output_path = argv[++i];
+        } else if (strcmp(argv[i], "--container") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            if (strcmp(value, "mp4") == 0) {
+                options->container = RecordingContainer::kFragmentedMp4;
+            } else if (strcmp(value, "mkv") == 0) {
+                options->container = RecordingContainer::kMatroska;
+            } else if (strcmp(value, "ts") == 0) {
+                options->container = RecordingContainer::kMpegTs;
+            } else {
+                return false;
+            }
+        } else if (argv[i][0] == '-' || !options->trace_path.empty()) {
+            return false;
+        } else {
+            options->trace_path = argv[i];
+        }
+    }
+    return !options->trace_path.empty();
+}
+
+// 입력: trace reader, 인코더, 통계
+// 출력: 모든 레코드를 호출 스레드에서 순서대로 인코딩 (실패 시 false)
+bool ReplayFast(CaptureTraceReader& reader, LibavEncoder& encoder, const CaptureTraceInfo& info,
+                ReplayStats* stats) {
+    const size_t expected_frame_size = static_cast<size_t>(info.width) * info.height * 4;
+    CaptureTraceRecord record;
+    while (reader.Next(&record)) {
+        stats->last_qpc = std::max(stats->last_qpc, record.qpc);
+        if (record.type == CaptureTraceRecordType::kAudio) {
+            if (!encoder.EncodeAudio(record.pcm.data(), record.pcm.size(), record.qpc)) return false;
+            stats->audio_packets++;
+            continue;
+        }
+        if (!record.bgra || record.bgra_size != expected_frame_size) {
+            stats->skipped_frames++;
+            continue;
+        }
+        if (!encoder.EncodeVideo(record.bgra, record.bgra_size, record.qpc)) return false;
+        if (record.type == CaptureTraceRecordType::kRepeatedFrame) {
+            stats->repeated_frames++;
+        } else {
+            stats->video_frames++;
+        }
+    }
+    return true;
+}
+
+// 입력: trace reader, 인코더, 단계 통계
+// 출력: 원래 캡처 간격대로 큐에 넣고 인코더 스레드에서 소비 (실패 시 false)
+bool ReplayRealtime(CaptureTraceReader& reader, LibavEncoder& encoder, const CaptureTraceInfo& info,
+                    PipelineStats& pipeline_stats, ReplayStats* stats) {
+    CaptureQueue<QueuedFrame> frame_queue(kVideoQueueSize);
+    CaptureQueue<QueuedAudio> audio_queue(kAudioQueueSize);
+    std::atomic<bool> producing(true);
+    std::atomic<bool> encode_failed(false);
+
+    // 인코더 스레드 (런너의 EncoderThreadFunc와 같은 순서: 비디오 → 오디오)
+    std::thread encoder_thread([&] {
+        while (producing || !frame_queue.Empty() || !audio_queue.Empty()) {
+            bool processed = false;
+            QueuedFrame frame;
+            if (frame_queue.TryPop(&frame)) {
+                pipeline_stats.RecordSince(PipelineStage::kVideoQueue, frame.enqueued_at);
+                if (!encoder.EncodeVideo(frame.pixels.data(), frame.pixels.size(), frame.qpc)) {
+                    encode_failed = true;
+                    break;
+                }
+                pipeline_stats.RecordSince(PipelineStage::kVideoTotal, frame.enqueued_at);
+                processed = true;
+            }
+            QueuedAudio audio;
+            if (audio_queue.TryPop(&audio)) {
+                pipeline_stats.RecordSince(PipelineStage::kAudioQueue, audio.enqueued_at);
+                if (!encoder.EncodeAudio(audio.pcm.data(), audio.pcm.size(), audio.qpc)) {
+                    encode_failed = true;
+                    break;
+                }
+                processed = true;
+            }
+            if (!processed) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+
+    const size_t expected_frame_size = static_cast<size_t>(info.width) * info.height * 4;
+    const auto wall_start = std::chrono::steady_clock::now();
+    CaptureTraceRecord record;
+    while (!encode_failed && reader.Next(&record)) {
+        // 원래 캡처 시각까지 대기 (trace 시작 시점 기준)
+        if (record.qpc > info.start_qpc) {
+            const double offset_seconds = static_cast<double>(record.qpc - info.start_qpc) /
+                                          static_cast<double>(info.qpc_frequency);
+            std::this_thread::sleep_until(
+                wall_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<double>(offset_seconds)));
+        }
+        stats->last_qpc = std::max(stats->last_qpc, record.qpc);
+
+        if (record.type == CaptureTraceRecordType::kAudio) {
+            QueuedAudio audio;
+            audio.pcm = std::move(record.pcm);
+            audio.qpc = record.qpc;
+            audio.enqueued_at = PipelineStats::Clock::now();
+            std::optional<QueuedAudio> dropped;
+            audio_queue.Push(std::move(audio), &dropped);
+            if (dropped) stats->dropped_audio_packets++;
+            stats->audio_packets++;
+            continue;
+        }
+        if (!record.bgra || record.bgra_size != expected_frame_size) {
+            stats->skipped_frames++;
+            continue;
+        }
+        QueuedFrame frame;
+        frame.pixels.assign(record.bgra, record.bgra + record.bgra_size);
+        frame.qpc = record.qpc;
+        frame.enqueued_at = PipelineStats::Clock::now();
+        std::optional<QueuedFrame> dropped;
+        frame_queue.Push(std::move(frame), &dropped);
+        if (dropped) stats->dropped_video_frames++;
+        if (record.type == CaptureTraceRecordType::kRepeatedFrame) {
+            stats->repeated_frames++;
+        } else {
+            stats->video_frames++;
+        }
+    }
+
+    producing = false;
+    encoder_thread.join();
+    return !encode_failed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.output_path.empty()) {
+        options.output_path = (std::filesystem::temp_directory_path() /
+                               (std::string("satrec_replay") +
+                                RecordingContainerExtension(options.container))).u8string();
+    }
+
+    // 인코더 진행 로그는 경고 이상만
+    NativeLogger::Instance().SetMinLevel(LogLevel::kWarning);
+
+    CaptureTraceReader reader;
+    std::string error;
+    if (!reader.Open(options.trace_path, &error)) {
+        fprintf(stderr, "❌ %s\n", error.c_str());
+        return 2;
+    }
+    const CaptureTraceInfo info = reader.info();
+    if (info.qpc_frequency == 0 || info.width <= 0 || info.height <= 0 || info.fps <= 0) {
+        fprintf(stderr, "❌ trace 헤더에 캡처 형식 정보가 없음\n");
+        return 2;
+    }
+    if (info.bits_per_sample != 32) {
+        // LibavEncoder::EncodeAudio는 Interleaved Float32만 받음 (WASAPI 공유 모드 기본 형식)
+        fprintf(stderr, "❌ 지원하지 않는 오디오 형식: %dbit\n", info.bits_per_sample);
+        return 2;
+    }
+
+    // trace의 QPC 값을 그대로 타임스탬프로 사용 (인코더 시작 = trace 시작)
+    ManualMediaClock clock(info.qpc_frequency);
+    clock.Set(info.start_qpc);
+    PipelineStats pipeline_stats;
+    pipeline_stats.Reset();
+
+    LibavEncoderConfig config;
+    config.output_path = std::filesystem::u8path(options.output_path).wstring();
+    config.video_width = info.width;
+    config.video_height = info.height;
+    config.video_fps = info.fps;
+    config.audio_sample_rate = info.sample_rate;
+    config.audio_channels = info.channels;
+    config.container = options.container;
+    config.clock = &clock;
+    config.pipeline_stats = &pipeline_stats;
+
+    LibavEncoder encoder;
+    if (!encoder.Start(config)) {
+        fprintf(stderr, "❌ 인코더 시작 실패: %s\n", encoder.GetLastError().c_str());
+        return 3;
+    }
+
+    ReplayStats stats;
+    const auto wall_started_at = std::chrono::steady_clock::now();
+    const bool ok = options.realtime
+        ? ReplayRealtime(reader, encoder, info, pipeline_stats, &stats)
+        : ReplayFast(reader, encoder, info, &stats);
+    const std::string encode_error = encoder.GetLastError();
+    encoder.Stop();
+    const double wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_started_at).count();
+    NativeLogger::Instance().Flush();
+
+    if (!options.keep_output) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(options.output_path), ec);
+    }
+    if (!ok) {
+        fprintf(stderr, "❌ 인코딩 실패: %s\n", encode_error.c_str());
+        return 3;
+    }
+    if (reader.truncated()) {
+        fprintf(stderr, "⚠️ trace가 중간에 잘려 있어 마지막 완전한 레코드까지만 재생함\n");
+    }
+
+    const double media_seconds = stats.last_qpc > info.start_qpc
+        ? static_cast<double>(stats.last_qpc - info.start_qpc) / static_cast<double>(info.qpc_frequency)
+        : 0.0;
+    const LatencySummary convert = pipeline_stats.Summarize(PipelineStage::kConvert);
+    const LatencySummary encode = pipeline_stats.Summarize(PipelineStage::kVideoEncode);
+    const LatencySummary mux = pipeline_stats.Summarize(PipelineStage::kMux);
+    const LatencySummary video_total = pipeline_stats.Summarize(PipelineStage::kVideoTotal);
+
+    // 기계 판독용 결과 (한 줄 JSON)
+    printf("{\"mode\":\"%s\",\"video_frames\":%lld,\"repeated_frames\":%lld,\"audio_packets\":%lld,"
+           "\"skipped_frames\":%lld,\"dropped_video_frames\":%lld,\"dropped_audio_packets\":%lld,"
+           "\"truncated\":%s,\"media_seconds\":%.3f,\"wall_seconds\":%.3f,\"speed_x\":%.2f,"
+           "\"convert_p50_us\":%lld,\"convert_p99_us\":%lld,\"encode_p50_us\":%lld,\"encode_p99_us\":%lld,"
+           "\"mux_p50_us\":%lld,\"mux_p99_us\":%lld,\"video_total_p99_us\":%lld}\n",
+           options.realtime ? "realtime" : "fast",
+           static_cast<long long>(stats.video_frames),
+           static_cast<long long>(stats.repeated_frames),
+           static_cast<long long>(stats.audio_packets),
+           static_cast<long long>(stats.skipped_frames),
+           static_cast<long long>(stats.dropped_video_frames),
+           static_cast<long long>(stats.dropped_audio_packets),
+           reader.truncated() ? "true" : "false",
+           media_seconds, wall_seconds, wall_seconds > 0.0 ? media_seconds / wall_seconds : 0.0,
+           static_cast<long long>(convert.p50_us), static_cast<long long>(convert.p99_us),
+           static_cast<long long>(encode.p50_us), static_cast<long long>(encode.p99_us),
+           static_cast<long long>(mux.p50_us), static_cast<long long>(mux.p99_us),
+           static_cast<long long>(video_total.p99_us));
+    return 0;
+}
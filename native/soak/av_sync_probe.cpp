@@ -0,0 +1,271 @@
+// 녹화 파일의 A/V 오프셋 측정 구현
+
+#include "av_sync_probe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace {
+
+std::string AvErrorToString(int errnum) {
+    char err_buf[128];
+    av_strerror(errnum, err_buf, sizeof(err_buf));
+    return std::string(err_buf);
+}
+
+// 비프음 검출 후 이 시간 이상 조용해야 다음 비프음으로 인정
+constexpr double kBeepReleaseSeconds = 0.02;
+// 마커 영역 평균 밝기(Y)가 이 값을 넘으면 플래시
+constexpr double kFlashLumaThreshold = 128.0;
+
+/// 스트림 하나의 디코더
+struct StreamDecoder {
+    int stream_index = -1;
+    AVCodecContext* codec_ctx = nullptr;
+    double time_base = 0.0;
+
+    ~StreamDecoder() { avcodec_free_context(&codec_ctx); }
+};
+
+bool OpenDecoder(AVFormatContext* format_ctx, AVMediaType type, StreamDecoder* decoder,
+                 std::string* error) {
+    const AVCodec* codec = nullptr;
+    const int index = av_find_best_stream(format_ctx, type, -1, -1, &codec, 0);
+    if (index < 0 || !codec) {
+        *error = std::string(type == AVMEDIA_TYPE_VIDEO ? "비디오" : "오디오") + " 스트림 없음";
+        return false;
+    }
+    AVStream* stream = format_ctx->streams[index];
+    decoder->codec_ctx = avcodec_alloc_context3(codec);
+    if (!decoder->codec_ctx) {
+        *error = "디코더 컨텍스트 할당 실패";
+        return false;
+    }
+    int ret = avcodec_parameters_to_context(decoder->codec_ctx, stream->codecpar);
+    if (ret >= 0) {
+        decoder->codec_ctx->thread_count = 0;  // 자동 (긴 파일 분석 시간 단축)
+        ret = avcodec_open2(decoder->codec_ctx, codec, nullptr);
+    }
+    if (ret < 0) {
+        *error = "디코더 열기 실패: " + AvErrorToString(ret);
+        return false;
+    }
+    decoder->stream_index = index;
+    decoder->time_base = av_q2d(stream->time_base);
+    return true;
+}
+
+/// 디코딩된 프레임에서 마커를 찾는 상태
+class MarkerDetector {
+public:
+    MarkerDetector(const SyntheticRect& region, float beep_threshold)
+        : region_(region), beep_threshold_(beep_threshold) {}
+
+    bool OnVideoFrame(const AVFrame* frame, double seconds, std::string* error) {
+        const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+        if (!desc || (desc->flags & AV_PIX_FMT_FLAG_RGB) || desc->comp[0].depth != 8) {
+            *error = "지원하지 않는 비디오 픽셀 형식";
+            return false;
+        }
+        if (region_.x + region_.width > frame->width || region_.y + region_.height > frame->height) {
+            *error = "마커 영역이 비디오 해상도를 벗어남";
+            return false;
+        }
+
+        // 첫 번째 평면 = 밝기(Y), 2픽셀 간격으로 평균
+        uint64_t sum = 0;
+        uint64_t count = 0;
+        for (int y = region_.y; y < region_.y + region_.height; y += 2) {
+            const uint8_t* row = frame->data[0] + static_cast<ptrdiff_t>(y) * frame->linesize[0];
+            for (int x = region_.x; x < region_.x + region_.width; x += 2) {
+                sum += row[x];
+                count++;
+            }
+        }
+        const bool flash = count > 0 &&
+                           static_cast<double>(sum) / static_cast<double>(count) > kFlashLumaThreshold;
+        if (flash && !flash_on_) {
+            flashes_.push_back(seconds);
+        }
+        flash_on_ = flash;
+        video_end_ = std::max(video_end_, seconds);
+        return true;
+    }
+
+    bool OnAudioFrame(const AVFrame* frame, double seconds, std::string* error) {
+        const AVSampleFormat format = static_cast<AVSampleFormat>(frame->format);
+        if (format != AV_SAMPLE_FMT_FLTP && format != AV_SAMPLE_FMT_FLT) {
+            *error = "지원하지 않는 오디오 샘플 형식";
+            return false;
+        }
+        if (frame->sample_rate <= 0) {
+            *error = "오디오 샘플레이트 없음";
+            return false;
+        }
+
+        // 첫 번째 채널만 검사 (FLT는 interleaved이므로 채널 수만큼 건너뜀)
+        const float* samples = reinterpret_cast<const float*>(frame->data[0]);
+        const int step = format == AV_SAMPLE_FMT_FLT ? std::max(frame->ch_layout.nb_channels, 1) : 1;
+        const int64_t release_samples =
+            static_cast<int64_t>(kBeepReleaseSeconds * frame->sample_rate);
+        for (int i = 0; i < frame->nb_samples; ++i) {
+            const bool loud = std::fabs(samples[static_cast<size_t>(i) * step]) > beep_threshold_;
+            if (!beep_on_) {
+                if (loud) {
+                    beeps_.push_back(seconds + static_cast<double>(i) / frame->sample_rate);
+                    beep_on_ = true;
+                    quiet_samples_ = 0;
+                }
+            } else if (loud) {
+                quiet_samples_ = 0;
+            } else if (++quiet_samples_ > release_samples) {
+                beep_on_ = false;
+            }
+        }
+        audio_end_ = std::max(audio_end_, seconds + static_cast<double>(frame->nb_samples) / frame->sample_rate);
+        next_audio_seconds_ = seconds + static_cast<double>(frame->nb_samples) / frame->sample_rate;
+        return true;
+    }
+
+    double next_audio_seconds() const { return next_audio_seconds_; }
+    const std::vector<double>& flashes() const { return flashes_; }
+    const std::vector<double>& beeps() const { return beeps_; }
+    double video_end() const { return video_end_; }
+    double audio_end() const { return audio_end_; }
+
+private:
+    SyntheticRect region_;
+    float beep_threshold_;
+    bool flash_on_ = false;
+    bool beep_on_ = false;
+    int64_t quiet_samples_ = 0;
+    double next_audio_seconds_ = 0.0;
+    double video_end_ = 0.0;
+    double audio_end_ = 0.0;
+    std::vector<double> flashes_;
+    std::vector<double> beeps_;
+};
+
+// 입력: 디코더, 보낼 패킷 (nullptr이면 flush)
+// 출력: 디코딩된 모든 프레임을 detector에 전달
+bool DecodePacket(StreamDecoder& decoder, const AVPacket* packet, AVFrame* frame,
+                  MarkerDetector& detector, std::string* error) {
+    int ret = avcodec_send_packet(decoder.codec_ctx, packet);
+    if (ret < 0 && ret != AVERROR_EOF) {
+        *error = "avcodec_send_packet 실패: " + AvErrorToString(ret);
+        return false;
+    }
+    while (true) {
+        ret = avcodec_receive_frame(decoder.codec_ctx, frame);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) return true;
+        if (ret < 0) {
+            *error = "avcodec_receive_frame 실패: " + AvErrorToString(ret);
+            return false;
+        }
+
+        bool ok;
+        if (decoder.codec_ctx->codec_type == AVMEDIA_TYPE_VIDEO) {
+            if (frame->best_effort_timestamp == AV_NOPTS_VALUE) {
+                av_frame_unref(frame);
+                continue;
+            }
+            ok = detector.OnVideoFrame(
+                frame, static_cast<double>(frame->best_effort_timestamp) * decoder.time_base, error);
+        } else {
+            // 타임스탬프가 없으면 직전 프레임 끝에 이어붙임
+            const double seconds = frame->best_effort_timestamp == AV_NOPTS_VALUE
+                                       ? detector.next_audio_seconds()
+                                       : static_cast<double>(frame->best_effort_timestamp) * decoder.time_base;
+            ok = detector.OnAudioFrame(frame, seconds, error);
+        }
+        av_frame_unref(frame);
+        if (!ok) return false;
+    }
+}
+
+}  // namespace
+
+bool ProbeAvSync(const std::string& path, const SyntheticLecture& lecture,
+                 AvSyncReport* report, std::string* error) {
+    *report = AvSyncReport{};
+
+    AVFormatContext* format_ctx = nullptr;
+    int ret = avformat_open_input(&format_ctx, path.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        *error = "파일 열기 실패: " + AvErrorToString(ret);
+        return false;
+    }
+    ret = avformat_find_stream_info(format_ctx, nullptr);
+    if (ret < 0) {
+        avformat_close_input(&format_ctx);
+        *error = "스트림 정보 읽기 실패: " + AvErrorToString(ret);
+        return false;
+    }
+
+    StreamDecoder video;
+    StreamDecoder audio;
+    if (!OpenDecoder(format_ctx, AVMEDIA_TYPE_VIDEO, &video, error) ||
+        !OpenDecoder(format_ctx, AVMEDIA_TYPE_AUDIO, &audio, error)) {
+        avformat_close_input(&format_ctx);
+        return false;
+    }
+
+    MarkerDetector detector(lecture.MarkerRegion(), lecture.BeepThreshold());
+    AVPacket* packet = av_packet_alloc();
+    AVFrame* frame = av_frame_alloc();
+    bool ok = packet && frame;
+    if (!ok) *error = "패킷/프레임 할당 실패";
+
+    while (ok && av_read_frame(format_ctx, packet) >= 0) {
+        if (packet->stream_index == video.stream_index) {
+            ok = DecodePacket(video, packet, frame, detector, error);
+        } else if (packet->stream_index == audio.stream_index) {
+            ok = DecodePacket(audio, packet, frame, detector, error);
+        }
+        av_packet_unref(packet);
+    }
+    if (ok) ok = DecodePacket(video, nullptr, frame, detector, error);
+    if (ok) ok = DecodePacket(audio, nullptr, frame, detector, error);
+
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    avformat_close_input(&format_ctx);
+    if (!ok) return false;
+
+    // 플래시마다 가장 가까운 비프음과 짝짓기 (마커 간격의 절반 이내)
+    const std::vector<double>& beeps = detector.beeps();
+    const double max_distance = lecture.config().marker_interval_seconds / 2.0;
+    for (double flash : detector.flashes()) {
+        auto it = std::lower_bound(beeps.begin(), beeps.end(), flash);
+        double best = 0.0;
+        double best_distance = max_distance;
+        bool found = false;
+        if (it != beeps.end() && std::fabs(*it - flash) < best_distance) {
+            best = *it;
+            best_distance = std::fabs(*it - flash);
+            found = true;
+        }
+        if (it != beeps.begin() && std::fabs(*(it - 1) - flash) < best_distance) {
+            best = *(it - 1);
+            found = true;
+        }
+        if (!found) {
+            report->unmatched_flashes++;
+            continue;
+        }
+        report->markers.push_back({flash, best, (best - flash) * 1000.0});
+    }
+
+    report->video_flashes = static_cast<int>(detector.flashes().size());
+    report->audio_beeps = static_cast<int>(beeps.size());
+    report->video_duration_seconds = detector.video_end();
+    report->audio_duration_seconds = detector.audio_end();
+    return true;
+}
@@ -0,0 +1,37 @@
+// 녹화 파일의 A/V 오프셋 측정
+// SyntheticLecture 마커(흰색 사각형 플래시 + 비프음)를 디코딩해서 찾은 뒤
+// 같은 마커의 비디오/오디오 시각 차이를 계산
+
+#ifndef SAT_LEC_REC_AV_SYNC_PROBE_H_
+#define SAT_LEC_REC_AV_SYNC_PROBE_H_
+
+#include <string>
+#include <vector>
+
+#include "synthetic_lecture.h"
+
+/// 마커 하나의 측정 결과
+/// offset_ms > 0: 소리가 화면보다 늦음, < 0: 소리가 화면보다 빠름
+struct AvSyncMarker {
+    double video_seconds = 0.0;
+    double audio_seconds = 0.0;
+    double offset_ms = 0.0;
+};
+
+/// 전체 측정 결과
+struct AvSyncReport {
+    std::vector<AvSyncMarker> markers;
+    int video_flashes = 0;      // 검출된 플래시 수
+    int audio_beeps = 0;        // 검출된 비프음 수
+    int unmatched_flashes = 0;  // 짝이 되는 비프음이 없는 플래시
+    double video_duration_seconds = 0.0;
+    double audio_duration_seconds = 0.0;
+};
+
+/// 입력: 녹화 파일 경로 (UTF-8), 녹화에 사용한 합성 강의
+/// 출력: report (마커별 A/V 오프셋), 실패 시 error
+/// 예외: 없음 (파일 열기/디코딩 실패 시 false)
+bool ProbeAvSync(const std::string& path, const SyntheticLecture& lecture,
+                 AvSyncReport* report, std::string* error);
+
+#endif  // SAT_LEC_REC_AV_SYNC_PROBE_H_
@@ -0,0 +1,456 @@
+// satrec_soak: 가상 시계로 LibavEncoder를 실제 시간보다 빠르게 장시간 구동하는 soak 테스트
+//
+// 합성 강의(SyntheticLecture)를 프레임/오디오 캡처 순서 그대로 인코더에 넣고
+// - 일정 간격마다 메모리(RSS), CPU 사용 시간, 처리 속도를 출력
+// - 종료 후 녹화 파일을 디코딩해서 마커(플래시 + 비프음)의 A/V 오프셋 추이를 측정
+// - --queue-budget-mb를 주면 비디오 큐를 예산만큼 항상 가득 채운 상태(인코더가 큐 길이만큼 밀린 최악의 경우)로
+//   유지해서 저장 형식(BGRA/I420)별 최대 RSS를 비교
+//
+// 사용법: satrec_soak [--hours 3] [--size 1920x1080] [--fps 24] [--output <경로>] [--keep]
+//                     [--container mp4|mkv|ts] [--report-minutes 10] [--slide-minutes 3]
+//                     [--marker-seconds 10] [--max-offset-ms 40]
+//                     [--frame-format bgra|i420] [--queue-budget-mb <MB>]
+// 종료 코드: 0 성공, 1 인자 오류, 2 A/V 오프셋 허용치 초과, 3 인코딩/분석 오류
+//
+// Linux 전용 (/proc/self/statm, getrusage)
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "av_sync_probe.h"
+#include "capture_queue.h"
+#include "capture_source.h"
+#include "frame_converter.h"
+#include "libav_encoder.h"
+#include "media_clock.h"
+#include "native_logger.h"
+#include "recording_pipeline.h"
+#include "synthetic_lecture.h"
+
+namespace {
+
+constexpr int kAudioChunksPerSecond = 100;  // WASAPI 기본 주기 10ms
+
+struct SoakOptions {
+    double hours = 3.0;
+    int width = 1920;
+    int height = 1080;
+    int fps = 24;
+    std::string output_path;
+    bool keep_output = false;
+    RecordingContainer container = RecordingContainer::kFragmentedMp4;
+    double report_minutes = 10.0;
+    double slide_minutes = 3.0;
+    double marker_seconds = 10.0;
+    double max_offset_ms = 40.0;
+    FramePixelFormat frame_format = FramePixelFormat::kBgra;
+    double queue_budget_mb = 0.0;  // 0이면 큐 없이 바로 인코딩
+};
+
+/// 측정 시점의 자원 사용량
+struct ResourceSample {
+    double media_seconds = 0.0;
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;        // 프로세스 전체 (user + sys, 모든 스레드)
+    double generator_seconds = 0.0;  // 합성 콘텐츠 생성에 쓴 시간 (하네스 오버헤드)
+    double rss_mb = 0.0;
+};
+
+void PrintUsage() {
+    fprintf(stderr,
+            "사용법: satrec_soak [--hours 3] [--size 1920x1080] [--fps 24] [--output <경로>] [--keep]\n"
+            "                    [--container mp4|mkv|ts] [--report-minutes 10] [--slide-minutes 3]\n"
+            "                    [--marker-seconds 10] [--max-offset-ms 40]\n"
+            "                    [--frame-format bgra|i420] [--queue-budget-mb <MB>]\n");
+}
+
+bool ParseOptions(int argc, char** argv, SoakOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--keep") == 0) {
+            options->keep_output = true;
+            continue;
+        }
+        if (!value) return false;
+        if (strcmp(arg, "--hours") == 0) {
+            options->hours = atof(value);
+        } else if (strcmp(arg, "--size") == 0) {
+            if (sscanf(value, "%dx%d", &options->width, &options->height) != 2) return false;
+        } else if (strcmp(arg, "--fps") == 0) {
+            options->fps = atoi(value);
+        } else if (strcmp(arg, "--output") == 0) {
+            options->output_path = value;
+        } else if (strcmp(arg, "--container") == 0) {
+            if (strcmp(value, "mp4") == 0) {
+                options->container = RecordingContainer::kFragmentedMp4;
+            } else if (strcmp(value, "mkv") == 0) {
+                options->container = RecordingContainer::kMatroska;
+            } else if (strcmp(value, "ts") == 0) {
+                options->container = RecordingContainer::kMpegTs;
+            } else {
+                return false;
+            }
+        } else if (strcmp(arg, "--report-minutes") == 0) {
+            options->report_minutes = atof(value);
+        } else if (strcmp(arg, "--slide-minutes") == 0) {
+            options->slide_minutes = atof(value);
+        } else if (strcmp(arg, "--marker-seconds") == 0) {
+            options->marker_seconds = atof(value);
+        } else if (strcmp(arg, "--max-offset-ms") == 0) {
+            options->max_offset_ms = atof(value);
+        } else if (strcmp(arg, "--frame-format") == 0) {
+            if (strcmp(value, "bgra") == 0) {
+                options->frame_format = FramePixelFormat::kBgra;
+            } else if (strcmp(value, "i420") == 0) {
+                options->frame_format = FramePixelFormat::kI420;
+            } else {
+                return false;
+            }
+        } else if (strcmp(arg, "--queue-budget-mb") == 0) {
+            options->queue_budget_mb = atof(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    // 인코더 해상도는 짝수여야 함 (YUV420P)
+    return options->hours > 0.0 && options->fps > 0 && options->width >= 64 &&
+           options->height >= 64 && options->width % 2 == 0 && options->height % 2 == 0 &&
+           options->report_minutes > 0.0 && options->marker_seconds > 0.0 && options->queue_budget_mb >= 0.0;
+}
+
+double ProcessCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+double ResidentMb() {
+    long pages_total = 0;
+    long pages_resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0.0;
+    const int fields = fscanf(statm, "%ld %ld", &pages_total, &pages_resident);
+    fclose(statm);
+    if (fields != 2) return 0.0;
+    return static_cast<double>(pages_resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) /
+           (1024.0 * 1024.0);
+}
+
+double PeakResidentMb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;  // Linux: KB
+}
+
+std::string FormatMediaTime(double seconds) {
+    const long long total = static_cast<long long>(seconds);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%02lld:%02lld:%02lld", total / 3600, (total / 60) % 60, total % 60);
+    return buf;
+}
+
+// 입력: (x, y) 점들
+// 출력: 최소제곱 기울기 (점이 2개 미만이면 0)
+double LinearSlope(const std::vector<double>& xs, const std::vector<double>& ys) {
+    const size_t n = std::min(xs.size(), ys.size());
+    if (n < 2) return 0.0;
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        mean_x += xs[i];
+        mean_y += ys[i];
+    }
+    mean_x /= static_cast<double>(n);
+    mean_y /= static_cast<double>(n);
+    double num = 0.0;
+    double den = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        num += (xs[i] - mean_x) * (ys[i] - mean_y);
+        den += (xs[i] - mean_x) * (xs[i] - mean_x);
+    }
+    return den > 0.0 ? num / den : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    SoakOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.output_path.empty()) {
+        options.output_path = (std::filesystem::temp_directory_path() /
+                               (std::string("satrec_soak") +
+                                RecordingContainerExtension(options.container))).u8string();
+    }
+
+    // 인코더 진행 로그는 경고 이상만 (soak 리포트가 묻히지 않도록)
+    NativeLogger::Instance().SetMinLevel(LogLevel::kWarning);
+
+    SyntheticLectureConfig lecture_config;
+    lecture_config.width = options.width;
+    lecture_config.height = options.height;
+    lecture_config.fps = options.fps;
+    lecture_config.slide_interval_seconds = options.slide_minutes * 60.0;
+    lecture_config.marker_interval_seconds = options.marker_seconds;
+    SyntheticLecture lecture(lecture_config);
+
+    ManualMediaClock clock;  // 나노초 tick
+    LibavEncoderConfig config;
+    config.output_path = std::filesystem::u8path(options.output_path).wstring();
+    config.video_width = options.width;
+    config.video_height = options.height;
+    config.video_fps = options.fps;
+    config.audio_sample_rate = lecture_config.sample_rate;
+    config.audio_channels = lecture_config.channels;
+    config.container = options.container;
+    config.clock = &clock;
+
+    // 비디오 큐 (파이프라인과 같은 방식으로 예산 / 프레임 크기로 깊이 결정)
+    const char* frame_format_name = options.frame_format == FramePixelFormat::kI420 ? "i420" : "bgra";
+    const size_t frame_bytes = FramePixelBytes(options.frame_format, options.width, options.height);
+    size_t queue_frames = 0;
+    if (options.queue_budget_mb > 0.0) {
+        const auto budget_bytes = static_cast<size_t>(options.queue_budget_mb * 1024.0 * 1024.0);
+        queue_frames = std::max(RecordingPipeline::kMinVideoQueueFrames, budget_bytes / frame_bytes);
+    }
+    CaptureQueue<FrameData> frame_queue(queue_frames > 0 ? queue_frames : 1);
+    FrameConverter converter;
+
+    printf("[soak] %.2f시간, %dx%d@%d, 출력: %s\n", options.hours, options.width, options.height,
+           options.fps, options.output_path.c_str());
+    printf("[soak] 프레임 저장 %s (%.1fMB/프레임), 큐 %zu프레임 (%.0fMB)\n", frame_format_name,
+           static_cast<double>(frame_bytes) / (1024.0 * 1024.0), queue_frames,
+           static_cast<double>(queue_frames * frame_bytes) / (1024.0 * 1024.0));
+
+    const auto wall_started_at = std::chrono::steady_clock::now();
+    const double cpu_started_at = ProcessCpuSeconds();
+    double generator_seconds = 0.0;
+    auto take_sample = [&](double media_seconds) {
+        ResourceSample sample;
+        sample.media_seconds = media_seconds;
+        sample.wall_seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - wall_started_at).count();
+        sample.cpu_seconds = ProcessCpuSeconds() - cpu_started_at;
+        sample.generator_seconds = generator_seconds;
+        sample.rss_mb = ResidentMb();
+        return sample;
+    };
+
+    LibavEncoder encoder;
+    if (!encoder.Start(config)) {
+        fprintf(stderr, "❌ 인코더 시작 실패: %s\n", encoder.GetLastError().c_str());
+        return 3;
+    }
+
+    std::vector<ResourceSample> samples;
+    samples.push_back(take_sample(0.0));
+
+    const int chunk_frames = lecture_config.sample_rate / kAudioChunksPerSecond;
+    std::vector<float> audio(static_cast<size_t>(chunk_frames) * lecture_config.channels);
+    const double total_seconds = options.hours * 3600.0;
+    const int64_t total_video_frames = std::llround(total_seconds * options.fps);
+    const int64_t total_audio_chunks = std::llround(total_seconds * kAudioChunksPerSecond);
+    const double report_interval = options.report_minutes * 60.0;
+    double next_report = report_interval;
+
+    int64_t video_index = 0;
+    int64_t audio_chunk = 0;
+    bool encode_ok = true;
+    std::string convert_error;
+    auto encode_frame = [&](const FrameData& queued) {
+        return queued.format == FramePixelFormat::kI420
+            ? encoder.EncodeVideoI420(queued.pixels.data(), queued.pixels.size(), queued.timestamp)
+            : encoder.EncodeVideo(queued.pixels.data(), queued.pixels.size(), queued.timestamp);
+    };
+    while (encode_ok && (video_index < total_video_frames || audio_chunk < total_audio_chunks)) {
+        // 캡처 시각 순서대로 인코더에 전달 (같은 시각이면 오디오 먼저)
+        const uint64_t video_ticks = static_cast<uint64_t>(video_index) * clock.Frequency() / options.fps;
+        const uint64_t audio_ticks = static_cast<uint64_t>(audio_chunk) * clock.Frequency() / kAudioChunksPerSecond;
+        const bool next_is_audio = audio_chunk < total_audio_chunks &&
+                                   (video_index >= total_video_frames || audio_ticks <= video_ticks);
+
+        const auto render_started_at = std::chrono::steady_clock::now();
+        FrameData frame;
+        if (next_is_audio) {
+            lecture.RenderAudio(audio_chunk * chunk_frames, chunk_frames, audio.data());
+        } else {
+            frame.pixels.resize(lecture.FrameBytes());
+            frame.width = options.width;
+            frame.height = options.height;
+            lecture.RenderVideoFrame(video_index, frame.pixels.data());
+        }
+        generator_seconds += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - render_started_at).count();
+
+        if (next_is_audio) {
+            clock.Set(audio_ticks);
+            encode_ok = encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(audio.data()),
+                                            audio.size() * sizeof(float), clock.Now());
+            audio_chunk++;
+        } else {
+            clock.Set(video_ticks);
+            frame.timestamp = clock.Now();
+            // 캡처 스레드와 같이 큐에 넣기 전 변환
+            if (options.frame_format == FramePixelFormat::kI420 &&
+                !converter.ConvertToI420(&frame, &convert_error)) {
+                fprintf(stderr, "❌ I420 변환 실패: %s\n", convert_error.c_str());
+                encode_ok = false;
+                break;
+            }
+            if (queue_frames == 0) {
+                encode_ok = encode_frame(frame);
+            } else {
+                // 큐가 가득 찬 상태를 유지: 가장 오래된 프레임 하나를 꺼내 인코딩
+                frame_queue.Push(std::move(frame));
+                FrameData oldest;
+                if (frame_queue.Size() >= queue_frames && frame_queue.TryPop(&oldest)) {
+                    encode_ok = encode_frame(oldest);
+                }
+            }
+            video_index++;
+        }
+
+        const double media_seconds = static_cast<double>(clock.Now()) / static_cast<double>(clock.Frequency());
+        if (media_seconds >= next_report) {
+            const ResourceSample sample = take_sample(media_seconds);
+            const ResourceSample& first = samples.front();
+            printf("[soak] %s | 벽시계 %.1fs (%.1fx) | CPU %.1fs (생성 %.1fs) | RSS %.1fMB (%+.1fMB)\n",
+                   FormatMediaTime(media_seconds).c_str(), sample.wall_seconds,
+                   sample.wall_seconds > 0.0 ? media_seconds / sample.wall_seconds : 0.0,
+                   sample.cpu_seconds, sample.generator_seconds, sample.rss_mb,
+                   sample.rss_mb - first.rss_mb);
+            fflush(stdout);
+            samples.push_back(sample);
+            next_report += report_interval;
+        }
+    }
+
+    // 큐에 남은 프레임 인코딩
+    FrameData remaining;
+    while (encode_ok && frame_queue.TryPop(&remaining)) {
+        encode_ok = encode_frame(remaining);
+    }
+    if (!encode_ok) {
+        fprintf(stderr, "❌ 인코딩 실패: %s\n", encoder.GetLastError().c_str());
+    }
+    encoder.Stop();
+    const double media_seconds = static_cast<double>(clock.Now()) / static_cast<double>(clock.Frequency());
+    const ResourceSample end_sample = take_sample(media_seconds);
+    if (samples.back().media_seconds < media_seconds) samples.push_back(end_sample);
+    NativeLogger::Instance().Flush();
+    if (!encode_ok) return 3;
+
+    // === A/V 오프셋 분석 ===
+    printf("[soak] 녹화 파일 분석 중...\n");
+    fflush(stdout);
+    AvSyncReport report;
+    std::string error;
+    const auto probe_started_at = std::chrono::steady_clock::now();
+    const bool probe_ok = ProbeAvSync(options.output_path, lecture, &report, &error);
+    const double probe_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - probe_started_at).count();
+    if (!options.keep_output) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(options.output_path), ec);
+    }
+    if (!probe_ok) {
+        fprintf(stderr, "❌ 녹화 파일 분석 실패: %s\n", error.c_str());
+        return 3;
+    }
+
+    // 리포트 구간별 오프셋 (평균/최소/최대)
+    std::vector<double> marker_hours;
+    std::vector<double> marker_offsets;
+    double offset_min = 0.0;
+    double offset_max = 0.0;
+    for (size_t i = 0; i < report.markers.size(); ++i) {
+        const AvSyncMarker& marker = report.markers[i];
+        marker_hours.push_back(marker.video_seconds / 3600.0);
+        marker_offsets.push_back(marker.offset_ms);
+        offset_min = i == 0 ? marker.offset_ms : std::min(offset_min, marker.offset_ms);
+        offset_max = i == 0 ? marker.offset_ms : std::max(offset_max, marker.offset_ms);
+    }
+    for (double window_start = 0.0; window_start < media_seconds; window_start += report_interval) {
+        double sum = 0.0;
+        double low = 0.0;
+        double high = 0.0;
+        int count = 0;
+        for (const AvSyncMarker& marker : report.markers) {
+            if (marker.video_seconds < window_start || marker.video_seconds >= window_start + report_interval) continue;
+            low = count == 0 ? marker.offset_ms : std::min(low, marker.offset_ms);
+            high = count == 0 ? marker.offset_ms : std::max(high, marker.offset_ms);
+            sum += marker.offset_ms;
+            count++;
+        }
+        if (count == 0) {
+            printf("[soak] A/V %s~ | 마커 없음\n", FormatMediaTime(window_start).c_str());
+        } else {
+            printf("[soak] A/V %s~ | 마커 %d개 | 평균 %+.1fms (최소 %+.1f, 최대 %+.1f)\n",
+                   FormatMediaTime(window_start).c_str(), count, sum / count, low, high);
+        }
+    }
+
+    // 메모리 증가율: 첫 리포트 이후(인코더 버퍼 할당이 끝난 뒤) 구간의 기울기
+    std::vector<double> rss_hours;
+    std::vector<double> rss_values;
+    for (size_t i = samples.size() > 2 ? 1 : 0; i < samples.size(); ++i) {
+        rss_hours.push_back(samples[i].media_seconds / 3600.0);
+        rss_values.push_back(samples[i].rss_mb);
+    }
+    const double media_hours = media_seconds / 3600.0;
+    const double encoder_cpu_seconds = end_sample.cpu_seconds - end_sample.generator_seconds;
+    const int expected_markers = static_cast<int>(
+        (total_video_frames - 1) / lecture.MarkerFrameInterval());
+
+    // 기계 판독용 결과 (한 줄 JSON)
+    printf("{\"frame_format\":\"%s\",\"queue_frames\":%zu,\"queue_mb\":%.0f,"
+           "\"media_hours\":%.3f,\"wall_seconds\":%.1f,\"speed_x\":%.2f,"
+           "\"cpu_seconds_per_media_hour\":%.1f,\"encoder_cpu_seconds_per_media_hour\":%.1f,"
+           "\"rss_start_mb\":%.1f,\"rss_end_mb\":%.1f,\"rss_peak_mb\":%.1f,\"rss_growth_mb_per_hour\":%.2f,"
+           "\"markers_expected\":%d,\"video_flashes\":%d,\"audio_beeps\":%d,\"markers_matched\":%d,"
+           "\"offset_ms_first\":%.1f,\"offset_ms_last\":%.1f,\"offset_ms_min\":%.1f,\"offset_ms_max\":%.1f,"
+           "\"drift_ms_per_hour\":%.2f,\"video_duration_seconds\":%.3f,\"audio_duration_seconds\":%.3f,"
+           "\"probe_seconds\":%.1f}\n",
+           frame_format_name, queue_frames,
+           static_cast<double>(queue_frames * frame_bytes) / (1024.0 * 1024.0),
+           media_hours, end_sample.wall_seconds,
+           end_sample.wall_seconds > 0.0 ? media_seconds / end_sample.wall_seconds : 0.0,
+           media_hours > 0.0 ? end_sample.cpu_seconds / media_hours : 0.0,
+           media_hours > 0.0 ? encoder_cpu_seconds / media_hours : 0.0,
+           samples.front().rss_mb, end_sample.rss_mb, PeakResidentMb(),
+           LinearSlope(rss_hours, rss_values),
+           expected_markers, report.video_flashes, report.audio_beeps,
+           static_cast<int>(report.markers.size()),
+           report.markers.empty() ? 0.0 : report.markers.front().offset_ms,
+           report.markers.empty() ? 0.0 : report.markers.back().offset_ms,
+           offset_min, offset_max, LinearSlope(marker_hours, marker_offsets),
+           report.video_duration_seconds, report.audio_duration_seconds, probe_seconds);
+
+    const bool markers_ok = !report.markers.empty() && report.unmatched_flashes == 0 &&
+                            static_cast<int>(report.markers.size()) >= expected_markers;
+    const bool offset_ok = std::fabs(offset_min) <= options.max_offset_ms &&
+                           std::fabs(offset_max) <= options.max_offset_ms;
+    if (!markers_ok || !offset_ok) {
+        fprintf(stderr, "❌ A/V 동기화 검증 실패: 마커 %d/%d개 검출, 오프셋 %+.1f~%+.1fms (허용 ±%.0fms)\n",
+                static_cast<int>(report.markers.size()), expected_markers, offset_min, offset_max,
+                options.max_offset_ms);
+        return 2;
+    }
+    return 0;
+}
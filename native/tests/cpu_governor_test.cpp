@@ -0,0 +1,249 @@
+// CpuGovernor 테스트: fps 단계 목록, 다음 녹화 인코더 단계, 히스테리시스 판단 (낮춤/보류/복원/유지 구간),
+// 실제 바쁜 스레드를 CpuUsageSampler로 재서 낮췄다가 부하가 끝나면 복원
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "cpu_governor.h"
+
+namespace {
+
+std::vector<int> LadderFps(const std::vector<CpuGovernorLevel>& ladder) {
+    std::vector<int> fps;
+    for (const CpuGovernorLevel& level : ladder) fps.push_back(level.capture_fps);
+    return fps;
+}
+
+TEST(CpuGovernorLadderTest, StepsFpsDownToFloor) {
+    EXPECT_EQ(LadderFps(BuildCpuGovernorLadder(24, 8)), (std::vector<int>{24, 18, 12, 8}));
+    EXPECT_EQ(LadderFps(BuildCpuGovernorLadder(30, 8)), (std::vector<int>{30, 22, 15, 10}));
+    // 하한에 닿은 단계는 합침
+    EXPECT_EQ(LadderFps(BuildCpuGovernorLadder(24, 12)), (std::vector<int>{24, 18, 12}));
+    // 원래 fps가 하한보다 낮으면 단계 하나
+    EXPECT_EQ(LadderFps(BuildCpuGovernorLadder(5, 8)), (std::vector<int>{5}));
+}
+
+TEST(CpuGovernorLadderTest, EncoderStepsForNextSession) {
+    const std::vector<CpuEncoderStep> steps = BuildCpuEncoderSteps("veryfast", 8);
+    ASSERT_EQ(steps.size(), 3u);
+    EXPECT_STREQ(steps[0].preset, "veryfast");
+    EXPECT_EQ(steps[0].encoder_threads, 0);
+    EXPECT_STREQ(steps[1].preset, "superfast");
+    EXPECT_EQ(steps[1].encoder_threads, 4);
+    EXPECT_STREQ(steps[2].preset, "ultrafast");
+    EXPECT_EQ(steps[2].encoder_threads, 2);
+
+    // ultrafast는 더 빠른 preset이 없으므로 스레드만 줄임
+    const std::vector<CpuEncoderStep> fastest = BuildCpuEncoderSteps("ultrafast", 8);
+    ASSERT_EQ(fastest.size(), 3u);
+    EXPECT_STREQ(fastest[1].preset, "ultrafast");
+    EXPECT_EQ(fastest[1].encoder_threads, 4);
+    // 알 수 없는 preset은 LibavEncoderConfig 기본값(veryfast)으로 봄
+    EXPECT_STREQ(BuildCpuEncoderSteps("bogus", 8)[0].preset, "veryfast");
+}
+
+class CpuGovernorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.budget_percent = 30.0;
+        governor_.Reset(config_, BuildCpuGovernorLadder(24, config_.min_capture_fps), 0);
+    }
+
+    // 입력: 녹화/시스템 사용률, 시작/끝 시각(ms, 1초 간격) / 출력: 그 구간에서 마지막으로 바뀐 판단
+    CpuGovernorDecision Feed(double recorder_percent, double system_percent, int64_t from_ms, int64_t to_ms) {
+        CpuGovernorDecision changed;
+        CpuUsageSample sample;
+        sample.recorder_percent = recorder_percent;
+        sample.system_percent = system_percent;
+        for (int64_t t = from_ms; t <= to_ms; t += 1000) {
+            const CpuGovernorDecision decision = governor_.Update(sample, t);
+            if (decision.action != CpuGovernorAction::kNone) {
+                changed = decision;
+                changes_++;
+            }
+        }
+        return changed;
+    }
+
+    CpuGovernorConfig config_;
+    CpuGovernor governor_;
+    int changes_ = 0;
+};
+
+TEST_F(CpuGovernorTest, DegradesAfterSustainedPressureThenHolds) {
+    // 압박 3초(degrade_after_ms) 전에는 그대로
+    Feed(40.0, 50.0, 0, 2000);
+    EXPECT_EQ(governor_.level(), 0);
+
+    const CpuGovernorDecision decision = Feed(40.0, 50.0, 3000, 3000);
+    EXPECT_EQ(decision.action, CpuGovernorAction::kDegrade);
+    EXPECT_STREQ(decision.reason, "recorder_over_budget");
+    EXPECT_EQ(decision.from_level, 0);
+    EXPECT_EQ(decision.to_level, 1);
+    EXPECT_EQ(governor_.current().capture_fps, 18);
+
+    // 변경 후 hold_ms(5초) 동안은 압박이 이어져도 판단하지 않고, 그 뒤 다시 3초가 지나야 다음 단계
+    Feed(40.0, 50.0, 4000, 10000);
+    EXPECT_EQ(governor_.level(), 1);
+    Feed(40.0, 50.0, 11000, 11000);
+    EXPECT_EQ(governor_.level(), 2);
+    EXPECT_EQ(changes_, 2);
+}
+
+TEST_F(CpuGovernorTest, SystemSaturationDegradesWithinBudget) {
+    const CpuGovernorDecision decision = Feed(20.0, 95.0, 0, 3000);
+    EXPECT_EQ(decision.action, CpuGovernorAction::kDegrade);
+    EXPECT_STREQ(decision.reason, "system_saturated");
+    EXPECT_EQ(governor_.level(), 1);
+}
+
+TEST_F(CpuGovernorTest, RestoresOnlyAfterLongHeadroom) {
+    Feed(40.0, 50.0, 0, 3000);
+    ASSERT_EQ(governor_.level(), 1);
+
+    // 보류가 끝난 8초부터 여유 15초(restore_after_ms) 전에는 복원하지 않음
+    Feed(10.0, 40.0, 4000, 22000);
+    EXPECT_EQ(governor_.level(), 1);
+    const CpuGovernorDecision decision = Feed(10.0, 40.0, 23000, 23000);
+    EXPECT_EQ(decision.action, CpuGovernorAction::kRestore);
+    EXPECT_STREQ(decision.reason, "headroom");
+    EXPECT_EQ(governor_.level(), 0);
+}
+
+TEST_F(CpuGovernorTest, KeepsLevelBetweenRestoreAndBudget) {
+    Feed(40.0, 50.0, 0, 3000);
+    ASSERT_EQ(governor_.level(), 1);
+
+    // 예산의 70~100% (21~30%): 낮추지도 복원하지도 않음
+    Feed(25.0, 60.0, 4000, 60000);
+    EXPECT_EQ(governor_.level(), 1);
+    EXPECT_EQ(changes_, 1);
+
+    // 여유 타이머는 유지 구간에서 끊김 → 여유 14초 + 유지 1초 + 여유 14초로는 복원하지 않음
+    Feed(10.0, 40.0, 61000, 75000);
+    Feed(25.0, 60.0, 76000, 76000);
+    Feed(10.0, 40.0, 77000, 91000);
+    EXPECT_EQ(governor_.level(), 1);
+}
+
+TEST_F(CpuGovernorTest, AdvisesFasterEncoderWhenFpsLadderIsExhausted) {
+    // 24 → 18 → 12 → 8fps: 단계마다 3초 압박 + 5초 보류
+    Feed(40.0, 50.0, 0, 19000);
+    ASSERT_EQ(governor_.level(), governor_.level_count() - 1);
+    EXPECT_EQ(governor_.EncoderStepDelta(), 0);
+
+    // 마지막 단계에서도 예산 초과가 이어지면 다음 녹화에서 인코더 단계를 낮춤 (녹화 중에는 그대로)
+    Feed(40.0, 50.0, 20000, 40000);
+    EXPECT_EQ(governor_.level(), governor_.level_count() - 1);
+    EXPECT_EQ(governor_.EncoderStepDelta(), 1);
+}
+
+TEST_F(CpuGovernorTest, AdvisesRestoringEncoderOnlyWithoutDegrades) {
+    Feed(10.0, 40.0, 0, 15000);
+    EXPECT_EQ(governor_.EncoderStepDelta(), -1);
+
+    // 한 번이라도 낮춘 녹화는 되돌리라고 권하지 않음
+    governor_.Reset(config_, BuildCpuGovernorLadder(24, config_.min_capture_fps), 0);
+    Feed(40.0, 50.0, 0, 3000);
+    Feed(10.0, 40.0, 4000, 60000);
+    EXPECT_EQ(governor_.level(), 0);
+    EXPECT_EQ(governor_.EncoderStepDelta(), 0);
+}
+
+TEST_F(CpuGovernorTest, DisabledBudgetNeverChanges) {
+    config_.budget_percent = 0.0;
+    governor_.Reset(config_, BuildCpuGovernorLadder(24, config_.min_capture_fps), 0);
+    Feed(100.0, 100.0, 0, 60000);
+    EXPECT_EQ(governor_.level(), 0);
+    EXPECT_EQ(changes_, 0);
+}
+
+// 실제 측정: 이 프로세스에서 쉬지 않고 도는 스레드 (녹화 프로세스의 CPU 사용률로 잡힘)
+class BusyThreads {
+public:
+    ~BusyThreads() { Stop(); }
+
+    void Start(int threads) {
+        stop_ = false;
+        for (int i = 0; i < threads; i++) {
+            threads_.emplace_back([this] {
+                volatile uint64_t sink = 0;
+                while (!stop_.load(std::memory_order_relaxed)) {
+                    for (int n = 0; n < 10000; n++) sink = sink * 6364136223846793005ULL + 1;
+                }
+            });
+        }
+    }
+
+    void Stop() {
+        stop_ = true;
+        for (auto& thread : threads_) thread.join();
+        threads_.clear();
+    }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+class CpuGovernorSamplerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 예산 = 코어 반 개 분량 → 바쁜 스레드 2개는 (할당된 코어가 하나뿐이어도) 예산의 두 배 이상
+        const int cpus = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        config_.budget_percent = 50.0 / cpus;
+        // 다른 프로그램의 부하와 무관하게 녹화 사용률로만 판단
+        config_.system_high_percent = 101.0;
+        config_.system_restore_percent = 101.0;
+        config_.degrade_after_ms = 300;
+        config_.restore_after_ms = 600;
+        config_.hold_ms = 200;
+        governor_.Reset(config_, BuildCpuGovernorLadder(24, config_.min_capture_fps), NowMs());
+        CpuUsageSample baseline;
+        sampler_.Sample(&baseline);
+    }
+
+    static int64_t NowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 입력: 끝낼 조건, 최대 대기 시간 / 출력: 조건을 만족했는지 (100ms마다 측정 → Update)
+    template <typename Done>
+    bool SampleUntil(Done done, std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            CpuUsageSample sample;
+            if (!sampler_.Sample(&sample)) continue;
+            governor_.Update(sample, NowMs());
+            if (done()) return true;
+        }
+        return false;
+    }
+
+    CpuGovernorConfig config_;
+    CpuGovernor governor_;
+    CpuUsageSampler sampler_;
+};
+
+TEST_F(CpuGovernorSamplerTest, DegradesUnderRealLoadAndRestoresAfter) {
+    BusyThreads load;
+    load.Start(2);
+    const bool degraded = SampleUntil([this] { return governor_.level() >= 1; }, std::chrono::seconds(5));
+    load.Stop();
+    ASSERT_TRUE(degraded) << "예산 " << config_.budget_percent << "%를 넘는 부하에서 낮추지 않음";
+    EXPECT_LT(governor_.current().capture_fps, 24);
+
+    EXPECT_TRUE(SampleUntil([this] { return governor_.level() == 0; }, std::chrono::seconds(10)));
+    EXPECT_EQ(governor_.current().capture_fps, 24);
+}
+
+}  // namespace
@@ -0,0 +1,220 @@
+// 인코더 자식 프로세스 테스트: 공유 메모리 링을 fork한 프로세스 사이에서 주고받기 (순서, 한 바퀴 넘기기, 가득 찬 링),
+// satrec_encoder_host를 강제 종료했을 때 재시작과 새 세그먼트 파일 (Linux 전용)
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "capture_source.h"
+#include "encoder_process.h"
+#include "media_clock.h"
+#include "shared_frame_ring.h"
+
+namespace {
+
+constexpr size_t kControlBytes = 64;  // 링 앞의 시작 플래그 영역 (링 헤더의 64바이트 정렬 유지)
+constexpr size_t kSlots = 4;
+constexpr size_t kSlotBytes = 64;
+constexpr uint32_t kItems = 100;  // 슬롯 4개를 25바퀴
+
+// 입력: 순번 / 출력: 그 항목의 데이터 길이 (슬롯마다 길이가 달라야 이전 바퀴 내용이 남았는지 드러남)
+uint32_t ItemBytes(uint32_t seq) { return 16 + seq % 48; }
+
+uint8_t PayloadByte(uint32_t seq, uint32_t offset) { return static_cast<uint8_t>((seq * 7 + offset) & 0xff); }
+
+// 자식 프로세스 소비자: 시작 플래그를 기다린 뒤 순서대로 전부 읽음
+// 반환: 종료 코드 (0 정상, 1 채널 오류, 2 순서/내용 불일치, 3 시간 초과)
+int ConsumeInChild(const std::string& name) {
+    SharedMemoryRegion region;
+    std::string error;
+    if (!region.Open(name, &error)) return 1;
+    auto* start = reinterpret_cast<std::atomic<uint32_t>*>(region.data());
+    SharedFrameRing ring;
+    if (!ring.Attach(region.data() + kControlBytes, region.size() - kControlBytes, kSlots, kSlotBytes, false)) {
+        return 1;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (start->load(std::memory_order_acquire) == 0) {
+        if (std::chrono::steady_clock::now() > deadline) return 3;
+        std::this_thread::yield();
+    }
+    for (uint32_t seq = 0; seq < kItems; seq++) {
+        const SharedRingItem* item = nullptr;
+        while ((item = ring.Peek()) == nullptr) {
+            if (std::chrono::steady_clock::now() > deadline) return 3;
+            std::this_thread::yield();
+        }
+        if (item->timestamp != seq || item->bytes != ItemBytes(seq)) return 2;
+        const uint8_t* payload = SharedFrameRing::Payload(item);
+        for (uint32_t i = 0; i < item->bytes; i++) {
+            if (payload[i] != PayloadByte(seq, i)) return 2;
+        }
+        ring.Release();
+    }
+    return ring.Peek() == nullptr ? 0 : 2;
+}
+
+TEST(SharedFrameRingTest, CrossProcessOrderWraparoundAndFullRing) {
+    const std::string name = "satrec_test_ring_" + std::to_string(getpid());
+    SharedMemoryRegion region;
+    std::string error;
+    ASSERT_TRUE(region.Create(name, kControlBytes + SharedFrameRing::RequiredBytes(kSlots, kSlotBytes), &error))
+        << error;
+    auto* start = new (region.data()) std::atomic<uint32_t>(0);
+    SharedFrameRing ring;
+    ASSERT_TRUE(ring.Attach(region.data() + kControlBytes, region.size() - kControlBytes, kSlots, kSlotBytes, true));
+    ASSERT_EQ(ring.Capacity(), kSlots);
+    ASSERT_GE(ring.MaxItemBytes(), ItemBytes(kItems - 1));
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        _exit(ConsumeInChild(name));
+    }
+
+    auto produce = [&ring](uint32_t seq) {
+        SharedRingItem* item = ring.TryAcquire();
+        if (!item) return false;
+        item->kind = SharedRingItemKind::kVideo;
+        item->timestamp = seq;
+        item->bytes = ItemBytes(seq);
+        uint8_t* payload = SharedFrameRing::Payload(item);
+        for (uint32_t i = 0; i < item->bytes; i++) payload[i] = PayloadByte(seq, i);
+        ring.Publish();
+        return true;
+    };
+
+    // 소비자가 시작하기 전에 채움 → 가득 찬 링은 새 항목을 거절 (가장 오래된 항목을 덮어쓰지 않음)
+    uint32_t seq = 0;
+    for (; seq < kSlots; seq++) ASSERT_TRUE(produce(seq));
+    EXPECT_EQ(ring.Size(), ring.Capacity());
+    EXPECT_FALSE(produce(seq));
+    EXPECT_EQ(ring.Size(), ring.Capacity());
+
+    // 나머지는 소비자와 동시에 (가득 차면 양보 후 다시)
+    start->store(1, std::memory_order_release);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (seq < kItems && std::chrono::steady_clock::now() < deadline) {
+        if (produce(seq)) {
+            seq++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_EQ(seq, kItems);
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0) << "1: 채널 오류, 2: 순서/내용 불일치, 3: 시간 초과";
+    EXPECT_EQ(ring.Size(), 0u);
+}
+
+class EncoderProcessTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+#ifndef SATREC_ENCODER_HOST_PATH
+        GTEST_SKIP() << "satrec_encoder_host를 빌드하지 않음 (SATREC_BUILD_ENCODER_HOST=OFF)";
+#endif
+        output_path_ = std::filesystem::temp_directory_path() /
+                       ("satrec_test_encoder_process_" + std::to_string(getpid()) + ".mp4");
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        for (int i = 0; i < 4; i++) {
+            std::filesystem::remove(RecordingSegmentPath(output_path_.wstring(), i), ec);
+        }
+    }
+
+    // 입력: 넣을 시간(ms) / 출력: 링에 넣은 프레임 수 (실시간 간격, 캡처 스레드 흉내)
+    int PushFrames(EncoderProcess* process, int duration_ms) {
+        FrameData frame;
+        frame.width = kWidth;
+        frame.height = kHeight;
+        frame.pixels.assign(static_cast<size_t>(kWidth) * kHeight * 4, 0x80);
+        int pushed = 0;
+        const auto interval = std::chrono::milliseconds(1000 / kFps);
+        for (int elapsed = 0; elapsed < duration_ms; elapsed += 1000 / kFps) {
+            frame.timestamp = SystemMediaClock::Instance().Now();
+            frame.pixels[static_cast<size_t>(pushed) % frame.pixels.size()] ^= 0xff;
+            if (process->PushVideo(frame)) pushed++;
+            process->Poll();
+            std::this_thread::sleep_for(interval);
+        }
+        return pushed;
+    }
+
+    static constexpr int kWidth = 320;
+    static constexpr int kHeight = 240;
+    static constexpr int kFps = 24;
+    std::filesystem::path output_path_;
+};
+
+TEST_F(EncoderProcessTest, KilledHostRestartsIntoNewSegment) {
+#ifdef SATREC_ENCODER_HOST_PATH
+    EncoderProcessConfig config;
+    config.host_path = SATREC_ENCODER_HOST_PATH;
+    config.encoder.output_path = output_path_.wstring();
+    config.encoder.video_width = kWidth;
+    config.encoder.video_height = kHeight;
+    config.encoder.video_fps = kFps;
+    config.encoder.h264_preset = "ultrafast";
+    config.lower_priority = false;
+
+    EncoderProcess process;
+    std::string error;
+    ASSERT_TRUE(process.Start(config, &error)) << error;
+    process.SetStartTick(SystemMediaClock::Instance().Now());
+    EXPECT_GT(PushFrames(&process, 1000), 0);
+
+    // 크래시 흉내: 자식을 강제 종료 → Poll이 다음 세그먼트로 다시 띄움
+    const int64_t first_pid = process.GetProcessId();
+    ASSERT_GT(first_pid, 0);
+    ASSERT_EQ(kill(static_cast<pid_t>(first_pid), SIGKILL), 0);
+    EncoderProcessStatus status = EncoderProcessStatus::kRunning;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(15);
+    while (status == EncoderProcessStatus::kRunning && std::chrono::steady_clock::now() < deadline) {
+        status = process.Poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(status, EncoderProcessStatus::kRestarted) << process.GetLastError();
+    EXPECT_NE(process.GetProcessId(), first_pid);
+    EXPECT_EQ(process.GetRestartCount(), 1);
+
+    EXPECT_GT(PushFrames(&process, 1000), 0);
+    EXPECT_TRUE(process.Finish(5000)) << process.GetLastError();
+
+    const std::vector<std::wstring> segments = process.GetSegmentPaths();
+    ASSERT_EQ(segments.size(), 2u);
+    EXPECT_EQ(segments[0], output_path_.wstring());
+    EXPECT_EQ(segments[1], RecordingSegmentPath(output_path_.wstring(), 1));
+    EXPECT_NE(std::filesystem::path(segments[1]).stem().string().find("_part2"), std::string::npos);
+    for (const std::wstring& segment : segments) {
+        std::error_code ec;
+        EXPECT_GT(std::filesystem::file_size(segment, ec), 0u) << std::filesystem::path(segment).string();
+        EXPECT_FALSE(ec);
+    }
+    EXPECT_GT(process.GetVideoFrameCount(), 0);
+#endif
+}
+
+}  // namespace
+
+#endif  // _WIN32
@@ -0,0 +1,143 @@
+// ConcatSegments 테스트: Linux에서 LibavEncoder로 만든 세그먼트 (시작 시각이 밀린 재시작 세그먼트 포함)
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "libav_encoder.h"
+#include "media_clock.h"
+#include "mp4_concat.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace {
+
+constexpr int kFps = 24;
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int kAudioChunkFrames = kSampleRate / 100;  // 10ms
+
+std::filesystem::path TestPath(const std::string& name) {
+    return std::filesystem::temp_directory_path() / ("satrec_test_concat_" + name);
+}
+
+// 입력: 경로, 해상도, 첫 프레임 시각(초, 인코더 시작 기준), 길이(초)
+// 출력: H.264 + AAC 세그먼트 (start_seconds > 0이면 인코더 재시작처럼 타임스탬프가 그만큼 밀린 채 시작)
+bool WriteSegment(const std::filesystem::path& path, int width, int height, double start_seconds, double seconds) {
+    ManualMediaClock clock;
+    LibavEncoder encoder;
+    LibavEncoderConfig config;
+    config.output_path = path.wstring();
+    config.video_width = width;
+    config.video_height = height;
+    config.video_fps = kFps;
+    config.audio_sample_rate = kSampleRate;
+    config.audio_channels = kChannels;
+    config.h264_preset = "ultrafast";
+    config.clock = &clock;
+    if (!encoder.Start(config)) return false;
+
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4, 0);
+    const std::vector<float> audio(static_cast<size_t>(kAudioChunkFrames) * kChannels, 0.1f);
+    const auto ticks = [&clock, start_seconds](double t) {
+        return static_cast<uint64_t>((start_seconds + t) * static_cast<double>(clock.Frequency()));
+    };
+    const int frames = static_cast<int>(seconds * kFps);
+    int64_t chunk = 0;
+    bool ok = true;
+    for (int i = 0; ok && i < frames; i++) {
+        for (size_t p = 0; p < frame.size(); p += 4) frame[p] = static_cast<uint8_t>(i * 8);
+        clock.Set(ticks(static_cast<double>(i) / kFps));
+        ok = encoder.EncodeVideo(frame.data(), frame.size(), clock.Now());
+        for (; ok && chunk * kFps < static_cast<int64_t>(i + 1) * 100; chunk++) {
+            clock.Set(ticks(static_cast<double>(chunk) / 100.0));
+            ok = encoder.EncodeAudio(reinterpret_cast<const uint8_t*>(audio.data()), audio.size() * sizeof(float),
+                                     clock.Now());
+        }
+    }
+    encoder.Stop();
+    return ok;
+}
+
+class Mp4ConcatTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::error_code ec;
+        for (const auto& path : created_) std::filesystem::remove(path, ec);
+    }
+
+    std::filesystem::path Track(const std::string& name) {
+        created_.push_back(TestPath(name));
+        return created_.back();
+    }
+
+    std::vector<std::filesystem::path> created_;
+};
+
+TEST_F(Mp4ConcatTest, ClosesTimestampGapsWithMonotonicDts) {
+    // 재시작 세그먼트는 인코더 시작 후 3초/1.5초 지나서 첫 프레임 (정체 후 재개)
+    const auto first = Track("gap_0.mp4");
+    const auto second = Track("gap_1.mp4");
+    const auto third = Track("gap_2.mp4");
+    const auto output = Track("gap_out.mp4");
+    ASSERT_TRUE(WriteSegment(first, 320, 240, 0.0, 2.0));
+    ASSERT_TRUE(WriteSegment(second, 320, 240, 3.0, 2.0));
+    ASSERT_TRUE(WriteSegment(third, 320, 240, 1.5, 2.0));
+
+    ConcatStats stats;
+    std::string error;
+    ASSERT_EQ(ConcatSegments({first.u8string(), second.u8string(), third.u8string()}, output.u8string(), &stats,
+                             &error),
+              ConcatResult::kOk)
+        << error;
+    EXPECT_EQ(stats.segment_count, 3);
+    // 공백은 직전 세그먼트 끝(2초) 뒤의 3초 시작 하나 (1초), 세 번째는 끝(4초)보다 일찍 시작해 뒤로 밀 뿐
+    EXPECT_EQ(stats.gaps_closed, 1);
+    EXPECT_NEAR(stats.closed_gap_seconds, 1.0, 0.1);
+    // 공백을 뺀 세그먼트 길이의 합
+    EXPECT_NEAR(stats.output_duration_seconds, 6.0, 0.25);
+
+    AVFormatContext* ctx = nullptr;
+    ASSERT_GE(avformat_open_input(&ctx, output.u8string().c_str(), nullptr, nullptr), 0);
+    ASSERT_GE(avformat_find_stream_info(ctx, nullptr), 0);
+    EXPECT_NEAR(static_cast<double>(ctx->duration) / AV_TIME_BASE, 6.0, 0.25);
+
+    std::vector<int64_t> last_dts(ctx->nb_streams, AV_NOPTS_VALUE);
+    int64_t packets = 0;
+    AVPacket* pkt = av_packet_alloc();
+    while (av_read_frame(ctx, pkt) >= 0) {
+        int64_t& previous = last_dts[static_cast<size_t>(pkt->stream_index)];
+        ASSERT_NE(pkt->dts, AV_NOPTS_VALUE);
+        if (previous != AV_NOPTS_VALUE) {
+            EXPECT_GT(pkt->dts, previous) << "stream " << pkt->stream_index << " packet " << packets;
+        }
+        previous = pkt->dts;
+        packets++;
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+    avformat_close_input(&ctx);
+    EXPECT_EQ(packets, stats.packet_count);
+}
+
+TEST_F(Mp4ConcatTest, RejectsIncompatibleSegmentsWithoutLeavingOutput) {
+    const auto first = Track("mismatch_0.mp4");
+    const auto second = Track("mismatch_1.mp4");
+    const auto output = Track("mismatch_out.mp4");
+    ASSERT_TRUE(WriteSegment(first, 320, 240, 0.0, 1.0));
+    ASSERT_TRUE(WriteSegment(second, 640, 360, 0.0, 1.0));
+
+    std::string error;
+    EXPECT_EQ(ConcatSegments({first.u8string(), second.u8string()}, output.u8string(), nullptr, &error),
+              ConcatResult::kIncompatible);
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(std::filesystem::exists(output));
+}
+
+}  // namespace
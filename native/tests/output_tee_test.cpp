@@ -0,0 +1,191 @@
+// OutputTee/AsyncOutputWriter 장애 주입 테스트: 멈춘 쓰기, 디스크 부족(ENOSPC), 닫기 시간 초과
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "output_tee.h"
+
+namespace {
+
+// 기록한 바이트를 테스트가 sink 소유권과 무관하게 확인할 수 있도록 공유 버퍼에 보관
+class MemorySink : public OutputSink {
+public:
+    explicit MemorySink(std::shared_ptr<std::vector<uint8_t>> bytes) : bytes_(std::move(bytes)) {}
+
+    bool WriteAt(int64_t offset, const uint8_t* data, size_t size, std::string*) override {
+        const size_t end = static_cast<size_t>(offset) + size;
+        if (bytes_->size() < end) bytes_->resize(end);
+        std::memcpy(bytes_->data() + offset, data, size);
+        return true;
+    }
+    bool Flush(std::string*) override { return true; }
+    void Close() override {}
+
+private:
+    std::shared_ptr<std::vector<uint8_t>> bytes_;
+};
+
+// 멈춘 디스크/네트워크 드라이브: Release 전까지 지정한 호출에서 돌아오지 않음
+struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released = false;
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return released; });
+    }
+    void Release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        cv.notify_all();
+    }
+};
+
+class BlockingSink : public OutputSink {
+public:
+    BlockingSink(std::shared_ptr<Gate> gate, bool block_write, bool block_flush)
+        : gate_(std::move(gate)), block_write_(block_write), block_flush_(block_flush) {}
+
+    bool WriteAt(int64_t, const uint8_t*, size_t, std::string*) override {
+        if (block_write_) gate_->Wait();
+        return true;
+    }
+    bool Flush(std::string*) override {
+        if (block_flush_) gate_->Wait();
+        return true;
+    }
+    void Close() override {}
+
+private:
+    std::shared_ptr<Gate> gate_;
+    bool block_write_;
+    bool block_flush_;
+};
+
+std::vector<uint8_t> MakeChunk(size_t size, int seed) {
+    std::vector<uint8_t> chunk(size);
+    for (size_t i = 0; i < size; i++) chunk[i] = static_cast<uint8_t>((i * 31 + static_cast<size_t>(seed)) & 0xFF);
+    return chunk;
+}
+
+// 입력: 열린 tee, 청크 크기/개수 / 출력: muxer처럼 avio로 쓴 전체 바이트
+std::vector<uint8_t> WriteThroughTee(OutputTee& tee, size_t chunk_size, int chunks) {
+    std::vector<uint8_t> written;
+    for (int i = 0; i < chunks; i++) {
+        const auto chunk = MakeChunk(chunk_size, i);
+        avio_write(tee.GetAvioContext(), chunk.data(), static_cast<int>(chunk.size()));
+        avio_flush(tee.GetAvioContext());
+        written.insert(written.end(), chunk.begin(), chunk.end());
+    }
+    return written;
+}
+
+// 입력: 대상 상태를 읽는 함수, 기다릴 상태 / 출력: 한도(2초) 안에 그 상태가 되었는지
+template <typename GetState>
+bool WaitForState(GetState get_state, OutputDestinationState expected) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (get_state() == expected) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return get_state() == expected;
+}
+
+TEST(OutputTeeTest, StalledSecondaryIsDetachedWhilePrimaryKeepsRecording) {
+    auto primary_bytes = std::make_shared<std::vector<uint8_t>>();
+    auto gate = std::make_shared<Gate>();
+    OutputWriterOptions options;
+    options.stall_timeout_ms = 100;
+
+    OutputTee tee;
+    tee.AddDestination("primary", std::make_unique<MemorySink>(primary_bytes), options);
+    tee.AddDestination("secondary", std::make_unique<BlockingSink>(gate, true, false), options);
+    std::string error;
+    ASSERT_TRUE(tee.Open(&error)) << error;
+
+    // 멈춘 쓰기는 다음 Submit에서 감지되므로 정체 한도를 넘길 때까지 계속 기록
+    std::vector<uint8_t> written = WriteThroughTee(tee, 64 * 1024, 4);
+    const bool stalled = WaitForState(
+        [&tee, &written] {
+            const auto more = WriteThroughTee(tee, 16 * 1024, 1);
+            written.insert(written.end(), more.begin(), more.end());
+            return tee.GetHealth(1).state;
+        },
+        OutputDestinationState::kStalled);
+    EXPECT_TRUE(stalled);
+    EXPECT_EQ(tee.GetHealth(0).state, OutputDestinationState::kHealthy);
+
+    // 분리 후에도 primary는 계속 기록
+    const auto after = WriteThroughTee(tee, 64 * 1024, 8);
+    written.insert(written.end(), after.begin(), after.end());
+    tee.Close();
+
+    EXPECT_EQ(tee.GetHealth(0).state, OutputDestinationState::kHealthy);
+    EXPECT_EQ(tee.GetHealth(1).state, OutputDestinationState::kStalled);
+    EXPECT_FALSE(tee.GetHealth(1).error.empty());
+    EXPECT_EQ(*primary_bytes, written);
+    gate->Release();
+}
+
+TEST(OutputTeeTest, DiskFullSecondaryFailsWhilePrimaryKeepsRecording) {
+    // /dev/full: 모든 쓰기가 ENOSPC로 실패 (FileOutputSink의 fwrite/fflush 오류 경로 그대로)
+    if (!std::filesystem::exists("/dev/full")) {
+        GTEST_SKIP() << "/dev/full 없음";
+    }
+    std::string error;
+    auto full = FileOutputSink::Open("/dev/full", &error);
+    ASSERT_NE(full, nullptr) << error;
+
+    auto primary_bytes = std::make_shared<std::vector<uint8_t>>();
+    OutputTee tee;
+    tee.AddDestination("primary", std::make_unique<MemorySink>(primary_bytes));
+    tee.AddDestination("secondary", std::move(full));
+    ASSERT_TRUE(tee.Open(&error)) << error;
+
+    std::vector<uint8_t> written = WriteThroughTee(tee, 64 * 1024, 4);
+    EXPECT_TRUE(WaitForState([&tee] { return tee.GetHealth(1).state; }, OutputDestinationState::kFailed));
+
+    const auto after = WriteThroughTee(tee, 64 * 1024, 4);
+    written.insert(written.end(), after.begin(), after.end());
+    tee.Close();
+
+    EXPECT_EQ(tee.GetHealth(0).state, OutputDestinationState::kHealthy);
+    const OutputDestinationHealth secondary = tee.GetHealth(1);
+    EXPECT_EQ(secondary.state, OutputDestinationState::kFailed);
+    EXPECT_NE(secondary.error.find(strerror(ENOSPC)), std::string::npos) << secondary.error;
+    EXPECT_EQ(*primary_bytes, written);
+}
+
+TEST(OutputTeeTest, CloseReturnsWithinTimeoutWhenFinalFlushHangs) {
+    auto gate = std::make_shared<Gate>();
+    OutputWriterOptions options;
+    options.close_timeout_ms = 200;
+
+    AsyncOutputWriter writer("secondary", std::make_unique<BlockingSink>(gate, false, true), options);
+    const auto chunk = MakeChunk(4096, 0);
+    ASSERT_TRUE(writer.Submit(0, chunk.data(), chunk.size()));
+
+    const auto started_at = std::chrono::steady_clock::now();
+    writer.Close();
+    const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started_at).count();
+
+    EXPECT_GE(elapsed_ms, options.close_timeout_ms - 20);
+    EXPECT_LT(elapsed_ms, options.close_timeout_ms + 500);
+    EXPECT_EQ(writer.GetHealth().state, OutputDestinationState::kStalled);
+    // 분리된 스레드는 공유 상태만 참조하므로 writer보다 늦게 풀려도 안전
+    gate->Release();
+}
+
+}  // namespace
@@ -0,0 +1,99 @@
+// PipelineWatchdog 테스트: 재시작 요청을 가져가지 않는 단계(호출 안에서 멈춤)와 잠깐 멈췄다 돌아오는 단계
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "media_clock.h"
+#include "pipeline_watchdog.h"
+
+namespace {
+
+constexpr int64_t kDeadlineMs = 500;
+constexpr size_t kEncoder = static_cast<size_t>(WatchedStage::kEncoder);
+
+class PipelineWatchdogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        PipelineWatchdogConfig config;
+        config.stall_deadline_ms = kDeadlineMs;
+        config.max_restarts = 3;
+        watchdog_.Reset(config, &clock_, clock_.Now());
+        watchdog_.Enable(WatchedStage::kEncoder);
+    }
+
+    // 입력: 진행할 시간(ms) / 출력: 인코더 단계의 Check 결과
+    WatchdogAction AdvanceAndCheck(int64_t ms) {
+        clock_.Advance(static_cast<uint64_t>(ms) * 1000000ULL);
+        watchdog_.Check(clock_.Now(), actions_, values_);
+        return actions_[kEncoder];
+    }
+
+    StageHeartbeat& heartbeat() { return watchdog_.heartbeat(WatchedStage::kEncoder); }
+
+    ManualMediaClock clock_;
+    PipelineWatchdog watchdog_;
+    WatchdogAction actions_[static_cast<size_t>(WatchedStage::kCount)];
+    int64_t values_[static_cast<size_t>(WatchedStage::kCount)];
+};
+
+TEST_F(PipelineWatchdogTest, StageThatNeverTakesRestartIsUnresponsive) {
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kRestartRequested);
+
+    // 요청을 가져가지 않는 동안에는 재시작을 더 세지 않음 (한도에 닿아 "재시작 3회"로 끝나지 않음)
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kNone);
+    }
+    EXPECT_EQ(watchdog_.GetStats(WatchedStage::kEncoder).restarts, 1);
+
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kUnresponsive);
+    EXPECT_EQ(values_[kEncoder], kDeadlineMs * 5);
+    const WatchdogStageStats stats = watchdog_.GetStats(WatchedStage::kEncoder);
+    EXPECT_TRUE(stats.failed);
+    EXPECT_TRUE(stats.unresponsive);
+    EXPECT_EQ(stats.recoveries, 0);
+
+    // 늦게 돌아온 스레드는 요청을 받지 못하고, 이후 확인은 조용함
+    EXPECT_FALSE(heartbeat().TakeRestartRequest());
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kNone);
+}
+
+TEST_F(PipelineWatchdogTest, StageThatReturnsLateRestartsOnce) {
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kRestartRequested);
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kNone);
+
+    // 기한을 넘겨 돌아온 스레드가 요청을 가져가 재시작 (재시작 기한은 가져간 뒤부터)
+    clock_.Advance(100 * 1000000ULL);
+    ASSERT_TRUE(heartbeat().TakeRestartRequest());
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs - 200), WatchdogAction::kNone);
+    heartbeat().RestartDone(clock_.Now());
+    clock_.Advance(10 * 1000000ULL);
+    heartbeat().Beat(clock_.Now());
+
+    EXPECT_EQ(AdvanceAndCheck(10), WatchdogAction::kRecovered);
+    EXPECT_EQ(values_[kEncoder], kDeadlineMs + 100 + kDeadlineMs - 200 + 10);
+    const WatchdogStageStats stats = watchdog_.GetStats(WatchedStage::kEncoder);
+    EXPECT_EQ(stats.restarts, 1);
+    EXPECT_EQ(stats.recoveries, 1);
+    EXPECT_FALSE(stats.failed);
+    EXPECT_FALSE(stats.unresponsive);
+}
+
+TEST_F(PipelineWatchdogTest, RestartThatKeepsFailingGivesUp) {
+    EXPECT_EQ(AdvanceAndCheck(kDeadlineMs), WatchdogAction::kRestartRequested);
+    for (int i = 0; i < 2; i++) {
+        // 요청은 가져가지만 재시작이 실패
+        ASSERT_TRUE(heartbeat().TakeRestartRequest());
+        heartbeat().RestartDone(clock_.Now() + 1);
+        heartbeat().ReportFault();
+        EXPECT_EQ(AdvanceAndCheck(10), WatchdogAction::kRestartRequested);
+    }
+    ASSERT_TRUE(heartbeat().TakeRestartRequest());
+    heartbeat().RestartDone(clock_.Now() + 1);
+    heartbeat().ReportFault();
+    EXPECT_EQ(AdvanceAndCheck(10), WatchdogAction::kGaveUp);
+    EXPECT_EQ(values_[kEncoder], 3);
+    EXPECT_FALSE(watchdog_.GetStats(WatchedStage::kEncoder).unresponsive);
+}
+
+}  // namespace
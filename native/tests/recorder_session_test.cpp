@@ -0,0 +1,137 @@
+// RecorderSession 종료 순서 테스트: 종료 이벤트는 on_finished와 끝남 표시 뒤에 전달되어야 함
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "generator_source.h"
+#include "recorder_events.h"
+#include "recorder_session.h"
+
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+
+// 종료 이벤트를 받은 순간의 세션 상태를 기록 (Dart가 이벤트를 받고 IsFinalizing/Launch를 부르는 시점)
+class StopOrderSink : public RecorderEventSink {
+public:
+    void Attach(RecorderSession* session, const std::atomic<bool>* on_finished_called) {
+        session_ = session;
+        on_finished_called_ = on_finished_called;
+    }
+
+    void OnRecorderEvent(const RecorderEvent& event) override {
+        if (event.type != RecorderEventType::kStopped && event.type != RecorderEventType::kStoppedWithError) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_events_++;
+        last_type_ = event.type;
+        finished_at_stop_ = session_->IsFinished();
+        stopping_at_stop_ = session_->IsStopping();
+        on_finished_before_stop_ = on_finished_called_ && on_finished_called_->load();
+        cv_.notify_all();
+    }
+
+    bool WaitForStop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(10), [this] { return stop_events_ > 0; });
+    }
+
+    int stop_events() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stop_events_;
+    }
+
+    RecorderEventType last_type_ = RecorderEventType::kStopped;
+    bool finished_at_stop_ = false;
+    bool stopping_at_stop_ = true;
+    bool on_finished_before_stop_ = false;
+
+private:
+    RecorderSession* session_ = nullptr;
+    const std::atomic<bool>* on_finished_called_ = nullptr;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int stop_events_ = 0;
+};
+
+RecorderSessionConfig MakeConfig(const std::filesystem::path& path, RecorderEventSink* sink,
+                                 std::atomic<bool>* on_finished_called) {
+    SyntheticLectureConfig lecture;
+    lecture.width = kWidth;
+    lecture.height = kHeight;
+
+    RecorderSessionConfig config;
+    config.video_source = std::make_unique<GeneratorVideoSource>(lecture);
+    config.audio_source = std::make_unique<GeneratorAudioSource>(lecture);
+    config.pipeline.encoder.output_path = path.wstring();
+    config.pipeline.encoder.video_width = kWidth;
+    config.pipeline.encoder.video_height = kHeight;
+    config.pipeline.encoder.video_fps = lecture.fps;
+    config.pipeline.encoder.h264_preset = "ultrafast";
+    config.event_sink = sink;
+    config.on_finished = [on_finished_called](RecorderSession&) {
+        // 후처리 예약이 오래 걸려도 종료 이벤트가 앞지르지 않아야 함
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        on_finished_called->store(true);
+    };
+    return config;
+}
+
+TEST(RecorderSessionTest, StopEventFollowsOnFinishedAndFinishedFlag) {
+    const auto path = std::filesystem::temp_directory_path() / "satrec_test_session_stop.mp4";
+    StopOrderSink sink;
+    std::atomic<bool> on_finished_called{false};
+    RecorderSession session(7);
+    sink.Attach(&session, &on_finished_called);
+
+    std::string error;
+    ASSERT_TRUE(session.Launch(MakeConfig(path, &sink, &on_finished_called), &error)) << error;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    session.RequestStop();
+    ASSERT_TRUE(sink.WaitForStop());
+
+    EXPECT_EQ(sink.last_type_, RecorderEventType::kStopped);
+    EXPECT_TRUE(sink.on_finished_before_stop_);
+    EXPECT_TRUE(sink.finished_at_stop_);
+    EXPECT_FALSE(sink.stopping_at_stop_);
+
+    // 이벤트를 받은 직후 같은 세션으로 다음 녹화를 시작할 수 있어야 함 (러너의 LaunchSession -2 방지)
+    on_finished_called = false;
+    ASSERT_TRUE(session.Launch(MakeConfig(path, &sink, &on_finished_called), &error)) << error;
+    session.Stop();
+    EXPECT_EQ(sink.stop_events(), 2);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+TEST(RecorderSessionTest, ArmFailureReportsFinishedSession) {
+    const auto path = std::filesystem::temp_directory_path() / "satrec_missing_dir" / "nested" / "out.mp4";
+    StopOrderSink sink;
+    RecorderSession session(8);
+    sink.Attach(&session, nullptr);
+
+    std::atomic<bool> on_finished_called{false};
+    std::string error;
+    ASSERT_TRUE(session.Launch(MakeConfig(path, &sink, &on_finished_called), &error)) << error;
+    ASSERT_TRUE(sink.WaitForStop());
+    session.Stop();
+
+    EXPECT_EQ(sink.last_type_, RecorderEventType::kStoppedWithError);
+    EXPECT_TRUE(sink.finished_at_stop_);
+    EXPECT_FALSE(session.GetLastError().empty());
+    EXPECT_EQ(sink.stop_events(), 1);
+}
+
+}  // namespace
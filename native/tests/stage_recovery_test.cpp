@@ -0,0 +1,166 @@
+// 단계 감시 복구 테스트: 생성기 소스 녹화에 단계별 오류를 주입해 재시작 이벤트와 복구 시간,
+// 호출 안에서 돌아오지 않는 단계(응답 없음)로 녹화가 끝나는지 확인
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "generator_source.h"
+#include "pipeline_watchdog.h"
+#include "recorder_events.h"
+#include "recording_pipeline.h"
+
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+constexpr int kDeadlineMs = 300;
+// 오류 → 감지(감시 주기) → 단계 재시작(소스 Stop/Start, 인코더는 새 세그먼트) → 첫 진행까지 허용 시간
+constexpr int64_t kMaxRecoveryMs = 2000;
+
+// 감시/재시작 이벤트만 모음 (감시 스레드, 인코더 스레드에서 전달)
+class StageEventSink : public RecorderEventSink {
+public:
+    void OnRecorderEvent(const RecorderEvent& event) override {
+        if (event.type != RecorderEventType::kStageStalled && event.type != RecorderEventType::kStageRestarted &&
+            event.type != RecorderEventType::kSecondaryOutputEnded) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(event);
+    }
+
+    // 입력: 이벤트 종류, 메시지 (단계 이름, 경로) / 출력: 가장 최근 이벤트 (없으면 false)
+    bool Find(RecorderEventType type, const std::string& message, RecorderEvent* out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = events_.rbegin(); it != events_.rend(); ++it) {
+            if (it->type == type && it->message == message) {
+                *out = *it;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<RecorderEvent> events_;
+};
+
+class StageRecoveryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SyntheticLectureConfig lecture;
+        lecture.width = kWidth;
+        lecture.height = kHeight;
+        video_source_ = std::make_unique<GeneratorVideoSource>(lecture);
+        audio_source_ = std::make_unique<GeneratorAudioSource>(lecture);
+
+        config_.video_source = video_source_.get();
+        config_.audio_source = audio_source_.get();
+        config_.encoder.output_path =
+            (std::filesystem::temp_directory_path() / "satrec_test_stage_recovery.mp4").wstring();
+        config_.encoder.video_width = kWidth;
+        config_.encoder.video_height = kHeight;
+        config_.encoder.video_fps = lecture.fps;
+        config_.encoder.h264_preset = "ultrafast";
+        config_.watchdog_deadline_ms = kDeadlineMs;
+        config_.event_sink = &sink_;
+    }
+
+    void TearDown() override {
+        pipeline_.Stop();
+        std::error_code ec;
+        for (const std::wstring& segment : pipeline_.GetSegmentPaths()) {
+            std::filesystem::remove(segment, ec);
+        }
+        std::filesystem::remove(secondary_path_, ec);
+    }
+
+    // 입력: 단계, 최대 대기 시간 / 출력: 복구/실패/응답 없음 중 하나가 될 때까지 기다린 감시 통계
+    WatchdogStageStats WaitForOutcome(WatchedStage stage, std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        WatchdogStageStats stats = pipeline_.GetWatchdogStats(stage);
+        while (stats.recoveries == 0 && !stats.failed && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            stats = pipeline_.GetWatchdogStats(stage);
+        }
+        return stats;
+    }
+
+    std::filesystem::path secondary_path_ = std::filesystem::temp_directory_path() / "satrec_test_stage_secondary.mp4";
+    std::unique_ptr<GeneratorVideoSource> video_source_;
+    std::unique_ptr<GeneratorAudioSource> audio_source_;
+    StageEventSink sink_;
+    RecordingPipelineConfig config_;
+    RecordingPipeline pipeline_;
+};
+
+TEST_F(StageRecoveryTest, EachStageRestartsAfterErrorWithinBound) {
+    config_.encoder.secondary_output_path = secondary_path_.wstring();
+    std::string error;
+    ASSERT_TRUE(pipeline_.Start(config_, &error)) << error;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    for (const WatchedStage stage : {WatchedStage::kCapture, WatchedStage::kAudio, WatchedStage::kEncoder}) {
+        const char* name = WatchedStageName(stage);
+        SCOPED_TRACE(name);
+        ASSERT_TRUE(pipeline_.InjectStageFault(stage, StageFault::kError));
+
+        const WatchdogStageStats stats = WaitForOutcome(stage, std::chrono::milliseconds(kMaxRecoveryMs * 2));
+        EXPECT_EQ(stats.restarts, 1);
+        EXPECT_EQ(stats.recoveries, 1);
+        EXPECT_FALSE(stats.failed);
+        EXPECT_LE(stats.last_recovery_ms, kMaxRecoveryMs);
+
+        // 복구 이벤트는 감시 스레드가 통계를 갱신한 뒤 보냄
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        RecorderEvent restarted;
+        ASSERT_TRUE(sink_.Find(RecorderEventType::kStageRestarted, name, &restarted));
+        EXPECT_EQ(restarted.value, stats.last_recovery_ms);
+        EXPECT_TRUE(pipeline_.IsCapturing());
+    }
+
+    // 인코더 재시작은 새 세그먼트로 이어 쓰고, 보조 출력은 첫 세그먼트에서 닫힘
+    pipeline_.Stop();
+    EXPECT_TRUE(pipeline_.GetLastError().empty()) << pipeline_.GetLastError();
+    EXPECT_EQ(pipeline_.GetSegmentPaths().size(), 2u);
+    RecorderEvent secondary_ended;
+    ASSERT_TRUE(sink_.Find(RecorderEventType::kSecondaryOutputEnded, secondary_path_.u8string(), &secondary_ended));
+    EXPECT_EQ(secondary_ended.value, 1);
+    std::error_code ec;
+    EXPECT_GT(std::filesystem::file_size(secondary_path_, ec), 0u);
+}
+
+TEST_F(StageRecoveryTest, StageStuckInCallIsReportedUnresponsive) {
+    std::string error;
+    ASSERT_TRUE(pipeline_.Start(config_, &error)) << error;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // 응답 없음 기한(감시 기한 × 5)보다 오래 캡처 호출 안에서 멈춤 → 재시작 요청을 가져가지 못함
+    ASSERT_TRUE(pipeline_.InjectStageFault(WatchedStage::kCapture, StageFault::kHang, kDeadlineMs * 10));
+    const WatchdogStageStats stats =
+        WaitForOutcome(WatchedStage::kCapture, std::chrono::milliseconds(kDeadlineMs * 10));
+    EXPECT_TRUE(stats.failed);
+    EXPECT_TRUE(stats.unresponsive);
+    EXPECT_EQ(stats.restarts, 1);
+    EXPECT_EQ(stats.recoveries, 0);
+
+    RecorderEvent stalled;
+    EXPECT_TRUE(sink_.Find(RecorderEventType::kStageStalled, "capture", &stalled));
+    RecorderEvent restarted;
+    EXPECT_FALSE(sink_.Find(RecorderEventType::kStageRestarted, "capture", &restarted));
+
+    pipeline_.Stop();
+    EXPECT_NE(pipeline_.GetLastError().find("응답 없음"), std::string::npos) << pipeline_.GetLastError();
+}
+
+}  // namespace
@@ -0,0 +1,277 @@
+// windows/runner/dxgi_video_source.cpp
+// DXGI Desktop Duplication 비디오 소스 구현
+
+#include "dxgi_video_source.h"
+
+#include <cstring>
+
+#include "media_clock.h"
+#include "native_logger.h"
+#include "trace_recorder.h"
+
+// 연속 실패 임계값 (넘으면 캡처 실패로 처리)
+static const int MAX_CAPTURE_FAILURES = 5;
+
+DxgiVideoSource::DxgiVideoSource(ID3D11Device* device, ID3D11DeviceContext* context, UINT output_index)
+    : device_(device), context_(context), output_index_(output_index) {}
+
+DxgiVideoSource::~DxgiVideoSource() {
+    Stop();
+}
+
+bool DxgiVideoSource::Start(std::string* error) {
+    if (!device_ || !context_) {
+        *error = "D3D11 디바이스가 초기화되지 않음";
+        return false;
+    }
+
+    SATREC_LOG_INFO("[C++] DXGI Desktop Duplication 초기화 시작...");
+    failure_count_ = 0;
+    if (!InitializeDuplication(error)) {
+        SATREC_LOG_ERROR("[C++] ❌ Desktop Duplication 초기화 실패");
+        return false;
+    }
+    SATREC_LOG_INFO("[C++] ✅ DXGI Desktop Duplication 초기화 완료");
+    return true;
+}
+
+void DxgiVideoSource::Stop() {
+    ReleaseDuplication();
+    if (staging_texture_) {
+        staging_texture_->Release();
+        staging_texture_ = nullptr;
+    }
+}
+
+// DXGI Desktop Duplication 초기화
+bool DxgiVideoSource::InitializeDuplication(std::string* error) {
+    HRESULT hr;
+
+    // 1. DXGI 어댑터 가져오기
+    SATREC_LOG_INFO("[C++] 1/4: DXGI 어댑터 가져오기...");
+
+    IDXGIDevice* dxgi_device = nullptr;
+    hr = device_->QueryInterface(__uuidof(IDXGIDevice), (void**)&dxgi_device);
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ DXGI 디바이스 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "DXGI 디바이스 가져오기 실패";
+        return false;
+    }
+
+    IDXGIAdapter* dxgi_adapter = nullptr;
+    hr = dxgi_device->GetAdapter(&dxgi_adapter);
+    dxgi_device->Release();
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ DXGI 어댑터 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "DXGI 어댑터 가져오기 실패";
+        return false;
+    }
+
+    // 2. 모니터 출력 가져오기 (기본: 두 번째 모니터, 인덱스 1)
+    SATREC_LOG_INFO("[C++] 2/4: %u번 출력 가져오기...", output_index_);
+
+    IDXGIOutput* dxgi_output = nullptr;
+    hr = dxgi_adapter->EnumOutputs(output_index_, &dxgi_output);
+    dxgi_adapter->Release();
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ DXGI 출력 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "DXGI 출력 가져오기 실패";
+        return false;
+    }
+
+    // 3. IDXGIOutput1로 변환
+    SATREC_LOG_INFO("[C++] 3/4: IDXGIOutput1 변환...");
+
+    IDXGIOutput1* dxgi_output1 = nullptr;
+    hr = dxgi_output->QueryInterface(__uuidof(IDXGIOutput1), (void**)&dxgi_output1);
+    dxgi_output->Release();
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ IDXGIOutput1 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "IDXGIOutput1 가져오기 실패";
+        return false;
+    }
+
+    // 4. Desktop Duplication 생성
+    SATREC_LOG_INFO("[C++] 4/4: Desktop Duplication 생성...");
+
+    hr = dxgi_output1->DuplicateOutput(device_, &duplication_);
+    dxgi_output1->Release();
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ Desktop Duplication 생성 실패 (HRESULT: 0x%08X)", hr);
+        *error = "Desktop Duplication 생성 실패";
+        return false;
+    }
+
+    SATREC_LOG_INFO("[C++] ✅ Desktop Duplication 생성 성공");
+    return true;
+}
+
+// DXGI Duplication 리소스 정리
+void DxgiVideoSource::ReleaseDuplication() {
+    if (duplication_) {
+        duplication_->Release();
+        duplication_ = nullptr;
+    }
+}
+
+// 장치 손실/복구 알림 (message: 소스 이름)
+void DxgiVideoSource::NotifyEvent(RecorderEventType type) {
+    if (!event_sink_) return;
+    RecorderEvent event;
+    event.type = type;
+    event.message = Name();
+    event_sink_->OnRecorderEvent(event);
+}
+
+// DXGI Desktop Duplication 재초기화 (ACCESS_LOST 복구용)
+bool DxgiVideoSource::ReinitializeDuplication() {
+    SATREC_LOG_INFO("[C++] DXGI Duplication 재초기화 시작...");
+
+    // 기존 리소스가 남아있다면 정리
+    ReleaseDuplication();
+
+    // 재초기화 시도 (최대 3회)
+    for (int attempt = 1; attempt <= 3; attempt++) {
+        SATREC_LOG_INFO("[C++] 재초기화 시도 %d/3...", attempt);
+
+        std::string error;
+        if (InitializeDuplication(&error)) {
+            SATREC_LOG_INFO("[C++] ✅ DXGI Duplication 재초기화 성공 (시도 %d)", attempt);
+            return true;
+        }
+
+        // 실패 시 잠시 대기 후 재시도
+        if (attempt < 3) {
+            SATREC_LOG_INFO("[C++] 재초기화 실패, 1초 후 재시도...");
+            Sleep(1000);
+        }
+    }
+
+    SATREC_LOG_ERROR("[C++] ❌ DXGI Duplication 재초기화 모든 시도 실패");
+    return false;
+}
+
+// 프레임 캡처 (DXGI Desktop Duplication)
+CaptureReadResult DxgiVideoSource::CaptureFrame(FrameData* frame, std::string* error) {
+    HRESULT hr;
+    DXGI_OUTDUPL_FRAME_INFO frame_info;
+    IDXGIResource* desktop_resource = nullptr;
+
+    if (!duplication_) {
+        *error = "Desktop Duplication이 초기화되지 않음";
+        return CaptureReadResult::kError;
+    }
+
+    // 1. 프레임 가져오기 (타임아웃 100ms)
+    hr = duplication_->AcquireNextFrame(100, &frame_info, &desktop_resource);
+    if (hr == DXGI_ERROR_WAIT_TIMEOUT) {
+        // 타임아웃: 화면 변화 없음 → 파이프라인이 마지막 프레임 재사용
+        return CaptureReadResult::kNoData;
+    }
+
+    // DXGI_ERROR_ACCESS_LOST: Desktop Duplication 세션이 무효화됨
+    // 원인: 전체화면 앱 전환, 디스플레이 설정 변경, DWM 재시작 등
+    if (hr == DXGI_ERROR_ACCESS_LOST) {
+        SATREC_LOG_ERROR("[C++] ⚠️ DXGI_ERROR_ACCESS_LOST 발생 - Desktop Duplication 재초기화 시도...");
+        NotifyEvent(RecorderEventType::kDeviceLost);
+
+        // 기존 Duplication 정리, 스테이징 텍스처도 정리 (해상도 변경 가능성)
+        ReleaseDuplication();
+        if (staging_texture_) {
+            staging_texture_->Release();
+            staging_texture_ = nullptr;
+        }
+
+        // 잠시 대기 후 재초기화
+        Sleep(500);
+
+        if (ReinitializeDuplication()) {
+            SATREC_LOG_INFO("[C++] ✅ Desktop Duplication 재초기화 성공, 녹화 계속...");
+            NotifyEvent(RecorderEventType::kDeviceRecovered);
+            failure_count_ = 0;
+            return CaptureReadResult::kNoData;  // 다음 주기에 재시도
+        }
+        SATREC_LOG_ERROR("[C++] ❌ Desktop Duplication 재초기화 실패");
+        *error = "DXGI 세션 복구 실패";
+        return CaptureReadResult::kError;
+    }
+
+    if (FAILED(hr)) {
+        failure_count_++;
+        SATREC_LOG_WARN("[C++] ⚠️ 프레임 가져오기 실패 (HRESULT: 0x%08X, 연속실패: %d/%d)",
+                        hr, failure_count_, MAX_CAPTURE_FAILURES);
+
+        // 연속 실패가 임계값 미만이면 재시도
+        if (failure_count_ < MAX_CAPTURE_FAILURES) {
+            Sleep(50);  // 잠시 대기 후 재시도
+            return CaptureReadResult::kNoData;
+        }
+
+        *error = "프레임 가져오기 연속 실패";
+        return CaptureReadResult::kError;
+    }
+
+    // 성공 시 실패 카운터 리셋
+    failure_count_ = 0;
+    frame->acquired_at = std::chrono::steady_clock::now();
+
+    // 2. ID3D11Texture2D로 변환
+    ID3D11Texture2D* desktop_texture = nullptr;
+    hr = desktop_resource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&desktop_texture);
+    desktop_resource->Release();
+    if (FAILED(hr)) {
+        duplication_->ReleaseFrame();
+        *error = "Texture 변환 실패";
+        return CaptureReadResult::kError;
+    }
+
+    // 3. Staging Texture로 복사 (GPU → CPU)
+    D3D11_TEXTURE2D_DESC desc;
+    desktop_texture->GetDesc(&desc);
+
+    if (!staging_texture_) {
+        // Staging Texture 생성 (최초 1회)
+        desc.Usage = D3D11_USAGE_STAGING;
+        desc.BindFlags = 0;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        desc.MiscFlags = 0;
+        device_->CreateTexture2D(&desc, nullptr, &staging_texture_);
+    }
+
+    context_->CopyResource(staging_texture_, desktop_texture);
+    desktop_texture->Release();
+
+    // 4. CPU 메모리로 읽기
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    hr = context_->Map(staging_texture_, 0, D3D11_MAP_READ, 0, &mapped);
+    if (FAILED(hr)) {
+        // 이번 프레임만 건너뜀 (기존 동작과 동일)
+        duplication_->ReleaseFrame();
+        return CaptureReadResult::kNoData;
+    }
+
+    {
+        SATREC_TRACE_SCOPE("map_copy");
+        frame->width = static_cast<int>(desc.Width);
+        frame->height = static_cast<int>(desc.Height);
+
+        // 픽셀 데이터 복사 (행 단위)
+        const size_t row_bytes = static_cast<size_t>(desc.Width) * 4;  // BGRA
+        frame->pixels.resize(row_bytes * desc.Height);
+
+        const uint8_t* src = static_cast<const uint8_t*>(mapped.pData);
+        uint8_t* dst = frame->pixels.data();
+        for (UINT y = 0; y < desc.Height; y++) {
+            memcpy(dst + y * row_bytes, src + static_cast<size_t>(y) * mapped.RowPitch, row_bytes);
+        }
+
+        context_->Unmap(staging_texture_, 0);
+    }
+
+    // 타임스탬프 설정 (QPC, 파이프라인 시계와 동일)
+    frame->timestamp = SystemMediaClock::Instance().Now();
+
+    // 5. 프레임 해제
+    duplication_->ReleaseFrame();
+    return CaptureReadResult::kData;
+}
@@ -0,0 +1,50 @@
+// windows/runner/dxgi_video_source.h
+// DXGI Desktop Duplication 비디오 소스 (IVideoSource 구현)
+
+#ifndef DXGI_VIDEO_SOURCE_H_
+#define DXGI_VIDEO_SOURCE_H_
+
+#include <windows.h>
+#include <d3d11.h>
+#include <dxgi1_2.h>
+
+#include <string>
+
+#include "capture_source.h"
+
+/// 입력: NativeRecorder_Initialize에서 만든 D3D11 디바이스/컨텍스트, 캡처할 모니터 번호
+/// 출력: 모니터 화면 BGRA 프레임 (QPC 타임스탬프 = SystemMediaClock)
+/// 예외: Duplication 생성 실패 시 Start가 false,
+///       ACCESS_LOST 재초기화 실패 또는 연속 캡처 실패 시 kError
+///
+/// 디바이스/컨텍스트는 소유하지 않음 (소스보다 오래 살아 있어야 함)
+class DxgiVideoSource : public IVideoSource {
+public:
+    DxgiVideoSource(ID3D11Device* device, ID3D11DeviceContext* context, UINT output_index = 1);
+    ~DxgiVideoSource() override;
+
+    DxgiVideoSource(const DxgiVideoSource&) = delete;
+    DxgiVideoSource& operator=(const DxgiVideoSource&) = delete;
+
+    const char* Name() const override { return "dxgi"; }
+    void SetEventSink(RecorderEventSink* sink) override { event_sink_ = sink; }
+    bool Start(std::string* error) override;
+    void Stop() override;
+    CaptureReadResult CaptureFrame(FrameData* frame, std::string* error) override;
+
+private:
+    bool InitializeDuplication(std::string* error);
+    void ReleaseDuplication();
+    bool ReinitializeDuplication();
+    void NotifyEvent(RecorderEventType type);
+
+    ID3D11Device* device_;
+    ID3D11DeviceContext* context_;
+    UINT output_index_;
+    IDXGIOutputDuplication* duplication_ = nullptr;
+    ID3D11Texture2D* staging_texture_ = nullptr;
+    int failure_count_ = 0;  // 연속 실패 횟수 (복구 시도용)
+    RecorderEventSink* event_sink_ = nullptr;  // ACCESS_LOST 손실/복구 알림
+};
+
+#endif  // DXGI_VIDEO_SOURCE_H_
@@ -1,10 +1,10 @@
 // windows/runner/native_screen_recorder.cpp
-// DXGI Desktop Duplication + WASAPI Loopback + FFmpeg 파이프라인을 사용한 화면 + 오디오 녹화 구현
+// DXGI Desktop Duplication + WASAPI Loopback + libav 인코더를 사용한 화면 + 오디오 녹화 구현
 //
 // 목적:
-//   1. DXGI Desktop Duplication으로 화면 캡처
-//   2. WASAPI Loopback으로 오디오 캡처
-//   3. FFmpeg Named Pipe로 Fragmented MP4 저장
+//   1. DXGI Desktop Duplication으로 화면 캡처 (dxgi_video_source)
+//   2. WASAPI Loopback으로 오디오 캡처 (wasapi_audio_source)
+//   3. 캡처/큐/인코딩은 native/core의 RecordingPipeline이 처리
 //
 // 작성일: 2025-10-22
 
@@ -12,17 +12,16 @@
 
 #include <windows.h>
 #include <d3d11.h>
-#include <dxgi1_2.h>
-#include <mmdeviceapi.h>
-#include <audioclient.h>
 #include <string>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <thread>
+#include <filesystem>
+#include <map>
 #include <mutex>
-#include <queue>
-#include <condition_variable>
-#include <cmath>  // Phase 3.1.2: std::sqrt, std::abs
 #include <memory>
+#include <vector>
 
 // DXGI Desktop Duplication API 헤더
 #pragma comment(lib, "d3d11.lib")
@@ -31,81 +30,97 @@
 // WASAPI 헤더
 #pragma comment(lib, "ole32.lib")
 #pragma comment(lib, "winmm.lib")
+
+// Dart native API (Dart_PostCObject_DL)
+#include "dart_api_dl.h"
+
+#include "dxgi_video_source.h"
 #include "libav_encoder.h"
+#include "mp4_finalizer.h"
+#include "mp4_concat.h"
+#include "native_logger.h"
+#include "pipeline_stats.h"
+#include "recorder_events.h"
+#include "recorder_session.h"
+#include "recording_pipeline.h"
+#include "trace_recorder.h"
+#include "wasapi_audio_source.h"
 
 // 전역 상태
-static std::atomic<bool> g_is_recording(false);
 static std::string g_last_error;
 static std::mutex g_error_mutex;
-static std::thread g_capture_thread;
 
 // Direct3D11 관련
 static ID3D11Device* g_d3d_device = nullptr;
 static ID3D11DeviceContext* g_d3d_context = nullptr;
-static ID3D11Texture2D* g_staging_texture = nullptr;
 static bool g_com_initialized = false;
 
-// DXGI Desktop Duplication 관련
-static IDXGIOutputDuplication* g_dxgi_duplication = nullptr;
+static bool g_video_only = false;  // 비디오만 녹화할지 여부 (기본값: 오디오도 함께 녹화)
 
-// WASAPI 오디오 캡처 관련
-static IMMDevice* g_audio_device = nullptr;
-static IAudioClient* g_audio_client = nullptr;
-static IAudioCaptureClient* g_audio_capture_client = nullptr;
-static WAVEFORMATEX* g_wave_format = nullptr;
-static std::thread g_audio_thread;
+// 녹화 종료 후 faststart 후처리 (백그라운드 스레드, 최초 사용 시 생성)
+static std::unique_ptr<Mp4Finalizer> g_mp4_finalizer;
+static std::mutex g_finalizer_mutex;
+static std::atomic<bool> g_finalize_faststart(true);
+// 후처리 결과 경로 → 세션 핸들 (FINALIZE_COMPLETED 이벤트에 세션을 붙이기 위해, 완료되면 제거)
+static std::mutex g_finalize_owner_mutex;
+static std::map<std::string, int32_t> g_finalize_owners;
 
-static std::thread g_encoder_thread;
-static std::unique_ptr<LibavEncoder> g_libav_encoder;
-static bool g_video_only = false;  // 비디오만 녹화할지 여부 (기본값: 오디오도 함께 녹화)
+// 패킷 저널 사용 여부 (다음 녹화부터 적용)
+static std::atomic<bool> g_packet_journal_enabled(false);
 
-// 타임스탬프 관리
-static LARGE_INTEGER g_recording_start_qpc;
-static LARGE_INTEGER g_qpc_frequency;
-static LONGLONG g_video_frame_count = 0;
-static LONGLONG g_audio_sample_count = 0;
-static int g_video_width = 0;
-static int g_video_height = 0;
-static int g_video_fps = 30;
-
-// 프레임 데이터 구조
-struct FrameData {
-    std::vector<uint8_t> pixels;  // BGRA 픽셀 데이터
-    int width;
-    int height;
-    uint64_t timestamp;  // QueryPerformanceCounter 값
-};
+// 녹화 중 컨테이너 (RecordingContainer 값, 다음 녹화부터 적용)
+static std::atomic<int32_t> g_container_format(
+    static_cast<int32_t>(RecordingContainer::kFragmentedMp4));
 
-// 오디오 샘플 데이터 구조
-struct AudioSample {
-    std::vector<uint8_t> data;     // PCM 오디오 데이터
-    uint32_t frame_count;          // 오디오 프레임 수
-    uint32_t sample_rate;          // 샘플레이트 (Hz)
-    uint16_t channels;             // 채널 수 (2 = 스테레오)
-    uint16_t bits_per_sample;      // 비트 깊이
-    uint64_t timestamp;            // QueryPerformanceCounter 값
-};
+// 이중 출력 보조 경로 (다음 녹화부터 적용, 상태는 세션 파이프라인이 다음 녹화 시작 전까지 유지)
+static std::mutex g_output_mutex;
+static std::string g_secondary_output_path;
+
+// 캡처 trace 경로 (설정되면 다음 녹화부터 캡처 입력을 그대로 기록)
+static std::mutex g_capture_trace_mutex;
+static std::string g_capture_trace_path;
+
+// 녹화 이벤트를 받을 Dart ReceivePort (ILLEGAL_PORT면 전송 안 함)
+static std::atomic<bool> g_dart_api_initialized(false);
+static std::atomic<int64_t> g_event_port(ILLEGAL_PORT);
 
-// 프레임 버퍼 큐
-static std::queue<FrameData> g_frame_queue;
-static std::mutex g_queue_mutex;
-static std::condition_variable g_queue_cv;
-static const size_t MAX_QUEUE_SIZE = 60;  // 최대 60 프레임 (약 2.5초 @ 24fps)
-
-// 마지막 캡처된 프레임 (DXGI 타임아웃 시 재사용)
-// ⚠️ 중요: 정적 화면에서도 비디오 스트림 연속성 유지를 위해 필요
-static FrameData g_last_captured_frame;
-static bool g_has_last_frame = false;
-
-// 오디오 버퍼 큐
-static std::queue<AudioSample> g_audio_queue;
-static std::mutex g_audio_queue_mutex;
-static std::condition_variable g_audio_queue_cv;
+// 캡처 큐 크기
+static const size_t MAX_QUEUE_SIZE = 60;  // 최대 60 프레임 (약 2.5초 @ 24fps, 예산 미사용 시)
 static const size_t MAX_AUDIO_QUEUE_SIZE = 100;  // 최대 100 샘플
 
-// Phase 3.1.2: 오디오 레벨 추적 (0.0 ~ 1.0)
-static std::atomic<float> g_current_audio_level(0.0f);  // RMS 레벨
-static std::atomic<float> g_peak_audio_level(0.0f);     // Peak 레벨
+// 비디오 큐 메모리 예산 / 저장 형식 (다음 녹화부터 적용)
+// 기본값: I420 192MB = 1080p 약 61프레임, 4K 약 15프레임 (Zoom과 함께 도는 8GB PC 기준)
+static std::atomic<int64_t> g_video_queue_budget_bytes(192LL * 1024 * 1024);
+static std::atomic<int32_t> g_video_frame_format(static_cast<int32_t>(FramePixelFormat::kI420));
+
+// pre-roll / post-roll 설정 (NativeRecorder_SetPreRoll, 다음 녹화부터 적용, 0이면 사용 안 함)
+static std::atomic<int32_t> g_preroll_max_ms(0);
+static std::atomic<int64_t> g_preroll_max_bytes(64LL * 1024 * 1024);
+static std::atomic<int32_t> g_postroll_ms(0);
+
+// 종료 처리 기한 (NativeRecorder_SetStopDeadline, 다음 녹화부터 적용, 0이면 제한 없음)
+// 기본 10초: I420 192MB 큐(1080p 약 61프레임)는 보통 3초 안에 비워지므로 인코더가 크게 밀린 경우에만 버림
+static std::atomic<int32_t> g_finalize_deadline_ms(10000);
+
+// 인코더 자식 프로세스 사용 여부 (NativeRecorder_SetEncoderIsolation, 다음 녹화부터 적용)
+static std::atomic<bool> g_encoder_isolation(false);
+
+// 단계 감시 (NativeRecorder_SetWatchdog, 다음 녹화부터 적용, 기한 0이면 감시 안 함)
+static std::atomic<int32_t> g_watchdog_deadline_ms(2000);
+static std::atomic<int32_t> g_stage_max_restarts(3);
+
+// 녹화 스레드 정책 (NativeRecorder_SetThreadPolicy, 다음 녹화부터 적용)
+static std::atomic<bool> g_thread_policy_enabled(true);
+static std::atomic<int32_t> g_thread_affinity_mode(0);
+static std::atomic<uint64_t> g_capture_cpus(0);
+static std::atomic<uint64_t> g_audio_cpus(0);
+static std::atomic<uint64_t> g_encoder_cpus(0);
+
+// CPU 예산 (NativeRecorder_SetCpuBudget, 다음 녹화부터 적용, 0이면 조절 안 함)
+static std::atomic<int32_t> g_cpu_budget_percent(0);
+// 다음 녹화의 인코더 단계 (BuildCpuEncoderSteps 기준, 녹화가 끝날 때 조절기 권고로 갱신, 예산을 끄면 0)
+static std::atomic<int32_t> g_governor_encoder_step(0);
+
 
 // 에러 메시지 설정 헬퍼
 static void SetLastError(const std::string& error) {
@@ -113,47 +128,84 @@ static void SetLastError(const std::string& error) {
     g_last_error = error;
 }
 
-// Phase 3.1.2: 오디오 레벨 계산 헬퍼 (Float32 PCM 데이터용)
-// RMS (Root Mean Square) 계산: 소리의 "에너지"를 나타냄
-// 반환값: 0.0 (무음) ~ 1.0 (최대)
-static float CalculateAudioLevel(const BYTE* data, UINT32 frames, UINT16 channels) {
-    if (data == nullptr || frames == 0) {
-        return 0.0f;
-    }
+// 녹화 이벤트를 Dart ReceivePort로 전송 ([type, elapsed_ms, value, message, session])
+// Dart_PostCObject는 스레드 안전하고 값을 복사하므로 발생한 스레드에서 바로 전송
+static void PostRecorderEvent(const RecorderEvent& event) {
+    SATREC_LOG_INFO("[C++] 이벤트: %s (세션 %d, value=%lld) %s", RecorderEventTypeName(event.type),
+                    event.session_id, static_cast<long long>(event.value), event.message.c_str());
 
-    // WASAPI는 Float32 PCM (-1.0 ~ +1.0) 반환
-    const float* samples = reinterpret_cast<const float*>(data);
-    UINT32 total_samples = frames * channels;
-
-    // RMS 계산: sqrt(sum(x^2) / n)
-    double sum_squares = 0.0;
-    float peak = 0.0f;
-
-    for (UINT32 i = 0; i < total_samples; i++) {
-        float sample = samples[i];
-        sum_squares += sample * sample;
+    const Dart_Port_DL port = g_event_port.load();
+    if (port == ILLEGAL_PORT || !g_dart_api_initialized.load()) {
+        return;
+    }
 
-        // Peak 레벨도 추적
-        float abs_sample = std::abs(sample);
-        if (abs_sample > peak) {
-            peak = abs_sample;
-        }
+    Dart_CObject type;
+    type.type = Dart_CObject_kInt64;
+    type.value.as_int64 = static_cast<int64_t>(event.type);
+    Dart_CObject elapsed_ms;
+    elapsed_ms.type = Dart_CObject_kInt64;
+    elapsed_ms.value.as_int64 = event.elapsed_ms;
+    Dart_CObject value;
+    value.type = Dart_CObject_kInt64;
+    value.value.as_int64 = event.value;
+    Dart_CObject message;
+    message.type = Dart_CObject_kString;
+    message.value.as_string = const_cast<char*>(event.message.c_str());
+    Dart_CObject session;
+    session.type = Dart_CObject_kInt32;
+    session.value.as_int32 = event.session_id;
+
+    Dart_CObject* values[] = {&type, &elapsed_ms, &value, &message, &session};
+    Dart_CObject array;
+    array.type = Dart_CObject_kArray;
+    array.value.as_array.length = 5;
+    array.value.as_array.values = values;
+
+    if (!Dart_PostCObject_DL(port, &array)) {
+        SATREC_LOG_WARN("[C++] ⚠️ 이벤트 전송 실패 (포트 닫힘): %s", RecorderEventTypeName(event.type));
     }
+}
 
-    float rms = static_cast<float>(std::sqrt(sum_squares / total_samples));
+static void PostRecorderEvent(RecorderEventType type, int64_t value, const std::string& message) {
+    RecorderEvent event;
+    event.type = type;
+    event.value = value;
+    event.message = message;
+    PostRecorderEvent(event);
+}
 
-    // Peak 레벨 업데이트 (atomic)
-    g_peak_audio_level.store(peak);
+// 파이프라인 이벤트 → Dart
+class DartPortEventSink : public RecorderEventSink {
+public:
+    void OnRecorderEvent(const RecorderEvent& event) override { PostRecorderEvent(event); }
+};
+static DartPortEventSink g_event_sink;
 
-    return rms;
+// 후처리 결과 경로의 세션 등록 (Enqueue 전에 호출, 완료 이벤트가 먼저 올 수 없도록)
+static void RegisterFinalizeOwner(const std::string& output_path, int32_t session_id) {
+    std::lock_guard<std::mutex> lock(g_finalize_owner_mutex);
+    g_finalize_owners[output_path] = session_id;
 }
 
-// Direct3D11 디바이스 생성
-static bool CreateD3D11Device() {
-    if (g_d3d_device) {
-        return true;  // 이미 생성됨
+// faststart 후처리 1건 완료 → Dart (후처리 스레드에서 호출, 등록한 세션 핸들을 붙임)
+static void OnFinalizeCompleted(const std::string& output_path, bool success) {
+    RecorderEvent event;
+    event.type = RecorderEventType::kFinalizeCompleted;
+    event.value = success ? 1 : 0;
+    event.message = output_path;
+    {
+        std::lock_guard<std::mutex> lock(g_finalize_owner_mutex);
+        auto it = g_finalize_owners.find(output_path);
+        if (it != g_finalize_owners.end()) {
+            event.session_id = it->second;
+            g_finalize_owners.erase(it);
+        }
     }
+    PostRecorderEvent(event);
+}
 
+// Direct3D11 디바이스 생성 (세션마다 따로 만들어 즉시 컨텍스트를 공유하지 않음)
+static bool CreateD3D11Device(ID3D11Device** device, ID3D11DeviceContext** context) {
     UINT creation_flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
 #ifdef _DEBUG
     creation_flags |= D3D11_CREATE_DEVICE_DEBUG;
@@ -176,9 +228,9 @@ static bool CreateD3D11Device() {
         feature_levels,
         ARRAYSIZE(feature_levels),
         D3D11_SDK_VERSION,
-        &g_d3d_device,
+        device,
         &feature_level,
-        &g_d3d_context
+        context
     );
 
     if (FAILED(hr)) {
@@ -189,13 +241,16 @@ static bool CreateD3D11Device() {
     return true;
 }
 
-// Direct3D11 리소스 정리
-static void CleanupD3D11() {
-    if (g_staging_texture) {
-        g_staging_texture->Release();
-        g_staging_texture = nullptr;
+// 기본 세션용 Direct3D11 디바이스 생성
+static bool CreateD3D11Device() {
+    if (g_d3d_device) {
+        return true;  // 이미 생성됨
     }
+    return CreateD3D11Device(&g_d3d_device, &g_d3d_context);
+}
 
+// Direct3D11 리소스 정리
+static void CleanupD3D11() {
     if (g_d3d_context) {
         g_d3d_context->Release();
         g_d3d_context = nullptr;
@@ -207,1168 +262,954 @@ static void CleanupD3D11() {
     }
 }
 
-// DXGI Desktop Duplication 초기화
-static bool InitializeDXGIDuplication() {
-    HRESULT hr;
-
-    // 1. DXGI 어댑터 가져오기
-    printf("[C++] 1/4: DXGI 어댑터 가져오기...\n");
-    fflush(stdout);
-
-    IDXGIDevice* dxgi_device = nullptr;
-    hr = g_d3d_device->QueryInterface(__uuidof(IDXGIDevice), (void**)&dxgi_device);
-    if (FAILED(hr)) {
-        printf("[C++] ❌ DXGI 디바이스 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("DXGI 디바이스 가져오기 실패");
-        return false;
-    }
-
-    IDXGIAdapter* dxgi_adapter = nullptr;
-    hr = dxgi_device->GetAdapter(&dxgi_adapter);
-    dxgi_device->Release();
-    if (FAILED(hr)) {
-        printf("[C++] ❌ DXGI 어댑터 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("DXGI 어댑터 가져오기 실패");
-        return false;
-    }
-
-    // 2. 두 번째 모니터(2번) 출력 가져오기
-    printf("[C++] 2/4: 2번 모니터 출력 가져오기...\n");
-    fflush(stdout);
-
-    IDXGIOutput* dxgi_output = nullptr;
-    hr = dxgi_adapter->EnumOutputs(1, &dxgi_output);  // 두 번째 모니터 (인덱스 1)
-    dxgi_adapter->Release();
-    if (FAILED(hr)) {
-        printf("[C++] ❌ DXGI 출력 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("DXGI 출력 가져오기 실패");
-        return false;
+// 녹화 세션 (소스/파이프라인/세션 스레드) + 세션 전용 D3D11 디바이스
+// 기본 세션(핸들 0)은 NativeRecorder_Initialize의 디바이스를 쓰고 device/context는 nullptr
+struct RunnerSession {
+    explicit RunnerSession(int32_t handle) : session(handle) {}
+    ~RunnerSession() {
+        session.Stop();
+        if (context) context->Release();
+        if (device) device->Release();
     }
 
-    // 3. IDXGIOutput1로 변환
-    printf("[C++] 3/4: IDXGIOutput1 변환...\n");
-    fflush(stdout);
-
-    IDXGIOutput1* dxgi_output1 = nullptr;
-    hr = dxgi_output->QueryInterface(__uuidof(IDXGIOutput1), (void**)&dxgi_output1);
-    dxgi_output->Release();
-    if (FAILED(hr)) {
-        printf("[C++] ❌ IDXGIOutput1 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("IDXGIOutput1 가져오기 실패");
-        return false;
-    }
+    RunnerSession(const RunnerSession&) = delete;
+    RunnerSession& operator=(const RunnerSession&) = delete;
 
-    // 4. Desktop Duplication 생성
-    printf("[C++] 4/4: Desktop Duplication 생성...\n");
-    fflush(stdout);
+    RecorderSession session;
+    ID3D11Device* device = nullptr;
+    ID3D11DeviceContext* context = nullptr;
 
-    hr = dxgi_output1->DuplicateOutput(g_d3d_device, &g_dxgi_duplication);
-    dxgi_output1->Release();
-    if (FAILED(hr)) {
-        printf("[C++] ❌ Desktop Duplication 생성 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("Desktop Duplication 생성 실패");
-        return false;
-    }
+    // NativeRecorder_SessionGetSegmentPaths가 돌려준 문자열 (다음 호출 전까지 유효)
+    std::mutex segment_paths_mutex;
+    std::string segment_paths_text;
+};
 
-    printf("[C++] ✅ Desktop Duplication 생성 성공\n");
-    fflush(stdout);
+// 세션 목록 (핸들 0 = 단일 녹화 API가 쓰는 기본 세션, 최초 조회 시 생성하고 제거하지 않음)
+// 기본 세션 파이프라인은 프로세스 수명 동안 같은 객체라 NativeRecorder_GetLiveStats 주소가 바뀌지 않음
+static const int32_t kDefaultSessionHandle = 0;
+static std::mutex g_sessions_mutex;
+static std::map<int32_t, std::shared_ptr<RunnerSession>> g_sessions;
+static int32_t g_next_session_handle = 1;
+
+static std::shared_ptr<RunnerSession> FindSession(int32_t handle) {
+    std::lock_guard<std::mutex> lock(g_sessions_mutex);
+    auto it = g_sessions.find(handle);
+    if (it != g_sessions.end()) {
+        return it->second;
+    }
+    if (handle != kDefaultSessionHandle) {
+        return nullptr;
+    }
+    auto runner_session = std::make_shared<RunnerSession>(kDefaultSessionHandle);
+    g_sessions[kDefaultSessionHandle] = runner_session;
+    return runner_session;
+}
 
-    return true;
+// 기본 세션 파이프라인 (기본 세션은 제거되지 않으므로 참조를 그대로 반환)
+static RecordingPipeline& DefaultPipeline() {
+    return FindSession(kDefaultSessionHandle)->session.pipeline();
 }
 
-// DXGI Duplication 리소스 정리
-static void CleanupDXGIDuplication() {
-    if (g_dxgi_duplication) {
-        g_dxgi_duplication->Release();
-        g_dxgi_duplication = nullptr;
+// 최종 MP4 경로 → 녹화 중 파일 경로 (MKV/TS는 확장자만 교체)
+static std::string ToLivePath(const std::string& output_path, RecordingContainer container) {
+    if (container == RecordingContainer::kFragmentedMp4) {
+        return output_path;
+    }
+    std::string live_path = output_path;
+    const size_t dot = live_path.find_last_of('.');
+    const size_t slash = live_path.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+        live_path.erase(dot);
     }
+    return live_path + RecordingContainerExtension(container);
 }
 
-// DXGI Desktop Duplication 재초기화 (ACCESS_LOST 복구용)
-// 녹화 중 DXGI_ERROR_ACCESS_LOST 발생 시 호출됨
-static bool ReinitializeDXGIDuplication() {
-    printf("[C++] DXGI Duplication 재초기화 시작...\\n");
-    fflush(stdout);
-    
-    // 기존 리소스가 남아있다면 정리
-    CleanupDXGIDuplication();
-    
-    // D3D 디바이스가 유효한지 확인
-    if (!g_d3d_device) {
-        printf("[C++] ❌ D3D 디바이스가 없습니다\\n");
-        fflush(stdout);
-        return false;
+// 전역 설정 경로 → 세션 전용 경로 (기본 세션은 그대로, 다른 세션은 <이름>_session<핸들><확장자>)
+// 동시 녹화가 같은 보조 출력/캡처 trace 파일에 겹쳐 쓰지 않도록 세션마다 다른 파일 사용
+static std::string SessionScopedPath(const std::string& path, int32_t handle) {
+    if (path.empty() || handle == kDefaultSessionHandle) {
+        return path;
     }
-    
-    // 재초기화 시도 (최대 3회)
-    for (int attempt = 1; attempt <= 3; attempt++) {
-        printf("[C++] 재초기화 시도 %d/3...\\n", attempt);
-        fflush(stdout);
-        
-        if (InitializeDXGIDuplication()) {
-            printf("[C++] ✅ DXGI Duplication 재초기화 성공 (시도 %d)\\n", attempt);
-            fflush(stdout);
-            return true;
-        }
-        
-        // 실패 시 잠시 대기 후 재시도
-        if (attempt < 3) {
-            printf("[C++] 재초기화 실패, 1초 후 재시도...\\n");
-            fflush(stdout);
-            Sleep(1000);
-        }
+    const size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = path.size();
     }
-    
-    printf("[C++] ❌ DXGI Duplication 재초기화 모든 시도 실패\\n");
-    fflush(stdout);
-    return false;
+    return path.substr(0, dot) + "_session" + std::to_string(handle) + path.substr(dot);
 }
 
-// WASAPI 초기화
-static bool InitializeWASAPI() {
-    HRESULT hr;
-
-    printf("[C++] WASAPI 초기화 시작...\n");
-    fflush(stdout);
-
-    // 1. IMMDeviceEnumerator 생성
-    printf("[C++] 1/4: IMMDeviceEnumerator 생성...\n");
-    fflush(stdout);
-
-    IMMDeviceEnumerator* enumerator = nullptr;
-    hr = CoCreateInstance(
-        __uuidof(MMDeviceEnumerator),
-        nullptr,
-        CLSCTX_ALL,
-        __uuidof(IMMDeviceEnumerator),
-        (void**)&enumerator
-    );
-    if (FAILED(hr)) {
-        printf("[C++] ❌ IMMDeviceEnumerator 생성 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("IMMDeviceEnumerator 생성 실패");
-        return false;
+// UTF-8 → UTF-16 (실패 시 빈 문자열)
+static std::wstring Utf8ToWide(const std::string& utf8) {
+    int wide_length = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, nullptr, 0);
+    if (wide_length <= 1) {
+        return std::wstring();
     }
+    std::wstring wide(wide_length - 1, 0);
+    MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, wide.data(), wide_length);
+    return wide;
+}
 
-    // 2. 기본 렌더 디바이스 가져오기 (스피커)
-    printf("[C++] 2/4: 기본 오디오 장치 가져오기...\n");
-    fflush(stdout);
-
-    hr = enumerator->GetDefaultAudioEndpoint(
-        eRender,      // 렌더 (출력) 장치
-        eConsole,     // 콘솔 역할
-        &g_audio_device
-    );
-    enumerator->Release();
-
-    if (FAILED(hr)) {
-        printf("[C++] ❌ 기본 오디오 장치 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("기본 오디오 장치 가져오기 실패");
-        return false;
+// 세션 녹화 시작 (StartRecording / ArmRecording 공통, 세션 스레드가 소스/파이프라인을 시작)
+// 설정 전역값(컨테이너, 큐, pre-roll, 보조 출력, trace)은 이 시점 값으로 고정
+// 보조 출력/캡처 trace 경로는 세션마다 다른 파일 (SessionScopedPath)
+// arm_only면 준비만 하고 트리거를 기다림 (그 전에 중지하면 파일 없음)
+static int32_t LaunchSession(
+    RunnerSession& runner_session,
+    const char* output_path_utf8,
+    int32_t width,
+    int32_t height,
+    int32_t fps,
+    int32_t monitor_index,
+    bool arm_only
+) {
+    RecorderSession& session = runner_session.session;
+    if (session.IsRecording() || !session.IsFinished()) {
+        SetLastError(session.IsStopping() ? "Previous recording is still stopping" : "Already recording");
+        return -2;
+    }
+    if (!output_path_utf8 || strlen(output_path_utf8) == 0) {
+        SetLastError("Invalid output path");
+        return -3;
     }
 
-    // 3. IAudioClient 생성
-    printf("[C++] 3/4: IAudioClient 생성...\n");
-    fflush(stdout);
+    // 녹화 중 파일 경로 결정
+    // MKV/TS는 확장자만 바꿔 기록하고, 종료 후 output_path(MP4)로 변환
+    const std::string output_path(output_path_utf8);
+    const auto container = static_cast<RecordingContainer>(g_container_format.load());
+    const std::string live_path = ToLivePath(output_path, container);
 
-    hr = g_audio_device->Activate(
-        __uuidof(IAudioClient),
-        CLSCTX_ALL,
-        nullptr,
-        (void**)&g_audio_client
-    );
-    if (FAILED(hr)) {
-        printf("[C++] ❌ IAudioClient 생성 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("IAudioClient 생성 실패");
-        return false;
+    std::string secondary_output_path;
+    {
+        std::lock_guard<std::mutex> lock(g_output_mutex);
+        secondary_output_path = SessionScopedPath(g_secondary_output_path, session.id());
     }
+    const std::string secondary_live_path = secondary_output_path.empty()
+        ? std::string()
+        : ToLivePath(secondary_output_path, container);
 
-    // 4. 오디오 포맷 가져오기
-    printf("[C++] 4/4: 오디오 포맷 가져오기...\n");
-    fflush(stdout);
-
-    hr = g_audio_client->GetMixFormat(&g_wave_format);
-    if (FAILED(hr)) {
-        printf("[C++] ❌ 오디오 포맷 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("오디오 포맷 가져오기 실패");
-        return false;
+    // 출력 파일 경로를 wchar_t로 변환 (UTF-8 → UTF-16)
+    const std::wstring w_output_path = Utf8ToWide(live_path);
+    if (w_output_path.empty()) {
+        SATREC_LOG_ERROR("[C++] ❌ 출력 경로 UTF-16 변환 실패");
+        SetLastError("출력 경로 UTF-16 변환 실패");
+        return -3;
     }
 
-    printf("[C++] ✅ 오디오 포맷: %d Hz, %d channels, %d bits\n",
-           g_wave_format->nSamplesPerSec,
-           g_wave_format->nChannels,
-           g_wave_format->wBitsPerSample);
-    fflush(stdout);
+    // 파이프라인 설정 (오디오 형식은 WASAPI 믹스 형식으로 파이프라인이 채움)
+    RecorderSessionConfig config;
+    config.pipeline.encoder.output_path = w_output_path;
+    if (!secondary_live_path.empty()) {
+        config.pipeline.encoder.secondary_output_path = Utf8ToWide(secondary_live_path);
+    }
+    config.pipeline.encoder.video_width = width;
+    config.pipeline.encoder.video_height = height;
+    config.pipeline.encoder.video_fps = fps;
+    config.pipeline.encoder.container = container;
+    config.pipeline.encoder.enable_fragmented_mp4 = true;
+    config.pipeline.encoder.h264_crf = 23;
+    config.pipeline.encoder.h264_preset = "veryfast";
+    config.pipeline.encoder.aac_bitrate = 192000;
+    config.pipeline.encoder.enable_packet_journal = g_packet_journal_enabled;
+    config.pipeline.video_queue_capacity = MAX_QUEUE_SIZE;
+    config.pipeline.audio_queue_capacity = MAX_AUDIO_QUEUE_SIZE;
+    config.pipeline.video_queue_budget_bytes = static_cast<size_t>(g_video_queue_budget_bytes.load());
+    config.pipeline.video_frame_format = static_cast<FramePixelFormat>(g_video_frame_format.load());
+    config.pipeline.encoder.start_in_preroll = g_preroll_max_ms > 0;
+    config.pipeline.encoder.preroll_limits.max_duration_ms = g_preroll_max_ms;
+    config.pipeline.encoder.preroll_limits.max_bytes = static_cast<size_t>(g_preroll_max_bytes.load());
+    config.pipeline.postroll_ms = g_postroll_ms;
+    config.pipeline.finalize_deadline_ms = g_finalize_deadline_ms;
+    config.pipeline.watchdog_deadline_ms = g_watchdog_deadline_ms;
+    config.pipeline.stage_max_restarts = g_stage_max_restarts;
+    config.pipeline.thread_policy.enabled = g_thread_policy_enabled;
+    config.pipeline.thread_policy.affinity_mode = static_cast<ThreadAffinityMode>(g_thread_affinity_mode.load());
+    config.pipeline.thread_policy.capture_cpus = g_capture_cpus;
+    config.pipeline.thread_policy.audio_cpus = g_audio_cpus;
+    config.pipeline.thread_policy.encoder_cpus = g_encoder_cpus;
+    config.pipeline.cpu_governor.budget_percent = static_cast<double>(g_cpu_budget_percent.load());
+    // preset/인코더 스레드는 녹화 중에 바꾸면 세그먼트가 나뉘므로 이전 녹화의 권고를 시작할 때만 적용
+    const int logical_cpus = static_cast<int>(std::thread::hardware_concurrency());
+    const std::vector<CpuEncoderStep> encoder_steps =
+        BuildCpuEncoderSteps(config.pipeline.encoder.h264_preset, logical_cpus);
+    if (g_cpu_budget_percent > 0 && g_governor_encoder_step > 0) {
+        const int step = std::min(g_governor_encoder_step.load(), static_cast<int32_t>(encoder_steps.size()) - 1);
+        config.pipeline.encoder.h264_preset = encoder_steps[step].preset;
+        config.pipeline.encoder.video_threads = encoder_steps[step].encoder_threads;
+        SATREC_LOG_INFO("[C++] CPU 예산: 인코더 단계 %d (preset %s, 스레드 %d)로 시작", step,
+                        encoder_steps[step].preset, encoder_steps[step].encoder_threads);
+    }
+    if (g_encoder_isolation) {
+        // 러너 실행 파일과 같은 폴더의 satrec_encoder_host.exe
+        wchar_t module_path[MAX_PATH] = {};
+        GetModuleFileNameW(nullptr, module_path, MAX_PATH);
+        config.pipeline.encoder_host_path = std::filesystem::path(module_path)
+            .replace_filename(L"satrec_encoder_host.exe").u8string();
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_capture_trace_mutex);
+        config.pipeline.capture_trace_path = SessionScopedPath(g_capture_trace_path, session.id());
+    }
+
+    // 기본 세션은 NativeRecorder_Initialize의 디바이스, 추가 세션은 자신의 디바이스 사용
+    ID3D11Device* device = runner_session.device ? runner_session.device : g_d3d_device;
+    ID3D11DeviceContext* context = runner_session.context ? runner_session.context : g_d3d_context;
+    config.video_source = monitor_index < 0
+        ? std::make_unique<DxgiVideoSource>(device, context)
+        : std::make_unique<DxgiVideoSource>(device, context, static_cast<UINT>(monitor_index));
+    if (!g_video_only) {
+        config.audio_source = std::make_unique<WasapiAudioSource>();
+    }
+    config.event_sink = &g_event_sink;
+    config.arm_only = arm_only;
+
+    // faststart 후처리는 백그라운드에서 진행 (Stop 호출자는 대기하지 않음)
+    // MKV/TS는 설정과 무관하게 항상 MP4로 변환
+    // 인코더 재시작(감시/CPU 예산/자식 프로세스 재실행)으로 나뉜 세그먼트는 설정과 무관하게 output_path 하나로 이어붙임
+    // 이중 출력 중 분리된 대상은 파일이 중간에 끊겼으므로 그대로 둠
+    config.on_finished = [output_path, live_path, secondary_output_path, secondary_live_path,
+                          encoder_steps](RecorderSession& finished) {
+        NativeLogger::Instance().LogStats();
+        const std::shared_ptr<const OutputTee> output_tee = finished.pipeline().GetOutputTee();
+        auto is_healthy = [&output_tee](size_t index) {
+            return !output_tee || output_tee->GetHealth(index).state == OutputDestinationState::kHealthy;
+        };
+
+        std::vector<std::string> segments;
+        for (const std::wstring& segment : finished.pipeline().GetSegmentPaths()) {
+            segments.push_back(std::filesystem::path(segment).u8string());
+        }
 
-    // 5. Loopback 모드로 초기화
-    REFERENCE_TIME buffer_duration = 1000 * 10000;  // 100ms in 100-nanosecond units
+        // 커밋 없이 끝난 pre-roll, 트리거 없이 끝난 준비 상태는 파일이 없으므로 후처리도 없음
+        const bool convert_container = (live_path != output_path);
+        const bool concat_segments = segments.size() > 1;
+        if (finished.pipeline().WroteOutput() && (concat_segments || convert_container || g_finalize_faststart)) {
+            std::lock_guard<std::mutex> lock(g_finalizer_mutex);
+            if (!g_mp4_finalizer) {
+                g_mp4_finalizer = std::make_unique<Mp4Finalizer>(OnFinalizeCompleted);
+            }
+            if (concat_segments) {
+                SATREC_LOG_INFO("[C++] 세션 %d: 인코더 재시작으로 나뉜 세그먼트 %zu개를 이어붙임",
+                                finished.id(), segments.size());
+                // 이어붙이기에 실패하면 세그먼트별 <이름>_part<N>으로 완료 이벤트가 옴
+                const std::wstring base = Utf8ToWide(output_path);
+                for (size_t i = 0; i < segments.size(); i++) {
+                    RegisterFinalizeOwner(std::filesystem::path(RecordingSegmentPath(base, static_cast<int>(i))).u8string(),
+                                          finished.id());
+                }
+                g_mp4_finalizer->EnqueueConcat(segments, output_path);
+            } else if (is_healthy(0)) {
+                RegisterFinalizeOwner(output_path, finished.id());
+                g_mp4_finalizer->Enqueue(live_path, output_path);
+            }
+            if (output_tee && output_tee->GetDestinationCount() > 1 && is_healthy(1)) {
+                RegisterFinalizeOwner(secondary_output_path, finished.id());
+                g_mp4_finalizer->Enqueue(secondary_live_path, secondary_output_path);
+            }
+        }
 
-    hr = g_audio_client->Initialize(
-        AUDCLNT_SHAREMODE_SHARED,        // Shared 모드
-        AUDCLNT_STREAMFLAGS_LOOPBACK,    // Loopback 플래그 (핵심!)
-        buffer_duration,
-        0,
-        g_wave_format,
-        nullptr
-    );
-    if (FAILED(hr)) {
-        printf("[C++] ❌ AudioClient 초기화 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("AudioClient 초기화 실패");
-        return false;
-    }
+        // 조절기 권고로 다음 녹화의 인코더 단계 갱신 (녹화 중에는 fps만 바꿈)
+        const CpuGovernorStats governor = finished.pipeline().GetCpuGovernorStats();
+        if (governor.enabled && governor.encoder_step_delta != 0 && g_cpu_budget_percent > 0) {
+            const int32_t max_step = static_cast<int32_t>(encoder_steps.size()) - 1;
+            const int32_t step = std::max(0, std::min(max_step, g_governor_encoder_step + governor.encoder_step_delta));
+            g_governor_encoder_step = step;
+            SATREC_LOG_INFO("[C++] CPU 예산: 다음 녹화 인코더 단계 %d (preset %s, 스레드 %d)", step,
+                            encoder_steps[step].preset, encoder_steps[step].encoder_threads);
+        }
 
-    // 6. IAudioCaptureClient 가져오기
-    hr = g_audio_client->GetService(
-        __uuidof(IAudioCaptureClient),
-        (void**)&g_audio_capture_client
-    );
-    if (FAILED(hr)) {
-        printf("[C++] ❌ IAudioCaptureClient 가져오기 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("IAudioCaptureClient 가져오기 실패");
-        return false;
-    }
+        SATREC_LOG_INFO("[C++] 세션 %d 리소스 정리 완료", finished.id());
+        NativeLogger::Instance().Flush();
+    };
 
-    // 7. 캡처 시작
-    hr = g_audio_client->Start();
-    if (FAILED(hr)) {
-        printf("[C++] ❌ 오디오 캡처 시작 실패 (HRESULT: 0x%08X)\n", hr);
-        fflush(stdout);
-        SetLastError("오디오 캡처 시작 실패");
-        return false;
+    std::string error;
+    if (!session.Launch(std::move(config), &error)) {
+        SetLastError(error);
+        return -1;
     }
-
-    printf("[C++] ✅ WASAPI 초기화 완료 (Loopback 모드)\n");
-    fflush(stdout);
-
-    return true;
+    SetLastError("");
+    return 0;
 }
 
-// WASAPI 리소스 정리
-static void CleanupWASAPI() {
-    printf("[C++] WASAPI 리소스 정리 시작...\n");
-    fflush(stdout);
+// ========== C 인터페이스 구현 (extern "C" 링크) ==========
 
-    if (g_audio_client) {
-        g_audio_client->Stop();
-    }
+extern "C" {
 
-    if (g_audio_capture_client) {
-        g_audio_capture_client->Release();
-        g_audio_capture_client = nullptr;
-    }
+// 녹화 초기화
+int32_t NativeRecorder_Initialize() {
+    try {
+        // COM 초기화 (멀티스레드 아파트)
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
+            SetLastError("COM 초기화 실패");
+            return -1;
+        }
+        g_com_initialized = true;
 
-    if (g_audio_client) {
-        g_audio_client->Release();
-        g_audio_client = nullptr;
-    }
+        // Direct3D11 디바이스 생성
+        if (!CreateD3D11Device()) {
+            SetLastError("D3D11 디바이스 생성 실패");
+            return -2;
+        }
 
-    if (g_audio_device) {
-        g_audio_device->Release();
-        g_audio_device = nullptr;
+        SetLastError("");
+        return 0;  // 성공
+    } catch (const std::exception& e) {
+        SetLastError(std::string("Initialize failed: ") + e.what());
+        return -1;
     }
+}
 
-    if (g_wave_format) {
-        CoTaskMemFree(g_wave_format);
-        g_wave_format = nullptr;
-    }
+// 녹화 시작
+int32_t NativeRecorder_StartRecording(
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps
+) {
+    return NativeRecorder_SessionStartRecording(kDefaultSessionHandle, output_path, width, height, fps, -1);
+}
 
-    printf("[C++] ✅ WASAPI 리소스 정리 완료\n");
-    fflush(stdout);
+// 녹화 준비 (장치/인코더/출력 파일을 미리 열고 트리거 대기)
+int32_t NativeRecorder_ArmRecording(
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps
+) {
+    return NativeRecorder_SessionArmRecording(kDefaultSessionHandle, output_path, width, height, fps, -1);
 }
 
-//==============================================================================
-// FFmpeg 파이프라인 보조 함수
-//==============================================================================
+// 준비된 녹화 시작 (준비가 끝나기 전이면 끝나는 즉시 시작)
+int32_t NativeRecorder_TriggerRecording() {
+    return NativeRecorder_SessionTriggerRecording(kDefaultSessionHandle);
+}
 
-// 입력: 없음
-// 출력: 타임스탬프와 카운터 초기화
-// 예외: 없음
-static void ResetRecordingStats() {
-    QueryPerformanceFrequency(&g_qpc_frequency);
-    QueryPerformanceCounter(&g_recording_start_qpc);
-    g_video_frame_count = 0;
-    g_audio_sample_count = 0;
+// 트리거 대기 중 여부
+int32_t NativeRecorder_IsArmed() {
+    return DefaultPipeline().IsArmed() ? 1 : 0;
 }
 
-// 입력: 없음 (큐 내부 데이터 사용)
-// 출력: 비디오 프레임을 FFmpeg 파이프에 전송했는지 여부
-// 예외: 파이프 오류 시 false, last_error 갱신
-static bool ProcessNextVideoFrame() {
-    std::unique_lock<std::mutex> lock(g_queue_mutex);
-    if (g_frame_queue.empty()) {
-        return false;
-    }
+// 녹화 중지
+int32_t NativeRecorder_StopRecording() {
+    return NativeRecorder_SessionStopRecording(kDefaultSessionHandle);
+}
 
-    FrameData frame = std::move(g_frame_queue.front());
-    g_frame_queue.pop();
-    lock.unlock();
+// 녹화 중 여부 확인
+int32_t NativeRecorder_IsRecording() {
+    return NativeRecorder_SessionIsRecording(kDefaultSessionHandle);
+}
 
-    if (!g_libav_encoder || !g_libav_encoder->IsRunning()) {
-        SetLastError("LibavEncoder가 실행 중이 아닙니다.");
-        return false;
-    }
+// 중지 요청 후 종료 처리 중 여부
+int32_t NativeRecorder_IsStopping() {
+    return NativeRecorder_SessionIsStopping(kDefaultSessionHandle);
+}
 
-    // ⚠️ 중요: 캡처 시점의 QPC 타임스탬프를 인코더에 전달 (A/V 동기화 핵심)
-    // 기존 카운터 기반 PTS 대신 실제 벽시계 시간 사용
-    if (!g_libav_encoder->EncodeVideo(frame.pixels.data(), frame.pixels.size(), frame.timestamp)) {
-        SetLastError(g_libav_encoder->GetLastError());
-        return false;
-    }
+// 마지막 녹화 세그먼트 (기본 세션)
+const char* NativeRecorder_GetSegmentPaths() {
+    return NativeRecorder_SessionGetSegmentPaths(kDefaultSessionHandle);
+}
 
-    g_video_frame_count++;
-    if (g_video_frame_count == 1 || g_video_frame_count % 300 == 0) {
-        printf("[C++] 비디오 프레임 #%lld 전송 완료\n", g_video_frame_count);
-        fflush(stdout);
+// 종료 처리 기한 설정
+int32_t NativeRecorder_SetStopDeadline(int32_t deadline_ms) {
+    if (deadline_ms < 0) {
+        return -1;
     }
-    return true;
+    g_finalize_deadline_ms = deadline_ms;
+    return 0;
 }
 
-// 입력: 없음 (큐 내부 데이터 사용)
-// 출력: 오디오 샘플을 FFmpeg 파이프에 전송했는지 여부
-// 예외: 파이프 오류 시 false, last_error 갱신
-static bool ProcessNextAudioSample() {
-    static int audio_packet_count = 0;
-    static int audio_debug_log_count = 0;
+// 인코더 자식 프로세스 사용 설정
+int32_t NativeRecorder_SetEncoderIsolation(int32_t enabled) {
+    g_encoder_isolation = enabled != 0;
+    SATREC_LOG_INFO("[C++] 인코더 자식 프로세스: %s (다음 녹화부터)", enabled != 0 ? "사용" : "사용 안 함");
+    return 0;
+}
 
-    std::unique_lock<std::mutex> lock(g_audio_queue_mutex);
-    if (g_audio_queue.empty()) {
-        return false;
+// 단계 감시 설정
+int32_t NativeRecorder_SetWatchdog(int32_t deadline_ms, int32_t max_restarts) {
+    if (deadline_ms < 0 || max_restarts < 0) {
+        return -1;
     }
+    g_watchdog_deadline_ms = deadline_ms;
+    g_stage_max_restarts = max_restarts;
+    SATREC_LOG_INFO("[C++] 단계 감시: 기한 %dms, 재시작 최대 %d회 (다음 녹화부터)", deadline_ms, max_restarts);
+    return 0;
+}
 
-    size_t queue_size_before_pop = g_audio_queue.size();
-    AudioSample audio = std::move(g_audio_queue.front());
-    g_audio_queue.pop();
-    lock.unlock();
-
-    size_t queue_remaining = queue_size_before_pop > 0 ? queue_size_before_pop - 1 : 0;
-
-    if (!g_libav_encoder || !g_libav_encoder->IsRunning()) {
-        SetLastError("LibavEncoder가 실행 중이 아닙니다.");
-        return false;
+int32_t NativeRecorder_SetCpuBudget(int32_t budget_percent) {
+    if (budget_percent < 0 || budget_percent > 100) {
+        return -1;
     }
-
-    int next_packet_index = audio_packet_count + 1;
-    double elapsed_ms = 0.0;
-    if (g_qpc_frequency.QuadPart > 0) {
-        long double start_qpc = static_cast<long double>(g_recording_start_qpc.QuadPart);
-        long double audio_qpc = static_cast<long double>(audio.timestamp);
-        long double delta = audio_qpc - start_qpc;
-        if (delta < 0.0L) {
-            delta = 0.0L;
-        }
-        elapsed_ms = static_cast<double>(delta * 1000.0L /
-                                         static_cast<long double>(g_qpc_frequency.QuadPart));
-    }
-
-    if (audio_debug_log_count < 5) {
-        printf("[C++] 오디오 패킷 #%d 준비 - 바이트:%llu, 프레임:%u, 잔여 큐:%llu, 경과:%.2fms\n",
-               next_packet_index,
-               static_cast<unsigned long long>(audio.data.size()),
-               audio.frame_count,
-               static_cast<unsigned long long>(queue_remaining),
-               elapsed_ms);
-        fflush(stdout);
-        audio_debug_log_count++;
-    }
-
-    // ⚠️ 중요: 캡처 시점의 QPC 타임스탬프를 인코더에 전달 (A/V 동기화 핵심)
-    // 비디오와 동일한 벽시계 기준으로 PTS 계산됨
-    if (!g_libav_encoder->EncodeAudio(audio.data.data(), audio.data.size(), audio.timestamp)) {
-        const std::string encoder_error = g_libav_encoder->GetLastError();
-        printf("[C++] ❌ 오디오 패킷 #%d 인코딩 실패\n", next_packet_index);
-        printf("[C++]    에러 메시지: %s\n", encoder_error.c_str());
-        printf("[C++]    데이터 크기: %llu bytes\n", static_cast<unsigned long long>(audio.data.size()));
-        printf("[C++]    프레임 수: %u\n", audio.frame_count);
-        printf("[C++]    인코더 실행 중: %s\n", g_libav_encoder->IsRunning() ? "예" : "아니오");
-        fflush(stdout);
-        SetLastError(encoder_error.empty() ? "오디오 인코딩 실패" : encoder_error);
-        return false;
+    g_cpu_budget_percent = budget_percent;
+    if (budget_percent == 0) {
+        g_governor_encoder_step = 0;
     }
+    SATREC_LOG_INFO("[C++] CPU 예산: %d%% (다음 녹화부터, 0이면 조절 안 함)", budget_percent);
+    return 0;
+}
 
-    g_audio_sample_count += audio.frame_count;
-
-    audio_packet_count++;
-    if (audio_packet_count == 1 || audio_packet_count % 500 == 0) {
-        printf("[C++] 오디오 패킷 #%d 전송 완료\n", audio_packet_count);
-        fflush(stdout);
+int32_t NativeRecorder_SetThreadPolicy(int32_t enabled, int32_t affinity_mode, uint64_t capture_cpus,
+                                       uint64_t audio_cpus, uint64_t encoder_cpus) {
+    if (affinity_mode < static_cast<int32_t>(ThreadAffinityMode::kNone) ||
+        affinity_mode > static_cast<int32_t>(ThreadAffinityMode::kHard)) {
+        return -1;
     }
-
-    return true;
+    g_thread_policy_enabled = enabled != 0;
+    g_thread_affinity_mode = affinity_mode;
+    g_capture_cpus = capture_cpus;
+    g_audio_cpus = audio_cpus;
+    g_encoder_cpus = encoder_cpus;
+    SATREC_LOG_INFO("[C++] 스레드 정책: %s, affinity %d (캡처 0x%llx, 오디오 0x%llx, 인코더 0x%llx, 다음 녹화부터)",
+                    enabled ? "사용" : "끔", affinity_mode, static_cast<unsigned long long>(capture_cpus),
+                    static_cast<unsigned long long>(audio_cpus), static_cast<unsigned long long>(encoder_cpus));
+    return 0;
 }
 
-// 입력: 없음
-// 출력: 없음 (파이프에 데이터 지속 전송)
-// 예외: 파이프 오류 시 last_error 갱신 후 루프 종료
-static void EncoderThreadFunc() {
-    try {
-        printf("[C++] FFmpeg 파이프 인코더 스레드 시작...\n");
-        fflush(stdout);
-
-    ResetRecordingStats();
-
-    // ⚠️ 스레드 안전성: 큐 접근 시 항상 뮤텍스 보호 필요
-    auto should_continue = [&]() {
-        bool has_frames = false;
-        bool has_audio = false;
-
-        {
-            std::lock_guard<std::mutex> lock(g_queue_mutex);
-            has_frames = !g_frame_queue.empty();
-        }
-
-        {
-            std::lock_guard<std::mutex> audio_lock(g_audio_queue_mutex);
-            has_audio = !g_audio_queue.empty();
-        }
-
-        return g_is_recording || has_frames || has_audio;
-    };
+// ============================================================================
+// 녹화 세션 (핸들 기반, 여러 녹화를 동시에)
+// ============================================================================
 
-    while (should_continue()) {
-        bool processed = false;
-        processed |= ProcessNextVideoFrame();
-        processed |= ProcessNextAudioSample();
+// 세션 생성 (전용 D3D11 디바이스 포함)
+int32_t NativeRecorder_CreateSession() {
+    ID3D11Device* device = nullptr;
+    ID3D11DeviceContext* context = nullptr;
+    if (!CreateD3D11Device(&device, &context)) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_sessions_mutex);
+    const int32_t handle = g_next_session_handle++;
+    auto runner_session = std::make_shared<RunnerSession>(handle);
+    runner_session->device = device;
+    runner_session->context = context;
+    g_sessions[handle] = runner_session;
+    SATREC_LOG_INFO("[C++] 세션 %d 생성", handle);
+    return handle;
+}
 
-        if (!processed) {
-            Sleep(2);
+// 세션 제거 (녹화 중이면 중지 후 종료 처리까지 대기)
+int32_t NativeRecorder_DestroySession(int32_t handle) {
+    std::shared_ptr<RunnerSession> runner_session;
+    {
+        std::lock_guard<std::mutex> lock(g_sessions_mutex);
+        auto it = g_sessions.find(handle);
+        if (handle == kDefaultSessionHandle || it == g_sessions.end()) {
+            SetLastError("Unknown session");
+            return -2;
         }
+        runner_session = std::move(it->second);
+        g_sessions.erase(it);
     }
+    runner_session->session.Stop();
+    SATREC_LOG_INFO("[C++] 세션 %d 제거", handle);
+    return 0;
+}
 
-    // 잔여 데이터 비우기
-    while (ProcessNextVideoFrame() || ProcessNextAudioSample()) {
-        // 잔여 데이터 비우기
+// 세션 녹화 시작
+int32_t NativeRecorder_SessionStartRecording(
+    int32_t handle,
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps,
+    int32_t monitor_index
+) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session) {
+        SetLastError("Unknown session");
+        return -4;
     }
+    return LaunchSession(*runner_session, output_path, width, height, fps, monitor_index, false);
+}
 
-    printf("[C++] FFmpeg 파이프 인코더 스레드 종료\n");
-    fflush(stdout);
-    } catch (const std::exception& e) {
-        printf("[C++] ❌ 인코더 스레드 예외 발생: %s\n", e.what());
-        fflush(stdout);
-    } catch (...) {
-        printf("[C++] ❌ 인코더 스레드 알 수 없는 예외 발생\n");
-        fflush(stdout);
+// 세션 녹화 준비
+int32_t NativeRecorder_SessionArmRecording(
+    int32_t handle,
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps,
+    int32_t monitor_index
+) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session) {
+        SetLastError("Unknown session");
+        return -4;
     }
+    return LaunchSession(*runner_session, output_path, width, height, fps, monitor_index, true);
 }
 
-// 프레임 큐에 추가 (나중에 FrameArrived에서 사용)
-[[maybe_unused]] static void EnqueueFrame(const FrameData& frame) {
-    std::lock_guard<std::mutex> lock(g_queue_mutex);
+// 세션의 준비된 녹화 시작
+int32_t NativeRecorder_SessionTriggerRecording(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session || !runner_session->session.Trigger()) {
+        SetLastError("준비된 녹화가 없습니다");
+        return -2;
+    }
+    return 0;
+}
 
-    if (g_frame_queue.size() >= MAX_QUEUE_SIZE) {
-        // 큐가 가득 찬 경우: 가장 오래된 프레임 버림
-        g_frame_queue.pop();
+// 세션 녹화 중지 요청 (바로 반환, 큐 비우기/파일 닫기는 세션 스레드가 백그라운드로 진행)
+int32_t NativeRecorder_SessionStopRecording(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session || !runner_session->session.IsRecording()) {
+        SetLastError("Not recording");
+        return -2;
     }
 
-    g_frame_queue.push(frame);
-    g_queue_cv.notify_one();
+    const auto requested_at = std::chrono::steady_clock::now();
+    runner_session->session.RequestStop();
+    SATREC_LOG_INFO("[C++] 세션 %d 중지 요청 (%.2fms에 반환, 종료 처리는 STOPPED 이벤트로 알림)", handle,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - requested_at).count());
+    SetLastError("");
+    return 0;  // 성공
 }
 
-// 프레임 큐에서 가져오기 (나중에 인코더 스레드에서 사용)
-[[maybe_unused]] static FrameData DequeueFrame() {
-    std::unique_lock<std::mutex> lock(g_queue_mutex);
-    g_queue_cv.wait(lock, [] {
-        return !g_frame_queue.empty() || !g_is_recording;
-    });
-
-    if (g_frame_queue.empty()) return FrameData{};
+// 세션 종료 처리 중 여부
+int32_t NativeRecorder_SessionIsStopping(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    return runner_session && runner_session->session.IsStopping() ? 1 : 0;
+}
 
-    FrameData frame = g_frame_queue.front();
-    g_frame_queue.pop();
-    return frame;
+// 세션 녹화 중 여부
+int32_t NativeRecorder_SessionIsRecording(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    return runner_session && runner_session->session.IsRecording() ? 1 : 0;
 }
 
-// 오디오 샘플 큐에 추가
-[[maybe_unused]] static void EnqueueAudioSample(const AudioSample& sample) {
-    std::lock_guard<std::mutex> lock(g_audio_queue_mutex);
+// 세션에서 인코딩된 비디오 프레임 수
+int64_t NativeRecorder_SessionGetVideoFrameCount(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    return runner_session ? runner_session->session.pipeline().GetVideoFrameCount() : 0;
+}
 
-    if (g_audio_queue.size() >= MAX_AUDIO_QUEUE_SIZE) {
-        // 큐가 가득 찬 경우: 가장 오래된 샘플 버림
-        g_audio_queue.pop();
+// 세션 녹화 경과 시간 (녹화 중이 아니면 0)
+int64_t NativeRecorder_SessionGetElapsedTimeMs(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session || !runner_session->session.IsRecording()) {
+        return 0;
     }
-
-    g_audio_queue.push(sample);
-    g_audio_queue_cv.notify_one();
+    return runner_session->session.pipeline().GetElapsedMs();
 }
 
-// 오디오 샘플 큐에서 가져오기
-[[maybe_unused]] static AudioSample DequeueAudioSample() {
-    std::unique_lock<std::mutex> lock(g_audio_queue_mutex);
-    g_audio_queue_cv.wait(lock, [] {
-        return !g_audio_queue.empty() || !g_is_recording;
-    });
-
-    if (g_audio_queue.empty()) return AudioSample{};
-
-    AudioSample sample = g_audio_queue.front();
-    g_audio_queue.pop();
-    return sample;
+// 세션 실시간 통계 블록 (세션을 제거하기 전까지 주소 고정)
+const NativeRecorderLiveStats* NativeRecorder_SessionGetLiveStats(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session) {
+        return nullptr;
+    }
+    return reinterpret_cast<const NativeRecorderLiveStats*>(&runner_session->session.pipeline().live_stats());
 }
 
-// 오디오 캡처 루프 (별도 스레드에서 실행)
-static void AudioCaptureThreadFunc() {
-    try {
-        printf("[C++] 오디오 캡처 스레드 시작...\n");
-        fflush(stdout);
-
-    HRESULT hr;
-    int sample_count = 0;
-
-    while (g_is_recording) {
-        // 사용 가능한 패킷 확인
-        UINT32 packet_length = 0;
-        hr = g_audio_capture_client->GetNextPacketSize(&packet_length);
-        if (FAILED(hr)) {
-            printf("[C++] ❌ GetNextPacketSize 실패 (HRESULT: 0x%08X)\n", hr);
-            fflush(stdout);
-            break;
-        }
-
-        while (packet_length != 0) {
-            // 오디오 데이터 가져오기
-            BYTE* data = nullptr;
-            UINT32 frames_available = 0;
-            DWORD flags = 0;
-
-            hr = g_audio_capture_client->GetBuffer(
-                &data,
-                &frames_available,
-                &flags,
-                nullptr,
-                nullptr
-            );
-
-            if (FAILED(hr)) {
-                printf("[C++] ❌ GetBuffer 실패 (HRESULT: 0x%08X)\n", hr);
-                fflush(stdout);
-                break;
-            }
-
-            // 오디오 샘플 생성 (무음 여부와 관계없이 항상 전송)
-            // ⚠️ 중요: 무음 구간에서도 데이터를 보내야 A/V 동기화 유지됨
-            AudioSample sample;
-            sample.frame_count = frames_available;
-            sample.sample_rate = g_wave_format->nSamplesPerSec;
-            sample.channels = g_wave_format->nChannels;
-            sample.bits_per_sample = g_wave_format->wBitsPerSample;
-
-            // 데이터 크기 계산
-            UINT32 data_size = frames_available * g_wave_format->nBlockAlign;
-            sample.data.resize(data_size);
-
-            // 무음 플래그 확인
-            if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
-                // 무음일 때: 0으로 채운 데이터 전송
-                memset(sample.data.data(), 0, data_size);
-                g_current_audio_level.store(0.0f);
-                g_peak_audio_level.store(0.0f);
-            } else {
-                // 실제 오디오 데이터 복사
-                memcpy(sample.data.data(), data, data_size);
-
-                // 오디오 레벨 계산 및 업데이트
-                float audio_level = CalculateAudioLevel(data, frames_available, g_wave_format->nChannels);
-                g_current_audio_level.store(audio_level);
-            }
-
-            // 타임스탬프 설정
-            LARGE_INTEGER qpc;
-            QueryPerformanceCounter(&qpc);
-            sample.timestamp = qpc.QuadPart;
-
-            // 큐에 추가 (무음 포함 항상)
-            EnqueueAudioSample(sample);
-
-            sample_count++;
-            if (sample_count == 1) {
-                printf("[C++] 🎤 첫 번째 오디오 샘플 캡처 성공! (%d frames)\n", frames_available);
-                fflush(stdout);
-            }
-            if (sample_count % 500 == 0) {
-                printf("[C++] 📊 오디오 샘플: %d개 캡처됨\n", sample_count);
-                fflush(stdout);
-            }
-
-            // 버퍼 해제
-            g_audio_capture_client->ReleaseBuffer(frames_available);
-
-            // 다음 패킷 확인
-            g_audio_capture_client->GetNextPacketSize(&packet_length);
-        }
-
-        // 10ms 대기 (CPU 절약)
-        Sleep(10);
+// 세션의 마지막 녹화 세그먼트 (UTF-8, 줄바꿈 구분)
+const char* NativeRecorder_SessionGetSegmentPaths(int32_t handle) {
+    const std::shared_ptr<RunnerSession> runner_session = FindSession(handle);
+    if (!runner_session) {
+        return "";
     }
-
-    printf("[C++] 오디오 캡처 스레드 종료, 총 %d개 샘플 캡처됨\n", sample_count);
-    fflush(stdout);
-    } catch (const std::exception& e) {
-        printf("[C++] ❌ 오디오 스레드 예외 발생: %s\n", e.what());
-        fflush(stdout);
-    } catch (...) {
-        printf("[C++] ❌ 오디오 스레드 알 수 없는 예외 발생\n");
-        fflush(stdout);
-    }
-}
-
-// DXGI 복구를 위한 재초기화 함수 (forward declaration)
-static bool ReinitializeDXGIDuplication();
-
-// 연속 실패 카운터 (복구 시도용)
-static int g_capture_failure_count = 0;
-static const int MAX_CAPTURE_FAILURES = 5;  // 5회 연속 실패 시 복구 시도
-
-// 프레임 캡처 (DXGI Desktop Duplication)
-static bool CaptureFrame() {
-    HRESULT hr;
-    DXGI_OUTDUPL_FRAME_INFO frame_info;
-    IDXGIResource* desktop_resource = nullptr;
-
-    // 1. 프레임 가져오기 (타임아웃 100ms)
-    hr = g_dxgi_duplication->AcquireNextFrame(100, &frame_info, &desktop_resource);
-    if (hr == DXGI_ERROR_WAIT_TIMEOUT) {
-        // 타임아웃: 화면 변화 없음 → 마지막 프레임 재사용
-        // ⚠️ 중요: 정적 화면(PPT, 문서 등)에서도 비디오 스트림 유지 필요
-        if (g_has_last_frame) {
-            // 새 타임스탬프로 마지막 프레임 복제하여 큐에 추가
-            FrameData repeat_frame = g_last_captured_frame;
-            LARGE_INTEGER qpc;
-            QueryPerformanceCounter(&qpc);
-            repeat_frame.timestamp = qpc.QuadPart;
-            EnqueueFrame(repeat_frame);
-        }
-        return true;
-    }
-    
-    // DXGI_ERROR_ACCESS_LOST: Desktop Duplication 세션이 무효화됨
-    // 원인: 전체화면 앱 전환, 디스플레이 설정 변경, DWM 재시작 등
-    if (hr == DXGI_ERROR_ACCESS_LOST) {
-        printf("[C++] ⚠️ DXGI_ERROR_ACCESS_LOST 발생 - Desktop Duplication 재초기화 시도...\\n");
-        fflush(stdout);
-        
-        // 기존 Duplication 정리
-        if (g_dxgi_duplication) {
-            g_dxgi_duplication->Release();
-            g_dxgi_duplication = nullptr;
-        }
-        
-        // 스테이징 텍스처도 정리 (해상도 변경 가능성)
-        if (g_staging_texture) {
-            g_staging_texture->Release();
-            g_staging_texture = nullptr;
-        }
-        
-        // 잠시 대기 후 재초기화
-        Sleep(500);
-        
-        if (ReinitializeDXGIDuplication()) {
-            printf("[C++] ✅ Desktop Duplication 재초기화 성공, 녹화 계속...\\n");
-            fflush(stdout);
-            g_capture_failure_count = 0;
-            return true;  // 재시도
-        } else {
-            printf("[C++] ❌ Desktop Duplication 재초기화 실패\\n");
-            fflush(stdout);
-            SetLastError("DXGI 세션 복구 실패");
-            return false;
-        }
+    std::string text;
+    for (const std::wstring& segment : runner_session->session.pipeline().GetSegmentPaths()) {
+        if (!text.empty()) text += '\n';
+        text += std::filesystem::path(segment).u8string();
     }
-    
-    if (FAILED(hr)) {
-        g_capture_failure_count++;
-        printf("[C++] ⚠️ 프레임 가져오기 실패 (HRESULT: 0x%08X, 연속실패: %d/%d)\\n",
-               hr, g_capture_failure_count, MAX_CAPTURE_FAILURES);
-        fflush(stdout);
-        
-        // 연속 실패가 임계값 미만이면 재시도
-        if (g_capture_failure_count < MAX_CAPTURE_FAILURES) {
-            Sleep(50);  // 잠시 대기 후 재시도
-            return true;
+    std::lock_guard<std::mutex> lock(runner_session->segment_paths_mutex);
+    runner_session->segment_paths_text = std::move(text);
+    return runner_session->segment_paths_text.c_str();
+}
+
+// 리소스 정리
+void NativeRecorder_Cleanup() {
+    // 모든 세션 중지 (녹화 중이면 파일을 닫을 때까지 대기), 추가 세션은 디바이스와 함께 제거
+    std::vector<std::shared_ptr<RunnerSession>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(g_sessions_mutex);
+        for (auto it = g_sessions.begin(); it != g_sessions.end();) {
+            sessions.push_back(it->second);
+            it = it->first == kDefaultSessionHandle ? std::next(it) : g_sessions.erase(it);
         }
-        
-        SetLastError("프레임 가져오기 연속 실패");
-        return false;
     }
-    
-    // 성공 시 실패 카운터 리셋
-    g_capture_failure_count = 0;
-
-    // 2. ID3D11Texture2D로 변환
-    ID3D11Texture2D* desktop_texture = nullptr;
-    hr = desktop_resource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&desktop_texture);
-    desktop_resource->Release();
-    if (FAILED(hr)) {
-        g_dxgi_duplication->ReleaseFrame();
-        SetLastError("Texture 변환 실패");
-        return false;
+    for (const auto& runner_session : sessions) {
+        runner_session->session.Stop();
     }
+    sessions.clear();
 
-    // 3. Staging Texture로 복사 (GPU → CPU)
-    D3D11_TEXTURE2D_DESC desc;
-    desktop_texture->GetDesc(&desc);
+    // Direct3D11 리소스 정리
+    CleanupD3D11();
 
-    if (!g_staging_texture) {
-        // Staging Texture 생성 (최초 1회)
-        desc.Usage = D3D11_USAGE_STAGING;
-        desc.BindFlags = 0;
-        desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-        desc.MiscFlags = 0;
-        g_d3d_device->CreateTexture2D(&desc, nullptr, &g_staging_texture);
+    // 진행 중인 faststart 후처리 완료 대기 (소멸자가 남은 작업까지 처리)
+    std::unique_ptr<Mp4Finalizer> finalizer;
+    {
+        std::lock_guard<std::mutex> lock(g_finalizer_mutex);
+        finalizer = std::move(g_mp4_finalizer);
     }
+    finalizer.reset();
 
-    g_d3d_context->CopyResource(g_staging_texture, desktop_texture);
-    desktop_texture->Release();
+    // 기록 중인 trace 마무리 (JSON 닫기)
+    TraceRecorder::Instance().Stop();
 
-    // 4. CPU 메모리로 읽기
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    hr = g_d3d_context->Map(g_staging_texture, 0, D3D11_MAP_READ, 0, &mapped);
-    if (SUCCEEDED(hr)) {
-        FrameData frame;
-        frame.width = desc.Width;
-        frame.height = desc.Height;
+    // 남은 로그 출력
+    NativeLogger::Instance().Flush();
 
-        // 픽셀 데이터 복사 (행 단위)
-        size_t pixel_count = desc.Width * desc.Height * 4;  // BGRA
-        frame.pixels.resize(pixel_count);
-
-        uint8_t* src = (uint8_t*)mapped.pData;
-        uint8_t* dst = frame.pixels.data();
-
-        for (UINT y = 0; y < desc.Height; y++) {
-            memcpy(dst + y * desc.Width * 4, src + y * mapped.RowPitch, desc.Width * 4);
-        }
-
-        g_d3d_context->Unmap(g_staging_texture, 0);
-
-        // 타임스탬프 설정
-        LARGE_INTEGER qpc;
-        QueryPerformanceCounter(&qpc);
-        frame.timestamp = qpc.QuadPart;
-
-        // 마지막 프레임으로 저장 (타임아웃 시 재사용)
-        g_last_captured_frame = frame;
-        g_has_last_frame = true;
-
-        // 프레임 큐에 추가
-        EnqueueFrame(frame);
+    // COM 종료
+    if (g_com_initialized) {
+        CoUninitialize();
+        g_com_initialized = false;
     }
-
-    // 5. 프레임 해제
-    g_dxgi_duplication->ReleaseFrame();
-
-    return true;
 }
 
-// 녹화 스레드 함수
-static void CaptureThreadFunc(
-    std::string output_path,
-    int32_t width,
-    int32_t height,
-    int32_t fps
-) {
-    try {
-        // DXGI Desktop Duplication 초기화
-        printf("[C++] DXGI Desktop Duplication 초기화 시작...\n");
-        fflush(stdout);
-
-    if (!InitializeDXGIDuplication()) {
-        printf("[C++] ❌ Desktop Duplication 초기화 실패\n");
-        fflush(stdout);
-        SetLastError("Desktop Duplication 초기화 실패");
-        g_is_recording = false;
-        return;
+// Dart native API 초기화 (Dart_PostCObject_DL 등 함수 포인터 설정)
+int32_t NativeRecorder_InitializeDartApi(void* data) {
+    if (Dart_InitializeApiDL(data) != 0) {
+        SATREC_LOG_ERROR("[C++] ❌ Dart API 초기화 실패 (Dart SDK 버전 불일치)");
+        return -1;
     }
+    g_dart_api_initialized = true;
+    return 0;
+}
 
-    printf("[C++] ✅ DXGI Desktop Duplication 초기화 완료\n");
-    fflush(stdout);
+// 녹화 이벤트 수신 포트 설정 (0이면 해제)
+void NativeRecorder_SetEventPort(int64_t port) {
+    g_event_port = port;
+}
 
-    // WASAPI 초기화
-    if (!InitializeWASAPI()) {
-        printf("[C++] ❌ WASAPI 초기화 실패\n");
-        fflush(stdout);
-        SetLastError("WASAPI 초기화 실패");
-        CleanupDXGIDuplication();
-        g_is_recording = false;
-        return;
+// 비디오 큐 메모리 예산 / 저장 형식 설정
+int32_t NativeRecorder_SetFrameBuffering(int64_t budget_bytes, int32_t frame_format) {
+    if (budget_bytes < 0 ||
+        (frame_format != static_cast<int32_t>(FramePixelFormat::kBgra) &&
+         frame_format != static_cast<int32_t>(FramePixelFormat::kI420))) {
+        return -1;
     }
-    printf("[C++] ✅ WASAPI 초기화 완료\n");
-    fflush(stdout);
-
-    // 오디오 캡처 스레드 시작
-    g_audio_thread = std::thread(AudioCaptureThreadFunc);
-    printf("[C++] ✅ 오디오 캡처 스레드 시작됨\n");
-    fflush(stdout);
+    g_video_queue_budget_bytes = budget_bytes;
+    g_video_frame_format = frame_format;
+    return 0;
+}
 
-    // 출력 파일 경로를 wchar_t로 변환 (UTF-8 → UTF-16)
-    int wide_length = MultiByteToWideChar(CP_UTF8, 0, output_path.c_str(), -1, nullptr, 0);
-    if (wide_length <= 1) {
-        printf("[C++] ❌ 출력 경로 UTF-16 변환 실패\n");
-        fflush(stdout);
-        CleanupWASAPI();
-        if (g_audio_thread.joinable()) g_audio_thread.join();
-        CleanupDXGIDuplication();
-        g_is_recording = false;
-        return;
+// pre-roll / post-roll 설정
+int32_t NativeRecorder_SetPreRoll(int32_t max_ms, int64_t max_bytes, int32_t postroll_ms) {
+    if (max_ms < 0 || max_bytes <= 0 || postroll_ms < 0) {
+        return -1;
     }
+    g_preroll_max_ms = max_ms;
+    g_preroll_max_bytes = max_bytes;
+    g_postroll_ms = postroll_ms;
+    return 0;
+}
 
-    std::wstring w_output_path(wide_length - 1, 0);
-    MultiByteToWideChar(CP_UTF8, 0, output_path.c_str(), -1, w_output_path.data(), wide_length);
-
-    // LibavEncoder 준비
-    g_video_width = width;
-    g_video_height = height;
-    g_video_fps = fps;
-
-    LibavEncoderConfig encoder_config;
-    encoder_config.output_path = w_output_path;
-    encoder_config.video_width = width;
-    encoder_config.video_height = height;
-    encoder_config.video_fps = fps;
-
-    // Audio 설정 (g_wave_format 사용)
-    if (g_wave_format) {
-        encoder_config.audio_sample_rate = g_wave_format->nSamplesPerSec;
-        encoder_config.audio_channels = g_wave_format->nChannels;
-    } else {
-        encoder_config.audio_sample_rate = 48000;
-        encoder_config.audio_channels = 2;
+// pre-roll 커밋 (인코더 스레드가 링을 파일로 넘길 때까지 대기)
+int32_t NativeRecorder_CommitPreRoll(int32_t lookback_ms) {
+    RecordingPipeline& pipeline = DefaultPipeline();
+    if (NativeRecorder_SessionIsRecording(kDefaultSessionHandle) == 0 || !pipeline.IsPreRollActive()) {
+        SetLastError("pre-roll 중이 아닙니다");
+        return -2;
     }
-
-    encoder_config.enable_fragmented_mp4 = true;
-    encoder_config.h264_crf = 23;
-    encoder_config.h264_preset = "veryfast";
-    encoder_config.aac_bitrate = 192000;
-
-    try {
-        g_libav_encoder = std::make_unique<LibavEncoder>();
-        if (!g_libav_encoder->Start(encoder_config)) {
-            printf("[C++] ❌ LibavEncoder 시작 실패: %s\n", g_libav_encoder->GetLastError().c_str());
-            fflush(stdout);
-            g_libav_encoder.reset();
-            CleanupWASAPI();
-            if (g_audio_thread.joinable()) g_audio_thread.join();
-            CleanupDXGIDuplication();
-            g_is_recording = false;
-            return;
-        }
-    } catch (const std::exception& e) {
-        printf("[C++] ❌ LibavEncoder 시작 중 예외 발생: %s\n", e.what());
-        fflush(stdout);
-        SetLastError(std::string("LibavEncoder 시작 예외: ") + e.what());
-        g_libav_encoder.reset();
-        CleanupWASAPI();
-        if (g_audio_thread.joinable()) g_audio_thread.join();
-        CleanupDXGIDuplication();
-        g_is_recording = false;
-        return;
-    } catch (...) {
-        printf("[C++] ❌ LibavEncoder 시작 중 알 수 없는 예외 발생\n");
-        fflush(stdout);
-        SetLastError("LibavEncoder 시작 중 알 수 없는 예외 발생");
-        g_libav_encoder.reset();
-        CleanupWASAPI();
-        if (g_audio_thread.joinable()) g_audio_thread.join();
-        CleanupDXGIDuplication();
-        g_is_recording = false;
-        return;
+    std::string error;
+    PreRollCommitInfo info;
+    if (!pipeline.CommitPreRoll(lookback_ms, &error, &info)) {
+        SATREC_LOG_ERROR("[C++] ❌ pre-roll 커밋 실패: %s", error.c_str());
+        SetLastError(error);
+        return -3;
     }
+    SATREC_LOG_INFO("[C++] pre-roll 커밋 완료 (%lldms 포함, %.2fms 소요)",
+                    static_cast<long long>(info.preroll_ms), static_cast<double>(info.commit_us) / 1000.0);
+    return 0;
+}
 
-    // 인코더 스레드 시작
-    g_encoder_thread = std::thread(EncoderThreadFunc);
+// 커밋 전 pre-roll 중 여부
+int32_t NativeRecorder_IsPreRollActive() {
+    return DefaultPipeline().IsPreRollActive() ? 1 : 0;
+}
 
-    printf("[C++] ✅ 모든 초기화 완료, 녹화 시작\\n");
-    fflush(stdout);
+// 마지막 에러 메시지 가져오기
+const char* NativeRecorder_GetLastError() {
+    std::lock_guard<std::mutex> lock(g_error_mutex);
+    return g_last_error.c_str();
+}
 
-    // 메인 캡처 루프 (FPS 제한 적용)
-    int frame_count = 0;
-    g_capture_failure_count = 0;  // 실패 카운터 초기화
+// ============================================================================
+// Phase 3.1.1: 녹화 진행률 조회 함수들
+// ============================================================================
 
-    // FPS 제한을 위한 타이밍 계산
-    // 예: 24fps → 프레임 간격 약 41.67ms
-    const double target_frame_interval_ms = 1000.0 / fps;
-    LARGE_INTEGER last_frame_qpc;
-    QueryPerformanceCounter(&last_frame_qpc);
+// 현재까지 인코딩된 비디오 프레임 수 가져오기
+int64_t NativeRecorder_GetVideoFrameCount() {
+    return DefaultPipeline().GetVideoFrameCount();
+}
 
-    printf("[C++] 프레임 캡처 루프 시작 (목표: %dfps, 간격: %.2fms)\\n", fps, target_frame_interval_ms);
-    fflush(stdout);
+// 현재까지 인코딩된 오디오 샘플 수 가져오기
+int64_t NativeRecorder_GetAudioSampleCount() {
+    return DefaultPipeline().GetAudioSampleCount();
+}
 
-    while (g_is_recording) {
-        // FPS 제한: 목표 프레임 간격이 지날 때까지 대기
-        LARGE_INTEGER current_qpc;
-        QueryPerformanceCounter(&current_qpc);
-        double elapsed_ms = static_cast<double>(current_qpc.QuadPart - last_frame_qpc.QuadPart)
-                           * 1000.0 / g_qpc_frequency.QuadPart;
+// 녹화 시작 이후 경과 시간 (밀리초)
+// 녹화 중이 아니면 0 반환
+int64_t NativeRecorder_GetElapsedTimeMs() {
+    return NativeRecorder_SessionGetElapsedTimeMs(kDefaultSessionHandle);
+}
 
-        if (elapsed_ms < target_frame_interval_ms) {
-            // 남은 시간만큼 Sleep (CPU 절약)
-            DWORD sleep_ms = static_cast<DWORD>(target_frame_interval_ms - elapsed_ms);
-            if (sleep_ms > 0) {
-                Sleep(sleep_ms);
-            }
-            continue;  // 다시 시간 체크
-        }
+// ============================================================================
+// Phase 3.1.2: 오디오 레벨 조회 함수들
+// ============================================================================
 
-        // 프레임 캡처 시점 기록 (다음 간격 계산용)
-        QueryPerformanceCounter(&last_frame_qpc);
+// 현재 오디오 RMS 레벨 가져오기 (0.0 ~ 1.0)
+// RMS (Root Mean Square)는 소리의 평균 에너지를 나타냄
+float NativeRecorder_GetAudioLevel() {
+    return DefaultPipeline().GetAudioLevel();
+}
 
-        if (CaptureFrame()) {
-            frame_count++;
-            if (frame_count == 1) {
-                printf("[C++] 🎬 첫 번째 프레임 캡처 성공!\n");
-                fflush(stdout);
-            }
-            if (frame_count % (fps * 10) == 0) {  // 10초마다 로그
-                double actual_fps = static_cast<double>(frame_count) /
-                    (static_cast<double>(last_frame_qpc.QuadPart - g_recording_start_qpc.QuadPart)
-                     / g_qpc_frequency.QuadPart);
-                printf("[C++] 📊 캡처된 프레임: %d (실제 FPS: %.1f)\n", frame_count, actual_fps);
-                fflush(stdout);
-            }
-        } else {
-            // 캡처 실패 시 루프 종료
-            printf("[C++] ❌ 프레임 캡처 실패, 루프 종료 (총 %d 프레임)\n", frame_count);
-            fflush(stdout);
-            g_is_recording = false;
-            break;
-        }
-    }
+// 현재 오디오 Peak 레벨 가져오기 (0.0 ~ 1.0)
+// Peak는 최대 진폭을 나타냄
+float NativeRecorder_GetAudioPeakLevel() {
+    return DefaultPipeline().GetAudioPeakLevel();
+}
 
-    printf("[C++] 캡처 루프 종료, 총 %d 프레임 캡처됨\n", frame_count);
-    fflush(stdout);
+// ============================================================================
+// 파이프라인 통계 (지연 시간 / 큐 압력)
+// ============================================================================
 
-    // 인코더 스레드 종료 대기
-    if (g_encoder_thread.joinable()) {
-        printf("[C++] 인코더 스레드 종료 대기...\n");
-        fflush(stdout);
-        g_encoder_thread.join();
+// 단계별 지연 시간 요약 (녹화 중/종료 후 모두 조회 가능)
+int32_t NativeRecorder_GetPipelineStats(NativeRecorderPipelineStats* stats) {
+    if (!stats || stats->struct_size != static_cast<int32_t>(sizeof(NativeRecorderPipelineStats))) {
+        SetLastError("Invalid pipeline stats struct");
+        return -1;
     }
 
-    // Video-only 모드가 아닐 때만 오디오 스레드 종료 대기
-    if (!g_video_only && g_audio_thread.joinable()) {
-        printf("[C++] 오디오 스레드 종료 대기...\n");
-        fflush(stdout);
-        g_audio_thread.join();
-    }
+    static_assert(static_cast<int>(PipelineStage::kCount) == NATIVE_RECORDER_PIPELINE_STAGE_COUNT,
+                  "FFI 단계 수와 PipelineStage가 일치해야 함");
+    stats->stage_count = NATIVE_RECORDER_PIPELINE_STAGE_COUNT;
+    stats->record_cost_ns = DefaultPipeline().pipeline_stats().GetRecordCostNs();
+    for (int i = 0; i < NATIVE_RECORDER_PIPELINE_STAGE_COUNT; i++) {
+        const LatencySummary summary = DefaultPipeline().pipeline_stats().Summarize(static_cast<PipelineStage>(i));
+        NativeRecorderStageLatency& out = stats->stages[i];
+        out.count = summary.count;
+        out.min_us = summary.min_us;
+        out.mean_us = summary.mean_us;
+        out.p50_us = summary.p50_us;
+        out.p90_us = summary.p90_us;
+        out.p99_us = summary.p99_us;
+        out.p999_us = summary.p999_us;
+        out.max_us = summary.max_us;
+    }
+    return 0;
+}
 
-    // 정리
-    if (g_libav_encoder) {
-        g_libav_encoder->Stop();
-        g_libav_encoder.reset();
+// 드롭/반복 프레임 및 큐 깊이 통계
+int32_t NativeRecorder_GetQueueStats(NativeRecorderQueueStats* stats) {
+    if (!stats || stats->struct_size != static_cast<int32_t>(sizeof(NativeRecorderQueueStats))) {
+        SetLastError("Invalid queue stats struct");
+        return -1;
     }
 
-    // WASAPI 정리
-    CleanupWASAPI();
-
-    CleanupDXGIDuplication();
-    printf("[C++] 모든 리소스 정리 완료\n");
-    fflush(stdout);
-    } catch (const std::exception& e) {
-        printf("[C++] ❌ 캡처 스레드 예외 발생: %s\n", e.what());
-        fflush(stdout);
-        // 예외 발생 시에도 정리 시도
-        g_is_recording = false;
-        CleanupWASAPI();
-        CleanupDXGIDuplication();
-    } catch (...) {
-        printf("[C++] ❌ 캡처 스레드 알 수 없는 예외 발생\n");
-        fflush(stdout);
-        g_is_recording = false;
-        CleanupWASAPI();
-        CleanupDXGIDuplication();
-    }
+    const RecordingQueueStats queue_stats = DefaultPipeline().GetQueueStats();
+    stats->captured_video_frames = queue_stats.captured_video_frames;
+    stats->repeated_video_frames = queue_stats.repeated_video_frames;
+    stats->dropped_video_frames = queue_stats.dropped_video_frames;
+    stats->dropped_audio_packets = queue_stats.dropped_audio_packets;
+    stats->dropped_audio_samples = queue_stats.dropped_audio_samples;
+    stats->dropped_audio_ms = queue_stats.dropped_audio_us / 1000;
+    stats->video_queue_depth = static_cast<int32_t>(queue_stats.video_queue_depth);
+    stats->audio_queue_depth = static_cast<int32_t>(queue_stats.audio_queue_depth);
+    stats->video_queue_high_water = static_cast<int32_t>(queue_stats.video_queue_high_water);
+    stats->audio_queue_high_water = static_cast<int32_t>(queue_stats.audio_queue_high_water);
+    stats->video_queue_capacity = static_cast<int32_t>(queue_stats.video_queue_capacity);
+    stats->audio_queue_capacity = static_cast<int32_t>(queue_stats.audio_queue_capacity);
+    return 0;
 }
 
-// ========== C 인터페이스 구현 (extern "C" 링크) ==========
+// 실시간 통계 블록 (기본 세션은 제거되지 않으므로 주소가 바뀌지 않음)
+const NativeRecorderLiveStats* NativeRecorder_GetLiveStats() {
+    static_assert(sizeof(NativeRecorderLiveStats) == sizeof(LiveStatsBlock),
+                  "NativeRecorderLiveStats와 LiveStatsBlock 레이아웃이 일치해야 함");
+    return reinterpret_cast<const NativeRecorderLiveStats*>(&DefaultPipeline().live_stats());
+}
 
-extern "C" {
+// ============================================================================
+// 네이티브 로그 파일
+// ============================================================================
 
-// 녹화 초기화
-int32_t NativeRecorder_Initialize() {
-    try {
-        // COM 초기화 (멀티스레드 아파트)
-        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-        if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
-            SetLastError("COM 초기화 실패");
-            return -1;
-        }
-        g_com_initialized = true;
+// 네이티브 로그를 Dart LoggerService와 같은 파일에 추가 (nullptr/빈 문자열이면 콘솔만)
+void NativeRecorder_SetLogFilePath(const char* log_path) {
+    NativeLogger::Instance().SetFilePath(log_path ? log_path : "");
+}
 
-        // Direct3D11 디바이스 생성
-        if (!CreateD3D11Device()) {
-            SetLastError("D3D11 디바이스 생성 실패");
-            return -2;
-        }
+// ============================================================================
+// 파이프라인 trace (Chrome trace-event JSON)
+// ============================================================================
 
-        SetLastError("");
-        return 0;  // 성공
-    } catch (const std::exception& e) {
-        SetLastError(std::string("Initialize failed: ") + e.what());
+// trace 기록 시작 (녹화 중에도 가능)
+int32_t NativeRecorder_StartTrace(const char* output_path) {
+    if (!output_path || strlen(output_path) == 0) {
+        SetLastError("Invalid trace path");
         return -1;
     }
-}
 
-// 녹화 시작
-int32_t NativeRecorder_StartRecording(
-    const char* output_path,
-    int32_t width,
-    int32_t height,
-    int32_t fps
-) {
-    if (g_is_recording) {
-        SetLastError("Already recording");
+    std::string error;
+    if (!TraceRecorder::Instance().Start(output_path, &error)) {
+        SetLastError(error);
         return -2;
     }
+    return 0;
+}
 
-    if (!output_path || strlen(output_path) == 0) {
-        SetLastError("Invalid output path");
-        return -3;
-    }
+// trace 기록 종료 (남은 이벤트 기록 후 파일 닫기)
+int64_t NativeRecorder_StopTrace() {
+    TraceRecorder::Instance().Stop();
+    return TraceRecorder::Instance().GetWrittenEventCount();
+}
 
-    try {
-        g_is_recording = true;
+// 캡처 trace 경로 설정 (다음 녹화부터 적용, 빈 경로면 기록 안 함)
+int32_t NativeRecorder_SetCaptureTracePath(const char* output_path) {
+    std::lock_guard<std::mutex> lock(g_capture_trace_mutex);
+    g_capture_trace_path = output_path ? output_path : "";
+    return 0;
+}
 
-        // 캡처 스레드 시작
-        g_capture_thread = std::thread(
-            CaptureThreadFunc,
-            std::string(output_path),
-            width,
-            height,
-            fps
-        );
+// ============================================================================
+// 녹화 후처리 (faststart remux)
+// ============================================================================
 
-        SetLastError("");
-        return 0;  // 성공
-    } catch (const std::exception& e) {
-        g_is_recording = false;
-        SetLastError(std::string("StartRecording failed: ") + e.what());
-        return -1;
-    }
+// faststart 후처리 진행 중 여부
+int32_t NativeRecorder_IsFinalizing() {
+    std::lock_guard<std::mutex> lock(g_finalizer_mutex);
+    return (g_mp4_finalizer && g_mp4_finalizer->IsBusy()) ? 1 : 0;
 }
 
-// 녹화 중지
-int32_t NativeRecorder_StopRecording() {
-    if (!g_is_recording) {
-        SetLastError("Not recording");
-        return -2;
-    }
+// faststart 후처리 사용 여부 설정 (다음 녹화부터 적용)
+void NativeRecorder_SetFaststartEnabled(int32_t enabled) {
+    g_finalize_faststart = (enabled != 0);
+}
 
-    try {
-        g_is_recording = false;
+// ============================================================================
+// 패킷 저널 (크래시 복구)
+// ============================================================================
 
-        // 캡처 스레드 종료 대기
-        if (g_capture_thread.joinable()) {
-            g_capture_thread.join();
-        }
+// 패킷 저널 사용 여부 설정
+void NativeRecorder_SetPacketJournalEnabled(int32_t enabled) {
+    g_packet_journal_enabled = (enabled != 0);
+}
 
-        // 마지막 프레임 상태 리셋
-        g_has_last_frame = false;
-        g_last_captured_frame = FrameData();
+// 저널에서 MP4 복구 (호출 스레드에서 동기 실행)
+int32_t NativeRecorder_RecoverFromJournal(const char* journal_path, const char* output_path) {
+    if (!journal_path || strlen(journal_path) == 0 || !output_path || strlen(output_path) == 0) {
+        SetLastError("Invalid journal recovery arguments");
+        return -1;
+    }
 
+    try {
+        std::string error;
+        if (!RecoverFromJournal(journal_path, output_path, nullptr, &error)) {
+            SetLastError(error);
+            return -2;
+        }
         SetLastError("");
-        return 0;  // 성공
+        return 0;
     } catch (const std::exception& e) {
-        SetLastError(std::string("StopRecording failed: ") + e.what());
-        return -1;
+        SetLastError(std::string("RecoverFromJournal failed: ") + e.what());
+        return -2;
     }
 }
 
-// 녹화 중 여부 확인
-int32_t NativeRecorder_IsRecording() {
-    return g_is_recording ? 1 : 0;
-}
-
-// 리소스 정리
-void NativeRecorder_Cleanup() {
-    if (g_is_recording) {
-        NativeRecorder_StopRecording();
-    }
+// ============================================================================
+// 녹화 컨테이너 (Fragmented MP4 / Matroska / MPEG-TS)
+// ============================================================================
 
-    // 오디오 스레드 종료 대기
-    if (g_audio_thread.joinable()) {
-        g_audio_thread.join();
+// 녹화 중 컨테이너 설정 (다음 녹화부터 적용)
+int32_t NativeRecorder_SetContainerFormat(int32_t container) {
+    if (container < static_cast<int32_t>(RecordingContainer::kFragmentedMp4) ||
+        container > static_cast<int32_t>(RecordingContainer::kMpegTs)) {
+        SetLastError("Invalid container format");
+        return -1;
     }
+    g_container_format = container;
+    return 0;
+}
 
-    if (g_libav_encoder) {
-        g_libav_encoder->Stop();
-        g_libav_encoder.reset();
+// MKV/TS 등을 faststart MP4로 변환 (호출 스레드에서 동기 실행)
+// 강제 종료로 변환되지 못하고 남은 파일 처리용
+int32_t NativeRecorder_RemuxToMp4(const char* input_path, const char* output_path) {
+    if (!input_path || strlen(input_path) == 0 || !output_path || strlen(output_path) == 0) {
+        SetLastError("Invalid remux arguments");
+        return -1;
     }
 
-    // WASAPI 리소스 정리
-    CleanupWASAPI();
-
-    // DXGI Duplication 리소스 정리
-    CleanupDXGIDuplication();
-
-    // Direct3D11 리소스 정리
-    CleanupD3D11();
-
-    // COM 종료
-    if (g_com_initialized) {
-        CoUninitialize();
-        g_com_initialized = false;
+    try {
+        std::string error;
+        if (!RemuxToFaststartMp4(input_path, output_path, nullptr, &error)) {
+            SetLastError(error);
+            return -2;
+        }
+        SetLastError("");
+        return 0;
+    } catch (const std::exception& e) {
+        SetLastError(std::string("RemuxToFaststartMp4 failed: ") + e.what());
+        return -2;
     }
 }
 
-// 마지막 에러 메시지 가져오기
-const char* NativeRecorder_GetLastError() {
-    std::lock_guard<std::mutex> lock(g_error_mutex);
-    return g_last_error.c_str();
-}
-
 // ============================================================================
-// Phase 3.1.1: 녹화 진행률 조회 함수들
+// 이중 출력 (primary + secondary)
 // ============================================================================
 
-// 현재까지 인코딩된 비디오 프레임 수 가져오기
-int64_t NativeRecorder_GetVideoFrameCount() {
-    return g_video_frame_count;
+// 보조 출력 경로 설정 (다음 녹화부터 적용, nullptr/빈 문자열이면 사용 안 함)
+void NativeRecorder_SetSecondaryOutputPath(const char* output_path) {
+    std::lock_guard<std::mutex> lock(g_output_mutex);
+    g_secondary_output_path = output_path ? output_path : "";
 }
 
-// 현재까지 인코딩된 오디오 샘플 수 가져오기
-int64_t NativeRecorder_GetAudioSampleCount() {
-    return g_audio_sample_count;
+// 출력 대상 상태 (0: primary, 1: secondary)
+int32_t NativeRecorder_GetOutputState(int32_t index) {
+    const std::shared_ptr<const OutputTee> output_tee = DefaultPipeline().GetOutputTee();
+    if (index < 0 || !output_tee) {
+        return static_cast<int32_t>(OutputDestinationState::kInactive);
+    }
+    return static_cast<int32_t>(output_tee->GetHealth(static_cast<size_t>(index)).state);
 }
 
-// 녹화 시작 이후 경과 시간 (밀리초)
-// 녹화 중이 아니면 0 반환
-int64_t NativeRecorder_GetElapsedTimeMs() {
-    if (!g_is_recording) {
+// 출력 대상에 기록 완료된 바이트 수
+int64_t NativeRecorder_GetOutputBytesWritten(int32_t index) {
+    const std::shared_ptr<const OutputTee> output_tee = DefaultPipeline().GetOutputTee();
+    if (index < 0 || !output_tee) {
         return 0;
     }
+    return output_tee->GetHealth(static_cast<size_t>(index)).bytes_written;
+}
 
-    LARGE_INTEGER current_qpc;
-    QueryPerformanceCounter(&current_qpc);
-
-    // QPC 카운트 차이를 밀리초로 변환
-    int64_t elapsed_counts = current_qpc.QuadPart - g_recording_start_qpc.QuadPart;
-    int64_t elapsed_ms = (elapsed_counts * 1000LL) / g_qpc_frequency.QuadPart;
-
-    return elapsed_ms;
+// 출력 대상 큐에서 대기 중인 바이트 수 (디스크가 느려지면 증가)
+int64_t NativeRecorder_GetOutputQueuedBytes(int32_t index) {
+    const std::shared_ptr<const OutputTee> output_tee = DefaultPipeline().GetOutputTee();
+    if (index < 0 || !output_tee) {
+        return 0;
+    }
+    return output_tee->GetHealth(static_cast<size_t>(index)).queued_bytes;
 }
 
-// ============================================================================
-// Phase 3.1.2: 오디오 레벨 조회 함수들
-// ============================================================================
+// 세그먼트 이어붙이기 (packet copy, 호출 스레드에서 동기 실행)
+int32_t NativeRecorder_ConcatSegments(
+    const char* const* input_paths,
+    int32_t input_count,
+    const char* output_path
+) {
+    if (!input_paths || input_count <= 0 || !output_path || strlen(output_path) == 0) {
+        SetLastError("Invalid concat arguments");
+        return static_cast<int32_t>(ConcatResult::kInvalidArgument);
+    }
 
-// 현재 오디오 RMS 레벨 가져오기 (0.0 ~ 1.0)
-// RMS (Root Mean Square)는 소리의 평균 에너지를 나타냄
-float NativeRecorder_GetAudioLevel() {
-    return g_current_audio_level.load();
-}
+    try {
+        std::vector<std::string> inputs;
+        inputs.reserve(input_count);
+        for (int32_t i = 0; i < input_count; i++) {
+            if (!input_paths[i]) {
+                SetLastError("Invalid concat arguments");
+                return static_cast<int32_t>(ConcatResult::kInvalidArgument);
+            }
+            inputs.emplace_back(input_paths[i]);
+        }
 
-// 현재 오디오 Peak 레벨 가져오기 (0.0 ~ 1.0)
-// Peak는 최대 진폭을 나타냄
-float NativeRecorder_GetAudioPeakLevel() {
-    return g_peak_audio_level.load();
+        std::string error;
+        ConcatResult result = ConcatSegments(inputs, output_path, nullptr, &error);
+        SetLastError(result == ConcatResult::kOk ? "" : error);
+        return static_cast<int32_t>(result);
+    } catch (const std::exception& e) {
+        SetLastError(std::string("ConcatSegments failed: ") + e.what());
+        return static_cast<int32_t>(ConcatResult::kIoError);
+    }
 }
 
 }  // extern "C"
@@ -21,16 +21,109 @@
 extern "C" {
 #endif
 
+/// 파이프라인 측정 단계 수
+/// 순서: capture, video_queue, convert, video_encode, mux, video_total, audio_queue, audio_encode
+#define NATIVE_RECORDER_PIPELINE_STAGE_COUNT 8
+
+/// 단계 하나의 지연 시간 요약 (마이크로초)
+typedef struct NativeRecorderStageLatency {
+    int64_t count;
+    int64_t min_us;
+    int64_t mean_us;
+    int64_t p50_us;
+    int64_t p90_us;
+    int64_t p99_us;
+    int64_t p999_us;
+    int64_t max_us;
+} NativeRecorderStageLatency;
+
+/// 큐 압력 통계 (NativeRecorder_GetQueueStats)
+typedef struct NativeRecorderQueueStats {
+    int32_t struct_size;             // 호출자가 sizeof(NativeRecorderQueueStats)로 설정
+    int32_t video_queue_depth;       // 현재 비디오 큐 길이
+    int32_t video_queue_high_water;  // 세션 중 최대 비디오 큐 길이
+    int32_t video_queue_capacity;
+    int32_t audio_queue_depth;
+    int32_t audio_queue_high_water;
+    int32_t audio_queue_capacity;
+    int32_t reserved;
+    int64_t captured_video_frames;   // 새로 캡처한 프레임 (반복 제외)
+    int64_t repeated_video_frames;   // 화면 변화 없어 마지막 프레임을 재사용한 횟수
+    int64_t dropped_video_frames;    // 큐가 가득 차 버린 프레임
+    int64_t dropped_audio_packets;   // 큐가 가득 차 버린 WASAPI 패킷
+    int64_t dropped_audio_samples;   // 버린 오디오 프레임 수 (채널당)
+    int64_t dropped_audio_ms;        // 버린 오디오 길이
+} NativeRecorderQueueStats;
+
+/// 단계별 지연 시간 통계 (NativeRecorder_GetPipelineStats)
+typedef struct NativeRecorderPipelineStats {
+    int32_t struct_size;     // 호출자가 sizeof(NativeRecorderPipelineStats)로 설정
+    int32_t stage_count;     // 채워진 단계 수
+    int64_t record_cost_ns;  // 측정 1회당 비용 (녹화 시작 시 보정값)
+    NativeRecorderStageLatency stages[NATIVE_RECORDER_PIPELINE_STAGE_COUNT];
+} NativeRecorderPipelineStats;
+
+/// 녹화 이벤트 종류 (NativeRecorder_SetEventPort로 받는 메시지의 첫 번째 값)
+/// native/core/recorder_events.h의 RecorderEventType과 같은 값
+#define NATIVE_RECORDER_EVENT_RECORDING_STARTED 1     // message: 녹화 중 파일 경로
+#define NATIVE_RECORDER_EVENT_FIRST_FRAME_ENCODED 2
+#define NATIVE_RECORDER_EVENT_STAGE_STALLED 3         // value: 정체 시간(ms), message: 단계 이름
+#define NATIVE_RECORDER_EVENT_DEVICE_LOST 4           // message: 소스 이름 (dxgi, wasapi)
+#define NATIVE_RECORDER_EVENT_DEVICE_RECOVERED 5      // message: 소스 이름
+#define NATIVE_RECORDER_EVENT_SEGMENT_CLOSED 6        // value: 기록한 바이트, message: 파일 경로
+#define NATIVE_RECORDER_EVENT_STOPPED 7               // value: 중지 요청 → 파일 닫힘 시간(ms)
+#define NATIVE_RECORDER_EVENT_STOPPED_WITH_ERROR 8    // value: 중지 요청 → 파일 닫힘 시간(ms), message: 오류 원인
+#define NATIVE_RECORDER_EVENT_FINALIZE_COMPLETED 9    // value: 성공 1 / 실패 0, message: 결과 파일 경로, session: 녹화한 세션
+#define NATIVE_RECORDER_EVENT_PREROLL_COMMITTED 10    // value: 커밋 시점 이전 길이(ms), message: 녹화 중 파일 경로
+#define NATIVE_RECORDER_EVENT_ENCODER_RESTARTED 11    // value: 재시작 횟수, message: 새 세그먼트 파일 경로
+#define NATIVE_RECORDER_EVENT_STAGE_RESTARTED 12      // value: 정체 감지 → 진행 재개 시간(ms), message: 단계 이름 (capture, audio, encoder)
+#define NATIVE_RECORDER_EVENT_CPU_GOVERNOR_CHANGED 13 // value: 새 조절 단계 (0 = 원래 설정), message: 판단 JSON
+#define NATIVE_RECORDER_EVENT_SECONDARY_OUTPUT_ENDED 14 // value: 보조 출력이 담은 마지막 세그먼트 번호 (1 = 첫 파일), message: 보조 출력 경로
+
+/// 실시간 녹화 통계 블록 (NativeRecorder_GetLiveStats, native/core/live_stats.h의 LiveStatsBlock과 같은 레이아웃)
+/// 네이티브 인코더 스레드가 100ms마다 seqlock으로 갱신, 호출자는 읽기만 함
+/// 읽기: sequence가 짝수일 때 필드를 읽고 다시 읽은 sequence가 같으면 일관된 값 (다르면 재시도)
+typedef struct NativeRecorderLiveStats {
+    uint32_t version;                 // 레이아웃 버전 (현재 1)
+    uint32_t struct_size;             // sizeof(NativeRecorderLiveStats) = 192
+    uint32_t sequence;                // 홀수면 갱신 중
+    uint32_t recording;               // 1: 캡처 중
+    int64_t elapsed_ms;
+    int64_t video_frames;             // 인코딩 완료 프레임
+    int64_t audio_samples;            // 인코딩 완료 오디오 프레임 (채널당)
+    int64_t captured_video_frames;
+    int64_t repeated_video_frames;
+    int64_t dropped_video_frames;
+    int64_t dropped_audio_packets;
+    int64_t dropped_audio_samples;
+    int64_t dropped_audio_ms;
+    int64_t encoded_bytes;            // muxer에 넘긴 누적 바이트
+    int32_t video_queue_depth;
+    int32_t video_queue_high_water;
+    int32_t video_queue_capacity;
+    int32_t audio_queue_depth;
+    int32_t audio_queue_high_water;
+    int32_t audio_queue_capacity;
+    float audio_level;                // RMS (0.0 ~ 1.0)
+    float audio_peak_level;           // Peak (0.0 ~ 1.0)
+    float video_fps;                  // 최근 1초 인코딩 fps
+    float encoder_bitrate_kbps;       // 최근 1초 출력 비트레이트
+    uint8_t reserved[56];             // 64바이트 정렬 패딩
+} NativeRecorderLiveStats;
+
 /// 녹화 초기화
 /// @return 성공 시 0, 실패 시 에러 코드
 NATIVE_RECORDER_EXPORT int32_t NativeRecorder_Initialize();
 
+/// 아래 단일 녹화 함수(StartRecording ~ IsRecording, 진행률/통계 조회)는 기본 세션(핸들 0)에 적용됨
+/// 여러 녹화를 동시에 하려면 NativeRecorder_CreateSession + NativeRecorder_Session* 함수 사용
+
 /// 녹화 시작
 /// @param output_path 저장할 MP4 파일 경로 (UTF-8)
 /// @param width 녹화 해상도 너비
 /// @param height 녹화 해상도 높이
 /// @param fps 프레임률
-/// @return 성공 시 0, 실패 시 에러 코드
+/// @return 성공 시 0, 녹화 중이거나 이전 녹화 종료 처리 중이면 -2, 실패 시 에러 코드
 NATIVE_RECORDER_EXPORT int32_t NativeRecorder_StartRecording(
     const char* output_path,
     int32_t width,
@@ -38,10 +131,142 @@ NATIVE_RECORDER_EXPORT int32_t NativeRecorder_StartRecording(
     int32_t fps
 );
 
-/// 녹화 중지
-/// @return 성공 시 0, 실패 시 에러 코드
+/// 녹화 준비 (warm standby): 캡처 장치, 인코더, 출력 파일, 프레임 버퍼를 미리 열고 트리거 대기
+/// 비디오 초기화와 오디오/인코더 초기화를 동시에 진행, 준비 중에도 녹화 중(IsRecording=1)으로 취급
+/// 트리거 없이 NativeRecorder_StopRecording을 호출하면 미리 연 파일을 지우고 후처리 없음
+/// @param output_path, width, height, fps NativeRecorder_StartRecording과 같음
+/// @return 성공 시 0, 실패 시 에러 코드 (준비 실패는 STOPPED_WITH_ERROR 이벤트로 전달)
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_ArmRecording(
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps
+);
+
+/// 준비된 녹화 시작 (플래그만 바꾸므로 바로 반환, 첫 프레임은 1ms 이내 캡처)
+/// 준비가 아직 끝나지 않았으면 끝나는 즉시 시작, RECORDING_STARTED 이벤트 시각이 녹화 0초
+/// @return 성공 시 0, 준비된 녹화가 없거나 이미 시작했으면 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_TriggerRecording();
+
+/// 준비 완료 후 트리거 대기 중 여부
+/// @return 대기 중이면 1, 아니면 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_IsArmed();
+
+/// 녹화 중지 요청 (캡처만 바로 멈추고 즉시 반환)
+/// 남은 큐 인코딩과 파일 닫기는 백그라운드에서 진행하고 끝나면 STOPPED/STOPPED_WITH_ERROR 이벤트 전송
+/// 종료 처리 중에는 IsRecording=0, IsStopping=1이고 같은 세션으로 다시 시작할 수 없음
+/// @return 성공 시 0, 녹화 중이 아니면 -2
 NATIVE_RECORDER_EXPORT int32_t NativeRecorder_StopRecording();
 
+/// 중지 요청 후 종료 처리(큐 비우기, 파일 닫기) 중 여부
+/// @return 종료 처리 중이면 1, 아니면 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_IsStopping();
+
+/// 마지막 녹화가 남긴 세그먼트 파일 (녹화 중 경로, 다음 녹화 시작 전까지 유지)
+/// 인코더 재시작(단계 감시, CPU 예산, 자식 프로세스 재실행)이 없으면 출력 파일 하나
+/// 여러 개면 종료 후 후처리가 출력 경로 하나로 이어붙이고 세그먼트를 지움 (FINALIZE_COMPLETED 이벤트)
+/// 이어붙일 수 없으면 세그먼트마다 <이름>_part<N>.mp4로 변환해 각각 FINALIZE_COMPLETED 이벤트
+/// @return UTF-8, 줄바꿈으로 구분 (녹화한 적이 없으면 빈 문자열, 다음 호출 전까지 유효)
+NATIVE_RECORDER_EXPORT const char* NativeRecorder_GetSegmentPaths();
+
+/// 종료 처리 기한 설정 (기본값: 10000ms, 다음 녹화부터 적용)
+/// 캡처 중지 후 큐를 비우는 데 기한을 넘기면 남은 프레임/오디오를 버리고 바로 파일을 닫음 (드롭 통계에 포함)
+/// @param deadline_ms 기한 (0이면 제한 없이 모두 인코딩)
+/// @return 성공 시 0, 음수면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetStopDeadline(int32_t deadline_ms);
+
+/// 인코더 자식 프로세스 사용 설정 (기본값: 사용 안 함, 다음 녹화부터 적용)
+/// 사용하면 러너 옆의 satrec_encoder_host.exe가 공유 메모리로 프레임을 받아 인코딩하고,
+/// 인코더가 크래시하면 새 세그먼트(<이름>_part2.mp4 ...)로 다시 띄워 녹화를 이어감 (ENCODER_RESTARTED 이벤트)
+/// 세그먼트는 종료 후 후처리가 출력 경로 하나로 이어붙임 (NativeRecorder_GetSegmentPaths)
+/// pre-roll, 라이브 보조 출력과 함께 쓰면 녹화 시작이 실패함
+/// @param enabled 1이면 사용, 0이면 앱 프로세스 안에서 인코딩
+/// @return 항상 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetEncoderIsolation(int32_t enabled);
+
+/// 단계 감시 설정 (기본값: 2000ms, 3회, 다음 녹화부터 적용)
+/// 캡처/오디오/인코더 스레드가 기한 동안 진행하지 못하거나 장치/인코딩 오류가 나면 그 스레드에 재시작을 요청하고
+/// 스레드가 돌아와 재시작(소스 다시 초기화, 인코더는 새 세그먼트)하면 STAGE_RESTARTED 이벤트, 재시작 한도를 넘으면 오류로 녹화 종료
+/// 호출 안에서 돌아오지 않는 스레드는 대신 교체하지 않고 기한 × 5 뒤 응답 없음 오류로 녹화 종료 (인코더는 SetEncoderIsolation)
+/// @param deadline_ms 정체 판정 기한 (0이면 감시 안 함, 오류가 난 단계는 그대로 종료)
+/// @param max_restarts 단계별 재시작 한도
+/// @return 성공 시 0, 음수 인자면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetWatchdog(int32_t deadline_ms, int32_t max_restarts);
+
+/// 녹화 스레드 정책 설정 (기본값: 사용, affinity 없음, 다음 녹화부터 적용)
+/// 오디오/캡처 스레드는 MMCSS("Pro Audio"/"Capture")에 등록하고 인코더 스레드(격리 모드면 자식 프로세스)는 우선순위를 낮춤
+/// @param enabled 1이면 사용, 0이면 OS 기본 우선순위
+/// @param affinity_mode 0 지정 안 함, 1 선호 코어(가장 낮은 비트), 2 지정한 코어에서만 실행
+/// @param capture_cpus 캡처 스레드 CPU 비트마스크 (bit n = 논리 CPU n, 0이면 지정 안 함)
+/// @param audio_cpus 오디오 스레드 CPU 비트마스크
+/// @param encoder_cpus 인코더 스레드 CPU 비트마스크 (in-process 인코딩만)
+/// @return 성공 시 0, 잘못된 affinity_mode면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetThreadPolicy(int32_t enabled, int32_t affinity_mode,
+                                                              uint64_t capture_cpus, uint64_t audio_cpus,
+                                                              uint64_t encoder_cpus);
+
+/// CPU 예산 설정 (기본값: 0 = 조절 안 함, 다음 녹화부터 적용)
+/// 녹화 프로세스(인코더 자식 포함) CPU 사용률이 예산을 넘거나 시스템 전체가 포화되면 캡처 fps를 낮추고
+/// 여유가 이어지면 한 단계씩 복원 (CPU_GOVERNOR_CHANGED 이벤트, 녹화 중에는 fps만 바꾸므로 파일 하나 유지)
+/// 가장 낮은 fps로도 부족했으면 다음 녹화를 더 빠른 preset/적은 인코더 스레드로 시작 (0으로 끄면 원래 설정으로 초기화)
+/// @param budget_percent 전체 CPU 대비 % (예: 35)
+/// @return 성공 시 0, 0~100 밖이면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetCpuBudget(int32_t budget_percent);
+
+/// 녹화 세션 생성 (전용 D3D11 디바이스 포함, NativeRecorder_Initialize 이후 호출)
+/// 세션마다 소스/큐/인코더/스레드를 따로 가지므로 이전 세션의 종료 처리와 다음 세션 시작을 겹치거나
+/// 모니터별로 동시에 녹화할 수 있음 (설정 함수 값은 각 세션 시작 시점 값으로 고정)
+/// @return 세션 핸들 (1 이상), D3D11 디바이스 생성 실패 시 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_CreateSession();
+
+/// 세션 제거 (녹화 중이면 중지 후 파일을 닫을 때까지 대기), 기본 세션(0)은 제거할 수 없음
+/// @return 성공 시 0, 알 수 없는 핸들이면 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_DestroySession(int32_t handle);
+
+/// 세션 녹화 시작 / 준비 (인자는 NativeRecorder_StartRecording / ArmRecording과 같음)
+/// @param monitor_index 캡처할 모니터 번호 (DXGI 출력 순서, 음수면 기본 모니터)
+/// @return 성공 시 0, 이미 녹화 중 -2, 잘못된 경로 -3, 알 수 없는 핸들 -4, 기타 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionStartRecording(
+    int32_t handle,
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps,
+    int32_t monitor_index
+);
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionArmRecording(
+    int32_t handle,
+    const char* output_path,
+    int32_t width,
+    int32_t height,
+    int32_t fps,
+    int32_t monitor_index
+);
+
+/// 세션의 준비된 녹화 시작
+/// @return 성공 시 0, 준비된 녹화가 없으면 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionTriggerRecording(int32_t handle);
+
+/// 세션 녹화 중지 요청 (즉시 반환, 종료 처리는 NativeRecorder_StopRecording과 같음)
+/// @return 성공 시 0, 녹화 중이 아니면 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionStopRecording(int32_t handle);
+
+/// 세션 종료 처리 중 여부
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionIsStopping(int32_t handle);
+
+/// 세션 녹화 중 여부 (준비 중 포함)
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SessionIsRecording(int32_t handle);
+
+/// 세션 진행률 (알 수 없는 핸들이면 0)
+NATIVE_RECORDER_EXPORT int64_t NativeRecorder_SessionGetVideoFrameCount(int32_t handle);
+NATIVE_RECORDER_EXPORT int64_t NativeRecorder_SessionGetElapsedTimeMs(int32_t handle);
+
+/// 세션 실시간 통계 블록 주소 (세션을 제거하기 전까지 고정, 알 수 없는 핸들이면 NULL)
+NATIVE_RECORDER_EXPORT const NativeRecorderLiveStats* NativeRecorder_SessionGetLiveStats(int32_t handle);
+
+/// 세션의 마지막 녹화 세그먼트 (NativeRecorder_GetSegmentPaths와 같음, 알 수 없는 핸들이면 빈 문자열)
+NATIVE_RECORDER_EXPORT const char* NativeRecorder_SessionGetSegmentPaths(int32_t handle);
+
 /// 녹화 중 여부 확인
 /// @return 녹화 중이면 1, 아니면 0
 NATIVE_RECORDER_EXPORT int32_t NativeRecorder_IsRecording();
@@ -73,6 +298,152 @@ NATIVE_RECORDER_EXPORT float NativeRecorder_GetAudioLevel();
 /// @return Peak 레벨 (0.0 ~ 1.0), 녹화 중이 아니면 0.0
 NATIVE_RECORDER_EXPORT float NativeRecorder_GetAudioPeakLevel();
 
+/// 단계별 지연 시간 통계 가져오기 (녹화 중/종료 후 모두 가능, 다음 녹화 시작 시 초기화)
+/// @param stats struct_size를 설정한 구조체 포인터
+/// @return 성공 시 0, 포인터/크기 불일치 시 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_GetPipelineStats(NativeRecorderPipelineStats* stats);
+
+/// 드롭/반복 프레임 및 큐 깊이 통계 가져오기 (다음 녹화 시작 시 초기화)
+/// @param stats struct_size를 설정한 구조체 포인터
+/// @return 성공 시 0, 포인터/크기 불일치 시 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_GetQueueStats(NativeRecorderQueueStats* stats);
+
+/// 실시간 녹화 통계 블록 주소 가져오기 (프로세스 수명 동안 고정, 한 번만 호출해 두고 직접 읽음)
+/// 녹화 종료 후에는 recording = 0, 다음 녹화 시작 전까지 마지막 값 유지
+/// @return 읽기 전용 블록 포인터 (항상 유효)
+NATIVE_RECORDER_EXPORT const NativeRecorderLiveStats* NativeRecorder_GetLiveStats();
+
+/// Dart native API 초기화 (NativeRecorder_SetEventPort 전에 한 번 호출)
+/// @param data Dart의 NativeApi.initializeApiDLData
+/// @return 성공 시 0, Dart SDK 버전 불일치 시 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_InitializeDartApi(void* data);
+
+/// 녹화 이벤트를 받을 Dart ReceivePort 설정
+/// 이벤트는 발생한 스레드에서 바로 [type, elapsed_ms, value, message, session] 배열로 전송됨
+/// (type: NATIVE_RECORDER_EVENT_*, elapsed_ms: 녹화 시작 기준, message: UTF-8,
+///  session: 세션 핸들, 기본 세션과 세션 무관 이벤트(후처리 완료)는 0)
+/// @param port ReceivePort.sendPort.nativePort, 0이면 해제
+NATIVE_RECORDER_EXPORT void NativeRecorder_SetEventPort(int64_t port);
+
+/// 네이티브 로그 파일 경로 설정 (Dart LoggerService의 현재 로그 파일)
+/// 네이티브 로그는 비동기로 모아 100ms마다 이 파일 끝에 추가됨 (콘솔 출력은 유지)
+/// @param log_path 로그 파일 경로 (UTF-8, nullptr 또는 빈 문자열이면 파일 기록 안 함)
+NATIVE_RECORDER_EXPORT void NativeRecorder_SetLogFilePath(const char* log_path);
+
+/// 파이프라인 trace 기록 시작 (Chrome trace-event JSON, chrome://tracing / Perfetto에서 열기)
+/// 캡처/오디오/인코더 스레드의 단계별 구간과 큐 깊이 카운터를 기록
+/// @param output_path trace JSON 경로 (UTF-8)
+/// @return 성공 시 0, 인자 오류 -1, 이미 기록 중이거나 파일 열기 실패 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_StartTrace(const char* output_path);
+
+/// 파이프라인 trace 기록 종료
+/// @return 기록된 이벤트 수
+NATIVE_RECORDER_EXPORT int64_t NativeRecorder_StopTrace();
+
+/// 캡처 trace 경로 설정 (캡처한 BGRA 프레임과 PCM을 QPC와 함께 기록, satrec_replay로 재생)
+/// 다음 녹화부터 적용되며, 기록이 밀리거나 실패해도 녹화는 계속 진행
+/// 기본 세션은 이 경로, 다른 세션은 <이름>_session<핸들><확장자>에 기록 (동시 녹화가 같은 파일을 쓰지 않음)
+/// @param output_path trace 파일 경로 (UTF-8, nullptr 또는 빈 문자열이면 기록 안 함)
+/// @return 항상 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetCaptureTracePath(const char* output_path);
+
+/// 녹화 종료 후 faststart 후처리(moov 앞쪽 이동) 진행 중 여부
+/// @return 후처리 대기/진행 중이면 1, 아니면 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_IsFinalizing();
+
+/// faststart 후처리 사용 여부 설정 (기본값: 사용)
+/// @param enabled 1이면 사용, 0이면 fragmented MP4 그대로 유지
+NATIVE_RECORDER_EXPORT void NativeRecorder_SetFaststartEnabled(int32_t enabled);
+
+/// 패킷 저널 사용 여부 설정 (기본값: 사용 안 함, 다음 녹화부터 적용)
+/// 저널은 <출력 경로>.journal로 기록되며 정상 종료 시 삭제됨
+/// @param enabled 1이면 사용, 0이면 사용 안 함
+NATIVE_RECORDER_EXPORT void NativeRecorder_SetPacketJournalEnabled(int32_t enabled);
+
+/// 패킷 저널에서 마지막 완전한 패킷까지 MP4로 복구 (동기 실행)
+/// @param journal_path 저널 파일 경로 (UTF-8)
+/// @param output_path 복구 MP4 경로 (UTF-8)
+/// @return 성공 시 0, 인자 오류 -1, 복구 실패 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_RecoverFromJournal(
+    const char* journal_path,
+    const char* output_path
+);
+
+/// 녹화 중 컨테이너 설정 (기본값: Fragmented MP4, 다음 녹화부터 적용)
+/// Matroska/MPEG-TS는 강제 종료 시에도 끊긴 지점까지 재생 가능하며,
+/// 정상 종료 후 백그라운드에서 요청한 MP4 경로로 변환됨 (NativeRecorder_IsFinalizing)
+/// @param container 0: Fragmented MP4, 1: Matroska(.mkv), 2: MPEG-TS(.ts)
+/// @return 성공 시 0, 알 수 없는 값이면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetContainerFormat(int32_t container);
+
+/// 비디오 큐 메모리 예산과 큐 저장 형식 설정 (다음 녹화부터 적용)
+/// 기본값: 192MB, I420 (캡처 스레드에서 변환, 1080p 프레임당 3.1MB → 약 61프레임)
+/// @param budget_bytes 큐 메모리 예산 (0이면 고정 60프레임)
+/// @param frame_format 0: BGRA (4바이트/픽셀), 1: I420 (1.5바이트/픽셀)
+/// @return 성공 시 0, 잘못된 값이면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetFrameBuffering(int64_t budget_bytes, int32_t frame_format);
+
+/// pre-roll / post-roll 설정 (기본값: 둘 다 사용 안 함, 다음 녹화부터 적용)
+/// pre-roll을 켜면 NativeRecorder_StartRecording은 캡처/인코딩만 시작하고 압축 패킷을 메모리 링에 보관하며,
+/// NativeRecorder_CommitPreRoll 전까지 디스크에 쓰지 않음 (커밋 없이 중지하면 파일 없음)
+/// post-roll을 켜면 NativeRecorder_StopRecording 이후 그 시간만큼 더 기록한 뒤 종료 처리 (중지 요청은 바로 반환)
+/// @param max_ms 링에 보관할 최대 길이 (0이면 pre-roll 사용 안 함)
+/// @param max_bytes 링 최대 바이트 (오래된 GOP부터 버림)
+/// @param postroll_ms 중지 요청 후 추가 기록 시간
+/// @return 성공 시 0, 잘못된 값이면 -1
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_SetPreRoll(int32_t max_ms, int64_t max_bytes, int32_t postroll_ms);
+
+/// pre-roll 커밋: (지금 - lookback_ms) 직전 키프레임부터 링의 패킷을 재인코딩 없이 파일에 쓰고 이후는 바로 기록
+/// 파일 타임스탬프는 그 키프레임이 0, 경과 시간/이벤트 시각은 커밋 시점 기준
+/// @param lookback_ms 커밋 시점을 지금보다 앞당길 길이 (0이면 지금)
+/// @return 성공 시 0, pre-roll 중이 아니면 -2, 커밋 실패 -3 (NativeRecorder_GetLastError)
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_CommitPreRoll(int32_t lookback_ms);
+
+/// 커밋 전 pre-roll 중 여부
+/// @return pre-roll 중이면 1, 아니면 0
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_IsPreRollActive();
+
+/// 녹화 파일을 재인코딩 없이 faststart MP4로 변환 (동기 실행)
+/// 강제 종료 후 남은 .mkv/.ts 파일 처리용
+/// @param input_path 입력 파일 경로 (UTF-8, MP4/MKV/TS)
+/// @param output_path 출력 MP4 경로 (UTF-8)
+/// @return 성공 시 0, 인자 오류 -1, 변환 실패 -2
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_RemuxToMp4(
+    const char* input_path,
+    const char* output_path
+);
+
+/// 보조 출력 경로 설정 (기본값: 사용 안 함, 다음 녹화부터 적용)
+/// 지정 시 녹화 파일을 primary/secondary 두 곳에 동시에 기록하며,
+/// 한쪽 디스크가 멈추거나 가득 차면 그 대상만 분리하고 나머지는 계속 기록
+/// 기본 세션은 이 경로, 다른 세션은 <이름>_session<핸들>.mp4에 기록 (동시 녹화가 같은 파일을 쓰지 않음)
+/// @param output_path 보조 MP4 경로 (UTF-8), nullptr 또는 빈 문자열이면 해제
+NATIVE_RECORDER_EXPORT void NativeRecorder_SetSecondaryOutputPath(const char* output_path);
+
+/// 출력 대상 상태 조회 (녹화 종료 후에도 다음 녹화 시작 전까지 유지)
+/// @param index 0: primary, 1: secondary
+/// @return 0: 사용 안 함, 1: 정상, 2: 멈춤으로 분리, 3: 쓰기 오류로 분리
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_GetOutputState(int32_t index);
+
+/// 출력 대상에 기록 완료된 바이트 수
+/// @param index 0: primary, 1: secondary
+NATIVE_RECORDER_EXPORT int64_t NativeRecorder_GetOutputBytesWritten(int32_t index);
+
+/// 출력 대상 큐에서 대기 중인 바이트 수 (디스크 지연 지표)
+/// @param index 0: primary, 1: secondary
+NATIVE_RECORDER_EXPORT int64_t NativeRecorder_GetOutputQueuedBytes(int32_t index);
+
+/// 녹화 세그먼트를 재인코딩 없이 하나의 MP4로 이어붙이기 (동기 실행)
+/// @param input_paths 세그먼트 경로 배열 (UTF-8, 재생 순서)
+/// @param input_count 세그먼트 수
+/// @param output_path 출력 MP4 경로 (UTF-8)
+/// @return 성공 시 0, 인자 오류 -1, 코덱 파라미터 불일치 -2, 입출력 오류 -3
+NATIVE_RECORDER_EXPORT int32_t NativeRecorder_ConcatSegments(
+    const char* const* input_paths,
+    int32_t input_count,
+    const char* output_path
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,232 @@
+// windows/runner/wasapi_audio_source.cpp
+// WASAPI Loopback 오디오 소스 구현
+
+#include "wasapi_audio_source.h"
+
+#include <cstring>
+
+#include "media_clock.h"
+#include "native_logger.h"
+
+WasapiAudioSource::~WasapiAudioSource() {
+    Stop();
+}
+
+// WASAPI 초기화
+bool WasapiAudioSource::Start(std::string* error) {
+    HRESULT hr;
+
+    SATREC_LOG_INFO("[C++] WASAPI 초기화 시작...");
+
+    // 1. IMMDeviceEnumerator 생성
+    SATREC_LOG_INFO("[C++] 1/4: IMMDeviceEnumerator 생성...");
+
+    IMMDeviceEnumerator* enumerator = nullptr;
+    hr = CoCreateInstance(
+        __uuidof(MMDeviceEnumerator),
+        nullptr,
+        CLSCTX_ALL,
+        __uuidof(IMMDeviceEnumerator),
+        (void**)&enumerator
+    );
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ IMMDeviceEnumerator 생성 실패 (HRESULT: 0x%08X)", hr);
+        *error = "IMMDeviceEnumerator 생성 실패";
+        return false;
+    }
+
+    // 2. 기본 렌더 디바이스 가져오기 (스피커)
+    SATREC_LOG_INFO("[C++] 2/4: 기본 오디오 장치 가져오기...");
+
+    hr = enumerator->GetDefaultAudioEndpoint(
+        eRender,      // 렌더 (출력) 장치
+        eConsole,     // 콘솔 역할
+        &device_
+    );
+    enumerator->Release();
+
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ 기본 오디오 장치 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "기본 오디오 장치 가져오기 실패";
+        Stop();
+        return false;
+    }
+
+    // 3. IAudioClient 생성
+    SATREC_LOG_INFO("[C++] 3/4: IAudioClient 생성...");
+
+    hr = device_->Activate(
+        __uuidof(IAudioClient),
+        CLSCTX_ALL,
+        nullptr,
+        (void**)&audio_client_
+    );
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ IAudioClient 생성 실패 (HRESULT: 0x%08X)", hr);
+        *error = "IAudioClient 생성 실패";
+        Stop();
+        return false;
+    }
+
+    // 4. 오디오 포맷 가져오기
+    SATREC_LOG_INFO("[C++] 4/4: 오디오 포맷 가져오기...");
+
+    hr = audio_client_->GetMixFormat(&wave_format_);
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ 오디오 포맷 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "오디오 포맷 가져오기 실패";
+        Stop();
+        return false;
+    }
+
+    SATREC_LOG_INFO("[C++] ✅ 오디오 포맷: %d Hz, %d channels, %d bits",
+                    wave_format_->nSamplesPerSec,
+                    wave_format_->nChannels,
+                    wave_format_->wBitsPerSample);
+
+    // 5. Loopback 모드로 초기화
+    REFERENCE_TIME buffer_duration = 1000 * 10000;  // 100ms in 100-nanosecond units
+
+    hr = audio_client_->Initialize(
+        AUDCLNT_SHAREMODE_SHARED,        // Shared 모드
+        AUDCLNT_STREAMFLAGS_LOOPBACK,    // Loopback 플래그 (핵심!)
+        buffer_duration,
+        0,
+        wave_format_,
+        nullptr
+    );
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ AudioClient 초기화 실패 (HRESULT: 0x%08X)", hr);
+        *error = "AudioClient 초기화 실패";
+        Stop();
+        return false;
+    }
+
+    // 6. IAudioCaptureClient 가져오기
+    hr = audio_client_->GetService(
+        __uuidof(IAudioCaptureClient),
+        (void**)&capture_client_
+    );
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ IAudioCaptureClient 가져오기 실패 (HRESULT: 0x%08X)", hr);
+        *error = "IAudioCaptureClient 가져오기 실패";
+        Stop();
+        return false;
+    }
+
+    // 7. 캡처 시작
+    hr = audio_client_->Start();
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ 오디오 캡처 시작 실패 (HRESULT: 0x%08X)", hr);
+        *error = "오디오 캡처 시작 실패";
+        Stop();
+        return false;
+    }
+
+    SATREC_LOG_INFO("[C++] ✅ WASAPI 초기화 완료 (Loopback 모드)");
+    return true;
+}
+
+// WASAPI 리소스 정리
+void WasapiAudioSource::Stop() {
+    if (!device_ && !audio_client_ && !capture_client_ && !wave_format_) {
+        return;
+    }
+    SATREC_LOG_INFO("[C++] WASAPI 리소스 정리 시작...");
+
+    if (audio_client_) {
+        audio_client_->Stop();
+    }
+
+    if (capture_client_) {
+        capture_client_->Release();
+        capture_client_ = nullptr;
+    }
+
+    if (audio_client_) {
+        audio_client_->Release();
+        audio_client_ = nullptr;
+    }
+
+    if (device_) {
+        device_->Release();
+        device_ = nullptr;
+    }
+
+    if (wave_format_) {
+        CoTaskMemFree(wave_format_);
+        wave_format_ = nullptr;
+    }
+
+    SATREC_LOG_INFO("[C++] ✅ WASAPI 리소스 정리 완료");
+}
+
+AudioSourceFormat WasapiAudioSource::Format() const {
+    AudioSourceFormat format;
+    if (wave_format_) {
+        format.sample_rate = static_cast<int>(wave_format_->nSamplesPerSec);
+        format.channels = wave_format_->nChannels;
+        format.bits_per_sample = wave_format_->wBitsPerSample;
+    }
+    return format;
+}
+
+CaptureReadResult WasapiAudioSource::ReadPacket(AudioSample* sample, std::string* error) {
+    if (!capture_client_) {
+        *error = "WASAPI가 초기화되지 않음";
+        return CaptureReadResult::kError;
+    }
+
+    // 사용 가능한 패킷 확인
+    UINT32 packet_length = 0;
+    HRESULT hr = capture_client_->GetNextPacketSize(&packet_length);
+    if (FAILED(hr)) {
+        SATREC_LOG_ERROR("[C++] ❌ GetNextPacketSize 실패 (HRESULT: 0x%08X)", hr);
+        *error = "GetNextPacketSize 실패";
+        if (hr == AUDCLNT_E_DEVICE_INVALIDATED && event_sink_) {
+            // 출력 장치 제거/변경 → 오디오 스레드만 종료 (비디오는 계속)
+            RecorderEvent event;
+            event.type = RecorderEventType::kDeviceLost;
+            event.message = Name();
+            event_sink_->OnRecorderEvent(event);
+        }
+        return CaptureReadResult::kError;
+    }
+    if (packet_length == 0) {
+        return CaptureReadResult::kNoData;
+    }
+
+    // 오디오 데이터 가져오기
+    BYTE* data = nullptr;
+    UINT32 frames_available = 0;
+    DWORD flags = 0;
+    hr = capture_client_->GetBuffer(&data, &frames_available, &flags, nullptr, nullptr);
+    if (FAILED(hr)) {
+        // 다음 주기에 다시 시도
+        SATREC_LOG_ERROR("[C++] ❌ GetBuffer 실패 (HRESULT: 0x%08X)", hr);
+        return CaptureReadResult::kNoData;
+    }
+
+    // 오디오 샘플 생성 (무음 여부와 관계없이 항상 전송)
+    // ⚠️ 중요: 무음 구간에서도 데이터를 보내야 A/V 동기화 유지됨
+    sample->frame_count = frames_available;
+    sample->sample_rate = wave_format_->nSamplesPerSec;
+    sample->channels = wave_format_->nChannels;
+    sample->bits_per_sample = wave_format_->wBitsPerSample;
+
+    const size_t data_size = static_cast<size_t>(frames_available) * wave_format_->nBlockAlign;
+    sample->data.resize(data_size);
+    if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
+        // 무음일 때: 0으로 채운 데이터 전송
+        memset(sample->data.data(), 0, data_size);
+    } else {
+        memcpy(sample->data.data(), data, data_size);
+    }
+
+    // 타임스탬프 설정 (QPC, 파이프라인 시계와 동일)
+    sample->timestamp = SystemMediaClock::Instance().Now();
+
+    // 버퍼 해제
+    capture_client_->ReleaseBuffer(frames_available);
+    return CaptureReadResult::kData;
+}
@@ -0,0 +1,43 @@
+// windows/runner/wasapi_audio_source.h
+// WASAPI Loopback 오디오 소스 (IAudioSource 구현)
+
+#ifndef WASAPI_AUDIO_SOURCE_H_
+#define WASAPI_AUDIO_SOURCE_H_
+
+#include <windows.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+
+#include <string>
+
+#include "capture_source.h"
+
+/// 입력: 없음 (기본 렌더 장치 = 스피커 출력을 loopback으로 캡처)
+/// 출력: 공유 모드 믹스 형식(Float32) PCM 패킷 (QPC 타임스탬프 = SystemMediaClock)
+/// 예외: 장치/클라이언트 초기화 실패 시 Start가 false, GetNextPacketSize 실패 시 kError
+///
+/// COM은 NativeRecorder_Initialize에서 MTA로 초기화된 상태여야 함
+class WasapiAudioSource : public IAudioSource {
+public:
+    WasapiAudioSource() = default;
+    ~WasapiAudioSource() override;
+
+    WasapiAudioSource(const WasapiAudioSource&) = delete;
+    WasapiAudioSource& operator=(const WasapiAudioSource&) = delete;
+
+    const char* Name() const override { return "wasapi"; }
+    void SetEventSink(RecorderEventSink* sink) override { event_sink_ = sink; }
+    bool Start(std::string* error) override;
+    void Stop() override;
+    AudioSourceFormat Format() const override;
+    CaptureReadResult ReadPacket(AudioSample* sample, std::string* error) override;
+
+private:
+    IMMDevice* device_ = nullptr;
+    IAudioClient* audio_client_ = nullptr;
+    IAudioCaptureClient* capture_client_ = nullptr;
+    WAVEFORMATEX* wave_format_ = nullptr;
+    RecorderEventSink* event_sink_ = nullptr;  // 장치 제거(AUDCLNT_E_DEVICE_INVALIDATED) 알림
+};
+
+#endif  // WASAPI_AUDIO_SOURCE_H_